@@ -0,0 +1,9 @@
+#pragma once
+
+#include "seastarx.h"
+
+#include <seastar/util/log.hh>
+
+namespace archival {
+inline ss::logger archival_log("archival");
+} // namespace archival
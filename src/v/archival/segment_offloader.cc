@@ -0,0 +1,91 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "archival/segment_offloader.h"
+
+#include "archival/logger.h"
+#include "vassert.h"
+#include "vlog.h"
+
+#include <seastar/core/file.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/reactor.hh>
+
+#include <fmt/format.h>
+
+#include <deque>
+#include <filesystem>
+
+namespace archival {
+
+segment_offloader::segment_offloader(
+  const s3::configuration& conf, s3::bucket_name bucket)
+  : _bucket(std::move(bucket))
+  , _client(conf) {}
+
+ss::future<> segment_offloader::stop() { return _client.shutdown(); }
+
+s3::object_key segment_offloader::make_object_key(const ss::sstring& path) {
+    // keep the <namespace>/<topic>/<partition>_<revision>/<file> suffix of
+    // the local path so objects in the bucket are grouped by ntp
+    std::filesystem::path p(path.c_str());
+    std::deque<std::string> parts;
+    for (const auto& e : p) {
+        parts.push_back(e.string());
+    }
+    while (parts.size() > 4) {
+        parts.pop_front();
+    }
+    return s3::object_key(fmt::format("{}", fmt::join(parts, "/")));
+}
+
+ss::future<> segment_offloader::offload_segment(
+  ss::lw_shared_ptr<storage::segment> seg) {
+    vassert(
+      !seg->has_appender(),
+      "cannot offload segment with active appender: {}",
+      *seg);
+    auto& reader = seg->reader();
+    auto key = make_object_key(reader.filename());
+    vlog(
+      archival_log.debug,
+      "offloading segment {} ({} bytes) to {}/{}",
+      reader.filename(),
+      reader.file_size(),
+      _bucket,
+      key);
+    auto stream = reader.data_stream(0, ss::default_priority_class());
+    return _client
+      .put_object(_bucket, key, reader.file_size(), std::move(stream))
+      .then([this, seg] { return offload_index(seg); });
+}
+
+ss::future<> segment_offloader::offload_index(
+  ss::lw_shared_ptr<storage::segment> seg) {
+    auto filename = seg->index().filename();
+    return ss::open_file_dma(filename, ss::open_flags::ro)
+      .then([this, filename](ss::file f) {
+          return f.size().then([this, f, filename](uint64_t size) mutable {
+              auto key = make_object_key(filename);
+              auto stream = ss::make_file_input_stream(std::move(f));
+              return _client.put_object(_bucket, key, size, std::move(stream));
+          });
+      });
+}
+
+ss::future<ss::input_stream<char>>
+segment_offloader::download(const s3::object_key& key) {
+    vlog(archival_log.debug, "downloading {}/{}", _bucket, key);
+    return _client.get_object(_bucket, key)
+      .then([](http::client::response_stream_ref response) {
+          return response->as_input_stream();
+      });
+}
+
+} // namespace archival
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "s3/client.h"
+#include "seastarx.h"
+#include "storage/segment.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/iostream.hh>
+
+namespace archival {
+
+/// Offloads closed log segments to object storage.
+///
+/// A segment is uploaded together with its offset index under a key that
+/// preserves the <namespace>/<topic>/<partition>_<revision>/<file> layout
+/// of the local data directory, so cold data can be located by ntp. The
+/// download path hands back an input stream compatible with
+/// storage::continuous_batch_parser, which lets historical fetches be
+/// replayed through the regular read path (and batch cache) without the
+/// segment being resident on local disk.
+class segment_offloader {
+public:
+    /// \brief Initialize the offloader
+    ///
+    /// \param conf is an s3 client configuration
+    /// \param bucket is a bucket that receives offloaded segments
+    segment_offloader(const s3::configuration& conf, s3::bucket_name bucket);
+
+    /// Stop the offloader and shutdown the underlying client
+    ss::future<> stop();
+
+    /// \brief Upload a closed segment and its index to the bucket.
+    ///
+    /// Only segments without an active appender may be offloaded; the
+    /// caller is responsible for ensuring the segment was rolled.
+    ss::future<> offload_segment(ss::lw_shared_ptr<storage::segment>);
+
+    /// \brief Stream a previously offloaded object back.
+    ///
+    /// The returned stream yields the raw segment payload and can be fed
+    /// to the storage parser to rebuild batches for historical reads.
+    ss::future<ss::input_stream<char>> download(const s3::object_key&);
+
+    /// Object key under which a local file would be offloaded
+    static s3::object_key make_object_key(const ss::sstring& path);
+
+private:
+    ss::future<> offload_index(ss::lw_shared_ptr<storage::segment>);
+
+    s3::bucket_name _bucket;
+    s3::client _client;
+};
+
+} // namespace archival
@@ -18,12 +18,57 @@
 
 #include <seastar/core/temporary_buffer.hh>
 
+#include <new>
+
 namespace details {
+
+/**
+ * Bounded per-shard free list of io_fragment sized blocks. Fragment
+ * descriptors are created and destroyed millions of times per second on
+ * the kafka and rpc paths; recycling them keeps those fixed size
+ * allocations out of the general allocator. Freed blocks link through
+ * their own storage, so the list itself never allocates.
+ */
+class io_fragment_free_list {
+public:
+    // at 64 bytes per descriptor this caps the cache at ~1MiB per shard
+    static constexpr size_t max_free_items = 16384;
+
+    void* pop() noexcept {
+        if (_head == nullptr) {
+            return nullptr;
+        }
+        node* n = _head;
+        _head = n->next;
+        --_size;
+        return n;
+    }
+    bool push(void* p) noexcept {
+        if (_size >= max_free_items) {
+            return false;
+        }
+        node* n = new (p) node{_head};
+        _head = n;
+        ++_size;
+        return true;
+    }
+
+private:
+    struct node {
+        node* next;
+    };
+    node* _head = nullptr;
+    size_t _size{0};
+};
+
 class io_fragment {
 public:
     struct full {};
     struct empty {};
 
+    static void* operator new(size_t sz);
+    static void operator delete(void* ptr) noexcept;
+
     io_fragment(ss::temporary_buffer<char> buf, full)
       : _buf(std::move(buf))
       , _used_bytes(_buf.size()) {}
@@ -110,4 +155,31 @@ private:
     size_t _used_bytes;
 };
 
+inline io_fragment_free_list& io_fragment_pool() {
+    static thread_local io_fragment_free_list pool;
+    return pool;
+}
+
+inline void* io_fragment::operator new(size_t sz) {
+    // the pool recycles exactly io_fragment sized blocks
+    vassert(
+      sz == sizeof(io_fragment),
+      "io_fragment pool got an allocation of {} bytes, expected {}",
+      sz,
+      sizeof(io_fragment));
+    if (void* p = io_fragment_pool().pop(); p != nullptr) {
+        return p;
+    }
+    return ::operator new(sz);
+}
+
+inline void io_fragment::operator delete(void* ptr) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+    if (!io_fragment_pool().push(ptr)) {
+        ::operator delete(ptr);
+    }
+}
+
 } // namespace details
@@ -165,8 +165,25 @@ public:
     size_t bytes_consumed() const { return _bytes_consumed; }
     // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
     size_t segment_bytes_left() const { return _frag_index_end - _frag_index; }
+    /// current read position inside the active fragment. valid for
+    /// segment_bytes_left() bytes, lets callers decode small values
+    /// straight from contiguous memory
+    const char* segment_index() const { return _frag_index; }
     bool is_finished() const { return _frag == _frag_end; }
 
+    /// fragment iterator at the current read position, lets callers slice
+    /// from here in constant time instead of re-walking from the front
+    io_const_iterator current_fragment() const { return _frag; }
+    io_const_iterator fragment_end() const { return _frag_end; }
+    /// byte offset of the read position within the current fragment
+    size_t current_fragment_offset() const {
+        if (_frag == _frag_end || _frag_index == nullptr) {
+            return 0;
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return _frag_index - _frag->get();
+    }
+
     /// starts a new iterator byte-for-byte starting at *this* index
     /// useful for varint decoding that need to peek ahead
     io_byte_iterator begin() const {
@@ -13,6 +13,7 @@
 
 #include "bytes/bytes.h"
 #include "bytes/iobuf.h"
+#include "bytes/iobuf_view.h"
 #include "seastarx.h"
 #include "utils/utf8.h"
 #include "utils/vint.h"
@@ -20,6 +21,8 @@
 #include <seastar/core/sstring.hh>
 
 #include <memory>
+#include <optional>
+#include <string_view>
 
 /**
  * iobuf parser interface suitable for an iobuf passed by const-ref. also
@@ -46,6 +49,16 @@ public:
     size_t bytes_consumed() const { return _in.bytes_consumed(); }
 
     std::pair<int64_t, uint8_t> read_varlong() {
+        // when the current fragment can hold a maximum length encoding the
+        // value is guaranteed contiguous - decode it with the unrolled bulk
+        // decoder instead of dispatching the byte iterator per byte. record
+        // parsing hits this path for nearly every field
+        if (likely(_in.segment_bytes_left() >= vint::max_length)) {
+            auto [val, length_size] = vint::deserialize_buf(
+              _in.segment_index(), _in.segment_bytes_left());
+            _in.skip(length_size);
+            return {val, static_cast<uint8_t>(length_size)};
+        }
         auto [val, length_size] = vint::deserialize(_in);
         _in.skip(length_size);
         return {val, length_size};
@@ -58,6 +71,23 @@ public:
         return str;
     }
 
+    /**
+     * Read len bytes as a view into the underlying buffer without copying.
+     * Only possible when the bytes are contiguous within one fragment;
+     * returns std::nullopt when the string straddles a fragment boundary
+     * and a copying read is required. The view is valid for as long as the
+     * parsed iobuf is alive.
+     */
+    std::optional<std::string_view> read_string_view(size_t len) {
+        if (unlikely(_in.segment_bytes_left() < len)) {
+            return std::nullopt;
+        }
+        std::string_view v(_in.segment_index(), len);
+        _in.skip(len);
+        validate_utf8(v);
+        return v;
+    }
+
     bytes read_bytes(size_t n) {
         auto b = ss::uninitialized_string<bytes>(n);
         _in.consume_to(n, b.begin());
@@ -90,6 +120,20 @@ public:
 
     iobuf copy(size_t len) { return iobuf_copy(_in, len); }
 
+    /**
+     * Constant time view of the next len bytes without consuming them.
+     * Built from the parser's current fragment position, so no fragments
+     * are walked. The view is valid while the parsed iobuf is alive and
+     * the parser has not been advanced past the viewed range.
+     */
+    iobuf_view peek_view(size_t len) const {
+        return iobuf_view(
+          _in.current_fragment(),
+          _in.fragment_end(),
+          _in.current_fragment_offset(),
+          len);
+    }
+
 protected:
     iobuf& ref() { return *std::get<owned_buf>(_buf); }
 
@@ -120,7 +164,9 @@ public:
       : iobuf_parser_base(std::move(buf), tag_owned_buf{}) {}
 
     iobuf share(size_t len) {
-        auto ret = ref().share(bytes_consumed(), len);
+        // slice from the current fragment instead of re-walking the buffer
+        // from the front as iobuf::share(pos, len) would
+        auto ret = peek_view(len).share();
         skip(len);
         return ret;
     }
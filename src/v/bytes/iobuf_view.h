@@ -0,0 +1,119 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "bytes/iobuf.h"
+#include "seastarx.h"
+
+#include <cstddef>
+
+/**
+ * Constant time, non-owning slice of an iobuf.
+ *
+ * A view is a (fragment iterator, byte offset, length) triple; building one
+ * never walks fragments, allocates or mutates the source. It is the slicing
+ * primitive for consumers that already know their position in the buffer -
+ * iobuf_parser tracks its current fragment, the fetch path splices record
+ * payload sub-ranges and rpc framing slices message bodies - where
+ * iobuf::share(pos, len) would re-walk every fragment preceding pos.
+ *
+ * The viewed range can be traversed span by span with for_each_span(),
+ * materialized without copying with share() (the underlying refcounted
+ * temporary buffers are shared, copy-on-write style: the source remains
+ * valid and unmodified), or deep copied with copy(). A view does not extend
+ * the lifetime of the source iobuf; the source must stay alive and its
+ * fragment list unchanged for as long as the view is used.
+ */
+class iobuf_view {
+public:
+    iobuf_view(
+      iobuf::const_iterator begin,
+      iobuf::const_iterator end,
+      size_t offset,
+      size_t len) noexcept
+      : _begin(begin)
+      , _end(end)
+      , _offset(offset)
+      , _size(len) {}
+
+    /// view over a whole iobuf
+    explicit iobuf_view(const iobuf& buf) noexcept
+      : iobuf_view(buf.cbegin(), buf.cend(), 0, buf.size_bytes()) {}
+
+    size_t size_bytes() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    /**
+     * Invokes f(const char*, size_t) for every contiguous span covered by
+     * the view, in order. Only the covered fragments are visited.
+     */
+    template<typename Consumer>
+    void for_each_span(Consumer&& f) const {
+        size_t left = _size;
+        size_t pos = _offset;
+        for (auto it = _begin; left > 0 && it != _end; ++it) {
+            if (pos >= it->size()) {
+                pos -= it->size();
+                continue;
+            }
+            const size_t step = std::min(left, it->size() - pos);
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            f(it->get() + pos, step);
+            left -= step;
+            pos = 0;
+        }
+    }
+
+    /**
+     * Materializes the viewed range as an owning iobuf by sharing the
+     * underlying temporary buffers. No payload bytes are copied; the result
+     * keeps the storage alive independently of the source iobuf.
+     */
+    iobuf share() const {
+        iobuf ret;
+        size_t left = _size;
+        size_t pos = _offset;
+        for (auto it = _begin; left > 0 && it != _end; ++it) {
+            if (pos >= it->size()) {
+                pos -= it->size();
+                continue;
+            }
+            const size_t step = std::min(left, it->size() - pos);
+            /*
+             * temporary_buffer::share only bumps the deleter refcount, the
+             * fragment payload is never written through this reference
+             */
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            auto& frag = const_cast<iobuf::fragment&>(*it);
+            ret.append(frag.share(pos, step));
+            left -= step;
+            pos = 0;
+        }
+        return ret;
+    }
+
+    /// deep copy of the viewed range
+    iobuf copy() const {
+        iobuf ret;
+        for_each_span([&ret](const char* src, size_t sz) {
+            ret.append(src, sz);
+        });
+        return ret;
+    }
+
+private:
+    iobuf::const_iterator _begin;
+    iobuf::const_iterator _end;
+    // byte offset of the slice start within *_begin
+    size_t _offset;
+    size_t _size;
+};
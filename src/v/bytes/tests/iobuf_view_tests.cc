@@ -0,0 +1,91 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/iobuf.h"
+#include "bytes/iobuf_parser.h"
+#include "bytes/iobuf_view.h"
+#include "random/generators.h"
+
+#include <seastar/core/temporary_buffer.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include <boost/test/unit_test.hpp>
+
+// fragmented buffer: every append lands in its own fragment
+static iobuf make_fragmented(size_t fragments, size_t fragment_size) {
+    iobuf buf;
+    for (size_t i = 0; i < fragments; ++i) {
+        auto str = random_generators::gen_alphanum_string(fragment_size);
+        ss::temporary_buffer<char> b(str.data(), str.size());
+        buf.append_take_ownership(
+          new iobuf::fragment(std::move(b), iobuf::fragment::full{}));
+    }
+    return buf;
+}
+
+SEASTAR_THREAD_TEST_CASE(test_view_matches_share) {
+    auto buf = make_fragmented(8, 128);
+    // a range straddling several fragment boundaries
+    const size_t pos = 200;
+    const size_t len = 500;
+
+    auto expected = buf.share(pos, len);
+    iobuf_view full(buf);
+    BOOST_REQUIRE_EQUAL(full.size_bytes(), buf.size_bytes());
+
+    iobuf_view view(buf.cbegin(), buf.cend(), pos, len);
+    BOOST_REQUIRE_EQUAL(view.size_bytes(), len);
+    BOOST_REQUIRE(view.share() == expected);
+    BOOST_REQUIRE(view.copy() == expected);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_view_for_each_span) {
+    auto buf = make_fragmented(4, 64);
+    iobuf_view view(buf.cbegin(), buf.cend(), 32, 128);
+
+    size_t total = 0;
+    size_t spans = 0;
+    view.for_each_span([&total, &spans](const char*, size_t sz) {
+        total += sz;
+        ++spans;
+    });
+    BOOST_REQUIRE_EQUAL(total, 128);
+    // 32 bytes from the first fragment, then 64 + 32 from the next two
+    BOOST_REQUIRE_EQUAL(spans, 3);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_view_share_outlives_source) {
+    auto buf = make_fragmented(4, 64);
+    auto expected = buf.share(100, 100).copy();
+
+    iobuf shared;
+    {
+        auto source = std::move(buf);
+        iobuf_view view(source.cbegin(), source.cend(), 100, 100);
+        shared = view.share();
+    }
+    // the underlying storage is refcounted, the slice survives the source
+    BOOST_REQUIRE(shared == expected);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_parser_share_from_current_position) {
+    auto buf = make_fragmented(6, 100);
+    auto expected = buf.share(150, 250);
+
+    iobuf_parser parser(buf.share(0, buf.size_bytes()));
+    parser.skip(150);
+
+    auto peeked = parser.peek_view(250);
+    BOOST_REQUIRE_EQUAL(parser.bytes_consumed(), 150);
+    BOOST_REQUIRE(peeked.share() == expected);
+
+    auto shared = parser.share(250);
+    BOOST_REQUIRE(shared == expected);
+    BOOST_REQUIRE_EQUAL(parser.bytes_consumed(), 400);
+}
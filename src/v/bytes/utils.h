@@ -14,10 +14,22 @@
 #include "hashing/crc32c.h"
 
 inline void crc_extend_iobuf(crc32& crc, const iobuf& buf) {
-    auto in = iobuf::iterator_consumer(buf.cbegin(), buf.cend());
-    (void)in.consume(buf.size_bytes(), [&crc](const char* src, size_t sz) {
+    /*
+     * hot path for produce validation and storage replay. walk the fragment
+     * list directly and hand each fragment to the crc backend in a single
+     * call: the crc32c library dispatches at runtime to the SSE4.2/PCLMUL
+     * kernels on x86 and the ARMv8 CRC extension on arm, and internally
+     * processes large blocks as interleaved streams, so per-fragment call
+     * overhead is the only cost left to shave. prefetching the next fragment
+     * hides the pointer chase through the fragment list while the current
+     * fragment is being crunched.
+     */
+    for (auto it = buf.begin(); it != buf.end(); ++it) {
+        auto next = std::next(it);
+        if (next != buf.end()) {
+            __builtin_prefetch(next->get(), 0 /*read*/, 3 /*high locality*/);
+        }
         // NOLINTNEXTLINE
-        crc.extend(reinterpret_cast<const uint8_t*>(src), sz);
-        return ss::stop_iteration::no;
-    });
+        crc.extend(reinterpret_cast<const uint8_t*>(it->get()), it->size());
+    }
 }
@@ -16,9 +16,11 @@
 #include "config/configuration.h"
 #include "rpc/backoff_policy.h"
 #include "rpc/types.h"
+#include "utils/dns_cache.h"
 #include "vlog.h"
 
 #include <seastar/core/future.hh>
+#include <seastar/core/smp.hh>
 
 #include <chrono>
 
@@ -84,10 +86,13 @@ ss::future<> maybe_create_tcp_client(
   model::node_id node,
   unresolved_address rpc_address,
   config::tls_config tls_config) {
-    return rpc_address.resolve().then([node,
-                                       &cache,
-                                       tls_config = std::move(tls_config)](
-                                        ss::socket_address new_addr) mutable {
+    // resolution goes through the shard's dns cache: during connectivity
+    // flaps broker clients are rebuilt in bursts and every shard would
+    // otherwise hit the resolver for the same peer hosts
+    return shard_dns_cache()
+      .resolve(rpc_address)
+      .then([node, &cache, tls_config = std::move(tls_config)](
+              ss::socket_address new_addr) mutable {
         auto f = ss::now();
         if (cache.contains(node)) {
             // client is already there, check if configuration changed
@@ -128,7 +133,19 @@ ss::future<> maybe_create_tcp_client(
                       .server_addr = new_addr,
                       .credentials = cert,
                       .disable_metrics = rpc::metrics_disabled(
-                        config::shard_local_cfg().disable_metrics)},
+                        config::shard_local_cfg().disable_metrics),
+                      .default_compression
+                      = config::shard_local_cfg().rpc_client_compress_payloads()
+                          ? rpc::compression_type::zstd
+                          : rpc::compression_type::none,
+                      .min_compression_bytes
+                      = config::shard_local_cfg()
+                          .rpc_client_min_compression_bytes(),
+                      // the internal rpc server balances accepts by source
+                      // port; land this shard's connection on the matching
+                      // remote shard so replication requests are handled on
+                      // the numa node owning the partition data
+                      .steer_to_shard = ss::this_shard_id()},
                     rpc::make_exponential_backoff_policy<rpc::clock_type>(
                       std::chrono::seconds(1), std::chrono::seconds(60)));
               });
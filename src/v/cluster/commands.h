@@ -102,23 +102,28 @@ template<typename... Commands>
 CONCEPT(requires(ControllerCommand<Commands>, ...))
 using make_commands_list = commands_type_list<Commands...>;
 
-/// Commands are serialized as a batch with single record. Command key is
-/// serialized as a record key. Key is independent from command type so it can
-/// leverage the log compactions (i.e only last command for given key is enough
-/// to determine its state). Command value contains command type information.
-/// Record data contains first the command type and then value.
+/// Commands are serialized as records - one command per record. Command key
+/// is serialized as a record key. Key is independent from command type so it
+/// can leverage the log compactions (i.e only last command for given key is
+/// enough to determine its state). Command value contains command type
+/// information. Record data contains first the command type and then value.
 ///
 ///                  +--------------+-------+
 ///                  | command_type | value |
 ///                  +--------------+-------+
 ///
+/// A batch carries one or more such records: single-command updates use
+/// serialize_cmd while bulk updates (e.g. tenant provisioning creating
+/// hundreds of topics at once) pack the whole set into one batch with
+/// serialize_cmds, so it commits in a single controller replication round.
+namespace internal {
 template<typename Cmd>
 CONCEPT(requires ControllerCommand<Cmd>)
-ss::future<model::record_batch> serialize_cmd(Cmd cmd) {
+ss::future<> serialize_cmd_record(simple_batch_builder& builder, Cmd cmd) {
     return ss::do_with(
       iobuf{},
       iobuf{},
-      [cmd = std::move(cmd)](iobuf& key_buf, iobuf& value_buf) mutable {
+      [&builder, cmd = std::move(cmd)](iobuf& key_buf, iobuf& value_buf) mutable {
           auto value_f
             = reflection::async_adl<command_type>{}
                 .to(value_buf, Cmd::type)
@@ -130,13 +135,40 @@ ss::future<model::record_batch> serialize_cmd(Cmd cmd) {
             key_buf, std::move(cmd.key));
           return ss::when_all_succeed(std::move(key_f), std::move(value_f))
             .discard_result()
-            .then([&key_buf, &value_buf]() mutable {
-                simple_batch_builder builder(Cmd::batch_type, model::offset(0));
+            .then([&builder, &key_buf, &value_buf]() mutable {
                 builder.add_raw_kv(std::move(key_buf), std::move(value_buf));
-                return std::move(builder).build();
             });
       });
 }
+} // namespace internal
+
+template<typename Cmd>
+CONCEPT(requires ControllerCommand<Cmd>)
+ss::future<model::record_batch> serialize_cmd(Cmd cmd) {
+    return ss::do_with(
+      simple_batch_builder(Cmd::batch_type, model::offset(0)),
+      [cmd = std::move(cmd)](simple_batch_builder& builder) mutable {
+          return internal::serialize_cmd_record(builder, std::move(cmd))
+            .then([&builder] { return std::move(builder).build(); });
+      });
+}
+
+template<typename Cmd>
+CONCEPT(requires ControllerCommand<Cmd>)
+ss::future<model::record_batch> serialize_cmds(std::vector<Cmd> cmds) {
+    return ss::do_with(
+      std::move(cmds),
+      simple_batch_builder(Cmd::batch_type, model::offset(0)),
+      [](std::vector<Cmd>& cmds, simple_batch_builder& builder) {
+          return ss::do_for_each(
+                   cmds,
+                   [&builder](Cmd& cmd) {
+                       return internal::serialize_cmd_record(
+                         builder, std::move(cmd));
+                   })
+            .then([&builder] { return std::move(builder).build(); });
+      });
+}
 
 namespace internal {
 template<typename Cmd>
@@ -173,13 +205,9 @@ std::optional<deserializer<Cmd>> make_deserializer(command_type tp) {
 
 template<typename... Commands>
 ss::future<std::variant<Commands...>>
-deserialize(model::record_batch b, commands_type_list<Commands...>) {
-    vassert(
-      b.record_count() == 1,
-      "Currently we expect single command in single batch");
-    auto records = b.copy_records();
-    iobuf_parser v_parser(records.begin()->release_value());
-    iobuf_parser k_parser(records.begin()->release_key());
+deserialize(model::record rec, commands_type_list<Commands...>) {
+    iobuf_parser v_parser(rec.release_value());
+    iobuf_parser k_parser(rec.release_key());
     // chose deserializer
     auto cmd_type = reflection::adl<command_type>{}.from(v_parser);
     std::optional<std::variant<internal::deserializer<Commands>...>> ret;
@@ -195,4 +223,15 @@ deserialize(model::record_batch b, commands_type_list<Commands...>) {
       },
       *ret);
 }
+
+template<typename... Commands>
+ss::future<std::variant<Commands...>>
+deserialize(model::record_batch b, commands_type_list<Commands...> list) {
+    vassert(
+      b.record_count() == 1,
+      "Expected single command batch, multi-command batches deserialize "
+      "record by record");
+    auto records = b.copy_records();
+    return deserialize(std::move(*records.begin()), list);
+}
 } // namespace cluster
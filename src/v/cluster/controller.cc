@@ -15,13 +15,17 @@
 #include "cluster/raft0_utils.h"
 #include "cluster/topics_frontend.h"
 #include "cluster/types.h"
+#include "config/configuration.h"
 #include "model/metadata.h"
 #include "model/timeout_clock.h"
+#include "reflection/adl.h"
 
 #include <seastar/core/thread.hh>
 
 namespace cluster {
 
+static const bytes controller_checkpoint_key("controller_state_checkpoint");
+
 controller::controller(
   ss::sharded<rpc::connection_cache>& ccache,
   ss::sharded<partition_manager>& pm,
@@ -88,6 +92,7 @@ ss::future<> controller::start() {
             std::ref(_partition_leaders),
             std::ref(_as));
       })
+      .then([this] { return load_checkpoint(); })
       .then([this] {
           return _stm.invoke_on(controller_stm_shard, &controller_stm::start);
       })
@@ -103,10 +108,100 @@ ss::future<> controller::start() {
           });
       })
       .then(
-        [this] { return _backend.invoke_on_all(&controller_backend::start); });
+        [this] { return _backend.invoke_on_all(&controller_backend::start); })
+      .then([this] {
+          _checkpoint_timer.set_callback([this] {
+              (void)ss::with_gate(_bg, [this] { return take_checkpoint(); })
+                .handle_exception([](const std::exception_ptr& e) {
+                    vlog(
+                      clusterlog.warn,
+                      "error taking controller checkpoint - {}",
+                      e);
+                })
+                .finally([this] {
+                    if (!_bg.is_closed()) {
+                        _checkpoint_timer.arm(config::shard_local_cfg()
+                                                .controller_checkpoint_interval_ms());
+                    }
+                });
+          });
+          _checkpoint_timer.arm(
+            config::shard_local_cfg().controller_checkpoint_interval_ms());
+      });
+}
+
+ss::future<> controller::load_checkpoint() {
+    auto buf = _storage.local().kvs().get(
+      storage::kvstore::key_space::controller, controller_checkpoint_key);
+    if (!buf) {
+        return ss::now();
+    }
+    auto checkpoint = reflection::from_iobuf<controller_checkpoint>(
+      std::move(*buf));
+    vlog(
+      clusterlog.info,
+      "seeding controller state from checkpoint at offset {} with {} topics",
+      checkpoint.last_applied,
+      checkpoint.topics.size());
+    _last_checkpoint_offset = checkpoint.last_applied;
+
+    std::vector<model::topic_metadata> metadata;
+    metadata.reserve(checkpoint.topics.size());
+    for (const auto& t : checkpoint.topics) {
+        metadata.push_back(t.get_metadata());
+    }
+    auto offset = checkpoint.last_applied;
+    return _partition_allocator
+      .invoke_on(
+        partition_allocator::shard,
+        [metadata = std::move(metadata), group = checkpoint.highest_group](
+          partition_allocator& allocator) mutable {
+            allocator.update_allocation_state(std::move(metadata), group);
+        })
+      .then([this, topics = std::move(checkpoint.topics), offset] {
+          return _tp_state.invoke_on_all(
+            [topics, offset](topic_table& table) {
+                return table.load_snapshot(topics, offset);
+            });
+      })
+      .then([this, offset] {
+          return _stm.invoke_on(
+            controller_stm_shard, [offset](controller_stm& stm) {
+                stm.set_next(offset + model::offset(1));
+            });
+      });
+}
+
+ss::future<> controller::take_checkpoint() {
+    // the applied offset is read before the state is copied: the copy may
+    // already include later commands, and re-applying those on recovery is
+    // idempotent, while the opposite order could lose commands
+    auto offset = _raft0->read_last_applied();
+    if (offset <= _last_checkpoint_offset) {
+        return ss::now();
+    }
+    auto checkpoint = controller_checkpoint(
+      offset,
+      _partition_allocator.local().highest_group(),
+      _tp_state.local().snapshot());
+    return _storage.local()
+      .kvs()
+      .put(
+        storage::kvstore::key_space::controller,
+        controller_checkpoint_key,
+        reflection::to_iobuf(std::move(checkpoint)))
+      .then([this, offset] {
+          _last_checkpoint_offset = offset;
+          vlog(
+            clusterlog.debug, "controller checkpoint taken at offset {}", offset);
+      });
 }
 ss::future<> controller::stop() {
-    return _as.invoke_on_all(&ss::abort_source::request_abort)
+    _checkpoint_timer.cancel();
+    return _bg.close()
+      .then([this] {
+          return _as.invoke_on_all(&ss::abort_source::request_abort);
+      })
       .then([this] { return _stm.stop(); })
       .then([this] { return _members_manager.stop(); })
       .then([this] { return _tp_frontend.stop(); })
@@ -118,4 +213,21 @@ ss::future<> controller::stop() {
       .then([this] { return _as.stop(); });
 }
 
+ss::future<std::error_code> controller::move_partition_replicas(
+  model::ntp ntp,
+  std::vector<model::broker_shard> new_replica_set,
+  model::timeout_clock::time_point tout) {
+    // validate targets up front, a move command pointing at an unknown node
+    // would otherwise be accepted and stall waiting for a broker that will
+    // never catch up
+    for (auto& bs : new_replica_set) {
+        if (!_members_table.local().get_broker(bs.node_id)) {
+            return ss::make_ready_future<std::error_code>(
+              errc::node_does_not_exists);
+        }
+    }
+    return _tp_frontend.local().move_partition_replicas(
+      std::move(ntp), std::move(new_replica_set), tout);
+}
+
 } // namespace cluster
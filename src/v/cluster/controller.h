@@ -27,7 +27,9 @@
 #include "storage/api.h"
 
 #include <seastar/core/abort_source.hh>
+#include <seastar/core/gate.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/core/timer.hh>
 
 #include <vector>
 
@@ -56,7 +58,30 @@ public:
     ss::future<> start();
     ss::future<> stop();
 
+    /**
+     * Moves a partition to a new replica set. New replicas join the group
+     * as learners and catch up in the background under the learner
+     * recovery bandwidth budget, voters are swapped only once the learners
+     * are caught up, so the move never reduces redundancy or saturates the
+     * cluster with recovery traffic. Returns errc::node_does_not_exists
+     * when a target node is not a cluster member.
+     */
+    ss::future<std::error_code> move_partition_replicas(
+      model::ntp,
+      std::vector<model::broker_shard>,
+      model::timeout_clock::time_point);
+
 private:
+    /// Seeds topic table and partition allocator from the kvstore
+    /// checkpoint (when one exists) and fast-forwards the stm past the
+    /// checkpointed prefix of the controller log. Runs before the stm
+    /// starts applying.
+    ss::future<> load_checkpoint();
+    /// Writes the current materialized state to the kvstore. The applied
+    /// offset is read before the state is copied, so replay over the
+    /// commands between them stays idempotent.
+    ss::future<> take_checkpoint();
+
     ss::sharded<ss::abort_source> _as;                     // instance per core
     ss::sharded<partition_allocator> _partition_allocator; // single instance
     ss::sharded<topic_table> _tp_state;                    // instance per core
@@ -74,6 +99,9 @@ private:
     ss::sharded<storage::api>& _storage;
     topic_updates_dispatcher _tp_updates_dispatcher;
     consensus_ptr _raft0;
+    ss::timer<> _checkpoint_timer;
+    ss::gate _bg;
+    model::offset _last_checkpoint_offset;
 };
 
 } // namespace cluster
\ No newline at end of file
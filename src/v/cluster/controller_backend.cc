@@ -136,13 +136,17 @@ ss::future<> controller_backend::reconcile_topics() {
         if (_topic_deltas.empty()) {
             return ss::now();
         }
-        // reconcile NTPs in parallel
+        // reconcile NTPs in parallel, bounded by _ops_sem so creating a
+        // large topic does not flood the shard with concurrent disk ops
         return ss::parallel_for_each(
                  _topic_deltas.begin(),
                  _topic_deltas.end(),
                  [this](underlying_t::value_type& ntp_deltas) {
-                     return reconcile_ntp(ntp_deltas.second);
+                     return ss::with_semaphore(_ops_sem, 1, [this, &ntp_deltas] {
+                         return reconcile_ntp(ntp_deltas.second);
+                     });
                  })
+          .then([this] { return flush_shard_table_updates(); })
           .then([this] {
               // cleanup empty NTP keys
               for (auto it = _topic_deltas.cbegin();
@@ -303,13 +307,24 @@ ss::future<std::error_code> controller_backend::update_partition_replica_set(
     return ss::make_ready_future<std::error_code>(errc::success);
 }
 
-ss::future<> controller_backend::add_to_shard_table(
-  model::ntp ntp, raft::group_id raft_group, uint32_t shard) {
-    // update shard_table: broadcast
+void controller_backend::add_to_shard_table(
+  model::ntp ntp, raft::group_id raft_group, ss::shard_id shard) {
+    // defer the cross core broadcast, updates collected within one
+    // reconciliation round are flushed with a single invoke_on_all
+    _pending_shard_updates.push_back(
+      shard_table_update{std::move(ntp), raft_group, shard});
+}
+
+ss::future<> controller_backend::flush_shard_table_updates() {
+    if (_pending_shard_updates.empty()) {
+        return ss::now();
+    }
     return _shard_table.invoke_on_all(
-      [ntp = std::move(ntp), raft_group, shard](shard_table& s) mutable {
-          s.insert(std::move(ntp), shard);
-          s.insert(raft_group, shard);
+      [updates = std::exchange(_pending_shard_updates, {})](shard_table& s) {
+          for (auto& u : updates) {
+              s.insert(u.ntp, u.shard);
+              s.insert(u.group, u.shard);
+          }
       });
 }
 
@@ -338,13 +353,11 @@ ss::future<std::error_code> controller_backend::create_partition(
               .discard_result();
     }
 
-    return f
-      .then([this, ntp = std::move(ntp), group_id]() mutable {
-          // we create only partitions that belongs to current shard
-          return add_to_shard_table(
-            std::move(ntp), group_id, ss::this_shard_id());
-      })
-      .then([] { return make_error_code(errc::success); });
+    return f.then([this, ntp = std::move(ntp), group_id]() mutable {
+        // we create only partitions that belongs to current shard
+        add_to_shard_table(std::move(ntp), group_id, ss::this_shard_id());
+        return make_error_code(errc::success);
+    });
 }
 
 ss::future<std::error_code>
@@ -359,6 +372,15 @@ controller_backend::delete_partition(model::ntp ntp, model::revision_id rev) {
     }
     auto group_id = part->group();
 
+    // drop any insert scheduled earlier in this round, it must not
+    // resurrect the entry when the batch is flushed
+    _pending_shard_updates.erase(
+      std::remove_if(
+        _pending_shard_updates.begin(),
+        _pending_shard_updates.end(),
+        [&ntp](const shard_table_update& u) { return u.ntp == ntp; }),
+      _pending_shard_updates.end());
+
     return _shard_table
       .invoke_on_all(
         [ntp, group_id](shard_table& st) mutable { st.erase(ntp, group_id); })
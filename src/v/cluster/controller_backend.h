@@ -53,7 +53,8 @@ private:
       raft::group_id,
       model::revision_id,
       std::vector<model::broker>);
-    ss::future<> add_to_shard_table(model::ntp, raft::group_id, ss::shard_id);
+    void add_to_shard_table(model::ntp, raft::group_id, ss::shard_id);
+    ss::future<> flush_shard_table_updates();
     ss::future<std::error_code> process_partition_update(
       model::ntp, const partition_assignment&, model::revision_id);
     ss::future<> fetch_deltas();
@@ -74,9 +75,25 @@ private:
     model::node_id _self;
     ss::sstring _data_directory;
     ss::sharded<ss::abort_source>& _as;
+    // limits how many partition operations execute at once within one
+    // reconciliation round, creations run concurrently but a large topic
+    // cannot flood the shard with raft group and log directory creations
+    static constexpr size_t max_concurrent_ops = 64;
+
+    // shard table insert scheduled by a finished partition creation, the
+    // cross core broadcasts are batched and flushed once per
+    // reconciliation round instead of once per partition
+    struct shard_table_update {
+        model::ntp ntp;
+        raft::group_id group;
+        ss::shard_id shard;
+    };
+
     underlying_t _topic_deltas;
+    std::vector<shard_table_update> _pending_shard_updates;
     ss::timer<> _housekeeping_timer;
     ss::semaphore _topics_sem{1};
+    ss::semaphore _ops_sem{max_concurrent_ops};
     ss::gate _gate;
 };
 } // namespace cluster
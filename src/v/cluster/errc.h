@@ -35,6 +35,7 @@ enum class errc {
     not_leader,
     partition_already_exists,
     waiting_for_recovery,
+    node_does_not_exists,
 };
 struct errc_category final : public std::error_category {
     const char* name() const noexcept final { return "cluster::errc"; }
@@ -87,6 +88,8 @@ struct errc_category final : public std::error_category {
             return "Requested partition already exists";
         case errc::waiting_for_recovery:
             return "Waiting for partition to recover";
+        case errc::node_does_not_exists:
+            return "Requested node does not exists";
         default:
             return "cluster::errc::unknown";
         }
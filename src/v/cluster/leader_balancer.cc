@@ -0,0 +1,206 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "cluster/leader_balancer.h"
+
+#include "cluster/logger.h"
+#include "config/configuration.h"
+#include "vlog.h"
+
+#include <seastar/core/future-util.hh>
+#include <seastar/core/smp.hh>
+
+#include <algorithm>
+
+namespace cluster {
+
+leader_balancer::leader_balancer(
+  ss::sharded<partition_leaders_table>& leaders,
+  ss::sharded<members_table>& members,
+  ss::sharded<partition_manager>& partition_manager)
+  : _leaders(leaders)
+  , _members(members)
+  , _partition_manager(partition_manager)
+  , _self(config::shard_local_cfg().node_id)
+  , _interval(config::shard_local_cfg().leader_balancer_interval_ms()) {
+    _timer.set_callback([this] {
+        (void)ss::with_gate(_gate, [this] { return balance(); });
+    });
+}
+
+ss::future<> leader_balancer::start() {
+    if (ss::this_shard_id() != balancer_shard) {
+        return ss::make_ready_future<>();
+    }
+    if (config::shard_local_cfg().enable_leader_balancer()) {
+        _timer.arm_periodic(_interval);
+    }
+    return ss::make_ready_future<>();
+}
+
+ss::future<> leader_balancer::stop() {
+    _timer.cancel();
+    return _gate.close();
+}
+
+void leader_balancer::prune_muted() {
+    const auto now = ss::lowres_clock::now();
+    for (auto it = _muted.begin(); it != _muted.end();) {
+        if (it->second <= now) {
+            it = _muted.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+ss::future<> leader_balancer::balance() {
+    prune_muted();
+
+    auto brokers = _members.local().all_broker_ids();
+    if (brokers.size() < 2) {
+        return ss::make_ready_future<>();
+    }
+    // leaders per node, nodes without any leadership count as zero
+    absl::flat_hash_map<model::node_id, size_t> counts;
+    counts.reserve(brokers.size());
+    for (auto& id : brokers) {
+        counts.emplace(id, 0);
+    }
+    _leaders.local().for_each_leader(
+      [&counts](
+        model::topic_namespace_view,
+        model::partition_id,
+        std::optional<model::node_id> leader,
+        model::term_id) {
+          if (leader) {
+              if (auto it = counts.find(*leader); it != counts.end()) {
+                  it->second++;
+              }
+          }
+      });
+
+    size_t total = 0;
+    for (auto& [id, count] : counts) {
+        total += count;
+    }
+    if (total == 0) {
+        return ss::make_ready_future<>();
+    }
+    const auto mean = static_cast<double>(total)
+                      / static_cast<double>(brokers.size());
+    const auto self_count = counts[_self];
+    // hysteresis - only react to a clear overload of this node so small
+    // imbalances and counting races do not trigger back and forth moves
+    const auto threshold = std::max<double>(2.0, mean * 0.1);
+    if (static_cast<double>(self_count) <= mean + threshold) {
+        return ss::make_ready_future<>();
+    }
+    // move one leadership to the least loaded node, provided it is below
+    // the mean, otherwise the move would not reduce the imbalance
+    auto target_it = std::min_element(
+      counts.begin(), counts.end(), [](const auto& a, const auto& b) {
+          return a.second < b.second;
+      });
+    if (
+      target_it->first == _self
+      || static_cast<double>(target_it->second) >= mean) {
+        return ss::make_ready_future<>();
+    }
+    const auto target = target_it->first;
+
+    std::vector<model::ntp> muted;
+    muted.reserve(_muted.size());
+    for (auto& [ntp, deadline] : _muted) {
+        muted.push_back(ntp);
+    }
+
+    vlog(
+      clusterlog.debug,
+      "Leadership imbalance detected, self: {}, mean: {}, transferring one "
+      "leadership to {}",
+      self_count,
+      mean,
+      target);
+
+    // search the shards for a led partition replicated on the target, rate
+    // limited to a single transfer per tick
+    return ss::do_with(
+      ss::shard_id{0},
+      std::optional<model::ntp>{},
+      std::move(muted),
+      [this, target](
+        ss::shard_id& shard,
+        std::optional<model::ntp>& moved,
+        std::vector<model::ntp>& muted) {
+          return ss::do_until(
+                   [&shard, &moved] {
+                       return moved.has_value() || shard >= ss::smp::count;
+                   },
+                   [this, target, &shard, &moved, &muted] {
+                       return find_and_transfer_on_shard(shard, target, muted)
+                         .then([&shard, &moved](std::optional<model::ntp> r) {
+                             if (r) {
+                                 moved = std::move(r);
+                             } else {
+                                 ++shard;
+                             }
+                         });
+                   })
+            .then([this, target, &moved] {
+                if (!moved) {
+                    return;
+                }
+                vlog(
+                  clusterlog.info,
+                  "Transferred leadership of {} to {}",
+                  *moved,
+                  target);
+                _muted.emplace(
+                  std::move(*moved),
+                  ss::lowres_clock::now() + mute_intervals * _interval);
+            });
+      });
+}
+
+ss::future<std::optional<model::ntp>>
+leader_balancer::find_and_transfer_on_shard(
+  ss::shard_id shard, model::node_id target, std::vector<model::ntp> muted) {
+    return _partition_manager.invoke_on(
+      shard, [target, muted = std::move(muted)](partition_manager& pm) {
+          for (auto& [ntp, partition] : pm.partitions()) {
+              if (!partition->is_leader()) {
+                  continue;
+              }
+              if (!partition->group_configuration().contains_broker(target)) {
+                  continue;
+              }
+              if (std::find(muted.begin(), muted.end(), ntp) != muted.end()) {
+                  continue;
+              }
+              auto moved_ntp = ntp;
+              return partition->transfer_leadership(target).then(
+                [ntp = std::move(moved_ntp)](std::error_code ec) {
+                    if (ec) {
+                        vlog(
+                          clusterlog.debug,
+                          "Leadership transfer of {} failed - {}",
+                          ntp,
+                          ec.message());
+                        return std::optional<model::ntp>{};
+                    }
+                    return std::optional<model::ntp>{ntp};
+                });
+          }
+          return ss::make_ready_future<std::optional<model::ntp>>(
+            std::nullopt);
+      });
+}
+
+} // namespace cluster
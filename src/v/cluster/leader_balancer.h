@@ -0,0 +1,74 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "cluster/members_table.h"
+#include "cluster/partition_leaders_table.h"
+#include "cluster/partition_manager.h"
+#include "model/fundamental.h"
+#include "model/metadata.h"
+
+#include <seastar/core/gate.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/core/timer.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+namespace cluster {
+
+/// Periodically evens out partition leadership across cluster nodes. Raft
+/// elections place leaders wherever the first candidate wins, so after a
+/// rolling restart most leaderships pile up on the nodes restarted first.
+///
+/// Every interval the balancer counts leaders per node using the local copy
+/// of partition_leaders_table. When this node holds noticeably more leaders
+/// than the cluster mean it transfers leadership of one of its partitions to
+/// the least loaded member of that partition's replica set. A single
+/// transfer per tick, the overload threshold and a mute period for recently
+/// transferred partitions give the cluster time to observe every move, so
+/// balancing converges without flapping. Each node only moves its own
+/// leaderships away, the cluster converges without any coordination.
+class leader_balancer final {
+public:
+    leader_balancer(
+      ss::sharded<partition_leaders_table>&,
+      ss::sharded<members_table>&,
+      ss::sharded<partition_manager>&);
+
+    ss::future<> start();
+    ss::future<> stop();
+
+private:
+    // balancing state lives on a single shard, transfers themselves are
+    // dispatched to the shard hosting the chosen partition
+    static constexpr ss::shard_id balancer_shard = 0;
+    // ignore a transferred partition for this many intervals so the new
+    // leader is observed everywhere before it is considered again
+    static constexpr int mute_intervals = 5;
+
+    ss::future<> balance();
+    ss::future<std::optional<model::ntp>> find_and_transfer_on_shard(
+      ss::shard_id, model::node_id target, std::vector<model::ntp> muted);
+    void prune_muted();
+
+    ss::sharded<partition_leaders_table>& _leaders;
+    ss::sharded<members_table>& _members;
+    ss::sharded<partition_manager>& _partition_manager;
+    model::node_id _self;
+    std::chrono::milliseconds _interval;
+    absl::flat_hash_map<model::ntp, ss::lowres_clock::time_point> _muted;
+    ss::timer<> _timer;
+    ss::gate _gate;
+};
+
+} // namespace cluster
@@ -51,5 +51,6 @@ void members_table::update_brokers(patch<broker_ptr> patch) {
     for (auto& br : patch.deletions) {
         _brokers.erase(br->id());
     }
+    ++_version;
 }
 } // namespace cluster
\ No newline at end of file
@@ -34,8 +34,13 @@ public:
 
     void update_brokers(patch<broker_ptr>);
 
+    /// Monotonically increases with every update applied on this shard.
+    /// Allows callers to invalidate results derived from the table state.
+    uint64_t version() const { return _version; }
+
 private:
     using broker_cache_t = absl::flat_hash_map<model::node_id, broker_ptr>;
     broker_cache_t _brokers;
+    uint64_t _version{0};
 };
 } // namespace cluster
\ No newline at end of file
@@ -65,6 +65,11 @@ metadata_cache::get_topic_timestamp_type(model::topic_namespace_view tp) const {
     return _topics_state.local().get_topic_timestamp_type(tp);
 }
 
+std::optional<model::compression>
+metadata_cache::get_topic_compression(model::topic_namespace_view tp) const {
+    return _topics_state.local().get_topic_compression(tp);
+}
+
 std::vector<model::topic_metadata> metadata_cache::all_topics_metadata() const {
     auto all_md = _topics_state.local().all_topics_metadata();
     for (auto& md : all_md) {
@@ -73,6 +78,10 @@ std::vector<model::topic_metadata> metadata_cache::all_topics_metadata() const {
     return all_md;
 }
 
+topic_table::metadata_snapshot_ptr metadata_cache::topics_snapshot() const {
+    return _topics_state.local().metadata_snapshot();
+}
+
 std::optional<broker_ptr> metadata_cache::get_broker(model::node_id nid) const {
     return _members_table.local().get_broker(nid);
 }
@@ -85,6 +94,10 @@ std::vector<model::node_id> metadata_cache::all_broker_ids() const {
     return _members_table.local().all_broker_ids();
 }
 
+bool metadata_cache::contains(model::topic_namespace_view tp) const {
+    return _topics_state.local().contains(tp);
+}
+
 bool metadata_cache::contains(
   model::topic_namespace_view tp, const model::partition_id pid) const {
     return _topics_state.local().contains(tp, pid);
@@ -102,4 +115,11 @@ std::optional<model::node_id> metadata_cache::get_controller_leader_id() {
     return _leaders.local().get_leader(controller_ntp);
 }
 
+uint64_t metadata_cache::version() const {
+    // each underlying version only ever increases, so the sum changes
+    // whenever any of them does
+    return _topics_state.local().version() + _members_table.local().version()
+           + _leaders.local().version();
+}
+
 } // namespace cluster
@@ -80,9 +80,21 @@ public:
     std::optional<model::timestamp_type>
       get_topic_timestamp_type(model::topic_namespace_view) const;
 
+    ///\brief Returns topics storage compression type
+    ///
+    /// Empty optional when the topic does not exist or does not configure a
+    /// storage codec (batches are stored with the producer codec)
+    std::optional<model::compression>
+      get_topic_compression(model::topic_namespace_view) const;
+
     /// Returns metadata of all topics.
     std::vector<model::topic_metadata> all_topics_metadata() const;
 
+    /// Shared immutable snapshot of the metadata of all topics. Zero copy,
+    /// consistent across scheduling points, but without leader information;
+    /// use get_leader()/all_topics_metadata() when leaders are needed.
+    topic_table::metadata_snapshot_ptr topics_snapshot() const;
+
     /// Returns all brokers, returns copy as the content of broker can change
     std::vector<broker_ptr> all_brokers() const;
 
@@ -93,6 +105,8 @@ public:
     /// broker can change
     std::optional<broker_ptr> get_broker(model::node_id) const;
 
+    bool contains(model::topic_namespace_view) const;
+
     bool contains(model::topic_namespace_view, model::partition_id) const;
 
     /// Returns metadata of all topics in cache internal format
@@ -113,6 +127,14 @@ public:
     /// If present returns a leader of raft0 group
     std::optional<model::node_id> get_controller_leader_id();
 
+    /**
+     * Monotonically increasing counter that changes whenever any of the
+     * underlying state on this shard changes (topics, brokers, or partition
+     * leadership). Callers may cache results derived from the metadata cache
+     * and use the version to invalidate them.
+     */
+    uint64_t version() const;
+
 private:
     ss::sharded<topic_table>& _topics_state;
     ss::sharded<members_table>& _members_table;
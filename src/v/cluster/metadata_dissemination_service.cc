@@ -22,6 +22,7 @@
 #include "model/fundamental.h"
 #include "model/metadata.h"
 #include "model/timeout_clock.h"
+#include "random/generators.h"
 #include "rpc/connection_cache.h"
 #include "rpc/types.h"
 #include "utils/retry.h"
@@ -35,8 +36,10 @@
 
 #include <absl/container/flat_hash_set.h>
 
+#include <algorithm>
 #include <chrono>
 #include <exception>
+#include <utility>
 
 namespace cluster {
 metadata_dissemination_service::metadata_dissemination_service(
@@ -54,12 +57,19 @@ metadata_dissemination_service::metadata_dissemination_service(
   , _clients(clients)
   , _self(config::shard_local_cfg().node_id)
   , _dissemination_interval(
-      config::shard_local_cfg().metadata_dissemination_interval_ms) {
+      config::shard_local_cfg().metadata_dissemination_interval_ms)
+  , _anti_entropy_interval(
+      config::shard_local_cfg()
+        .metadata_dissemination_anti_entropy_interval_ms) {
     _dispatch_timer.set_callback([this] {
         (void)ss::with_gate(
           _bg, [this] { return dispatch_disseminate_leadership(); });
     });
     _dispatch_timer.arm_periodic(_dissemination_interval);
+    _anti_entropy_timer.set_callback([this] {
+        (void)ss::with_gate(
+          _bg, [this] { return dispatch_anti_entropy_sync(); });
+    });
 
     for (auto& seed : config::shard_local_cfg().seed_servers()) {
         _seed_server_ids.push_back(seed.id);
@@ -76,7 +86,10 @@ void metadata_dissemination_service::disseminate_leadership(
       ntp,
       leader_id.value());
 
-    _requests.push_back(ntp_leader{std::move(ntp), term, leader_id});
+    // newer leadership for the same ntp supersedes the previous entry, a
+    // peer that has not acked the old version will only receive the new one
+    _leaders_updates[std::move(ntp)] = versioned_leader{
+      term, leader_id, ++_version};
 }
 
 ss::future<> metadata_dissemination_service::start() {
@@ -98,6 +111,7 @@ ss::future<> metadata_dissemination_service::start() {
     if (ss::this_shard_id() != 0) {
         return ss::make_ready_future<>();
     }
+    _anti_entropy_timer.arm_periodic(_anti_entropy_interval);
     // poll either seed servers or configuration
     auto ids = _members_table.local().all_broker_ids();
     // use hash set to deduplicate ids
@@ -133,39 +147,60 @@ ss::future<> metadata_dissemination_service::start() {
 
 void metadata_dissemination_service::handle_leadership_notification(
   model::ntp ntp, model::term_id term, std::optional<model::node_id> lid) {
-    (void)ss::with_gate(_bg, [this, ntp = std::move(ntp), lid, term]() mutable {
-        return container().invoke_on(
-          0,
-          [ntp = std::move(ntp), lid, term](
-            metadata_dissemination_service& s) mutable {
-              return s.apply_leadership_notification(std::move(ntp), term, lid);
-          });
+    _pending_notifications.push_back(
+      ntp_leader{.ntp = std::move(ntp), .term = term, .leader_id = lid});
+    if (_notification_dispatch_in_flight) {
+        // the running dispatch fiber picks this entry up before exiting
+        return;
+    }
+    _notification_dispatch_in_flight = true;
+    (void)ss::with_gate(_bg, [this] {
+        return dispatch_pending_notifications().finally(
+          [this] { _notification_dispatch_in_flight = false; });
     });
 }
 
-ss::future<> metadata_dissemination_service::apply_leadership_notification(
-  model::ntp ntp, model::term_id term, std::optional<model::node_id> lid) {
-    // the gate also needs to be taken on the destination core.
-    return ss::with_gate(
-      _bg, [this, ntp = std::move(ntp), lid, term]() mutable {
-          // the lock sequences the updates from raft
-          return _lock.with([this, ntp = std::move(ntp), lid, term]() mutable {
-              // update partition leaders
-              auto f = _leaders.invoke_on_all(
-                [ntp, lid, term](partition_leaders_table& leaders) {
-                    leaders.update_partition_leader(ntp, term, lid);
-                });
-              if (lid == _self) {
-                  // only disseminate from current leader
-                  f = f.then([this, ntp = std::move(ntp), term, lid]() mutable {
-                      return disseminate_leadership(std::move(ntp), term, lid);
-                  });
-              }
-              return f;
-          });
+ss::future<> metadata_dissemination_service::dispatch_pending_notifications() {
+    return ss::do_until(
+      [this] { return _pending_notifications.empty(); },
+      [this] {
+          auto batch = std::exchange(_pending_notifications, {});
+          return container().invoke_on(
+            0,
+            [batch = std::move(batch)](
+              metadata_dissemination_service& s) mutable {
+                return s.apply_leadership_notifications(std::move(batch));
+            });
       });
 }
 
+ss::future<> metadata_dissemination_service::apply_leadership_notifications(
+  ntp_leaders updates) {
+    // the gate also needs to be taken on the destination core.
+    return ss::with_gate(_bg, [this, updates = std::move(updates)]() mutable {
+        // the lock sequences the updates from raft
+        return _lock.with([this, updates = std::move(updates)]() mutable {
+            // update partition leaders, whole batch in one cross-shard call
+            auto f = _leaders.invoke_on_all(
+              [updates](partition_leaders_table& leaders) {
+                  for (auto& u : updates) {
+                      leaders.update_partition_leader(
+                        u.ntp, u.term, u.leader_id);
+                  }
+              });
+            return f.then([this, updates = std::move(updates)]() mutable {
+                for (auto& u : updates) {
+                    if (u.leader_id == _self) {
+                        // only disseminate from current leader
+                        disseminate_leadership(
+                          std::move(u.ntp), u.term, u.leader_id);
+                    }
+                }
+            });
+        });
+    });
+}
+
 static inline ss::future<>
 wait_for_next_retry(std::chrono::seconds sleep_for, ss::abort_source& as) {
     return ss::sleep_abortable(sleep_for, as)
@@ -253,76 +288,102 @@ metadata_dissemination_service::dispatch_get_metadata_update(
         });
 }
 
-void metadata_dissemination_service::collect_pending_updates() {
+metadata_dissemination_service::broker_updates_t
+metadata_dissemination_service::collect_pending_updates() {
     auto brokers = _members_table.local().all_broker_ids();
-    for (auto& ntp_leader : _requests) {
+    // entries at or below the version acked by every peer were already
+    // delivered everywhere and can be skipped without looking up topic
+    // metadata. a freshly seen peer starts from version 0 and receives the
+    // whole table
+    int64_t min_acked = _version;
+    for (auto& id : brokers) {
+        if (id != _self) {
+            min_acked = std::min(min_acked, _acked_versions[id]);
+        }
+    }
+    broker_updates_t updates;
+    for (auto it = _leaders_updates.begin(); it != _leaders_updates.end();) {
+        auto& [ntp, leader] = *it;
+        if (leader.version <= min_acked) {
+            ++it;
+            continue;
+        }
         auto tp_md = _topics.local().get_topic_metadata(
-          model::topic_namespace_view(ntp_leader.ntp));
-
+          model::topic_namespace_view(ntp));
         if (!tp_md) {
             // Topic metadata is not there anymore, partition was removed
+            it = _leaders_updates.erase(it);
             continue;
         }
         auto non_overlapping = calculate_non_overlapping_nodes(
-          get_partition_members(ntp_leader.ntp.tp.partition, *tp_md), brokers);
+          get_partition_members(ntp.tp.partition, *tp_md), brokers);
         for (auto& id : non_overlapping) {
-            if (!_pending_updates.contains(id)) {
-                _pending_updates.emplace(id, update_retry_meta{ntp_leaders{}});
+            if (leader.version <= _acked_versions[id]) {
+                // peer already acknowledged this entry
+                continue;
             }
-            _pending_updates[id].updates.push_back(ntp_leader);
-        }
-    }
-    _requests.clear();
-}
-
-void metadata_dissemination_service::cleanup_finished_updates() {
-    std::vector<model::node_id> _to_remove;
-    _to_remove.reserve(_pending_updates.size());
-    for (auto& [node_id, meta] : _pending_updates) {
-        if (meta.finished) {
-            _to_remove.push_back(node_id);
+            auto& batch = updates[id];
+            batch.version = _version;
+            batch.updates.push_back(
+              ntp_leader{ntp, leader.term, leader.leader_id});
         }
+        ++it;
     }
-    for (auto id : _to_remove) {
-        _pending_updates.erase(id);
-    }
+    return updates;
 }
 
 ss::future<> metadata_dissemination_service::dispatch_disseminate_leadership() {
-    collect_pending_updates();
-    return ss::parallel_for_each(
-             _pending_updates.begin(),
-             _pending_updates.end(),
-             [this](broker_updates_t::value_type& br_update) {
-                 return dispatch_one_update(br_update.first, br_update.second);
-             })
-      .then([this] { cleanup_finished_updates(); });
+    const auto round_version = _version;
+    return ss::do_with(
+      collect_pending_updates(),
+      [this, round_version](broker_updates_t& updates) {
+          return ss::parallel_for_each(
+                   updates.begin(),
+                   updates.end(),
+                   [this](broker_updates_t::value_type& br_update) {
+                       return dispatch_one_update(
+                         br_update.first, br_update.second);
+                   })
+            .then([this, &updates, round_version] {
+                // peers with no pending delta are current up to this round
+                for (auto& id : _members_table.local().all_broker_ids()) {
+                    if (id == _self || updates.contains(id)) {
+                        continue;
+                    }
+                    auto& acked = _acked_versions[id];
+                    acked = std::max(acked, round_version);
+                }
+            });
+      });
 }
 
 ss::future<> metadata_dissemination_service::dispatch_one_update(
-  model::node_id target_id, update_retry_meta& meta) {
+  model::node_id target_id, update_batch& batch) {
     return _clients.local()
       .with_node_client<metadata_dissemination_rpc_client_protocol>(
         _self,
         ss::this_shard_id(),
         target_id,
-        [this, &meta, target_id](
+        [this, &batch, target_id](
           metadata_dissemination_rpc_client_protocol proto) mutable {
             vlog(
               clusterlog.trace,
               "Sending {} metadata updates to {}",
-              meta.updates.size(),
+              batch.updates.size(),
               target_id);
             return proto
               .update_leadership(
-                update_leadership_request{meta.updates},
+                update_leadership_request{batch.updates},
                 rpc::client_opts(
                   _dissemination_interval + rpc::clock_type::now()))
               .then(&rpc::get_ctx_data<update_leadership_reply>);
         })
-      .then([target_id, &meta](result<update_leadership_reply> r) {
+      .then([this, target_id, &batch](result<update_leadership_reply> r) {
           if (r) {
-              meta.finished = true;
+              // everything up to the batch version was delivered, the next
+              // round will send only newer changes
+              auto& acked = _acked_versions[target_id];
+              acked = std::max(acked, batch.version);
               return;
           }
           vlog(
@@ -336,11 +397,43 @@ ss::future<> metadata_dissemination_service::dispatch_one_update(
       });
 }
 
+ss::future<> metadata_dissemination_service::dispatch_anti_entropy_sync() {
+    auto ids = _members_table.local().all_broker_ids();
+    ids.erase(std::remove(ids.begin(), ids.end(), _self), ids.end());
+    if (ids.empty()) {
+        return ss::make_ready_future<>();
+    }
+    auto id = ids[random_generators::get_int(ids.size() - 1)];
+    vlog(clusterlog.debug, "Anti-entropy metadata sync with node {}", id);
+    return dispatch_get_metadata_update(id)
+      .then([this, id](result<get_leadership_reply> r) {
+          if (!r) {
+              vlog(
+                clusterlog.debug,
+                "Anti-entropy metadata sync with node {} failed - {}",
+                id,
+                r.error().message());
+              return ss::make_ready_future<>();
+          }
+          return _leaders.invoke_on_all(
+            [reply = std::move(r.value())](
+              partition_leaders_table& leaders) mutable {
+                for (auto& l : reply.leaders) {
+                    leaders.update_partition_leader(l.ntp, l.term, l.leader_id);
+                }
+            });
+      })
+      .handle_exception([](const std::exception_ptr& e) {
+          vlog(clusterlog.debug, "Anti-entropy metadata sync error: {}", e);
+      });
+}
+
 ss::future<> metadata_dissemination_service::stop() {
     _raft_manager.local().unregister_leadership_notification(
       _notification_handle);
     _as.request_abort();
     _dispatch_timer.cancel();
+    _anti_entropy_timer.cancel();
     return _bg.close();
 }
 
@@ -37,10 +37,13 @@ namespace cluster {
 /// instances of raft group that current node have. Instace of raft group
 /// triggers leadership notification and by that mean updates leadership in
 /// metadata cache.
-/// The service caches all leadership updates and sends them as
-/// batch per node, every configurable period of time. This service is also
-/// responsible for querying one of the cluster nodes for current leadership
-/// metadata when node has started.
+/// The service keeps a versioned table of leadership updates and tracks the
+/// table version each peer acknowledged, so every dissemination round sends
+/// only the ntps that changed since the peer's acked version. A periodic
+/// anti-entropy sync pulls the full leadership metadata from a random node
+/// to reconcile anything missed. This service is also responsible for
+/// querying one of the cluster nodes for current leadership metadata when
+/// node has started.
 ///
 /// Used acronymes:
 /// RG<num> - raft group with <num> id
@@ -90,12 +93,19 @@ public:
     ss::future<> stop();
 
 private:
-    // Used to store pending updates
-    // When update was delivered successfully the finished flag is set to true
-    // and object is removed from pending updates map
-    struct update_retry_meta {
+    // Leadership state with the version it was assigned when it changed.
+    // The service keeps one entry per disseminated ntp and sends each peer
+    // only entries newer than the version that peer has acknowledged.
+    struct versioned_leader {
+        model::term_id term;
+        std::optional<model::node_id> leader_id;
+        int64_t version;
+    };
+    // Delta batch for one peer. version is the local table version the
+    // peer reaches once the batch is acknowledged.
+    struct update_batch {
         ntp_leaders updates;
-        bool finished = false;
+        int64_t version = 0;
     };
     // Used to track the process of requesting update when redpanda starts
     // when update using a node from ids will fail we will try the next one
@@ -108,18 +118,17 @@ private:
         exp_backoff_policy backoff_policy;
     };
 
-    using broker_updates_t
-      = absl::flat_hash_map<model::node_id, update_retry_meta>;
+    using broker_updates_t = absl::flat_hash_map<model::node_id, update_batch>;
 
     void handle_leadership_notification(
       model::ntp, model::term_id, std::optional<model::node_id>);
-    ss::future<> apply_leadership_notification(
-      model::ntp, model::term_id, std::optional<model::node_id>);
+    ss::future<> dispatch_pending_notifications();
+    ss::future<> apply_leadership_notifications(ntp_leaders);
 
-    void collect_pending_updates();
-    void cleanup_finished_updates();
+    broker_updates_t collect_pending_updates();
     ss::future<> dispatch_disseminate_leadership();
-    ss::future<> dispatch_one_update(model::node_id, update_retry_meta&);
+    ss::future<> dispatch_one_update(model::node_id, update_batch&);
+    ss::future<> dispatch_anti_entropy_sync();
     ss::future<result<get_leadership_reply>>
       dispatch_get_metadata_update(model::node_id);
     ss::future<> do_request_metadata_update(request_retry_meta&);
@@ -136,11 +145,23 @@ private:
     ss::sharded<rpc::connection_cache>& _clients;
     model::node_id _self;
     std::chrono::milliseconds _dissemination_interval;
-    std::vector<ntp_leader> _requests;
+    std::chrono::milliseconds _anti_entropy_interval;
     std::vector<model::node_id> _seed_server_ids;
-    broker_updates_t _pending_updates;
+    // per-shard staging buffer for leadership notifications. Raft invokes
+    // the notification callback once per group; during rolling restarts
+    // that is thousands of events in quick succession, so instead of one
+    // cross-shard hop per event everything that accumulates while a
+    // dispatch is in flight is shipped to shard 0 as a single batch
+    ntp_leaders _pending_notifications;
+    bool _notification_dispatch_in_flight{false};
+    // all of the fields below are only used on shard 0, where leadership
+    // notifications are applied
+    int64_t _version{0};
+    absl::flat_hash_map<model::ntp, versioned_leader> _leaders_updates;
+    absl::flat_hash_map<model::node_id, int64_t> _acked_versions;
     mutex _lock;
     ss::timer<> _dispatch_timer;
+    ss::timer<> _anti_entropy_timer;
     ss::abort_source _as;
     ss::gate _bg;
     cluster::notification_id_type _notification_handle;
@@ -12,6 +12,7 @@
 #pragma once
 #include "model/fundamental.h"
 #include "model/metadata.h"
+#include "reflection/async_adl.h"
 
 #include <ostream>
 
@@ -43,4 +44,20 @@ inline std::ostream& operator<<(std::ostream& o, const ntp_leader& l) {
     return o;
 }
 
-} // namespace cluster
\ No newline at end of file
+} // namespace cluster
+
+namespace reflection {
+/*
+ * Leadership snapshots carry one entry per partition. On a node hosting
+ * tens of thousands of partitions serializing them through the default
+ * synchronous adl monopolizes the reactor, so walk the leader vectors
+ * through the yielding field serializer. The encoding is unchanged.
+ */
+template<>
+struct async_adl<cluster::update_leadership_request>
+  : async_adl_struct<cluster::update_leadership_request> {};
+
+template<>
+struct async_adl<cluster::get_leadership_reply>
+  : async_adl_struct<cluster::get_leadership_reply> {};
+} // namespace reflection
\ No newline at end of file
@@ -51,6 +51,14 @@ public:
 
     model::offset start_offset() const { return _raft->start_offset(); }
 
+    model::offset dirty_offset() const { return _raft->dirty_offset(); }
+
+    /// replication queue depth of the group's batcher, in [0, 1]; input to
+    /// produce admission control
+    double replicate_batcher_usage() const {
+        return _raft->replicate_batcher_usage();
+    }
+
     /**
      * The returned value of last committed offset should not be used to
      * do things like initialize a reader (use partition::make_reader). Instead
@@ -96,6 +104,10 @@ public:
 
     bool is_leader() const { return _raft->is_leader(); }
 
+    /// \brief clock based leadership validation, see
+    /// raft::consensus::has_leader_lease()
+    bool has_leader_lease() const { return _raft->has_leader_lease(); }
+
     ss::future<std::error_code>
     transfer_leadership(std::optional<model::node_id> target) {
         return _raft->transfer_leadership(target);
@@ -35,22 +35,6 @@ void partition_allocator::rollback(const std::vector<model::broker_shard>& v) {
     }
 }
 
-static inline bool valid_machine_fault_domain_diversity(
-  const std::vector<model::broker_shard>& replicas) {
-    model::node_id sentinel = replicas.begin()->node_id;
-    const uint32_t unique = std::accumulate(
-      replicas.begin(),
-      replicas.end(),
-      uint32_t(1),
-      [&sentinel](uint32_t acc, const model::broker_shard& bs) {
-          if (sentinel != bs.node_id) {
-              acc += 1;
-          }
-          return acc;
-      });
-    return unique == replicas.size();
-}
-
 static bool is_machine_in_replicas(
   const allocation_node& machine,
   const std::vector<model::broker_shard>& replicas) {
@@ -62,8 +46,86 @@ static bool is_machine_in_replicas(
       });
 }
 
+void partition_allocator::setup_default_constraints() {
+    // replicas of one partition must live on distinct nodes
+    _constraints.emplace_back(
+      "distinct_nodes",
+      allocation_constraint::type::hard,
+      [](
+        const allocation_node& candidate,
+        const std::vector<model::broker_shard>& replicas) {
+          return !is_machine_in_replicas(candidate, replicas);
+      });
+    // spread replicas over distinct racks. nodes without rack information
+    // always match, clusters where racks cannot be satisfied fall back to
+    // node diversity only
+    _constraints.emplace_back(
+      "distinct_racks",
+      allocation_constraint::type::soft,
+      [this](
+        const allocation_node& candidate,
+        const std::vector<model::broker_shard>& replicas) {
+          if (!candidate.rack()) {
+              return true;
+          }
+          return std::none_of(
+            replicas.begin(),
+            replicas.end(),
+            [this, &candidate](const model::broker_shard& bs) {
+                auto it = _machines.find(bs.node_id);
+                return it != _machines.end()
+                       && it->second->rack() == candidate.rack();
+            });
+      });
+}
+
+allocation_node* partition_allocator::find_allocatable(
+  const std::vector<model::broker_shard>& replicas) {
+    // first pass honors every constraint. when the cluster cannot satisfy
+    // the soft ones, e.g. fewer racks than the replication factor, they are
+    // relaxed as a group instead of failing the allocation
+    for (auto relax_soft : {false, true}) {
+        const size_t candidates = _available_machines.size();
+        for (size_t i = 0; i < candidates; ++i) {
+            auto& rr = round_robin_ptr();
+            auto& machine = *rr;
+            rr++;
+            const bool allocatable = std::all_of(
+              _constraints.begin(),
+              _constraints.end(),
+              [&machine, &replicas, relax_soft](
+                const allocation_constraint& c) {
+                  return (relax_soft && c.is_soft())
+                         || c.matches(machine, replicas);
+              });
+            if (allocatable) {
+                return &machine;
+            }
+        }
+    }
+    return nullptr;
+}
+
+/// shard the hint designates on this node, if the node is part of the hint
+static std::optional<uint32_t> hinted_shard(
+  const allocation_node& machine,
+  const std::vector<model::broker_shard>* hint) {
+    if (hint == nullptr) {
+        return std::nullopt;
+    }
+    auto it = std::find_if(
+      hint->begin(), hint->end(), [&machine](const model::broker_shard& bs) {
+          return bs.node_id == machine.id();
+      });
+    if (it == hint->end()) {
+        return std::nullopt;
+    }
+    return it->shard;
+}
+
 std::optional<std::vector<model::broker_shard>>
-partition_allocator::allocate_replicas(int16_t replication_factor) {
+partition_allocator::allocate_replicas(
+  int16_t replication_factor, const std::vector<model::broker_shard>* hint) {
     std::vector<model::broker_shard> replicas;
     replicas.reserve(replication_factor);
 
@@ -73,27 +135,27 @@ partition_allocator::allocate_replicas(int16_t replication_factor) {
             rollback(replicas);
             return std::nullopt;
         }
-        auto& rr = round_robin_ptr();
-        auto& machine = *rr;
-        rr++;
-        if (is_machine_in_replicas(machine, replicas)) {
-            continue;
+        auto* machine = find_allocatable(replicas);
+        if (machine == nullptr) {
+            rollback(replicas);
+            return std::nullopt;
+        }
+        uint32_t cpu;
+        if (auto hinted = hinted_shard(*machine, hint); hinted) {
+            cpu = machine->allocate_near(*hinted);
+        } else {
+            cpu = machine->allocate();
         }
-        const uint32_t cpu = machine.allocate();
-        model::broker_shard bs{.node_id = machine.id(), .shard = cpu};
+        model::broker_shard bs{.node_id = machine->id(), .shard = cpu};
         replicas.push_back(bs);
-        if (machine.is_full()) {
-            _available_machines.erase(_available_machines.iterator_to(machine));
+        if (machine->is_full()) {
+            _available_machines.erase(
+              _available_machines.iterator_to(*machine));
         }
     }
-    if (!valid_machine_fault_domain_diversity(replicas)) {
-        rollback(replicas);
-        return std::nullopt;
-    }
     return replicas;
 }
 
-// FIXME: take into account broker.rack diversity & other constraints
 std::optional<partition_allocator::allocation_units>
 partition_allocator::allocate(const topic_configuration& cfg) {
     if (_available_machines.empty()) {
@@ -114,12 +176,18 @@ partition_allocator::allocate(const topic_configuration& cfg) {
           cap);
         return std::nullopt;
     }
+    const std::vector<model::broker_shard>* hint = nullptr;
+    if (auto it = _placement_hints.find(cfg.tp_ns);
+        it != _placement_hints.end()) {
+        hint = &it->second;
+    }
     std::vector<partition_assignment> ret;
     ret.reserve(cfg.partition_count);
     for (int32_t i = 0; i < cfg.partition_count; ++i) {
         // all replicas must belong to the same raft group
         raft::group_id partition_group = raft::group_id(_highest_group() + 1);
-        auto replicas_assignment = allocate_replicas(cfg.replication_factor);
+        auto replicas_assignment = allocate_replicas(
+          cfg.replication_factor, hint);
         if (replicas_assignment == std::nullopt) {
             rollback(ret);
             return std::nullopt;
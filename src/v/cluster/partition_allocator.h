@@ -16,6 +16,9 @@
 #include "utils/intrusive_list_helpers.h"
 #include "vassert.h"
 
+#include <seastar/util/noncopyable_function.hh>
+
+#include <absl/container/flat_hash_map.h>
 #include <boost/container/flat_map.hpp>
 #include <fmt/ostream.h>
 
@@ -33,10 +36,12 @@ public:
     allocation_node(
       model::node_id id,
       uint32_t cpus,
-      std::unordered_map<ss::sstring, ss::sstring> labels)
+      std::unordered_map<ss::sstring, ss::sstring> labels,
+      std::optional<ss::sstring> rack = std::nullopt)
       : _id(id)
       , _weights(cpus)
-      , _machine_labels(std::move(labels)) {
+      , _machine_labels(std::move(labels))
+      , _rack(std::move(rack)) {
         // add extra weights to core 0
         _weights[0] = core0_extra_weight;
         _partition_capacity = (cpus * max_allocations_per_core)
@@ -47,7 +52,8 @@ public:
       : _id(o._id)
       , _weights(std::move(o._weights))
       , _partition_capacity(o._partition_capacity)
-      , _machine_labels(std::move(o._machine_labels)) {
+      , _machine_labels(std::move(o._machine_labels))
+      , _rack(std::move(o._rack)) {
         _hook.swap_nodes(o._hook);
     }
 
@@ -58,6 +64,7 @@ public:
     uint32_t cpus() const { return _weights.size(); }
     model::node_id id() const { return _id; }
     uint32_t partition_capacity() const { return _partition_capacity; }
+    const std::optional<ss::sstring>& rack() const { return _rack; }
 
 private:
     friend partition_allocator;
@@ -76,6 +83,18 @@ private:
         _partition_capacity--;
         return std::distance(_weights.begin(), it);
     }
+    // prefer the given core if it still has capacity, otherwise fall back
+    // to the least loaded one
+    uint32_t allocate_near(uint32_t core) {
+        if (
+          core < _weights.size()
+          && _weights[core] < max_allocations_per_core) {
+            _weights[core]++;
+            _partition_capacity--;
+            return core;
+        }
+        return allocate();
+    }
     void deallocate(uint32_t core) {
         vassert(
           core < _weights.size(),
@@ -104,6 +123,8 @@ private:
     uint32_t _partition_capacity{0};
     /// generated by `rpk` usually in /etc/redpanda/machine_labels.json
     std::unordered_map<ss::sstring, ss::sstring> _machine_labels;
+    /// failure domain the machine belongs to, taken from broker properties
+    std::optional<ss::sstring> _rack;
 
     // for partition_allocator
     safe_intrusive_list_hook _hook;
@@ -111,6 +132,35 @@ private:
     friend std::ostream& operator<<(std::ostream&, const allocation_node&);
 };
 
+/// Constraint evaluated against a candidate node while picking the replicas
+/// of one partition. Hard constraints must always hold. Soft constraints are
+/// relaxed as a group when no node can satisfy them, e.g. a cluster with
+/// fewer racks than the replication factor still gets a full replica set.
+class allocation_constraint {
+public:
+    enum class type { hard, soft };
+    using evaluator = ss::noncopyable_function<bool(
+      const allocation_node&, const std::vector<model::broker_shard>&)>;
+
+    allocation_constraint(ss::sstring name, type t, evaluator ev)
+      : _name(std::move(name))
+      , _type(t)
+      , _ev(std::move(ev)) {}
+
+    const ss::sstring& name() const { return _name; }
+    bool is_soft() const { return _type == type::soft; }
+    bool matches(
+      const allocation_node& candidate,
+      const std::vector<model::broker_shard>& replicas) const {
+        return _ev(candidate, replicas);
+    }
+
+private:
+    ss::sstring _name;
+    type _type;
+    evaluator _ev;
+};
+
 struct partition_allocator_tester;
 class partition_allocator {
 public:
@@ -157,6 +207,28 @@ public:
     explicit partition_allocator(raft::group_id highest_known_group)
       : _highest_group(highest_known_group) {
         _rr = _available_machines.end();
+        setup_default_constraints();
+    }
+
+    /// registers an additional constraint evaluated after the default
+    /// distinct nodes and distinct racks ones
+    void add_allocation_constraint(allocation_constraint c) {
+        _constraints.push_back(std::move(c));
+    }
+
+    /// Registers a placement hint for a topic: replicas of its partitions
+    /// that land on a node present in the hint prefer the hinted shard on
+    /// that node. Used to co-locate a consumer group coordinator partition
+    /// with the data partitions the group commits to, saving a cross-shard
+    /// hop on every commit cycle. Purely advisory - a saturated shard falls
+    /// back to the least loaded one, and topics without a hint keep the
+    /// default spreading behavior.
+    void add_placement_hint(
+      model::topic_namespace tp_ns, std::vector<model::broker_shard> hint) {
+        _placement_hints.insert_or_assign(std::move(tp_ns), std::move(hint));
+    }
+    void remove_placement_hint(const model::topic_namespace& tp_ns) {
+        _placement_hints.erase(tp_ns);
     }
     void register_node(ptr n) {
         _available_machines.push_back(*n);
@@ -183,6 +255,10 @@ public:
 
     const underlying_t& allocation_nodes() { return _machines; }
 
+    /// highest raft group id ever observed; persisted with the controller
+    /// checkpoint so recovery from it starts group allocation past it
+    raft::group_id highest_group() const { return _highest_group; }
+
     ~partition_allocator() {
         _available_machines.clear();
         _rr = _available_machines.end();
@@ -196,9 +272,13 @@ private:
     void rollback(const std::vector<partition_assignment>& pa);
     void rollback(const std::vector<model::broker_shard>& v);
 
-    std::optional<std::vector<model::broker_shard>>
-    allocate_replicas(int16_t replication_factor);
+    std::optional<std::vector<model::broker_shard>> allocate_replicas(
+      int16_t replication_factor,
+      const std::vector<model::broker_shard>* hint);
     iterator find_node(model::node_id id);
+    void setup_default_constraints();
+    allocation_node*
+    find_allocatable(const std::vector<model::broker_shard>& replicas);
 
     [[gnu::always_inline]] inline cil_t::iterator& round_robin_ptr() {
         if (_rr == _available_machines.end()) {
@@ -211,6 +291,13 @@ private:
     cil_t::iterator _rr; // round robin
     cil_t _available_machines;
     underlying_t _machines;
+    std::vector<allocation_constraint> _constraints;
+    absl::flat_hash_map<
+      model::topic_namespace,
+      std::vector<model::broker_shard>,
+      model::topic_namespace_hash,
+      model::topic_namespace_eq>
+      _placement_hints;
 
     // for testing
     void test_only_saturate_all_machines();
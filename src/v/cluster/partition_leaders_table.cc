@@ -32,8 +32,19 @@ ss::future<> partition_leaders_table::stop() {
 
 std::optional<model::node_id> partition_leaders_table::get_leader(
   model::topic_namespace_view tp_ns, model::partition_id pid) const {
-    if (auto it = _leaders.find(leader_key_view{tp_ns, pid});
-        it != _leaders.end()) {
+    const auto key = leader_key_view{tp_ns, pid};
+    // kafka handlers resolve the same partition several times while serving
+    // one request. when the table was not modified since the previous
+    // lookup the cached entry can be returned with a key comparison,
+    // skipping the ns/topic string hashing of a map probe
+    if (
+      _last_lookup != nullptr && _last_lookup_version == _version
+      && leader_key_eq{}(_last_lookup->first, key)) {
+        return _last_lookup->second.id;
+    }
+    if (auto it = _leaders.find(key); it != _leaders.end()) {
+        _last_lookup = &*it;
+        _last_lookup_version = _version;
         return it->second.id;
     }
     return std::nullopt;
@@ -66,6 +77,7 @@ void partition_leaders_table::update_partition_leader(
     // existing partition
     it->second.id = leader_id;
     it->second.update_term = term;
+    ++_version;
 
     // notify waiters if update is setting the leader
     if (!leader_id) {
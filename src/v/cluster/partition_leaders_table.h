@@ -61,11 +61,17 @@ public:
     void remove_leader(const model::ntp& ntp) {
         _leaders.erase(
           leader_key_view{model::topic_namespace_view(ntp), ntp.tp.partition});
+        ++_version;
     }
 
     void update_partition_leader(
       const model::ntp&, model::term_id, std::optional<model::node_id>);
 
+    /// Monotonically increases with every leadership update applied on this
+    /// shard. Allows callers to invalidate results derived from the table
+    /// state.
+    uint64_t version() const { return _version; }
+
 private:
     // optimized to reduce number of ntp copies
     struct leader_key {
@@ -128,8 +134,16 @@ private:
         model::term_id update_term;
     };
 
-    absl::flat_hash_map<leader_key, leader_meta, leader_key_hash, leader_key_eq>
-      _leaders;
+    using leaders_map = absl::
+      flat_hash_map<leader_key, leader_meta, leader_key_hash, leader_key_eq>;
+
+    leaders_map _leaders;
+
+    // single entry lookup cache guarded by _version, see get_leader. every
+    // structural mutation of _leaders bumps _version and entry pointers are
+    // stable in between, so a version match proves the entry is still valid
+    mutable const leaders_map::value_type* _last_lookup{nullptr};
+    mutable uint64_t _last_lookup_version{0};
 
     // per-ntp notifications for leadership election. note that the
     // namespace is currently ignored pending an update to the metadata
@@ -137,6 +151,8 @@ private:
     absl::
       flat_hash_map<model::ntp, std::vector<expiring_promise<model::node_id>>>
         _leader_promises;
+
+    uint64_t _version{0};
 };
 
 } // namespace cluster
@@ -55,6 +55,12 @@ public:
         return nullptr;
     }
 
+    /// all partitions hosted on this shard, keyed by ntp
+    const absl::flat_hash_map<model::ntp, ss::lw_shared_ptr<partition>>&
+    partitions() const {
+        return _ntp_table;
+    }
+
     ss::future<> start() { return ss::now(); }
     ss::future<> stop();
     ss::future<consensus_ptr>
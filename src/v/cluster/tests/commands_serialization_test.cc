@@ -103,6 +103,33 @@ FIXTURE_TEST(test_create_topic_cmd_serialization, cmd_test_fixture) {
     });
 }
 
+FIXTURE_TEST(test_bulk_create_topic_cmds_serialization, cmd_test_fixture) {
+    std::vector<cluster::create_topic_cmd> cmds;
+    cmds.reserve(3);
+    for (int i = 0; i < 3; ++i) {
+        cmds.push_back(
+          make_create_topic_cmd(fmt::format("test_tp_{}", i), 2, 3));
+    }
+
+    // bulk creation packs one command per record into a single batch
+    auto batch = cluster::serialize_cmds(std::move(cmds)).get0();
+    BOOST_REQUIRE_EQUAL(batch.record_count(), 3);
+
+    auto records = batch.copy_records();
+    int i = 0;
+    for (auto& r : records) {
+        auto deser = cluster::deserialize(
+                       std::move(r),
+                       cluster::make_commands_list<cluster::create_topic_cmd>())
+                       .get0();
+        ss::visit(deser, [&i](cluster::create_topic_cmd c) {
+            BOOST_REQUIRE_EQUAL(
+              c.key.tp, model::topic(fmt::format("test_tp_{}", i)));
+        });
+        ++i;
+    }
+}
+
 FIXTURE_TEST(test_delete_topic_cmd_serialization, cmd_test_fixture) {
     auto cmd = make_delete_topic_cmd("test_tp");
 
@@ -197,4 +197,75 @@ FIXTURE_TEST(allocation_units_test, partition_allocator_tester) {
       machines().at(model::node_id(2))->partition_capacity(), max);
     // we do not decrement the highest raft group
     BOOST_REQUIRE_EQUAL(highest_group()(), partitions);
-}
\ No newline at end of file
+}
+// two racks with two nodes each, node i lives in rack i/2
+static void register_rack_aware_nodes(partition_allocator& allocator) {
+    for (int i = 0; i < 4; ++i) {
+        allocator.register_node(std::make_unique<allocation_node>(
+          model::node_id(i),
+          4,
+          std::unordered_map<ss::sstring, ss::sstring>(),
+          ss::sstring(fmt::format("rack_{}", i / 2))));
+    }
+}
+
+FIXTURE_TEST(rack_aware_assignment, partition_allocator_tester) {
+    partition_allocator allocator(raft::group_id(0));
+    register_rack_aware_nodes(allocator);
+    auto cfg = gen_topic_configuration(10, 2);
+    auto allocs = allocator.allocate(cfg).value();
+    BOOST_REQUIRE_EQUAL(allocs.get_assignments().size(), 10);
+    for (auto& p_as : allocs.get_assignments()) {
+        BOOST_REQUIRE_EQUAL(p_as.replicas.size(), 2);
+        // replicas of every partition must span both racks
+        BOOST_REQUIRE_NE(
+          p_as.replicas[0].node_id() / 2, p_as.replicas[1].node_id() / 2);
+    }
+}
+
+FIXTURE_TEST(rack_constraint_relaxation, partition_allocator_tester) {
+    // 3 replicas cannot span 3 racks in a two rack cluster, the rack
+    // constraint is relaxed and node diversity still holds
+    partition_allocator allocator(raft::group_id(0));
+    register_rack_aware_nodes(allocator);
+    auto cfg = gen_topic_configuration(1, 3);
+    auto allocs = allocator.allocate(cfg).value();
+    auto& replicas = allocs.get_assignments().begin()->replicas;
+    BOOST_REQUIRE_EQUAL(replicas.size(), 3);
+    BOOST_REQUIRE_NE(replicas[0].node_id, replicas[1].node_id);
+    BOOST_REQUIRE_NE(replicas[1].node_id, replicas[2].node_id);
+    BOOST_REQUIRE_NE(replicas[0].node_id, replicas[2].node_id);
+}
+
+FIXTURE_TEST(placement_hint_prefers_hinted_shard, partition_allocator_tester) {
+    std::vector<model::broker_shard> hint;
+    for (uint32_t n = 0; n < partition_allocator_tester::max_nodes; n++) {
+        hint.push_back({model::node_id(n), 7});
+    }
+    pa.add_placement_hint(
+      model::topic_namespace(model::ns("test_ns"), model::topic("w00t")),
+      std::move(hint));
+    auto cfg = gen_topic_configuration(4, 3);
+    auto allocs = pa.allocate(cfg).value();
+    for (auto& as : allocs.get_assignments()) {
+        for (auto& bs : as.replicas) {
+            BOOST_REQUIRE_EQUAL(bs.shard, 7);
+        }
+    }
+}
+
+FIXTURE_TEST(removed_placement_hint_is_ignored, partition_allocator_tester) {
+    auto tp_ns = model::topic_namespace(
+      model::ns("test_ns"), model::topic("w00t"));
+    pa.add_placement_hint(
+      tp_ns, {model::broker_shard{model::node_id(0), 7}});
+    pa.remove_placement_hint(tp_ns);
+    auto cfg = gen_topic_configuration(1, 3);
+    auto allocs = pa.allocate(cfg).value();
+    for (auto& as : allocs.get_assignments()) {
+        for (auto& bs : as.replicas) {
+            // default placement: the least loaded core of each node
+            BOOST_REQUIRE_NE(bs.shard, 7);
+        }
+    }
+}
@@ -501,3 +501,42 @@ FIXTURE_TEST(add_two_nodes_to_replica_set, partition_assignment_test_fixture) {
 
     validate_replicas_recovery(ntp, new_replica_set, reference_batches);
 }
+
+FIXTURE_TEST(move_via_controller_api, partition_assignment_test_fixture) {
+    create_topic(test_topics_configuration(1));
+
+    auto reference_batches = replicate_data(ntp, 10);
+
+    std::vector<model::broker_shard> new_replica_set;
+    new_replica_set.push_back(model::broker_shard{
+      .node_id = nodes[2],
+      .shard = ss::this_shard_id(),
+    });
+
+    auto ec = get_leader_controller()
+                ->move_partition_replicas(ntp, new_replica_set, model::no_timeout)
+                .get0();
+    BOOST_REQUIRE_EQUAL(ec, cluster::errc::success);
+
+    // check topics table
+    wait_for_metadata_update(ntp, new_replica_set).get0();
+    // check if replicas are there
+    wait_for_replica_set_partitions(ntp, new_replica_set);
+
+    validate_replicas_recovery(ntp, new_replica_set, reference_batches);
+}
+
+FIXTURE_TEST(
+  move_via_controller_rejects_unknown_node, partition_assignment_test_fixture) {
+    create_topic(test_topics_configuration(1));
+
+    std::vector<model::broker_shard> new_replica_set;
+    // node 10 was never added to the cluster
+    new_replica_set.push_back(
+      model::broker_shard{.node_id = model::node_id(10), .shard = 0});
+
+    auto ec = get_leader_controller()
+                ->move_partition_replicas(ntp, new_replica_set, model::no_timeout)
+                .get0();
+    BOOST_REQUIRE_EQUAL(ec, cluster::errc::node_does_not_exists);
+}
@@ -31,6 +31,7 @@ SEASTAR_THREAD_TEST_CASE(topic_config_rt_test) {
     cfg.segment_size = std::optional<size_t>(1_GiB);
     cfg.retention_bytes = tristate<size_t>{};
     cfg.retention_duration = tristate<std::chrono::milliseconds>(10h);
+    cfg.durability = storage::durability_mode::raft_quorum;
 
     auto d = serialize_roundtrip_rpc(std::move(cfg));
 
@@ -48,6 +49,7 @@ SEASTAR_THREAD_TEST_CASE(topic_config_rt_test) {
       model::compaction_strategy::offset, d.compaction_strategy);
     BOOST_CHECK(10h == d.retention_duration.value());
     BOOST_REQUIRE_EQUAL(tristate<size_t>{}, d.retention_bytes);
+    BOOST_CHECK(storage::durability_mode::raft_quorum == d.durability);
 }
 
 SEASTAR_THREAD_TEST_CASE(broker_metadata_rt_test) {
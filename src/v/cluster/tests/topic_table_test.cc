@@ -115,3 +115,25 @@ FIXTURE_TEST(test_wait_aborted, topic_table_fixture) {
       table.local().wait_for_changes(local_as).get0(),
       ss::abort_requested_exception);
 }
+
+FIXTURE_TEST(test_metadata_snapshot_sharing, topic_table_fixture) {
+    create_topics();
+
+    auto snap = table.local().metadata_snapshot();
+    BOOST_REQUIRE_EQUAL(snap->size(), 3);
+    // an unchanged table hands out the same shared listing
+    BOOST_REQUIRE(table.local().metadata_snapshot() == snap);
+
+    table.local()
+      .apply(
+        cluster::delete_topic_cmd(
+          make_tp_ns("test_tp_2"), make_tp_ns("test_tp_2")),
+        model::offset(0))
+      .get0();
+
+    auto snap_2 = table.local().metadata_snapshot();
+    BOOST_REQUIRE(snap_2 != snap);
+    BOOST_REQUIRE_EQUAL(snap_2->size(), 2);
+    // the old snapshot still pins the state it was taken from
+    BOOST_REQUIRE_EQUAL(snap->size(), 3);
+}
@@ -157,6 +157,50 @@ FIXTURE_TEST(
       node_initial_capacity(4) - (1));
 }
 
+FIXTURE_TEST(
+  test_dispatching_bulk_create, topic_table_updates_dispatcher_fixture) {
+    // bulk creation packs all topics into a single batch, one command per
+    // record
+    std::vector<cluster::create_topic_cmd> cmds;
+    cmds.push_back(make_create_topic_cmd("test_tp_1", 1, 3));
+    cmds.push_back(make_create_topic_cmd("test_tp_2", 12, 3));
+    cmds.push_back(make_create_topic_cmd("test_tp_3", 8, 1));
+
+    auto res = dispatcher
+                 .apply_update(serialize_cmds(std::move(cmds)).get0())
+                 .get0();
+    BOOST_REQUIRE_EQUAL(res, cluster::errc::success);
+
+    auto md = table.local().all_topics_metadata();
+    BOOST_REQUIRE_EQUAL(md.size(), 3);
+    std::sort(
+      md.begin(),
+      md.end(),
+      [](const model::topic_metadata& a, const model::topic_metadata& b) {
+          return a.tp_ns.tp < b.tp_ns.tp;
+      });
+    BOOST_REQUIRE_EQUAL(md[0].partitions.size(), 1);
+    BOOST_REQUIRE_EQUAL(md[1].partitions.size(), 12);
+    BOOST_REQUIRE_EQUAL(md[2].partitions.size(), 8);
+}
+
+FIXTURE_TEST(
+  test_dispatching_bulk_create_duplicate,
+  topic_table_updates_dispatcher_fixture) {
+    create_topics();
+    // a duplicate in the batch fails while the new topic still applies; the
+    // failure becomes the batch result
+    std::vector<cluster::create_topic_cmd> cmds;
+    cmds.push_back(make_create_topic_cmd("test_tp_1", 1, 3));
+    cmds.push_back(make_create_topic_cmd("test_tp_4", 2, 1));
+
+    auto res = dispatcher
+                 .apply_update(serialize_cmds(std::move(cmds)).get0())
+                 .get0();
+    BOOST_REQUIRE_EQUAL(res, cluster::errc::topic_already_exists);
+    BOOST_REQUIRE_EQUAL(table.local().all_topics_metadata().size(), 4);
+}
+
 FIXTURE_TEST(
   test_dispatching_conflicts, topic_table_updates_dispatcher_fixture) {
     create_topics();
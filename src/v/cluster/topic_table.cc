@@ -56,10 +56,39 @@ topic_table::apply(create_topic_cmd cmd, model::offset offset) {
     }
 
     _topics.insert({cmd.key, std::move(cmd.value)});
+    ++_version;
     notify_waiters();
     return ss::make_ready_future<std::error_code>(errc::success);
 }
 
+std::vector<topic_configuration_assignment> topic_table::snapshot() const {
+    std::vector<topic_configuration_assignment> ret;
+    ret.reserve(_topics.size());
+    for (const auto& [tp_ns, assigned_cfg] : _topics) {
+        ret.push_back(assigned_cfg);
+    }
+    return ret;
+}
+
+ss::future<> topic_table::load_snapshot(
+  std::vector<topic_configuration_assignment> topics, model::offset offset) {
+    vassert(
+      _topics.empty(),
+      "can only load a checkpoint into an empty topic table");
+    for (auto& t : topics) {
+        for (auto& pas : t.assignments) {
+            auto ntp = model::ntp(t.cfg.tp_ns.ns, t.cfg.tp_ns.tp, pas.id);
+            _pending_deltas.emplace_back(
+              std::move(ntp), pas, offset, delta::op_type::add);
+        }
+        auto tp_ns = t.cfg.tp_ns;
+        _topics.insert({std::move(tp_ns), std::move(t)});
+    }
+    ++_version;
+    notify_waiters();
+    return ss::now();
+}
+
 ss::future<> topic_table::stop() {
     for (auto& w : _waiters) {
         w->promise.set_exception(ss::abort_requested_exception());
@@ -76,6 +105,7 @@ topic_table::apply(delete_topic_cmd cmd, model::offset offset) {
               std::move(ntp), std::move(p), offset, delta::op_type::del);
         }
         _topics.erase(tp);
+        ++_version;
         notify_waiters();
         return ss::make_ready_future<std::error_code>(errc::success);
     }
@@ -108,6 +138,7 @@ topic_table::apply(move_partition_replicas_cmd cmd, model::offset o) {
     _pending_deltas.emplace_back(
       std::move(ntp), *current_assignment_it, o, delta::op_type::update);
 
+    ++_version;
     notify_waiters();
 
     return ss::make_ready_future<std::error_code>(errc::success);
@@ -188,10 +219,35 @@ topic_table::get_topic_timestamp_type(model::topic_namespace_view tp) const {
     return {};
 }
 
+std::optional<model::compression>
+topic_table::get_topic_compression(model::topic_namespace_view tp) const {
+    if (auto it = _topics.find(tp); it != _topics.end()) {
+        return it->second.cfg.compression;
+    }
+    return {};
+}
+
 std::vector<model::topic_metadata> topic_table::all_topics_metadata() const {
-    return transform_topics([](const topic_configuration_assignment& td) {
-        return td.get_metadata();
-    });
+    // copy of the shared snapshot: cheaper than re-materializing and
+    // re-sorting every topic's partition listing, and the snapshot stays
+    // cached for the zero copy readers
+    return *metadata_snapshot();
+}
+
+topic_table::metadata_snapshot_ptr topic_table::metadata_snapshot() const {
+    if (!_metadata_snapshot || _snapshot_version != _version) {
+        _metadata_snapshot
+          = ss::make_lw_shared<const std::vector<model::topic_metadata>>(
+            transform_topics([](const topic_configuration_assignment& td) {
+                return td.get_metadata();
+            }));
+        _snapshot_version = _version;
+    }
+    return _metadata_snapshot;
+}
+
+bool topic_table::contains(model::topic_namespace_view topic) const {
+    return _topics.find(topic) != _topics.end();
 }
 
 bool topic_table::contains(
@@ -17,6 +17,8 @@
 #include "model/fundamental.h"
 #include "utils/expiring_promise.h"
 
+#include <seastar/core/shared_ptr.hh>
+
 #include <absl/container/flat_hash_map.h>
 
 namespace cluster {
@@ -70,6 +72,18 @@ public:
 
     ss::future<> stop();
 
+    /// Checkpoint API
+
+    /// Copy of the full table, used to materialize a controller checkpoint
+    std::vector<topic_configuration_assignment> snapshot() const;
+
+    /// Seeds the table from a checkpoint taken at the given offset. Emits an
+    /// add delta for every partition so the backend reconciles local state
+    /// exactly as it would during log replay. Must run on an empty table,
+    /// before the controller stm starts applying.
+    ss::future<>
+      load_snapshot(std::vector<topic_configuration_assignment>, model::offset);
+
     /// Delta API
 
     ss::future<std::vector<delta>> wait_for_changes(ss::abort_source&);
@@ -99,9 +113,30 @@ public:
     std::optional<model::timestamp_type>
       get_topic_timestamp_type(model::topic_namespace_view) const;
 
+    ///\brief Returns topics storage compression type
+    ///
+    /// Empty optional when the topic does not exist or does not configure a
+    /// storage codec (batches are stored with the producer codec)
+    std::optional<model::compression>
+      get_topic_compression(model::topic_namespace_view) const;
+
     /// Returns metadata of all topics.
     std::vector<model::topic_metadata> all_topics_metadata() const;
 
+    /// Immutable shared snapshot of the full metadata listing.
+    using metadata_snapshot_ptr
+      = ss::lw_shared_ptr<const std::vector<model::topic_metadata>>;
+
+    /// Returns a snapshot of the metadata of all topics. The listing is
+    /// materialized lazily on the first call after a mutation and the same
+    /// shared vector is handed to every caller until the table changes, so
+    /// concurrent listings iterate shared state with zero copies and stay
+    /// consistent across scheduling points.
+    metadata_snapshot_ptr metadata_snapshot() const;
+
+    /// Checks if it has given topic
+    bool contains(model::topic_namespace_view) const;
+
     /// Checks if it has given partition
     bool contains(model::topic_namespace_view, model::partition_id) const;
 
@@ -112,6 +147,11 @@ public:
     void update_partition_leader(
       const model::ntp&, model::term_id, std::optional<model::node_id>);
 
+    /// Monotonically increases with every topic or assignment change applied
+    /// on this shard. Allows callers to invalidate results derived from the
+    /// table state.
+    uint64_t version() const { return _version; }
+
 private:
     struct waiter {
         explicit waiter(uint64_t id)
@@ -138,5 +178,10 @@ private:
     std::vector<delta> _pending_deltas;
     std::vector<std::unique_ptr<waiter>> _waiters;
     uint64_t _waiter_id{0};
+    uint64_t _version{0};
+    // lazily materialized listing shared by readers, rebuilt only when
+    // _version has moved since it was taken
+    mutable metadata_snapshot_ptr _metadata_snapshot;
+    mutable uint64_t _snapshot_version{0};
 };
 } // namespace cluster
@@ -27,59 +27,83 @@ topic_updates_dispatcher::topic_updates_dispatcher(
 ss::future<std::error_code>
 topic_updates_dispatcher::apply_update(model::record_batch b) {
     auto base_offset = b.base_offset();
-    return deserialize(std::move(b), commands)
-      .then([this, base_offset](auto cmd) {
-          return ss::visit(
-            std::move(cmd),
-            [this, base_offset](delete_topic_cmd del_cmd) {
-                // delete case - we need state copy to
-                auto tp_md = _topic_table.local().get_topic_metadata(
-                  del_cmd.value);
-                return dispatch_updates_to_cores(del_cmd, base_offset)
-                  .then([this, tp_md](std::error_code ec) {
-                      if (ec == errc::success) {
-                          vassert(
-                            tp_md.has_value(),
-                            "Topic had to exist before successful delete");
-                          deallocate_topic(*tp_md);
-                      }
-                      return ec;
-                  });
-            },
-            [this, base_offset](create_topic_cmd create_cmd) {
-                return dispatch_updates_to_cores(create_cmd, base_offset)
-                  .then([this, create_cmd](std::error_code ec) {
-                      if (ec == errc::success) {
-                          update_allocations(create_cmd);
-                      }
-                      return ec;
-                  });
-            },
-            [this, base_offset](move_partition_replicas_cmd cmd) {
-                auto tp_md = _topic_table.local().get_topic_metadata(
-                  model::topic_namespace_view(cmd.key));
-                return dispatch_updates_to_cores(cmd, base_offset)
-                  .then([this, tp_md, cmd](std::error_code ec) {
-                      if (!ec) {
-                          vassert(
-                            tp_md.has_value(),
-                            "Topic had to exist before successful partition "
-                            "reallocation");
-                          auto it = std::find_if(
-                            std::cbegin(tp_md->partitions),
-                            std::cend(tp_md->partitions),
-                            [p_id = cmd.key.tp.partition](
-                              const model::partition_metadata& pmd) {
-                                return pmd.id == p_id;
-                            });
-                          vassert(
-                            it != tp_md->partitions.cend(),
-                            "Reassigned partition must exist");
+    // a batch may carry many commands - bulk topic creation packs one
+    // create per requested topic so the whole set commits in a single
+    // controller round. records apply independently in log order and the
+    // first failure becomes the batch result
+    return ss::do_with(
+      b.copy_records(),
+      std::error_code(errc::success),
+      [this, base_offset](auto& records, std::error_code& result) {
+          return ss::do_for_each(
+                   records,
+                   [this, base_offset, &result](model::record& r) {
+                       return deserialize(std::move(r), commands)
+                         .then([this, base_offset](auto cmd) {
+                             return apply_cmd(std::move(cmd), base_offset);
+                         })
+                         .then([&result](std::error_code ec) {
+                             if (result == errc::success) {
+                                 result = ec;
+                             }
+                         });
+                   })
+            .then([&result] { return result; });
+      });
+}
 
-                          reallocate_partition(it->replicas, cmd.value);
-                      }
-                      return ec;
-                  });
+ss::future<std::error_code> topic_updates_dispatcher::apply_cmd(
+  command_variant cmd, model::offset base_offset) {
+    return ss::visit(
+      std::move(cmd),
+      [this, base_offset](delete_topic_cmd del_cmd) {
+          // delete case - we need state copy to
+          auto tp_md = _topic_table.local().get_topic_metadata(
+            del_cmd.value);
+          return dispatch_updates_to_cores(del_cmd, base_offset)
+            .then([this, tp_md](std::error_code ec) {
+                if (ec == errc::success) {
+                    vassert(
+                      tp_md.has_value(),
+                      "Topic had to exist before successful delete");
+                    deallocate_topic(*tp_md);
+                }
+                return ec;
+            });
+      },
+      [this, base_offset](create_topic_cmd create_cmd) {
+          return dispatch_updates_to_cores(create_cmd, base_offset)
+            .then([this, create_cmd](std::error_code ec) {
+                if (ec == errc::success) {
+                    update_allocations(create_cmd);
+                }
+                return ec;
+            });
+      },
+      [this, base_offset](move_partition_replicas_cmd cmd) {
+          auto tp_md = _topic_table.local().get_topic_metadata(
+            model::topic_namespace_view(cmd.key));
+          return dispatch_updates_to_cores(cmd, base_offset)
+            .then([this, tp_md, cmd](std::error_code ec) {
+                if (!ec) {
+                    vassert(
+                      tp_md.has_value(),
+                      "Topic had to exist before successful partition "
+                      "reallocation");
+                    auto it = std::find_if(
+                      std::cbegin(tp_md->partitions),
+                      std::cend(tp_md->partitions),
+                      [p_id = cmd.key.tp.partition](
+                        const model::partition_metadata& pmd) {
+                          return pmd.id == p_id;
+                      });
+                    vassert(
+                      it != tp_md->partitions.cend(),
+                      "Reassigned partition must exist");
+
+                    reallocate_partition(it->replicas, cmd.value);
+                }
+                return ec;
             });
       });
 }
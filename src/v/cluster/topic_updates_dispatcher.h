@@ -17,6 +17,9 @@
 
 #include <seastar/core/sharded.hh>
 
+#include <system_error>
+#include <variant>
+
 namespace cluster {
 
 // The topic updates dispatcher is resposible for receiving update_apply upcalls
@@ -58,11 +61,18 @@ public:
       delete_topic_cmd,
       move_partition_replicas_cmd>();
 
+    using command_variant = std::variant<
+      create_topic_cmd,
+      delete_topic_cmd,
+      move_partition_replicas_cmd>;
+
     bool is_batch_applicable(const model::record_batch& batch) const {
         return batch.header().type == topic_batch_type;
     }
 
 private:
+    ss::future<std::error_code> apply_cmd(command_variant, model::offset);
+
     template<typename Cmd>
     ss::future<std::error_code> dispatch_updates_to_cores(Cmd, model::offset);
 
@@ -62,18 +62,7 @@ ss::future<std::vector<topic_result>> topics_frontend::create_topics(
               return ss::make_ready_future<std::vector<topic_result>>(
                 create_topic_results(topics, errc::not_leader_controller));
           }
-          std::vector<ss::future<topic_result>> futures;
-          futures.reserve(topics.size());
-
-          std::transform(
-            std::begin(topics),
-            std::end(topics),
-            std::back_inserter(futures),
-            [this, timeout](topic_configuration& t_cfg) {
-                return do_create_topic(std::move(t_cfg), timeout);
-            });
-
-          return ss::when_all_succeed(futures.begin(), futures.end());
+          return do_create_topics(std::move(topics), timeout);
       });
 }
 
@@ -125,56 +114,128 @@ ss::future<std::error_code> topics_frontend::replicate_and_wait(
       });
 }
 
-ss::future<topic_result> topics_frontend::do_create_topic(
-  topic_configuration t_cfg, model::timeout_clock::time_point timeout) {
-    if (!validate_topic_name(t_cfg.tp_ns)) {
-        return ss::make_ready_future<topic_result>(
-          topic_result(t_cfg.tp_ns, errc::invalid_topic_name));
+template<typename Cmd>
+ss::future<std::error_code> topics_frontend::replicate_and_wait_many(
+  std::vector<Cmd> cmds, model::timeout_clock::time_point timeout) {
+    return _stm.invoke_on(
+      controller_stm_shard,
+      [cmds = std::move(cmds), &as = _as, timeout](
+        controller_stm& stm) mutable {
+          return serialize_cmds(std::move(cmds))
+            .then([&stm, timeout, &as](model::record_batch b) {
+                return stm.replicate_and_wait(
+                  std::move(b), timeout, as.local());
+            });
+      });
+}
+
+ss::future<std::vector<topic_result>> topics_frontend::do_create_topics(
+  std::vector<topic_configuration> topics,
+  model::timeout_clock::time_point timeout) {
+    std::vector<topic_result> results;
+    std::vector<topic_configuration> valid;
+    valid.reserve(topics.size());
+    for (auto& t_cfg : topics) {
+        if (!validate_topic_name(t_cfg.tp_ns)) {
+            results.emplace_back(t_cfg.tp_ns, errc::invalid_topic_name);
+            continue;
+        }
+        valid.push_back(std::move(t_cfg));
     }
+    if (valid.empty()) {
+        return ss::make_ready_future<std::vector<topic_result>>(
+          std::move(results));
+    }
+    // allocate the whole request in a single allocator pass - one
+    // cross-shard hop instead of one per topic
     return _allocator
       .invoke_on(
         partition_allocator::shard,
-        [t_cfg](partition_allocator& al) { return al.allocate(t_cfg); })
+        [valid](partition_allocator& al) {
+            std::vector<std::optional<partition_allocator::allocation_units>>
+              units;
+            units.reserve(valid.size());
+            for (auto& t_cfg : valid) {
+                units.push_back(al.allocate(t_cfg));
+            }
+            return units;
+        })
       .then(
-        [this, t_cfg = std::move(t_cfg), timeout](
-          std::optional<partition_allocator::allocation_units> units) mutable {
-            // no assignments, error
-            if (!units) {
-                return ss::make_ready_future<topic_result>(
-                  topic_result(t_cfg.tp_ns, errc::topic_invalid_partitions));
+        [this,
+         results = std::move(results),
+         valid = std::move(valid),
+         timeout](
+          std::vector<std::optional<partition_allocator::allocation_units>>
+            units) mutable {
+            std::vector<topic_configuration> allocated;
+            std::vector<partition_allocator::allocation_units> allocated_units;
+            allocated.reserve(valid.size());
+            allocated_units.reserve(valid.size());
+            for (size_t i = 0; i < valid.size(); ++i) {
+                // no assignments, error
+                if (!units[i]) {
+                    results.emplace_back(
+                      valid[i].tp_ns, errc::topic_invalid_partitions);
+                    continue;
+                }
+                allocated.push_back(std::move(valid[i]));
+                allocated_units.push_back(std::move(*units[i]));
             }
-
-            return replicate_create_topic(
-              std::move(t_cfg), std::move(*units), timeout);
+            if (allocated.empty()) {
+                return ss::make_ready_future<std::vector<topic_result>>(
+                  std::move(results));
+            }
+            return replicate_create_topics(
+                     std::move(allocated), std::move(allocated_units), timeout)
+              .then([results = std::move(results)](
+                      std::vector<topic_result> replicated) mutable {
+                  std::move(
+                    replicated.begin(),
+                    replicated.end(),
+                    std::back_inserter(results));
+                  return std::move(results);
+              });
         });
 }
 
-ss::future<topic_result> topics_frontend::replicate_create_topic(
-  topic_configuration cfg,
-  partition_allocator::allocation_units units,
+ss::future<std::vector<topic_result>> topics_frontend::replicate_create_topics(
+  std::vector<topic_configuration> cfgs,
+  std::vector<partition_allocator::allocation_units> units,
   model::timeout_clock::time_point timeout) {
-    auto tp_ns = cfg.tp_ns;
-    create_topic_cmd cmd(
-      tp_ns,
-      topic_configuration_assignment(std::move(cfg), units.get_assignments()));
-
+    std::vector<create_topic_cmd> cmds;
+    cmds.reserve(cfgs.size());
+    std::vector<model::topic_namespace> tp_nss;
+    tp_nss.reserve(cfgs.size());
     std::vector<ntp_leader> leaders;
-    leaders.reserve(cmd.value.assignments.size());
-    for (auto& p_as : cmd.value.assignments) {
-        std::shuffle(
-          p_as.replicas.begin(),
-          p_as.replicas.end(),
-          random_generators::internal::gen);
-        // guesstimate leaders
-        leaders.emplace_back(
-          model::ntp(tp_ns.ns, tp_ns.tp, p_as.id),
-          p_as.replicas.begin()->node_id);
+    for (size_t i = 0; i < cfgs.size(); ++i) {
+        auto tp_ns = cfgs[i].tp_ns;
+        create_topic_cmd cmd(
+          tp_ns,
+          topic_configuration_assignment(
+            std::move(cfgs[i]), units[i].get_assignments()));
+        for (auto& p_as : cmd.value.assignments) {
+            std::shuffle(
+              p_as.replicas.begin(),
+              p_as.replicas.end(),
+              random_generators::internal::gen);
+            // guesstimate leaders
+            leaders.emplace_back(
+              model::ntp(tp_ns.ns, tp_ns.tp, p_as.id),
+              p_as.replicas.begin()->node_id);
+        }
+        cmds.push_back(std::move(cmd));
+        tp_nss.push_back(std::move(tp_ns));
     }
 
-    return replicate_and_wait(std::move(cmd), timeout)
+    // one record per topic packed into a single batch - a 500 topic
+    // provisioning burst costs one controller replication round instead of
+    // 500. the tradeoff is error granularity: apply-time failures (e.g. a
+    // concurrent create racing us to a name) surface as the shared batch
+    // result for every topic in it
+    return replicate_and_wait_many(std::move(cmds), timeout)
       .then_wrapped(
         [this,
-         tp_ns = std::move(tp_ns),
+         tp_nss = std::move(tp_nss),
          units = std::move(units),
          leaders = std::move(leaders)](ss::future<std::error_code> f) mutable {
             try {
@@ -184,18 +245,18 @@ ss::future<topic_result> topics_frontend::replicate_create_topic(
                     ret_f = update_leaders_with_estimates(std::move(leaders));
                 }
 
-                return ret_f.then([tp_ns = std::move(tp_ns),
+                return ret_f.then([tp_nss = std::move(tp_nss),
                                    error_code]() mutable {
-                    return topic_result(std::move(tp_ns), map_errc(error_code));
+                    return create_topic_results(tp_nss, map_errc(error_code));
                 });
 
             } catch (...) {
                 vlog(
                   clusterlog.warn,
-                  "Unable to create topic - {}",
+                  "Unable to create topics - {}",
                   std::current_exception());
-                return ss::make_ready_future<topic_result>(
-                  topic_result(std::move(tp_ns), errc::replication_error));
+                return ss::make_ready_future<std::vector<topic_result>>(
+                  create_topic_results(tp_nss, errc::replication_error));
             }
         });
 }
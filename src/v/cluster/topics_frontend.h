@@ -57,12 +57,17 @@ public:
 private:
     using ntp_leader = std::pair<model::ntp, model::node_id>;
 
-    ss::future<topic_result>
-      do_create_topic(topic_configuration, model::timeout_clock::time_point);
+    /// validates names and allocates the whole set in one partition
+    /// allocator pass, then hands the surviving topics to
+    /// replicate_create_topics
+    ss::future<std::vector<topic_result>> do_create_topics(
+      std::vector<topic_configuration>, model::timeout_clock::time_point);
 
-    ss::future<topic_result> replicate_create_topic(
-      topic_configuration,
-      partition_allocator::allocation_units,
+    /// commits all topics through a single controller replication round
+    /// (one command record per topic in one batch)
+    ss::future<std::vector<topic_result>> replicate_create_topics(
+      std::vector<topic_configuration>,
+      std::vector<partition_allocator::allocation_units>,
       model::timeout_clock::time_point);
 
     ss::future<topic_result>
@@ -72,6 +77,10 @@ private:
     ss::future<std::error_code>
     replicate_and_wait(Cmd&&, model::timeout_clock::time_point);
 
+    template<typename Cmd>
+    ss::future<std::error_code>
+    replicate_and_wait_many(std::vector<Cmd>, model::timeout_clock::time_point);
+
     ss::future<std::vector<topic_result>> dispatch_create_to_leader(
       model::node_id,
       std::vector<topic_configuration>,
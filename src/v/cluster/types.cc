@@ -33,7 +33,8 @@ storage::ntp_config topic_configuration::make_ntp_config(
   model::partition_id p_id,
   model::revision_id rev) const {
     auto has_overrides = cleanup_policy_bitflags || compaction_strategy
-                         || segment_size || retention_bytes.has_value()
+                         || segment_size || io_shares || durability
+                         || ephemeral || retention_bytes.has_value()
                          || retention_bytes.is_disabled()
                          || retention_duration.has_value()
                          || retention_duration.is_disabled();
@@ -45,6 +46,9 @@ storage::ntp_config topic_configuration::make_ntp_config(
             .cleanup_policy_bitflags = cleanup_policy_bitflags,
             .compaction_strategy = compaction_strategy,
             .segment_size = segment_size,
+            .io_shares = io_shares,
+            .durability = durability,
+            .ephemeral = ephemeral,
             .retention_bytes = retention_bytes,
             .retention_time = retention_duration});
     }
@@ -81,7 +85,8 @@ std::ostream& operator<<(std::ostream& o, const topic_configuration& cfg) {
       "{{ topic: {}, partition_count: {}, replication_factor: {}, compression: "
       "{}, cleanup_policy_bitflags: {}, compaction_strategy: {}, "
       "retention_bytes: {}, "
-      "retention_duration_hours: {}, segment_size: {}, timestamp_type: {} }}",
+      "retention_duration_hours: {}, segment_size: {}, io_shares: {}, "
+      "durability: {}, ephemeral: {}, timestamp_type: {} }}",
       cfg.tp_ns,
       cfg.partition_count,
       cfg.replication_factor,
@@ -91,6 +96,9 @@ std::ostream& operator<<(std::ostream& o, const topic_configuration& cfg) {
       cfg.retention_bytes,
       cfg.retention_duration,
       cfg.segment_size,
+      cfg.io_shares,
+      cfg.durability,
+      cfg.ephemeral,
       cfg.timestamp_type);
 
     return o;
@@ -136,7 +144,10 @@ void adl<cluster::topic_configuration>::to(
       t.timestamp_type,
       t.segment_size,
       t.retention_bytes,
-      t.retention_duration);
+      t.retention_duration,
+      t.io_shares,
+      t.durability,
+      t.ephemeral);
 }
 
 cluster::topic_configuration
@@ -159,6 +170,9 @@ adl<cluster::topic_configuration>::from(iobuf_parser& in) {
     cfg.retention_bytes = adl<tristate<size_t>>{}.from(in);
     cfg.retention_duration = adl<tristate<std::chrono::milliseconds>>{}.from(
       in);
+    cfg.io_shares = adl<std::optional<uint32_t>>{}.from(in);
+    cfg.durability = adl<std::optional<storage::durability_mode>>{}.from(in);
+    cfg.ephemeral = adl<bool>{}.from(in);
 
     return cfg;
 }
@@ -235,6 +249,66 @@ adl<cluster::create_topics_reply>::from(iobuf_parser& in) {
       std::move(results), std::move(md), std::move(cfg)};
 }
 
+ss::future<> async_adl<cluster::create_topics_request>::to(
+  iobuf& out, cluster::create_topics_request&& r) {
+    auto timeout = r.timeout;
+    return async_adl<std::vector<cluster::topic_configuration>>{}
+      .to(out, std::move(r.topics))
+      .then([&out, timeout] {
+          adl<model::timeout_clock::duration>{}.to(out, timeout);
+      });
+}
+
+ss::future<cluster::create_topics_request>
+async_adl<cluster::create_topics_request>::from(iobuf_parser& in) {
+    return async_adl<std::vector<cluster::topic_configuration>>{}
+      .from(in)
+      .then([&in](std::vector<cluster::topic_configuration> topics) {
+          auto timeout = adl<model::timeout_clock::duration>{}.from(in);
+          return cluster::create_topics_request{std::move(topics), timeout};
+      });
+}
+
+ss::future<> async_adl<cluster::create_topics_reply>::to(
+  iobuf& out, cluster::create_topics_reply&& r) {
+    return ss::do_with(
+      std::move(r), [&out](cluster::create_topics_reply& r) {
+          return async_adl<std::vector<cluster::topic_result>>{}
+            .to(out, std::move(r.results))
+            .then([&out, &r] {
+                return async_adl<std::vector<model::topic_metadata>>{}.to(
+                  out, std::move(r.metadata));
+            })
+            .then([&out, &r] {
+                return async_adl<std::vector<cluster::topic_configuration>>{}
+                  .to(out, std::move(r.configs));
+            });
+      });
+}
+
+ss::future<cluster::create_topics_reply>
+async_adl<cluster::create_topics_reply>::from(iobuf_parser& in) {
+    return ss::do_with(
+      cluster::create_topics_reply{}, [&in](cluster::create_topics_reply& r) {
+          return async_adl<std::vector<cluster::topic_result>>{}
+            .from(in)
+            .then([&in, &r](std::vector<cluster::topic_result> results) {
+                r.results = std::move(results);
+                return async_adl<std::vector<model::topic_metadata>>{}.from(
+                  in);
+            })
+            .then([&in, &r](std::vector<model::topic_metadata> metadata) {
+                r.metadata = std::move(metadata);
+                return async_adl<std::vector<cluster::topic_configuration>>{}
+                  .from(in);
+            })
+            .then([&r](std::vector<cluster::topic_configuration> configs) {
+                r.configs = std::move(configs);
+                return std::move(r);
+            });
+      });
+}
+
 void adl<model::timeout_clock::duration>::to(iobuf& out, duration dur) {
     // This is a clang bug that cause ss::cpu_to_le to become ambiguous
     // because rep has type of long long
@@ -266,6 +340,29 @@ adl<cluster::topic_configuration_assignment>::from(iobuf_parser& in) {
       std::move(cfg), std::move(assignments));
 }
 
+void adl<cluster::controller_checkpoint>::to(
+  iobuf& out, cluster::controller_checkpoint&& c) {
+    reflection::serialize(
+      out, c.version, c.last_applied, c.highest_group, std::move(c.topics));
+}
+
+cluster::controller_checkpoint
+adl<cluster::controller_checkpoint>::from(iobuf_parser& parser) {
+    auto version = adl<uint8_t>{}.from(parser);
+    vassert(
+      version == cluster::controller_checkpoint::current_version,
+      "Currently only version 0 of controller checkpoint is supported");
+
+    auto last_applied = adl<model::offset>{}.from(parser);
+    auto highest_group = adl<raft::group_id>{}.from(parser);
+    auto topics
+      = adl<std::vector<cluster::topic_configuration_assignment>>{}.from(
+        parser);
+
+    return cluster::controller_checkpoint(
+      last_applied, highest_group, std::move(topics));
+}
+
 void adl<cluster::configuration_invariants>::to(
   iobuf& out, cluster::configuration_invariants&& r) {
     reflection::serialize(out, r.version, r.node_id, r.core_count);
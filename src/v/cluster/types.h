@@ -18,6 +18,7 @@
 #include "model/timeout_clock.h"
 #include "raft/types.h"
 #include "reflection/adl.h"
+#include "reflection/async_adl.h"
 #include "storage/types.h"
 #include "tristate.h"
 #include "utils/to_string.h"
@@ -95,6 +96,13 @@ struct topic_configuration {
     std::optional<model::compaction_strategy> compaction_strategy;
     std::optional<model::timestamp_type> timestamp_type;
     std::optional<size_t> segment_size;
+    // seastar io queue shares for this topic's partitions
+    std::optional<uint32_t> io_shares;
+    // when appends become locally durable, see storage::durability_mode
+    std::optional<storage::durability_mode> durability;
+    // memory-only topic: partitions never touch disk, redundancy comes
+    // from raft replication alone
+    bool ephemeral{false};
 
     // Tristate fields
     // Mapped according to the following policy:
@@ -170,6 +178,32 @@ struct configuration_invariants {
     operator<<(std::ostream&, const configuration_invariants&);
 };
 
+/// Materialized controller state written periodically to the local kvstore
+/// so that bootstrap seeds the topic table and partition allocator from one
+/// checkpoint plus a short controller log tail instead of replaying the
+/// whole log. Brokers are not part of the checkpoint - the members table is
+/// rebuilt from the materialized raft0 configuration.
+struct controller_checkpoint {
+    static constexpr uint8_t current_version = 0;
+    // version 0: last_applied, highest_group, topics
+
+    controller_checkpoint(
+      model::offset last_applied,
+      raft::group_id highest_group,
+      std::vector<topic_configuration_assignment> topics)
+      : last_applied(last_applied)
+      , highest_group(highest_group)
+      , topics(std::move(topics)) {}
+
+    uint8_t version = current_version;
+    // offset the checkpointed state is consistent through; the stm resumes
+    // applying at the next offset
+    model::offset last_applied;
+    // highest raft group id ever allocated
+    raft::group_id highest_group;
+    std::vector<topic_configuration_assignment> topics;
+};
+
 class configuration_invariants_changed final : public std::exception {
 public:
     explicit configuration_invariants_changed(
@@ -237,12 +271,36 @@ struct adl<cluster::create_topics_reply> {
     cluster::create_topics_reply from(iobuf);
     cluster::create_topics_reply from(iobuf_parser&);
 };
+/*
+ * Topic creation requests can carry thousands of configurations and the
+ * replies as many per-topic results and metadata entries. These mirror
+ * the custom adl encodings above field for field, but yield between
+ * vector elements so large controller payloads do not stall the reactor.
+ */
+template<>
+struct async_adl<cluster::create_topics_request> {
+    ss::future<> to(iobuf&, cluster::create_topics_request&&);
+    ss::future<cluster::create_topics_request> from(iobuf_parser&);
+};
+
+template<>
+struct async_adl<cluster::create_topics_reply> {
+    ss::future<> to(iobuf&, cluster::create_topics_reply&&);
+    ss::future<cluster::create_topics_reply> from(iobuf_parser&);
+};
+
 template<>
 struct adl<cluster::topic_configuration_assignment> {
     void to(iobuf&, cluster::topic_configuration_assignment&&);
     cluster::topic_configuration_assignment from(iobuf_parser&);
 };
 
+template<>
+struct adl<cluster::controller_checkpoint> {
+    void to(iobuf&, cluster::controller_checkpoint&&);
+    cluster::controller_checkpoint from(iobuf_parser&);
+};
+
 template<>
 struct adl<cluster::configuration_invariants> {
     void to(iobuf&, cluster::configuration_invariants&&);
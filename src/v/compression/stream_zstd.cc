@@ -16,6 +16,9 @@
 #include "units.h"
 #include "vlog.h"
 
+#include <seastar/core/do_with.hh>
+#include <seastar/core/future-util.hh>
+
 #include <fmt/format.h>
 
 #include <array>
@@ -34,12 +37,11 @@ static void throw_if_error(size_t rc) {
 }
 
 void stream_zstd::reset_compressor() {
-    _compress.reset(ZSTD_createCCtx());
-    if (!_compress) {
-        throw std::bad_alloc{};
-    }
+    // borrowing hands back a session-reset context with its workspace
+    // already allocated; nothing is created or freed in steady state
+    _compress = zstd_ctx_pool::local().borrow_cctx();
 }
-stream_zstd::zstd_compress_ctx& stream_zstd::compressor() {
+zstd_ctx_pool::cctx_lease& stream_zstd::compressor() {
     if (!_compress) {
         reset_compressor();
     }
@@ -47,22 +49,22 @@ stream_zstd::zstd_compress_ctx& stream_zstd::compressor() {
 }
 
 void stream_zstd::reset_decompressor() {
-    _decompress.reset(ZSTD_createDCtx());
-    if (!_decompress) {
-        throw std::bad_alloc{};
-    }
+    _decompress = zstd_ctx_pool::local().borrow_dctx();
 }
 
-stream_zstd::zstd_decompress_ctx& stream_zstd::decompressor() {
+zstd_ctx_pool::dctx_lease& stream_zstd::decompressor() {
     if (!_decompress) {
         reset_decompressor();
     }
     return _decompress;
 }
 
-iobuf stream_zstd::do_compress(const iobuf& x) {
+iobuf stream_zstd::do_compress(const iobuf& x, const zstd_dictionary* dict) {
     reset_compressor();
     ZSTD_CCtx* ctx = compressor().get();
+    if (dict) {
+        throw_if_error(ZSTD_CCtx_refCDict(ctx, dict->cdict()));
+    }
     // NOTE: always enable content size. **decompression** depends on this
     throw_if_error(ZSTD_CCtx_setPledgedSrcSize(ctx, x.size_bytes()));
     // zstd requires linearized memory
@@ -83,6 +85,47 @@ iobuf stream_zstd::do_compress(const iobuf& x) {
     return ret;
 }
 
+ss::future<iobuf> stream_zstd::compress_async(iobuf x) {
+    reset_compressor();
+    ZSTD_CCtx* ctx = compressor().get();
+    // NOTE: always enable content size. **decompression** depends on this
+    throw_if_error(ZSTD_CCtx_setPledgedSrcSize(ctx, x.size_bytes()));
+    // zstd requires linearized memory. moving the temporary_buffer into
+    // do_with below does not relocate the underlying allocation, so the
+    // output pointer stays valid
+    ss::temporary_buffer<char> obuf(ZSTD_compressBound(x.size_bytes()));
+    ZSTD_outBuffer out = {
+      .dst = obuf.get_write(), .size = obuf.size(), .pos = 0};
+    return ss::do_with(
+      std::move(x),
+      std::move(obuf),
+      out,
+      [ctx](iobuf& input, ss::temporary_buffer<char>& obuf, ZSTD_outBuffer& out) {
+          return ss::do_with(
+                   input.cbegin(),
+                   [ctx, &input, &out](iobuf::const_iterator& it) {
+                       return ss::do_until(
+                         [&input, &it] { return it == input.cend(); },
+                         [ctx, &out, &it] {
+                             ZSTD_inBuffer in = {
+                               .src = it->get(), .size = it->size(), .pos = 0};
+                             throw_if_error(ZSTD_compressStream2(
+                               ctx, &out, &in, ZSTD_e_flush));
+                             ++it;
+                             return ss::later();
+                         });
+                   })
+            .then([ctx, &obuf, &out] {
+                // Must happen outside of loop to encode empty-buffer sizes
+                ZSTD_endStream(ctx, &out);
+                obuf.trim(out.pos);
+                iobuf ret;
+                ret.append(std::move(obuf));
+                return ret;
+            });
+      });
+}
+
 size_t find_zstd_size(const iobuf& x) {
     auto consumer = iobuf::iterator_consumer(x.cbegin(), x.cend());
     // defined in zstd.h ONLY under static allocation - sigh
@@ -128,13 +171,16 @@ size_t decompression_step(const iobuf& x) {
     return std::min(64_KiB, ret);
 }
 
-iobuf stream_zstd::do_uncompress(const iobuf& x) {
+iobuf stream_zstd::do_uncompress(const iobuf& x, const zstd_dictionary* dict) {
     if (unlikely(x.empty())) {
         throw std::runtime_error(
           "Asked to stream_zstd::uncompress empty buffer");
     }
     reset_decompressor();
     ZSTD_DCtx* dctx = decompressor().get();
+    if (dict) {
+        throw_if_error(ZSTD_DCtx_refDDict(dctx, dict->ddict()));
+    }
     iobuf ret;
     ss::temporary_buffer<char> obuf(decompression_step(x));
     ZSTD_outBuffer out = {
@@ -157,4 +203,52 @@ iobuf stream_zstd::do_uncompress(const iobuf& x) {
     return ret;
 }
 
+zstd_chunked_decompressor::zstd_chunked_decompressor(
+  iobuf input, size_t chunk_size)
+  : _input(std::move(input))
+  , _chunk_size(chunk_size)
+  , _frag(_input.cbegin()) {
+    if (unlikely(_input.empty())) {
+        throw std::runtime_error(
+          "Asked to zstd_chunked_decompressor::next empty buffer");
+    }
+    _ctx = zstd_ctx_pool::local().borrow_dctx();
+}
+
+std::optional<iobuf> zstd_chunked_decompressor::next() {
+    if (_done) {
+        return std::nullopt;
+    }
+    ss::temporary_buffer<char> obuf(_chunk_size);
+    ZSTD_outBuffer out = {
+      .dst = obuf.get_write(), .size = obuf.size(), .pos = 0};
+    while (out.pos != out.size) {
+        if (_in.pos == _in.size) {
+            if (_frag == _input.cend()) {
+                break;
+            }
+            _in = {.src = _frag->get(), .size = _frag->size(), .pos = 0};
+            ++_frag;
+        }
+        auto rc = ZSTD_decompressStream(_ctx.get(), &out, &_in);
+        throw_if_error(rc);
+        if (rc == 0) {
+            // frame fully decoded and flushed
+            _done = true;
+            break;
+        }
+    }
+    if (out.pos == 0) {
+        if (unlikely(!_done)) {
+            throw std::runtime_error(
+              "zstd_chunked_decompressor: input ended mid-frame");
+        }
+        return std::nullopt;
+    }
+    obuf.trim(out.pos);
+    iobuf ret;
+    ret.append(std::move(obuf));
+    return ret;
+}
+
 } // namespace compression
@@ -11,39 +11,82 @@
 
 #pragma once
 #include "bytes/iobuf.h"
-#include "static_deleter_fn.h"
+#include "compression/zstd_ctx_pool.h"
+#include "compression/zstd_dict.h"
+#include "seastarx.h"
+#include "units.h"
 
-#include <memory>
+#include <seastar/core/future.hh>
+
+#include <optional>
 #include <zstd.h>
 
 namespace compression {
 class stream_zstd {
 public:
-    using zstd_compress_ctx = std::unique_ptr<
-      ZSTD_CCtx,
-      // wrap ZSTD C API
-      static_sized_deleter_fn<ZSTD_CCtx, &ZSTD_freeCCtx>>;
-    using zstd_decompress_ctx = std::unique_ptr<
-      ZSTD_DCtx,
-      // wrap ZSTD C API
-      static_sized_deleter_fn<ZSTD_DCtx, &ZSTD_freeDCtx>>;
-
-    iobuf compress(const iobuf& b) { return do_compress(b); }
-    iobuf uncompress(const iobuf& b) { return do_uncompress(b); }
-    iobuf compress(iobuf&& b) { return do_compress(b); }
-    iobuf uncompress(iobuf&& b) { return do_uncompress(b); }
+    iobuf compress(const iobuf& b) { return do_compress(b, nullptr); }
+    iobuf uncompress(const iobuf& b) { return do_uncompress(b, nullptr); }
+    iobuf compress(iobuf&& b) { return do_compress(b, nullptr); }
+    iobuf uncompress(iobuf&& b) { return do_uncompress(b, nullptr); }
+
+    /// \brief like compress(), but yields to the reactor between input
+    /// fragments so a multi-MB payload does not stall the scheduler for
+    /// the whole frame. `this` must outlive the returned future.
+    ss::future<iobuf> compress_async(iobuf b);
+
+    // dictionary variants. a frame compressed with a dictionary must be
+    // uncompressed with the same dictionary (the frame header records the
+    // dictionary id).
+    iobuf compress(const iobuf& b, const zstd_dictionary& d) {
+        return do_compress(b, &d);
+    }
+    iobuf uncompress(const iobuf& b, const zstd_dictionary& d) {
+        return do_uncompress(b, &d);
+    }
 
 private:
-    iobuf do_compress(const iobuf&);
-    iobuf do_uncompress(const iobuf&);
+    iobuf do_compress(const iobuf&, const zstd_dictionary*);
+    iobuf do_uncompress(const iobuf&, const zstd_dictionary*);
 
     void reset_compressor();
     void reset_decompressor();
-    zstd_compress_ctx& compressor();
-    zstd_decompress_ctx& decompressor();
+    zstd_ctx_pool::cctx_lease& compressor();
+    zstd_ctx_pool::dctx_lease& decompressor();
+
+    // contexts are borrowed from the shard's warmed pool and returned
+    // when the lease is dropped
+    zstd_ctx_pool::cctx_lease _compress;
+    zstd_ctx_pool::dctx_lease _decompress;
+};
 
-    zstd_compress_ctx _compress{nullptr};
-    zstd_decompress_ctx _decompress{nullptr};
+/**
+ * Incremental decompression of a single zstd frame. Input is consumed
+ * fragment by fragment and decompressed output is handed back in chunks of
+ * at most `chunk_size` bytes, so peak memory is bounded by the chunk size
+ * instead of the uncompressed frame size.
+ */
+class zstd_chunked_decompressor {
+public:
+    explicit zstd_chunked_decompressor(iobuf input, size_t chunk_size = 64_KiB);
+    zstd_chunked_decompressor(const zstd_chunked_decompressor&) = delete;
+    zstd_chunked_decompressor& operator=(const zstd_chunked_decompressor&)
+      = delete;
+    // the fragment cursor points into _input; moving would invalidate it
+    zstd_chunked_decompressor(zstd_chunked_decompressor&&) = delete;
+    zstd_chunked_decompressor& operator=(zstd_chunked_decompressor&&) = delete;
+    ~zstd_chunked_decompressor() = default;
+
+    /// Next decompressed chunk. Empty optional once the frame is fully
+    /// decoded. Throws if the input ends before the frame does.
+    std::optional<iobuf> next();
+
+private:
+    iobuf _input;
+    size_t _chunk_size;
+    zstd_ctx_pool::dctx_lease _ctx;
+    iobuf::const_iterator _frag;
+    ZSTD_inBuffer _in{nullptr, 0, 0};
+    bool _done{false};
 };
 
 } // namespace compression
@@ -19,6 +19,8 @@
 
 #include <seastar/testing/thread_test_case.hh>
 
+#include <fmt/format.h>
+
 static inline constexpr std::array<size_t, 12> sizes{{
   0,
   8,
@@ -65,6 +67,82 @@ SEASTAR_THREAD_TEST_CASE(stream_zstd_test) {
     }
 }
 
+SEASTAR_THREAD_TEST_CASE(stream_zstd_dict_test) {
+    // samples mimic a small-message workload: a fixed structure with a small
+    // varying payload. enough shared structure for training to converge.
+    std::vector<iobuf> samples;
+    samples.reserve(1000);
+    const auto payload = random_generators::gen_alphanum_string(32);
+    for (size_t i = 0; i < 1000; i++) {
+        auto msg = fmt::format(
+          "{{\"host\":\"node-{}\",\"metric\":\"latency_us\",\"value\":{},"
+          "\"payload\":\"{}\"}}",
+          i % 16,
+          i,
+          payload);
+        iobuf b;
+        b.append(msg.data(), msg.size());
+        samples.push_back(std::move(b));
+    }
+
+    auto dict = compression::zstd_dictionary::train(samples, 4_KiB);
+    BOOST_CHECK(dict.id() != 0);
+    BOOST_CHECK(!dict.raw().empty());
+
+    // a rebuilt dictionary from persisted raw content is interchangeable
+    compression::zstd_dictionary rebuilt(dict.raw());
+    BOOST_CHECK_EQUAL(dict.id(), rebuilt.id());
+
+    compression::stream_zstd fn;
+    for (size_t i = 0; i < 10; i++) {
+        auto& buf = samples[i * 100];
+        auto cbuf = fn.compress(buf, dict);
+        auto dbuf = fn.uncompress(cbuf, rebuilt);
+        BOOST_CHECK_EQUAL(dbuf, buf);
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(stream_zstd_chunked_test) {
+    compression::stream_zstd fn;
+    for (size_t i : sizes) {
+        iobuf buf = gen(i);
+        auto cbuf = fn.compress(buf.share(0, i));
+        // chunk size deliberately smaller than most inputs so multiple
+        // chunks are produced and frame-end handling is exercised
+        compression::zstd_chunked_decompressor dec(std::move(cbuf), 512);
+        iobuf dbuf;
+        while (auto chunk = dec.next()) {
+            BOOST_CHECK(chunk->size_bytes() <= 512);
+            dbuf.append(std::move(*chunk));
+        }
+        BOOST_CHECK_EQUAL(dbuf, buf);
+        // exhausted decompressor keeps returning empty
+        BOOST_CHECK(!dec.next());
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(zstd_ctx_pool_reuse_test) {
+    auto& pool = compression::zstd_ctx_pool::local();
+    {
+        // dropping the lease returns the context to the pool
+        auto lease = pool.borrow_cctx();
+        BOOST_CHECK(bool(lease));
+    }
+    auto idle = pool.idle_cctx();
+    BOOST_CHECK(idle >= 1);
+    // operations recycle pooled contexts instead of growing the pool
+    for (int i = 0; i < 10; ++i) {
+        compression::stream_zstd fn;
+        iobuf buf = gen(4_KiB);
+        auto cbuf = fn.compress(buf.share(0, 4_KiB));
+        auto dbuf = fn.uncompress(std::move(cbuf));
+        BOOST_CHECK_EQUAL(dbuf, buf);
+    }
+    BOOST_CHECK(
+      pool.idle_cctx() <= compression::zstd_ctx_pool::max_idle_per_level);
+    BOOST_CHECK(pool.idle_dctx() >= 1);
+}
+
 SEASTAR_THREAD_TEST_CASE(lz4_block_tests) {
     using fn = compression::internal::lz4_frame_compressor;
     roundtrip_compression(fn::compress, fn::uncompress);
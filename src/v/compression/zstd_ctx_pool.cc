@@ -0,0 +1,143 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "compression/zstd_ctx_pool.h"
+
+#include "likely.h"
+
+#include <fmt/format.h>
+
+#include <array>
+#include <zstd_errors.h>
+
+namespace compression {
+
+[[gnu::cold]] static void throw_zstd_err(size_t rc) {
+    throw std::runtime_error(
+      fmt::format("ZSTD error:{}", ZSTD_getErrorName(rc)));
+}
+static void throw_if_error(size_t rc) {
+    if (unlikely(ZSTD_isError(rc))) {
+        throw_zstd_err(rc);
+    }
+}
+
+zstd_ctx_pool& zstd_ctx_pool::local() {
+    static thread_local zstd_ctx_pool pool;
+    return pool;
+}
+
+zstd_ctx_pool::cctx_lease&
+zstd_ctx_pool::cctx_lease::operator=(cctx_lease&& o) noexcept {
+    if (this != &o) {
+        if (_ctx) {
+            local().release(std::move(_ctx), _level);
+        }
+        _ctx = std::move(o._ctx);
+        _level = o._level;
+    }
+    return *this;
+}
+
+zstd_ctx_pool::cctx_lease::~cctx_lease() {
+    if (_ctx) {
+        local().release(std::move(_ctx), _level);
+    }
+}
+
+zstd_ctx_pool::dctx_lease&
+zstd_ctx_pool::dctx_lease::operator=(dctx_lease&& o) noexcept {
+    if (this != &o) {
+        if (_ctx) {
+            local().release(std::move(_ctx));
+        }
+        _ctx = std::move(o._ctx);
+    }
+    return *this;
+}
+
+zstd_ctx_pool::dctx_lease::~dctx_lease() {
+    if (_ctx) {
+        local().release(std::move(_ctx));
+    }
+}
+
+// sizes and allocates the workspace up front: the first streaming call
+// sizes it from the pledged source size, so pledging the common batch
+// size here means real operations find it already allocated
+static void warm_cctx(ZSTD_CCtx* ctx, int level) {
+    throw_if_error(
+      ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel, level));
+    throw_if_error(
+      ZSTD_CCtx_setPledgedSrcSize(ctx, zstd_ctx_pool::common_src_size));
+    std::array<char, 128> scratch{};
+    ZSTD_outBuffer out = {
+      .dst = scratch.data(), .size = scratch.size(), .pos = 0};
+    ZSTD_inBuffer in = {.src = nullptr, .size = 0, .pos = 0};
+    throw_if_error(ZSTD_compressStream2(ctx, &out, &in, ZSTD_e_continue));
+    throw_if_error(ZSTD_CCtx_reset(ctx, ZSTD_reset_session_only));
+}
+
+zstd_ctx_pool::cctx_lease zstd_ctx_pool::borrow_cctx(int level) {
+    auto it = _cctx.find(level);
+    if (it != _cctx.end() && !it->second.empty()) {
+        auto ctx = std::move(it->second.back());
+        it->second.pop_back();
+        // drop any dictionary / pledged size left by the previous user;
+        // the workspace allocation survives the reset
+        throw_if_error(
+          ZSTD_CCtx_reset(ctx.get(), ZSTD_reset_session_and_parameters));
+        throw_if_error(
+          ZSTD_CCtx_setParameter(ctx.get(), ZSTD_c_compressionLevel, level));
+        return cctx_lease(std::move(ctx), level);
+    }
+    cctx_ptr ctx(ZSTD_createCCtx());
+    if (!ctx) {
+        throw std::bad_alloc{};
+    }
+    warm_cctx(ctx.get(), level);
+    return cctx_lease(std::move(ctx), level);
+}
+
+zstd_ctx_pool::dctx_lease zstd_ctx_pool::borrow_dctx() {
+    if (!_dctx.empty()) {
+        auto ctx = std::move(_dctx.back());
+        _dctx.pop_back();
+        throw_if_error(
+          ZSTD_DCtx_reset(ctx.get(), ZSTD_reset_session_and_parameters));
+        return dctx_lease(std::move(ctx));
+    }
+    dctx_ptr ctx(ZSTD_createDCtx());
+    if (!ctx) {
+        throw std::bad_alloc{};
+    }
+    return dctx_lease(std::move(ctx));
+}
+
+size_t zstd_ctx_pool::idle_cctx(int level) const {
+    auto it = _cctx.find(level);
+    return it == _cctx.end() ? 0 : it->second.size();
+}
+
+void zstd_ctx_pool::release(cctx_ptr ctx, int level) {
+    auto& idle = _cctx[level];
+    if (idle.size() < max_idle_per_level) {
+        idle.push_back(std::move(ctx));
+    }
+    // otherwise let the context free itself: the cap bounds how much
+    // workspace memory a bursty shard can pin
+}
+
+void zstd_ctx_pool::release(dctx_ptr ctx) {
+    if (_dctx.size() < max_idle_dctx) {
+        _dctx.push_back(std::move(ctx));
+    }
+}
+
+} // namespace compression
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "seastarx.h"
+#include "static_deleter_fn.h"
+#include "units.h"
+
+#include <absl/container/flat_hash_map.h>
+
+#include <memory>
+#include <vector>
+#include <zstd.h>
+
+namespace compression {
+
+/**
+ * Per-shard pool of warmed zstd contexts.
+ *
+ * Creating a ZSTD_CCtx is cheap, but the first compression call sizes and
+ * allocates a multi-megabyte workspace from the pledged source size and
+ * compression level - that allocation used to happen once per operation on
+ * the produce path for compressed topics. The pool keeps finished contexts
+ * around instead: a borrowed context is session-reset (which retains the
+ * allocated workspace) and handed back out, so steady state compression
+ * never re-sizes the workspace.
+ *
+ * Compression contexts are pooled per level since the workspace size
+ * depends on it. New compression contexts are pre-warmed by pledging the
+ * common batch size, so even the first real use of a context finds the
+ * workspace already sized. The number of retained idle contexts is capped
+ * to bound the memory a bursty shard can pin.
+ */
+class zstd_ctx_pool {
+public:
+    using cctx_ptr = std::unique_ptr<
+      ZSTD_CCtx,
+      // wrap ZSTD C API
+      static_sized_deleter_fn<ZSTD_CCtx, &ZSTD_freeCCtx>>;
+    using dctx_ptr = std::unique_ptr<
+      ZSTD_DCtx,
+      // wrap ZSTD C API
+      static_sized_deleter_fn<ZSTD_DCtx, &ZSTD_freeDCtx>>;
+
+    static constexpr int default_level = 3; // ZSTD_CLEVEL_DEFAULT
+    /// workspace pre-sizing target: the produce path overwhelmingly
+    /// compresses batches below this size
+    static constexpr size_t common_src_size = 1_MiB;
+    static constexpr size_t max_idle_per_level = 4;
+    static constexpr size_t max_idle_dctx = 4;
+
+    /// RAII handle on a pooled compression context; returns the context
+    /// to the pool on destruction
+    class cctx_lease {
+    public:
+        cctx_lease() = default;
+        cctx_lease(cctx_ptr ctx, int level)
+          : _ctx(std::move(ctx))
+          , _level(level) {}
+        cctx_lease(const cctx_lease&) = delete;
+        cctx_lease& operator=(const cctx_lease&) = delete;
+        cctx_lease(cctx_lease&&) noexcept = default;
+        cctx_lease& operator=(cctx_lease&& o) noexcept;
+        ~cctx_lease();
+
+        ZSTD_CCtx* get() const { return _ctx.get(); }
+        explicit operator bool() const { return bool(_ctx); }
+
+    private:
+        cctx_ptr _ctx;
+        int _level{default_level};
+    };
+
+    /// RAII handle on a pooled decompression context
+    class dctx_lease {
+    public:
+        dctx_lease() = default;
+        explicit dctx_lease(dctx_ptr ctx)
+          : _ctx(std::move(ctx)) {}
+        dctx_lease(const dctx_lease&) = delete;
+        dctx_lease& operator=(const dctx_lease&) = delete;
+        dctx_lease(dctx_lease&&) noexcept = default;
+        dctx_lease& operator=(dctx_lease&& o) noexcept;
+        ~dctx_lease();
+
+        ZSTD_DCtx* get() const { return _ctx.get(); }
+        explicit operator bool() const { return bool(_ctx); }
+
+    private:
+        dctx_ptr _ctx;
+    };
+
+    static zstd_ctx_pool& local();
+
+    /// borrow a session-reset compression context configured for the
+    /// given level; creates and warms one if the pool is empty
+    cctx_lease borrow_cctx(int level = default_level);
+
+    /// borrow a session-reset decompression context
+    dctx_lease borrow_dctx();
+
+    size_t idle_cctx(int level = default_level) const;
+    size_t idle_dctx() const { return _dctx.size(); }
+
+private:
+    friend class cctx_lease;
+    friend class dctx_lease;
+
+    void release(cctx_ptr, int level);
+    void release(dctx_ptr);
+
+    absl::flat_hash_map<int, std::vector<cctx_ptr>> _cctx;
+    std::vector<dctx_ptr> _dctx;
+};
+
+} // namespace compression
@@ -0,0 +1,74 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "compression/zstd_dict.h"
+
+#include <fmt/format.h>
+
+#include <numeric>
+#include <zdict.h>
+
+namespace compression {
+
+zstd_dictionary::zstd_dictionary(bytes raw, int compression_level)
+  : _raw(std::move(raw)) {
+    _cdict.reset(ZSTD_createCDict(_raw.data(), _raw.size(), compression_level));
+    if (!_cdict) {
+        throw std::runtime_error("Failed to digest zstd dictionary (cdict)");
+    }
+    _ddict.reset(ZSTD_createDDict(_raw.data(), _raw.size()));
+    if (!_ddict) {
+        throw std::runtime_error("Failed to digest zstd dictionary (ddict)");
+    }
+}
+
+zstd_dictionary zstd_dictionary::train(
+  const std::vector<iobuf>& samples,
+  size_t max_dict_size,
+  int compression_level) {
+    // zdict requires linearized samples back to back with explicit sizes
+    std::vector<size_t> sizes;
+    sizes.reserve(samples.size());
+    size_t total = 0;
+    for (const auto& s : samples) {
+        sizes.push_back(s.size_bytes());
+        total += s.size_bytes();
+    }
+
+    std::vector<char> sample_data;
+    sample_data.reserve(total);
+    for (const auto& s : samples) {
+        for (const auto& frag : s) {
+            sample_data.insert(
+              sample_data.end(), frag.get(), frag.get() + frag.size());
+        }
+    }
+
+    std::vector<char> dict_data(max_dict_size);
+    auto rc = ZDICT_trainFromBuffer(
+      dict_data.data(),
+      dict_data.size(),
+      sample_data.data(),
+      sizes.data(),
+      sizes.size());
+    if (ZDICT_isError(rc)) {
+        throw std::runtime_error(fmt::format(
+          "ZDICT training error:{}", ZDICT_getErrorName(rc)));
+    }
+
+    bytes raw(
+      reinterpret_cast<const bytes::value_type*>(dict_data.data()), rc);
+    return zstd_dictionary(std::move(raw), compression_level);
+}
+
+uint32_t zstd_dictionary::id() const {
+    return ZSTD_getDictID_fromDict(_raw.data(), _raw.size());
+}
+
+} // namespace compression
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "bytes/bytes.h"
+#include "bytes/iobuf.h"
+#include "static_deleter_fn.h"
+
+#include <memory>
+#include <vector>
+#include <zstd.h>
+
+namespace compression {
+
+/**
+ * Immutable trained zstd dictionary.
+ *
+ * Small payloads compress poorly on their own because each frame has to
+ * rebuild its entropy tables from a few hundred bytes of input. A dictionary
+ * trained from representative samples front-loads that shared context, which
+ * is where the ratio win for small-message workloads comes from.
+ *
+ * The digested compression and decompression forms are built once at
+ * construction and can be referenced by any number of stream_zstd operations
+ * without per-use setup cost. Every frame compressed with a dictionary
+ * records the dictionary id in its header, so a reader can select the
+ * matching dictionary version before decompressing.
+ */
+class zstd_dictionary {
+public:
+    using zstd_cdict_ptr = std::unique_ptr<
+      ZSTD_CDict,
+      // wrap ZSTD C API
+      static_sized_deleter_fn<ZSTD_CDict, &ZSTD_freeCDict>>;
+    using zstd_ddict_ptr = std::unique_ptr<
+      ZSTD_DDict,
+      // wrap ZSTD C API
+      static_sized_deleter_fn<ZSTD_DDict, &ZSTD_freeDDict>>;
+
+    /// Build a dictionary from previously trained raw dictionary content.
+    explicit zstd_dictionary(bytes raw, int compression_level = 3);
+
+    /**
+     * Train a dictionary from representative samples.
+     *
+     * \throws std::runtime_error if training fails, e.g. when the samples do
+     * not carry enough shared structure to be useful.
+     */
+    static zstd_dictionary train(
+      const std::vector<iobuf>& samples,
+      size_t max_dict_size,
+      int compression_level = 3);
+
+    /// Id zstd embeds in the header of every frame compressed with this
+    /// dictionary.
+    uint32_t id() const;
+
+    /// Raw dictionary content, suitable for persisting and rebuilding.
+    const bytes& raw() const { return _raw; }
+
+    const ZSTD_CDict* cdict() const { return _cdict.get(); }
+    const ZSTD_DDict* ddict() const { return _ddict.get(); }
+
+private:
+    bytes _raw;
+    zstd_cdict_ptr _cdict{nullptr};
+    zstd_ddict_ptr _ddict{nullptr};
+};
+
+} // namespace compression
@@ -40,6 +40,14 @@ configuration::configuration()
       "256MiB)",
       required::no,
       256_MiB)
+  , log_segment_index_granularity(
+      *this,
+      "log_segment_index_granularity",
+      "How many bytes of batch data are written between sparse offset/time "
+      "index entries. Smaller values make timestamp and offset lookups more "
+      "precise at the cost of larger per-segment indices (default 32KiB)",
+      required::no,
+      32_KiB)
   , rpc_server(
       *this,
       "rpc_server",
@@ -53,6 +61,28 @@ configuration::configuration()
       required::no,
       tls_config(),
       tls_config::validate)
+  , rpc_server_tcp_send_buf(
+      *this,
+      "rpc_server_tcp_send_buf",
+      "Size of the RPC server TCP send buffer in bytes. Setting it disables "
+      "kernel autotuning, which chronically undersizes windows on fat links. "
+      "If unset the kernel default is used",
+      required::no,
+      std::nullopt)
+  , rpc_server_tcp_recv_buf(
+      *this,
+      "rpc_server_tcp_recv_buf",
+      "Size of the RPC server TCP receive buffer in bytes. If unset the "
+      "kernel default is used",
+      required::no,
+      std::nullopt)
+  , rpc_server_tcp_nodelay(
+      *this,
+      "rpc_server_tcp_nodelay",
+      "Disable Nagle batching on RPC server connections. Raft messages are "
+      "latency bound, so this defaults to true",
+      required::no,
+      true)
   , enable_coproc(
       *this, "enable_coproc", "Enable coprocessing mode", required::no, false)
   , coproc_script_manager_server(
@@ -109,6 +139,26 @@ configuration::configuration()
       required::no,
       tls_config(),
       tls_config::validate)
+  , kafka_api_tcp_send_buf(
+      *this,
+      "kafka_api_tcp_send_buf",
+      "Size of the Kafka API TCP send buffer in bytes. If unset the kernel "
+      "default is used",
+      required::no,
+      std::nullopt)
+  , kafka_api_tcp_recv_buf(
+      *this,
+      "kafka_api_tcp_recv_buf",
+      "Size of the Kafka API TCP receive buffer in bytes. If unset the "
+      "kernel default is used",
+      required::no,
+      std::nullopt)
+  , kafka_api_tcp_nodelay(
+      *this,
+      "kafka_api_tcp_nodelay",
+      "Disable Nagle batching on Kafka API connections",
+      required::no,
+      true)
   , use_scheduling_groups(
       *this,
       "use_scheduling_groups",
@@ -160,6 +210,28 @@ configuration::configuration()
       "Target quota byte rate (bytes per second) - 1GB default",
       required::no,
       1_GiB)
+  , target_node_quota_byte_rate(
+      *this,
+      "target_node_quota_byte_rate",
+      "Aggregate byte rate limit (bytes per second) across all clients of a "
+      "node, enforced per shard with demand-based rebalancing - 0 disables "
+      "the aggregate limit",
+      required::no,
+      0)
+  , kafka_latency_trace_sample_rate(
+      *this,
+      "kafka_latency_trace_sample_rate",
+      "Trace 1 in N kafka requests with a per-stage latency breakdown. 0 "
+      "disables tracing",
+      required::no,
+      0)
+  , reactor_stall_capture_threshold_ms(
+      *this,
+      "reactor_stall_capture_threshold_ms",
+      "Capture a backtrace when the reactor stalls for longer than this "
+      "threshold and retain it for the admin API. 0 disables capture",
+      required::no,
+      30ms)
   , rack(*this, "rack", "Rack identifier", required::no, std::nullopt)
   , dashboard_dir(
       *this,
@@ -209,6 +281,34 @@ configuration::configuration()
       "Interaval for metadata dissemination batching",
       required::no,
       3'000ms)
+  , metadata_dissemination_anti_entropy_interval_ms(
+      *this,
+      "metadata_dissemination_anti_entropy_interval_ms",
+      "Interval of full leadership metadata sync with a random cluster node, "
+      "reconciling updates missed by incremental dissemination",
+      required::no,
+      300'000ms)
+  , enable_leader_balancer(
+      *this,
+      "enable_leader_balancer",
+      "Enable automatic partition leadership balancing across nodes",
+      required::no,
+      true)
+  , leader_balancer_interval_ms(
+      *this,
+      "leader_balancer_interval_ms",
+      "Interval between leadership balancing attempts, at most one "
+      "leadership is transferred per interval",
+      required::no,
+      30'000ms)
+  , controller_checkpoint_interval_ms(
+      *this,
+      "controller_checkpoint_interval_ms",
+      "Interval between checkpoints of the materialized controller state, "
+      "letting bootstrap read a checkpoint plus a short log tail instead of "
+      "replaying the whole controller log",
+      required::no,
+      10min)
   , fetch_reads_debounce_timeout(
       *this,
       "fetch_reads_debounce_timeout",
@@ -282,6 +382,13 @@ configuration::configuration()
       "Kafka group recovery timeout expressed in milliseconds",
       required::no,
       30'000ms)
+  , kafka_group_snapshot_interval_ms(
+      *this,
+      "kafka_group_snapshot_interval_ms",
+      "How often the committed suffix of each group metadata partition is "
+      "folded into its local recovery snapshot",
+      required::no,
+      60'000ms)
   , replicate_append_timeout_ms(
       *this,
       "replicate_append_timeout_ms",
@@ -301,6 +408,60 @@ configuration::configuration()
       "Max size of requests cached for replication",
       required::no,
       1_MiB)
+  , raft_flush_interval_ms(
+      *this,
+      "raft_flush_interval_ms",
+      "Max age of an unflushed append on a partition running in "
+      "raft_quorum durability mode before it is fdatasynced in the "
+      "background",
+      required::no,
+      100ms)
+  , raft_max_concurrent_recoveries(
+      *this,
+      "raft_max_concurrent_recoveries",
+      "Maximum number of follower recoveries running concurrently on a shard",
+      required::no,
+      64)
+  , raft_recovery_rate_bytes_per_sec(
+      *this,
+      "raft_recovery_rate_bytes_per_sec",
+      "Aggregate bandwidth budget for follower recoveries on a shard in bytes "
+      "per second, 0 disables throttling",
+      required::no,
+      100_MiB)
+  , raft_learner_recovery_rate_bytes_per_sec(
+      *this,
+      "raft_learner_recovery_rate_bytes_per_sec",
+      "Bandwidth budget for learner catch up traffic (partition movement and "
+      "rebalancing) on a shard in bytes per second. Learner traffic also "
+      "counts against the aggregate recovery budget, 0 disables the separate "
+      "limit",
+      required::no,
+      32_MiB)
+  , rpc_client_shard_group_size(
+      *this,
+      "rpc_client_shard_group_size",
+      "Number of neighbouring shards sharing one RPC client connection to "
+      "each peer node. With the default of 1 every shard owns a dedicated "
+      "connection and requests are issued without cross-core hops, larger "
+      "values reduce the connection count on many-core machines",
+      required::no,
+      1)
+  , rpc_client_compress_payloads(
+      *this,
+      "rpc_client_compress_payloads",
+      "Transparently compress internal RPC request payloads with zstd. Only "
+      "bulk traffic (replication, recovery) is compressed, latency sensitive "
+      "requests like heartbeats are sent uncompressed",
+      required::no,
+      true)
+  , rpc_client_min_compression_bytes(
+      *this,
+      "rpc_client_min_compression_bytes",
+      "Minimum RPC request payload size in bytes eligible for transparent "
+      "compression",
+      required::no,
+      1024)
   , reclaim_min_size(
       *this,
       "reclaim_min_size",
@@ -396,6 +557,59 @@ configuration::configuration()
       "cache",
       required::no,
       60s)
+  , kafka_produce_dedup_window_ms(
+      *this,
+      "kafka_produce_dedup_window_ms",
+      "Drop produce batches whose content fingerprint was written to the "
+      "same partition within this window. Shields against clients that "
+      "re-produce recent data after a restart. Disabled when 0",
+      required::no,
+      0ms)
+  , kafka_produce_coalesce_window_us(
+      *this,
+      "kafka_produce_coalesce_window_us",
+      "Stage produce batches on the partition's home shard for up to this "
+      "long so that writes from concurrent connections are replicated as "
+      "a single round. Disabled when 0",
+      required::no,
+      0us)
+  , kafka_fetch_max_bytes(
+      *this,
+      "kafka_fetch_max_bytes",
+      "Per-request cap on the size of a fetch response. The effective "
+      "budget is the smaller of this and the max_bytes the client sent",
+      required::no,
+      1_MiB)
+  , kafka_fetch_memory_window_bytes(
+      *this,
+      "kafka_fetch_memory_window_bytes",
+      "Per-shard bound on memory held by concurrently assembling fetch "
+      "responses. Fetches reserve their byte budget from this window and "
+      "wait when it is exhausted",
+      required::no,
+      32_MiB)
+  , kafka_client_memory_budget_bytes(
+      *this,
+      "kafka_client_memory_budget_bytes",
+      "Per-shard memory each kafka client_id may hold in requests being "
+      "read or processed before further requests from that client wait",
+      required::no,
+      8_MiB)
+  , kafka_client_memory_shared_bytes(
+      *this,
+      "kafka_client_memory_shared_bytes",
+      "Per-shard pool a kafka client borrows from for the part of a "
+      "request that exceeds its own memory budget",
+      required::no,
+      64_MiB)
+  , kafka_throttle_load_threshold_percent(
+      *this,
+      "kafka_throttle_load_threshold_percent",
+      "Shard load score above which produce/fetch responses start carrying "
+      "throttle_time hints, growing proportionally up to "
+      "max_kafka_throttle_delay_ms as the shard approaches saturation",
+      required::no,
+      uint32_t(80))
   , _advertised_kafka_api(
       *this,
       "advertised_kafka_api",
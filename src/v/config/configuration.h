@@ -35,9 +35,13 @@ struct configuration final : public config_store {
     property<bool> developer_mode;
     property<uint64_t> log_segment_size;
     property<uint64_t> compacted_log_segment_size;
+    property<size_t> log_segment_index_granularity;
     // Network
     property<unresolved_address> rpc_server;
     property<tls_config> rpc_server_tls;
+    property<std::optional<size_t>> rpc_server_tcp_send_buf;
+    property<std::optional<size_t>> rpc_server_tcp_recv_buf;
+    property<bool> rpc_server_tcp_nodelay;
     // Coproc
     property<bool> enable_coproc;
     property<unresolved_address> coproc_script_manager_server;
@@ -52,6 +56,9 @@ struct configuration final : public config_store {
     // Kafka
     property<unresolved_address> kafka_api;
     property<tls_config> kafka_api_tls;
+    property<std::optional<size_t>> kafka_api_tcp_send_buf;
+    property<std::optional<size_t>> kafka_api_tcp_recv_buf;
+    property<bool> kafka_api_tcp_nodelay;
     property<bool> use_scheduling_groups;
     property<unresolved_address> admin;
     property<tls_config> admin_api_tls;
@@ -61,6 +68,9 @@ struct configuration final : public config_store {
     property<std::chrono::milliseconds> default_window_sec;
     property<std::chrono::milliseconds> quota_manager_gc_sec;
     property<uint32_t> target_quota_byte_rate;
+    property<uint32_t> target_node_quota_byte_rate;
+    property<uint32_t> kafka_latency_trace_sample_rate;
+    property<std::chrono::milliseconds> reactor_stall_capture_threshold_ms;
     property<std::optional<ss::sstring>> rack;
     property<std::optional<ss::sstring>> dashboard_dir;
     property<bool> disable_metrics;
@@ -69,6 +79,11 @@ struct configuration final : public config_store {
     property<std::chrono::milliseconds> group_initial_rebalance_delay;
     property<std::chrono::milliseconds> group_new_member_join_timeout;
     property<std::chrono::milliseconds> metadata_dissemination_interval_ms;
+    property<std::chrono::milliseconds>
+      metadata_dissemination_anti_entropy_interval_ms;
+    property<bool> enable_leader_balancer;
+    property<std::chrono::milliseconds> leader_balancer_interval_ms;
+    property<std::chrono::milliseconds> controller_checkpoint_interval_ms;
     property<std::chrono::milliseconds> fetch_reads_debounce_timeout;
     // same as delete.retention.ms in kafka
     property<std::chrono::milliseconds> delete_retention_ms;
@@ -83,9 +98,17 @@ struct configuration final : public config_store {
     property<bool> disable_batch_cache;
     property<std::chrono::milliseconds> raft_election_timeout_ms;
     property<std::chrono::milliseconds> kafka_group_recovery_timeout_ms;
+    property<std::chrono::milliseconds> kafka_group_snapshot_interval_ms;
     property<std::chrono::milliseconds> replicate_append_timeout_ms;
     property<std::chrono::milliseconds> recovery_append_timeout_ms;
     property<size_t> raft_replicate_batch_window_size;
+    property<std::chrono::milliseconds> raft_flush_interval_ms;
+    property<size_t> raft_max_concurrent_recoveries;
+    property<size_t> raft_recovery_rate_bytes_per_sec;
+    property<size_t> raft_learner_recovery_rate_bytes_per_sec;
+    property<size_t> rpc_client_shard_group_size;
+    property<bool> rpc_client_compress_payloads;
+    property<size_t> rpc_client_min_compression_bytes;
 
     property<size_t> reclaim_min_size;
     property<size_t> reclaim_max_size;
@@ -104,6 +127,13 @@ struct configuration final : public config_store {
     property<bool> release_cache_on_segment_roll;
     property<std::chrono::milliseconds> segment_appender_flush_timeout_ms;
     property<std::chrono::milliseconds> fetch_session_eviction_timeout_ms;
+    property<std::chrono::milliseconds> kafka_produce_dedup_window_ms;
+    property<std::chrono::microseconds> kafka_produce_coalesce_window_us;
+    property<size_t> kafka_fetch_max_bytes;
+    property<size_t> kafka_fetch_memory_window_bytes;
+    property<size_t> kafka_client_memory_budget_bytes;
+    property<size_t> kafka_client_memory_shared_bytes;
+    property<uint32_t> kafka_throttle_load_threshold_percent;
 
     configuration();
 
@@ -251,6 +281,23 @@ struct convert<std::chrono::milliseconds> {
     }
 };
 
+template<>
+struct convert<std::chrono::microseconds> {
+    using type = std::chrono::microseconds;
+
+    static Node encode(const type& rhs) { return Node(rhs.count()); }
+
+    static bool decode(const Node& node, type& rhs) {
+        type::rep us;
+        auto res = convert<type::rep>::decode(node, us);
+        if (!res) {
+            return res;
+        }
+        rhs = std::chrono::microseconds(us);
+        return true;
+    }
+};
+
 inline ss::sstring to_absolute(const ss::sstring& path) {
     namespace fs = boost::filesystem;
     if (path.empty()) {
@@ -23,6 +23,7 @@
 #include "vassert.h"
 #include "vlog.h"
 
+#include <seastar/core/future-util.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/map_reduce.hh>
 
@@ -143,20 +144,14 @@ ss::future<> router::do_route() {
              _sources.begin(),
              _sources.end(),
              [this](router_source_manager::consumers_state::value_type& p) {
-                 return make_reader_cfg(p.second).then(
-                   [this, ntp = p.first, ts = p.second](
-                     opt_cfg config) mutable {
-                       if (!config) {
-                           return ss::make_ready_future<opt_req_data>();
-                       }
-                       return route_ntp(std::move(ntp), *config, ts);
-                   });
+                 return route_ntp(p.first, p.second);
              },
              std::vector<process_batch_request::data>(),
              [](
-               std::vector<process_batch_request::data>&& acc, opt_req_data x) {
-                 if (x.has_value()) {
-                     acc.emplace_back(std::move(*x));
+               std::vector<process_batch_request::data>&& acc,
+               std::vector<process_batch_request::data> x) {
+                 for (auto& e : x) {
+                     acc.emplace_back(std::move(e));
                  }
                  return std::move(acc);
              })
@@ -166,6 +161,29 @@ ss::future<> router::do_route() {
       .then([this, next_loop = _jitter()] { _loop_timer.rearm(next_loop); });
 }
 
+/// Splits the accumulated per-ntp data into up to max_inflight_requests
+/// requests of roughly equal size. Every ntp lands in exactly one request,
+/// so per-script offsets are still only bumped from the reply that carries
+/// their data.
+static std::vector<process_batch_request>
+chunk_requests(std::vector<process_batch_request::data> batch) {
+    std::vector<process_batch_request> reqs;
+    const size_t n = std::min(batch.size(), router::max_inflight_requests);
+    const size_t per_request = (batch.size() + n - 1) / n;
+    reqs.reserve(n);
+    auto it = batch.begin();
+    while (it != batch.end()) {
+        const auto remaining = static_cast<size_t>(
+          std::distance(it, batch.end()));
+        auto last = std::next(it, std::min(per_request, remaining));
+        std::vector<process_batch_request::data> chunk(
+          std::make_move_iterator(it), std::make_move_iterator(last));
+        reqs.push_back(process_batch_request{.reqs = std::move(chunk)});
+        it = last;
+    }
+    return reqs;
+}
+
 ss::future<>
 router::process_batch(std::vector<process_batch_request::data> batch) {
     if (batch.empty()) {
@@ -185,29 +203,67 @@ router::process_batch(std::vector<process_batch_request::data> batch) {
               }
               return ss::now();
           }
-          return send_batch(
-            transport.value(), process_batch_request{.reqs = std::move(batch)});
+          // dispatch a window of concurrent requests so the engine can
+          // overlap script execution with transfer instead of serializing
+          // the entire poll round behind one round trip. each request is
+          // acked independently via its own reply.
+          return ss::do_with(
+            chunk_requests(std::move(batch)),
+            [this, transport = transport.value()](
+              std::vector<process_batch_request>& reqs) mutable {
+                return ss::parallel_for_each(
+                  reqs, [this, transport](process_batch_request& r) mutable {
+                      return send_batch(transport, std::move(r));
+                  });
+            });
       });
 }
 
-ss::future<router::opt_req_data> router::route_ntp(
+ss::future<std::vector<process_batch_request::data>> router::route_ntp(
   const model::ntp& ntp,
-  storage::log_reader_config config,
   ss::lw_shared_ptr<router_source_manager::topic_state> ts) {
-    return ts->log.make_reader(config)
+    using acc_t = std::vector<process_batch_request::data>;
+    return make_lanes(ts).then([this, ntp, ts](lane_map lanes) {
+        if (lanes.empty()) {
+            return ss::make_ready_future<acc_t>();
+        }
+        return ss::do_with(
+          std::move(lanes), acc_t(), [this, ntp, ts](lane_map& lanes, acc_t& acc) {
+              return ss::do_for_each(
+                       lanes,
+                       [this, ntp, ts, &acc](lane_map::value_type& lane) {
+                           return route_lane(ntp, ts, lane, acc);
+                       })
+                .then([&acc] { return std::move(acc); });
+          });
+    });
+}
+
+ss::future<> router::route_lane(
+  const model::ntp& ntp,
+  ss::lw_shared_ptr<router_source_manager::topic_state> ts,
+  lane_map::value_type& lane,
+  std::vector<process_batch_request::data>& acc) {
+    auto cfg = reader_cfg(
+      lane.first, model::model_limits<model::offset>::max());
+    return ts->log.make_reader(cfg)
       .then([this](model::record_batch_reader reader) {
           return extract_offset(std::move(reader));
       })
-      .then([ntp = std::move(ntp), ts = std::move(ts)](
-              std::optional<offset_rbr_pair> offset_and_batch) mutable {
+      .then([ntp, ts, &lane, &acc](
+              std::optional<offset_rbr_pair> offset_and_batch) {
           if (!offset_and_batch) {
-              return opt_req_data(std::nullopt);
+              return;
           }
           auto& [offset, rbr] = *offset_and_batch;
-          ts->dirty = offset;
-          return opt_req_data(process_batch_request::data{
-            .ids = {ts->scripts.begin(), ts->scripts.end()},
-            .ntp = std::move(ntp),
+          for (const auto sid : lane.second) {
+              if (auto it = ts->scripts.find(sid); it != ts->scripts.end()) {
+                  it->second.dirty = offset;
+              }
+          }
+          acc.emplace_back(process_batch_request::data{
+            .ids = std::move(lane.second),
+            .ntp = ntp,
             .reader = std::move(rbr)});
       });
 }
@@ -258,7 +314,9 @@ void router::bump_offset(const model::ntp& src_ntp, const script_id sid) {
         vlog(coproclog.warn, "Script id removed before offset set: {}", sid);
         return;
     }
-    found->second->committed = found->second->dirty;
+    // only this script's lane advances; the others commit from their own
+    // replies
+    fsid->second.committed = fsid->second.dirty;
 }
 
 ss::future<> router::process_reply_one(process_batch_reply::data e) {
@@ -310,30 +368,33 @@ ss::future<> router::process_reply_one(process_batch_reply::data e) {
     });
 }
 
-ss::future<router::opt_cfg> router::make_reader_cfg(
+ss::future<router::lane_map> router::make_lanes(
   ss::lw_shared_ptr<router_source_manager::topic_state> ts) {
     /**
-     * Making a reader will grab a mutual exclusion lock on reading from the
-     * requested log. This is OK for now since the only topic_ingestion_policy
+     * Grabs the topics mutual exclusion lock while inspecting per script
+     * offsets. This is OK for now since the only topic_ingestion_policy
      * supported will be 'latest'
      *
-     * On success the last offset will be recorded and the request is prepared
-     * and returned.
+     * Scripts that will read from the same offset share a lane - in the
+     * common case all scripts are caught up to the same point and the
+     * topic is read once. A script whose replies lag (or fail) falls into
+     * its own lane and re-reads without holding the others back.
      */
-    return ts->mtx.with([this, ts = std::move(ts)]() {
+    return ts->mtx.with([ts = std::move(ts)]() {
         const storage::offset_stats ostats = ts->log.offsets();
-        const model::offset committed = ts->committed;
-        if (committed >= ostats.committed_offset) {
-            // Signifies materialized log is up-to-date with source, there
-            // isn't anything more to read
-            return opt_cfg(std::nullopt);
+        lane_map lanes;
+        for (const auto& [sid, state] : ts->scripts) {
+            if (state.committed >= ostats.committed_offset) {
+                // up-to-date with source, there isn't anything more to read
+                continue;
+            }
+            const model::offset start
+              = (state.committed == model::model_limits<model::offset>::min())
+                  ? model::offset(0)
+                  : state.committed + model::offset(1);
+            lanes[start].push_back(sid);
         }
-        const model::offset start
-          = (committed == model::model_limits<model::offset>::min())
-              ? model::offset(0)
-              : committed + model::offset(1);
-        return opt_cfg(
-          reader_cfg(start, model::model_limits<model::offset>::max()));
+        return lanes;
     });
 }
 
@@ -34,6 +34,12 @@ namespace coproc {
 /// topics can resume upon last processed record in the case of a failure.
 class router {
 public:
+    /// Maximum number of engine requests dispatched concurrently per poll
+    /// round. The per-ntp data of one round is split across this many
+    /// requests so replies (and therefore offset bumps) are windowed
+    /// instead of serialized behind a single round trip.
+    static constexpr size_t max_inflight_requests = 4;
+
     router(ss::socket_address, ss::sharded<storage::api>&);
 
     /// Begin the loop on the current shard
@@ -57,8 +63,9 @@ public:
 private:
     using offset_rbr_pair
       = std::pair<model::offset, model::record_batch_reader>;
-    using opt_req_data = std::optional<process_batch_request::data>;
-    using opt_cfg = std::optional<storage::log_reader_config>;
+    /// Scripts laned by the offset they will read from next; scripts at
+    /// the same offset share one read and one request entry
+    using lane_map = absl::flat_hash_map<model::offset, std::vector<script_id>>;
 
     ss::future<result<supervisor_client_protocol>> get_client();
     ss::future<storage::log> get_log(const model::ntp& ntp);
@@ -68,10 +75,14 @@ private:
 
     ss::future<> route();
     ss::future<> do_route();
-    ss::future<opt_req_data> route_ntp(
+    ss::future<std::vector<process_batch_request::data>> route_ntp(
       const model::ntp&,
-      storage::log_reader_config,
       ss::lw_shared_ptr<router_source_manager::topic_state>);
+    ss::future<> route_lane(
+      const model::ntp&,
+      ss::lw_shared_ptr<router_source_manager::topic_state>,
+      lane_map::value_type&,
+      std::vector<process_batch_request::data>&);
 
     ss::future<> process_batch(std::vector<process_batch_request::data>);
     ss::future<> send_batch(supervisor_client_protocol, process_batch_request);
@@ -80,8 +91,8 @@ private:
       extract_offset(model::record_batch_reader);
     void bump_offset(const model::ntp&, const script_id);
 
-    ss::future<opt_cfg>
-      make_reader_cfg(ss::lw_shared_ptr<router_source_manager::topic_state>);
+    ss::future<lane_map>
+      make_lanes(ss::lw_shared_ptr<router_source_manager::topic_state>);
     storage::log_reader_config reader_cfg(model::offset, model::offset);
 
 private:
@@ -46,15 +46,15 @@ void router_source_manager::do_process_additions(script_id id, source& src) {
 
     for (const auto& [ntp, log] : logs) {
         if (auto found = _sources.find(ntp); found == _sources.end()) {
-            auto ts = ss::make_lw_shared<topic_state>(
-              topic_state{.log = log, .scripts = {id}});
+            auto ts = ss::make_lw_shared<topic_state>(topic_state{.log = log});
+            ts->scripts.emplace(id, script_state{});
             vassert(
               _sources.emplace(ntp, std::move(ts)).second,
               "Insertion into _sources failed when it was checked to already "
               "not have the existing key: {}",
               ntp);
         } else {
-            found->second->scripts.emplace(id);
+            found->second->scripts.emplace(id, script_state{});
         }
         vlog(coproclog.info, "Inserted ntp {} id {}", ntp, id);
     }
@@ -15,11 +15,17 @@ namespace coproc {
 
 class router_source_manager {
 public:
-    struct topic_state {
-        storage::log log;
-        absl::flat_hash_set<script_id> scripts;
+    /// Offsets are tracked per script so a slow or failing script only
+    /// delays its own lane; the other scripts sharing the topic keep
+    /// consuming independently
+    struct script_state {
         model::offset committed{model::model_limits<model::offset>::min()};
         model::offset dirty{model::model_limits<model::offset>::min()};
+    };
+
+    struct topic_state {
+        storage::log log;
+        absl::flat_hash_map<script_id, script_state> scripts;
         mutex mtx;
     };
 
@@ -0,0 +1,134 @@
+#pragma once
+#include "model/record.h"
+
+#include <seastar/core/future.hh>
+
+#include <optional>
+#include <vector>
+
+namespace coproc {
+
+/// Ready-made combine operations for sliding_window_accumulator. Any
+/// associative binary op (a monoid without an explicit identity - the
+/// empty window reports std::nullopt instead) works as a drop-in.
+template<typename T>
+struct window_sum {
+    T operator()(const T& a, const T& b) const { return a + b; }
+};
+
+template<typename T>
+struct window_min {
+    T operator()(const T& a, const T& b) const { return std::min(a, b); }
+};
+
+template<typename T>
+struct window_max {
+    T operator()(const T& a, const T& b) const { return std::max(a, b); }
+};
+
+/**
+ * Incremental sliding-window aggregate over an associative combine op.
+ *
+ * Windowed scripts used to re-scan the whole window on every emission,
+ * costing O(window) per output. This maintains the aggregate as elements
+ * enter and leave using the classic two-stack queue: the back stack
+ * accumulates a running aggregate of recent pushes, the front stack holds
+ * suffix aggregates of older elements, and the window aggregate is the
+ * combine of the two stack tops. push/pop are amortized O(1) and value()
+ * is O(1), so emission cost no longer scales with window size.
+ *
+ * The combine op only needs associativity (sum, count, min, max, or any
+ * custom monoid); commutativity is not required - elements are combined
+ * in arrival order.
+ */
+template<typename T, typename Combine>
+class sliding_window_accumulator {
+public:
+    sliding_window_accumulator() = default;
+    explicit sliding_window_accumulator(Combine op)
+      : _op(std::move(op)) {}
+
+    /// add the newest element to the window; amortized O(1)
+    void push(T v) {
+        if (_back_agg) {
+            _back_agg = _op(*_back_agg, v);
+        } else {
+            _back_agg = v;
+        }
+        _back.push_back(std::move(v));
+    }
+
+    /// evict the oldest element from the window; amortized O(1)
+    void pop() {
+        if (_front.empty()) {
+            // flip: turn raw back-stack values into suffix aggregates so
+            // that _front.back() is always the aggregate of the oldest
+            // remaining elements
+            while (!_back.empty()) {
+                T v = std::move(_back.back());
+                _back.pop_back();
+                if (_front.empty()) {
+                    _front.push_back(std::move(v));
+                } else {
+                    _front.push_back(_op(v, _front.back()));
+                }
+            }
+            _back_agg = std::nullopt;
+        }
+        _front.pop_back();
+    }
+
+    /// aggregate over the whole window, std::nullopt when empty; O(1)
+    std::optional<T> value() const {
+        if (_front.empty()) {
+            return _back_agg;
+        }
+        if (!_back_agg) {
+            return _front.back();
+        }
+        return _op(_front.back(), *_back_agg);
+    }
+
+    size_t size() const { return _front.size() + _back.size(); }
+    bool empty() const { return _front.empty() && _back.empty(); }
+
+private:
+    std::vector<T> _front; // suffix aggregates, oldest on top
+    std::vector<T> _back;  // raw values in arrival order
+    std::optional<T> _back_agg;
+    Combine _op;
+};
+
+/**
+ * Reference consumer maintaining a count-based sliding-window aggregate
+ * over record batches, one window element per batch. Plugs into
+ * reference_window_consumer like any other ref consumer: Extract maps a
+ * batch to a window element (e.g. its record count or payload size) and
+ * end_of_stream() returns the aggregate over the last window_size
+ * batches. Older batches fall out of the window automatically.
+ */
+template<typename T, typename Combine, typename Extract>
+class windowed_aggregate_consumer {
+public:
+    windowed_aggregate_consumer(size_t window_size, Extract fn)
+      : _window_size(window_size)
+      , _extract(std::move(fn)) {}
+
+    ss::future<ss::stop_iteration> operator()(model::record_batch& b) {
+        _acc.push(_extract(b));
+        if (_acc.size() > _window_size) {
+            _acc.pop();
+        }
+        return ss::make_ready_future<ss::stop_iteration>(
+          ss::stop_iteration::no);
+    }
+
+    std::optional<T> end_of_stream() { return _acc.value(); }
+
+private:
+    size_t _window_size;
+    Extract _extract;
+    sliding_window_accumulator<T, Combine> _acc;
+};
+
+} // namespace coproc
@@ -0,0 +1,44 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "kafka/batch_dedup_cache.h"
+
+namespace kafka {
+
+bool batch_dedup_cache::seen(
+  uint64_t fingerprint, std::chrono::milliseconds window) const {
+    auto it = _index.find(fingerprint);
+    if (it == _index.end()) {
+        return false;
+    }
+    return it->second.added + window >= ss::lowres_clock::now();
+}
+
+void batch_dedup_cache::add(uint64_t fingerprint) {
+    while (_fifo.size() >= max_entries) {
+        auto& oldest = _fifo.front();
+        // the fingerprint may have been refreshed by a newer insertion;
+        // only its own index entry is dropped
+        auto it = _index.find(oldest.fingerprint);
+        if (it != _index.end() && it->second.seq == oldest.seq) {
+            _index.erase(it);
+        }
+        _fifo.pop_front();
+    }
+    auto seq = _seq++;
+    _fifo.push_back(entry{.fingerprint = fingerprint, .seq = seq});
+    _index[fingerprint] = slot{.added = ss::lowres_clock::now(), .seq = seq};
+}
+
+batch_dedup_registry& batch_dedups() {
+    static thread_local batch_dedup_registry registry;
+    return registry;
+}
+
+} // namespace kafka
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/fundamental.h"
+#include "seastarx.h"
+
+#include <seastar/core/circular_buffer.hh>
+#include <seastar/core/lowres_clock.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <chrono>
+#include <cstdint>
+
+namespace kafka {
+
+/**
+ * Per partition window of recently written batch fingerprints.
+ *
+ * Connector style clients restart and re-produce their recent window
+ * verbatim, briefly doubling write volume. A batch whose xxhash
+ * fingerprint (header identity fields plus the record payload, see
+ * model::xxhash_record_batch) was written within the configured window is
+ * acknowledged without being replicated again, saving the disk and
+ * replication bandwidth of the replay.
+ *
+ * The shield is probabilistic by design: with the bounded window of
+ * max_entries 64-bit fingerprints a false collision is vanishingly rare,
+ * and a false miss (entry aged out or evicted) merely writes the
+ * duplicate, which is the status quo. Fingerprints are recorded only
+ * after successful replication so a failed write is never remembered as
+ * present.
+ */
+class batch_dedup_cache {
+public:
+    /// bound on remembered fingerprints per partition; adding one beyond
+    /// the bound evicts the oldest
+    static constexpr size_t max_entries = 256;
+
+    /// true when the fingerprint was recorded no longer than window ago
+    bool seen(uint64_t fingerprint, std::chrono::milliseconds window) const;
+
+    /// records a fingerprint as written now
+    void add(uint64_t fingerprint);
+
+    size_t size() const { return _index.size(); }
+
+private:
+    struct entry {
+        uint64_t fingerprint;
+        // which insertion this fifo slot belongs to; a refreshed
+        // fingerprint's stale slot must not drop the fresh index entry
+        uint64_t seq;
+    };
+    struct slot {
+        ss::lowres_clock::time_point added;
+        uint64_t seq;
+    };
+
+    // fifo of insertions drives eviction; the index serves the O(1) probe
+    ss::circular_buffer<entry> _fifo;
+    absl::flat_hash_map<uint64_t, slot> _index;
+    uint64_t _seq{0};
+};
+
+/**
+ * Shard local registry of the per partition caches, keyed by ntp. Looked
+ * up on the partition's home shard in the produce path, mirroring
+ * producer_states(). A cache for a partition that left the shard is inert
+ * and bounded; remove() lets housekeeping reclaim it.
+ */
+class batch_dedup_registry {
+public:
+    batch_dedup_cache& get(const model::ntp& ntp) { return _caches[ntp]; }
+    void remove(const model::ntp& ntp) { _caches.erase(ntp); }
+
+private:
+    absl::flat_hash_map<model::ntp, batch_dedup_cache> _caches;
+};
+
+/// shard local instance
+batch_dedup_registry& batch_dedups();
+
+} // namespace kafka
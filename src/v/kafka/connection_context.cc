@@ -12,7 +12,11 @@
 
 #include "kafka/protocol.h"
 #include "kafka/protocol_utils.h"
+#include "kafka/requests/api_versions_request.h"
+#include "kafka/requests/metadata_request.h"
+#include "kafka/requests/produce_request.h"
 #include "kafka/requests/request_context.h"
+#include "ssx/future-util.h"
 
 #include <seastar/core/scattered_message.hh>
 #include <seastar/core/sleep.hh>
@@ -20,26 +24,36 @@
 namespace kafka {
 
 ss::future<> connection_context::process_one_request() {
-    return parse_size(_rs.conn->input())
-      .then([this](std::optional<size_t> sz) mutable {
+    // on a busy connection the size/header bytes of the next request are
+    // usually already buffered, so these parses resolve immediately;
+    // inline_then keeps the buffered path free of continuation frames
+    return ssx::inline_then(
+      parse_size(_rs.conn->input()), [this](std::optional<size_t> sz) mutable {
           if (!sz) {
               return ss::make_ready_future<>();
           }
-          return parse_header(_rs.conn->input())
-            .then(
-              [this, s = sz.value()](std::optional<request_header> h) mutable {
-                  _rs.probe().request_received();
-                  _rs.probe().add_bytes_received(s);
-                  if (!h) {
-                      vlog(
-                        klog.debug,
-                        "could not parse header from client: {}",
-                        _rs.conn->addr);
-                      _rs.probe().header_corrupted();
-                      return ss::make_ready_future<>();
-                  }
-                  return dispatch_method_once(std::move(h.value()), s);
-              });
+          // socket boundary timestamp: the frame's first bytes just left
+          // the kernel buffer. latency accounting is anchored here so time
+          // the request spends queued behind this fiber (header parse,
+          // pipelined predecessors) is attributed to ingress rather than
+          // blamed on - or hidden from - the handler stages
+          auto ingress = request_trace::clock::now();
+          return ssx::inline_then(
+            parse_header(_rs.conn->input()),
+            [this, s = sz.value(), ingress](
+              std::optional<request_header> h) mutable {
+                _rs.probe().request_received();
+                _rs.probe().add_bytes_received(s);
+                if (!h) {
+                    vlog(
+                      klog.debug,
+                      "could not parse header from client: {}",
+                      _rs.conn->addr);
+                    _rs.probe().header_corrupted();
+                    return ss::make_ready_future<>();
+                }
+                return dispatch_method_once(std::move(h.value()), s, ingress);
+            });
       });
 }
 
@@ -49,7 +63,7 @@ bool connection_context::is_finished_parsing() const {
 
 ss::future<connection_context::session_resources>
 connection_context::throttle_request(
-  std::optional<std::string_view> client_id, size_t request_size) {
+  const request_header& hdr, size_t request_size) {
     // update the throughput tracker for this client using the
     // size of the current request and return any computed delay
     // to apply for quota throttling.
@@ -62,22 +76,49 @@ connection_context::throttle_request(
     // applied to subsequent messages allow backpressure to take
     // affect.
     auto delay = _proto.quota_mgr().record_tp_and_throttle(
-      client_id, request_size);
+      hdr.client_id, request_size);
+
+    auto throttle = delay.first_violation ? ss::lowres_clock::duration{}
+                                          : delay.duration;
+    // produce admission control: apply the smoothed replication
+    // pressure observed by earlier produce dispatches before reading
+    // the next batch off the wire. unlike quota throttling there is no
+    // first violation grace period; the overload exists now.
+    if (hdr.key == produce_api::key) {
+        throttle = std::max<ss::lowres_clock::duration>(
+          throttle, _produce_backpressure);
+    }
 
     auto fut = ss::now();
-    if (!delay.first_violation) {
-        fut = ss::sleep_abortable(delay.duration, _rs.abort_source());
+    if (throttle > ss::lowres_clock::duration{}) {
+        fut = ss::sleep_abortable(throttle, _rs.abort_source());
     }
     return fut
+      .then([this, client_id = hdr.client_id, request_size] {
+          // per-client admission: the frame's bytes are held against the
+          // client's own budget before the body is read off the wire, so
+          // a client streaming huge requests queues behind itself instead
+          // of draining the memory shared with well behaved clients
+          return _proto.quota_mgr().reserve_memory(client_id, request_size);
+      })
+      .then([this, request_size](quota_manager::memory_units client_mem) {
+          return reserve_request_units(request_size)
+            .then([client_mem = std::move(client_mem)](
+                    ss::semaphore_units<> units) mutable {
+                return std::make_pair(std::move(client_mem), std::move(units));
+            });
+      })
       .then(
-        [this, request_size] { return reserve_request_units(request_size); })
-      .then([this, delay](ss::semaphore_units<> units) {
-          return session_resources{
-            .backpressure_delay = delay.duration,
-            .memlocks = std::move(units),
-            .method_latency = _rs.hist().auto_measure(),
-          };
-      });
+        [this, delay](
+          std::pair<quota_manager::memory_units, ss::semaphore_units<>>
+            units) {
+            return session_resources{
+              .backpressure_delay = delay.duration,
+              .memlocks = std::move(units.second),
+              .client_memlocks = std::move(units.first),
+              .method_latency = _rs.hist().auto_measure(),
+            };
+        });
 }
 
 ss::future<ss::semaphore_units<>>
@@ -98,29 +139,90 @@ connection_context::reserve_request_units(size_t size) {
     return fut;
 }
 
-ss::future<>
-connection_context::dispatch_method_once(request_header hdr, size_t size) {
-    return throttle_request(hdr.client_id, size)
-      .then([this, hdr = std::move(hdr), size](session_resources sres) mutable {
+ss::future<> connection_context::dispatch_method_once(
+  request_header hdr, size_t size, request_trace::clock::time_point ingress) {
+    // tag 1-in-N requests at ingress with a latency trace, anchored at the
+    // socket boundary timestamp rather than at dispatch
+    auto trace = _proto.tracer().maybe_sample(hdr.key, ingress);
+    if (trace) {
+        trace->stage(trace_stage::ingress);
+    }
+    return throttle_request(hdr, size)
+      .then([this,
+             hdr = std::move(hdr),
+             size,
+             trace = std::move(trace),
+             ingress](session_resources sres) mutable {
           if (_rs.abort_requested()) {
               // protect against shutdown behavior
               return ss::make_ready_future<>();
           }
+          if (trace) {
+              trace->stage(trace_stage::throttle);
+          }
           auto remaining = size - sizeof(raw_request_header)
                            - hdr.client_id_buffer.size();
           return read_iobuf_exactly(_rs.conn->input(), remaining)
-            .then([this, hdr = std::move(hdr), sres = std::move(sres)](
-                    iobuf buf) mutable {
+            .then([this,
+                   hdr = std::move(hdr),
+                   sres = std::move(sres),
+                   trace = std::move(trace),
+                   ingress](iobuf buf) mutable {
                 if (_rs.abort_requested()) {
                     // _proto._cntrl etc might not be alive
                     return;
                 }
+                /*
+                 * handshake fast path: a reconnect storm is made of
+                 * api_versions + metadata pairs, and both are served
+                 * from per-shard serialized snapshots when nothing
+                 * per-request has to be encoded. a throttled request
+                 * takes the slow path since the delay is part of the
+                 * response body.
+                 */
+                if (
+                  sres.backpressure_delay == ss::lowres_clock::duration{}) {
+                    std::optional<response_ptr> fast;
+                    try {
+                        fast = handshake_fastpath(hdr, buf);
+                    } catch (...) {
+                        // malformed body: fall through so the regular
+                        // path reports the parse failure uniformly
+                        fast = std::nullopt;
+                    }
+                    if (fast) {
+                        fast.value()->set_correlation(hdr.correlation);
+                        if (trace) {
+                            trace->stage(trace_stage::handle);
+                        }
+                        const sequence_id seq = _seq_idx;
+                        _seq_idx = _seq_idx + sequence_id(1);
+                        _responses.insert(
+                          {seq,
+                           sequenced_response{
+                             std::move(*fast), std::move(trace)}});
+                        auto self = shared_from_this();
+                        (void)ss::with_gate(
+                          _rs.conn_gate(),
+                          [this] { return process_next_response(); })
+                          .handle_exception([self](std::exception_ptr e) {
+                              vlog(
+                                klog.info,
+                                "Detected error processing request: {}",
+                                e);
+                              self->_rs.conn->shutdown_input();
+                          });
+                        return;
+                    }
+                }
                 auto self = shared_from_this();
                 auto rctx = request_context(
                   self,
                   std::move(hdr),
                   std::move(buf),
-                  sres.backpressure_delay);
+                  sres.backpressure_delay,
+                  std::move(trace),
+                  ingress);
                 // background process this one full request
                 (void)ss::with_gate(
                   _rs.conn_gate(),
@@ -137,44 +239,96 @@ connection_context::dispatch_method_once(request_header hdr, size_t size) {
       });
 }
 
+std::optional<response_ptr>
+connection_context::handshake_fastpath(const request_header& hdr, iobuf& buf) {
+    if (hdr.key == api_versions_api::key) {
+        return api_versions_api::handshake_response(hdr);
+    }
+    if (hdr.key == metadata_api::key) {
+        return metadata_api::handshake_response(
+          hdr,
+          buf,
+          _proto.metadata_cache(),
+          _proto.quota_mgr(),
+          _rs.probe().connections());
+    }
+    return std::nullopt;
+}
+
 ss::future<> connection_context::do_process(request_context ctx) {
     const auto correlation = ctx.header().correlation;
     const sequence_id seq = _seq_idx;
     _seq_idx = _seq_idx + sequence_id(1);
+    auto trace = ctx.trace();
     return kafka::process_request(std::move(ctx), _proto.smp_group())
-      .then([this, seq, correlation](response_ptr r) mutable {
+      .then([this, seq, correlation, trace = std::move(trace)](
+              response_ptr r) mutable {
+          if (trace) {
+              trace->stage(trace_stage::handle);
+          }
           r->set_correlation(correlation);
-          _responses.insert({seq, std::move(r)});
+          _responses.insert(
+            {seq, sequenced_response{std::move(r), std::move(trace)}});
           return process_next_response();
       });
 }
 
 ss::future<> connection_context::process_next_response() {
     return ss::repeat([this]() mutable {
-        auto it = _responses.find(_next_response);
-        if (it == _responses.end()) {
-            return ss::make_ready_future<ss::stop_iteration>(
-              ss::stop_iteration::yes);
-        }
-        // found one; increment counter
-        _next_response = _next_response + sequence_id(1);
+        // coalesce every response that is already in sequence order into a
+        // single scattered message so pipelined clients pay one socket write
+        // for the whole batch instead of one per response. the batch is
+        // capped at the output stream's flush threshold; anything beyond
+        // that goes out on the next iteration.
+        constexpr size_t max_coalesced_bytes
+          = rpc::batched_output_stream::default_max_unflushed_bytes;
+        ss::scattered_message<char> msg;
+        std::vector<request_trace_ptr> traces;
+        size_t coalesced = 0;
+        while (msg.size() < max_coalesced_bytes) {
+            auto it = _responses.find(_next_response);
+            if (it == _responses.end()) {
+                break;
+            }
+            // found one; increment counter
+            _next_response = _next_response + sequence_id(1);
 
-        auto r = std::move(it->second);
-        _responses.erase(it);
-        _rs.probe().request_completed();
+            auto r = std::move(it->second.response);
+            auto trace = std::move(it->second.trace);
+            _responses.erase(it);
+            _rs.probe().request_completed();
 
-        if (r->is_noop()) {
+            if (trace) {
+                trace->stage(trace_stage::queue);
+            }
+            if (r->is_noop()) {
+                // acks=0: nothing is written back, the trace ends here
+                if (trace) {
+                    trace->finish();
+                }
+                continue;
+            }
+            response_into_scattered(msg, std::move(r));
+            if (trace) {
+                traces.push_back(std::move(trace));
+            }
+            ++coalesced;
+        }
+        if (coalesced == 0) {
             return ss::make_ready_future<ss::stop_iteration>(
-              ss::stop_iteration::no);
+              ss::stop_iteration::yes);
         }
-
-        auto msg = response_as_scattered(std::move(r));
         _rs.probe().add_bytes_sent(msg.size());
         try {
-            return _rs.conn->write(std::move(msg)).then([] {
-                return ss::make_ready_future<ss::stop_iteration>(
-                  ss::stop_iteration::no);
-            });
+            return _rs.conn->write(std::move(msg))
+              .then([traces = std::move(traces)] {
+                  for (auto& trace : traces) {
+                      trace->stage(trace_stage::write);
+                      trace->finish();
+                  }
+                  return ss::make_ready_future<ss::stop_iteration>(
+                    ss::stop_iteration::no);
+              });
         } catch (...) {
             vlog(
               klog.debug,
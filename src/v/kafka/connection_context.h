@@ -10,6 +10,7 @@
  */
 #pragma once
 #include "kafka/protocol.h"
+#include "kafka/request_tracer.h"
 #include "kafka/requests/response.h"
 #include "rpc/server.h"
 #include "seastarx.h"
@@ -24,6 +25,7 @@
 #include <absl/container/flat_hash_map.h>
 
 #include <memory>
+#include <optional>
 
 namespace kafka {
 
@@ -44,14 +46,29 @@ public:
 
     protocol& server() { return _proto; }
 
+    /// open kafka connections on this shard
+    uint32_t shard_connections() { return _rs.probe().connections(); }
+
     ss::future<> process_one_request();
     bool is_finished_parsing() const;
 
+    /// produce admission control. replication pressure observed by produce
+    /// dispatches is smoothed here and applied as a delay before the next
+    /// produce request is read off the wire, so an overloaded shard sheds
+    /// ingest at the socket instead of queueing work destined to time out.
+    void record_produce_pressure(std::chrono::milliseconds delay) {
+        _produce_backpressure = std::chrono::milliseconds(
+          static_cast<int64_t>(
+            (0.7 * _produce_backpressure.count())
+            + (0.3 * delay.count())));
+    }
+
 private:
     // used to pass around some internal state
     struct session_resources {
         ss::lowres_clock::duration backpressure_delay;
         ss::semaphore_units<> memlocks;
+        quota_manager::memory_units client_memlocks;
         std::unique_ptr<hdr_hist::measurement> method_latency;
     };
 
@@ -60,21 +77,36 @@ private:
 
     /// apply correct backpressure sequence
     ss::future<session_resources>
-    throttle_request(std::optional<std::string_view>, size_t sz);
+    throttle_request(const request_header&, size_t sz);
 
-    ss::future<> dispatch_method_once(request_header, size_t sz);
+    ss::future<> dispatch_method_once(
+      request_header, size_t sz, request_trace::clock::time_point ingress);
     ss::future<> process_next_response();
     ss::future<> do_process(request_context);
 
+    /// handshake fast path: serve api_versions and full-listing
+    /// metadata from per-shard serialized snapshots, skipping request
+    /// context setup and handler dispatch. nullopt falls through to the
+    /// regular dispatch path
+    std::optional<response_ptr>
+    handshake_fastpath(const request_header& hdr, iobuf& buf);
+
 private:
     using sequence_id = named_type<uint64_t, struct kafka_protocol_sequence>;
-    using map_t = absl::flat_hash_map<sequence_id, response_ptr>;
+    // a response waiting for its turn in the pipeline order, together with
+    // the latency trace of its request when it was sampled
+    struct sequenced_response {
+        response_ptr response;
+        request_trace_ptr trace;
+    };
+    using map_t = absl::flat_hash_map<sequence_id, sequenced_response>;
 
     protocol& _proto;
     rpc::server::resources _rs;
     sequence_id _next_response;
     sequence_id _seq_idx;
     map_t _responses;
+    std::chrono::milliseconds _produce_backpressure{0};
 };
 
 } // namespace kafka
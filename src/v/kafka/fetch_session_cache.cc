@@ -72,10 +72,10 @@ fetch_session_cache::maybe_get_session(const fetch_request& req) {
     if (req.is_full_fetch_request()) {
         // Any session specified in a FULL fetch request will be closed.
         if (session_id != invalid_fetch_session_id) {
-            if (auto it = _sessions.find(session_id); it != _sessions.end()) {
+            if (auto* session = _sessions.find(session_id)) {
                 vlog(klog.info, "removing fetch session {}", session_id);
-                _sessions_mem_usage -= it->second->mem_usage();
-                _sessions.erase(it);
+                _sessions_mem_usage -= (*session)->mem_usage();
+                _sessions.erase(session_id);
             }
         }
         if (epoch == final_fetch_session_epoch) {
@@ -95,23 +95,23 @@ fetch_session_cache::maybe_get_session(const fetch_request& req) {
         // initialize fetch session partitions
         update_fetch_session(*new_session, req);
 
-        auto [it, success] = _sessions.emplace(*new_id, std::move(new_session));
         vassert(
-          success,
+          !_sessions.contains(*new_id),
           "fetch session {} already exists, can not insert the session",
           *new_id);
+        auto& session = _sessions.insert(*new_id, std::move(new_session));
 
         vlog(klog.info, "fetch session created: {}", *new_id);
-        _sessions_mem_usage += it->second->mem_usage();
-        return fetch_session_ctx(it->second, true);
+        _sessions_mem_usage += session->mem_usage();
+        return fetch_session_ctx(session, true);
     }
-    auto it = _sessions.find(session_id);
-    if (it == _sessions.end()) {
+    auto* it = _sessions.get(session_id);
+    if (it == nullptr) {
         vlog(klog.info, "no session with id {} found", session_id);
         return fetch_session_ctx(error_code::fetch_session_id_not_found);
     }
 
-    auto session = it->second;
+    auto session = *it;
     if (session->epoch() != epoch) {
         vlog(
           klog.info,
@@ -160,19 +160,20 @@ std::optional<fetch_session_id> fetch_session_cache::new_session_id() {
 
 void fetch_session_cache::gc_sessions() {
     auto now = model::timeout_clock::now();
-    for (auto it = _sessions.cbegin(); it != _sessions.cend();) {
-        // session is in use or was used recently skip
+    // sessions sit in lru order, so the expired ones form a prefix of the
+    // cold end of the list; stop at the first session that is in use or
+    // was used recently
+    _sessions.evict_while([this, now](auto& e) {
+        auto& session = e.value;
         if (
-          it->second->is_locked()
-          || now - it->second->_last_used < _session_eviction_duration) {
-            // do nothing
-            ++it;
-        } else {
-            vlog(klog.debug, "evicting session {}", it->second->id());
-            _sessions_mem_usage -= it->second->mem_usage();
-            _sessions.erase(it++);
+          session->is_locked()
+          || now - session->_last_used < _session_eviction_duration) {
+            return false;
         }
-    }
+        vlog(klog.debug, "evicting session {}", session->id());
+        _sessions_mem_usage -= session->mem_usage();
+        return true;
+    });
 }
 
 void fetch_session_cache::register_metrics() {
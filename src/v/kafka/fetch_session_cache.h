@@ -13,11 +13,10 @@
 #include "kafka/fetch_session.h"
 #include "kafka/types.h"
 #include "units.h"
+#include "utils/lru_hash_map.h"
 
 #include <seastar/core/metrics_registration.hh>
 
-#include <absl/container/flat_hash_map.h>
-
 #include <chrono>
 
 namespace kafka {
@@ -39,8 +38,9 @@ public:
     size_t size() const { return _sessions.size(); }
 
 private:
-    using underlying_t
-      = absl::flat_hash_map<fetch_session_id, fetch_session_ptr>;
+    // sessions are kept in lru order by the container itself so eviction
+    // only has to look at the cold end instead of scanning every session
+    using underlying_t = lru_hash_map<fetch_session_id, fetch_session_ptr>;
 
     static constexpr size_t max_mem_usage = 10_MiB;
 
@@ -57,9 +57,7 @@ private:
     void gc_sessions();
 
     size_t mem_usage() const {
-        using debug = absl::container_internal::hashtable_debug_internal::
-          HashtableDebugAccess<underlying_t>;
-        return debug::AllocatedByteSize(_sessions) + _sessions_mem_usage;
+        return _sessions.memory_allocated() + _sessions_mem_usage;
     }
 
     void register_metrics();
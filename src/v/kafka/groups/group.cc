@@ -32,6 +32,7 @@
 #include <fmt/ostream.h>
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <iterator>
 #include <ostream>
@@ -39,6 +40,7 @@
 #include <stdexcept>
 #include <streambuf>
 #include <utility>
+#include <utility>
 
 namespace kafka {
 
@@ -133,6 +135,31 @@ bool group::supports_protocols(const join_group_request& r) {
       });
 }
 
+/*
+ * partition assignment protocols that rebalance cooperatively. the coordinator
+ * recognizes these by name, mirroring the classification that clients apply to
+ * their configured assignors.
+ */
+static const std::array<kafka::protocol_name, 1> cooperative_protocols{
+  kafka::protocol_name("cooperative-sticky")};
+
+bool group::is_cooperative() const {
+    if (_members.empty()) {
+        return false;
+    }
+    return std::all_of(
+      std::cbegin(_members),
+      std::cend(_members),
+      [](const member_map::value_type& m) {
+          return std::any_of(
+            std::cbegin(cooperative_protocols),
+            std::cend(cooperative_protocols),
+            [&m](const kafka::protocol_name& protocol) {
+                return m.second->supports_protocol(protocol);
+            });
+      });
+}
+
 void group::add_member_no_join(member_ptr member) {
     if (_members.empty()) {
         _protocol_type = member->protocol_type();
@@ -618,7 +645,15 @@ void group::try_prepare_rebalance() {
     // them rejoin.</kafka>
     if (in_state(group_state::completing_rebalance)) {
         klog.trace("requesting rejoin from syncing members");
-        clear_assignments();
+        /*
+         * eager members revoke everything before rejoining so their cached
+         * assignment is stale. cooperative members keep fetching from the
+         * partitions they own until the next assignment is installed, so the
+         * previously confirmed assignment is retained.
+         */
+        if (!is_cooperative()) {
+            clear_assignments();
+        }
         finish_syncing_members(error_code::rebalance_in_progress);
     }
 
@@ -1174,41 +1209,71 @@ void group::fail_offset_commit(
 
 ss::future<offset_commit_response>
 group::store_offsets(offset_commit_request&& r) {
+    /*
+     * queue the commit for the next flush window. when no flush is in
+     * progress the caller drives one immediately, otherwise the commit is
+     * coalesced into the batch built once the in-flight replication
+     * completes.
+     */
+    _queued_offset_commits.emplace_back(std::move(r));
+    auto response = _queued_offset_commits.back().promise.get_future();
+    if (_offset_flush_in_progress) {
+        return response;
+    }
+    return flush_offset_commits().then(
+      [response = std::move(response)]() mutable {
+          return std::move(response);
+      });
+}
+
+ss::future<> group::flush_offset_commits() {
+    _offset_flush_in_progress = true;
+    auto queued = std::exchange(_queued_offset_commits, {});
+
+    // coalesce repeated commits for the same topic partition. the last value
+    // queued within the flush window wins and is written to the log once.
+    absl::flat_hash_map<model::topic_partition, group_log_offset_metadata>
+      coalesced;
+    for (const auto& q : queued) {
+        for (const auto& t : q.request.data.topics) {
+            for (const auto& p : t.partitions) {
+                model::topic_partition tp(t.name, p.partition_index);
+                coalesced[tp] = group_log_offset_metadata{
+                  p.committed_offset,
+                  p.committed_leader_epoch,
+                  p.committed_metadata,
+                };
+            }
+        }
+    }
+
     cluster::simple_batch_builder builder(
       raft::data_batch_type, model::offset(0));
 
     std::vector<std::pair<model::topic_partition, offset_metadata>>
       offset_commits;
-
-    for (const auto& t : r.data.topics) {
-        for (const auto& p : t.partitions) {
-            group_log_record_key key{
-              .record_type = group_log_record_key::type::offset_commit,
-              .key = reflection::to_iobuf(group_log_offset_key{
-                _id,
-                t.name,
-                p.partition_index,
-              }),
-            };
-            group_log_offset_metadata val{
-              p.committed_offset,
-              p.committed_leader_epoch,
-              p.committed_metadata,
-            };
-            builder.add_kv(std::move(key), std::move(val));
-
-            model::topic_partition tp(t.name, p.partition_index);
-            offset_metadata md{
-              .offset = p.committed_offset,
-              .metadata = p.committed_metadata.value_or(""),
-            };
-
-            offset_commits.emplace_back(std::make_pair(tp, md));
-
-            // record the offset commits as pending commits which will be
-            // inspected after the append to catch concurrent updates.
-            _pending_offset_commits[tp] = md;
-        }
+    offset_commits.reserve(coalesced.size());
+
+    for (auto& [tp, val] : coalesced) {
+        group_log_record_key key{
+          .record_type = group_log_record_key::type::offset_commit,
+          .key = reflection::to_iobuf(group_log_offset_key{
+            _id,
+            tp.topic,
+            tp.partition,
+          }),
+        };
+        offset_metadata md{
+          .offset = val.offset,
+          .metadata = val.metadata.value_or(""),
+        };
+        builder.add_kv(std::move(key), std::move(val));
+
+        offset_commits.emplace_back(std::make_pair(tp, md));
+
+        // record the offset commits as pending commits which will be
+        // inspected after the append to catch concurrent updates.
+        _pending_offset_commits[tp] = md;
     }
 
     auto batch = std::move(builder).build();
@@ -1218,25 +1283,33 @@ group::store_offsets(offset_commit_request&& r) {
       ->replicate(
         std::move(reader),
         raft::replicate_options(raft::consistency_level::quorum_ack))
-      .then([this, req = std::move(r), commits = std::move(offset_commits)](
+      .then([this,
+             queued = std::move(queued),
+             commits = std::move(offset_commits)](
               result<raft::replicate_result> r) mutable {
           error_code error = r ? error_code::none : error_code::not_coordinator;
-          if (in_state(group_state::dead)) {
-              return offset_commit_response(req, error);
+          if (!in_state(group_state::dead)) {
+              if (error == error_code::none) {
+                  for (auto& e : commits) {
+                      e.second.log_offset = r.value().last_offset;
+                      complete_offset_commit(e.first, e.second);
+                  }
+              } else {
+                  for (const auto& e : commits) {
+                      fail_offset_commit(e.first, e.second);
+                  }
+              }
           }
 
-          if (error == error_code::none) {
-              for (auto& e : commits) {
-                  e.second.log_offset = r.value().last_offset;
-                  complete_offset_commit(e.first, e.second);
-              }
-          } else {
-              for (const auto& e : commits) {
-                  fail_offset_commit(e.first, e.second);
-              }
+          for (auto& q : queued) {
+              q.promise.set_value(offset_commit_response(q.request, error));
           }
 
-          return offset_commit_response(req, error);
+          _offset_flush_in_progress = false;
+          if (!_queued_offset_commits.empty()) {
+              return flush_offset_commits();
+          }
+          return ss::now();
       });
 }
 
@@ -222,6 +222,20 @@ public:
      */
     bool supports_protocols(const join_group_request& r);
 
+    /**
+     * \brief Check if the group rebalances cooperatively.
+     *
+     * The rebalance protocol is a property of the embedded partition
+     * assignment protocols: eager members revoke all owned partitions before
+     * rejoining, while cooperative members keep fetching from partitions they
+     * own during a rebalance and only revoke what the next assignment takes
+     * away. A group is cooperative only if every member supports a
+     * cooperative assignment protocol. The coordinator recognizes the
+     * protocols by name, mirroring the classification clients apply to their
+     * configured assignors.
+     */
+    bool is_cooperative() const;
+
     /**
      * \brief Add a member to the group.
      *
@@ -397,6 +411,15 @@ public:
     void fail_offset_commit(
       const model::topic_partition& tp, const offset_metadata& md);
 
+    /**
+     * \brief Store offset commits on the coordinator partition.
+     *
+     * Commits are written in flush windows. While a batch is replicating,
+     * newly arriving commits are queued and coalesced into a single follow-up
+     * batch, so a topic partition committed repeatedly within a window is
+     * written to the log once. A response is only delivered after the batch
+     * carrying the commit has been replicated.
+     */
     ss::future<offset_commit_response> store_offsets(offset_commit_request&& r);
 
     ss::future<offset_commit_response>
@@ -420,6 +443,19 @@ private:
 
     model::record_batch checkpoint(const assignments_type& assignments);
 
+    /// A commit waiting for the next flush of the offset commit queue.
+    struct queued_offset_commit {
+        explicit queued_offset_commit(offset_commit_request r)
+          : request(std::move(r)) {}
+
+        offset_commit_request request;
+        ss::promise<offset_commit_response> promise;
+    };
+
+    /// Replicate queued offset commits as a single coalesced batch. Restarts
+    /// itself if more commits were queued while the batch was in flight.
+    ss::future<> flush_offset_commits();
+
     kafka::group_id _id;
     group_state _state;
     clock_type::time_point _state_timestamp;
@@ -438,6 +474,8 @@ private:
     absl::flat_hash_map<model::topic_partition, offset_metadata> _offsets;
     absl::flat_hash_map<model::topic_partition, offset_metadata>
       _pending_offset_commits;
+    std::vector<queued_offset_commit> _queued_offset_commits;
+    bool _offset_flush_in_progress{false};
 };
 
 using group_ptr = ss::lw_shared_ptr<group>;
@@ -46,10 +46,20 @@ ss::future<> group_manager::start() {
       cluster::kafka_group_topic,
       [this](ss::lw_shared_ptr<cluster::partition> p) { attach_partition(p); });
 
+    /*
+     * periodically fold the committed suffix of each attached partition's
+     * log into its recovery snapshot so that a future leadership change
+     * replays a bounded amount of history. see group_manager docs.
+     */
+    _snapshot_timer.set_callback([this] { refresh_recovery_snapshots(); });
+    _snapshot_timer.arm_periodic(
+      config::shard_local_cfg().kafka_group_snapshot_interval_ms());
+
     return ss::make_ready_future<>();
 }
 
 ss::future<> group_manager::stop() {
+    _snapshot_timer.cancel();
     _pm.local().unregister_manage_notification(_manage_notify_handle);
     _gm.local().unregister_leadership_notification(_leader_notify_handle);
 
@@ -126,13 +136,21 @@ ss::future<> group_manager::handle_partition_leader_change(
          */
         return inject_noop(p->partition, timeout).then([this, timeout, p] {
             /*
-             * the full log is read and deduplicated. the dedupe processing is
-             * based on the record keys, so this code should be ready to
-             * transparently take advantage of key-based compaction in the
-             * future.
+             * everything below the recovery snapshot was already folded into
+             * it; only the log suffix is read and deduplicated on top. the
+             * dedupe processing is based on the record keys, so this code
+             * should be ready to transparently take advantage of key-based
+             * compaction in the future.
              */
+            auto snap = load_recovery_snapshot(p->partition->ntp());
+            auto start = p->partition->start_offset();
+            if (snap) {
+                start = std::max(
+                  model::offset(snap->last_offset() + 1), start);
+            }
+
             storage::log_reader_config reader_config(
-              p->partition->start_offset(),
+              start,
               model::model_limits<model::offset>::max(),
               0,
               std::numeric_limits<size_t>::max(),
@@ -141,18 +159,27 @@ ss::future<> group_manager::handle_partition_leader_change(
               std::nullopt,
               std::nullopt);
 
+            auto ctx = recovery_batch_consumer(&p->as);
+            ctx.last_read_offset = model::offset(start() - 1);
+            seed_from_snapshot(ctx, std::move(snap));
+
             return p->partition->make_reader(reader_config)
-              .then([this, p, timeout](model::record_batch_reader reader) {
+              .then([this, p, timeout, ctx = std::move(ctx)](
+                      model::record_batch_reader reader) mutable {
                   return std::move(reader)
-                    .consume(recovery_batch_consumer(&p->as), timeout)
+                    .consume(std::move(ctx), timeout)
                     .then([this, p](recovery_batch_consumer ctx) {
                         // avoid trying to recover if we stopped the reader
                         // because an abort was requested
                         if (p->as.abort_requested()) {
                             return ss::make_ready_future<>();
                         }
-                        return recover_partition(p->partition, std::move(ctx))
-                          .then([p] { p->loading = false; });
+                        return save_recovery_snapshot(p->partition->ntp(), ctx)
+                          .then([this, p, ctx = std::move(ctx)]() mutable {
+                              return recover_partition(
+                                       p->partition, std::move(ctx))
+                                .then([p] { p->loading = false; });
+                          });
                     });
               });
         });
@@ -264,6 +291,161 @@ ss::future<> group_manager::recover_partition(
     return ss::make_ready_future<>();
 }
 
+/*
+ * key types within the kafka kvstore key space
+ */
+enum class group_kvstore_key_type : int8_t { recovery_snapshot = 0 };
+
+bytes group_manager::recovery_snapshot_key(const model::ntp& ntp) {
+    iobuf buf;
+    reflection::serialize(
+      buf, group_kvstore_key_type::recovery_snapshot, ntp);
+    return iobuf_to_bytes(buf);
+}
+
+std::optional<group_recovery_snapshot>
+group_manager::load_recovery_snapshot(const model::ntp& ntp) {
+    auto buf = _storage.local().kvs().get(
+      storage::kvstore::key_space::kafka, recovery_snapshot_key(ntp));
+    if (!buf) {
+        return std::nullopt;
+    }
+    auto snap = reflection::from_iobuf<group_recovery_snapshot>(
+      std::move(*buf));
+    if (snap.version != group_recovery_snapshot::current_version) {
+        vlog(
+          klog.info,
+          "Ignoring group recovery snapshot for {} with version {}",
+          ntp,
+          snap.version);
+        return std::nullopt;
+    }
+    return snap;
+}
+
+static group_log_group_metadata
+copy_group_metadata(const group_log_group_metadata& md) {
+    group_log_group_metadata copy;
+    copy.protocol_type = md.protocol_type;
+    copy.generation = md.generation;
+    copy.protocol = md.protocol;
+    copy.leader = md.leader;
+    copy.state_timestamp = md.state_timestamp;
+    copy.members.reserve(md.members.size());
+    for (const auto& m : md.members) {
+        copy.members.push_back(m.copy());
+    }
+    return copy;
+}
+
+ss::future<> group_manager::save_recovery_snapshot(
+  const model::ntp& ntp, const recovery_batch_consumer& ctx) {
+    group_recovery_snapshot snap;
+    snap.last_offset = ctx.last_read_offset;
+    snap.groups.reserve(ctx.loaded_groups.size());
+    for (const auto& e : ctx.loaded_groups) {
+        snap.groups.push_back({e.first, copy_group_metadata(e.second)});
+    }
+    snap.removed_groups.assign(
+      ctx.removed_groups.begin(), ctx.removed_groups.end());
+    snap.offsets.reserve(ctx.loaded_offsets.size());
+    for (const auto& e : ctx.loaded_offsets) {
+        snap.offsets.push_back({e.first, e.second.first, e.second.second});
+    }
+    vlog(
+      klog.debug,
+      "Saving group recovery snapshot for {} at offset {}: {} groups, {} "
+      "offsets",
+      ntp,
+      snap.last_offset,
+      snap.groups.size(),
+      snap.offsets.size());
+    return _storage.local().kvs().put(
+      storage::kvstore::key_space::kafka,
+      recovery_snapshot_key(ntp),
+      reflection::to_iobuf(std::move(snap)));
+}
+
+void group_manager::seed_from_snapshot(
+  recovery_batch_consumer& ctx, std::optional<group_recovery_snapshot> snap) {
+    if (!snap) {
+        return;
+    }
+    ctx.last_read_offset = snap->last_offset;
+    for (auto& g : snap->groups) {
+        ctx.loaded_groups[std::move(g.id)] = std::move(g.metadata);
+    }
+    for (auto& g : snap->removed_groups) {
+        ctx.removed_groups.emplace(std::move(g));
+    }
+    for (auto& o : snap->offsets) {
+        auto key = std::move(o.key);
+        ctx.loaded_offsets[std::move(key)] = std::make_pair(
+          o.log_offset, std::move(o.metadata));
+    }
+}
+
+void group_manager::refresh_recovery_snapshots() {
+    for (auto& e : _partitions) {
+        auto p = e.second;
+        (void)ss::with_gate(_gate, [this, p] {
+            // the semaphore serializes snapshot refresh with the
+            // recovery/unload transitions driven by leadership changes
+            return ss::with_semaphore(p->sem, 1, [this, p] {
+                return refresh_recovery_snapshot(p);
+            });
+        });
+    }
+}
+
+ss::future<> group_manager::refresh_recovery_snapshot(
+  ss::lw_shared_ptr<attached_partition> p) {
+    /*
+     * committed entries are identical on every replica, so the snapshot is
+     * refreshed regardless of leadership: a follower with a fresh snapshot
+     * is fast to take over as coordinator.
+     */
+    auto snap = load_recovery_snapshot(p->partition->ntp());
+    auto start = p->partition->start_offset();
+    if (snap) {
+        start = std::max(model::offset(snap->last_offset() + 1), start);
+    }
+    auto committed = p->partition->committed_offset();
+    if (start > committed) {
+        return ss::make_ready_future<>();
+    }
+
+    storage::log_reader_config reader_config(
+      start,
+      committed,
+      0,
+      std::numeric_limits<size_t>::max(),
+      kafka_read_priority(),
+      raft::data_batch_type,
+      std::nullopt,
+      std::nullopt);
+
+    auto ctx = recovery_batch_consumer(&p->as);
+    ctx.last_read_offset = model::offset(start() - 1);
+    seed_from_snapshot(ctx, std::move(snap));
+
+    return p->partition->make_reader(reader_config)
+      .then([this, p, ctx = std::move(ctx)](
+              model::record_batch_reader reader) mutable {
+          auto timeout
+            = ss::lowres_clock::now()
+              + config::shard_local_cfg().kafka_group_recovery_timeout_ms();
+          return std::move(reader)
+            .consume(std::move(ctx), timeout)
+            .then([this, p](recovery_batch_consumer ctx) {
+                if (p->as.abort_requested()) {
+                    return ss::make_ready_future<>();
+                }
+                return save_recovery_snapshot(p->partition->ntp(), ctx);
+            });
+      });
+}
+
 ss::future<ss::stop_iteration>
 recovery_batch_consumer::operator()(model::record_batch batch) {
     if (unlikely(batch.header().type != raft::data_batch_type)) {
@@ -276,6 +458,7 @@ recovery_batch_consumer::operator()(model::record_batch batch) {
           ss::stop_iteration::yes);
     }
     batch_base_offset = batch.base_offset();
+    auto batch_last_offset = batch.last_offset();
     return ss::do_with(
              std::move(batch),
              [this](model::record_batch& batch) {
@@ -283,7 +466,10 @@ recovery_batch_consumer::operator()(model::record_batch batch) {
                      return handle_record(std::move(r));
                  });
              })
-      .then([] { return ss::stop_iteration::no; });
+      .then([this, batch_last_offset] {
+          last_read_offset = batch_last_offset;
+          return ss::stop_iteration::no;
+      });
 }
 
 ss::future<> recovery_batch_consumer::handle_record(model::record r) {
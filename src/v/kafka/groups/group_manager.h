@@ -10,6 +10,7 @@
  */
 
 #pragma once
+#include "bytes/bytes.h"
 #include "cluster/cluster_utils.h"
 #include "cluster/namespace.h"
 #include "cluster/partition_manager.h"
@@ -27,6 +28,7 @@
 #include "kafka/requests/sync_group_request.h"
 #include "raft/group_manager.h"
 #include "seastarx.h"
+#include "storage/api.h"
 
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/future.hh>
@@ -39,6 +41,109 @@ namespace kafka {
 
 struct recovery_batch_consumer;
 
+/**
+ * the key type for group membership log records.
+ *
+ * the opaque key field is decoded based on the actual type.
+ *
+ * TODO: The `noop` type indicates a control structure used to synchronize raft
+ * state in a transition to leader state so that a consistent read is made. this
+ * is a temporary work-around until we fully address consistency semantics in
+ * raft.
+ */
+struct group_log_record_key {
+    enum class type : int8_t { group_metadata, offset_commit, noop };
+
+    type record_type;
+    iobuf key;
+};
+
+/**
+ * the value type of a group metadata log record.
+ */
+struct group_log_group_metadata {
+    kafka::protocol_type protocol_type;
+    kafka::generation_id generation;
+    std::optional<kafka::protocol_name> protocol;
+    std::optional<kafka::member_id> leader;
+    int32_t state_timestamp;
+    std::vector<member_state> members;
+};
+
+/**
+ * the key type for offset commit records.
+ */
+struct group_log_offset_key {
+    kafka::group_id group;
+    model::topic topic;
+    model::partition_id partition;
+
+    bool operator==(const group_log_offset_key& other) const {
+        return group == other.group && topic == other.topic
+               && partition == other.partition;
+    }
+
+    friend std::ostream& operator<<(std::ostream&, const group_log_offset_key&);
+};
+
+/**
+ * the value type for offset commit records.
+ */
+struct group_log_offset_metadata {
+    model::offset offset;
+    int32_t leader_epoch;
+    std::optional<ss::sstring> metadata;
+
+    friend std::ostream&
+    operator<<(std::ostream&, const group_log_offset_metadata&);
+};
+
+/*
+ * Deduplicated recovery state persisted to the local kvstore, keyed by the
+ * group metadata partition's ntp. See the recovery snapshot discussion on
+ * group_manager. The structs mirror the recovery_batch_consumer maps in a
+ * directly adl-serializable layout.
+ */
+struct group_recovery_snapshot_group {
+    kafka::group_id id;
+    group_log_group_metadata metadata;
+};
+
+struct group_recovery_snapshot_offset {
+    group_log_offset_key key;
+    model::offset log_offset;
+    group_log_offset_metadata metadata;
+};
+
+struct group_recovery_snapshot {
+    static constexpr int8_t current_version = 0;
+
+    int8_t version{current_version};
+    // all log records at offsets <= last_offset are folded into this
+    // snapshot; recovery replays the log starting at last_offset + 1
+    model::offset last_offset;
+    std::vector<group_recovery_snapshot_group> groups;
+    std::vector<kafka::group_id> removed_groups;
+    std::vector<group_recovery_snapshot_offset> offsets;
+};
+
+} // namespace kafka
+
+namespace std {
+template<>
+struct hash<kafka::group_log_offset_key> {
+    size_t operator()(const kafka::group_log_offset_key& key) const {
+        size_t h = 0;
+        boost::hash_combine(h, hash<ss::sstring>()(key.group));
+        boost::hash_combine(h, hash<ss::sstring>()(key.topic));
+        boost::hash_combine(h, hash<model::partition_id>()(key.partition));
+        return h;
+    }
+};
+} // namespace std
+
+namespace kafka {
+
 /*
  * \brief Manages the Kafka group lifecycle.
  *
@@ -107,15 +212,35 @@ struct recovery_batch_consumer;
  * cleared.
  *
  *     - This is not yet implemented.
+ *
+ * Recovery snapshots
+ * ==================
+ *
+ * The group metadata log is not compacted, so reading it from the beginning
+ * on every leadership change makes failover proportional to commit history.
+ * To bound that, the deduplicated recovery state is periodically folded into
+ * a snapshot stored in the local kvstore, keyed by the metadata partition's
+ * ntp. Recovery seeds the batch consumer from the snapshot and reads only
+ * the log suffix past the snapshot offset, making failover proportional to
+ * live group/offset count plus recent history.
+ *
+ * Snapshots are refreshed by a background timer that consumes the committed
+ * log suffix into the previous snapshot. Committed entries are identical on
+ * every replica, so followers refresh their snapshots too and are fast to
+ * take over leadership. Only committed offsets ever enter a snapshot (the
+ * partition reader is capped at the committed index), so a snapshot can
+ * never contain state from a truncated log suffix.
  */
 class group_manager {
 public:
     group_manager(
       ss::sharded<raft::group_manager>& gm,
       ss::sharded<cluster::partition_manager>& pm,
+      ss::sharded<storage::api>& storage,
       config::configuration& conf)
       : _gm(gm)
       , _pm(pm)
+      , _storage(storage)
       , _conf(conf)
       , _self(cluster::make_self_broker(config::shard_local_cfg())) {}
 
@@ -199,87 +324,31 @@ private:
       ss::lw_shared_ptr<cluster::partition> p,
       ss::lowres_clock::time_point timeout);
 
+    /*
+     * recovery snapshot helpers. load/save move state between the kvstore
+     * and the recovery batch consumer; refresh folds the committed log
+     * suffix of every attached partition into its snapshot.
+     */
+    static bytes recovery_snapshot_key(const model::ntp&);
+    std::optional<group_recovery_snapshot>
+    load_recovery_snapshot(const model::ntp&);
+    ss::future<>
+    save_recovery_snapshot(const model::ntp&, const recovery_batch_consumer&);
+    static void seed_from_snapshot(
+      recovery_batch_consumer&, std::optional<group_recovery_snapshot>);
+    ss::future<>
+      refresh_recovery_snapshot(ss::lw_shared_ptr<attached_partition>);
+    void refresh_recovery_snapshots();
+
     ss::sharded<raft::group_manager>& _gm;
     ss::sharded<cluster::partition_manager>& _pm;
+    ss::sharded<storage::api>& _storage;
     config::configuration& _conf;
     absl::flat_hash_map<group_id, group_ptr> _groups;
     model::broker _self;
+    ss::timer<> _snapshot_timer;
 };
 
-/**
- * the key type for group membership log records.
- *
- * the opaque key field is decoded based on the actual type.
- *
- * TODO: The `noop` type indicates a control structure used to synchronize raft
- * state in a transition to leader state so that a consistent read is made. this
- * is a temporary work-around until we fully address consistency semantics in
- * raft.
- */
-struct group_log_record_key {
-    enum class type : int8_t { group_metadata, offset_commit, noop };
-
-    type record_type;
-    iobuf key;
-};
-
-/**
- * the value type of a group metadata log record.
- */
-struct group_log_group_metadata {
-    kafka::protocol_type protocol_type;
-    kafka::generation_id generation;
-    std::optional<kafka::protocol_name> protocol;
-    std::optional<kafka::member_id> leader;
-    int32_t state_timestamp;
-    std::vector<member_state> members;
-};
-
-/**
- * the key type for offset commit records.
- */
-struct group_log_offset_key {
-    kafka::group_id group;
-    model::topic topic;
-    model::partition_id partition;
-
-    bool operator==(const group_log_offset_key& other) const {
-        return group == other.group && topic == other.topic
-               && partition == other.partition;
-    }
-
-    friend std::ostream& operator<<(std::ostream&, const group_log_offset_key&);
-};
-
-/**
- * the value type for offset commit records.
- */
-struct group_log_offset_metadata {
-    model::offset offset;
-    int32_t leader_epoch;
-    std::optional<ss::sstring> metadata;
-
-    friend std::ostream&
-    operator<<(std::ostream&, const group_log_offset_metadata&);
-};
-
-} // namespace kafka
-
-namespace std {
-template<>
-struct hash<kafka::group_log_offset_key> {
-    size_t operator()(const kafka::group_log_offset_key& key) const {
-        size_t h = 0;
-        boost::hash_combine(h, hash<ss::sstring>()(key.group));
-        boost::hash_combine(h, hash<ss::sstring>()(key.topic));
-        boost::hash_combine(h, hash<model::partition_id>()(key.partition));
-        return h;
-    }
-};
-} // namespace std
-
-namespace kafka {
-
 /*
  * This batch consumer is used during partition recovery to read, index, and
  * deduplicate both group and commit metadata snapshots.
@@ -298,6 +367,10 @@ struct recovery_batch_consumer {
 
     model::offset batch_base_offset;
 
+    // last offset folded into the consumer's state, either read from the
+    // log or carried over from a recovery snapshot
+    model::offset last_read_offset;
+
     absl::flat_hash_map<kafka::group_id, group_log_group_metadata>
       loaded_groups;
 
@@ -22,12 +22,15 @@
 #include "kafka/requests/offset_fetch_request.h"
 #include "kafka/requests/sync_group_request.h"
 #include "kafka/types.h"
+#include "likely.h"
 #include "seastarx.h"
 
 #include <seastar/core/reactor.hh>
 #include <seastar/core/scheduling.hh>
 #include <seastar/core/sharded.hh>
 
+#include <absl/container/flat_hash_map.h>
+
 #include <type_traits>
 
 namespace kafka {
@@ -138,21 +141,45 @@ public:
     }
 
 private:
+    /*
+     * resolving a group to its ntp copies the internal topic's metadata and
+     * hashes the group name on every request, which is real work at offset
+     * commit rates. the resolution is cached per shard; the shard table
+     * lookup stays live on every use so the hint can never route to a shard
+     * that no longer owns the partition - a dead hint is simply dropped and
+     * re-resolved.
+     */
     std::optional<std::pair<model::ntp, ss::shard_id>>
     shard_for(const group_id& group) {
+        if (auto it = _route_hints.find(group); it != _route_hints.end()) {
+            if (auto shard_id = _shards.local().shard_for(it->second);
+                shard_id) {
+                return std::make_pair(it->second, *shard_id);
+            }
+            // partition moved off this node or topic was recreated
+            _route_hints.erase(it);
+        }
         if (auto ntp = _coordinators.local().ntp_for(group); ntp) {
             if (auto shard_id = _shards.local().shard_for(*ntp); shard_id) {
+                if (unlikely(_route_hints.size() >= max_route_hints)) {
+                    _route_hints.clear();
+                }
+                _route_hints.emplace(group, *ntp);
                 return std::make_pair(std::move(*ntp), *shard_id);
             }
         }
         return std::nullopt;
     }
 
+    // bounds hint memory on shards serving pathological numbers of groups
+    static constexpr size_t max_route_hints = 10000;
+
     ss::scheduling_group _sg;
     ss::smp_service_group _ssg;
     ss::sharded<group_manager>& _group_manager;
     ss::sharded<cluster::shard_table>& _shards;
     ss::sharded<coordinator_ntp_mapper>& _coordinators;
+    absl::flat_hash_map<group_id, model::ntp> _route_hints;
 };
 
 } // namespace kafka
@@ -145,6 +145,14 @@ public:
         return _state.protocols;
     }
 
+    /// Check if the member supports a given protocol.
+    bool supports_protocol(const kafka::protocol_name& protocol) const {
+        return std::any_of(
+          _state.protocols.cbegin(),
+          _state.protocols.cend(),
+          [&protocol](const member_protocol& p) { return p.name == protocol; });
+    }
+
     /// Update the set of protocols supported by the member.
     void set_protocols(std::vector<member_protocol> protocols) {
         _state.protocols = std::move(protocols);
@@ -0,0 +1,113 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "kafka/produce_coalescer.h"
+
+#include "cluster/partition.h"
+#include "model/timeout_clock.h"
+
+#include <exception>
+#include <utility>
+
+namespace kafka {
+
+produce_coalescer::produce_coalescer() {
+    _flush_timer.set_callback([this] { flush(); });
+}
+
+ss::future<result<raft::replicate_result>> produce_coalescer::append(
+  ss::lw_shared_ptr<cluster::partition> partition,
+  model::record_batch_reader reader,
+  raft::replicate_options opts,
+  std::chrono::microseconds window) {
+    return model::consume_reader_to_memory(std::move(reader), model::no_timeout)
+      .then([this, partition = std::move(partition), opts, window](
+              model::record_batch_reader::data_t batches) mutable {
+          /*
+           * a round is one replicate call and the ack level decides when
+           * that call resolves, so rounds never mix consistency levels.
+           * a mismatching batch closes the staged round and opens a new
+           * one rather than waiting behind it.
+           */
+          if (!_waiters.empty() && _opts.consistency != opts.consistency) {
+              flush();
+          }
+          if (_waiters.empty()) {
+              _partition = std::move(partition);
+              _opts = opts;
+              _flush_timer.arm(window);
+          }
+          waiter w;
+          for (auto& b : batches) {
+              w.num_records += b.record_count();
+              _bytes += b.size_bytes();
+              _data.push_back(std::move(b));
+          }
+          auto f = w.done.get_future();
+          _waiters.push_back(std::move(w));
+          if (_bytes >= max_staged_bytes) {
+              flush();
+          }
+          return f;
+      });
+}
+
+void produce_coalescer::flush() {
+    _flush_timer.cancel();
+    if (_waiters.empty()) {
+        return;
+    }
+    auto partition = std::exchange(_partition, nullptr);
+    auto opts = _opts;
+    auto data = std::exchange(_data, {});
+    auto waiters = std::exchange(_waiters, {});
+    _bytes = 0;
+    /*
+     * the staged batches were decoded on the handling cores and are
+     * consumed here on the partition's home shard, exactly as they would
+     * be without staging; the foreign reader re-asserts their ownership
+     * for the replication path. the round itself runs inside the raft
+     * group's gate and the promises are resolved on every outcome, so
+     * detaching here cannot strand a waiter.
+     */
+    auto reader = model::make_foreign_memory_record_batch_reader(
+      std::move(data));
+    (void)partition->replicate(std::move(reader), opts)
+      .then_wrapped([partition, waiters = std::move(waiters)](
+                      ss::future<result<raft::replicate_result>> f) mutable {
+          try {
+              auto r = f.get0();
+              if (!r) {
+                  for (auto& w : waiters) {
+                      w.done.set_value(r.error());
+                  }
+                  return;
+              }
+              // carve each producer's slice out of the merged round back
+              // to front, mirroring the raft batcher's result propagation
+              auto last_offset = r.value().last_offset;
+              for (auto it = waiters.rbegin(); it != waiters.rend(); ++it) {
+                  it->done.set_value(raft::replicate_result{last_offset});
+                  last_offset = last_offset - model::offset(it->num_records);
+              }
+          } catch (...) {
+              auto e = std::current_exception();
+              for (auto& w : waiters) {
+                  w.done.set_exception(e);
+              }
+          }
+      });
+}
+
+produce_coalescer_registry& produce_coalescers() {
+    static thread_local produce_coalescer_registry registry;
+    return registry;
+}
+
+} // namespace kafka
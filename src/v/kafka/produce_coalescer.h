@@ -0,0 +1,113 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/fundamental.h"
+#include "model/record_batch_reader.h"
+#include "outcome.h"
+#include "raft/types.h"
+#include "seastarx.h"
+#include "units.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/shared_ptr.hh>
+#include <seastar/core/timer.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace cluster {
+class partition;
+} // namespace cluster
+
+namespace kafka {
+
+/**
+ * Per partition staging buffer that merges produce batches from
+ * concurrent requests into one replication round.
+ *
+ * The raft replicate batcher already fuses concurrent quorum_ack rounds,
+ * but with relaxed consistency every replicate call dispatches its own
+ * disk append, so a partition written by many connections within the
+ * same instant pays one storage round per connection. Staging on the
+ * partition's home shard closes that gap for every ack level: batches
+ * arriving within kafka_produce_coalesce_window_us enter the log as one
+ * round and each producer's offsets are carved out of the merged result.
+ *
+ * A round never mixes consistency levels; a batch produced with a
+ * different ack level than the staged round flushes the round and starts
+ * a new one. A round is also flushed as soon as it stages
+ * max_staged_bytes, bounding both the added latency and the memory held
+ * by staging.
+ */
+class produce_coalescer {
+public:
+    /// byte bound of one staged round; reaching it flushes immediately
+    static constexpr size_t max_staged_bytes = 1_MiB;
+
+    produce_coalescer();
+
+    /// stage a batch for replication. resolves with the caller's slice
+    /// of the merged round, shaped exactly like an unstaged replicate
+    /// result
+    ss::future<result<raft::replicate_result>> append(
+      ss::lw_shared_ptr<cluster::partition> partition,
+      model::record_batch_reader reader,
+      raft::replicate_options opts,
+      std::chrono::microseconds window);
+
+private:
+    struct waiter {
+        int32_t num_records{0};
+        ss::promise<result<raft::replicate_result>> done;
+    };
+
+    void flush();
+
+    ss::lw_shared_ptr<cluster::partition> _partition;
+    raft::replicate_options _opts{raft::consistency_level::quorum_ack};
+    model::record_batch_reader::data_t _data;
+    std::vector<waiter> _waiters;
+    size_t _bytes{0};
+    ss::timer<> _flush_timer;
+};
+
+/**
+ * Shard local registry of the per partition coalescers, keyed by ntp.
+ * Looked up on the partition's home shard in the produce path, mirroring
+ * batch_dedups() and producer_states().
+ */
+class produce_coalescer_registry {
+public:
+    produce_coalescer& get(const model::ntp& ntp) {
+        auto& c = _coalescers[ntp];
+        if (!c) {
+            c = std::make_unique<produce_coalescer>();
+        }
+        return *c;
+    }
+    void remove(const model::ntp& ntp) { _coalescers.erase(ntp); }
+
+private:
+    // unique_ptr values keep the armed flush timers address stable
+    // across rehash
+    absl::flat_hash_map<model::ntp, std::unique_ptr<produce_coalescer>>
+      _coalescers;
+};
+
+/// shard local instance
+produce_coalescer_registry& produce_coalescers();
+
+} // namespace kafka
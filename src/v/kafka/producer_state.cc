@@ -0,0 +1,113 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "kafka/producer_state.h"
+
+namespace kafka {
+
+/// sequences wrap at int32 max per the kafka protocol
+static int32_t next_sequence(int32_t sequence) {
+    if (sequence == std::numeric_limits<int32_t>::max()) {
+        return 0;
+    }
+    return sequence + 1;
+}
+
+producer_state_table::check_result producer_state_table::check_and_advance(
+  int64_t producer_id,
+  int16_t epoch,
+  int32_t first_sequence,
+  int32_t last_sequence) {
+    check_result res{
+      .epoch = epoch,
+      .last_sequence = last_sequence,
+    };
+    auto it = _producers.find(producer_id);
+    if (it == _producers.end()) {
+        // first contact with this producer. any starting sequence is
+        // admitted: older state may have been forgotten across leadership
+        // changes or restarts and rejecting would strand the producer
+        if (_producers.size() >= max_producers) {
+            evict_idlest();
+        }
+        _producers.emplace(
+          producer_id,
+          state{
+            .epoch = epoch,
+            .last_sequence = last_sequence,
+            .last_update = ss::lowres_clock::now(),
+          });
+        return res;
+    }
+    auto& st = it->second;
+    res.was_known = true;
+    res.prev_epoch = st.epoch;
+    res.prev_sequence = st.last_sequence;
+    if (epoch < st.epoch) {
+        res.outcome = sequence_check::stale_epoch;
+        return res;
+    }
+    if (epoch > st.epoch) {
+        // a bumped epoch restarts sequencing from zero
+        if (first_sequence != 0) {
+            res.outcome = sequence_check::out_of_order;
+            return res;
+        }
+    } else if (first_sequence != next_sequence(st.last_sequence)) {
+        if (first_sequence <= st.last_sequence) {
+            // the window was already acknowledged; the client retried
+            res.outcome = sequence_check::duplicate;
+        } else {
+            res.outcome = sequence_check::out_of_order;
+        }
+        return res;
+    }
+    st.epoch = epoch;
+    st.last_sequence = last_sequence;
+    st.last_update = ss::lowres_clock::now();
+    return res;
+}
+
+void producer_state_table::rollback(
+  int64_t producer_id, const check_result& r) {
+    auto it = _producers.find(producer_id);
+    if (it == _producers.end()) {
+        return;
+    }
+    auto& st = it->second;
+    // only undo our own advance: a later admitted batch owns the window
+    if (st.epoch != r.epoch || st.last_sequence != r.last_sequence) {
+        return;
+    }
+    if (!r.was_known) {
+        _producers.erase(it);
+        return;
+    }
+    st.epoch = r.prev_epoch;
+    st.last_sequence = r.prev_sequence;
+}
+
+void producer_state_table::evict_idlest() {
+    auto victim = _producers.begin();
+    for (auto it = _producers.begin(); it != _producers.end(); ++it) {
+        if (it->second.last_update < victim->second.last_update) {
+            victim = it;
+        }
+    }
+    if (victim != _producers.end()) {
+        _producers.erase(victim);
+    }
+}
+
+producer_state_cache& producer_states() {
+    static thread_local producer_state_cache cache;
+    return cache;
+}
+
+} // namespace kafka
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/fundamental.h"
+#include "seastarx.h"
+
+#include <seastar/core/lowres_clock.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <cstdint>
+#include <limits>
+
+namespace kafka {
+
+/**
+ * Per partition dedup state for idempotent producers.
+ *
+ * One flat open-addressing map keyed by producer id holds the last
+ * acknowledged sequence window per producer, so the produce hot path pays
+ * a single O(1) hash probe per batch and allocates only when a producer
+ * is seen for the first time (or on the map's rare rehash).
+ *
+ * The window is advanced optimistically when a batch is admitted, which
+ * keeps pipelined batches from the same producer in order without
+ * tracking in-flight sets; a failed replication rolls the window back so
+ * the client's retry of the same sequence range is admitted again.
+ */
+class producer_state_table {
+public:
+    /// bound on tracked producers per partition; admitting one beyond the
+    /// bound evicts the producer idle the longest
+    static constexpr size_t max_producers = 1024;
+
+    enum class sequence_check {
+        accept,
+        duplicate,
+        out_of_order,
+        stale_epoch,
+    };
+
+    /// everything needed to undo an optimistic advance if the admitted
+    /// batch fails replication
+    struct check_result {
+        sequence_check outcome{sequence_check::accept};
+        bool was_known{false};
+        int16_t prev_epoch{-1};
+        int32_t prev_sequence{-1};
+        int16_t epoch{-1};
+        int32_t last_sequence{-1};
+    };
+
+    /**
+     * Validates the sequence window [first_sequence, last_sequence] of a
+     * produced batch and, when admitted, advances the producer's window
+     * to last_sequence.
+     */
+    check_result check_and_advance(
+      int64_t producer_id,
+      int16_t epoch,
+      int32_t first_sequence,
+      int32_t last_sequence);
+
+    /// undoes the optimistic advance of an admitted batch whose
+    /// replication failed; a no-op if a later batch advanced the window
+    /// past it in the meantime
+    void rollback(int64_t producer_id, const check_result&);
+
+    size_t size() const { return _producers.size(); }
+
+private:
+    struct state {
+        int16_t epoch;
+        int32_t last_sequence;
+        ss::lowres_clock::time_point last_update;
+    };
+
+    void evict_idlest();
+
+    absl::flat_hash_map<int64_t, state> _producers;
+};
+
+/**
+ * Shard local registry of the per partition tables, keyed by ntp. Looked
+ * up on the partition's home shard in the produce path. A table for a
+ * partition that left the shard is inert (produce fails the leadership
+ * check first) and holds at most max_producers windows; remove() lets
+ * housekeeping reclaim it.
+ */
+class producer_state_cache {
+public:
+    producer_state_table& get(const model::ntp& ntp) {
+        return _tables[ntp];
+    }
+    void remove(const model::ntp& ntp) { _tables.erase(ntp); }
+
+private:
+    absl::flat_hash_map<model::ntp, producer_state_table> _tables;
+};
+
+/// shard local instance
+producer_state_cache& producer_states();
+
+} // namespace kafka
@@ -48,7 +48,8 @@ protocol::protocol(
   , _shard_table(tbl)
   , _partition_manager(pm)
   , _coordinator_mapper(coordinator_mapper)
-  , _fetch_session_cache(session_cache) {}
+  , _fetch_session_cache(session_cache)
+  , _tracer(std::make_unique<request_tracer>()) {}
 
 ss::future<> protocol::apply(rpc::server::resources rs) {
     auto ctx = ss::make_lw_shared<connection_context>(*this, std::move(rs));
@@ -19,6 +19,7 @@
 #include "kafka/groups/coordinator_ntp_mapper.h"
 #include "kafka/groups/group_router.h"
 #include "kafka/quota_manager.h"
+#include "kafka/request_tracer.h"
 #include "rpc/server.h"
 
 #include <seastar/core/future.hh>
@@ -70,6 +71,7 @@ public:
         return _fetch_session_cache.local();
     }
     quota_manager& quota_mgr() { return _quota_mgr.local(); }
+    request_tracer& tracer() { return *_tracer; }
 
 private:
     ss::smp_service_group _smp_group;
@@ -81,6 +83,9 @@ private:
     ss::sharded<cluster::partition_manager>& _partition_manager;
     ss::sharded<kafka::coordinator_ntp_mapper>& _coordinator_mapper;
     ss::sharded<kafka::fetch_session_cache>& _fetch_session_cache;
+    // unique_ptr: the tracer's metric callbacks capture its address, which
+    // must stay stable when the protocol instance is moved
+    std::unique_ptr<request_tracer> _tracer;
 };
 
 } // namespace kafka
@@ -31,4 +31,12 @@ ss::future<std::optional<size_t>> parse_size(ss::input_stream<char>&);
 
 ss::scattered_message<char> response_as_scattered(response_ptr response);
 
+/// \brief append the wire format of a response (header + body) to an
+/// existing scattered message.
+///
+/// allows several pipelined responses to be coalesced into a single socket
+/// write instead of paying one write/flush per response.
+void response_into_scattered(
+  ss::scattered_message<char>& msg, response_ptr response);
+
 } // namespace kafka
@@ -11,8 +11,14 @@
 
 #include "config/configuration.h"
 #include "kafka/logger.h"
+#include "likely.h"
+#include "prometheus/prometheus_sanitize.h"
+#include "storage/chunk_cache.h"
 #include "vlog.h"
 
+#include <seastar/core/metrics.hh>
+#include <seastar/core/reactor.hh>
+
 namespace kafka {
 using clock = quota_manager::clock;
 using throttle_delay = quota_manager::throttle_delay;
@@ -29,6 +35,45 @@ ss::future<> quota_manager::start() {
     return ss::make_ready_future<>();
 }
 
+void quota_manager::maybe_sample_load(clock::time_point now) {
+    if (now - _last_load_sample < load_sample_period) {
+        return;
+    }
+    const auto busy = ss::engine().total_busy_time();
+    const auto wall = now - _last_load_sample;
+    double cpu = 0;
+    if (_last_load_sample.time_since_epoch().count() != 0 && wall.count() > 0) {
+        cpu = std::min(
+          std::chrono::duration<double>(busy - _last_busy_time)
+            / std::chrono::duration<double>(wall),
+          1.0);
+    }
+    // appenders hold chunks while their writes are in flight, so the
+    // chunk cache running dry means the append pipeline is backed up;
+    // anyone actually waiting for a chunk is full saturation
+    auto& chunks = storage::internal::chunks();
+    double append = chunks.utilization();
+    if (chunks.waiters() != 0) {
+        append = 1.0;
+    }
+    // whichever resource saturates first is the one clients will queue
+    // on; smooth it so a single busy poll does not throttle anyone
+    const double score = std::max(cpu, append);
+    _load_score = (3 * _load_score + score) / 4;
+    _last_busy_time = busy;
+    _last_load_sample = now;
+}
+
+clock::duration quota_manager::load_hint() const {
+    const double threshold = _load_threshold_pct / 100.0;
+    if (threshold >= 1.0 || _load_score <= threshold) {
+        return clock::duration(0);
+    }
+    const double f = std::min(
+      (_load_score - threshold) / (1.0 - threshold), 1.0);
+    return std::chrono::duration_cast<clock::duration>(_max_delay * f);
+}
+
 // record a new observation and return <previous delay, new delay>
 throttle_delay quota_manager::record_tp_and_throttle(
   std::optional<std::string_view> client_id,
@@ -38,57 +83,147 @@ throttle_delay quota_manager::record_tp_and_throttle(
     // shares a default quota. the anonymous group is keyed on empty string.
     auto cid = client_id ? *client_id : "";
 
-    // find or create the throughput tracker for this client
-    //
-    // c++20: heterogeneous lookup for unordered_map can avoid creation of
-    // an sstring here but std::unordered_map::find isn't using an
-    // equal_to<> overload. this is a general issue we'll be looking at. for
-    // now, these client-name strings are small. This will be solved in
-    // c++20 via Hash::transparent_key_equal.
-    auto [it, inserted] = _quotas.try_emplace(
-      ss::sstring(cid),
-      quota{
-        now,
-        clock::duration(0),
-        {_default_num_windows, _default_window_width}});
+    // find or create the token bucket for this client. lookup is
+    // transparent so steady state requests do not allocate a key.
+    auto it = _quotas.find(cid);
+    if (unlikely(it == _quotas.end())) {
+        auto [new_it, _] = _quotas.emplace(
+          ss::sstring(cid),
+          quota{
+            now,
+            clock::duration(0),
+            token_bucket(_target_tp_rate, max_burst_bytes())});
+        it = new_it;
+    }
+    auto& q = it->second;
 
     // bump to prevent gc
-    if (!inserted) {
-        it->second.last_seen = now;
-    }
+    q.last_seen = now;
 
-    auto rate = it->second.tp_rate.record_and_measure(bytes, now);
-
-    uint64_t delay_ms = 0;
-    if (rate > _target_tp_rate) {
-        auto diff = rate - _target_tp_rate;
-        double delay
-          = (diff / _target_tp_rate)
-            * (double)std::chrono::duration_cast<std::chrono::milliseconds>(
-                it->second.tp_rate.window_size())
-                .count();
-        delay_ms = static_cast<uint64_t>(delay);
+    // charge the client bucket; the node-wide aggregate (when configured)
+    // is the parent level in the hierarchy, so the reported delay is the
+    // largest deficit of the two
+    auto delay = q.tp_bucket.record(double(bytes), now);
+    if (_node_bucket) {
+        delay = std::max(delay, _node_bucket->record(double(bytes), now));
     }
+    // this is the value reported to clients as throttle_time_ms
+    auto delay_ms = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(delay).count());
     if (delay_ms > (uint64_t)_max_delay.count()) {
         vlog(
           klog.info,
-          "Found data rate for window of: {} bytes. Client:{}, Estimated "
-          "backpressure delay of {}ms. Limiting to {}ms backpressure delay",
-          rate,
+          "Client:{} exceeded quota by {} bytes. Estimated backpressure "
+          "delay of {}ms. Limiting to {}ms backpressure delay",
           cid,
+          q.tp_bucket.deficit(),
           delay_ms,
           _max_delay.count());
         delay_ms = _max_delay.count();
     }
 
-    auto prev = it->second.delay;
-    it->second.delay = std::chrono::milliseconds(delay_ms);
+    auto prev = q.delay;
+    q.delay = std::chrono::milliseconds(delay_ms);
 
     throttle_delay res{};
     res.first_violation = prev.count() == 0;
-    res.duration = it->second.delay;
+    res.duration = q.delay;
+
+    // shard overload hint: unlike a quota violation there is no first
+    // violation grace period - the overload exists now, and the hint is
+    // what lets clients back off before they start timing out
+    maybe_sample_load(now);
+    if (auto hint = load_hint(); hint > res.duration) {
+        res.first_violation = false;
+        res.duration = hint;
+    }
     return res;
 }
+ss::future<quota_manager::memory_units> quota_manager::reserve_memory(
+  std::optional<std::string_view> client_id, size_t bytes) {
+    auto now = clock::now();
+    // see record_tp_and_throttle: anonymous clients share one entry
+    auto cid = client_id ? *client_id : "";
+    auto it = _quotas.find(cid);
+    if (unlikely(it == _quotas.end())) {
+        auto [new_it, _] = _quotas.emplace(
+          ss::sstring(cid),
+          quota{
+            now,
+            clock::duration(0),
+            token_bucket(_target_tp_rate, max_burst_bytes())});
+        it = new_it;
+    }
+    auto& q = it->second;
+    q.last_seen = now;
+    if (!q.memory) {
+        q.memory = ss::make_lw_shared<ss::semaphore>(_memory_budget);
+        setup_client_metrics(q, cid);
+    }
+
+    // the budget covers well behaved clients entirely; a request larger
+    // than the budget holds the whole budget and borrows the remainder
+    // from the shared pool, clamped so a single reservation can always
+    // be satisfied. the budget is always taken first so every waiter
+    // acquires the two semaphores in the same order.
+    const auto from_budget = std::min(bytes, _memory_budget);
+    const auto from_shared = std::min(
+      bytes - from_budget, _shared_memory_size);
+    auto mem = q.memory;
+    return ss::get_units(*mem, from_budget)
+      .then([this, mem, from_shared](ss::semaphore_units<> budget_units) {
+          return ss::get_units(_shared_memory, from_shared)
+            .then([mem, budget_units = std::move(budget_units)](
+                    ss::semaphore_units<> shared_units) mutable {
+                return memory_units{
+                  mem, std::move(budget_units), std::move(shared_units)};
+            });
+      });
+}
+
+void quota_manager::setup_metrics() {
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+    namespace sm = ss::metrics;
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("kafka:quota"),
+      {sm::make_gauge(
+         "shared_memory_available_bytes",
+         [this] { return _shared_memory.available_units(); },
+         sm::description("Bytes left in the pool clients borrow request "
+                         "memory from beyond their own budget")),
+       sm::make_gauge(
+         "load_score",
+         [this] { return _load_score; },
+         sm::description(
+           "Smoothed shard load score (0-1) combining reactor utilization "
+           "and append pipeline depth; throttle hints start above "
+           "kafka_throttle_load_threshold_percent"))});
+}
+
+void quota_manager::setup_client_metrics(quota& q, std::string_view cid) {
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+    namespace sm = ss::metrics;
+    const std::vector<sm::label_instance> labels = {
+      sm::label("client_id")(ss::sstring(cid))};
+    // the gauge callback holds the semaphore alive on its own; the group
+    // itself lives in the client's tracking entry so gc unregisters it
+    q.metrics.add_group(
+      prometheus_sanitize::metrics_name("kafka:quota:client"),
+      {sm::make_gauge(
+        "memory_held_bytes",
+        [budget = _memory_budget, mem = q.memory] {
+            return budget
+                   - std::max<ssize_t>(mem->available_units(), 0);
+        },
+        sm::description("Bytes of the client's request memory budget held "
+                        "by its in-flight requests"),
+        labels)});
+}
+
 // erase inactive tracked quotas. windows are considered inactive if they
 // have not received any updates in ten window's worth of time.
 void quota_manager::gc(clock::duration full_window) {
@@ -96,8 +231,23 @@ void quota_manager::gc(clock::duration full_window) {
     auto expire_age = full_window * 10;
     // c++20: replace with std::erase_if
     absl::erase_if(
-      _quotas, [now, expire_age](const std::pair<ss::sstring, quota>& q) {
-          return (now - q.second.last_seen) > expire_age;
+      _quotas,
+      [this, now, expire_age](const std::pair<ss::sstring, quota>& q) {
+          if ((now - q.second.last_seen) <= expire_age) {
+              return false;
+          }
+          // an entry whose memory budget is partly held must survive:
+          // recreating it later would hand the client a second budget
+          // while the first is still reserved
+          const auto& mem = q.second.memory;
+          if (
+            mem
+            && (mem->waiters() != 0
+                || mem->available_units()
+                     != static_cast<ssize_t>(_memory_budget))) {
+              return false;
+          }
+          return true;
       });
 }
 
@@ -11,15 +11,19 @@
 
 #pragma once
 #include "config/configuration.h"
-#include "resource_mgmt/rate.h"
+#include "resource_mgmt/token_bucket.h"
 #include "seastarx.h"
 
 #include <seastar/core/future.hh>
 #include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/shared_ptr.hh>
 #include <seastar/core/sstring.hh>
 #include <seastar/core/timer.hh>
 
 #include <absl/container/flat_hash_map.h>
+#include <absl/hash/hash.h>
 
 #include <chrono>
 #include <optional>
@@ -29,6 +33,21 @@ namespace kafka {
 
 // quota_manager tracks quota usage
 //
+// each shard has its own instance tracking the clients it serves, so the
+// hot path is a single map lookup plus token bucket arithmetic - no locks
+// and no cross-shard communication. tokens are bytes that accrue at the
+// target rate up to one burst window's worth; the throttle delay is the
+// time the bucket needs to replenish the deficit, which matches the
+// semantics of kafka's throttle_time_ms.
+//
+// besides per-client quotas the manager samples a shard load score -
+// reactor busy fraction combined with depletion of the segment append
+// write-behind chunk cache - and folds a delay proportional to the
+// score above kafka_throttle_load_threshold_percent into the returned
+// throttle. clients see rising throttle_time hints in produce/fetch
+// responses before the shard saturates instead of discovering the
+// overload through timeouts.
+//
 // TODO:
 //   - we will want to eventually add support for configuring the quotas and
 //   quota settings as runtime through the kafka api and other mechanisms.
@@ -53,14 +72,40 @@ public:
         clock::duration duration;
     };
 
+    // memory reserved against a client's own budget, plus any bytes
+    // borrowed from the shared pool for the part of the request that
+    // exceeded it. the shared pointer keeps the client's semaphore alive
+    // if gc drops the tracking entry while a request is still in flight.
+    struct memory_units {
+        ss::lw_shared_ptr<ss::semaphore> budget;
+        ss::semaphore_units<> budget_units;
+        ss::semaphore_units<> shared_units;
+    };
+
     quota_manager()
       : _default_num_windows(config::shard_local_cfg().default_num_windows())
       , _default_window_width(config::shard_local_cfg().default_window_sec())
       , _target_tp_rate(config::shard_local_cfg().target_quota_byte_rate())
+      , _target_node_tp_rate(
+          config::shard_local_cfg().target_node_quota_byte_rate())
       , _gc_freq(config::shard_local_cfg().quota_manager_gc_sec())
-      , _max_delay(config::shard_local_cfg().max_kafka_throttle_delay_ms()) {
+      , _max_delay(config::shard_local_cfg().max_kafka_throttle_delay_ms())
+      , _memory_budget(
+          config::shard_local_cfg().kafka_client_memory_budget_bytes())
+      , _shared_memory_size(
+          config::shard_local_cfg().kafka_client_memory_shared_bytes())
+      , _shared_memory(_shared_memory_size)
+      , _load_threshold_pct(
+          config::shard_local_cfg().kafka_throttle_load_threshold_percent()) {
         auto full_window = _default_num_windows * _default_window_width;
+        if (_target_node_tp_rate > 0) {
+            _node_bucket.emplace(
+              double(_target_node_tp_rate),
+              double(_target_node_tp_rate)
+                * std::chrono::duration<double>(full_window).count());
+        }
         _gc_timer.set_callback([this, full_window] { gc(full_window); });
+        setup_metrics();
     }
 
     quota_manager(const quota_manager&) = delete;
@@ -80,30 +125,119 @@ public:
       uint64_t bytes,
       clock::time_point now = clock::now());
 
+    // reserve request memory against the client's per-shard budget; the
+    // part of a request exceeding the budget borrows from the shared
+    // pool. resolves once the reservation is satisfied, so a client that
+    // outruns its budget queues behind its own in-flight requests
+    // instead of draining memory shared with well behaved clients.
+    ss::future<memory_units>
+    reserve_memory(std::optional<std::string_view> client_id, size_t bytes);
+
+    // smoothed shard saturation in [0, 1]; see maybe_sample_load
+    double load_score() const { return _load_score; }
+
 private:
     // erase inactive tracked quotas. windows are considered inactive if they
     // have not received any updates in ten window's worth of time.
     void gc(clock::duration full_window);
 
+    // refresh the shard load score at most once per sample period
+    void maybe_sample_load(clock::time_point now);
+
+    // delay hinted to clients for the load score above the threshold,
+    // scaled linearly up to _max_delay at full saturation
+    clock::duration load_hint() const;
+
 private:
     // last_seen: used for gc keepalive
     // delay: last calculated delay
-    // tp_rate: throughput tracking
+    // tp_bucket: per-client token bucket, tokens are bytes
+    // memory: per-client request memory budget, created on first use
     struct quota {
         clock::time_point last_seen;
         clock::duration delay;
-        rate_tracker tp_rate;
+        token_bucket tp_bucket;
+        ss::lw_shared_ptr<ss::semaphore> memory;
+        ss::metrics::metric_groups metrics;
+    };
+
+    void setup_metrics();
+    void setup_client_metrics(quota&, std::string_view client_id);
+
+    /*
+     * transparent hashing/equality so the hot path looks clients up by
+     * string_view and only allocates a key on first sight of a client
+     */
+    struct client_id_hash {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view v) const {
+            return absl::Hash<std::string_view>{}(v);
+        }
+
+        size_t operator()(const ss::sstring& v) const {
+            return absl::Hash<std::string_view>{}(
+              std::string_view(v.data(), v.size()));
+        }
+    };
+
+    struct client_id_eq {
+        using is_transparent = void;
+
+        bool operator()(std::string_view lhs, std::string_view rhs) const {
+            return lhs == rhs;
+        }
+
+        bool operator()(const ss::sstring& lhs, std::string_view rhs) const {
+            return std::string_view(lhs.data(), lhs.size()) == rhs;
+        }
+
+        bool operator()(std::string_view lhs, const ss::sstring& rhs) const {
+            return operator()(rhs, lhs);
+        }
+
+        bool operator()(const ss::sstring& lhs, const ss::sstring& rhs) const {
+            return lhs == rhs;
+        }
     };
 
+    // bucket capacity: one full burst window's worth of bytes
+    double max_burst_bytes() const {
+        return double(_target_tp_rate)
+               * std::chrono::duration<double>(
+                   _default_num_windows * _default_window_width)
+                   .count();
+    }
+
     const std::size_t _default_num_windows;
     const clock::duration _default_window_width;
 
     const uint32_t _target_tp_rate;
-    absl::flat_hash_map<ss::sstring, quota> _quotas;
+    const uint32_t _target_node_tp_rate;
+    // node-wide aggregate limit, the parent level above per-client
+    // buckets; each shard charges its own demand-reconciled sub-bucket
+    struct node_quota_tag {};
+    std::optional<sharded_token_bucket<node_quota_tag>> _node_bucket;
+    absl::flat_hash_map<ss::sstring, quota, client_id_hash, client_id_eq>
+      _quotas;
 
     ss::timer<> _gc_timer;
     const clock::duration _gc_freq;
     const clock::duration _max_delay;
+
+    const size_t _memory_budget;
+    const size_t _shared_memory_size;
+    ss::semaphore _shared_memory;
+
+    // shard load sampling for pre-saturation throttle hints
+    static constexpr clock::duration load_sample_period
+      = std::chrono::milliseconds(100);
+    const uint32_t _load_threshold_pct;
+    clock::time_point _last_load_sample;
+    std::chrono::nanoseconds _last_busy_time{0};
+    double _load_score{0};
+
+    ss::metrics::metric_groups _metrics;
 };
 
 } // namespace kafka
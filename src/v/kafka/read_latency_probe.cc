@@ -0,0 +1,47 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "kafka/read_latency_probe.h"
+
+namespace kafka {
+
+read_latency_probe& read_latency_probe::local() {
+    static thread_local read_latency_probe probe;
+    return probe;
+}
+
+void read_latency_probe::record(
+  const model::topic& tp, std::chrono::microseconds d) {
+    auto it = _topics.find(tp);
+    if (it == _topics.end()) {
+        if (_topics.size() >= max_topics) {
+            return;
+        }
+        it = _topics
+               .emplace(tp, reservoir_sample<int64_t>(reservoir_capacity))
+               .first;
+    }
+    it->second.add(d.count());
+}
+
+std::vector<read_latency_probe::topic_samples>
+read_latency_probe::snapshot() const {
+    std::vector<topic_samples> ret;
+    ret.reserve(_topics.size());
+    for (const auto& [tp, reservoir] : _topics) {
+        ret.push_back(topic_samples{
+          .topic = tp,
+          .total = reservoir.count(),
+          .samples_us = reservoir.samples(),
+        });
+    }
+    return ret;
+}
+
+} // namespace kafka
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/fundamental.h"
+#include "utils/reservoir_sample.h"
+
+#include <absl/container/flat_hash_map.h>
+
+#include <chrono>
+#include <vector>
+
+namespace kafka {
+
+/*
+ * Shard-local per-topic fetch latency estimators. The aggregate fetch
+ * histogram cannot answer "which topic is slow"; keeping a fixed size
+ * latency reservoir per topic gives per-topic quantiles at a per-sample
+ * cost of one prng draw and bounded memory, no matter how much traffic a
+ * topic sees. Quantiles are computed on demand (admin API), not on the
+ * hot path.
+ */
+class read_latency_probe {
+public:
+    /// samples retained per topic; 1024 puts the p99 estimate within a
+    /// couple of percentile points of the true stream quantile
+    static constexpr size_t reservoir_capacity = 1024;
+    /// bound on distinct topics tracked per shard so topic churn cannot
+    /// grow the registry without bound
+    static constexpr size_t max_topics = 1024;
+
+    struct topic_samples {
+        model::topic topic;
+        uint64_t total;
+        std::vector<int64_t> samples_us;
+    };
+
+    /// fetches are recorded on the connection's shard
+    static read_latency_probe& local();
+
+    void record(const model::topic&, std::chrono::microseconds);
+
+    /// copy of every topic's reservoir for off-shard aggregation
+    std::vector<topic_samples> snapshot() const;
+
+private:
+    absl::flat_hash_map<model::topic, reservoir_sample<int64_t>> _topics;
+};
+
+} // namespace kafka
@@ -0,0 +1,58 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "kafka/replica_selector.h"
+
+#include "cluster/metadata_cache.h"
+#include "config/configuration.h"
+
+#include <algorithm>
+
+namespace kafka {
+
+std::optional<model::node_id> select_preferred_read_replica(
+  const cluster::metadata_cache& md_cache,
+  const model::ntp& ntp,
+  std::optional<std::string_view> client_rack) {
+    if (!client_rack) {
+        return std::nullopt;
+    }
+    // this node already sits in the consumer's rack, serve locally
+    const auto& self_rack = config::shard_local_cfg().rack();
+    if (self_rack && std::string_view(*self_rack) == *client_rack) {
+        return std::nullopt;
+    }
+    auto tp_md = md_cache.get_topic_metadata(
+      model::topic_namespace_view(ntp.ns, ntp.tp.topic));
+    if (!tp_md) {
+        return std::nullopt;
+    }
+    auto p_it = std::find_if(
+      tp_md->partitions.cbegin(),
+      tp_md->partitions.cend(),
+      [&ntp](const model::partition_metadata& p_md) {
+          return p_md.id == ntp.tp.partition;
+      });
+    if (p_it == tp_md->partitions.cend()) {
+        return std::nullopt;
+    }
+    for (const auto& replica : p_it->replicas) {
+        auto broker = md_cache.get_broker(replica.node_id);
+        if (!broker) {
+            continue;
+        }
+        const auto& rack = (*broker)->rack();
+        if (rack && std::string_view(*rack) == *client_rack) {
+            return replica.node_id;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace kafka
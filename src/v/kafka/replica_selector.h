@@ -0,0 +1,40 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/fundamental.h"
+#include "model/metadata.h"
+#include "seastarx.h"
+
+#include <optional>
+#include <string_view>
+
+namespace cluster {
+class metadata_cache;
+}
+
+namespace kafka {
+
+/**
+ * Rack aware replica selection for fetch from follower (KIP-392).
+ *
+ * Returns the replica a consumer in client_rack should fetch from, or
+ * std::nullopt when this node should keep serving it: the consumer did not
+ * present a rack, this node is already in the consumer's rack, or no
+ * replica of the partition lives there.
+ */
+std::optional<model::node_id> select_preferred_read_replica(
+  const cluster::metadata_cache&,
+  const model::ntp&,
+  std::optional<std::string_view> client_rack);
+
+} // namespace kafka
@@ -0,0 +1,80 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "kafka/request_tracer.h"
+
+#include "config/configuration.h"
+#include "kafka/logger.h"
+#include "prometheus/prometheus_sanitize.h"
+#include "vlog.h"
+
+#include <seastar/core/metrics.hh>
+
+#include <fmt/format.h>
+
+namespace kafka {
+
+void request_trace::stage(trace_stage s) {
+    auto now = clock::now();
+    auto d = std::chrono::duration_cast<std::chrono::microseconds>(
+      now - _last);
+    _last = now;
+    _stages[static_cast<size_t>(s)] = d;
+    _tracer->record(s, d);
+}
+
+void request_trace::finish() {
+    auto total = std::chrono::duration_cast<std::chrono::microseconds>(
+      clock::now() - _start);
+    _tracer->record_total(total);
+    vlog(
+      klog.debug,
+      "request trace: key {} ingress {}us throttle {}us replicate {}us handle "
+      "{}us queue {}us write {}us total {}us",
+      _key,
+      _stages[static_cast<size_t>(trace_stage::ingress)].count(),
+      _stages[static_cast<size_t>(trace_stage::throttle)].count(),
+      _stages[static_cast<size_t>(trace_stage::replicate)].count(),
+      _stages[static_cast<size_t>(trace_stage::handle)].count(),
+      _stages[static_cast<size_t>(trace_stage::queue)].count(),
+      _stages[static_cast<size_t>(trace_stage::write)].count(),
+      total.count());
+}
+
+request_tracer::request_tracer()
+  : _sample_rate(
+    config::shard_local_cfg().kafka_latency_trace_sample_rate()) {
+    if (_sample_rate != 0) {
+        setup_metrics();
+    }
+}
+
+void request_tracer::setup_metrics() {
+    namespace sm = ss::metrics;
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+    std::vector<sm::metric_definition> defs;
+    for (size_t i = 0; i < num_trace_stages; ++i) {
+        auto stage = static_cast<trace_stage>(i);
+        defs.push_back(sm::make_histogram(
+          fmt::format("stage_{}_latency_us", trace_stage_name(stage)),
+          [this, i] { return _stage_hists[i].seastar_histogram_logform(); },
+          sm::description("Latency of sampled requests spent in the stage")));
+    }
+    defs.push_back(sm::make_histogram(
+      "sampled_request_latency_us",
+      [this] { return _total_hist.seastar_histogram_logform(); },
+      sm::description("End to end latency of sampled requests")));
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("kafka:latency_trace"),
+      std::move(defs));
+}
+
+} // namespace kafka
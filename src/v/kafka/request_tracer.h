@@ -0,0 +1,148 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "kafka/types.h"
+#include "seastarx.h"
+#include "utils/hdr_hist.h"
+
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/shared_ptr.hh>
+
+#include <array>
+#include <chrono>
+#include <string_view>
+
+namespace kafka {
+
+/*
+ * Stages of a sampled request, in the order they are stamped. Each stage
+ * records the time elapsed since the previous stamp (or since sampling for
+ * the first one), so the stage histograms form a breakdown of the total
+ * request latency rather than overlapping measurements.
+ *
+ *   ingress   - from the frame's first bytes leaving the socket until the
+ *               request is dispatched: header parse and connection
+ *               bookkeeping. latency accumulated here is connection fiber
+ *               queuing, not broker handling
+ *   throttle  - quota / backpressure delay before the body is read
+ *   replicate - produce only: dispatch, raft replication and log flush
+ *   handle    - remaining handler time: body read, decode, response building
+ *   queue     - waiting for earlier pipelined responses to be sequenced
+ *   write     - socket write of the (possibly coalesced) response batch
+ */
+enum class trace_stage : uint8_t {
+    ingress = 0,
+    throttle,
+    replicate,
+    handle,
+    queue,
+    write
+};
+
+static constexpr size_t num_trace_stages = 6;
+
+constexpr std::string_view trace_stage_name(trace_stage s) {
+    switch (s) {
+    case trace_stage::ingress:
+        return "ingress";
+    case trace_stage::throttle:
+        return "throttle";
+    case trace_stage::replicate:
+        return "replicate";
+    case trace_stage::handle:
+        return "handle";
+    case trace_stage::queue:
+        return "queue";
+    case trace_stage::write:
+        return "write";
+    }
+    return "unknown";
+}
+
+class request_tracer;
+
+/*
+ * Per-stage timing of a single sampled request. Stamps feed the tracer's
+ * stage histograms immediately; finish() records the total and optionally
+ * emits one structured log line with the full breakdown.
+ */
+class request_trace {
+public:
+    using clock = std::chrono::steady_clock;
+
+    // \param start the earliest timestamp observed for the request, taken
+    // at the socket boundary so pre-dispatch queuing is part of the trace
+    request_trace(
+      request_tracer* tracer, api_key key, clock::time_point start)
+      : _tracer(tracer)
+      , _key(key)
+      , _start(start)
+      , _last(_start) {}
+
+    void stage(trace_stage s);
+    void finish();
+
+private:
+    request_tracer* _tracer;
+    api_key _key;
+    clock::time_point _start;
+    clock::time_point _last;
+    std::array<std::chrono::microseconds, num_trace_stages> _stages{};
+};
+
+using request_trace_ptr = ss::lw_shared_ptr<request_trace>;
+
+/*
+ * Shard-local sampling tracer. Tags 1 in N requests at connection ingress
+ * (kafka_latency_trace_sample_rate, 0 disables) and aggregates per-stage
+ * latency histograms exposed through the metrics endpoint, so a tail
+ * latency spike can be attributed to a stage instead of guessed at from
+ * the aggregate request histogram.
+ */
+class request_tracer {
+public:
+    request_tracer();
+
+    // \param ingress the timestamp at which the request's first bytes were
+    // read off the socket; traces are anchored there rather than at
+    // dispatch so kernel/socket adjacent queuing shows up as the ingress
+    // stage instead of silently inflating (or escaping) the total
+    request_trace_ptr maybe_sample(
+      api_key key,
+      request_trace::clock::time_point ingress
+      = request_trace::clock::now()) {
+        if (_sample_rate == 0 || ++_requests % _sample_rate != 0) {
+            return nullptr;
+        }
+        return ss::make_lw_shared<request_trace>(this, key, ingress);
+    }
+
+private:
+    friend class request_trace;
+
+    void record(trace_stage s, std::chrono::microseconds d) {
+        _stage_hists[static_cast<size_t>(s)].record(d.count());
+    }
+    void record_total(std::chrono::microseconds d) {
+        _total_hist.record(d.count());
+    }
+    void setup_metrics();
+
+    uint32_t _sample_rate;
+    uint64_t _requests{0};
+    std::array<hdr_hist, num_trace_stages> _stage_hists;
+    hdr_hist _total_hist;
+    ss::metrics::metric_groups _metrics;
+};
+
+} // namespace kafka
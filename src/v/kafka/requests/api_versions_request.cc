@@ -35,6 +35,9 @@
 #include "kafka/requests/sasl_handshake_request.h"
 #include "kafka/requests/sync_group_request.h"
 
+#include <array>
+#include <optional>
+
 namespace kafka {
 
 std::ostream& operator<<(std::ostream& os, const api_versions_response& r) {
@@ -90,6 +93,38 @@ std::vector<api_versions_response_key> get_supported_apis() {
     return serialize_apis(request_types{});
 }
 
+/**
+ * Per-shard snapshot of the serialized api_versions response, one body
+ * per supported version.
+ *
+ * A new connection's first request is api_versions, so during a
+ * reconnect storm this is the request the overload is made of. The
+ * response is a pure function of the api version as long as no throttle
+ * delay has to be reported (the connection layer only takes the fast
+ * path when there is none), and the supported api table is fixed for
+ * the lifetime of the process, so the encoded body never invalidates
+ * and every handshake after the first shares the same bytes.
+ */
+std::optional<response_ptr>
+api_versions_api::handshake_response(const request_header& hdr) {
+    if (hdr.version < min_supported || hdr.version > max_supported) {
+        return std::nullopt;
+    }
+    static thread_local std::array<iobuf, max_supported() + 1> snapshots;
+    auto& snap = snapshots[hdr.version()];
+    if (snap.empty()) {
+        api_versions_response r;
+        r.data.error_code = error_code::none;
+        r.data.api_keys = get_supported_apis();
+        response resp;
+        r.data.encode(resp.writer(), hdr.version);
+        snap = std::move(resp.buf());
+    }
+    auto resp = std::make_unique<response>();
+    resp->buf() = snap.share(0, snap.size_bytes());
+    return response_ptr(std::move(resp));
+}
+
 ss::future<response_ptr>
 api_versions_api::process(request_context&& ctx, ss::smp_service_group) {
     // Unlike other request types, we handle ApiVersion requests
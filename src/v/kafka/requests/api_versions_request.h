@@ -33,6 +33,13 @@ struct api_versions_api final {
 
     static ss::future<response_ptr>
     process(request_context&&, ss::smp_service_group);
+
+    /// handshake fast path: answer from the per-shard serialized
+    /// snapshot without building a request context. disengaged
+    /// (nullopt) for versions above max_supported, which take the slow
+    /// path for the v0-schema downgrade
+    static std::optional<response_ptr>
+    handshake_response(const request_header& hdr);
 };
 
 struct api_versions_request final {
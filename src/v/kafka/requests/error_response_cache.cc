@@ -0,0 +1,40 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "kafka/requests/error_response_cache.h"
+
+namespace kafka {
+
+error_response_cache& error_response_cache::local() {
+    static thread_local error_response_cache cache;
+    return cache;
+}
+
+std::optional<iobuf>
+error_response_cache::find(api_key key, api_version v, error_code error) {
+    auto it = _templates.find(make_key(key, v, error));
+    if (it == _templates.end()) {
+        return std::nullopt;
+    }
+    // sharing is cheaper than the memcpy it replaces: response bodies are
+    // immutable once encoded, so the connection writes the cached
+    // fragments directly
+    return it->second.share(0, it->second.size_bytes());
+}
+
+void error_response_cache::put(
+  api_key key, api_version v, error_code error, const iobuf& body) {
+    if (_templates.size() >= max_entries) {
+        return;
+    }
+    _templates.try_emplace(
+      make_key(key, v, error), body.share(0, body.size_bytes()));
+}
+
+} // namespace kafka
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "bytes/iobuf.h"
+#include "kafka/errors.h"
+#include "kafka/types.h"
+#include "seastarx.h"
+
+#include <absl/container/flat_hash_map.h>
+
+#include <cstdint>
+#include <optional>
+
+namespace kafka {
+
+/**
+ * Per shard cache of pre-serialized error response bodies.
+ *
+ * Rejection storms are bursty and repetitive: while group coordinators
+ * move between brokers after a restart, every consumer retries its
+ * heartbeat against the old coordinator and each retry is answered with
+ * the same two-field NOT_COORDINATOR response, rebuilt through the full
+ * response_writer machinery every time. An error-only response body is a
+ * pure function of (api, api version, error code), so it is encoded once
+ * and subsequent rejections share the cached bytes - only the
+ * correlation id differs, and that is patched into the response header
+ * at send time as for any response.
+ *
+ * Only response types whose error constructor fills every wire field may
+ * be served from the cache; see request_context::respond_error.
+ */
+class error_response_cache {
+public:
+    /// bound on cached templates; the (api, version, error) combinations
+    /// reachable in practice number a few dozen, the bound only guards
+    /// against a misbehaving client cycling through versions
+    static constexpr size_t max_entries = 256;
+
+    /// cache of the calling shard
+    static error_response_cache& local();
+
+    /// returns a shared view of the cached body, or std::nullopt when the
+    /// combination has not been encoded yet
+    std::optional<iobuf> find(api_key key, api_version v, error_code error);
+
+    /// records an encoded body for the combination
+    void put(api_key key, api_version v, error_code error, const iobuf& body);
+
+    size_t size() const { return _templates.size(); }
+
+private:
+    static uint64_t make_key(api_key key, api_version v, error_code error) {
+        return (uint64_t(uint16_t(key())) << 32)
+               | (uint64_t(uint16_t(v())) << 16)
+               | uint64_t(uint16_t(static_cast<int16_t>(error)));
+    }
+
+    absl::flat_hash_map<uint64_t, iobuf> _templates;
+};
+
+} // namespace kafka
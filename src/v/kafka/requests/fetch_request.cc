@@ -14,18 +14,24 @@
 #include "config/configuration.h"
 #include "kafka/errors.h"
 #include "kafka/fetch_session.h"
+#include "kafka/read_latency_probe.h"
+#include "kafka/replica_selector.h"
 #include "kafka/requests/batch_consumer.h"
 #include "likely.h"
 #include "model/fundamental.h"
 #include "model/timeout_clock.h"
+#include "raft/offset_monitor.h"
 #include "resource_mgmt/io_priority.h"
+#include "ssx/future-util.h"
 #include "utils/to_string.h"
 
 #include <seastar/core/do_with.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/sleep.hh>
 #include <seastar/core/thread.hh>
 #include <seastar/util/log.hh>
 
+#include <absl/container/flat_hash_map.h>
 #include <boost/range/irange.hpp>
 #include <fmt/ostream.h>
 
@@ -75,6 +81,9 @@ void fetch_request::encode(response_writer& writer, api_version version) {
                 [](int32_t p, response_writer& writer) { writer.write(p); });
           });
     }
+    if (version >= api_version(11)) {
+        writer.write(rack_id.value_or(""));
+    }
 }
 
 void fetch_request::decode(request_context& ctx) {
@@ -122,6 +131,12 @@ void fetch_request::decode(request_context& ctx) {
             };
         });
     }
+    if (version >= api_version(11)) {
+        auto rack = reader.read_string_view();
+        if (!rack.empty()) {
+            rack_id = rack;
+        }
+    }
 }
 
 std::ostream&
@@ -149,7 +164,7 @@ std::ostream& operator<<(std::ostream& o, const fetch_request& r) {
     fmt::print(
       o,
       "{{replica {} max_wait_time {} session_id {} session_epoch {} min_bytes "
-      "{} max_bytes {} isolation {} topics {} forgotten {}}}",
+      "{} max_bytes {} isolation {} topics {} forgotten {} rack {}}}",
       r.replica_id,
       r.max_wait_time,
       r.session_id,
@@ -158,7 +173,8 @@ std::ostream& operator<<(std::ostream& o, const fetch_request& r) {
       r.max_bytes,
       r.isolation_level,
       r.topics,
-      r.forgotten_topics);
+      r.forgotten_topics,
+      r.rack_id);
     return o;
 }
 
@@ -192,6 +208,9 @@ void fetch_response::encode(const request_context& ctx, response& resp) {
                       writer.write(t.producer_id);
                       writer.write(int64_t(t.first_offset));
                   });
+                if (version >= api_version(11)) {
+                    writer.write(r.preferred_read_replica());
+                }
                 writer.write(std::move(r.record_set));
             });
       });
@@ -224,6 +243,8 @@ void fetch_response::decode(iobuf buf, api_version version) {
                       .first_offset = model::offset(reader.read_int64()),
                     };
                 }),
+              .preferred_read_replica = model::node_id(
+                version >= api_version(11) ? reader.read_int32() : -1),
               .record_set = reader.read_fragmented_nullable_bytes()};
         });
         return p;
@@ -242,12 +263,13 @@ operator<<(std::ostream& o, const fetch_response::partition_response& p) {
     fmt::print(
       o,
       "{{id {} err {} high_water {} last_stable_off {} aborted {} "
-      "record_set_len {}}}",
+      "preferred_replica {} record_set_len {}}}",
       p.id,
       p.error,
       p.high_watermark,
       p.last_stable_offset,
       p.aborted_transactions,
+      p.preferred_read_replica,
       (p.record_set ? p.record_set->size_bytes() : -1));
     return o;
 }
@@ -287,13 +309,24 @@ make_partition_response_error(model::partition_id p_id, error_code error) {
 static ss::future<read_result> read_from_partition(
   partition_wrapper pw,
   fetch_config config,
-  bool foreign_read,
   std::optional<model::timeout_clock::time_point> deadline) {
     auto hw = pw.high_watermark();
     auto lso = pw.last_stable_offset();
-    // if we have no data read, return fast
+    std::optional<model::timeout_clock::time_point> wait_for_data;
     if (hw < config.start_offset) {
-        return ss::make_ready_future<read_result>(hw, lso);
+        if (!config.debounce_deadline || pw.is_materialized()) {
+            // no data to read and the caller does not want to wait (or the
+            // partition has no offset monitor to wait on), return fast
+            return ss::make_ready_future<read_result>(hw, lso);
+        }
+        /*
+         * long-poll: register with the partition's offset monitor so the
+         * read resolves when the satisfying append happens instead of
+         * periodically re-polling. only armed when there is nothing to
+         * read right now - otherwise the monitor would make available data
+         * wait for the next append.
+         */
+        wait_for_data = config.debounce_deadline;
     }
 
     storage::log_reader_config reader_config(
@@ -307,23 +340,34 @@ static ss::future<read_result> read_from_partition(
       std::nullopt);
 
     reader_config.strict_max_bytes = config.strict_max_bytes;
-    return pw.make_reader(reader_config)
-      .then([hw, lso, foreign_read, deadline](model::record_batch_reader rdr) {
-          // if we are on remote core, we MUST use foreign record batch reader.
-          if (foreign_read) {
-              return model::consume_reader_to_memory(
-                       std::move(rdr), deadline.value_or(model::no_timeout))
-                .then([hw, lso](ss::circular_buffer<model::record_batch> data) {
-                    return read_result(
-                      model::make_foreign_memory_record_batch_reader(
-                        std::move(data)),
-                      hw,
-                      lso);
-                });
-          }
-          return ss::make_ready_future<read_result>(
-            read_result(std::move(rdr), hw, lso));
-      });
+    return pw.make_reader(reader_config, wait_for_data)
+      .then([deadline, pw](model::record_batch_reader rdr) mutable {
+          /*
+           * serialize into the kafka on-wire format here, on the home core:
+           * the record payload is stored wire-compatible and is spliced into
+           * the result without copies, and for cross-core fetches only the
+           * final iobuf travels between cores instead of a buffer of batches
+           * that would be re-framed on the connection's core.
+           */
+          return std::move(rdr)
+            .consume(
+              kafka_batch_serializer(), deadline.value_or(model::no_timeout))
+            .then([pw](kafka_batch_serializer::result res) {
+                // report offsets observed after a potential wait so the
+                // client sees the high watermark that satisfied the fetch
+                return read_result(
+                  std::move(res.data),
+                  res.record_count,
+                  pw.high_watermark(),
+                  pw.last_stable_offset());
+            });
+      })
+      .handle_exception_type(
+        [pw](const raft::offset_monitor::wait_aborted&) mutable {
+            // long-poll expired (or partition is shutting down) before any
+            // new data arrived
+            return read_result(pw.high_watermark(), pw.last_stable_offset());
+        });
 }
 
 std::optional<partition_wrapper> make_partition_wrapper(
@@ -339,6 +383,118 @@ std::optional<partition_wrapper> make_partition_wrapper(
     return partition_wrapper(partition);
 }
 
+/**
+ * Identity of an in-flight partition read. Two fetches that start at the
+ * same offset with the same size budget walk exactly the same bytes, so
+ * they can be served by one read.
+ */
+struct inflight_read_key {
+    model::ntp ntp;
+    model::offset offset;
+    size_t max_bytes;
+    bool strict_max_bytes;
+
+    bool operator==(const inflight_read_key& o) const {
+        return ntp == o.ntp && offset == o.offset && max_bytes == o.max_bytes
+               && strict_max_bytes == o.strict_max_bytes;
+    }
+
+    template<typename H>
+    friend H AbslHashValue(H h, const inflight_read_key& k) {
+        return H::combine(
+          std::move(h),
+          std::hash<model::ntp>{}(k.ntp),
+          k.offset(),
+          k.max_bytes,
+          k.strict_max_bytes);
+    }
+};
+
+using inflight_read_map = absl::flat_hash_map<
+  inflight_read_key,
+  ss::shared_future<ss::lw_shared_ptr<read_result>>>;
+
+// shard-local: fetches always read a partition on its home core
+static inflight_read_map& inflight_reads() {
+    static thread_local inflight_read_map reads;
+    return reads;
+}
+
+/**
+ * Hand a waiter its own view of a shared read. The record set payload is
+ * shared by reference counting the underlying fragments, not copied.
+ */
+static read_result share_read_result(read_result& res) {
+    if (res.error != error_code::none) {
+        return read_result(res.error);
+    }
+    read_result ret(res.high_watermark, res.last_stable_offset);
+    ret.record_count = res.record_count;
+    if (res.record_set) {
+        ret.record_set = res.record_set->share(
+          0, res.record_set->size_bytes());
+    }
+    return ret;
+}
+
+/**
+ * Fetch deduplication for fanout topics: when n consumers of the same
+ * partition fetch the same offset window concurrently - the common steady
+ * state of a consumer group re-reading a hot partition - the first fetch
+ * runs the read pipeline and the rest attach to its future, sharing the
+ * serialized record set via iobuf::share instead of running n identical
+ * reads. The entry is dropped the moment the read completes so later
+ * fetches observe fresh offsets; only reads with data available join, a
+ * long-polling read is never shared (deadlines differ per consumer).
+ */
+static ss::future<read_result> read_from_partition_shared(
+  partition_wrapper pw,
+  fetch_config config,
+  model::ntp ntp,
+  std::optional<model::timeout_clock::time_point> deadline) {
+    auto& inflight = inflight_reads();
+    inflight_read_key key{
+      std::move(ntp),
+      config.start_offset,
+      config.max_bytes,
+      config.strict_max_bytes};
+    auto it = inflight.find(key);
+    if (it != inflight.end()) {
+        return it->second.get_future().then(
+          [](ss::lw_shared_ptr<read_result> res) {
+              return share_read_result(*res);
+          });
+    }
+    auto fut = read_from_partition(pw, config, deadline);
+    if (fut.available()) {
+        /*
+         * resolved without suspending (pure batch cache hit): there is
+         * nothing concurrent to attach, and publishing an already
+         * resolved read would run the cleanup continuation inline -
+         * before the emplace - pinning a stale snapshot in the map
+         * forever
+         */
+        return fut;
+    }
+    auto shared = fut.then_wrapped([key](ss::future<read_result> f) {
+        // unshare before publishing: a fetch arriving after the read
+        // finished must see fresh offsets. get0() forwards a failed read
+        // to every waiter
+        inflight_reads().erase(key);
+        return ss::make_lw_shared<read_result>(f.get0());
+    });
+    it = inflight
+           .emplace(
+             std::move(key),
+             ss::shared_future<ss::lw_shared_ptr<read_result>>(
+               std::move(shared)))
+           .first;
+    return it->second.get_future().then(
+      [](ss::lw_shared_ptr<read_result> res) {
+          return share_read_result(*res);
+      });
+}
+
 /**
  * Entry point for reading from an ntp. This is executed on NTP home core and
  * build error responses if anything goes wrong.
@@ -347,7 +503,6 @@ ss::future<read_result> read_from_ntp(
   cluster::partition_manager& mgr,
   const model::materialized_ntp& ntp,
   fetch_config config,
-  bool foreign_read,
   std::optional<model::timeout_clock::time_point> deadline) {
     /*
      * lookup the ntp's partition
@@ -357,7 +512,11 @@ ss::future<read_result> read_from_ntp(
         return ss::make_ready_future<read_result>(
           error_code::unknown_topic_or_partition);
     }
-    if (unlikely(!partition->is_leader())) {
+    // leases make the leadership check a pure time comparison: a leader cut
+    // off from the majority stops serving reads once its lease expires
+    // instead of returning data that a new leader may have overwritten
+    const bool follower_read = !partition->has_leader_lease();
+    if (unlikely(follower_read && !config.read_from_follower)) {
         return ss::make_ready_future<read_result>(
           error_code::not_leader_for_partition);
     }
@@ -372,6 +531,16 @@ ss::future<read_result> read_from_ntp(
                         ? model::offset(0)
 
                         : high_watermark + model::offset(1);
+    /*
+     * monotonic cursor guard for follower reads: the consumer's position
+     * can be ahead of what this replica has replicated. that is not an out
+     * of range error - report the local offsets with no data so the client
+     * retries without rewinding
+     */
+    if (unlikely(follower_read && config.start_offset > max_offset)) {
+        return ss::make_ready_future<read_result>(
+          read_result(high_watermark, partition->last_stable_offset()));
+    }
     if (
       config.start_offset < partition->start_offset()
       || config.start_offset > max_offset) {
@@ -379,7 +548,13 @@ ss::future<read_result> read_from_ntp(
           error_code::offset_out_of_range);
     }
 
-    return read_from_partition(*partition_wpr, config, foreign_read, deadline);
+    if (config.start_offset < max_offset) {
+        // data is available right now: identical concurrent fetches can
+        // share one read
+        return read_from_partition_shared(
+          *partition_wpr, config, ntp.input_ntp(), deadline);
+    }
+    return read_from_partition(*partition_wpr, config, deadline);
 }
 
 static ss::future<> do_fill_fetch_responses(
@@ -389,35 +564,43 @@ static ss::future<> do_fill_fetch_responses(
     return ss::parallel_for_each(range, [&results, &responses](size_t idx) {
         auto& res = results[idx];
         auto& resp_it = responses[idx];
-        vlog(klog.trace, "fetch reader {}", res.reader);
-        // error case
-        if (!res.reader) {
+        // error case. the cached high watermark is reset to -1 so the
+        // partition is re-sent once the error clears
+        if (res.error != error_code::none) {
             resp_it.set(
               make_partition_response_error(res.partition, res.error));
             return ss::now();
         }
-        return std::move(*res.reader)
-          .consume(kafka_batch_serializer(), model::no_timeout)
-          .then([pid = res.partition, resp_it = resp_it](
-                  kafka_batch_serializer::result res) mutable {
-              fetch_response::partition_response resp{
-                .id = pid,
-                .error = error_code::none,
-                .record_set = std::move(res.data),
-              };
-              resp_it.set(std::move(resp));
-          })
-          .handle_exception([pid = res.partition, resp_it = resp_it](
-                              const std::exception_ptr&) mutable {
-              /*
-               * TODO: this is where we will want to
-               * handle any storage specific errors and
-               * translate them into kafka response
-               * error codes.
-               */
-              resp_it.set(make_partition_response_error(
-                pid, error_code::unknown_server_error));
-          });
+        /*
+         * no new data. report the offsets that were observed so the session
+         * cursor stays accurate - an incremental fetch then includes the
+         * partition in the response only when its high watermark moved
+         */
+        if (!res.record_set) {
+            resp_it.set(fetch_response::partition_response{
+              .id = res.partition,
+              .error = error_code::none,
+              .high_watermark = res.high_watermark,
+              .last_stable_offset = res.last_stable_offset,
+              .record_set = iobuf(),
+            });
+            return ss::now();
+        }
+        vlog(
+          klog.trace,
+          "fetch record_set {} bytes",
+          res.record_set->size_bytes());
+        // the record data was serialized on the partition's home shard;
+        // splice it into the response as-is
+        fetch_response::partition_response resp{
+          .id = res.partition,
+          .error = error_code::none,
+          .high_watermark = res.high_watermark,
+          .last_stable_offset = res.last_stable_offset,
+          .record_set = std::move(*res.record_set),
+        };
+        resp_it.set(std::move(resp));
+        return ss::now();
     });
 }
 
@@ -434,17 +617,38 @@ static ss::future<> fill_fetch_responsens(
       });
 }
 
+/**
+ * A record set serialized on this shard shares fragments with batch
+ * cache resident batches, and iobuf sharing refcounts are not atomic.
+ * Before results cross to the connection's shard every record set is
+ * rebound to exclusively owned fragments so the home shard's refcounts
+ * are never touched remotely; a same-shard fetch keeps the zero-copy
+ * splice.
+ */
+static void detach_read_results(std::vector<read_result>& results) {
+    for (auto& res : results) {
+        if (res.record_set) {
+            res.record_set = res.record_set->copy();
+        }
+    }
+}
+
 static ss::future<std::vector<read_result>> fetch_ntps_in_parallel(
   cluster::partition_manager& mgr,
   std::vector<ntp_fetch_config> ntp_fetch_configs,
-  bool foreign_read,
   std::optional<model::timeout_clock::time_point> deadline) {
-    return ssx::async_transform(
-      std::move(ntp_fetch_configs),
-      [&mgr, deadline, foreign_read](ntp_fetch_config cfg) {
+    return ssx::parallel_transform(
+      std::move(ntp_fetch_configs), [&mgr, deadline](ntp_fetch_config cfg) {
           auto p_id = cfg.first.source_ntp().tp.partition;
-          return read_from_ntp(
-                   mgr, cfg.first, cfg.second, foreign_read, deadline)
+          return read_from_ntp(mgr, cfg.first, cfg.second, deadline)
+            .handle_exception([](const std::exception_ptr&) {
+                /*
+                 * TODO: this is where we will want to handle any storage
+                 * specific errors and translate them into kafka response
+                 * error codes.
+                 */
+                return read_result(error_code::unknown_server_error);
+            })
             .then([p_id](read_result res) {
                 res.partition = p_id;
                 return res;
@@ -470,19 +674,23 @@ handle_shard_fetch(ss::shard_id shard, op_context& octx, shard_fetch fetch) {
         return ss::now();
     }
 
-    bool foreign_read = shard != ss::this_shard_id();
-
     // dispatch to remote core
+    const bool foreign_read = shard != ss::this_shard_id();
     return octx.rctx.partition_manager()
       .invoke_on(
         shard,
         octx.ssg,
-        [foreign_read,
-         deadline = octx.deadline,
+        [deadline = octx.deadline,
+         foreign_read,
          configs = std::move(fetch.requests)](
           cluster::partition_manager& mgr) mutable {
-            return fetch_ntps_in_parallel(
-              mgr, std::move(configs), foreign_read, deadline);
+            return fetch_ntps_in_parallel(mgr, std::move(configs), deadline)
+              .then([foreign_read](std::vector<read_result> results) {
+                  if (foreign_read) {
+                      detach_read_results(results);
+                  }
+                  return results;
+              });
         })
       .then([responses = std::move(fetch.responses)](
               std::vector<read_result> results) mutable {
@@ -515,6 +723,31 @@ static std::vector<shard_fetch> group_requests_by_shard(op_context& octx) {
         auto ntp = model::ntp(cluster::kafka_namespace, fp.topic, fp.partition);
         auto materialized_ntp = model::materialized_ntp(std::move(ntp));
 
+        /*
+         * KIP-392: a consumer that presented its rack is redirected to a
+         * replica in that rack instead of being served cross-AZ. the
+         * consumer keeps its cursor and resumes from the same offset on
+         * the preferred replica
+         */
+        if (octx.request.rack_id) {
+            auto preferred = select_preferred_read_replica(
+              octx.rctx.metadata_cache(),
+              materialized_ntp.source_ntp(),
+              octx.request.rack_id);
+            if (preferred) {
+                resp_it.set(fetch_response::partition_response{
+                  .id = fp.partition,
+                  .error = error_code::none,
+                  .high_watermark = model::offset(-1),
+                  .last_stable_offset = model::offset(-1),
+                  .preferred_read_replica = *preferred,
+                  .record_set = iobuf(),
+                });
+                ++resp_it;
+                return;
+            }
+        }
+
         auto shard = octx.rctx.shards().shard_for(
           materialized_ntp.source_ntp());
         if (!shard) {
@@ -530,6 +763,12 @@ static std::vector<shard_fetch> group_requests_by_shard(op_context& octx) {
           .max_bytes = std::min(octx.bytes_left, size_t(fp.max_bytes)),
           .timeout = octx.deadline.value_or(model::no_timeout),
           .strict_max_bytes = octx.response_size > 0,
+          // the first pass reads whatever is available without waiting;
+          // retry passes park on the partition's offset monitor
+          .debounce_deadline = octx.initial_fetch
+                                 ? std::nullopt
+                                 : octx.deadline,
+          .read_from_follower = octx.request.rack_id.has_value(),
         };
         shard_fetches[*shard].push_back(
           std::move(materialized_ntp), config, resp_it++);
@@ -541,25 +780,18 @@ static std::vector<shard_fetch> group_requests_by_shard(op_context& octx) {
 /**
  * Process partition fetch requests.
  *
- * Each request is handled serially in the order they appear in the request.
- * There are a couple reasons why we are not **yet** processing these in
- * parallel. First, Kafka expects to some extent that the order of the
- * partitions in the request is an implicit priority on which partitions to
- * read from. This is closely related to the request budget limits specified
- * in terms of maximum bytes and maximum time delay.
- *
- * Once we start processing requests in parallel we'll have to work through
- * various challenges. First, once we dispatch in parallel, we'll need to
- * develop heuristics for dealing with the implicit priority order. We'll
- * also need to develop techniques and heuristics for dealing with budgets
- * since global budgets aren't trivially divisible onto each core when
- * partition requests may produce non-uniform amounts of data.
+ * The plan is grouped by shard and each shard receives exactly one
+ * cross-core dispatch carrying its whole slice of the plan. On the owning
+ * shard all partition reads run concurrently - there are no data
+ * dependencies between them - and the serialized per-partition results
+ * travel back in a single reply. Response reassembly preserves the order
+ * of the partitions in the request.
  *
- * w.r.t. what is needed to parallelize this, there are no data dependencies
- * between partition requests within the fetch request, and so they can be
- * run fully in parallel. The only dependency that exists is that the
- * response must be reassembled such that the responses appear in these
- * order as the partitions in the request.
+ * Per-partition byte budgets are fixed when the plan is built
+ * (min(bytes_left, partition max_bytes) at planning time), so concurrent
+ * reads may together overshoot the global request budget in the way
+ * concurrent shards always could; response_size/bytes_left accounting on
+ * the connection core keeps follow-up passes within budget.
  */
 
 static ss::future<> fetch_topic_partitions(op_context& octx) {
@@ -572,15 +804,29 @@ static ss::future<> fetch_topic_partitions(op_context& octx) {
           handle_shard_fetch(shard++, octx, std::move(shard_fetch)));
     }
 
+    auto size_before = octx.response_size;
     return ss::do_with(
-      std::move(fetches), [&octx](std::vector<ss::future<>>& fetches) {
+      std::move(fetches),
+      [&octx, size_before](std::vector<ss::future<>>& fetches) {
           return ss::when_all_succeed(fetches.begin(), fetches.end())
-            .then([&octx] {
+            .then([&octx, size_before] {
                 if (octx.should_stop_fetch()) {
                     return ss::now();
                 }
                 octx.reset_context();
-                // debounce next read retry
+                if (octx.response_size > size_before) {
+                    // made progress, re-plan immediately
+                    return ss::now();
+                }
+                /*
+                 * empty reads are event driven: a partition with no data
+                 * parks on its offset monitor and resolves on the append
+                 * that satisfies it, so there is no periodic re-polling on
+                 * the common path. a pass can still come back empty without
+                 * having blocked (materialized partitions, or visible
+                 * offsets holding only non-data batches), so keep the
+                 * debounce sleep as a spin guard for those.
+                 */
                 return ss::sleep(std::min(
                   config::shard_local_cfg().fetch_reads_debounce_timeout(),
                   octx.request.max_wait_time));
@@ -588,6 +834,46 @@ static ss::future<> fetch_topic_partitions(op_context& octx) {
       });
 }
 
+/*
+ * shard wide bound on memory held by concurrently assembling fetch
+ * responses. every fetch reserves its full byte budget up front and in a
+ * single acquisition, so waiters never hold partial reservations and the
+ * window cannot deadlock. the units are released when the op context is
+ * destroyed, after the assembled response has been handed to the
+ * connection for writing.
+ */
+static ss::semaphore& fetch_memory_window() {
+    static thread_local ss::semaphore window{
+      config::shard_local_cfg().kafka_fetch_memory_window_bytes()};
+    return window;
+}
+
+static ss::future<> reserve_memory_window(op_context& octx) {
+    // a budget above the whole window could never be satisfied; clamp the
+    // budget so the reservation (and the response) fit
+    const size_t reserve = std::min(
+      octx.bytes_left,
+      config::shard_local_cfg().kafka_fetch_memory_window_bytes());
+    octx.bytes_left = reserve;
+    return ss::get_units(fetch_memory_window(), reserve)
+      .then([&octx](ss::semaphore_units<> units) {
+          octx.memory_units = std::move(units);
+      });
+}
+
+// feed the per-topic latency reservoirs. the whole fetch duration is
+// attributed to every topic in the request: a multi-topic fetch finishes
+// when its slowest topic does, which is exactly what the consumer of that
+// topic experienced
+static void record_read_latency(
+  const op_context& octx, std::chrono::steady_clock::time_point start) {
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+    for (const auto& t : octx.request.topics) {
+        read_latency_probe::local().record(t.name, elapsed);
+    }
+}
+
 ss::future<response_ptr>
 fetch_api::process(request_context&& rctx, ss::smp_service_group ssg) {
     return ss::do_with(op_context(std::move(rctx), ssg), [](op_context& octx) {
@@ -597,14 +883,19 @@ fetch_api::process(request_context&& rctx, ss::smp_service_group ssg) {
             return std::move(octx).send_response();
         }
         octx.response.error = error_code::none;
+        auto start = std::chrono::steady_clock::now();
         // first fetch, do not wait
-        return fetch_topic_partitions(octx)
+        return reserve_memory_window(octx)
+          .then([&octx] { return fetch_topic_partitions(octx); })
           .then([&octx] {
               return ss::do_until(
                 [&octx] { return octx.should_stop_fetch(); },
                 [&octx] { return fetch_topic_partitions(octx); });
           })
-          .then([&octx] { return std::move(octx).send_response(); });
+          .then([&octx, start] {
+              record_read_latency(octx, start);
+              return std::move(octx).send_response();
+          });
     });
 }
 
@@ -629,12 +920,15 @@ op_context::op_context(request_context&& ctx, ss::smp_service_group ssg)
     }
 
     /*
-     * TODO: max size is multifaceted. it needs to be absolute, but also
-     * integrate with other resource contraints that are dynamic within the
-     * kafka server itself.
+     * the per-request byte budget honors the client's max_bytes up to the
+     * broker cap. aggregate memory across concurrent fetches is bounded
+     * separately by the shard's fetch memory window (see
+     * reserve_memory_window), so a large cap here cannot multiply into a
+     * shard-wide memory spike.
      */
-    static constexpr size_t max_size = 128_KiB;
-    bytes_left = std::min(max_size, size_t(request.max_bytes));
+    bytes_left = std::min(
+      config::shard_local_cfg().kafka_fetch_max_bytes(),
+      size_t(request.max_bytes));
     session_ctx = rctx.fetch_sessions().maybe_get_session(request);
     create_response_placeholders();
 }
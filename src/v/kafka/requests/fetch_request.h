@@ -23,6 +23,9 @@
 #include "seastarx.h"
 
 #include <seastar/core/future.hh>
+#include <seastar/core/semaphore.hh>
+
+#include <string_view>
 
 namespace kafka {
 
@@ -34,7 +37,7 @@ struct fetch_api final {
     static constexpr const char* name = "fetch";
     static constexpr api_key key = api_key(1);
     static constexpr api_version min_supported = api_version(4);
-    static constexpr api_version max_supported = api_version(10);
+    static constexpr api_version max_supported = api_version(11);
 
     static ss::future<response_ptr>
     process(request_context&&, ss::smp_service_group);
@@ -72,6 +75,9 @@ struct fetch_request final {
     int32_t session_epoch = final_fetch_session_epoch; // >= v7
     std::vector<topic> topics;
     std::vector<forgotten_topic> forgotten_topics; // >= v7
+    // consumer's rack (KIP-392), empty on the wire means not set >= v11.
+    // a view into the request buffer, valid for the request lifetime only
+    std::optional<std::string_view> rack_id;
 
     void encode(response_writer& writer, api_version version);
     void decode(request_context& ctx);
@@ -221,6 +227,9 @@ struct fetch_response final {
         model::offset last_stable_offset;                      // >= v4
         model::offset log_start_offset;                        // >= v5
         std::vector<aborted_transaction> aborted_transactions; // >= v4
+        // replica the consumer should fetch from (KIP-392), -1 when the
+        // leader should keep serving this consumer >= v11
+        model::node_id preferred_read_replica = model::node_id(-1);
         std::optional<iobuf> record_set;
         /*
          * _not part of kafka protocol
@@ -463,6 +472,9 @@ struct op_context {
 
     // operation budgets
     size_t bytes_left;
+    // units held against the shard's fetch memory window while the
+    // response is being assembled
+    ss::semaphore_units<> memory_units;
     std::optional<model::timeout_clock::time_point> deadline;
 
     // size of response
@@ -482,12 +494,23 @@ public:
       : _partition(partition)
       , _log(log) {}
 
-    ss::future<model::record_batch_reader>
-    make_reader(storage::log_reader_config config) {
+    /**
+     * When a debounce deadline is set and no new data is available the read
+     * registers with the partition's offset monitor and resolves when the
+     * satisfying append happens (or the deadline passes). Materialized logs
+     * are filled asynchronously and have no monitor, so they always read
+     * immediately.
+     */
+    ss::future<model::record_batch_reader> make_reader(
+      storage::log_reader_config config,
+      std::optional<model::timeout_clock::time_point> debounce_deadline
+      = std::nullopt) {
         return _log ? _log->make_reader(config)
-                    : _partition->make_reader(config);
+                    : _partition->make_reader(config, debounce_deadline);
     }
 
+    bool is_materialized() const { return _log.has_value(); }
+
     cluster::partition_probe& probe() { return _partition->probe(); }
 
     model::offset high_watermark() const {
@@ -510,17 +533,27 @@ struct fetch_config {
     size_t max_bytes;
     model::timeout_clock::time_point timeout;
     bool strict_max_bytes{false};
+    // when set and the partition has no data past start_offset the read
+    // waits for the next append instead of returning empty immediately
+    std::optional<model::timeout_clock::time_point> debounce_deadline;
+    // the consumer presented a rack id (KIP-392), a follower replica may
+    // serve the read up to its locally replicated high watermark
+    bool read_from_follower{false};
 };
 /**
- * Simple type aggregating either reader and offsets or an error
+ * Simple type aggregating either the wire-format record data and offsets or
+ * an error. Batches are serialized to the kafka on-wire framing on the
+ * partition's home shard, so the response path only splices the returned
+ * iobuf into the response without touching individual batches again.
  */
 struct read_result {
     explicit read_result(error_code e)
       : error(e) {}
 
     read_result(
-      model::record_batch_reader rdr, model::offset hw, model::offset lso)
-      : reader(std::move(rdr))
+      iobuf data, uint32_t count, model::offset hw, model::offset lso)
+      : record_set(std::move(data))
+      , record_count(count)
       , high_watermark(hw)
       , last_stable_offset(lso)
       , error(error_code::none) {}
@@ -530,7 +563,8 @@ struct read_result {
       , last_stable_offset(lso)
       , error(error_code::none) {}
 
-    std::optional<model::record_batch_reader> reader;
+    std::optional<iobuf> record_set;
+    uint32_t record_count{0};
     model::offset high_watermark;
     model::offset last_stable_offset;
     error_code error;
@@ -573,7 +607,6 @@ ss::future<read_result> read_from_ntp(
   cluster::partition_manager&,
   const model::materialized_ntp&,
   fetch_config,
-  bool,
   std::optional<model::timeout_clock::time_point>);
 
 } // namespace kafka
@@ -13,6 +13,7 @@
 #include "kafka/groups/group_router.h"
 #include "kafka/requests/request_context.h"
 #include "kafka/requests/response.h"
+#include "likely.h"
 #include "utils/remote.h"
 #include "utils/to_string.h"
 
@@ -32,6 +33,12 @@ ss::future<response_ptr> heartbeat_api::process(
         return ctx.groups()
           .heartbeat(std::move(request))
           .then([&ctx](heartbeat_response&& reply) {
+              if (unlikely(reply.data.error_code != error_code::none)) {
+                  // rejection storms (coordinator movement after restarts)
+                  // are served from the pre-serialized template cache
+                  return ctx.respond_error<heartbeat_response>(
+                    reply.data.error_code);
+              }
               return ctx.respond(std::move(reply));
           });
     });
@@ -9,25 +9,61 @@
 
 #include "kafka/requests/init_producer_id_request.h"
 
-#include "kafka/groups/group_manager.h"
-#include "kafka/groups/group_router.h"
+#include "config/configuration.h"
+#include "kafka/errors.h"
 #include "kafka/requests/request_context.h"
 #include "kafka/requests/response.h"
-#include "utils/remote.h"
-#include "utils/to_string.h"
 
-#include <seastar/core/print.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/smp.hh>
+
+#include <chrono>
 
 namespace kafka {
 
+/**
+ * Producer ids are allocated node-locally without coordination:
+ *
+ *   [0][node id:15][shard:8][counter:40]
+ *
+ * The node and shard fields make concurrent allocations across the
+ * cluster disjoint, and the counter is seeded from the wall clock in
+ * milliseconds at first use so ids keep moving forward across restarts
+ * as long as a shard's long term allocation rate stays below one id per
+ * millisecond. A collision with a forgotten id would only weaken dedup
+ * for that one producer, never the correctness of the log.
+ */
+static int64_t next_producer_id() {
+    constexpr int64_t counter_mask = (int64_t(1) << 40) - 1;
+    static thread_local int64_t counter = [] {
+        auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+          ss::lowres_system_clock::now().time_since_epoch());
+        return now.count() & counter_mask;
+    }();
+    const int64_t node = config::shard_local_cfg().node_id() & 0x7FFF;
+    const int64_t shard = ss::this_shard_id() & 0xFF;
+    counter = (counter + 1) & counter_mask;
+    return (node << 48) | (shard << 40) | counter;
+}
+
 ss::future<response_ptr> init_producer_id_api::process(
   request_context&& ctx, [[maybe_unused]] ss::smp_service_group g) {
-    return ss::do_with(std::move(ctx), [](request_context& ctx) {
-        init_producer_id_request request;
-        request.decode(ctx.reader(), ctx.header().version);
-        return ss::make_exception_future<response_ptr>(std::runtime_error(
-          fmt::format("Unsupported API {}", ctx.header().key)));
-    });
+    init_producer_id_request request;
+    request.decode(ctx.reader(), ctx.header().version);
+
+    init_producer_id_response reply;
+    if (request.data.transactional_id) {
+        // transactions are not supported; idempotence-only producers send
+        // a null transactional id
+        reply.data.error_code = error_code::invalid_request;
+        reply.data.producer_id = producer_id(-1);
+        reply.data.producer_epoch = -1;
+        return ctx.respond(std::move(reply));
+    }
+    reply.data.error_code = error_code::none;
+    reply.data.producer_id = producer_id(next_producer_id());
+    reply.data.producer_epoch = 0;
+    return ctx.respond(std::move(reply));
 }
 
 } // namespace kafka
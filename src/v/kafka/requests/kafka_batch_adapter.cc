@@ -9,15 +9,17 @@
 
 #include "kafka/requests/kafka_batch_adapter.h"
 
-#include "hashing/crc32c.h"
 #include "kafka/requests/request_context.h"
 #include "kafka/requests/request_reader.h"
 #include "likely.h"
 #include "model/record.h"
+#include "model/record_utils.h"
 #include "raft/types.h"
 #include "storage/parser_utils.h"
 #include "vassert.h"
 
+#include <seastar/core/do_with.hh>
+#include <seastar/core/future-util.hh>
 #include <seastar/core/smp.hh>
 
 #include <stdexcept>
@@ -90,41 +92,144 @@ model::record_batch_header kafka_batch_adapter::read_header(iobuf_parser& in) {
     return header;
 }
 
-void kafka_batch_adapter::verify_crc(int32_t expected_crc, iobuf_parser in) {
-    auto crc = crc32();
-
-    // 1. move the cursor to correct endpoint
-    //   - 8 base offset
-    //   - 4 batch length
-    //   - 4 partition leader epoch
-    //   - 1 magic
-    //   - 4 exepcted crc
-    in.skip(21);
-
-    // 2. consume & checksum the CRC
-    in.consume(in.bytes_left(), [&crc](const char* src, size_t n) {
-        // NOLINTNEXTLINE
-        crc.extend(reinterpret_cast<const uint8_t*>(src), n);
-        return ss::stop_iteration::no;
-    });
-
-    // the crc is calculated over the bytes we receive as a uint32_t, but the
-    // crc arrives off the wire as a signed 32-bit value.
-    if (unlikely((uint32_t)expected_crc != crc.value())) {
-        valid_crc = false;
+/**
+ * Structural validation of an uncompressed payload: walk the record length
+ * prefixes without materializing keys, values or headers. Framing errors
+ * surface here; payload integrity is already covered by the crc.
+ */
+static bool
+records_are_well_formed(const iobuf& records, int32_t record_count) {
+    auto in = iobuf_const_parser(records);
+    try {
+        for (int32_t i = 0; i < record_count; ++i) {
+            auto [length, length_size] = in.read_varlong();
+            if (length < 0 || static_cast<size_t>(length) > in.bytes_left()) {
+                return false;
+            }
+            in.skip(length);
+        }
+    } catch (const std::out_of_range&) {
+        return false;
+    }
+    return in.bytes_left() == 0;
+}
+
+// record length prefixes walked per reactor task on the chunked path
+static constexpr int32_t records_validated_per_step = 1024;
+
+static ss::future<bool>
+records_are_well_formed_chunked(const iobuf& records, int32_t record_count) {
+    struct validate_state {
+        validate_state(const iobuf& b, int32_t count)
+          : in(b)
+          , remaining(count) {}
+        iobuf_const_parser in;
+        int32_t remaining;
+        bool ok{true};
+    };
+    return ss::do_with(
+      validate_state(records, record_count), [](validate_state& st) {
+          return ss::repeat([&st] {
+                     try {
+                         const auto step = std::min(
+                           st.remaining, records_validated_per_step);
+                         for (int32_t i = 0; i < step; ++i) {
+                             auto [length, length_size] = st.in.read_varlong();
+                             if (
+                               length < 0
+                               || static_cast<size_t>(length)
+                                    > st.in.bytes_left()) {
+                                 st.ok = false;
+                                 return ss::make_ready_future<
+                                   ss::stop_iteration>(ss::stop_iteration::yes);
+                             }
+                             st.in.skip(length);
+                         }
+                         st.remaining -= step;
+                     } catch (const std::out_of_range&) {
+                         st.ok = false;
+                         return ss::make_ready_future<ss::stop_iteration>(
+                           ss::stop_iteration::yes);
+                     }
+                     if (st.remaining == 0) {
+                         st.ok = st.in.bytes_left() == 0;
+                         return ss::make_ready_future<ss::stop_iteration>(
+                           ss::stop_iteration::yes);
+                     }
+                     return ss::make_ready_future<ss::stop_iteration>(
+                       ss::stop_iteration::no);
+                 })
+            .then([&st] { return st.ok; });
+      });
+}
+
+ss::future<> kafka_batch_adapter::adapt_chunked(iobuf&& kbatch) {
+    auto parser = iobuf_parser(std::move(kbatch));
+
+    auto header = read_header(parser);
+    if (unlikely(!v2_format)) {
         vlog(
           klog.error,
-          "Cannot validate Kafka record batch. Missmatching CRC. Expected:{}, "
-          "Got:{}",
-          expected_crc,
-          crc.value());
-    } else {
-        valid_crc = true;
+          "cann only parse magic.version2 format messages. ignoring");
+        return ss::now();
     }
+
+    auto records_size = header.size_bytes
+                        - model::packed_record_batch_header_size;
+    auto records = parser.share(records_size);
+
+    return ss::do_with(
+      std::move(records), crc32(), [this, header](iobuf& records, crc32& crc) {
+          model::crc_record_batch_header(crc, header);
+          /*
+           * the crc is extended one receive fragment at a time through the
+           * same vectorized kernel as the synchronous path; the loop only
+           * suspends when the reactor wants to preempt, so a batch close
+           * to max_message_bytes spreads over many tasks while a small one
+           * still decodes in a single task.
+           */
+          return ss::do_for_each(
+                   records,
+                   [&crc](const iobuf::fragment& f) {
+                       crc.extend(f.get(), f.size());
+                   })
+            .then([this, header, &records, &crc] {
+                if (unlikely(
+                      header.crc != static_cast<int32_t>(crc.value()))) {
+                    valid_crc = false;
+                    vlog(
+                      klog.error,
+                      "Cannot validate Kafka record batch. Missmatching CRC. "
+                      "Expected:{}, Got:{}",
+                      header.crc,
+                      crc.value());
+                    return ss::now();
+                }
+                valid_crc = true;
+
+                auto verified = ss::make_ready_future<bool>(true);
+                if (header.attrs.compression() == model::compression::none) {
+                    verified = records_are_well_formed_chunked(
+                      records, header.record_count);
+                }
+                return verified.then([this, header, &records](bool ok) {
+                    if (unlikely(!ok)) {
+                        vlog(
+                          klog.error,
+                          "Invalid uncompressed record framing: {}",
+                          header);
+                        return;
+                    }
+                    batch = model::record_batch(
+                      header,
+                      std::move(records),
+                      model::record_batch::tag_ctor_ng{});
+                });
+            });
+      });
 }
 
 void kafka_batch_adapter::adapt(iobuf&& kbatch) {
-    auto crcparser = iobuf_parser(kbatch.share(0, kbatch.size_bytes()));
     auto parser = iobuf_parser(std::move(kbatch));
 
     auto header = read_header(parser);
@@ -135,34 +240,37 @@ void kafka_batch_adapter::adapt(iobuf&& kbatch) {
         return;
     }
 
-    verify_crc(header.crc, std::move(crcparser));
-    if (unlikely(!valid_crc)) {
-        vlog(klog.error, "batch has invlaid CRC: {}", header);
-        return;
-    }
-
     auto records_size = header.size_bytes
                         - model::packed_record_batch_header_size;
     auto records = parser.share(records_size);
 
-    auto new_batch = model::record_batch(
-      header, std::move(records), model::record_batch::tag_ctor_ng{});
-
-    /**
-     * Perform some type of validation on the uncompressed input. In this case
-     * we make sure that the records can be materialized but we avoid
-     * re-encoding them using the lazy-record optimization.
+    /*
+     * validate the crc in place: the checksummed header fields are rebuilt
+     * from the parsed header and the payload is checksummed through the
+     * share, so the receive buffer is traversed once and never copied.
      */
-    if (!new_batch.compressed()) {
-        try {
-            new_batch.for_each_record([](model::record r) { (void)r; });
-        } catch (const std::exception& e) {
-            vlog(klog.error, "Parsing uncompressed records: {}", e.what());
+    auto crc = model::crc_record_batch(header, records);
+    if (unlikely(header.crc != crc)) {
+        valid_crc = false;
+        vlog(
+          klog.error,
+          "Cannot validate Kafka record batch. Missmatching CRC. Expected:{}, "
+          "Got:{}",
+          header.crc,
+          crc);
+        return;
+    }
+    valid_crc = true;
+
+    if (header.attrs.compression() == model::compression::none) {
+        if (unlikely(!records_are_well_formed(records, header.record_count))) {
+            vlog(klog.error, "Invalid uncompressed record framing: {}", header);
             return;
         }
     }
 
-    batch = std::move(new_batch);
+    batch = model::record_batch(
+      header, std::move(records), model::record_batch::tag_ctor_ng{});
 }
 
 } // namespace kafka
@@ -16,6 +16,8 @@
 #include "model/record_batch_reader.h"
 #include "utils/vint.h"
 
+#include <seastar/core/future.hh>
+
 namespace kafka {
 
 namespace internal {
@@ -53,13 +55,21 @@ class kafka_batch_adapter {
 public:
     void adapt(iobuf&&);
 
+    /**
+     * chunked variant of adapt() for payloads that may approach
+     * max_message_bytes: the crc runs incrementally over one receive
+     * fragment at a time and the record framing walk is bounded per step,
+     * yielding to the reactor between chunks. small batches still decode
+     * in a single task since the loops only suspend under preemption.
+     */
+    ss::future<> adapt_chunked(iobuf&&);
+
     bool v2_format;
     bool valid_crc;
 
     std::optional<model::record_batch> batch;
 
 private:
-    void verify_crc(int32_t, iobuf_parser);
     model::record_batch_header read_header(iobuf_parser&);
 };
 
@@ -13,6 +13,7 @@
 #include "kafka/groups/group_router.h"
 #include "kafka/requests/request_context.h"
 #include "kafka/requests/response.h"
+#include "likely.h"
 #include "utils/remote.h"
 #include "utils/to_string.h"
 
@@ -34,6 +35,12 @@ ss::future<response_ptr> leave_group_api::process(
           return ctx.groups()
             .leave_group(std::move(request))
             .then([&ctx](leave_group_response&& reply) {
+                if (unlikely(reply.data.error_code != error_code::none)) {
+                    // rejections are served from the pre-serialized
+                    // template cache
+                    return ctx.respond_error<leave_group_response>(
+                      reply.data.error_code);
+                }
                 auto resp = std::make_unique<response>();
                 reply.encode(ctx, *resp.get());
                 return ss::make_ready_future<response_ptr>(std::move(resp));
@@ -136,7 +136,9 @@ static ss::future<list_offset_partition_response> list_offsets_partition(
 
 static ss::future<list_offset_topic_response>
 list_offsets_topic(list_offsets_ctx& octx, list_offset_topic& topic) {
-    std::vector<ss::future<list_offset_partition_response>> partitions;
+    // per-request fan-out scratch comes from the context arena
+    std::pmr::vector<ss::future<list_offset_partition_response>> partitions{
+      &octx.rctx.scratch()};
     partitions.reserve(topic.partitions.size());
 
     for (auto& part : topic.partitions) {
@@ -174,9 +176,10 @@ list_offsets_topic(list_offsets_ctx& octx, list_offset_topic& topic) {
       });
 }
 
-static std::vector<ss::future<list_offset_topic_response>>
+static std::pmr::vector<ss::future<list_offset_topic_response>>
 list_offsets_topics(list_offsets_ctx& octx) {
-    std::vector<ss::future<list_offset_topic_response>> topics;
+    std::pmr::vector<ss::future<list_offset_topic_response>> topics{
+      &octx.rctx.scratch()};
     topics.reserve(octx.request.data.topics.size());
 
     for (auto& topic : octx.request.data.topics) {
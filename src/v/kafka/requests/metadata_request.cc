@@ -13,17 +13,25 @@
 #include "cluster/topics_frontend.h"
 #include "cluster/types.h"
 #include "config/configuration.h"
+#include "hashing/xx.h"
 #include "kafka/errors.h"
+#include "kafka/logger.h"
 #include "kafka/requests/topics/topic_utils.h"
 #include "likely.h"
 #include "model/metadata.h"
 #include "utils/to_string.h"
+#include "vlog.h"
 
 #include <seastar/core/future-util.hh>
 #include <seastar/core/thread.hh>
 
+#include <absl/container/flat_hash_map.h>
+
 #include <fmt/ostream.h>
 
+#include <array>
+#include <limits>
+
 namespace kafka {
 
 void metadata_request::decode(request_context& ctx) {
@@ -74,8 +82,20 @@ std::ostream& operator<<(std::ostream& o, const metadata_request& r) {
 }
 
 void metadata_response::encode(const request_context& ctx, response& resp) {
+    encode_head(ctx, resp);
+    encode_tail(ctx, resp);
+}
+
+void metadata_response::encode_head(const request_context& ctx, response& resp) {
+    encode_head(ctx.header().version, resp);
+}
+
+void metadata_response::encode_tail(const request_context& ctx, response& resp) {
+    encode_tail(ctx.header().version, resp);
+}
+
+void metadata_response::encode_head(api_version version, response& resp) {
     auto& writer = resp.writer();
-    auto version = ctx.header().version;
 
     if (version >= api_version(3)) {
         writer.write(int32_t(throttle_time.count()));
@@ -90,6 +110,11 @@ void metadata_response::encode(const request_context& ctx, response& resp) {
               rw.write(b.rack);
           }
       });
+}
+
+void metadata_response::encode_tail(api_version version, response& resp) {
+    auto& writer = resp.writer();
+
     // cluster id
     if (version >= api_version(2)) {
         writer.write(cluster_id);
@@ -405,24 +430,164 @@ get_topic_metadata(request_context& ctx, metadata_request& request) {
       });
 }
 
+/**
+ * Per-shard cache of the serialized full-listing response tail (cluster
+ * and controller ids plus the topic listing).
+ *
+ * Clients refresh metadata aggressively and the full topic listing dominates
+ * the serialization cost. The encoded tail is cached per api version and
+ * invalidated with the metadata cache version counter, which is bumped on
+ * every topic, broker or leadership change on this shard. A steady state
+ * metadata request then only encodes the small per-client broker head and
+ * shares the cached buffer into the response instead of rebuilding and
+ * re-encoding the listing.
+ */
+struct serialized_metadata_entry {
+    uint64_t version;
+    iobuf body;
+};
+static thread_local absl::
+  flat_hash_map<int16_t, serialized_metadata_entry>
+    serialized_metadata_cache;
+
+/*
+ * Weighted per-client broker ordering.
+ *
+ * Clients connect to a bootstrap broker and then follow metadata, and
+ * many walk the returned broker list in order, so the listing doubles as
+ * a cheap server-side balancer. Rendezvous hashing over (client id,
+ * broker) gives every client a stable pseudo-random preference,
+ * spreading new connections uniformly instead of piling onto list order.
+ * The local broker is the only one whose load this shard observes; its
+ * weight is scaled by the headroom left by the shard load score and the
+ * open connection count, so a loaded broker sinks in the lists it hands
+ * out and steers new connections toward its peers.
+ */
+static void order_brokers_for_client(
+  std::optional<std::string_view> client_id,
+  uint32_t shard_connections,
+  double load_score,
+  std::vector<metadata_response::broker>& brokers) {
+    if (brokers.size() < 2) {
+        return;
+    }
+    // connection pressure on a shard saturates the weight at this count
+    static constexpr double max_connections = 2048.0;
+    const double conn_pressure = std::min(
+      shard_connections / max_connections, 1.0);
+    const double headroom = (1.0 - load_score) * (1.0 - conn_pressure);
+    const uint64_t seed = client_id
+                            ? xxhash_64(client_id->data(), client_id->size())
+                            : 0;
+    const auto self = model::node_id(config::shard_local_cfg().node_id());
+    auto weight = [seed, self, headroom](const metadata_response::broker& b) {
+        std::array<uint64_t, 2> key{seed, uint64_t(b.node_id())};
+        auto w = double(xxhash_64(key))
+                 / double(std::numeric_limits<uint64_t>::max());
+        if (b.node_id == self) {
+            w *= headroom;
+        }
+        return w;
+    };
+    std::sort(
+      brokers.begin(),
+      brokers.end(),
+      [&weight](
+        const metadata_response::broker& a,
+        const metadata_response::broker& b) { return weight(a) > weight(b); });
+}
+
+static std::vector<metadata_response::broker>
+make_broker_listing(cluster::metadata_cache& md_cache) {
+    auto brokers = md_cache.all_brokers();
+    std::vector<metadata_response::broker> listing;
+    listing.reserve(brokers.size());
+    std::transform(
+      brokers.begin(),
+      brokers.end(),
+      std::back_inserter(listing),
+      [](cluster::broker_ptr b) {
+          return metadata_response::broker{
+            .node_id = b->id(),
+            .host = b->kafka_api_address().host(),
+            .port = b->kafka_api_address().port(),
+            .rack = b->rack()};
+      });
+    return listing;
+}
+
+std::optional<response_ptr> metadata_api::handshake_response(
+  const request_header& hdr,
+  iobuf& body,
+  cluster::metadata_cache& md_cache,
+  quota_manager& quota_mgr,
+  uint32_t shard_connections) {
+    if (hdr.version < min_supported || hdr.version > max_supported) {
+        return std::nullopt;
+    }
+    auto it = serialized_metadata_cache.find(hdr.version());
+    if (
+      it == serialized_metadata_cache.end()
+      || it->second.version != md_cache.version()) {
+        // no fresh snapshot for this version; the slow path rebuilds it
+        return std::nullopt;
+    }
+    /*
+     * only a full listing is served from the snapshot. the check mirrors
+     * metadata_request::decode but reads a share of the body, so a
+     * request naming specific topics falls through to the slow path with
+     * its buffer intact.
+     */
+    request_reader reader(body.share(0, body.size_bytes()));
+    auto topics = reader.read_nullable_array(
+      [](request_reader& r) { return model::topic(r.read_string()); });
+    const bool list_all = hdr.version > api_version(0) ? !topics
+                                                       : topics->empty();
+    if (!list_all) {
+        return std::nullopt;
+    }
+    metadata_response reply;
+    reply.brokers = make_broker_listing(md_cache);
+    order_brokers_for_client(
+      hdr.client_id, shard_connections, quota_mgr.load_score(), reply.brokers);
+    auto resp = std::make_unique<response>();
+    reply.encode_head(hdr.version, *resp.get());
+    resp->buf().append(it->second.body.share(0, it->second.body.size_bytes()));
+    return response_ptr(std::move(resp));
+}
+
 ss::future<response_ptr> metadata_api::process(
   request_context&& ctx, [[maybe_unused]] ss::smp_service_group g) {
     return ss::do_with(
       std::move(ctx),
       metadata_response{},
       [](request_context& ctx, metadata_response& reply) {
-          auto brokers = ctx.metadata_cache().all_brokers();
-          std::transform(
-            brokers.begin(),
-            brokers.end(),
-            std::back_inserter(reply.brokers),
-            [](cluster::broker_ptr b) {
-                return metadata_response::broker{
-                  .node_id = b->id(),
-                  .host = b->kafka_api_address().host(),
-                  .port = b->kafka_api_address().port(),
-                  .rack = b->rack()};
-            });
+          metadata_request request;
+          request.decode(ctx);
+
+          reply.brokers = make_broker_listing(ctx.metadata_cache());
+          order_brokers_for_client(
+            ctx.header().client_id,
+            ctx.shard_connections(),
+            ctx.quota_mgr().load_score(),
+            reply.brokers);
+
+          // only the full-listing tail is cacheable; requests for
+          // specific topics may trigger topic auto-creation, and the
+          // broker head is ordered per client anyway
+          const auto cache_version = ctx.metadata_cache().version();
+          const auto api_ver = ctx.header().version;
+          if (request.list_all_topics) {
+              if (auto it = serialized_metadata_cache.find(api_ver());
+                  it != serialized_metadata_cache.end()
+                  && it->second.version == cache_version) {
+                  auto resp = std::make_unique<response>();
+                  reply.encode_head(ctx, *resp.get());
+                  resp->buf().append(
+                    it->second.body.share(0, it->second.body.size_bytes()));
+                  return ss::make_ready_future<response_ptr>(std::move(resp));
+              }
+          }
 
           // FIXME:  #95 Cluster Id
           reply.cluster_id = std::nullopt;
@@ -430,13 +595,34 @@ ss::future<response_ptr> metadata_api::process(
           auto leader_id = ctx.metadata_cache().get_controller_leader_id();
           reply.controller_id = leader_id.value_or(model::node_id(-1));
 
-          metadata_request request;
-          request.decode(ctx);
+          const bool cacheable = request.list_all_topics;
           return get_topic_metadata(ctx, request)
             .then([&reply](std::vector<metadata_response::topic> topics) {
                 reply.topics = std::move(topics);
             })
-            .then([&ctx, &reply] { return ctx.respond(std::move(reply)); });
+            .then([&ctx, &reply, cacheable, cache_version, api_ver] {
+                vlog(klog.trace, "sending metadata response {}", reply);
+                auto resp = std::make_unique<response>();
+                reply.encode_head(ctx, *resp.get());
+                const auto head_size = resp->buf().size_bytes();
+                reply.encode_tail(ctx, *resp.get());
+                if (cacheable) {
+                    /*
+                     * the cached tail shares the response fragments; the
+                     * version was sampled before the listing was built so
+                     * a concurrent state change invalidates the entry
+                     * conservatively
+                     */
+                    auto& buf = resp->buf();
+                    serialized_metadata_cache[api_ver()]
+                      = serialized_metadata_entry{
+                        .version = cache_version,
+                        .body = buf.share(
+                          head_size, buf.size_bytes() - head_size),
+                      };
+                }
+                return ss::make_ready_future<response_ptr>(std::move(resp));
+            });
       });
 }
 
@@ -20,8 +20,13 @@
 
 #include <chrono>
 
+namespace cluster {
+class metadata_cache;
+} // namespace cluster
+
 namespace kafka {
 
+class quota_manager;
 struct metadata_response;
 
 struct metadata_api final {
@@ -34,6 +39,17 @@ struct metadata_api final {
 
     static ss::future<response_ptr>
     process(request_context&&, ss::smp_service_group);
+
+    /// handshake fast path: answer a full-listing request from the
+    /// per-shard serialized snapshot without building a request context.
+    /// disengaged (nullopt) when the snapshot is stale, the version is
+    /// out of bounds or the request names specific topics
+    static std::optional<response_ptr> handshake_response(
+      const request_header& hdr,
+      iobuf& body,
+      cluster::metadata_cache& md_cache,
+      quota_manager& quota_mgr,
+      uint32_t shard_connections);
 };
 
 struct metadata_request {
@@ -95,6 +111,18 @@ struct metadata_response {
 
     void encode(const request_context& ctx, response& resp);
     void decode(iobuf buf, api_version version);
+
+    /*
+     * the response body is encoded in two halves so that the broker list
+     * (head) can be ordered per client while the topic listing (tail) is
+     * served from the per-shard serialized cache. both halves depend
+     * only on the api version, so the handshake fast path can encode
+     * them without a request context
+     */
+    void encode_head(api_version version, response& resp);
+    void encode_tail(api_version version, response& resp);
+    void encode_head(const request_context& ctx, response& resp);
+    void encode_tail(const request_context& ctx, response& resp);
 };
 
 std::ostream& operator<<(std::ostream&, const metadata_response&);
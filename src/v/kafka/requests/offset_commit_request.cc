@@ -72,13 +72,10 @@ offset_commit_api::process(request_context&& ctx, ss::smp_service_group ssg) {
      * in order to deal with this we filter out nonexistent topic-partitions,
      * and pass those that exist on to the group membership layer.
      *
-     * TODO: the filtering is expensive for large requests. there are two things
-     * that can be done to speed this up. first, the metadata cache should
-     * provide an interface for efficiently searching for topic-partitions.
-     * second, the code generator should be extended to allow the generated
-     * structures to contain extra fields. in this case, we could introduce a
-     * flag to mark topic-partitions to be ignored by the group membership
-     * subsystem.
+     * TODO: the filtering is expensive for large requests. to speed this up
+     * the code generator should be extended to allow the generated structures
+     * to contain extra fields. in this case, we could introduce a flag to mark
+     * topic-partitions to be ignored by the group membership subsystem.
      */
     for (auto it = octx.request.data.topics.begin();
          it != octx.request.data.topics.end();) {
@@ -88,21 +85,16 @@ offset_commit_api::process(request_context&& ctx, ss::smp_service_group ssg) {
         const auto topic_name = model::topic(it->name);
         model::topic_namespace_view tn(cluster::kafka_namespace, topic_name);
 
-        if (const auto& md = octx.rctx.metadata_cache().get_topic_metadata(tn);
-            md) {
+        if (octx.rctx.metadata_cache().contains(tn)) {
             /*
              * check if each partition exists
              */
             auto split = std::partition(
               it->partitions.begin(),
               it->partitions.end(),
-              [&md](const offset_commit_request_partition& p) {
-                  return std::any_of(
-                    md->partitions.cbegin(),
-                    md->partitions.cend(),
-                    [&p](const model::partition_metadata& pmd) {
-                        return pmd.id == p.partition_index;
-                    });
+              [&octx, &tn](const offset_commit_request_partition& p) {
+                  return octx.rctx.metadata_cache().contains(
+                    tn, p.partition_index);
               });
             /*
              * build responses for nonexistent topic partitions
@@ -13,15 +13,23 @@
 #include "cluster/metadata_cache.h"
 #include "cluster/namespace.h"
 #include "cluster/partition_manager.h"
+#include "config/configuration.h"
+#include "kafka/batch_dedup_cache.h"
 #include "kafka/errors.h"
+#include "kafka/produce_coalescer.h"
+#include "kafka/producer_state.h"
 #include "kafka/requests/kafka_batch_adapter.h"
 #include "kafka/requests/response_writer_utils.h"
 #include "likely.h"
+#include "model/compression.h"
 #include "model/fundamental.h"
 #include "model/metadata.h"
 #include "model/record_batch_reader.h"
+#include "model/record_utils.h"
 #include "model/timestamp.h"
 #include "raft/types.h"
+#include "ssx/future-util.h"
+#include "storage/parser_utils.h"
 #include "storage/shard_assignment.h"
 #include "utils/remote.h"
 #include "utils/to_string.h"
@@ -53,10 +61,18 @@ void produce_request::encode(response_writer& writer, api_version) {
     });
 }
 
-void produce_request::decode(request_context& ctx) {
+void produce_request::on_adapted(const kafka_batch_adapter& adapter) {
+    if (adapter.batch) {
+        const auto& hdr = adapter.batch->header();
+        has_transactional = has_transactional || hdr.attrs.is_transactional();
+        has_idempotent = has_idempotent || hdr.producer_id >= 0;
+    }
+}
+
+void produce_request::decode_fields(request_context& ctx) {
     auto& reader = ctx.reader();
 
-    transactional_id = reader.read_nullable_string();
+    transactional_id = reader.read_nullable_string_view();
     acks = reader.read_int16();
     timeout = std::chrono::milliseconds(reader.read_int32());
     topics = reader.read_array([](request_reader& reader) {
@@ -70,22 +86,45 @@ void produce_request::decode(request_context& ctx) {
           }),
         };
     });
+}
+
+void produce_request::decode(request_context& ctx) {
+    decode_fields(ctx);
 
     for (auto& topic : topics) {
         for (auto& part : topic.partitions) {
             if (part.data) {
                 part.adapter.adapt(std::move(part.data.value()));
-                if (part.adapter.batch) {
-                    const auto& hdr = part.adapter.batch->header();
-                    has_transactional = has_transactional
-                                        || hdr.attrs.is_transactional();
-                    has_idempotent = has_idempotent || hdr.producer_id >= 0;
-                }
+                on_adapted(part.adapter);
             }
         }
     }
 }
 
+ss::future<produce_request>
+produce_request::decode_chunked(request_context& ctx) {
+    produce_request request;
+    request.decode_fields(ctx);
+    return ss::do_with(std::move(request), [](produce_request& request) {
+        return ss::do_for_each(
+                 request.topics,
+                 [&request](topic& t) {
+                     return ss::do_for_each(
+                       t.partitions, [&request](partition& part) {
+                           if (!part.data) {
+                               return ss::now();
+                           }
+                           return part.adapter
+                             .adapt_chunked(std::move(part.data.value()))
+                             .then([&request, &part] {
+                                 request.on_adapted(part.adapter);
+                             });
+                       });
+                 })
+          .then([&request] { return std::move(request); });
+    });
+}
+
 produce_response produce_request::make_error_response(error_code error) const {
     produce_response response;
 
@@ -214,6 +253,10 @@ struct produce_ctx {
     request_context rctx;
     produce_request request;
     produce_response response;
+    // largest replication pressure hint reported by the shards this request
+    // produced to; surfaced as throttle_time_ms and fed back to the
+    // connection's admission control
+    std::chrono::milliseconds pressure{0};
     ss::smp_service_group ssg;
 
     produce_ctx(
@@ -255,14 +298,28 @@ reader_from_lcore_batch(model::record_batch&& batch) {
  * batch is being deserialized (see reader_from_kafka_batch).
  */
 static ss::future<produce_response::partition> partition_append(
-  model::partition_id id,
+  const model::ntp& ntp,
   ss::lw_shared_ptr<cluster::partition> partition,
   model::record_batch_reader reader,
   int16_t acks,
   int32_t num_records) {
-    return partition
-      ->replicate(std::move(reader), acks_to_replicate_options(acks))
-      .then_wrapped([partition, id, num_records = num_records](
+    auto id = ntp.tp.partition;
+    /*
+     * when coalescing is enabled the batch is staged on this shard and
+     * replicated together with batches other connections produce to the
+     * partition within the window; the resolved result is this batch's
+     * slice of the merged round, so the offset math below is unchanged
+     */
+    auto window = config::shard_local_cfg().kafka_produce_coalesce_window_us();
+    auto f = window > std::chrono::microseconds(0)
+               ? produce_coalescers().get(ntp).append(
+                 partition,
+                 std::move(reader),
+                 acks_to_replicate_options(acks),
+                 window)
+               : partition->replicate(
+                 std::move(reader), acks_to_replicate_options(acks));
+    return std::move(f).then_wrapped([partition, id, num_records = num_records](
                       ss::future<result<raft::replicate_result>> f) {
           produce_response::partition p{.id = id};
           try {
@@ -285,146 +342,409 @@ static ss::future<produce_response::partition> partition_append(
 }
 
 /**
- * \brief handle writing to a single topic partition.
+ * A single decoded batch bound for a partition. A shard receives its whole
+ * slice of the produce plan in one cross-core dispatch instead of one hop
+ * per partition.
  */
-static ss::future<produce_response::partition> produce_topic_partition(
-  produce_ctx& octx,
-  produce_request::topic& topic,
-  produce_request::partition& part) {
-    auto ntp = model::ntp(cluster::kafka_namespace, topic.name, part.id);
+struct partition_produce_unit {
+    model::ntp ntp;
+    model::record_batch_reader reader;
+    int32_t num_records;
+    // idempotent producer window of the batch, producer_id < 0 when the
+    // producer is not idempotent
+    int64_t producer_id{-1};
+    int16_t producer_epoch{-1};
+    int32_t first_sequence{-1};
+    int32_t last_sequence{-1};
+    // content fingerprint for the recent-batch dedup shield, only
+    // computed when kafka_produce_dedup_window_ms is set
+    std::optional<uint64_t> fingerprint;
+};
 
-    /*
-     * A single produce request may contain record batches for many
-     * different partitions that are managed different cores.
-     */
-    auto shard = octx.rctx.shards().shard_for(ntp);
+/**
+ * A batch staged on the handling core before dispatch. The foreign reader
+ * is built only after the topic's storage codec policy has been applied, so
+ * the shipped batch reflects exactly what will be written to the log.
+ */
+struct staged_produce_unit {
+    model::ntp ntp;
+    model::record_batch batch;
+    std::optional<model::compression> target_compression;
+};
 
-    if (!shard) {
-        return ss::make_ready_future<produce_response::partition>(
-          produce_response::partition{
-            .id = ntp.tp.partition,
-            .error = error_code::unknown_topic_or_partition});
-    }
+struct shard_produce_batch {
+    std::vector<staged_produce_unit> staged;
+    // (topic, partition) response slots, same order as staged units
+    std::vector<std::pair<size_t, size_t>> slots;
+};
 
-    // steal the batch from the adapter
-    auto batch = std::move(part.adapter.batch.value());
-    /*
-     * grab timestamp type topic configuration option out of the
-     * metadata cache. For append time setting we have to recalculate
-     * the CRC.
-     */
-    auto timestamp_type = octx.rctx.metadata_cache().get_topic_timestamp_type(
-      model::topic_namespace_view(cluster::kafka_namespace, topic.name));
-
-    if (timestamp_type == model::timestamp_type::append_time) {
-        auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
-          ss::lowres_clock::now().time_since_epoch());
-        batch.set_max_timestamp(
-          model::timestamp_type::append_time, model::timestamp(now.count()));
+/**
+ * \brief Apply the topic's storage codec to a produced batch.
+ *
+ * Mirrors kafka's topic level compression.type: a topic without a
+ * configured codec stores whatever the producer sent, otherwise the batch
+ * is transcoded (decompressed with the producer codec, recompressed with
+ * the topic codec) before it is replicated.
+ */
+static ss::future<model::record_batch> maybe_recompress_batch(
+  model::record_batch&& batch, std::optional<model::compression> target) {
+    if (!target || batch.header().attrs.compression() == *target) {
+        return ss::make_ready_future<model::record_batch>(std::move(batch));
     }
-
-    auto num_records = batch.record_count();
-    auto reader = reader_from_lcore_batch(std::move(batch));
-
-    return octx.rctx.partition_manager().invoke_on(
-      *shard,
-      octx.ssg,
-      [reader = std::move(reader),
-       ntp = std::move(ntp),
-       num_records,
-       acks = octx.request.acks](cluster::partition_manager& mgr) mutable {
-          auto partition = mgr.get(ntp);
-          if (!partition) {
-              return ss::make_ready_future<produce_response::partition>(
-                produce_response::partition{
-                  .id = ntp.tp.partition,
-                  .error = error_code::unknown_topic_or_partition});
-          }
-          if (unlikely(!partition->is_leader())) {
-              return ss::make_ready_future<produce_response::partition>(
-                produce_response::partition{
-                  .id = ntp.tp.partition,
-                  .error = error_code::not_leader_for_partition});
-          }
-          return partition_append(
-            ntp.tp.partition, partition, std::move(reader), acks, num_records);
-      });
+    auto f = batch.compressed()
+               ? storage::internal::decompress_batch(std::move(batch))
+               : ss::make_ready_future<model::record_batch>(std::move(batch));
+    return f.then([target](model::record_batch b) {
+        if (*target == model::compression::none) {
+            return ss::make_ready_future<model::record_batch>(std::move(b));
+        }
+        return storage::internal::compress_batch(*target, std::move(b));
+    });
 }
 
 /**
- * \brief Dispatch and collect topic partition produce responses
+ * \brief Group decoded batches by the shard owning their partition.
+ *
+ * The response is pre-built so that validation errors are recorded
+ * directly in their slots and shard results can be scattered back without
+ * reassembling the topic structure.
  */
-static ss::future<produce_response::topic>
-produce_topic(produce_ctx& octx, produce_request::topic& topic) {
-    std::vector<ss::future<produce_response::partition>> partitions;
-    partitions.reserve(topic.partitions.size());
-
-    for (auto& part : topic.partitions) {
-        if (!octx.rctx.metadata_cache().contains(
-              model::topic_namespace_view(cluster::kafka_namespace, topic.name),
-              part.id)) {
-            partitions.push_back(
-              ss::make_ready_future<produce_response::partition>(
-                produce_response::partition{
-                  .id = part.id,
-                  .error = error_code::unknown_topic_or_partition}));
-            continue;
-        }
+static std::vector<shard_produce_batch>
+group_produce_by_shard(produce_ctx& octx) {
+    std::vector<shard_produce_batch> batches(ss::smp::count);
+    octx.response.topics.reserve(octx.request.topics.size());
+
+    for (size_t t_ix = 0; t_ix < octx.request.topics.size(); ++t_ix) {
+        auto& topic = octx.request.topics[t_ix];
+        auto& t_resp = octx.response.topics.emplace_back();
+        t_resp.name = topic.name;
+        t_resp.partitions.reserve(topic.partitions.size());
+
+        for (size_t p_ix = 0; p_ix < topic.partitions.size(); ++p_ix) {
+            auto& part = topic.partitions[p_ix];
+            auto& p_resp = t_resp.partitions.emplace_back(
+              produce_response::partition{
+                .id = part.id, .error = error_code::none});
+
+            if (!octx.rctx.metadata_cache().contains(
+                  model::topic_namespace_view(
+                    cluster::kafka_namespace, topic.name),
+                  part.id)) {
+                p_resp.error = error_code::unknown_topic_or_partition;
+                continue;
+            }
 
-        if (unlikely(!part.adapter.valid_crc)) {
-            partitions.push_back(
-              ss::make_ready_future<produce_response::partition>(
-                produce_response::partition{
-                  .id = part.id, .error = error_code::corrupt_message}));
-            continue;
-        }
+            if (unlikely(!part.adapter.valid_crc)) {
+                p_resp.error = error_code::corrupt_message;
+                continue;
+            }
 
-        // produce version >= 3 (enforced for all produce requests)
-        // requires exactly one record batch per request and it must use
-        // the v2 format.
-        if (unlikely(!part.adapter.v2_format || !part.adapter.batch)) {
-            partitions.push_back(
-              ss::make_ready_future<produce_response::partition>(
-                produce_response::partition{
-                  .id = part.id, .error = error_code::invalid_record}));
-            continue;
+            // produce version >= 3 (enforced for all produce requests)
+            // requires exactly one record batch per request and it must use
+            // the v2 format.
+            if (unlikely(!part.adapter.v2_format || !part.adapter.batch)) {
+                p_resp.error = error_code::invalid_record;
+                continue;
+            }
+
+            auto ntp = model::ntp(
+              cluster::kafka_namespace, topic.name, part.id);
+            auto shard = octx.rctx.shards().shard_for(ntp);
+            if (!shard) {
+                p_resp.error = error_code::unknown_topic_or_partition;
+                continue;
+            }
+
+            // steal the batch from the adapter
+            auto batch = std::move(part.adapter.batch.value());
+            /*
+             * grab timestamp type topic configuration option out of the
+             * metadata cache. For append time setting we have to recalculate
+             * the CRC.
+             */
+            auto timestamp_type
+              = octx.rctx.metadata_cache().get_topic_timestamp_type(
+                model::topic_namespace_view(
+                  cluster::kafka_namespace, topic.name));
+
+            if (timestamp_type == model::timestamp_type::append_time) {
+                auto now
+                  = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    ss::lowres_clock::now().time_since_epoch());
+                batch.set_max_timestamp(
+                  model::timestamp_type::append_time,
+                  model::timestamp(now.count()));
+            }
+
+            auto target_compression
+              = octx.rctx.metadata_cache().get_topic_compression(
+                model::topic_namespace_view(
+                  cluster::kafka_namespace, topic.name));
+
+            batches[*shard].staged.push_back(staged_produce_unit{
+              .ntp = std::move(ntp),
+              .batch = std::move(batch),
+              .target_compression = target_compression,
+            });
+            batches[*shard].slots.emplace_back(t_ix, p_ix);
         }
+    }
+
+    return batches;
+}
+
+/**
+ * Results of one shard's slice of the produce plan, plus the replication
+ * pressure observed on that shard while executing it.
+ */
+struct shard_produce_result {
+    std::vector<produce_response::partition> partitions;
+    std::chrono::milliseconds pressure{0};
+};
 
-        auto pr = produce_topic_partition(octx, topic, part);
-        partitions.push_back(std::move(pr));
+/**
+ * \brief Translate a partition's replication backlog into a throttle hint.
+ *
+ * Two signals are combined: the byte budget of the group's replicate
+ * batcher (queue depth) and the number of entries appended to the leader
+ * log but not yet committed by a quorum (replication lag). Either one
+ * saturating means new writes will sit in queues until they time out, so
+ * the hint starts at the watermark and grows linearly to the cap.
+ */
+static std::chrono::milliseconds
+replicate_pressure_delay(const ss::lw_shared_ptr<cluster::partition>& p) {
+    constexpr double watermark = 0.5;
+    constexpr int64_t max_uncommitted_entries = 32768;
+    constexpr auto max_delay = std::chrono::milliseconds(300);
+
+    const double queue = p->replicate_batcher_usage();
+    const double lag = std::min(
+      static_cast<double>(p->dirty_offset() - p->committed_offset())
+        / static_cast<double>(max_uncommitted_entries),
+      1.0);
+    const double pressure = std::max(queue, lag);
+    if (pressure <= watermark) {
+        return std::chrono::milliseconds(0);
     }
+    return std::chrono::milliseconds(static_cast<int64_t>(
+      max_delay.count() * ((pressure - watermark) / (1.0 - watermark))));
+}
 
-    // collect partition responses and build the topic response
-    return when_all_succeed(partitions.begin(), partitions.end())
-      .then([name = std::move(topic.name)](
-              std::vector<produce_response::partition> parts) mutable {
-          return produce_response::topic{
-            .name = std::move(name),
-            .partitions = std::move(parts),
-          };
+/**
+ * \brief Execute a shard's slice of the produce plan. Runs on the shard
+ * owning the partitions. Appends for individual partitions proceed
+ * concurrently and results are returned in plan order.
+ */
+static ss::future<shard_produce_result> produce_on_shard(
+  cluster::partition_manager& mgr,
+  std::vector<partition_produce_unit> units,
+  int16_t acks) {
+    // sample replication pressure before the appends below add to it
+    auto pressure = std::chrono::milliseconds(0);
+    for (auto& unit : units) {
+        if (auto p = mgr.get(unit.ntp); p && p->is_leader()) {
+            pressure = std::max(pressure, replicate_pressure_delay(p));
+        }
+    }
+    return ssx::parallel_transform(
+             std::move(units),
+             [&mgr, acks](partition_produce_unit unit) {
+                 auto partition = mgr.get(unit.ntp);
+                 if (!partition) {
+                     return ss::make_ready_future<produce_response::partition>(
+                       produce_response::partition{
+                         .id = unit.ntp.tp.partition,
+                         .error = error_code::unknown_topic_or_partition});
+                 }
+                 if (unlikely(!partition->is_leader())) {
+                     return ss::make_ready_future<produce_response::partition>(
+                       produce_response::partition{
+                         .id = unit.ntp.tp.partition,
+                         .error = error_code::not_leader_for_partition});
+                 }
+                 auto id = unit.ntp.tp.partition;
+                 /*
+                  * recent-batch dedup shield: a batch whose content
+                  * fingerprint was written within the configured window
+                  * is acknowledged without replicating it again. the ack
+                  * carries base_offset -1 since the original write's
+                  * offset is not retained.
+                  */
+                 if (unit.fingerprint) {
+                     auto window = config::shard_local_cfg()
+                                     .kafka_produce_dedup_window_ms();
+                     auto& cache = batch_dedups().get(unit.ntp);
+                     if (cache.seen(*unit.fingerprint, window)) {
+                         return ss::make_ready_future<
+                           produce_response::partition>(
+                           produce_response::partition{
+                             .id = id, .error = error_code::none});
+                     }
+                 }
+                 // remember the fingerprint only once the write is
+                 // acknowledged, so a failed write is retryable
+                 auto record_write = [fp = unit.fingerprint, ntp = unit.ntp](
+                                       produce_response::partition p) {
+                     if (fp && p.error == error_code::none) {
+                         batch_dedups().get(ntp).add(*fp);
+                     }
+                     return p;
+                 };
+                 if (unit.producer_id < 0) {
+                     return partition_append(
+                              unit.ntp,
+                              partition,
+                              std::move(unit.reader),
+                              acks,
+                              unit.num_records)
+                       .then(std::move(record_write));
+                 }
+                 /*
+                  * idempotent batch: one O(1) probe of the partition's
+                  * producer table admits or rejects the sequence window.
+                  * duplicates are reported with their own error code; the
+                  * client treats it as an already-acknowledged write.
+                  */
+                 auto& table = producer_states().get(unit.ntp);
+                 auto check = table.check_and_advance(
+                   unit.producer_id,
+                   unit.producer_epoch,
+                   unit.first_sequence,
+                   unit.last_sequence);
+                 using sequence_check = producer_state_table::sequence_check;
+                 auto reject = [id](error_code ec) {
+                     return ss::make_ready_future<produce_response::partition>(
+                       produce_response::partition{.id = id, .error = ec});
+                 };
+                 switch (check.outcome) {
+                 case sequence_check::duplicate:
+                     return reject(error_code::duplicate_sequence_number);
+                 case sequence_check::out_of_order:
+                     return reject(error_code::out_of_order_sequence_number);
+                 case sequence_check::stale_epoch:
+                     return reject(error_code::invalid_producer_epoch);
+                 case sequence_check::accept:
+                     break;
+                 }
+                 auto pid = unit.producer_id;
+                 auto ntp = unit.ntp;
+                 return partition_append(
+                          unit.ntp,
+                          partition,
+                          std::move(unit.reader),
+                          acks,
+                          unit.num_records)
+                   .then([pid, check, ntp = std::move(ntp)](
+                           produce_response::partition p) {
+                       if (unlikely(p.error != error_code::none)) {
+                           // undo the optimistic advance so the client's
+                           // retry of this window is admitted
+                           producer_states().get(ntp).rollback(pid, check);
+                       }
+                       return p;
+                   })
+                   .then(std::move(record_write));
+             })
+      .then([pressure](std::vector<produce_response::partition> partitions) {
+          return shard_produce_result{
+            .partitions = std::move(partitions), .pressure = pressure};
       });
 }
 
 /**
- * \brief Dispatch and collect topic produce responses
+ * \brief Dispatch the produce plan, one cross-core hop per shard.
  */
-static std::vector<ss::future<produce_response::topic>>
-produce_topics(produce_ctx& octx) {
-    std::vector<ss::future<produce_response::topic>> topics;
-    topics.reserve(octx.request.topics.size());
-
-    for (auto& topic : octx.request.topics) {
-        auto tr = produce_topic(octx, topic);
-        topics.push_back(std::move(tr));
+static std::vector<ss::future<>> dispatch_produce(produce_ctx& octx) {
+    auto plan = group_produce_by_shard(octx);
+
+    std::vector<ss::future<>> dispatches;
+    dispatches.reserve(plan.size());
+
+    for (ss::shard_id shard = 0; shard < plan.size(); ++shard) {
+        auto& batch = plan[shard];
+        if (batch.staged.empty()) {
+            continue;
+        }
+        // apply the storage codec policy on the handling core, then ship the
+        // shard's slice of the plan in a single cross-core hop
+        auto f = ssx::parallel_transform(
+                   std::move(batch.staged),
+                   [](staged_produce_unit unit) {
+                       return maybe_recompress_batch(
+                                std::move(unit.batch), unit.target_compression)
+                         .then([ntp = std::move(unit.ntp)](
+                                 model::record_batch b) mutable {
+                             auto num_records = b.record_count();
+                             const auto& hdr = b.header();
+                             auto pid = hdr.producer_id;
+                             auto epoch = hdr.producer_epoch;
+                             auto first_seq = hdr.base_sequence;
+                             auto last_seq = hdr.base_sequence
+                                             + hdr.last_offset_delta;
+                             // fingerprint after recompression so a
+                             // replayed batch hashes identically on
+                             // both passes
+                             std::optional<uint64_t> fingerprint;
+                             auto window = config::shard_local_cfg()
+                                             .kafka_produce_dedup_window_ms();
+                             if (window > std::chrono::milliseconds(0)) {
+                                 fingerprint = model::xxhash_record_batch(b);
+                             }
+                             return partition_produce_unit{
+                               .ntp = std::move(ntp),
+                               .reader = reader_from_lcore_batch(std::move(b)),
+                               .num_records = num_records,
+                               .producer_id = pid,
+                               .producer_epoch = epoch,
+                               .first_sequence = first_seq,
+                               .last_sequence = last_seq,
+                               .fingerprint = fingerprint,
+                             };
+                         });
+                   })
+                   .then([&octx, shard](
+                           std::vector<partition_produce_unit> units) {
+                       return octx.rctx.partition_manager().invoke_on(
+                         shard,
+                         octx.ssg,
+                         [units = std::move(units), acks = octx.request.acks](
+                           cluster::partition_manager& mgr) mutable {
+                             return produce_on_shard(
+                               mgr, std::move(units), acks);
+                         });
+                   })
+                   .then([&octx, slots = std::move(batch.slots)](
+                           shard_produce_result result) {
+                       octx.pressure = std::max(
+                         octx.pressure, result.pressure);
+                       for (size_t i = 0; i < result.partitions.size(); ++i) {
+                           auto [t_ix, p_ix] = slots[i];
+                           octx.response.topics[t_ix].partitions[p_ix]
+                             = std::move(result.partitions[i]);
+                       }
+                   });
+        dispatches.push_back(std::move(f));
     }
 
-    return topics;
+    return dispatches;
 }
 
 ss::future<response_ptr>
 produce_api::process(request_context&& ctx, ss::smp_service_group ssg) {
-    produce_request request(ctx);
+    // chunked decode: a request near max_message_bytes yields to the
+    // reactor between fragments of crc validation instead of adapting the
+    // whole payload in a single task
+    return ss::do_with(std::move(ctx), [ssg](request_context& ctx) {
+        return produce_request::decode_chunked(ctx).then(
+          [&ctx, ssg](produce_request request) {
+              return produce_api::process_decoded(
+                std::move(ctx), std::move(request), ssg);
+          });
+    });
+}
 
+ss::future<response_ptr> produce_api::process_decoded(
+  request_context&& ctx, produce_request&& request, ss::smp_service_group ssg) {
     /*
      * Authorization
      *
@@ -460,15 +780,27 @@ produce_api::process(request_context&& ctx, ss::smp_service_group ssg) {
       [](produce_ctx& octx) {
           vlog(klog.trace, "handling produce request {}", octx.request);
 
-          // dispatch produce requests for each topic
-          auto topics = produce_topics(octx);
+          // dispatch the produce plan, one cross-core hop per shard. shard
+          // results and validation errors land directly in the pre-built
+          // response
+          auto dispatches = dispatch_produce(octx);
 
-          // collect topic responses
-          return when_all_succeed(topics.begin(), topics.end())
-            .then([&octx](std::vector<produce_response::topic> topics) {
-                octx.response.topics = std::move(topics);
-            })
+          return when_all_succeed(dispatches.begin(), dispatches.end())
             .then([&octx] {
+                // all partition appends are replicated and flushed at this
+                // point; split them out of the handler time for sampled
+                // latency traces
+                octx.rctx.trace_stage(trace_stage::replicate);
+
+                // surface replication pressure to the client as a throttle
+                // hint and feed it back to the connection so subsequent
+                // produce requests are admitted more slowly instead of
+                // queueing until they time out
+                octx.response.throttle = std::max(
+                  octx.pressure,
+                  std::chrono::milliseconds(octx.rctx.throttle_delay_ms()));
+                octx.rctx.record_produce_pressure(octx.pressure);
+
                 // send response immediately
                 if (octx.request.acks != 0) {
                     return octx.rctx.respond(std::move(octx.response));
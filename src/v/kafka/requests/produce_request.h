@@ -21,6 +21,8 @@
 
 #include <seastar/core/future.hh>
 
+#include <string_view>
+
 namespace kafka {
 
 struct produce_response;
@@ -40,6 +42,10 @@ public:
 
     static ss::future<response_ptr>
     process(request_context&&, ss::smp_service_group);
+
+private:
+    static ss::future<response_ptr> process_decoded(
+      request_context&&, struct produce_request&&, ss::smp_service_group);
 };
 
 struct produce_response;
@@ -60,14 +66,19 @@ struct produce_request final {
         std::vector<partition> partitions;
     };
 
-    std::optional<ss::sstring> transactional_id;
+    // a view into the request buffer, valid for the request lifetime only.
+    // redpanda only inspects it to reject transactional produce, the id is
+    // never stored past the request
+    std::optional<std::string_view> transactional_id;
     int16_t acks;
     std::chrono::milliseconds timeout;
     std::vector<topic> topics;
 
     produce_request(
-      std::optional<ss::sstring> t_id, int16_t acks, std::vector<topic> topics)
-      : transactional_id(std::move(t_id))
+      std::optional<std::string_view> t_id,
+      int16_t acks,
+      std::vector<topic> topics)
+      : transactional_id(t_id)
       , acks(acks)
       , timeout()
       , topics(std::move(topics)) {}
@@ -81,6 +92,15 @@ struct produce_request final {
     void encode(response_writer& writer, api_version version);
     void decode(request_context& ctx);
 
+    /**
+     * Chunked decode used by the produce handler. Wire fields are read
+     * synchronously but each partition's batch is adapted with
+     * kafka_batch_adapter::adapt_chunked, so crc validation of a request
+     * near max_message_bytes yields to the reactor between fragments
+     * instead of stalling it for the whole payload.
+     */
+    static ss::future<produce_request> decode_chunked(request_context& ctx);
+
     /**
      * Build a generic error response for a given request.
      */
@@ -91,6 +111,12 @@ struct produce_request final {
 
     /// True if the request contains a batch with a producer id.
     bool has_idempotent = false;
+
+private:
+    produce_request() = default;
+
+    void decode_fields(request_context& ctx);
+    void on_adapted(const kafka_batch_adapter& adapter);
 };
 
 std::ostream& operator<<(std::ostream&, const produce_request&);
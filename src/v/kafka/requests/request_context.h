@@ -15,10 +15,12 @@
 #include "kafka/fetch_session_cache.h"
 #include "kafka/logger.h"
 #include "kafka/protocol.h"
+#include "kafka/requests/error_response_cache.h"
 #include "kafka/requests/request_reader.h"
 #include "kafka/requests/response.h"
 #include "kafka/types.h"
 #include "seastarx.h"
+#include "utils/arena.h"
 #include "vlog.h"
 
 #include <seastar/core/future.hh>
@@ -62,19 +64,28 @@ public:
       ss::lw_shared_ptr<connection_context> conn,
       request_header&& header,
       iobuf&& request,
-      ss::lowres_clock::duration throttle_delay) noexcept
+      ss::lowres_clock::duration throttle_delay,
+      request_trace_ptr trace = nullptr,
+      request_trace::clock::time_point ingress
+      = request_trace::clock::now()) noexcept
       : _conn(std::move(conn))
       , _header(std::move(header))
-      , _reader(std::move(request))
-      , _throttle_delay(throttle_delay) {
+      , _scratch(std::make_unique<arena>())
+      , _reader(std::move(request), _scratch.get())
+      , _throttle_delay(throttle_delay)
+      , _trace(std::move(trace))
+      , _ingress(ingress) {
         // XXX: don't forget to extend the move ctor
     }
     ~request_context() noexcept = default;
     request_context(request_context&& o) noexcept
       : _conn(std::move(o._conn))
       , _header(std::move(o._header))
+      , _scratch(std::move(o._scratch))
       , _reader(std::move(o._reader))
-      , _throttle_delay(o._throttle_delay) {}
+      , _throttle_delay(o._throttle_delay)
+      , _trace(std::move(o._trace))
+      , _ingress(o._ingress) {}
     request_context& operator=(request_context&& o) noexcept {
         if (this != &o) {
             this->~request_context();
@@ -89,6 +100,16 @@ public:
 
     request_reader& reader() { return _reader; }
 
+    /**
+     * Request-scoped scratch memory: a bump arena released wholesale when
+     * this context is destroyed, after the response has been sent. The
+     * reader spills boundary-straddling strings into it, and handlers can
+     * point std::pmr containers at it for short lived temporaries instead
+     * of paying per-element malloc/free. The arena sits behind a
+     * unique_ptr so references stay valid across context moves.
+     */
+    arena& scratch() { return *_scratch; }
+
     const cluster::metadata_cache& metadata_cache() const {
         return _conn->server().metadata_cache();
     }
@@ -107,6 +128,35 @@ public:
           .count();
     }
 
+    /// feed replication pressure observed by a produce dispatch back to the
+    /// connection's admission control
+    void record_produce_pressure(std::chrono::milliseconds delay) {
+        _conn->record_produce_pressure(delay);
+    }
+
+    /// latency trace of this request; null unless it was sampled
+    const request_trace_ptr& trace() const { return _trace; }
+
+    /// timestamp at which the request's first bytes were read off the
+    /// socket, before header parse and throttling. handlers can use it to
+    /// compute the true age of a request - e.g. to shorten an effective
+    /// timeout - rather than measuring from dispatch
+    request_trace::clock::time_point ingress_timestamp() const {
+        return _ingress;
+    }
+
+    /// stamp a trace stage; no-op for unsampled requests
+    void trace_stage(kafka::trace_stage s) {
+        if (_trace) {
+            _trace->stage(s);
+        }
+    }
+
+    kafka::quota_manager& quota_mgr() { return _conn->server().quota_mgr(); }
+
+    /// open kafka connections on this shard
+    uint32_t shard_connections() const { return _conn->shard_connections(); }
+
     kafka::group_router& groups() { return _conn->server().group_router(); }
 
     cluster::shard_table& shards() { return _conn->server().shard_table(); }
@@ -138,6 +188,50 @@ public:
         return ss::make_ready_future<response_ptr>(std::move(resp));
     }
 
+    /**
+     * Respond with an error-only response served from the per-shard
+     * template cache.
+     *
+     * Only valid for response types whose wire encoding is a pure
+     * function of (api version, error code) - i.e. the error_code
+     * constructor fills every field. The body is encoded through the
+     * writer once per (api, version, error) combination; subsequent
+     * rejections share the cached bytes, and the correlation id is
+     * patched in at send time as for any response.
+     */
+    // clang-format off
+    template<typename ResponseType>
+    CONCEPT(requires requires (
+            ResponseType r, const request_context& ctx,
+            response& resp, error_code error) {
+        ResponseType(error);
+        { r.encode(ctx, resp) } -> std::same_as<void>;
+    })
+    // clang-format on
+    ss::future<response_ptr> respond_error(error_code error) {
+        vlog(
+          klog.trace,
+          "sending {}:{} error response {}",
+          ResponseType::api_type::key,
+          ResponseType::api_type::name,
+          error);
+        auto resp = std::make_unique<response>();
+        auto& cache = error_response_cache::local();
+        auto body = cache.find(
+          ResponseType::api_type::key, _header.version, error);
+        if (body) {
+            resp->buf() = std::move(*body);
+        } else {
+            ResponseType(error).encode(*this, *resp.get());
+            cache.put(
+              ResponseType::api_type::key,
+              _header.version,
+              error,
+              resp->buf());
+        }
+        return ss::make_ready_future<response_ptr>(std::move(resp));
+    }
+
     coordinator_ntp_mapper& coordinator_mapper() {
         return _conn->server().coordinator_mapper();
     }
@@ -145,8 +239,12 @@ public:
 private:
     ss::lw_shared_ptr<connection_context> _conn;
     request_header _header;
+    // declared before _reader: the reader keeps a pointer into the arena
+    std::unique_ptr<arena> _scratch;
     request_reader _reader;
     ss::lowres_clock::duration _throttle_delay;
+    request_trace_ptr _trace;
+    request_trace::clock::time_point _ingress;
 };
 
 // Executes the API call identified by the specified request_context.
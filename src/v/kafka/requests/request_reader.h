@@ -15,6 +15,7 @@
 #include "bytes/iobuf_parser.h"
 #include "likely.h"
 #include "seastarx.h"
+#include "utils/arena.h"
 #include "utils/concepts-enabled.h"
 #include "utils/utf8.h"
 #include "utils/vint.h"
@@ -24,15 +25,25 @@
 
 #include <fmt/format.h>
 
+#include <deque>
 #include <optional>
+#include <string_view>
 #include <type_traits>
 
 namespace kafka {
 
 class request_reader {
 public:
-    explicit request_reader(iobuf io) noexcept
-      : _parser(std::move(io)) {}
+    /**
+     * The optional arena backs spill storage for string views that cross
+     * an iobuf fragment boundary. When the reader belongs to a
+     * request_context the context's scratch arena is passed in, so spilled
+     * strings are released together with everything else at request
+     * completion instead of through individual frees.
+     */
+    explicit request_reader(iobuf io, arena* spill = nullptr) noexcept
+      : _parser(std::move(io))
+      , _spill_arena(spill) {}
 
     size_t bytes_left() const { return _parser.bytes_left(); }
     size_t bytes_consumed() const { return _parser.bytes_consumed(); }
@@ -49,6 +60,26 @@ public:
 
     ss::sstring read_string() { return do_read_string(read_int16()); }
 
+    /**
+     * Read a string as a view into the request buffer without copying. The
+     * view stays valid for the lifetime of the reader - for a kafka request
+     * that is until the response is sent, when the request_context (and the
+     * buffer with it) is released wholesale. Strings that straddle an
+     * internal fragment boundary are spilled into reader-owned storage, so
+     * the common case performs no allocation at all.
+     */
+    std::string_view read_string_view() {
+        return do_read_string_view(read_int16());
+    }
+
+    std::optional<std::string_view> read_nullable_string_view() {
+        auto n = read_int16();
+        if (n < 0) {
+            return std::nullopt;
+        }
+        return {do_read_string_view(n)};
+    }
+
     std::optional<ss::sstring> read_nullable_string() {
         auto n = read_int16();
         if (n < 0) {
@@ -104,6 +135,26 @@ private:
         return _parser.read_string(n);
     }
 
+    std::string_view do_read_string_view(int16_t n) {
+        if (unlikely(n < 0)) {
+            throw std::out_of_range("Asked to read a negative byte string");
+        }
+        if (auto v = _parser.read_string_view(n); v) {
+            return *v;
+        }
+        // the string straddles a fragment boundary - copy it into spill
+        // storage so the returned view stays stable. the arena, when
+        // present, ties the copy's lifetime to the request; the deque
+        // fallback never relocates elements, which would invalidate views
+        // into small-string-optimized storage
+        auto s = _parser.read_string(n);
+        if (_spill_arena) {
+            return _spill_arena->copy(std::string_view(s.begin(), s.size()));
+        }
+        auto& sp = _spill.emplace_back(std::move(s));
+        return {sp.begin(), sp.size()};
+    }
+
     // clang-format off
     template<typename ElementParser,
              typename T = std::invoke_result_t<ElementParser, request_reader&>>
@@ -121,6 +172,8 @@ private:
     }
 
     iobuf_parser _parser;
+    arena* _spill_arena;
+    std::deque<ss::sstring> _spill;
 };
 
 } // namespace kafka
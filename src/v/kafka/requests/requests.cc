@@ -32,12 +32,16 @@
 #include "kafka/requests/sasl_authenticate_request.h"
 #include "kafka/requests/sasl_handshake_request.h"
 #include "kafka/requests/sync_group_request.h"
+#include "likely.h"
 #include "utils/to_string.h"
 #include "vlog.h"
 
 #include <seastar/core/print.hh>
 #include <seastar/util/log.hh>
 
+#include <algorithm>
+#include <array>
+
 namespace kafka {
 
 /**
@@ -91,54 +95,69 @@ ss::future<response_ptr> do_process(
     return process_dispatch<Request>::process(std::move(ctx), g);
 }
 
+using process_fn
+  = ss::future<response_ptr> (*)(request_context&&, ss::smp_service_group);
+
+/**
+ * Dispatch table indexed by api key, precomputed at compile time from the
+ * list of supported request types. A slot left null marks an unsupported
+ * key, so dispatch is one bounds check plus one indirect call.
+ */
+template<typename... Requests>
+static constexpr auto make_dispatch_table() {
+    constexpr size_t slots = size_t(std::max({Requests::key()...})) + 1;
+    std::array<process_fn, slots> table{};
+    ((table[Requests::key()] = &do_process<Requests>), ...);
+    return table;
+}
+
+static constexpr auto dispatch_table = make_dispatch_table<
+  api_versions_api,
+  metadata_api,
+  list_groups_api,
+  find_coordinator_api,
+  offset_fetch_api,
+  produce_api,
+  list_offsets_api,
+  offset_commit_api,
+  fetch_api,
+  join_group_api,
+  heartbeat_api,
+  leave_group_api,
+  sync_group_api,
+  create_topics_api,
+  describe_configs_api,
+  alter_configs_api,
+  delete_topics_api,
+  describe_groups_api,
+  sasl_handshake_api,
+  sasl_authenticate_api,
+  init_producer_id_api,
+  incremental_alter_configs_api>();
+
 ss::future<response_ptr>
 process_request(request_context&& ctx, ss::smp_service_group g) {
-    switch (ctx.header().key) {
-    case api_versions_api::key:
-        return do_process<api_versions_api>(std::move(ctx), g);
-    case metadata_api::key:
-        return do_process<metadata_api>(std::move(ctx), g);
-    case list_groups_api::key:
-        return do_process<list_groups_api>(std::move(ctx), g);
-    case find_coordinator_api::key:
-        return do_process<find_coordinator_api>(std::move(ctx), g);
-    case offset_fetch_api::key:
-        return do_process<offset_fetch_api>(std::move(ctx), g);
-    case produce_api::key:
+    const auto key = ctx.header().key;
+    /*
+     * produce, fetch and offset_commit are the bulk of request volume;
+     * test for them directly ahead of the table so their handlers are
+     * reached without the indirect call and the compiler can fold the
+     * version bounds check into the comparison.
+     */
+    if (likely(key == produce_api::key)) {
         return do_process<produce_api>(std::move(ctx), g);
-    case list_offsets_api::key:
-        return do_process<list_offsets_api>(std::move(ctx), g);
-    case offset_commit_api::key:
-        return do_process<offset_commit_api>(std::move(ctx), g);
-    case fetch_api::key:
+    }
+    if (likely(key == fetch_api::key)) {
         return do_process<fetch_api>(std::move(ctx), g);
-    case join_group_api::key:
-        return do_process<join_group_api>(std::move(ctx), g);
-    case heartbeat_api::key:
-        return do_process<heartbeat_api>(std::move(ctx), g);
-    case leave_group_api::key:
-        return do_process<leave_group_api>(std::move(ctx), g);
-    case sync_group_api::key:
-        return do_process<sync_group_api>(std::move(ctx), g);
-    case create_topics_api::key:
-        return do_process<create_topics_api>(std::move(ctx), g);
-    case describe_configs_api::key:
-        return do_process<describe_configs_api>(std::move(ctx), g);
-    case alter_configs_api::key:
-        return do_process<alter_configs_api>(std::move(ctx), g);
-    case delete_topics_api::key:
-        return do_process<delete_topics_api>(std::move(ctx), g);
-    case describe_groups_api::key:
-        return do_process<describe_groups_api>(std::move(ctx), g);
-    case sasl_handshake_api::key:
-        return do_process<sasl_handshake_api>(std::move(ctx), g);
-    case sasl_authenticate_api::key:
-        return do_process<sasl_authenticate_api>(std::move(ctx), g);
-    case init_producer_id_api::key:
-        return do_process<init_producer_id_api>(std::move(ctx), g);
-    case incremental_alter_configs_api::key:
-        return do_process<incremental_alter_configs_api>(std::move(ctx), g);
-    };
+    }
+    if (key == offset_commit_api::key) {
+        return do_process<offset_commit_api>(std::move(ctx), g);
+    }
+    if (
+      key() >= 0 && size_t(key()) < dispatch_table.size()
+      && dispatch_table[size_t(key())] != nullptr) {
+        return dispatch_table[size_t(key())](std::move(ctx), g);
+    }
     return ss::make_exception_future<response_ptr>(
       std::runtime_error(fmt::format("Unsupported API {}", ctx.header().key)));
 }
@@ -31,6 +31,56 @@
 
 namespace kafka {
 
+/**
+ * Sizing counterparts of the response_writer::write overload set. The
+ * generated encoders (see schemata/generator.py) use these to measure the
+ * exact encoded size of a message before writing it, so the whole response
+ * can be reserved in a single allocation instead of growing the buffer
+ * fragment by fragment.
+ */
+inline constexpr size_t encoded_size_of(bool) { return sizeof(int8_t); }
+inline constexpr size_t encoded_size_of(int8_t) { return sizeof(int8_t); }
+inline constexpr size_t encoded_size_of(int16_t) { return sizeof(int16_t); }
+inline constexpr size_t encoded_size_of(int32_t) { return sizeof(int32_t); }
+inline constexpr size_t encoded_size_of(int64_t) { return sizeof(int64_t); }
+inline constexpr size_t encoded_size_of(uint32_t) { return sizeof(uint32_t); }
+
+template<typename T, typename = std::enable_if_t<std::is_enum_v<T>>>
+constexpr size_t encoded_size_of(T) {
+    return sizeof(std::underlying_type_t<T>);
+}
+
+inline constexpr size_t encoded_size_of(model::timestamp) {
+    return sizeof(int64_t);
+}
+
+template<typename Rep, typename Period>
+constexpr size_t encoded_size_of(const std::chrono::duration<Rep, Period>&) {
+    return sizeof(int32_t);
+}
+
+inline size_t encoded_size_of(std::string_view v) {
+    return sizeof(int16_t) + v.size();
+}
+
+inline size_t encoded_size_of(bytes_view v) {
+    return sizeof(int32_t) + v.size();
+}
+
+template<typename T, typename Tag>
+size_t encoded_size_of(const named_type<T, Tag>& v) {
+    return encoded_size_of(v());
+}
+
+template<typename T>
+size_t encoded_size_of(const std::optional<T>& v) {
+    if (!v) {
+        // nullable strings encode null as an int16_t -1 length
+        return sizeof(int16_t);
+    }
+    return encoded_size_of(*v);
+}
+
 class response_writer {
     template<typename ExplicitIntegerType, typename IntegerType>
     // clang-format off
@@ -53,6 +103,15 @@ public:
     explicit response_writer(iobuf& out) noexcept
       : _out(&out) {}
 
+    /**
+     * Ensure size bytes are available for subsequent writes. When size is
+     * the exact encoded size (see encoded_size_of) the message serializes
+     * into one up-front fragment allocation - subject to the iobuf maximum
+     * chunk size - instead of walking the incremental growth ladder. Small
+     * responses land in a single pooled fragment.
+     */
+    void reserve(size_t size) { _out->reserve_memory(size); }
+
     uint32_t write(bool v) { return serialize_int<int8_t>(v); }
 
     uint32_t write(int8_t v) { return serialize_int<int8_t>(v); }
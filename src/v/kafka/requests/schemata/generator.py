@@ -618,6 +618,9 @@ class response;
 
 {{ render_struct(struct) }}
     void encode(response_writer&, api_version);
+    // exact size in bytes encode() will produce for the same version. used
+    // to reserve the full message up front in a single allocation
+    size_t encoded_size(api_version) const;
 {%- if op_type == "request" %}
     void decode(request_reader&, api_version);
 {%- else %}
@@ -725,6 +728,38 @@ writer.write({{ fname }});
 {%- endif %}
 {%- endmacro %}
 
+{% macro field_measurer(field, obj) %}
+{%- if obj %}
+{%- set fname = obj + "." + field.name %}
+{%- else %}
+{%- set fname = field.name %}
+{%- endif %}
+{%- if field.is_array %}
+size += sizeof(int32_t);
+{%- if field.nullable() %}
+if ({{ fname }}) {
+    for (const auto& v : *{{ fname }}) {
+{%- if field.type().value_type().is_struct %}
+{{- struct_serde(field.type().value_type(), field_measurer, "v") | indent(8) }}
+{%- else %}
+        size += encoded_size_of(v);
+{%- endif %}
+    }
+}
+{%- else %}
+for (const auto& v : {{ fname }}) {
+{%- if field.type().value_type().is_struct %}
+{{- struct_serde(field.type().value_type(), field_measurer, "v") | indent }}
+{%- else %}
+    size += encoded_size_of(v);
+{%- endif %}
+}
+{%- endif %}
+{%- else %}
+size += encoded_size_of({{ fname }});
+{%- endif %}
+{%- endmacro %}
+
 {% macro struct_serde(struct, field_serde, obj = "") %}
 {%- for field in struct.fields %}
 {%- call version_guard(field) %}
@@ -737,9 +772,16 @@ namespace kafka {
 
 {%- if struct.fields %}
 void {{ struct.name }}::encode(response_writer& writer, [[maybe_unused]] api_version version) {
+    writer.reserve(encoded_size(version));
 {{- struct_serde(struct, field_encoder) | indent }}
 }
 
+size_t {{ struct.name }}::encoded_size([[maybe_unused]] api_version version) const {
+    size_t size = 0;
+{{- struct_serde(struct, field_measurer) | indent }}
+    return size;
+}
+
 {%- if op_type == "request" %}
 void {{ struct.name }}::decode(request_reader& reader, [[maybe_unused]] api_version version) {
 {{- struct_serde(struct, field_decoder) | indent }}
@@ -759,6 +801,7 @@ void {{ struct.name }}::decode(request_reader&, api_version) {}
 void {{ struct.name }}::encode(const request_context&, response&) {}
 void {{ struct.name }}::decode(iobuf, api_version) {}
 {%- endif %}
+size_t {{ struct.name }}::encoded_size(api_version) const { return 0; }
 {%- endif %}
 
 {% set structs = struct.structs() + [struct] %}
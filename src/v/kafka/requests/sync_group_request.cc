@@ -13,6 +13,7 @@
 #include "kafka/groups/group_router.h"
 #include "kafka/requests/request_context.h"
 #include "kafka/requests/response.h"
+#include "likely.h"
 #include "utils/remote.h"
 #include "utils/to_string.h"
 
@@ -32,6 +33,13 @@ ss::future<response_ptr> sync_group_api::process(
         return ctx.groups()
           .sync_group(std::move(request))
           .then([&ctx](sync_group_response&& reply) {
+              if (unlikely(reply.data.error_code != error_code::none)) {
+                  // error replies carry no assignment, so their encoding
+                  // depends only on (version, error) and the body comes
+                  // from the pre-serialized template cache
+                  return ctx.respond_error<sync_group_response>(
+                    reply.data.error_code);
+              }
               return ctx.respond(std::move(reply));
           });
     });
@@ -89,6 +89,14 @@ cluster::topic_configuration to_cluster_type(const creatable_topic& t) {
       config_entries, "segment.bytes");
     cfg.compaction_strategy = get_config_value<model::compaction_strategy>(
       config_entries, "compaction.strategy");
+    cfg.io_shares = get_config_value<uint32_t>(
+      config_entries, "redpanda.io.shares");
+    // kafka boolean configs are the strings "true"/"false", which
+    // lexical_cast does not accept
+    if (auto it = config_entries.find("redpanda.ephemeral");
+        it != config_entries.end()) {
+        cfg.ephemeral = it->second == "true";
+    }
     cfg.retention_bytes = get_tristate_value<size_t>(
       config_entries, "retention.bytes");
     cfg.retention_duration = get_tristate_value<std::chrono::milliseconds>(
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#pragma once
+#include "kafka/security/scram_algorithm.h"
+#include "seastarx.h"
+
+#include <seastar/core/sstring.hh>
+
+#include <absl/container/node_hash_map.h>
+
+#include <optional>
+#include <variant>
+
+namespace kafka {
+
+/**
+ * Per-shard store of authentication credentials.
+ *
+ * Scram credentials hold the derived server and stored keys, so the
+ * iteration-heavy key derivation (scram_algorithm::make_credentials) runs once
+ * when a credential is created or updated. Authenticating a known user against
+ * the store is then a lookup plus a couple of cheap hmac computations over the
+ * sasl exchange, which matters for workloads dominated by short-lived
+ * connections.
+ *
+ * The store is intended to be instantiated per shard so authentication never
+ * leaves the core that owns the connection.
+ */
+class credential_store {
+public:
+    // when a new credential type is supported add it to the variant
+    using credential_types = std::variant<scram_credential>;
+
+    credential_store() noexcept = default;
+    credential_store(const credential_store&) = delete;
+    credential_store& operator=(const credential_store&) = delete;
+    credential_store(credential_store&&) noexcept = default;
+    credential_store& operator=(credential_store&&) noexcept = default;
+    ~credential_store() noexcept = default;
+
+    /// Add or replace the credential for a user.
+    template<typename T>
+    void put(const ss::sstring& name, T&& credential) {
+        _credentials.insert_or_assign(
+          name, credential_types(std::forward<T>(credential)));
+    }
+
+    /// Retrieve the credential for a user.
+    template<typename T>
+    std::optional<T> get(const ss::sstring& name) const {
+        if (auto it = _credentials.find(name); it != _credentials.end()) {
+            return std::get<T>(it->second);
+        }
+        return std::nullopt;
+    }
+
+    /// Remove the credential for a user.
+    bool remove(const ss::sstring& name) {
+        return _credentials.erase(name) > 0;
+    }
+
+    /// Check if a credential exists for a user.
+    bool contains(const ss::sstring& name) const {
+        return _credentials.find(name) != _credentials.end();
+    }
+
+private:
+    absl::node_hash_map<ss::sstring, credential_types> _credentials;
+};
+
+} // namespace kafka
@@ -49,6 +49,22 @@ FIXTURE_TEST(validate_v0, redpanda_thread_fixture) {
     BOOST_TEST(response.data.api_keys == expected);
 }
 
+FIXTURE_TEST(snapshot_serves_repeat_handshakes, redpanda_thread_fixture) {
+    auto client = make_kafka_client().get0();
+    client.connect().get();
+
+    // the first request encodes the per-shard snapshot and the second is
+    // served from it; both must carry the same payload
+    kafka::api_versions_request request;
+    auto first = client.dispatch(request, kafka::api_version(1)).get0();
+    auto second = client.dispatch(request, kafka::api_version(1)).get0();
+    client.stop().then([&client] { client.shutdown(); }).get();
+
+    BOOST_TEST(first.data.error_code == kafka::error_code::none);
+    BOOST_TEST(second.data.error_code == kafka::error_code::none);
+    BOOST_TEST(first.data.api_keys == second.data.api_keys);
+}
+
 // version 3 is not supported
 #if 0
 FIXTURE_TEST(validate_v3, redpanda_thread_fixture) {
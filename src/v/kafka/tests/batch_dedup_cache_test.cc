@@ -0,0 +1,50 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE batch_dedup_cache
+
+#include "kafka/batch_dedup_cache.h"
+
+#include <boost/test/unit_test.hpp>
+
+using cache = kafka::batch_dedup_cache;
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_CASE(recorded_fingerprints_are_seen) {
+    cache c;
+    BOOST_REQUIRE(!c.seen(0xdead, 10s));
+    c.add(0xdead);
+    BOOST_REQUIRE(c.seen(0xdead, 10s));
+    BOOST_REQUIRE(!c.seen(0xbeef, 10s));
+}
+
+BOOST_AUTO_TEST_CASE(cache_is_bounded_and_evicts_oldest) {
+    cache c;
+    c.add(0);
+    for (uint64_t fp = 1; fp <= cache::max_entries; ++fp) {
+        c.add(fp);
+    }
+    BOOST_REQUIRE_EQUAL(c.size(), cache::max_entries);
+    // the first fingerprint aged out of the window
+    BOOST_REQUIRE(!c.seen(0, 10s));
+    BOOST_REQUIRE(c.seen(1, 10s));
+    BOOST_REQUIRE(c.seen(cache::max_entries, 10s));
+}
+
+BOOST_AUTO_TEST_CASE(refreshed_fingerprint_survives_eviction_of_old_slot) {
+    cache c;
+    c.add(42);
+    // a duplicate of the original write refreshes the entry
+    c.add(42);
+    // push the original slot out of the fifo
+    for (uint64_t fp = 1000; fp < 1000 + cache::max_entries - 1; ++fp) {
+        c.add(fp);
+    }
+    BOOST_REQUIRE(c.seen(42, 10s));
+}
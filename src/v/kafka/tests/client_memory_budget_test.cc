@@ -0,0 +1,72 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "config/configuration.h"
+#include "kafka/quota_manager.h"
+#include "units.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+#include <optional>
+#include <string_view>
+
+static const std::optional<std::string_view> client{"franz"};
+static const std::optional<std::string_view> other_client{"kalinda"};
+
+static size_t budget() {
+    return config::shard_local_cfg().kafka_client_memory_budget_bytes();
+}
+
+static size_t shared_pool() {
+    return config::shard_local_cfg().kafka_client_memory_shared_bytes();
+}
+
+SEASTAR_THREAD_TEST_CASE(small_request_reserves_budget_only) {
+    kafka::quota_manager qm;
+    auto units = qm.reserve_memory(client, 1024).get0();
+    BOOST_REQUIRE(units.budget);
+    BOOST_REQUIRE_EQUAL(
+      units.budget->available_units(), ssize_t(budget() - 1024));
+}
+
+SEASTAR_THREAD_TEST_CASE(units_release_budget_on_destruction) {
+    kafka::quota_manager qm;
+    { auto units = qm.reserve_memory(client, 1024).get0(); }
+    auto units = qm.reserve_memory(client, 1).get0();
+    BOOST_REQUIRE_EQUAL(units.budget->available_units(), ssize_t(budget() - 1));
+}
+
+SEASTAR_THREAD_TEST_CASE(oversized_request_borrows_from_shared_pool) {
+    kafka::quota_manager qm;
+    auto units = qm.reserve_memory(client, budget() + 1024).get0();
+    // the whole budget is held and the excess came from the shared pool
+    BOOST_REQUIRE_EQUAL(units.budget->available_units(), 0);
+}
+
+SEASTAR_THREAD_TEST_CASE(request_larger_than_all_memory_is_clamped) {
+    kafka::quota_manager qm;
+    // must complete: the reservation is clamped to budget + shared pool
+    auto units = qm.reserve_memory(client, budget() + shared_pool() + 1_MiB)
+                   .get0();
+    BOOST_REQUIRE_EQUAL(units.budget->available_units(), 0);
+}
+
+SEASTAR_THREAD_TEST_CASE(client_queues_behind_its_own_requests) {
+    kafka::quota_manager qm;
+    auto first = qm.reserve_memory(client, budget()).get0();
+    auto second = qm.reserve_memory(client, 1);
+    BOOST_REQUIRE(!second.available());
+    // a different client is not affected by the exhausted budget
+    auto elsewhere = qm.reserve_memory(other_client, 1024).get0();
+    BOOST_REQUIRE_EQUAL(
+      elsewhere.budget->available_units(), ssize_t(budget() - 1024));
+    // releasing the first reservation unblocks the waiter
+    first = {};
+    second.get0();
+}
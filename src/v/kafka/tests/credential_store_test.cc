@@ -0,0 +1,53 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+#define BOOST_TEST_MODULE credential_store
+#include "kafka/security/credential_store.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+#include <boost/test/unit_test.hpp>
+
+namespace kafka {
+
+SEASTAR_THREAD_TEST_CASE(credential_store_put_get) {
+    auto cred = scram_sha256::make_credentials("password", 4096);
+
+    credential_store store;
+    store.put("user", cred);
+    BOOST_REQUIRE(store.contains("user"));
+    BOOST_REQUIRE(!store.contains("other"));
+
+    auto found = store.get<scram_credential>("user");
+    BOOST_REQUIRE(found);
+    BOOST_REQUIRE(found->salt() == cred.salt());
+    BOOST_REQUIRE(found->server_key() == cred.server_key());
+    BOOST_REQUIRE(found->stored_key() == cred.stored_key());
+    BOOST_REQUIRE(found->iterations() == cred.iterations());
+
+    BOOST_REQUIRE(!store.get<scram_credential>("other"));
+}
+
+SEASTAR_THREAD_TEST_CASE(credential_store_replace_remove) {
+    auto cred_a = scram_sha256::make_credentials("a", 4096);
+    auto cred_b = scram_sha256::make_credentials("b", 4096);
+
+    credential_store store;
+    store.put("user", cred_a);
+    store.put("user", cred_b);
+
+    auto found = store.get<scram_credential>("user");
+    BOOST_REQUIRE(found);
+    BOOST_REQUIRE(found->stored_key() == cred_b.stored_key());
+
+    BOOST_REQUIRE(store.remove("user"));
+    BOOST_REQUIRE(!store.remove("user"));
+    BOOST_REQUIRE(!store.contains("user"));
+}
+
+} // namespace kafka
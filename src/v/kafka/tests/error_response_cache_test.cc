@@ -0,0 +1,67 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE error_response_cache
+
+#include "kafka/requests/error_response_cache.h"
+
+#include <boost/test/unit_test.hpp>
+
+using cache = kafka::error_response_cache;
+
+static iobuf make_body(ss::sstring s) {
+    iobuf b;
+    b.append(s.data(), s.size());
+    return b;
+}
+
+BOOST_AUTO_TEST_CASE(cached_body_is_returned_for_exact_combination) {
+    cache c;
+    const auto key = kafka::api_key(12);
+    const auto v = kafka::api_version(3);
+    const auto error = kafka::error_code::not_coordinator;
+
+    BOOST_REQUIRE(!c.find(key, v, error));
+
+    auto body = make_body("not-coordinator-v3");
+    c.put(key, v, error, body);
+
+    auto found = c.find(key, v, error);
+    BOOST_REQUIRE(found);
+    BOOST_REQUIRE(*found == body);
+
+    // every dimension of the combination must match
+    BOOST_REQUIRE(!c.find(kafka::api_key(13), v, error));
+    BOOST_REQUIRE(!c.find(key, kafka::api_version(2), error));
+    BOOST_REQUIRE(!c.find(key, v, kafka::error_code::unknown_member_id));
+}
+
+BOOST_AUTO_TEST_CASE(repeated_lookups_share_the_same_bytes) {
+    cache c;
+    const auto key = kafka::api_key(14);
+    const auto v = kafka::api_version(0);
+    const auto error = kafka::error_code::rebalance_in_progress;
+
+    c.put(key, v, error, make_body("rebalance"));
+
+    auto a = c.find(key, v, error);
+    auto b = c.find(key, v, error);
+    BOOST_REQUIRE(a && b);
+    BOOST_REQUIRE(*a == *b);
+    BOOST_REQUIRE_EQUAL(c.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(cache_is_bounded) {
+    cache c;
+    const auto error = kafka::error_code::not_coordinator;
+    for (int16_t v = 0; v < int16_t(cache::max_entries) + 10; v++) {
+        c.put(kafka::api_key(12), kafka::api_version(v), error, make_body("x"));
+    }
+    BOOST_REQUIRE_EQUAL(c.size(), cache::max_entries);
+}
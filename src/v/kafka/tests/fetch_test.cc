@@ -16,6 +16,7 @@
 #include "test_utils/async.h"
 
 #include <seastar/core/smp.hh>
+#include <seastar/core/when_all.hh>
 
 #include <chrono>
 #include <limits>
@@ -167,16 +168,8 @@ FIXTURE_TEST(read_from_ntp_max_bytes, redpanda_thread_fixture) {
             shard,
             [ntp, config](cluster::partition_manager& pm) {
                 return kafka::read_from_ntp(
-                  pm,
-                  model::materialized_ntp(ntp),
-                  config,
-                  true,
-                  model::no_timeout);
+                  pm, model::materialized_ntp(ntp), config, model::no_timeout);
             })
-          .then([](kafka::read_result res) {
-              return std::move(*res.reader)
-                .consume(kafka::kafka_batch_serializer(), model::no_timeout);
-          })
           .get0();
     };
     wait_for_controller_leadership().get0();
@@ -192,16 +185,67 @@ FIXTURE_TEST(read_from_ntp_max_bytes, redpanda_thread_fixture) {
           });
     }).get();
 
-    auto zero = do_read(ntp, 0).data.size_bytes();
-    auto one = do_read(ntp, 1).data.size_bytes();
-    auto maxlimit
-      = do_read(ntp, std::numeric_limits<size_t>::max()).data.size_bytes();
+    auto zero = do_read(ntp, 0).record_set->size_bytes();
+    auto one = do_read(ntp, 1).record_set->size_bytes();
+    auto maxlimit = do_read(ntp, std::numeric_limits<size_t>::max())
+                      .record_set->size_bytes();
 
     BOOST_TEST(zero > 0); // read something
     BOOST_TEST(zero == one);
     BOOST_TEST(one <= maxlimit); // read more
 }
 
+FIXTURE_TEST(read_from_ntp_concurrent_identical, redpanda_thread_fixture) {
+    // identical concurrent reads attach to one in-flight read and share the
+    // record set; both must observe the same data
+    wait_for_controller_leadership().get0();
+    auto ntp = make_data(model::revision_id(2));
+
+    auto shard = app.shard_table.local().shard_for(ntp);
+    tests::cooperative_spin_wait_with_timeout(10s, [this, shard, ntp = ntp] {
+        return app.partition_manager.invoke_on(
+          *shard, [ntp](cluster::partition_manager& mgr) {
+              auto partition = mgr.get(ntp);
+              return partition
+                     && partition->committed_offset() >= model::offset(1);
+          });
+    }).get();
+
+    auto equal = app.partition_manager
+                   .invoke_on(
+                     *shard,
+                     [ntp](cluster::partition_manager& pm) {
+                         kafka::fetch_config config{
+                           .start_offset = model::offset(0),
+                           .max_bytes = std::numeric_limits<size_t>::max(),
+                           .timeout = model::no_timeout,
+                         };
+                         auto f1 = kafka::read_from_ntp(
+                           pm,
+                           model::materialized_ntp(ntp),
+                           config,
+                           model::no_timeout);
+                         auto f2 = kafka::read_from_ntp(
+                           pm,
+                           model::materialized_ntp(ntp),
+                           config,
+                           model::no_timeout);
+                         return ss::when_all(std::move(f1), std::move(f2))
+                           .then([](std::tuple<
+                                    ss::future<kafka::read_result>,
+                                    ss::future<kafka::read_result>> rs) {
+                               auto a = std::get<0>(rs).get0();
+                               auto b = std::get<1>(rs).get0();
+                               return a.record_set && b.record_set
+                                      && a.record_set->size_bytes() > 0
+                                      && *a.record_set == *b.record_set
+                                      && a.high_watermark == b.high_watermark;
+                           });
+                     })
+                   .get0();
+    BOOST_TEST(equal);
+}
+
 FIXTURE_TEST(fetch_one, redpanda_thread_fixture) {
     // create a topic partition with some data
     model::topic topic("foo");
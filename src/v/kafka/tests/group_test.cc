@@ -129,6 +129,33 @@ SEASTAR_THREAD_TEST_CASE(has_members) {
     BOOST_TEST(g.has_members());
 }
 
+SEASTAR_THREAD_TEST_CASE(cooperative_rebalance_classification) {
+    auto g = get();
+
+    // empty groups are not cooperative
+    BOOST_TEST(!g.is_cooperative());
+
+    // eager-only member
+    auto m0 = get_group_member("m0");
+    (void)g.add_member(m0);
+    BOOST_TEST(!g.is_cooperative());
+
+    // all members support a cooperative protocol
+    auto g2 = get();
+    const std::vector<member_protocol> coop_protos = {
+      {kafka::protocol_name("cooperative-sticky"), "d0"}};
+    auto m1 = get_group_member("m1", coop_protos);
+    auto m2 = get_group_member("m2", coop_protos);
+    (void)g2.add_member(m1);
+    (void)g2.add_member(m2);
+    BOOST_TEST(g2.is_cooperative());
+
+    // mixed groups fall back to eager
+    auto m3 = get_group_member("m3");
+    (void)g2.add_member(m3);
+    BOOST_TEST(!g2.is_cooperative());
+}
+
 SEASTAR_THREAD_TEST_CASE(pending_members) {
     auto g = get();
     BOOST_TEST(!g.contains_pending_member(kafka::member_id("m")));
@@ -0,0 +1,136 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/iobuf.h"
+#include "kafka/requests/join_group_request.h"
+#include "kafka/requests/kafka_batch_adapter.h"
+#include "kafka/requests/offset_commit_request.h"
+#include "kafka/requests/response_writer.h"
+#include "kafka/requests/response_writer_utils.h"
+#include "random/generators.h"
+#include "storage/tests/utils/random_batch.h"
+#include "vassert.h"
+
+#include <seastar/testing/perf_tests.hh>
+
+#include <fmt/format.h>
+
+/*
+ * per-api-key codec microbenchmarks. each test measures a single decode or
+ * encode pass over a representative pre-built frame so regressions can be
+ * attributed to an api key; the perf framework reports ns/op and allocs/op.
+ *
+ * the corpus is synthesized with the same writers the broker uses on the
+ * wire, so decode sees byte-identical input to what a client would send.
+ */
+
+static constexpr auto join_group_version = kafka::api_version(4);
+static constexpr auto offset_commit_version = kafka::api_version(7);
+
+static kafka::join_group_request_data make_join_group() {
+    kafka::join_group_request_data data;
+    data.group_id = kafka::group_id("codec-bench-group");
+    data.session_timeout_ms = std::chrono::milliseconds(30000);
+    data.rebalance_timeout_ms = std::chrono::milliseconds(60000);
+    data.member_id = kafka::member_id("codec-bench-member");
+    data.protocol_type = kafka::protocol_type("consumer");
+    for (int i = 0; i < 4; i++) {
+        data.protocols.push_back(kafka::join_group_request_protocol{
+          .name = kafka::protocol_name(fmt::format("range-{}", i)),
+          .metadata = random_generators::get_bytes(64),
+        });
+    }
+    return data;
+}
+
+static kafka::offset_commit_request_data make_offset_commit() {
+    kafka::offset_commit_request_data data;
+    data.group_id = kafka::group_id("codec-bench-group");
+    data.generation_id = 7;
+    data.member_id = kafka::member_id("codec-bench-member");
+    for (int t = 0; t < 8; t++) {
+        kafka::offset_commit_request_topic topic;
+        topic.name = model::topic(fmt::format("topic-{}", t));
+        for (int p = 0; p < 8; p++) {
+            topic.partitions.push_back(kafka::offset_commit_request_partition{
+              .partition_index = model::partition_id(p),
+              .committed_offset = model::offset(8192 + p),
+              .committed_metadata = "codec-bench-metadata",
+            });
+        }
+        data.topics.push_back(std::move(topic));
+    }
+    return data;
+}
+
+template<typename T>
+static iobuf encode_frame(T data, kafka::api_version version) {
+    iobuf out;
+    kafka::response_writer writer(out);
+    data.encode(writer, version);
+    return out;
+}
+
+struct codec_bench {
+    codec_bench() {
+        join_group_frame = encode_frame(make_join_group(), join_group_version);
+        offset_commit_frame = encode_frame(
+          make_offset_commit(), offset_commit_version);
+
+        auto batch = storage::test::make_random_batch(
+          model::offset(0), 64, false);
+        kafka::response_writer writer(produce_batch_frame);
+        kafka::writer_serialize_batch(writer, std::move(batch));
+    }
+
+    iobuf join_group_frame;
+    iobuf offset_commit_frame;
+    iobuf produce_batch_frame;
+};
+
+PERF_TEST_F(codec_bench, join_group_decode) {
+    kafka::join_group_request_data data;
+    data.decode(
+      join_group_frame.share(0, join_group_frame.size_bytes()),
+      join_group_version);
+    perf_tests::do_not_optimize(data);
+}
+
+PERF_TEST_F(codec_bench, join_group_encode) {
+    auto data = make_join_group();
+    perf_tests::start_measuring_time();
+    auto out = encode_frame(std::move(data), join_group_version);
+    perf_tests::stop_measuring_time();
+    perf_tests::do_not_optimize(out);
+}
+
+PERF_TEST_F(codec_bench, offset_commit_decode) {
+    kafka::offset_commit_request_data data;
+    data.decode(
+      offset_commit_frame.share(0, offset_commit_frame.size_bytes()),
+      offset_commit_version);
+    perf_tests::do_not_optimize(data);
+}
+
+PERF_TEST_F(codec_bench, offset_commit_encode) {
+    auto data = make_offset_commit();
+    perf_tests::start_measuring_time();
+    auto out = encode_frame(std::move(data), offset_commit_version);
+    perf_tests::stop_measuring_time();
+    perf_tests::do_not_optimize(out);
+}
+
+// the produce hot path: adapting a kafka wire format batch into a redpanda
+// batch, including the crc validation pass
+PERF_TEST_F(codec_bench, produce_batch_adapt) {
+    kafka::kafka_batch_adapter kba;
+    kba.adapt(produce_batch_frame.share(0, produce_batch_frame.size_bytes()));
+    vassert(kba.v2_format && kba.valid_crc, "corpus batch must adapt cleanly");
+    perf_tests::do_not_optimize(kba);
+}
@@ -0,0 +1,95 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE producer_state
+
+#include "kafka/producer_state.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <limits>
+
+using table = kafka::producer_state_table;
+using check = table::sequence_check;
+
+BOOST_AUTO_TEST_CASE(sequences_advance_in_order) {
+    table t;
+    // unknown producer is admitted at any starting sequence
+    BOOST_REQUIRE(t.check_and_advance(1, 0, 5, 9).outcome == check::accept);
+    BOOST_REQUIRE(t.check_and_advance(1, 0, 10, 10).outcome == check::accept);
+    // retry of an acknowledged window
+    BOOST_REQUIRE(t.check_and_advance(1, 0, 10, 10).outcome == check::duplicate);
+    BOOST_REQUIRE(t.check_and_advance(1, 0, 5, 9).outcome == check::duplicate);
+    // gap in the sequence
+    BOOST_REQUIRE(
+      t.check_and_advance(1, 0, 12, 12).outcome == check::out_of_order);
+    // the failed attempts must not have moved the window
+    BOOST_REQUIRE(t.check_and_advance(1, 0, 11, 11).outcome == check::accept);
+}
+
+BOOST_AUTO_TEST_CASE(epoch_transitions) {
+    table t;
+    BOOST_REQUIRE(t.check_and_advance(7, 3, 0, 0).outcome == check::accept);
+    // older epoch is fenced
+    BOOST_REQUIRE(t.check_and_advance(7, 2, 1, 1).outcome == check::stale_epoch);
+    // a bumped epoch must restart sequencing from zero
+    BOOST_REQUIRE(
+      t.check_and_advance(7, 4, 5, 5).outcome == check::out_of_order);
+    BOOST_REQUIRE(t.check_and_advance(7, 4, 0, 3).outcome == check::accept);
+    BOOST_REQUIRE(t.check_and_advance(7, 4, 4, 4).outcome == check::accept);
+}
+
+BOOST_AUTO_TEST_CASE(sequence_wraparound) {
+    table t;
+    constexpr auto max = std::numeric_limits<int32_t>::max();
+    BOOST_REQUIRE(
+      t.check_and_advance(1, 0, max - 1, max).outcome == check::accept);
+    BOOST_REQUIRE(t.check_and_advance(1, 0, 0, 2).outcome == check::accept);
+    BOOST_REQUIRE(t.check_and_advance(1, 0, 3, 3).outcome == check::accept);
+}
+
+BOOST_AUTO_TEST_CASE(rollback_restores_window) {
+    table t;
+    BOOST_REQUIRE(t.check_and_advance(1, 0, 0, 4).outcome == check::accept);
+    auto admitted = t.check_and_advance(1, 0, 5, 9);
+    BOOST_REQUIRE(admitted.outcome == check::accept);
+    // replication failed: the retry of the same window is admitted again
+    t.rollback(1, admitted);
+    BOOST_REQUIRE(t.check_and_advance(1, 0, 5, 9).outcome == check::accept);
+}
+
+BOOST_AUTO_TEST_CASE(rollback_of_first_contact_forgets_producer) {
+    table t;
+    auto admitted = t.check_and_advance(1, 0, 100, 104);
+    BOOST_REQUIRE(admitted.outcome == check::accept);
+    t.rollback(1, admitted);
+    BOOST_REQUIRE_EQUAL(t.size(), 0);
+    BOOST_REQUIRE(t.check_and_advance(1, 0, 100, 104).outcome == check::accept);
+}
+
+BOOST_AUTO_TEST_CASE(rollback_is_noop_after_later_advance) {
+    table t;
+    BOOST_REQUIRE(t.check_and_advance(1, 0, 0, 0).outcome == check::accept);
+    auto first = t.check_and_advance(1, 0, 1, 1);
+    BOOST_REQUIRE(first.outcome == check::accept);
+    BOOST_REQUIRE(t.check_and_advance(1, 0, 2, 2).outcome == check::accept);
+    // a later batch owns the window now; the stale rollback must not
+    // rewind it
+    t.rollback(1, first);
+    BOOST_REQUIRE(t.check_and_advance(1, 0, 3, 3).outcome == check::accept);
+}
+
+BOOST_AUTO_TEST_CASE(table_is_bounded) {
+    table t;
+    for (size_t i = 0; i < table::max_producers + 10; ++i) {
+        auto r = t.check_and_advance(int64_t(i), 0, 0, 0);
+        BOOST_REQUIRE(r.outcome == check::accept);
+    }
+    BOOST_REQUIRE_EQUAL(t.size(), table::max_producers);
+}
@@ -7,6 +7,7 @@
 // the Business Source License, use of this software will be governed
 // by the Apache License, Version 2.0
 
+#include "kafka/requests/join_group_request.h"
 #include "kafka/requests/request_reader.h"
 #include "kafka/requests/response_writer.h"
 #include "random/generators.h"
@@ -50,3 +51,60 @@ SEASTAR_THREAD_TEST_CASE(write_and_read_value_test) {
     roundtrip_test(
       model::topic{"test_topic"}, ss::sstring, &request_reader::read_string);
 }
+
+SEASTAR_THREAD_TEST_CASE(encoded_size_of_matches_writer_test) {
+    auto out = iobuf();
+    kafka::response_writer w(out);
+    BOOST_REQUIRE_EQUAL(w.write(true), encoded_size_of(true));
+    BOOST_REQUIRE_EQUAL(
+      w.write(static_cast<int16_t>(32000)),
+      encoded_size_of(static_cast<int16_t>(32000)));
+    BOOST_REQUIRE_EQUAL(
+      w.write(static_cast<int64_t>(45564000000)),
+      encoded_size_of(static_cast<int64_t>(45564000000)));
+    auto str = ss::sstring{"test_string"};
+    BOOST_REQUIRE_EQUAL(w.write(str), encoded_size_of(std::string_view(str)));
+    auto null_str = std::optional<ss::sstring>{std::nullopt};
+    BOOST_REQUIRE_EQUAL(w.write(null_str), encoded_size_of(null_str));
+    auto topic = model::topic{"test_topic"};
+    BOOST_REQUIRE_EQUAL(w.write(topic), encoded_size_of(topic));
+    BOOST_REQUIRE_EQUAL(out.size_bytes(), 38);
+}
+
+SEASTAR_THREAD_TEST_CASE(write_and_read_string_view_test) {
+    auto out = iobuf();
+    kafka::response_writer w(out);
+    w.write(ss::sstring{"test_string"});
+    w.write(std::optional<ss::sstring>{"test_string"});
+    w.write(std::optional<ss::sstring>{std::nullopt});
+    kafka::request_reader r(std::move(out));
+    BOOST_REQUIRE_EQUAL(r.read_string_view(), "test_string");
+    auto nullable = r.read_nullable_string_view();
+    BOOST_REQUIRE(nullable.has_value());
+    BOOST_REQUIRE_EQUAL(*nullable, "test_string");
+    BOOST_REQUIRE(!r.read_nullable_string_view().has_value());
+}
+
+// decoding a frame truncated at any byte boundary must fail with an
+// exception rather than read out of bounds or produce a partial message
+SEASTAR_THREAD_TEST_CASE(truncated_frame_decode_throws_test) {
+    kafka::join_group_request_data data;
+    data.group_id = kafka::group_id("group");
+    data.session_timeout_ms = std::chrono::milliseconds(30000);
+    data.rebalance_timeout_ms = std::chrono::milliseconds(60000);
+    data.member_id = kafka::member_id("member");
+    data.protocol_type = kafka::protocol_type("consumer");
+    data.protocols.push_back(kafka::join_group_request_protocol{
+      .name = kafka::protocol_name("range"),
+      .metadata = random_generators::get_bytes(16),
+    });
+    auto out = iobuf();
+    kafka::response_writer w(out);
+    data.encode(w, kafka::api_version(4));
+    for (size_t len = 0; len < out.size_bytes(); len++) {
+        kafka::join_group_request_data decoded;
+        BOOST_REQUIRE_THROW(
+          decoded.decode(out.share(0, len), kafka::api_version(4)),
+          std::exception);
+    }
+}
@@ -34,7 +34,7 @@ enum class cleanup_policy_bitflags : uint8_t {
     compaction = 1U << 1U
 };
 
-inline cleanup_policy_bitflags
+inline constexpr cleanup_policy_bitflags
 operator|(cleanup_policy_bitflags a, cleanup_policy_bitflags b) {
     return cleanup_policy_bitflags(
       std::underlying_type_t<cleanup_policy_bitflags>(a)
@@ -45,7 +45,7 @@ inline void operator|=(cleanup_policy_bitflags& a, cleanup_policy_bitflags b) {
     a = (a | b);
 }
 
-inline cleanup_policy_bitflags
+inline constexpr cleanup_policy_bitflags
 operator&(cleanup_policy_bitflags a, cleanup_policy_bitflags b) {
     return cleanup_policy_bitflags(
       std::underlying_type_t<cleanup_policy_bitflags>(a)
@@ -250,6 +250,47 @@ private:
     std::vector<record_header> _headers{};
 };
 
+/**
+ * A lazy, partially materialized view of one serialized record. Scalar
+ * fields are decoded and the key is copied out of the batch payload; the
+ * value and headers are skipped without being materialized. Use it on
+ * paths that only need keys, offsets or timestamps - compaction indexing,
+ * filtering - where building a full model::record would copy the value
+ * and allocate a header vector per record for nothing.
+ */
+class record_view {
+public:
+    record_view(
+      int32_t size_bytes,
+      record_attributes attributes,
+      int64_t timestamp_delta,
+      int32_t offset_delta,
+      int32_t key_size,
+      iobuf key) noexcept
+      : _size_bytes(size_bytes)
+      , _attributes(attributes)
+      , _timestamp_delta(timestamp_delta)
+      , _offset_delta(offset_delta)
+      , _key_size(key_size)
+      , _key(std::move(key)) {}
+
+    int32_t size_bytes() const { return _size_bytes; }
+    record_attributes attributes() const { return _attributes; }
+    int64_t timestamp_delta() const { return _timestamp_delta; }
+    int32_t offset_delta() const { return _offset_delta; }
+    int32_t key_size() const { return _key_size; }
+    const iobuf& key() const { return _key; }
+    iobuf release_key() && { return std::move(_key); }
+
+private:
+    int32_t _size_bytes{0};
+    record_attributes _attributes;
+    int64_t _timestamp_delta{0};
+    int32_t _offset_delta{0};
+    int32_t _key_size{-1};
+    iobuf _key;
+};
+
 class record_batch_attributes final {
 public:
     static constexpr uint16_t compression_mask = 0x7;
@@ -558,6 +599,26 @@ public:
         }
     }
 
+    /**
+     * Iterate over partially materialized record views. Values and
+     * headers are skipped, not copied - see model::record_view.
+     *
+     * Use `model::for_each_record_view(..)` for futurized version.
+     */
+    template<typename Func>
+    void for_each_record_view(Func f) const {
+        verify_iterable();
+        iobuf_const_parser parser(_records);
+        for (auto i = 0; i < _header.record_count; i++) {
+            f(model::parse_one_record_view_from_buffer(parser));
+        }
+        if (unlikely(parser.bytes_left())) {
+            throw std::out_of_range(fmt::format(
+              "Record view iteration stopped with {} bytes remaining",
+              parser.bytes_left()));
+        }
+    }
+
     /**
      * Materialize records.
      *
@@ -604,6 +665,10 @@ private:
     template<typename Func>
     friend ss::future<>
     for_each_record(const model::record_batch& batch, Func&& f);
+
+    template<typename Func>
+    friend ss::future<>
+    for_each_record_view(const model::record_batch& batch, Func&& f);
 };
 
 using record_batch_opt = ss::optimized_optional<record_batch>;
@@ -630,6 +695,27 @@ for_each_record(const model::record_batch& batch, Func&& f) {
       });
 }
 
+/**
+ * Iterate over partially materialized record views, futurized. Values
+ * and headers are skipped, not copied - see model::record_view.
+ */
+template<typename Func>
+inline ss::future<>
+for_each_record_view(const model::record_batch& batch, Func&& f) {
+    batch.verify_iterable();
+    return ss::do_with(
+      iobuf_const_parser(batch.data()),
+      [record_count = batch.record_count(),
+       f = std::forward<Func>(f)](iobuf_const_parser& parser) mutable {
+          return ss::do_for_each(
+            boost::counting_iterator<int32_t>(0),
+            boost::counting_iterator<int32_t>(record_count),
+            [&parser, f = std::forward<Func>(f)](int32_t) {
+                return f(model::parse_one_record_view_from_buffer(parser));
+            });
+      });
+}
+
 class record_batch_crc_checker {
 public:
     explicit record_batch_crc_checker(bool verify_internal_header = true)
@@ -10,6 +10,7 @@
 #include "model/record_utils.h"
 
 #include "bytes/utils.h"
+#include "hashing/xx.h"
 #include "model/record.h"
 #include "reflection/adl.h"
 #include "utils/vint.h"
@@ -87,6 +88,33 @@ int32_t crc_record_batch(const record_batch& b) {
     return crc_record_batch(b.header(), b.data());
 }
 
+uint64_t
+xxhash_record_batch(const record_batch_header& hdr, const iobuf& records) {
+    auto h = incremental_xxhash64();
+    // same fields as header_crc and crc combined, minus the crc fields
+    // themselves. hashed as little endian at no cost on x86.
+    h.update_all(
+      ss::cpu_to_le(hdr.size_bytes),
+      ss::cpu_to_le(hdr.base_offset()),
+      ss::cpu_to_le(hdr.type()),
+      ss::cpu_to_le(hdr.attrs.value()),
+      ss::cpu_to_le(hdr.last_offset_delta),
+      ss::cpu_to_le(hdr.first_timestamp.value()),
+      ss::cpu_to_le(hdr.max_timestamp.value()),
+      ss::cpu_to_le(hdr.producer_id),
+      ss::cpu_to_le(hdr.producer_epoch),
+      ss::cpu_to_le(hdr.base_sequence),
+      ss::cpu_to_le(hdr.record_count));
+    for (const auto& f : records) {
+        h.update(f.get(), f.size());
+    }
+    return h.digest();
+}
+
+uint64_t xxhash_record_batch(const record_batch& b) {
+    return xxhash_record_batch(b.header(), b.data());
+}
+
 template<typename Parser, typename ParserData>
 static std::vector<model::record_header>
 parse_record_headers(Parser& parser, ParserData parser_data) {
@@ -172,6 +200,39 @@ model::record parse_one_record_copy_from_buffer(iobuf_const_parser& parser) {
       });
 }
 
+model::record_view parse_one_record_view_from_buffer(iobuf_const_parser& parser) {
+    auto [record_size, attr] = parse_record_meta_from_buffer(parser);
+    auto [timestamp_delta, tv] = parser.read_varlong();
+    auto [offset_delta, ov] = parser.read_varlong();
+    auto [key_length, kv] = parser.read_varlong();
+    iobuf key;
+    if (key_length > 0) {
+        key = parser.copy(key_length);
+    }
+    auto [value_length, vv] = parser.read_varlong();
+    if (value_length > 0) {
+        parser.skip(value_length);
+    }
+    auto [header_count, hv] = parser.read_varlong();
+    for (int64_t i = 0; i < header_count; ++i) {
+        auto [hkey_length, hkv] = parser.read_varlong();
+        if (hkey_length > 0) {
+            parser.skip(hkey_length);
+        }
+        auto [hvalue_length, hvv] = parser.read_varlong();
+        if (hvalue_length > 0) {
+            parser.skip(hvalue_length);
+        }
+    }
+    return model::record_view(
+      record_size,
+      model::record_attributes(attr),
+      static_cast<int64_t>(timestamp_delta),
+      static_cast<int32_t>(offset_delta),
+      static_cast<int32_t>(key_length),
+      std::move(key));
+}
+
 static inline void append_vint_to_iobuf(iobuf& b, int64_t v) {
     auto vb = vint::to_bytes(v);
     b.append(vb.data(), vb.size());
@@ -19,6 +19,7 @@ namespace model {
 struct record_batch_header;
 class record_batch;
 class record;
+class record_view;
 
 void crc_record_batch_header(crc32&, const record_batch_header&);
 
@@ -30,8 +31,18 @@ int32_t crc_record_batch(const record_batch_header&, const iobuf&);
 /// it is *only* record_batch_header.header_crc;
 uint32_t internal_header_only_crc(const record_batch_header&);
 
+/// \brief xxhash64 integrity profile over a batch
+///
+/// Covers the union of the fields protected by header_crc and crc in a
+/// single pass over the payload. Strictly node-local: the kafka wire
+/// format and the on disk log keep crc32c.
+uint64_t xxhash_record_batch(const record_batch& b);
+uint64_t xxhash_record_batch(const record_batch_header&, const iobuf&);
+
 model::record parse_one_record_from_buffer(iobuf_parser& parser);
 model::record parse_one_record_copy_from_buffer(iobuf_const_parser& parser);
+/// decodes scalar fields and the key, skips value and headers entirely
+model::record_view parse_one_record_view_from_buffer(iobuf_const_parser&);
 void append_record_to_buffer(iobuf& a, const model::record& r);
 
 } // namespace model
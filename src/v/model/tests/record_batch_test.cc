@@ -78,3 +78,19 @@ SEASTAR_THREAD_TEST_CASE(set_max_timestamp) {
     BOOST_TEST(crc == batch.header().crc);
     BOOST_TEST(hdr_crc == batch.header().header_crc);
 }
+
+SEASTAR_THREAD_TEST_CASE(record_view_matches_materialized_records) {
+    auto batch = storage::test::make_random_batch(model::offset(0), 10, false);
+
+    std::vector<model::record> records = batch.copy_records();
+    size_t i = 0;
+    batch.for_each_record_view([&records, &i](model::record_view v) {
+        const auto& r = records[i++];
+        BOOST_REQUIRE_EQUAL(v.size_bytes(), r.size_bytes());
+        BOOST_REQUIRE_EQUAL(v.timestamp_delta(), r.timestamp_delta());
+        BOOST_REQUIRE_EQUAL(v.offset_delta(), r.offset_delta());
+        BOOST_REQUIRE_EQUAL(v.key_size(), r.key_size());
+        BOOST_REQUIRE(v.key() == r.key());
+    });
+    BOOST_REQUIRE_EQUAL(i, records.size());
+}
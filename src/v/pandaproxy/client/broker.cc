@@ -9,27 +9,43 @@
 
 #include "pandaproxy/client/broker.h"
 
+#include "pandaproxy/client/configuration.h"
 #include "pandaproxy/client/logger.h"
+#include "ssx/future-util.h"
+#include "utils/dns_cache.h"
+
+#include <boost/range/irange.hpp>
 
 namespace pandaproxy::client {
 
+ss::future<broker::connection_ptr> make_connection(ss::socket_address addr) {
+    auto client = ss::make_lw_shared<kafka::client>(
+      rpc::base_transport::configuration{.server_addr = addr});
+    return client->connect().then([client]() {
+        return ss::make_lw_shared<broker::connection>(std::move(*client));
+    });
+}
+
 ss::future<shared_broker_t>
 make_broker(model::node_id node_id, unresolved_address addr) {
-    return addr.resolve()
+    return shard_dns_cache()
+      .resolve(addr)
       .then([](ss::socket_address addr) {
-          auto client = ss::make_lw_shared<kafka::client>(
-            rpc::base_transport::configuration{.server_addr = addr});
-          return client->connect().then(
-            [client]() mutable { return std::move(client); });
+          auto connections = std::max(
+            size_t{1}, shard_local_cfg().broker_connections());
+          return ssx::parallel_transform(
+            boost::irange(size_t{0}, connections),
+            [addr](size_t) { return make_connection(addr); });
       })
-      .then([node_id, addr](ss::lw_shared_ptr<kafka::client> client) {
+      .then([node_id, addr](std::vector<broker::connection_ptr> connections) {
           vlog(
             ppclog.info,
-            "connected to broker:{} - {}:{}",
+            "connected to broker:{} - {}:{} ({} connections)",
             node_id,
             addr.host(),
-            addr.port());
-          return ss::make_lw_shared<broker>(node_id, std::move(*client));
+            addr.port(),
+            connections.size());
+          return ss::make_lw_shared<broker>(node_id, std::move(connections));
       })
       .handle_exception_type([node_id](const std::system_error& ex) {
           if (
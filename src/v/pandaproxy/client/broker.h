@@ -15,12 +15,16 @@
 #include "model/metadata.h"
 #include "pandaproxy/client/error.h"
 #include "utils/mutex.h"
+#include "vassert.h"
 
+#include <seastar/core/future-util.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/shared_ptr.hh>
 
 #include <absl/container/flat_hash_set.h>
 
+#include <vector>
+
 namespace pandaproxy::client {
 
 struct gated_mutex {
@@ -48,17 +52,33 @@ struct gated_mutex {
 
 class broker : public ss::enable_lw_shared_from_this<broker> {
 public:
-    broker(model::node_id node_id, kafka::client&& client)
+    /// \brief A transport and the mutex that serializes requests on it.
+    ///
+    /// The kafka protocol returns replies in the order requests were
+    /// received, so each connection admits one request at a time; requests
+    /// overlap by being spread across the pool of connections.
+    struct connection {
+        explicit connection(kafka::client&& client)
+          : client{std::move(client)}
+          , gated_mutex{} {}
+        kafka::client client;
+        gated_mutex gated_mutex;
+    };
+    using connection_ptr = ss::lw_shared_ptr<connection>;
+
+    broker(model::node_id node_id, std::vector<connection_ptr> connections)
       : _node_id(node_id)
-      , _client(std::move(client))
-      , _gated_mutex{} {}
+      , _connections(std::move(connections)) {
+        vassert(!_connections.empty(), "broker requires a connection");
+    }
 
     template<typename T, typename Ret = typename T::api_type::response_type>
     CONCEPT(requires(kafka::KafkaRequest<typename T::api_type>))
     ss::future<Ret> dispatch(T r) {
-        return _gated_mutex
-          .with([this, r{std::move(r)}]() mutable {
-              return _client.dispatch(std::move(r));
+        auto conn = _connections[_next_connection++ % _connections.size()];
+        return conn->gated_mutex
+          .with([conn, r{std::move(r)}]() mutable {
+              return conn->client.dispatch(std::move(r));
           })
           .handle_exception_type([this](const std::bad_optional_access&) {
               // Short read
@@ -70,16 +90,20 @@ public:
 
     model::node_id id() const { return _node_id; }
     ss::future<> stop() {
-        return _gated_mutex.close()
-          .then([this]() { return _client.stop(); })
+        return ss::parallel_for_each(
+                 _connections,
+                 [](connection_ptr conn) {
+                     return conn->gated_mutex.close().then(
+                       [conn]() { return conn->client.stop(); });
+                 })
           .finally([b = shared_from_this()]() {});
     }
 
 private:
     model::node_id _node_id;
-    kafka::client _client;
-    // TODO(Ben): allow overlapped requests
-    gated_mutex _gated_mutex;
+    /// \brief Pooled connections, selected with round-robin
+    std::vector<connection_ptr> _connections;
+    size_t _next_connection{0};
 };
 
 using shared_broker_t = ss::lw_shared_ptr<broker>;
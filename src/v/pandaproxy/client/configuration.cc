@@ -28,6 +28,12 @@ configuration::configuration()
       config::required::no,
       config::tls_config(),
       config::tls_config::validate)
+  , broker_connections(
+      *this,
+      "broker_connections",
+      "Number of connections to pool per broker",
+      config::required::no,
+      4)
   , retries(
       *this,
       "retries",
@@ -36,9 +36,8 @@ make_produce_request(model::topic_partition tp, model::record_batch&& batch) {
     std::vector<kafka::produce_request::topic> topics;
     topics.emplace_back(kafka::produce_request::topic{
       .name{std::move(tp.topic)}, .partitions{std::move(partitions)}});
-    std::optional<ss::sstring> t_id;
     int16_t acks = -1;
-    return kafka::produce_request(t_id, acks, std::move(topics));
+    return kafka::produce_request(std::nullopt, acks, std::move(topics));
 }
 
 kafka::produce_response::partition
@@ -0,0 +1,340 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "prometheus/metrics_snapshot.h"
+
+#include "bytes/bytes.h"
+#include "bytes/iobuf.h"
+#include "hashing/xx.h"
+#include "random/generators.h"
+#include "reflection/adl.h"
+
+#include <seastar/core/loop.hh>
+#include <seastar/core/metrics_api.hh>
+#include <seastar/core/smp.hh>
+#include <seastar/http/handlers.hh>
+
+#include <absl/container/flat_hash_map.h>
+#include <boost/range/irange.hpp>
+#include <fmt/format.h>
+
+namespace prometheus {
+
+namespace mi = ss::metrics::impl;
+
+namespace {
+
+/*
+ * wire format (integers are little endian, the broker's native order):
+ *
+ *   u32 magic "RPMS"
+ *   u8  format version
+ *   u8  has_metadata
+ *   u64 session id
+ *   u64 metadata version
+ *   u32 shard count
+ *   per shard:
+ *     [has_metadata] u32 length + metadata block
+ *     u32 length + values block
+ *
+ * a metadata block lists metric families (name, type, per metric label
+ * set) in a fixed order. the matching values block packs one sample per
+ * metric in exactly that order with no per-sample framing: gauges are
+ * doubles, histograms carry their bucket vectors, everything else is a
+ * u64. a client decodes values against the metadata of the same version
+ * and re-requests metadata when the version moves.
+ */
+constexpr uint32_t snapshot_magic = 0x52504d53; // "RPMS"
+constexpr uint8_t snapshot_format_version = 1;
+// a scraper holds one session per broker; bound the table so misbehaving
+// clients cannot grow it without limit
+constexpr size_t max_sessions = 64;
+
+/*
+ * one shard's serialized metadata block. seastar rebuilds its metadata
+ * snapshot only when metric registrations change, so the snapshot's
+ * identity doubles as a change detector: serialization and hashing run
+ * once per registration change instead of once per scrape.
+ */
+struct metadata_cache {
+    const void* source{nullptr};
+    uint64_t version{0};
+    bytes serialized;
+};
+
+metadata_cache& shard_metadata_cache() {
+    static thread_local metadata_cache cache;
+    return cache;
+}
+
+/// session id -> combined metadata version last sent on that session.
+/// sessions are shard local: an http connection is served by one shard
+/// and scrapers reuse their connection.
+absl::flat_hash_map<uint64_t, uint64_t>& shard_sessions() {
+    static thread_local absl::flat_hash_map<uint64_t, uint64_t> sessions;
+    return sessions;
+}
+
+void serialize_metadata(iobuf& out, const mi::metric_metadata& metadata) {
+    reflection::serialize(out, uint32_t(metadata.size()));
+    for (const auto& family : metadata) {
+        uint32_t enabled = 0;
+        for (const auto& metric : family.metrics) {
+            enabled += metric.enabled ? 1 : 0;
+        }
+        reflection::serialize(
+          out,
+          ss::sstring(family.mf.name),
+          uint8_t(family.mf.type),
+          enabled);
+        for (const auto& metric : family.metrics) {
+            if (!metric.enabled) {
+                continue;
+            }
+            reflection::serialize(out, uint32_t(metric.id.labels().size()));
+            for (const auto& [key, value] : metric.id.labels()) {
+                reflection::serialize(
+                  out, ss::sstring(key), ss::sstring(value));
+            }
+        }
+    }
+}
+
+void serialize_values(iobuf& out, const mi::values_copy& copy) {
+    const auto& metadata = *copy.metadata;
+    for (size_t i = 0; i < metadata.size(); ++i) {
+        const auto type = metadata[i].mf.type;
+        for (size_t j = 0; j < metadata[i].metrics.size(); ++j) {
+            if (!metadata[i].metrics[j].enabled) {
+                continue;
+            }
+            const auto& value = copy.values[i][j];
+            switch (type) {
+            case mi::data_type::GAUGE:
+                reflection::serialize(out, value.d());
+                break;
+            case mi::data_type::HISTOGRAM: {
+                const auto& h = value.get_histogram();
+                reflection::serialize(
+                  out,
+                  h.sample_count,
+                  h.sample_sum,
+                  uint32_t(h.buckets.size()));
+                for (const auto& b : h.buckets) {
+                    reflection::serialize(out, b.upper_bound, b.count);
+                }
+                break;
+            }
+            default:
+                reflection::serialize(out, value.ui());
+                break;
+            }
+        }
+    }
+}
+
+struct shard_snapshot {
+    uint64_t version{0};
+    bytes values;
+};
+
+shard_snapshot make_shard_snapshot() {
+    auto copy = mi::get_values();
+    auto& cache = shard_metadata_cache();
+    if (cache.source != static_cast<const void*>(copy->metadata.get())) {
+        iobuf md;
+        serialize_metadata(md, *copy->metadata);
+        incremental_xxhash64 hasher;
+        for (const auto& f : md) {
+            hasher.update(f.get(), f.size());
+        }
+        cache.source = copy->metadata.get();
+        cache.version = hasher.digest();
+        cache.serialized = iobuf_to_bytes(md);
+    }
+    iobuf values;
+    serialize_values(values, *copy);
+    return shard_snapshot{
+      .version = cache.version, .values = iobuf_to_bytes(values)};
+}
+
+ss::future<std::vector<shard_snapshot>> gather_snapshots() {
+    return ss::do_with(
+      std::vector<shard_snapshot>(ss::smp::count),
+      [](std::vector<shard_snapshot>& snapshots) {
+          return ss::parallel_for_each(
+                   boost::irange<unsigned>(0, ss::smp::count),
+                   [&snapshots](unsigned shard) {
+                       return ss::smp::submit_to(shard, make_shard_snapshot)
+                         .then([&snapshots, shard](shard_snapshot s) {
+                             snapshots[shard] = std::move(s);
+                         });
+                   })
+            .then([&snapshots] { return std::move(snapshots); });
+      });
+}
+
+/*
+ * second round trip taken only for new sessions or after a metadata
+ * change. values are re-taken together with the metadata blocks so the
+ * two cannot disagree if registrations move between the rounds; the
+ * metadata itself is served from the per shard cache.
+ */
+ss::future<std::vector<bytes>>
+gather_metadata(std::vector<shard_snapshot>& snapshots) {
+    return ss::do_with(
+      std::vector<bytes>(ss::smp::count),
+      [&snapshots](std::vector<bytes>& blocks) {
+          return ss::parallel_for_each(
+                   boost::irange<unsigned>(0, ss::smp::count),
+                   [&snapshots, &blocks](unsigned shard) {
+                       return ss::smp::submit_to(
+                                shard,
+                                [] {
+                                    auto snapshot = make_shard_snapshot();
+                                    return std::make_pair(
+                                      std::move(snapshot),
+                                      bytes(
+                                        shard_metadata_cache().serialized));
+                                })
+                         .then([&snapshots, &blocks, shard](auto p) {
+                             snapshots[shard] = std::move(p.first);
+                             blocks[shard] = std::move(p.second);
+                         });
+                   })
+            .then([&blocks] { return std::move(blocks); });
+      });
+}
+
+uint64_t combined_version(const std::vector<shard_snapshot>& snapshots) {
+    incremental_xxhash64 hasher;
+    for (const auto& s : snapshots) {
+        hasher.update(s.version);
+    }
+    return hasher.digest();
+}
+
+ss::sstring iobuf_to_body(const iobuf& in) {
+    auto out = ss::uninitialized_string(in.size_bytes());
+    iobuf::iterator_consumer it(in.cbegin(), in.cend());
+    it.consume_to(in.size_bytes(), out.data());
+    return out;
+}
+
+ss::sstring make_response_body(
+  uint64_t session_id,
+  uint64_t version,
+  const std::vector<shard_snapshot>& snapshots,
+  const std::vector<bytes>& metadata) {
+    const uint8_t has_metadata = metadata.empty() ? 0 : 1;
+    iobuf out;
+    reflection::serialize(
+      out,
+      snapshot_magic,
+      snapshot_format_version,
+      has_metadata,
+      session_id,
+      version,
+      uint32_t(snapshots.size()));
+    for (size_t shard = 0; shard < snapshots.size(); ++shard) {
+        if (has_metadata) {
+            reflection::serialize(out, uint32_t(metadata[shard].size()));
+            out.append(
+              // NOLINTNEXTLINE
+              reinterpret_cast<const char*>(metadata[shard].data()),
+              metadata[shard].size());
+        }
+        reflection::serialize(out, uint32_t(snapshots[shard].values.size()));
+        out.append(
+          // NOLINTNEXTLINE
+          reinterpret_cast<const char*>(snapshots[shard].values.data()),
+          snapshots[shard].values.size());
+    }
+    return iobuf_to_body(out);
+}
+
+class snapshot_handler final : public ss::httpd::handler_base {
+public:
+    ss::future<std::unique_ptr<ss::httpd::reply>> handle(
+      const ss::sstring&,
+      std::unique_ptr<ss::httpd::request> req,
+      std::unique_ptr<ss::httpd::reply> rep) final {
+        std::optional<uint64_t> session;
+        if (auto s = req->get_query_param("session"); !s.empty()) {
+            try {
+                session = std::stoull(s);
+            } catch (...) {
+                throw ss::httpd::bad_param_exception(
+                  fmt::format("Invalid session id: {}", s));
+            }
+        }
+        return gather_snapshots().then(
+          [session, rep = std::move(rep)](
+            std::vector<shard_snapshot> snapshots) mutable {
+              const auto version = combined_version(snapshots);
+              auto& sessions = shard_sessions();
+              uint64_t session_id;
+              bool send_metadata = true;
+              if (session && sessions.contains(*session)) {
+                  session_id = *session;
+                  send_metadata = sessions[session_id] != version;
+              } else {
+                  if (sessions.size() >= max_sessions) {
+                      // evicted scrapers transparently re-fetch metadata
+                      sessions.clear();
+                  }
+                  session_id = random_generators::get_int<uint64_t>();
+              }
+              if (!send_metadata) {
+                  sessions[session_id] = version;
+                  auto body = make_response_body(
+                    session_id, version, snapshots, {});
+                  return finish(std::move(rep), std::move(body));
+              }
+              return ss::do_with(
+                std::move(snapshots),
+                [session_id, rep = std::move(rep)](
+                  std::vector<shard_snapshot>& snapshots) mutable {
+                    return gather_metadata(snapshots)
+                      .then([session_id, &snapshots, rep = std::move(rep)](
+                              std::vector<bytes> metadata) mutable {
+                          // re-taken together with the metadata blocks
+                          const auto version = combined_version(snapshots);
+                          shard_sessions()[session_id] = version;
+                          auto body = make_response_body(
+                            session_id, version, snapshots, metadata);
+                          return finish(std::move(rep), std::move(body));
+                      });
+                });
+          });
+    }
+
+private:
+    static ss::future<std::unique_ptr<ss::httpd::reply>>
+    finish(std::unique_ptr<ss::httpd::reply> rep, ss::sstring body) {
+        rep->set_mime_type("application/octet-stream");
+        rep->_content = std::move(body);
+        rep->done();
+        return ss::make_ready_future<std::unique_ptr<ss::httpd::reply>>(
+          std::move(rep));
+    }
+};
+
+} // namespace
+
+ss::future<> add_metrics_snapshot_routes(ss::sharded<ss::http_server>& server) {
+    return server.invoke_on_all([](ss::http_server& s) {
+        s._routes.put(
+          ss::httpd::operation_type::GET,
+          "/metrics_snapshot",
+          new snapshot_handler());
+    });
+}
+
+} // namespace prometheus
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/http/httpd.hh>
+
+namespace prometheus {
+
+/**
+ * Registers GET /metrics_snapshot on every shard of the admin server.
+ *
+ * The endpoint is a binary columnar sibling of the prometheus text
+ * endpoint for high frequency scraping. Metric metadata (family names,
+ * types and label sets) is sent once per scrape session; subsequent
+ * scrapes on the same session stream only the sample values as packed
+ * arrays gathered per shard, with no string formatting on the hot path.
+ * When metric registrations change (e.g. a partition is added) the next
+ * response carries a fresh metadata block and version.
+ */
+ss::future<> add_metrics_snapshot_routes(ss::sharded<ss::http_server>&);
+
+} // namespace prometheus
@@ -26,7 +26,11 @@ bool group_nodes::contains(model::node_id id) const {
         return true;
     }
     auto l_it = std::find(std::cbegin(learners), std::cend(learners), id);
-    return l_it != learners.cend();
+    if (l_it != learners.cend()) {
+        return true;
+    }
+    auto o_it = std::find(std::cbegin(observers), std::cend(observers), id);
+    return o_it != observers.cend();
 }
 
 group_configuration::group_configuration(std::vector<model::broker> brokers)
@@ -83,6 +87,22 @@ bool group_configuration::is_voter(model::node_id id) const {
     return old_it != std::cend(_old->voters);
 }
 
+bool group_configuration::is_observer(model::node_id id) const {
+    auto it = std::find(
+      std::cbegin(_current.observers), std::cend(_current.observers), id);
+
+    if (it != std::cend(_current.observers)) {
+        return true;
+    }
+    if (!_old) {
+        return false;
+    }
+    auto old_it = std::find(
+      std::cbegin(_old->observers), std::cend(_old->observers), id);
+
+    return old_it != std::cend(_old->observers);
+}
+
 bool group_configuration::contains_broker(model::node_id id) const {
     auto it = std::find_if(
       std::cbegin(_brokers),
@@ -125,6 +145,10 @@ std::vector<model::node_id> group_configuration::unique_learner_ids() const {
     auto old_learners = _old ? _old->learners : std::vector<model::node_id>();
     return unique_ids(_current.learners, old_learners);
 }
+std::vector<model::node_id> group_configuration::unique_observer_ids() const {
+    auto old_observers = _old ? _old->observers : std::vector<model::node_id>();
+    return unique_ids(_current.observers, old_observers);
+}
 
 void erase_id(std::vector<model::node_id>& v, model::node_id id) {
     auto it = std::find(std::cbegin(v), std::cend(v), id);
@@ -176,6 +200,7 @@ void group_configuration::remove(const std::vector<model::node_id>& ids) {
     for (auto& id : ids) {
         erase_id(new_cfg.learners, id);
         erase_id(new_cfg.voters, id);
+        erase_id(new_cfg.observers, id);
     }
 
     _old = std::move(_current);
@@ -255,6 +280,10 @@ void group_configuration::discard_old_config() {
     for (auto& id : _current.voters) {
         ids.insert(id);
     }
+
+    for (auto& id : _current.observers) {
+        ids.insert(id);
+    }
     // remove unused brokers from brokers set
     auto it = std::stable_partition(
       std::begin(_brokers), std::end(_brokers), [ids](const model::broker& b) {
@@ -279,6 +308,54 @@ void group_configuration::update(model::broker broker) {
     *it = std::move(broker);
 }
 
+void group_configuration::add_observer(model::broker broker) {
+    if (unlikely(contains_broker(broker.id()))) {
+        throw std::invalid_argument(fmt::format(
+          "broker {} already present in current configuration {}",
+          broker.id(),
+          *this));
+    }
+    // observers never change the majority, no need for joint consensus
+    _current.observers.push_back(broker.id());
+    _brokers.push_back(std::move(broker));
+}
+
+void group_configuration::remove_observer(model::node_id id) {
+    auto it = std::find(
+      std::cbegin(_current.observers), std::cend(_current.observers), id);
+    if (unlikely(it == std::cend(_current.observers))) {
+        throw std::invalid_argument(fmt::format(
+          "observer {} not found in current configuration {}", id, *this));
+    }
+    _current.observers.erase(it);
+    if (_old) {
+        erase_id(_old->observers, id);
+    }
+    // drop the broker unless it is still referenced by the old configuration
+    if (!_old || !_old->contains(id)) {
+        auto broker_it = std::find_if(
+          std::cbegin(_brokers),
+          std::cend(_brokers),
+          [id](const model::broker& n) { return id == n.id(); });
+        if (broker_it != std::cend(_brokers)) {
+            _brokers.erase(broker_it);
+        }
+    }
+}
+
+void group_configuration::promote_observer(model::node_id id) {
+    auto it = std::find(
+      std::cbegin(_current.observers), std::cend(_current.observers), id);
+    if (unlikely(it == std::cend(_current.observers))) {
+        throw std::invalid_argument(fmt::format(
+          "observer {} not found in current configuration {}", id, *this));
+    }
+    // move to learners, the regular catch-up promotion path
+    // (promote_to_voter) finishes the transition to voter
+    _current.observers.erase(it);
+    _current.learners.push_back(id);
+}
+
 std::ostream& operator<<(std::ostream& o, const group_configuration& c) {
     fmt::print(
       o,
@@ -290,7 +367,12 @@ std::ostream& operator<<(std::ostream& o, const group_configuration& c) {
 }
 
 std::ostream& operator<<(std::ostream& o, const group_nodes& n) {
-    fmt::print(o, "{{voters: {}, learners: {}}}", n.voters, n.learners);
+    fmt::print(
+      o,
+      "{{voters: {}, learners: {}, observers: {}}}",
+      n.voters,
+      n.learners,
+      n.observers);
     return o;
 }
 
@@ -300,7 +382,8 @@ std::ostream& operator<<(std::ostream& o, const offset_configuration& c) {
 }
 
 bool operator==(const group_nodes& a, const group_nodes& b) {
-    return a.learners == b.learners && a.voters == b.voters;
+    return a.learners == b.learners && a.voters == b.voters
+           && a.observers == b.observers;
 }
 
 bool operator==(const group_configuration& a, const group_configuration& b) {
@@ -321,17 +404,36 @@ void adl<raft::group_configuration>::to(
       cfg.old_config());
 }
 
+namespace {
+// version 0 predates group_nodes::observers, the field walk would
+// otherwise expect the observers vector to be present on the wire
+raft::group_nodes group_nodes_v0(iobuf_parser& p) {
+    raft::group_nodes n;
+    n.voters = adl<std::vector<model::node_id>>{}.from(p);
+    n.learners = adl<std::vector<model::node_id>>{}.from(p);
+    return n;
+}
+} // namespace
+
 raft::group_configuration
 adl<raft::group_configuration>::from(iobuf_parser& p) {
     auto version = adl<uint8_t>{}.from(p);
-    // currently we support only version 1
     vassert(
-      version == raft::group_configuration::current_version,
-      "Version {} is not supported. We only support version {}",
+      version <= raft::group_configuration::current_version,
+      "Version {} is not supported. We only support versions up to {}",
       version,
       raft::group_configuration::current_version);
 
     auto brokers = adl<std::vector<model::broker>>{}.from(p);
+    if (version == 0) {
+        auto current = group_nodes_v0(p);
+        std::optional<raft::group_nodes> old;
+        if (adl<int8_t>{}.from(p) != 0) {
+            old = group_nodes_v0(p);
+        }
+        return raft::group_configuration(
+          std::move(brokers), std::move(current), std::move(old));
+    }
     auto current = adl<raft::group_nodes>{}.from(p);
     auto old = adl<std::optional<raft::group_nodes>>{}.from(p);
     return raft::group_configuration(
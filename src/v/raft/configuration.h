@@ -27,6 +27,14 @@ enum class configuration_type : uint8_t { simple, joint };
 struct group_nodes {
     std::vector<model::node_id> voters;
     std::vector<model::node_id> learners;
+    /**
+     * observers are permanent non-voting replicas. like learners they
+     * receive the log through the regular append entries/recovery stream,
+     * but they never count toward the quorum, never request votes and are
+     * never promoted automatically. they only leave the observer role
+     * through an explicit promote_observer call.
+     */
+    std::vector<model::node_id> observers;
 
     bool contains(model::node_id id) const;
     friend std::ostream& operator<<(std::ostream&, const group_nodes&);
@@ -35,7 +43,8 @@ struct group_nodes {
 
 class group_configuration final {
 public:
-    static constexpr int8_t current_version = 0;
+    // version 1: added group_nodes::observers
+    static constexpr int8_t current_version = 1;
     /**
      * creates a configuration where all provided brokers are current
      * configuration voters
@@ -65,6 +74,12 @@ public:
      */
     bool is_voter(model::node_id) const;
 
+    /**
+     * Check if node with given id is an observer (permanent non-voting
+     * replica) in either the current or the old configuration
+     */
+    bool is_observer(model::node_id) const;
+
     /**
      * Configuration manipulation API. Each operation cause the configuration to
      * become joint configuration.
@@ -79,6 +94,16 @@ public:
      */
     void update(model::broker);
 
+    /**
+     * Observer manipulation. Adding or removing an observer does not require
+     * entering joint consensus as observers never participate in the
+     * majority. Promoting an observer moves it to the learner set so the
+     * regular catch-up promotion path takes it the rest of the way to voter.
+     */
+    void add_observer(model::broker);
+    void remove_observer(model::node_id);
+    void promote_observer(model::node_id);
+
     /**
      * Discards the old configuration, after this operation joint configuration
      * become simple
@@ -102,6 +127,9 @@ public:
     template<typename Func>
     void for_each_learner(Func&& f) const;
 
+    template<typename Func>
+    void for_each_observer(Func&& f) const;
+
     /**
      * Return largest value for which every server in a quorum (majority) has a
      * value greater than or equal to.
@@ -141,6 +169,7 @@ public:
 private:
     std::vector<model::node_id> unique_voter_ids() const;
     std::vector<model::node_id> unique_learner_ids() const;
+    std::vector<model::node_id> unique_observer_ids() const;
 
     uint8_t _version = current_version;
     std::vector<model::broker> _brokers;
@@ -232,6 +261,12 @@ void group_configuration::for_each_learner(Func&& f) const {
     std::for_each(ids.begin(), ids.end(), std::forward<Func>(f));
 }
 
+template<typename Func>
+void group_configuration::for_each_observer(Func&& f) const {
+    auto ids = unique_observer_ids();
+    std::for_each(ids.begin(), ids.end(), std::forward<Func>(f));
+}
+
 struct offset_configuration {
     offset_configuration(model::offset o, group_configuration c)
       : offset(o)
@@ -15,6 +15,7 @@
 #include "raft/types.h"
 #include "reflection/adl.h"
 #include "storage/kvstore.h"
+#include "vassert.h"
 #include "vlog.h"
 
 #include <absl/container/btree_map.h>
@@ -32,6 +33,17 @@ configuration_manager::configuration_manager(
   , _ctxlog(log) {
     vlog(_ctxlog.trace, "Initial configuration: {}", initial_cfg);
     _configurations.emplace(model::offset{}, std::move(initial_cfg));
+    rebuild_offset_index();
+}
+
+void configuration_manager::rebuild_offset_index() {
+    _offset_index.clear();
+    _offset_index.reserve(_configurations.size());
+    // btree iteration is in key order, the index is sorted by construction
+    for (const auto& [offset, cfg] : _configurations) {
+        _offset_index.push_back(offset);
+    }
+    _mru_cache.reset();
 }
 
 ss::future<> configuration_manager::truncate(model::offset offset) {
@@ -46,6 +58,7 @@ ss::future<> configuration_manager::truncate(model::offset offset) {
     return _lock.with([this, offset] {
         auto it = _configurations.lower_bound(offset);
         _configurations.erase(it, _configurations.end());
+        rebuild_offset_index();
 
         _highest_known_offset = std::min(offset, _highest_known_offset);
         return store_highest_known_offset().then(
@@ -67,6 +80,7 @@ ss::future<> configuration_manager::prefix_truncate(model::offset offset) {
                 get_latest_offset())));
         }
         _configurations.erase(_configurations.begin(), it);
+        rebuild_offset_index();
         _highest_known_offset = std::max(offset, _highest_known_offset);
         return store_highest_known_offset().then(
           [this] { return store_configurations(); });
@@ -82,6 +96,7 @@ void configuration_manager::add_configuration(
           "already exists",
           offset));
     }
+    rebuild_offset_index();
 }
 
 ss::future<>
@@ -138,17 +153,39 @@ model::offset configuration_manager::get_latest_offset() const {
 
 std::optional<group_configuration>
 configuration_manager::get(model::offset offset) const {
-    auto it = _configurations.lower_bound(offset);
-    if (it != _configurations.end() && it->first == offset) {
-        return it->second;
+    if (unlikely(_offset_index.empty())) {
+        return std::nullopt;
     }
-    // we are returning previous configuration as this is the one that was
-    // active for requested offset
-    if (it != _configurations.begin()) {
-        return std::prev(it)->second;
+    // hot path - the vast majority of queries are at or beyond the latest
+    // configuration offset
+    if (offset >= _offset_index.back()) {
+        return get_latest();
     }
-
-    return std::nullopt;
+    // branchless binary search for the greatest configuration offset that
+    // is not larger than the requested one. the comparison result feeds an
+    // arithmetic update of the base pointer (cmov) instead of a branch, so
+    // long membership histories do not cost a chain of mispredictions
+    const model::offset* base = _offset_index.data();
+    size_t n = _offset_index.size();
+    while (n > 1) {
+        const size_t half = n / 2;
+        base += (base[half - 1] <= offset) ? half : 0;
+        n -= half;
+    }
+    if (*base > offset) {
+        // all known configurations are newer than the requested offset
+        return std::nullopt;
+    }
+    if (_mru_cache && _mru_cache->first == *base) {
+        return _mru_cache->second;
+    }
+    auto it = _configurations.find(*base);
+    vassert(
+      it != _configurations.end(),
+      "offset index out of sync with configuration map at offset {}",
+      *base);
+    _mru_cache = std::make_pair(*base, it->second);
+    return it->second;
 }
 
 ss::future<iobuf> serialize_configurations(
@@ -226,7 +263,11 @@ ss::future<> configuration_manager::store_highest_known_offset() {
 
 ss::future<> configuration_manager::stop() {
     _config_changed.broken();
-    return ss::now();
+    // drain any in-flight background write, then persist the current
+    // watermark so a graceful restart does not re-read the log tail
+    return _gate.close().then([this] {
+        return flush_highest_known_offset();
+    });
 }
 
 ss::future<> configuration_manager::start(bool reset) {
@@ -250,6 +291,7 @@ ss::future<> configuration_manager::start(bool reset) {
             f = deserialize_configurations(std::move(*map_buf))
                   .then([this](underlying_t cfgs) {
                       _configurations = std::move(cfgs);
+                      rebuild_offset_index();
                       if (!_configurations.empty()) {
                           _highest_known_offset
                             = _configurations.rbegin()->first;
@@ -281,7 +323,30 @@ ss::future<> configuration_manager::maybe_store_highest_known_offset(
     }
 
     _bytes_since_last_offset_update = 0;
-    return store_highest_known_offset();
+    // the watermark is a recovery hint, not correctness state: a stale
+    // value only means reading more of the log on startup. persist it in
+    // the background so bulk replication never waits on the kv-store
+    dispatch_background_offset_flush();
+    return ss::now();
+}
+
+void configuration_manager::dispatch_background_offset_flush() {
+    if (_hko_flush_pending || _gate.is_closed()) {
+        return;
+    }
+    _hko_flush_pending = true;
+    (void)ss::with_gate(_gate, [this] {
+        // serialize with truncations so an in-flight write can not
+        // clobber a lowered watermark with a stale higher one
+        return _lock.with([this] { return store_highest_known_offset(); })
+          .finally([this] { _hko_flush_pending = false; });
+    }).handle_exception([this](const std::exception_ptr& e) {
+        vlog(_ctxlog.warn, "Unable to store highest known offset - {}", e);
+    });
+}
+
+ss::future<> configuration_manager::flush_highest_known_offset() {
+    return _lock.with([this] { return store_highest_known_offset(); });
 }
 
 ss::future<offset_configuration> configuration_manager::wait_for_change(
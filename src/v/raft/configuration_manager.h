@@ -22,6 +22,7 @@
 #include <seastar/core/condition-variable.hh>
 #include <seastar/core/future-util.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
 
 #include <absl/container/btree_map.h>
 
@@ -100,14 +101,24 @@ public:
     model::offset get_latest_offset() const;
 
     /**
-     * Persist highest known offset to KV store when stored bytes threshold has
-     * been reached. The first argument is an offset that was appended to the
-     * log. The second method argument is number of bytes persisted to disk in
-     * last append. Configuration manager tracks number of bytes that were
-     * appended since last write of `highest_known_offset` to kv-store
+     * Update highest known offset. The first argument is an offset that was
+     * appended to the log. The second method argument is number of bytes
+     * persisted to disk in last append. Configuration manager tracks number
+     * of bytes that were appended since last write of `highest_known_offset`
+     * to kv-store. The in-memory watermark is updated immediately; the
+     * kv-store write is dispatched in the background when the stored bytes
+     * threshold has been reached, so the append path never waits on it. The
+     * watermark is a recovery hint - see start() for how a stale value is
+     * tolerated.
      */
     ss::future<> maybe_store_highest_known_offset(model::offset, size_t);
 
+    /**
+     * Force persistence of the current highest known offset. Used on
+     * shutdown so a graceful restart does not have to re-read the log tail.
+     */
+    ss::future<> flush_highest_known_offset();
+
     /**
      * Returns the highest offset for which the configuration manager
      * contains valid configuration set. Beyond that offset log has to be
@@ -140,13 +151,33 @@ private:
 
     ss::future<> store_configurations();
     ss::future<> store_highest_known_offset();
+    void dispatch_background_offset_flush();
     bytes configurations_map_key();
     bytes highest_known_offset_key();
 
     void add_configuration(model::offset, group_configuration);
 
+    /**
+     * Rebuilds the flat offset index from the configuration map and drops
+     * the MRU cache. Called after every mutation; mutations (membership
+     * changes, truncations) are rare while lookups are on the append hot
+     * path, so we optimize the index for reads.
+     */
+    void rebuild_offset_index();
+
     raft::group_id _group;
     underlying_t _configurations;
+    /**
+     * Sorted flat array of the configuration offsets. Configuration-at-offset
+     * queries binary search this array (branchless, cache friendly) instead
+     * of walking the btree; the map is only consulted to materialize the
+     * matched configuration.
+     */
+    std::vector<model::offset> _offset_index;
+    // one entry MRU cache - the vast majority of queries resolve to the same
+    // configuration that the previous one did
+    mutable std::optional<std::pair<model::offset, group_configuration>>
+      _mru_cache;
     /**
      * The highest know offset is latest offset for which configuration manager
      * has all configurations. In other words, some configuration may be in the
@@ -161,6 +192,10 @@ private:
      * bootstrap redpanda will have to read up to 64MB per raft group.
      */
     size_t _bytes_since_last_offset_update = 0;
+    // true while a background watermark write is queued or in flight;
+    // coalesces threshold trips into a single kv-store put
+    bool _hko_flush_pending = false;
+    ss::gate _gate;
     ctx_log& _ctxlog;
 };
 } // namespace raft
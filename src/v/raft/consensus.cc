@@ -74,6 +74,7 @@ consensus::consensus(
         maybe_step_down();
         dispatch_vote(false);
     });
+    _flush_timeout.set_callback([this] { dispatch_flush_with_lock(); });
 }
 
 void consensus::setup_metrics() {
@@ -94,9 +95,43 @@ void consensus::setup_metrics() {
         labels)});
 }
 
+void consensus::set_vote_state(vote_state s) {
+    if (_vstate != s) {
+        ++_leadership_epoch;
+        _vstate = s;
+    }
+}
+
 void consensus::do_step_down() {
     _hbeat = clock_type::now();
-    _vstate = vote_state::follower;
+    set_vote_state(vote_state::follower);
+}
+
+bool consensus::has_leader_lease() const {
+    if (_vstate != vote_state::leader) {
+        return false;
+    }
+    /**
+     * the lease is anchored at the local send time of the last request
+     * each follower acked. the follower restarted its election timer when
+     * that request arrived - no earlier than its dispatch - so no quorum
+     * member can grant a vote to a competing candidate before
+     * anchor + base election timeout. anchoring at the ack's receive time
+     * would overshoot by a network one-way delay.
+     */
+    auto majority_ack_sent = config().quorum_match([this](model::node_id id) {
+        if (id == _self) {
+            return clock_type::now();
+        }
+        if (!_fstats.contains(id)) {
+            return clock_type::time_point::min();
+        }
+        return _fstats.get(id).last_acked_append_timestamp;
+    });
+    if (majority_ack_sent < _became_leader_at) {
+        majority_ack_sent = _became_leader_at;
+    }
+    return majority_ack_sent + _jit.base_duration() > clock_type::now();
 }
 
 void consensus::maybe_step_down() {
@@ -124,9 +159,17 @@ void consensus::maybe_step_down() {
     });
 }
 
+void consensus::release_tail_pins() {
+    while (!_tail_pins.empty() && _tail_pins.front().first <= _commit_index) {
+        _tail_pins.pop_front();
+    }
+}
+
 ss::future<> consensus::stop() {
     vlog(_ctxlog.info, "Stopping");
     _vote_timeout.cancel();
+    _flush_timeout.cancel();
+    _tail_pins.clear();
     _as.request_abort();
     _commit_index_updated.broken();
     _disk_append.broken();
@@ -135,6 +178,7 @@ ss::future<> consensus::stop() {
       .then([this] { return _append_requests_buffer.stop(); })
       .then([this] { return _bg.close(); })
       .then([this] { return _batcher.stop(); })
+      .then([this] { return _configuration_manager.stop(); })
       .then([this] {
           // close writer if we have to
           if (likely(!_snapshot_writer)) {
@@ -149,7 +193,8 @@ consensus::success_reply consensus::update_follower_index(
   model::node_id node,
   result<append_entries_reply> r,
   follower_req_seq seq,
-  model::offset dirty_offset) {
+  model::offset dirty_offset,
+  clock_type::time_point sent_at) {
     // do not process replies when stoping
     if (unlikely(_as.abort_requested())) {
         return success_reply::no;
@@ -195,6 +240,10 @@ consensus::success_reply consensus::update_follower_index(
     }
 
     update_node_hbeat_timestamp(node);
+    // anchor for the leader lease: max() guards against reordered replies
+    // moving the anchor backwards
+    idx.last_acked_append_timestamp = std::max(
+      idx.last_acked_append_timestamp, sent_at);
 
     if (
       seq < idx.last_received_seq
@@ -297,6 +346,11 @@ void consensus::maybe_promote_to_voter(model::node_id id) {
         if (config().is_voter(id)) {
             return ss::now();
         }
+
+        // observers stay non-voting until explicitly promoted
+        if (config().is_observer(id)) {
+            return ss::now();
+        }
         auto it = _fstats.find(id);
 
         // already removed
@@ -329,9 +383,10 @@ void consensus::process_append_entries_reply(
   model::node_id node,
   result<append_entries_reply> r,
   follower_req_seq seq_id,
-  model::offset dirty_offset) {
+  model::offset dirty_offset,
+  clock_type::time_point sent_at) {
     auto is_success = update_follower_index(
-      node, std::move(r), seq_id, dirty_offset);
+      node, std::move(r), seq_id, dirty_offset, sent_at);
     if (is_success) {
         maybe_promote_to_voter(node);
         maybe_update_majority_replicated_index();
@@ -394,7 +449,8 @@ void consensus::dispatch_recovery(follower_index_metadata& idx) {
 
 ss::future<result<replicate_result>>
 consensus::replicate(model::record_batch_reader&& rdr, replicate_options opts) {
-    if (!is_leader() || unlikely(_transferring_leadership)) {
+    auto token = capture_leadership_token();
+    if (!token) {
         return seastar::make_ready_future<result<replicate_result>>(
           errc::not_leader);
     }
@@ -416,15 +472,23 @@ consensus::replicate(model::record_batch_reader&& rdr, replicate_options opts) {
     // For relaxed consistency, append data to leader disk without flush
     // asynchronous replication is provided by Raft protocol recovery mechanism.
     return _op_lock
-      .with([this, rdr = std::move(rdr)]() mutable {
-          if (!is_leader()) {
+      .with([this, token = *token, rdr = std::move(rdr)]() mutable {
+          /*
+           * commit-time validation of the optimistic leadership snapshot:
+           * a single epoch compare replaces re-deriving leadership from
+           * the voting state, and also rejects leadership lost and re-won
+           * while this request waited on the op lock - the token's term
+           * would then be stale. a valid epoch means the term is exactly
+           * token.term, so the batches are stamped from the token.
+           */
+          if (unlikely(!leadership_token_valid(token))) {
               return seastar::make_ready_future<result<replicate_result>>(
                 errc::not_leader);
           }
 
           return disk_append(model::make_record_batch_reader<
                                details::term_assigning_reader>(
-                               std::move(rdr), model::term_id(_term)))
+                               std::move(rdr), token.term))
             .then([this](storage::append_result res) {
                 // only update visibility upper bound if all quorum replicated
                 // entries are committed already
@@ -438,6 +502,21 @@ consensus::replicate(model::record_batch_reader&& rdr, replicate_options opts) {
                   replicate_result{.last_offset = res.last_offset});
             });
       })
+      .then([this](result<replicate_result> res) {
+          /*
+           * the caller is acked at append time; durability bookkeeping
+           * continues off the ack path. the deferred flush lets the
+           * leader account its own match offset so subsequent heartbeat
+           * rounds can replicate and commit the entries without a
+           * quorum_ack request forcing a flush first. back to back
+           * relaxed appends coalesce into one flush via
+           * _has_pending_flushes.
+           */
+          if (res) {
+              dispatch_flush_with_lock();
+          }
+          return res;
+      })
       .finally([this] { _probe.replicate_done(); });
 }
 
@@ -686,6 +765,40 @@ consensus::remove_members(std::vector<model::node_id> ids) {
       });
 }
 
+ss::future<std::error_code> consensus::add_observer(model::broker broker) {
+    vlog(_ctxlog.trace, "Adding observer: {}", broker);
+    return change_configuration(
+      [broker = std::move(broker)](group_configuration current) mutable {
+          if (current.contains_broker(broker.id())) {
+              return result<group_configuration>(errc::node_already_exists);
+          }
+          current.add_observer(std::move(broker));
+          return result<group_configuration>(std::move(current));
+      });
+}
+
+ss::future<std::error_code> consensus::remove_observer(model::node_id id) {
+    vlog(_ctxlog.trace, "Removing observer: {}", id);
+    return change_configuration([id](group_configuration current) {
+        if (!current.is_observer(id)) {
+            return result<group_configuration>(errc::node_does_not_exists);
+        }
+        current.remove_observer(id);
+        return result<group_configuration>(std::move(current));
+    });
+}
+
+ss::future<std::error_code> consensus::promote_observer(model::node_id id) {
+    vlog(_ctxlog.trace, "Promoting observer: {}", id);
+    return change_configuration([id](group_configuration current) {
+        if (!current.is_observer(id)) {
+            return result<group_configuration>(errc::node_does_not_exists);
+        }
+        current.promote_observer(id);
+        return result<group_configuration>(std::move(current));
+    });
+}
+
 ss::future<std::error_code>
 consensus::replace_configuration(std::vector<model::broker> new_brokers) {
     return change_configuration([new_brokers = std::move(new_brokers)](
@@ -1085,7 +1198,7 @@ consensus::do_append_entries(append_entries_request&& r) {
 
     // raft.pdf:If AppendEntries RPC received from new leader: convert to
     // follower (§5.2)
-    _vstate = vote_state::follower;
+    set_vote_state(vote_state::follower);
     if (unlikely(_leader_id != r.node_id)) {
         _leader_id = r.node_id;
         trigger_leadership_notification();
@@ -1554,6 +1667,20 @@ consensus::disk_append(model::record_batch_reader&& reader) {
           _disk_append.broadcast();
           auto& [ret, configurations] = t;
           _has_pending_flushes = true;
+          // keep the freshly appended batches pinned in the batch cache
+          // until the quorum commits them: follower dispatch and commit
+          // apply re-read this range immediately and must not lose it to
+          // a reclaim in the meantime
+          _tail_pins.emplace_back(
+            ret.last_offset,
+            _log.pin_cached_range(ret.base_offset, ret.last_offset));
+          if (quorum_durability() && !_flush_timeout.armed()) {
+              // quorum durability: nothing on the ack path will fsync
+              // this append, make it durable on the next interval
+              // boundary. covers leader and follower appends alike.
+              _flush_timeout.arm(
+                config::shard_local_cfg().raft_flush_interval_ms());
+          }
           // TODO
           // if we rolled a log segment. write current configuration
           // for speedy recovery in the background
@@ -1678,20 +1805,30 @@ consensus::do_maybe_update_leader_commit_idx(ss::semaphore_units<> u) {
     // If there exists an N such that N > commitIndex, a majority
     // of matchIndex[i] ≥ N, and log[N].term == currentTerm:
     // set commitIndex = N (§5.3, §5.4).
-    auto majority_match = config().quorum_match(
-      [this, committed_offset = lstats.committed_offset](model::node_id id) {
-          // current node - we just return commited offset
-          if (id == _self) {
-              return committed_offset;
-          }
-          return _fstats.get(id).match_committed_index();
-      });
+    /**
+     * with quorum durability replicas vote toward the commit quorum with
+     * their dirty (in memory) offsets - an entry is committed once a
+     * majority holds it, durability comes from the quorum itself and
+     * fdatasync runs on interval boundaries. with the default mode only
+     * flushed offsets count.
+     */
+    auto majority_match = config().quorum_match([this, lstats](
+                                                  model::node_id id) {
+        if (id == _self) {
+            return quorum_durability() ? lstats.dirty_offset
+                                       : lstats.committed_offset;
+        }
+        auto& idx = _fstats.get(id);
+        return quorum_durability() ? idx.match_index
+                                   : idx.match_committed_index();
+    });
     if (
       majority_match > _commit_index
       && _log.get_term(majority_match) == _term) {
         vlog(_ctxlog.trace, "Leader commit index updated {}", majority_match);
         auto old_commit_idx = _commit_index;
         _commit_index = majority_match;
+        release_tail_pins();
         auto range_start = details::next_offset(model::offset(old_commit_idx));
         vlog(
           _ctxlog.trace,
@@ -1722,10 +1859,15 @@ consensus::maybe_update_follower_commit_idx(model::offset request_commit_idx) {
     // If leaderCommit > commitIndex, set commitIndex =
     // min(leaderCommit, index of last new entry)
     if (request_commit_idx > _commit_index) {
+        // with quorum durability entries count as soon as they are in the
+        // local log (dirty); the default mode requires them flushed
         auto new_commit_idx = std::min(
-          request_commit_idx, lstats.committed_offset);
+          request_commit_idx,
+          quorum_durability() ? lstats.dirty_offset
+                              : lstats.committed_offset);
         if (new_commit_idx != _commit_index) {
             _commit_index = new_commit_idx;
+            release_tail_pins();
             vlog(
               _ctxlog.trace, "Follower commit index updated {}", _commit_index);
             _commit_index_updated.broadcast();
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "hashing/crc32c.h"
+#include "likely.h"
 #include "model/fundamental.h"
 #include "model/metadata.h"
 #include "raft/configuration_manager.h"
@@ -27,6 +28,7 @@
 #include "raft/types.h"
 #include "rpc/connection_cache.h"
 #include "seastarx.h"
+#include "ssx/timer_wheel.h"
 #include "storage/api.h"
 #include "storage/log.h"
 #include "storage/snapshot.h"
@@ -36,6 +38,8 @@
 #include <seastar/core/sharded.hh>
 #include <seastar/util/bool_class.hh>
 
+#include <deque>
+
 namespace raft {
 class replicate_entries_stm;
 class vote_stm;
@@ -94,8 +98,58 @@ public:
     // Replace configuration of raft group with given set of nodes
     ss::future<std::error_code>
       replace_configuration(std::vector<model::broker>);
+    /// Adds a non-voting observer replica to the group. Observers receive
+    /// the log but never participate in quorum or elections
+    ss::future<std::error_code> add_observer(model::broker);
+    // Removes an observer replica from the group
+    ss::future<std::error_code> remove_observer(model::node_id);
+    /// Starts promotion of an observer. The observer becomes a learner and
+    /// is promoted to voter once it is caught up with the leader
+    ss::future<std::error_code> promote_observer(model::node_id);
 
     bool is_leader() const { return _vstate == vote_state::leader; }
+
+    /**
+     * Epoch-stamped leadership snapshot for optimistic append paths.
+     *
+     * The epoch counts voting state transitions, so a token captured
+     * while leader proves leadership continuity for as long as the
+     * epoch is unchanged: revalidating after a scheduling point (e.g.
+     * waiting on the op lock) is a single integer compare, and it also
+     * catches leadership that was lost and re-won with a higher term in
+     * the meantime. The token carries the term appended batches must be
+     * stamped with - a valid epoch guarantees the term has not moved.
+     */
+    struct leadership_token {
+        model::term_id term;
+        uint64_t epoch;
+    };
+
+    /// snapshot of the current leadership, or std::nullopt when this
+    /// node cannot accept appends
+    std::optional<leadership_token> capture_leadership_token() const {
+        if (
+          _vstate != vote_state::leader
+          || unlikely(_transferring_leadership)) {
+            return std::nullopt;
+        }
+        return leadership_token{.term = _term, .epoch = _leadership_epoch};
+    }
+
+    /// true when leadership has been held continuously since the token
+    /// was captured
+    bool leadership_token_valid(const leadership_token& t) const {
+        return _leadership_epoch == t.epoch;
+    }
+    /**
+     * True when this node holds a clock based leader lease. The lease spans
+     * the base election timeout counted from the moment a majority of the
+     * group last acknowledged this leader (heartbeats or appends). Until it
+     * expires no follower will grant a vote to a competing candidate, so
+     * reads served under the lease are guaranteed fresh with a single time
+     * comparison and no cross-node coordination.
+     */
+    bool has_leader_lease() const;
     bool is_candidate() const { return _vstate == vote_state::candidate; }
     std::optional<model::node_id> get_leader_id() const { return _leader_id; }
     model::node_id self() const { return _self; }
@@ -133,7 +187,8 @@ public:
       model::node_id,
       result<append_entries_reply>,
       follower_req_seq,
-      model::offset);
+      model::offset,
+      clock_type::time_point sent_at);
 
     ss::future<result<replicate_result>>
     replicate(model::record_batch_reader&&, replicate_options);
@@ -144,6 +199,11 @@ public:
 
     model::offset committed_offset() const { return _commit_index; }
     model::offset last_stable_offset() const;
+    model::offset dirty_offset() const { return _log.offsets().dirty_offset; }
+
+    /// replication queue depth of this group's batcher, in [0, 1]; input to
+    /// kafka produce admission control
+    double replicate_batcher_usage() const { return _batcher.usage(); }
 
     /**
      * Last visible index is an offset that is safe to be fetched by the
@@ -201,6 +261,17 @@ public:
 
     const storage::ntp_config& log_config() const { return _log.config(); }
 
+    /**
+     * true when this partition runs in raft_quorum durability mode:
+     * appends are acknowledged once a majority of replicas hold them in
+     * memory and fdatasync runs in the background on
+     * raft_flush_interval_ms boundaries instead of on the ack path
+     */
+    bool quorum_durability() const {
+        return _log.config().durability()
+               == storage::durability_mode::raft_quorum;
+    }
+
     /*
      * Attempt to transfer leadership to another node in this raft group. If no
      * node is specified, the most up-to-date node will be selected.
@@ -234,6 +305,9 @@ private:
     // all these private functions assume that we are under exclusive operations
     // via the _op_sem
     void do_step_down();
+    /// all voting state changes go through here so the leadership epoch
+    /// tracks them; see leadership_token
+    void set_vote_state(vote_state);
     ss::future<vote_reply> do_vote(vote_request&&);
     ss::future<append_entries_reply>
     do_append_entries(append_entries_request&&);
@@ -267,7 +341,8 @@ private:
       model::node_id,
       result<append_entries_reply>,
       follower_req_seq seq_id,
-      model::offset);
+      model::offset,
+      clock_type::time_point sent_at);
 
     void successfull_append_entries_reply(
       follower_index_metadata&, append_entries_reply);
@@ -332,6 +407,8 @@ private:
     bytes last_applied_key() const;
 
     void maybe_update_last_visible_index(model::offset);
+    /// drop batch cache pins the advancing commit index no longer needs
+    void release_tail_pins();
     void maybe_update_majority_replicated_index();
 
     void start_dispatching_disk_append_events();
@@ -376,8 +453,18 @@ private:
     clock_type::time_point _became_leader_at = clock_type::now();
     /// used to keep track if we are a leader, or transitioning
     vote_state _vstate = vote_state::follower;
-    /// used for votes only. heartbeats are done by heartbeat_manager
-    timer_type _vote_timeout;
+    /// bumped on every voting state transition; see leadership_token
+    uint64_t _leadership_epoch{0};
+    /// used for votes only. heartbeats are done by heartbeat_manager.
+    /// registered with the shard wide timer wheel so tens of thousands of
+    /// groups share a single seastar timer instead of one heap entry each
+    ssx::timer_wheel<clock_type>::timer _vote_timeout{
+      ssx::shard_timer_wheel<clock_type>()};
+    /// background fdatasync for raft_quorum durability mode. armed when
+    /// an append leaves unflushed data behind, fires at flush interval
+    /// boundaries
+    ssx::timer_wheel<clock_type>::timer _flush_timeout{
+      ssx::shard_timer_wheel<clock_type>()};
 
     /// used for keepint tally on followers
     follower_stats _fstats;
@@ -418,6 +505,15 @@ private:
      */
     model::offset _last_quorum_replicated_index;
     offset_monitor _consumable_offset_monitor;
+    /**
+     * Batch cache leases over the uncommitted tail, ordered by the last
+     * offset each append covered. Holding them keeps fresh batches memory
+     * resident under reclaim pressure so follower dispatch and commit
+     * apply never touch disk for just-appended data; released as the
+     * commit index advances past them.
+     */
+    std::deque<std::pair<model::offset, storage::batch_cache::pin_guard>>
+      _tail_pins;
     ss::condition_variable _disk_append;
     details::mutex_buffer<append_entries_request, append_entries_reply>
       _append_requests_buffer;
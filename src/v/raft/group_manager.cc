@@ -13,6 +13,8 @@
 #include "prometheus/prometheus_sanitize.h"
 #include "resource_mgmt/io_priority.h"
 
+#include <seastar/core/semaphore.hh>
+
 namespace raft {
 
 group_manager::group_manager(
@@ -35,15 +37,22 @@ ss::future<> group_manager::stop() {
     return _gate.close()
       .then([this] { return _heartbeats.stop(); })
       .then([this] {
-          return ss::parallel_for_each(
-            _groups,
-            [](ss::lw_shared_ptr<consensus> raft) { return raft->stop(); });
+          // bounded like start_groups: every stop flushes state to disk
+          // and a large node should not issue all of them at once
+          return ss::do_with(
+            ss::semaphore(max_concurrent_hydrations), [this](ss::semaphore& sem) {
+                return ss::parallel_for_each(
+                  _groups, [&sem](ss::lw_shared_ptr<consensus> raft) {
+                      return ss::with_semaphore(
+                        sem, 1, [raft] { return raft->stop(); });
+                  });
+            });
       });
 }
 
-ss::future<ss::lw_shared_ptr<raft::consensus>> group_manager::create_group(
+ss::lw_shared_ptr<raft::consensus> group_manager::make_consensus(
   raft::group_id id, std::vector<model::broker> nodes, storage::log log) {
-    auto raft = ss::make_lw_shared<raft::consensus>(
+    return ss::make_lw_shared<raft::consensus>(
       _self,
       id,
       raft::group_configuration(std::move(nodes)),
@@ -57,6 +66,11 @@ ss::future<ss::lw_shared_ptr<raft::consensus>> group_manager::create_group(
           trigger_leadership_notification(std::move(st));
       },
       _storage);
+}
+
+ss::future<ss::lw_shared_ptr<raft::consensus>> group_manager::create_group(
+  raft::group_id id, std::vector<model::broker> nodes, storage::log log) {
+    auto raft = make_consensus(id, std::move(nodes), log);
 
     return ss::with_gate(_gate, [this, raft] {
         return _heartbeats.register_group(raft).then([this, raft] {
@@ -66,6 +80,44 @@ ss::future<ss::lw_shared_ptr<raft::consensus>> group_manager::create_group(
     });
 }
 
+ss::future<std::vector<ss::lw_shared_ptr<raft::consensus>>>
+group_manager::create_groups(std::vector<group_args> args) {
+    return ss::with_gate(_gate, [this, args = std::move(args)]() mutable {
+        // no IO and no scheduling points: the whole batch is constructed
+        // in one pass and registered under a single heartbeat manager
+        // lock acquisition
+        std::vector<ss::lw_shared_ptr<consensus>> groups;
+        groups.reserve(args.size());
+        for (auto& a : args) {
+            groups.push_back(
+              make_consensus(a.id, std::move(a.nodes), std::move(a.log)));
+        }
+        return _heartbeats.register_groups(groups).then(
+          [this, groups]() mutable {
+              _groups.insert(_groups.end(), groups.begin(), groups.end());
+              return std::move(groups);
+          });
+    });
+}
+
+ss::future<> group_manager::start_groups(
+  std::vector<ss::lw_shared_ptr<raft::consensus>> groups) {
+    return ss::with_gate(_gate, [this, groups = std::move(groups)]() mutable {
+        return ss::do_with(
+          ss::semaphore(max_concurrent_hydrations),
+          std::move(groups),
+          [](
+            ss::semaphore& sem,
+            std::vector<ss::lw_shared_ptr<consensus>>& groups) {
+              return ss::parallel_for_each(
+                groups, [&sem](ss::lw_shared_ptr<consensus> raft) {
+                    return ss::with_semaphore(
+                      sem, 1, [raft] { return raft->start(); });
+                });
+          });
+    });
+}
+
 ss::future<> group_manager::remove(ss::lw_shared_ptr<raft::consensus> c) {
     return c->stop()
       .then([c] { return c->remove_persistent_state(); })
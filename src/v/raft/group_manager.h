@@ -47,6 +47,33 @@ public:
     ss::future<ss::lw_shared_ptr<raft::consensus>> create_group(
       raft::group_id id, std::vector<model::broker> nodes, storage::log log);
 
+    // everything needed to build one group, gathered up front so the bulk
+    // startup path can construct a whole batch in a single pass
+    struct group_args {
+        raft::group_id id;
+        std::vector<model::broker> nodes;
+        storage::log log;
+    };
+
+    /**
+     * bulk startup path. node startup brings up thousands of groups and
+     * paying per-group scheduling and locking costs serially dominates
+     * the boot time, so initialization is phased:
+     *
+     *  - create_groups constructs and registers consensus instances for
+     *    the whole batch without doing any IO. the persistent metadata
+     *    these constructors consult lives in the kvstore, which is fully
+     *    memory resident after storage::api::start, so there is no
+     *    per-group metadata read to batch.
+     *
+     *  - start_groups hydrates the groups' logs and snapshots from disk
+     *    with bounded parallelism: wide enough to saturate the disk,
+     *    bounded so a large node does not issue every read at once.
+     */
+    ss::future<std::vector<ss::lw_shared_ptr<raft::consensus>>>
+    create_groups(std::vector<group_args>);
+    ss::future<> start_groups(std::vector<ss::lw_shared_ptr<raft::consensus>>);
+
     ss::future<> remove(ss::lw_shared_ptr<raft::consensus>);
 
     cluster::notification_id_type
@@ -73,6 +100,12 @@ public:
     }
 
 private:
+    // concurrency of disk hydration in start_groups (and of group
+    // shutdown in stop)
+    static constexpr size_t max_concurrent_hydrations = 16;
+
+    ss::lw_shared_ptr<raft::consensus>
+    make_consensus(raft::group_id, std::vector<model::broker>, storage::log);
     void trigger_leadership_notification(raft::leadership_status);
     void setup_metrics();
 
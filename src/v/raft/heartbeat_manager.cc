@@ -16,6 +16,7 @@
 #include "raft/consensus_client_protocol.h"
 #include "raft/errc.h"
 #include "raft/raftgen_service.h"
+#include "likely.h"
 #include "raft/types.h"
 #include "rpc/reconnect_transport.h"
 #include "rpc/types.h"
@@ -32,8 +33,9 @@ ss::logger hbeatlog{"r/heartbeat"};
 using consensus_ptr = heartbeat_manager::consensus_ptr;
 using consensus_set = heartbeat_manager::consensus_set;
 
-static std::vector<heartbeat_manager::node_heartbeat> requests_for_range(
-  const consensus_set& c, clock_type::duration heartbeat_interval) {
+std::vector<heartbeat_manager::node_heartbeat>
+heartbeat_manager::requests_for_range() {
+    const consensus_set& c = _consensus_groups;
     absl::flat_hash_map<
       model::node_id,
       std::vector<std::pair<protocol_metadata, follower_req_seq>>>
@@ -42,7 +44,7 @@ static std::vector<heartbeat_manager::node_heartbeat> requests_for_range(
         return {};
     }
     auto self = (*c.begin())->self();
-    auto last_heartbeat = clock_type::now() - heartbeat_interval;
+    auto last_heartbeat = clock_type::now() - _heartbeat_interval;
     for (auto& ptr : c) {
         if (!ptr->is_leader()) {
             continue;
@@ -91,23 +93,46 @@ static std::vector<heartbeat_manager::node_heartbeat> requests_for_range(
     reqs.reserve(pending_beats.size());
     for (auto& p : pending_beats) {
         std::vector<protocol_metadata> requests;
+        std::vector<raft::group_id> unchanged;
         absl::flat_hash_map<
           raft::group_id,
           heartbeat_manager::follower_request_meta>
           meta_map;
         requests.reserve(p.second.size());
         meta_map.reserve(p.second.size());
+        // self beats are handled in process, delta encoding only pays off
+        // across the wire
+        hbeat_session* session = nullptr;
+        bool full_resync = true;
+        if (p.first != self) {
+            session = &_sessions[p.first];
+            full_resync = session->beats_since_full++ >= full_beat_interval;
+            if (full_resync) {
+                session->beats_since_full = 0;
+            }
+        }
         for (auto& [meta, seq] : p.second) {
             meta_map.emplace(
               meta.group,
               heartbeat_manager::follower_request_meta{
                 seq, meta.prev_log_index});
+            if (session && !full_resync) {
+                auto it = session->last_sent.find(meta.group);
+                if (it != session->last_sent.end() && it->second == meta) {
+                    // the receiver still has this metadata, ping the group
+                    // by id only
+                    unchanged.push_back(meta.group);
+                    continue;
+                }
+            }
+            if (session) {
+                session->last_sent[meta.group] = meta;
+            }
             requests.push_back(std::move(meta));
         }
-        reqs.emplace_back(
-          p.first,
-          heartbeat_request{self, std::move(requests)},
-          std::move(meta_map));
+        heartbeat_request req{self, std::move(requests)};
+        req.unchanged = std::move(unchanged);
+        reqs.emplace_back(p.first, std::move(req), std::move(meta_map));
     }
 
     return reqs;
@@ -149,7 +174,7 @@ heartbeat_manager::send_heartbeats(std::vector<node_heartbeat> reqs) {
 }
 
 ss::future<> heartbeat_manager::do_dispatch_heartbeats() {
-    auto reqs = requests_for_range(_consensus_groups, _heartbeat_interval);
+    auto reqs = requests_for_range();
     return send_heartbeats(std::move(reqs));
 }
 
@@ -167,11 +192,13 @@ ss::future<> heartbeat_manager::do_self_heartbeat(node_heartbeat&& r) {
             .group = meta.group,
             .result = append_entries_reply::status::success};
       });
-    process_reply(r.target, std::move(r.meta_map), std::move(reply));
+    process_reply(
+      r.target, std::move(r.meta_map), std::move(reply), clock_type::now());
     return ss::now();
 }
 
 ss::future<> heartbeat_manager::do_heartbeat(node_heartbeat&& r) {
+    auto sent_at = clock_type::now();
     auto f = _client_protocol.heartbeat(
       r.target,
       std::move(r.request),
@@ -179,9 +206,9 @@ ss::future<> heartbeat_manager::do_heartbeat(node_heartbeat&& r) {
         next_heartbeat_timeout(), rpc::compression_type::zstd, 512));
     _dispatch_sem.signal();
     return f
-      .then([node = r.target, groups = std::move(r.meta_map), this](
+      .then([node = r.target, groups = std::move(r.meta_map), sent_at, this](
               result<heartbeat_reply> ret) mutable {
-          process_reply(node, std::move(groups), std::move(ret));
+          process_reply(node, std::move(groups), std::move(ret), sent_at);
       })
       .handle_exception_type([](const ss::gate_closed_exception&) {});
 }
@@ -189,7 +216,8 @@ ss::future<> heartbeat_manager::do_heartbeat(node_heartbeat&& r) {
 void heartbeat_manager::process_reply(
   model::node_id n,
   absl::flat_hash_map<raft::group_id, follower_request_meta> groups,
-  result<heartbeat_reply> r) {
+  result<heartbeat_reply> r,
+  clock_type::time_point sent_at) {
     if (!r) {
         vlog(
           hbeatlog.trace,
@@ -197,6 +225,9 @@ void heartbeat_manager::process_reply(
           n,
           r,
           r.error().message());
+        // the receiver may not have seen the request, resend full metadata
+        // on the next beat
+        _sessions.erase(n);
         for (auto& [g, req_meta] : groups) {
             auto it = _consensus_groups.find(g);
             if (it == _consensus_groups.end()) {
@@ -209,11 +240,20 @@ void heartbeat_manager::process_reply(
               n,
               result<append_entries_reply>(r.error()),
               req_meta.seq,
-              req_meta.dirty_offset);
+              req_meta.dirty_offset,
+              sent_at);
         }
         return;
     }
     for (auto& m : r.value().meta) {
+        if (unlikely(m.result != append_entries_reply::status::success)) {
+            // the receiver could not handle the beat (e.g. it could not
+            // reconstruct a delta encoded group), resend full metadata for
+            // this group on the next beat
+            if (auto s = _sessions.find(n); s != _sessions.end()) {
+                s->second.last_sent.erase(m.group);
+            }
+        }
         auto it = _consensus_groups.find(m.group);
         if (it == _consensus_groups.end()) {
             vlog(
@@ -225,7 +265,8 @@ void heartbeat_manager::process_reply(
           n,
           result<append_entries_reply>(std::move(m)),
           meta.seq,
-          meta.dirty_offset);
+          meta.dirty_offset,
+          sent_at);
     }
 }
 
@@ -250,6 +291,23 @@ ss::future<> heartbeat_manager::deregister_group(group_id g) {
         auto it = _consensus_groups.find(g);
         vassert(it != _consensus_groups.end(), "group not found: {}", g);
         _consensus_groups.erase(it);
+        for (auto& [_, session] : _sessions) {
+            session.last_sent.erase(g);
+        }
+    });
+}
+
+ss::future<> heartbeat_manager::register_groups(
+  std::vector<ss::lw_shared_ptr<consensus>> groups) {
+    return _lock.with([this, groups = std::move(groups)] {
+        for (auto& ptr : groups) {
+            auto ret = _consensus_groups.insert(ptr);
+            vassert(
+              ret.second,
+              "double registration of group: {}:{}",
+              ptr->ntp(),
+              ptr->group());
+        }
     });
 }
 
@@ -82,6 +82,15 @@ extern ss::logger hbeatlog;
  *
  *    heartbeat({L0, L1}) -> {F0, F1}(node-b)
  *    heartbeat({L0, L1}) -> {F0, F1}(node-c)
+ *
+ * Additionally heartbeats are delta encoded across rounds. The manager
+ * remembers the protocol metadata last sent to every node and groups whose
+ * metadata did not change are advertised by group id only; the receiver
+ * reconstructs the full metadata from its per-source cache. Every
+ * `full_beat_interval` rounds (and after any delivery error) the full
+ * metadata is resent so both sides converge again after drops, restarts or
+ * reconnects. With many idle groups this shrinks steady state heartbeat
+ * payloads and serialization work to a few bytes per group.
  */
 class heartbeat_manager {
 public:
@@ -114,12 +123,26 @@ public:
       duration_type interval, consensus_client_protocol, model::node_id);
 
     ss::future<> register_group(ss::lw_shared_ptr<consensus>);
+    // bulk registration: one lock acquisition for the whole batch, used
+    // by the group_manager bulk startup path
+    ss::future<> register_groups(std::vector<ss::lw_shared_ptr<consensus>>);
     ss::future<> deregister_group(raft::group_id);
 
     ss::future<> start();
     ss::future<> stop();
 
 private:
+    /// number of rounds after which a node gets full metadata for all its
+    /// groups regardless of what changed
+    static constexpr size_t full_beat_interval = 8;
+
+    /// per target node delta encoding state
+    struct hbeat_session {
+        /// metadata included in the last beat sent for each group
+        absl::flat_hash_map<raft::group_id, protocol_metadata> last_sent;
+        size_t beats_since_full{0};
+    };
+
     void dispatch_heartbeats();
 
     clock_type::time_point next_heartbeat_timeout();
@@ -127,6 +150,8 @@ private:
     /// \brief unprotected, must be used inside the gate & semaphore
     ss::future<> do_dispatch_heartbeats();
 
+    std::vector<node_heartbeat> requests_for_range();
+
     ss::future<> send_heartbeats(std::vector<node_heartbeat>);
 
     /// \brief sends a batch to one node
@@ -138,10 +163,12 @@ private:
     /// \param n the physical node that owns heart beats
     /// \param groups raft groups managed by \param n
     /// \param result if the node return successful heartbeats
+    /// \param sent_at local time the heartbeat round was dispatched
     void process_reply(
       model::node_id n,
       absl::flat_hash_map<raft::group_id, follower_request_meta> groups,
-      result<heartbeat_reply> result);
+      result<heartbeat_reply> result,
+      clock_type::time_point sent_at);
 
     // private members
 
@@ -157,5 +184,8 @@ private:
     consensus_client_protocol _client_protocol;
     ss::semaphore _dispatch_sem{0};
     model::node_id _self;
+    /// delta encoding state per target node, dropped on delivery errors to
+    /// force a full resend
+    absl::flat_hash_map<model::node_id, hbeat_session> _sessions;
 };
 } // namespace raft
@@ -22,7 +22,9 @@
 #include "utils/expiring_promise.h"
 #include "vassert.h"
 
+#include <seastar/core/future-util.hh>
 #include <seastar/core/semaphore.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/util/bool_class.hh>
 #include <seastar/util/log.hh>
@@ -32,6 +34,7 @@
 #include <optional>
 #include <system_error>
 #include <variant>
+#include <vector>
 
 namespace raft {
 
@@ -120,45 +123,36 @@ private:
 
     ss::future<> apply(model::record_batch b) final;
 
+    /**
+     * Resolves when every batch currently queued on the dispatch tails is
+     * applied. Used as a completion barrier so that the base state machine
+     * never reports an offset as applied (waiter notification, last applied
+     * persistence) while an earlier batch is still in flight on another
+     * queue.
+     */
+    ss::future<> dispatch_barrier();
+
     container_t _promises;
 
     /*
-     * Here the _mutex is used to make sure that promise was inserted into
-     * the map before apply is executed. In other words we make sure that
-     * calls to replicate and emplacing a promise in the map will happen
-     * without apply handler executed in between.
-     *
-     *       +--------+
-     *       |
-     *       |        +---------------+
-     *       |        |   Replicate   |     trigger, separate fibre
-     *       |        +-------+-------+- - - - - - - -+
-     *       |                |                       |
-     * lock <|                |  offset               |
-     *       |                v                       |
-     *       |        +-------+------+                |
-     *       |        |Insert promise|                |
-     *       |        |  for offset  |                |
-     *       |        +-------+------+                |
-     *       |                |                       |
-     *       +--------+       | future                |
-     *                        |                       |           +--+
-     *                        |                       v              |
-     *                        |           +-----------+-----------+  |
-     *                        |           |  Apply & set value    |  |> lock
-     *                        |           +-----------------------+  |
-     *                        |                                      |
-     *                        V                                   +--+
-     *                 +------+------+
-     *                 |  Wait for   |
-     *                 |   promise   |
-     *                 +-------------+
-     *
-     * Mutex prevents the 'Apply & set value' to be executed between 'Replicate'
-     * and 'Insert promise for offset'
-     *
+     * There is no lock between a caller's replicate and the apply fiber. The
+     * race they used to be serialized against - apply finishing before the
+     * replicate continuation registered its promise - is handled with an
+     * early-result window instead: while at least one replicate is in
+     * flight, applies park results for offsets nobody is waiting on yet in
+     * _early_results, where the replicate continuation picks them up. The
+     * window closes (and the map is cleared) when the last in-flight
+     * replicate resolves, so replayed batches that never had a waiter do not
+     * accumulate results.
+     */
+    absl::flat_hash_map<model::offset, std::error_code> _early_results;
+    size_t _in_flight_replicates{0};
+    /**
+     * Per-state single-writer dispatch queues. Batches applicable to the
+     * same state apply in log order; a batch for a different state starts
+     * applying without waiting for another state's in-flight batch.
      */
-    mutex _mutex;
+    std::vector<ss::shared_future<>> _dispatch_tails;
     consensus* _c;
     const persistent_last_applied _persist_last_applied;
     // we keep states in a tuple to automatically dispatch updates to correct
@@ -176,7 +170,12 @@ mux_state_machine<T...>::mux_state_machine(
   : raft::state_machine(c, logger, ss::default_priority_class())
   , _c(c)
   , _persist_last_applied(persist)
-  , _state(state...) {}
+  , _state(state...) {
+    _dispatch_tails.reserve(sizeof...(T));
+    for (size_t i = 0; i < sizeof...(T); ++i) {
+        _dispatch_tails.emplace_back(ss::now());
+    }
+}
 
 template<typename... T>
 CONCEPT(requires(State<T>, ...))
@@ -194,55 +193,86 @@ ss::future<std::error_code> mux_state_machine<T...>::replicate_and_wait(
   model::timeout_clock::time_point timeout,
   ss::abort_source& as) {
     using ret_t = std::error_code;
-    return _mutex.get_units().then(
-      [this, b = std::move(b), timeout, &as](ss::semaphore_units<> u) mutable {
-          return replicate(std::move(b))
-            .then([this, u = std::move(u), timeout, &as](
-                    result<raft::replicate_result> r) {
-                if (!r) {
-                    return ss::make_ready_future<ret_t>(r.error());
-                }
+    // open the early-result window: an apply that finishes before the
+    // waiter below is registered parks its result instead of dropping it
+    ++_in_flight_replicates;
+    return replicate(std::move(b))
+      .then_wrapped([this, timeout, &as](
+                      ss::future<result<raft::replicate_result>> f) {
+          // the window may close as soon as this continuation finishes -
+          // claiming an early result or registering the promise happens
+          // without yielding to the reactor
+          auto close_window = [this] {
+              if (--_in_flight_replicates == 0) {
+                  _early_results.clear();
+              }
+          };
+          try {
+              auto r = f.get0();
+              if (!r) {
+                  close_window();
+                  return ss::make_ready_future<ret_t>(r.error());
+              }
+
+              auto last_offset = r.value().last_offset;
 
-                auto last_offset = r.value().last_offset;
+              if (auto it = _early_results.find(last_offset);
+                  it != _early_results.end()) {
+                  auto ec = it->second;
+                  _early_results.erase(it);
+                  close_window();
+                  return ss::make_ready_future<ret_t>(ec);
+              }
 
-                auto [it, insterted] = _promises.emplace(
-                  last_offset, expiring_promise<ret_t>{});
-                vassert(
-                  insterted,
-                  "Prosmise for offset {} already registered",
-                  last_offset);
-                return it->second
-                  .get_future_with_timeout(
-                    timeout, [] { return errc::timeout; }, as)
-                  .then_wrapped(
-                    [this, last_offset](ss::future<std::error_code> ec) {
-                        _promises.erase(last_offset);
-                        return ec;
-                    });
-            });
+              auto [it, insterted] = _promises.emplace(
+                last_offset, expiring_promise<ret_t>{});
+              vassert(
+                insterted,
+                "Prosmise for offset {} already registered",
+                last_offset);
+              close_window();
+              return it->second
+                .get_future_with_timeout(
+                  timeout, [] { return errc::timeout; }, as)
+                .then_wrapped(
+                  [this, last_offset](ss::future<std::error_code> ec) {
+                      _promises.erase(last_offset);
+                      return ec;
+                  });
+          } catch (...) {
+              close_window();
+              return ss::make_exception_future<ret_t>(
+                std::current_exception());
+          }
       });
 }
 
-// return value only if state accepts given batch type
-template<typename State>
-static std::optional<State*>
-is_batch_applicable(State& s, const model::record_batch& batch) {
-    if (s.is_batch_applicable(batch)) {
-        return &s;
+template<typename... T>
+CONCEPT(requires(State<T>, ...))
+ss::future<> mux_state_machine<T...>::dispatch_barrier() {
+    std::vector<ss::future<>> tails;
+    tails.reserve(_dispatch_tails.size());
+    for (auto& tail : _dispatch_tails) {
+        tails.push_back(tail.get_future());
     }
-    return std::nullopt;
+    return ss::when_all_succeed(tails.begin(), tails.end());
 }
 
 template<typename... T>
 CONCEPT(requires(State<T>, ...))
 ss::future<> mux_state_machine<T...>::apply(model::record_batch b) {
-    // lookup for the state to apply the update
-    auto state = std::apply(
-      [&b](T&... st) {
-          using variant_t = std::variant<T*...>;
-          std::optional<variant_t> res;
-          (void)((res = is_batch_applicable(st, b), res) || ...);
-          return res;
+    // lookup for the state to apply the update and its dispatch queue
+    using variant_t = std::variant<T*...>;
+    std::optional<variant_t> state;
+    size_t queue_idx = 0;
+    std::apply(
+      [&b, &state, &queue_idx](T&... st) {
+          size_t i = 0;
+          (void)
+            ((st.is_batch_applicable(b)
+                ? (state.emplace(&st), queue_idx = i, true)
+                : (++i, false))
+             || ...);
       },
       _state);
 
@@ -253,29 +283,53 @@ ss::future<> mux_state_machine<T...>::apply(model::record_batch b) {
             || b.header().type == raft::configuration_batch_type,
           "State handler for batch of type: {} not found",
           b.header().type);
-        return ss::now();
+        return dispatch_barrier();
     }
 
     auto last_offset = b.last_offset();
-    // apply update
-    auto result_f = std::visit(
-      [b = std::move(b)](auto& state) mutable {
-          return state->apply_update(std::move(b));
-      },
-      *state);
+    // enqueue on the matched state's single-writer queue. this starts the
+    // apply immediately when the queue is idle, concurrently with another
+    // state's in-flight batch
+    auto done = ss::make_lw_shared<ss::promise<>>();
+    auto task = _dispatch_tails[queue_idx].get_future().then(
+      [this, state = *state, b = std::move(b), last_offset, done]() mutable {
+          return std::visit(
+                   [b = std::move(b)](auto& st) mutable {
+                       return st->apply_update(std::move(b));
+                   },
+                   state)
+            .then_wrapped(
+              [this, last_offset, done](ss::future<std::error_code> f) {
+                  try {
+                      auto ec = f.get0();
+                      if (auto it = _promises.find(last_offset);
+                          it != _promises.end()) {
+                          it->second.set_value(ec);
+                      } else if (_in_flight_replicates > 0) {
+                          // the replicate caller has not registered its
+                          // waiter yet, park the result (see _early_results)
+                          _early_results.emplace(last_offset, ec);
+                      }
+                      done->set_value();
+                  } catch (...) {
+                      // surface the failure through this batch's completion
+                      // only; the queue itself stays usable
+                      done->set_exception(std::current_exception());
+                  }
+              });
+      });
+    _dispatch_tails[queue_idx] = ss::shared_future<>(std::move(task));
 
-    return result_f.then([this, last_offset](std::error_code ec) {
-        auto f = _mutex.with([this, last_offset, ec] {
-            if (auto it = _promises.find(last_offset); it != _promises.end()) {
-                it->second.set_value(ec);
-            }
-        });
-        if (!_persist_last_applied) {
-            return f;
-        }
-        return f.then(
-          [this, last_offset] { return write_last_applied(last_offset); });
-    });
+    // resolve once every batch up to and including this one is applied, so
+    // the base state machine can safely notify waiters for last_offset
+    return dispatch_barrier()
+      .then([done] { return done->get_future(); })
+      .then([this, last_offset] {
+          if (!_persist_last_applied) {
+              return ss::now();
+          }
+          return write_last_applied(last_offset);
+      });
 }
 
 } // namespace raft
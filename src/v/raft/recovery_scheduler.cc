@@ -0,0 +1,133 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "raft/recovery_scheduler.h"
+
+#include "config/configuration.h"
+
+#include <seastar/core/sleep.hh>
+
+#include <algorithm>
+#include <chrono>
+
+namespace raft {
+
+recovery_scheduler::recovery_scheduler(
+  size_t max_concurrent,
+  size_t rate_bytes_per_sec,
+  size_t learner_rate_bytes_per_sec)
+  : _max_concurrent(max_concurrent)
+  , _rate_bytes_per_sec(rate_bytes_per_sec)
+  , _learner_rate_bytes_per_sec(learner_rate_bytes_per_sec)
+  , _tokens(static_cast<double>(rate_bytes_per_sec))
+  , _learner_tokens(static_cast<double>(learner_rate_bytes_per_sec))
+  , _last_refill(clock_type::now()) {}
+
+recovery_scheduler& recovery_scheduler::local() {
+    static thread_local recovery_scheduler scheduler(
+      config::shard_local_cfg().raft_max_concurrent_recoveries(),
+      config::shard_local_cfg().raft_recovery_rate_bytes_per_sec(),
+      config::shard_local_cfg().raft_learner_recovery_rate_bytes_per_sec());
+    return scheduler;
+}
+
+ss::future<>
+recovery_scheduler::admit(model::offset lag, ss::abort_source& as) {
+    if (_active < _max_concurrent) {
+        ++_active;
+        return ss::now();
+    }
+    auto w = std::make_unique<waiter>(lag);
+    auto f = w->done.get_future();
+    auto opt_sub = as.subscribe([raw = w.get()]() noexcept {
+        raw->aborted = true;
+        raw->done.set_exception(ss::abort_requested_exception{});
+    });
+    if (!opt_sub) {
+        // already aborted
+        return ss::make_exception_future<>(ss::abort_requested_exception{});
+    }
+    w->sub = std::move(*opt_sub);
+    _waiters.push_back(std::move(w));
+    return f;
+}
+
+void recovery_scheduler::release() {
+    // drop entries that were aborted while waiting for a slot
+    _waiters.erase(
+      std::remove_if(
+        _waiters.begin(),
+        _waiters.end(),
+        [](const std::unique_ptr<waiter>& w) { return w->aborted; }),
+      _waiters.end());
+    if (_waiters.empty()) {
+        --_active;
+        return;
+    }
+    // hand the slot over to the most lagging waiter, recovering the furthest
+    // behind replicas first minimizes the time with reduced redundancy
+    auto it = std::max_element(
+      _waiters.begin(),
+      _waiters.end(),
+      [](const std::unique_ptr<waiter>& a, const std::unique_ptr<waiter>& b) {
+          return a->lag < b->lag;
+      });
+    (*it)->done.set_value();
+    _waiters.erase(it);
+}
+
+ss::future<>
+recovery_scheduler::throttle(size_t bytes, learner_traffic learner) {
+    refill_tokens();
+    std::chrono::duration<double> delay{0};
+    if (_rate_bytes_per_sec != 0) {
+        _tokens -= static_cast<double>(bytes);
+        if (_tokens < 0) {
+            delay = std::chrono::duration<double>(
+              -_tokens / static_cast<double>(_rate_bytes_per_sec));
+        }
+    }
+    // learner traffic also counts against the aggregate budget above, the
+    // separate bucket only tightens the limit for planned data movement
+    if (learner == learner_traffic::yes && _learner_rate_bytes_per_sec != 0) {
+        _learner_tokens -= static_cast<double>(bytes);
+        if (_learner_tokens < 0) {
+            delay = std::max(
+              delay,
+              std::chrono::duration<double>(
+                -_learner_tokens
+                / static_cast<double>(_learner_rate_bytes_per_sec)));
+        }
+    }
+    if (delay == std::chrono::duration<double>{0}) {
+        return ss::now();
+    }
+    // budget exhausted, sleep until the deficit refills. recovery chunks are
+    // small (32KB) relative to the budget so the delay stays short
+    return ss::sleep(
+      std::chrono::duration_cast<std::chrono::milliseconds>(delay));
+}
+
+void recovery_scheduler::refill_tokens() {
+    auto now = clock_type::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(
+      now - _last_refill);
+    _last_refill = now;
+    // cap the buckets at one second worth of budget to bound bursts after
+    // idle periods
+    _tokens = std::min(
+      static_cast<double>(_rate_bytes_per_sec),
+      _tokens + elapsed.count() * static_cast<double>(_rate_bytes_per_sec));
+    _learner_tokens = std::min(
+      static_cast<double>(_learner_rate_bytes_per_sec),
+      _learner_tokens
+        + elapsed.count() * static_cast<double>(_learner_rate_bytes_per_sec));
+}
+
+} // namespace raft
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/fundamental.h"
+#include "raft/types.h"
+#include "seastarx.h"
+
+#include <seastar/core/abort_source.hh>
+#include <seastar/core/future.hh>
+#include <seastar/util/bool_class.hh>
+
+#include <memory>
+#include <vector>
+
+namespace raft {
+
+/**
+ * Shard local coordinator for follower recoveries.
+ *
+ * When a node rejoins the cluster every out of date group starts its own
+ * recovery_stm. Without coordination they all compete for disk and network
+ * bandwidth, recovery of each individual partition takes longer and
+ * foreground produce latency suffers. The scheduler bounds the number of
+ * recoveries running concurrently on a shard, admitting the most lagging
+ * follower first when a slot frees up, and debits every recovery chunk
+ * against an aggregate token bucket so recovery traffic can not exceed the
+ * configured bandwidth budget.
+ */
+class recovery_scheduler {
+public:
+    /**
+     * Distinguishes learner catch up traffic (partition movement,
+     * rebalancing) from regular follower recovery. Learner traffic is
+     * additionally debited against a separate, typically smaller budget so
+     * that planned data movement can not starve recoveries that restore
+     * lost redundancy.
+     */
+    using learner_traffic = ss::bool_class<struct learner_traffic_tag>;
+
+    recovery_scheduler(
+      size_t max_concurrent,
+      size_t rate_bytes_per_sec,
+      size_t learner_rate_bytes_per_sec);
+
+    /// Shard local instance configured from config::shard_local_cfg()
+    static recovery_scheduler& local();
+
+    /**
+     * Waits for a recovery slot. Queued requests are admitted in order of
+     * descending follower lag so the most out of date replicas catch up
+     * first. The returned future fails with abort_requested_exception when
+     * the abort source fires while the request is still queued.
+     */
+    ss::future<> admit(model::offset lag, ss::abort_source&);
+
+    /// Returns a slot acquired with admit()
+    void release();
+
+    /**
+     * Debits bytes from the aggregate recovery bandwidth budget, sleeping
+     * until the token bucket refills when the budget is exhausted. Learner
+     * traffic is also debited against the learner budget and sleeps for
+     * whichever deficit is larger.
+     */
+    ss::future<>
+    throttle(size_t bytes, learner_traffic = learner_traffic::no);
+
+private:
+    struct waiter {
+        explicit waiter(model::offset l)
+          : lag(l) {}
+        model::offset lag;
+        ss::promise<> done;
+        bool aborted{false};
+        ss::abort_source::subscription sub;
+    };
+
+    void refill_tokens();
+
+    size_t _max_concurrent;
+    size_t _rate_bytes_per_sec;
+    size_t _learner_rate_bytes_per_sec;
+    size_t _active{0};
+    std::vector<std::unique_ptr<waiter>> _waiters;
+    double _tokens;
+    double _learner_tokens;
+    clock_type::time_point _last_refill;
+};
+
+} // namespace raft
@@ -9,6 +9,7 @@
 
 #include "raft/recovery_stm.h"
 
+#include "likely.h"
 #include "model/fundamental.h"
 #include "model/record_batch_reader.h"
 #include "outcome_future_utils.h"
@@ -16,6 +17,7 @@
 #include "raft/errc.h"
 #include "raft/logger.h"
 #include "raft/raftgen_service.h"
+#include "raft/recovery_scheduler.h"
 
 #include <seastar/core/future-util.hh>
 
@@ -129,20 +131,65 @@ bool recovery_stm::state_changed() {
 }
 
 ss::future<> recovery_stm::read_range_for_recovery(
+  model::offset start_offset, model::offset end_offset) {
+    /**
+     * Windowed recovery. Chunks are read sequentially but their append
+     * entries requests are dispatched without waiting for the previous
+     * reply, with up to max_inflight_requests outstanding. Requests travel
+     * in order over the follower connection so each chunk optimistically
+     * chains onto the last offset of the previous one; if any of them fails
+     * the follower rejects the rest of the window, the reply handler moves
+     * next_index backward and the recovery loop retries from there.
+     */
+    struct pipeline_state {
+        model::offset next_offset;
+        std::vector<ss::future<>> inflight;
+    };
+    return ss::do_with(
+      pipeline_state{start_offset, {}},
+      [this, end_offset](pipeline_state& st) {
+          return ss::do_until(
+                   [this, &st, end_offset] {
+                       return _stop_requested || st.next_offset > end_offset
+                              || st.inflight.size() >= max_inflight_requests;
+                   },
+                   [this, &st, end_offset] {
+                       return dispatch_chunk(st.next_offset, end_offset)
+                         .then([&st](std::optional<inflight_chunk> chunk) {
+                             if (!chunk) {
+                                 return;
+                             }
+                             st.next_offset = details::next_offset(
+                               chunk->last_offset);
+                             st.inflight.push_back(std::move(chunk->reply));
+                         });
+                   })
+            .then([&st] {
+                return ss::when_all_succeed(
+                  st.inflight.begin(), st.inflight.end());
+            });
+      });
+}
+
+ss::future<std::optional<recovery_stm::inflight_chunk>>
+recovery_stm::dispatch_chunk(
   model::offset start_offset, model::offset end_offset) {
     storage::log_reader_config cfg(
       start_offset,
       end_offset,
       1,
-      // 32KB is a modest estimate. It has good batching and it also prevents an
-      // OOM situation where we have a lot of raft groups recovering at the same
-      // time and all drawing from memory. If this setting proves difficult,
-      // we'll need to throttle with a core-local semaphore
-      32 * 1024,
+      _read_size,
       _prio,
       std::nullopt,
       std::nullopt,
       _ptr->_as);
+    /*
+     * recovery is a read-once scan of cold data. cache hits on the hot
+     * tail are still served, but nothing read from disk here is inserted
+     * into the batch cache and nothing is promoted - otherwise a long
+     * recovery evicts the cache-resident tail that live consumers fetch
+     */
+    cfg.skip_batch_cache = true;
 
     vlog(
       _ctxlog.trace,
@@ -167,12 +214,29 @@ ss::future<> recovery_stm::read_range_for_recovery(
               _node_id);
             if (batches.empty()) {
                 _stop_requested = true;
-                return ss::make_ready_future<>();
+                return ss::make_ready_future<std::optional<inflight_chunk>>(
+                  std::nullopt);
             }
             auto gap_filled_batches = details::make_ghost_batches_in_gaps(
               start_offset, std::move(batches));
-            _base_batch_offset = gap_filled_batches.begin()->base_offset();
-            _last_batch_offset = gap_filled_batches.back().last_offset();
+            auto base_batch_offset = gap_filled_batches.begin()->base_offset();
+            auto last_batch_offset = gap_filled_batches.back().last_offset();
+            size_t chunk_bytes = 0;
+            for (const auto& b : gap_filled_batches) {
+                chunk_bytes += b.size_bytes();
+            }
+
+            /*
+             * adapt the next read to what this one returned: a chunk that
+             * filled (at least half of) its budget means the follower is
+             * still deep behind and the next read doubles; a partial chunk
+             * means we are near the tail, go back to the initial size
+             */
+            if (chunk_bytes * 2 >= _read_size) {
+                _read_size = std::min(_read_size * 2, max_read_size);
+            } else {
+                _read_size = initial_read_size;
+            }
 
             auto f_reader = model::make_foreign_memory_record_batch_reader(
               std::move(gap_filled_batches));
@@ -183,10 +247,27 @@ ss::future<> recovery_stm::read_range_for_recovery(
              * be fully caught up.
              */
             auto should_flush = append_entries_request::flush_after_append(
-              _last_batch_offset == lstats.dirty_offset
+              last_batch_offset == lstats.dirty_offset
               && (_ptr->last_visible_index() <= _ptr->committed_offset()));
 
-            return replicate(std::move(f_reader), should_flush);
+            // charge the chunk against the shard wide recovery bandwidth
+            // budget before dispatching it
+            return recovery_scheduler::local()
+              .throttle(chunk_bytes, traffic_class())
+              .then([this,
+                     f_reader = std::move(f_reader),
+                     should_flush,
+                     base_batch_offset,
+                     last_batch_offset]() mutable
+                    -> std::optional<inflight_chunk> {
+                  return inflight_chunk{
+                    last_batch_offset,
+                    replicate(
+                      std::move(f_reader),
+                      should_flush,
+                      base_batch_offset,
+                      last_batch_offset)};
+              });
         });
 }
 
@@ -203,11 +284,18 @@ ss::future<> recovery_stm::open_snapshot_reader() {
       });
 }
 
-ss::future<> recovery_stm::send_install_snapshot_request() {
+ss::future<> recovery_stm::send_install_snapshot_request(
+  std::vector<ss::future<>>& inflight) {
     // send 32KB at a time
     return read_iobuf_exactly(_snapshot_reader->input(), 32_KiB)
-      .then([this](iobuf chunk) mutable {
+      .then([this, &inflight](iobuf chunk) mutable {
           auto chunk_size = chunk.size_bytes();
+          if (unlikely(chunk_size == 0)) {
+              // reader exhausted before the advertised snapshot size,
+              // restart the transfer
+              _snapshot_install_failed = true;
+              return ss::now();
+          }
           install_snapshot_request req{
             .term = _ptr->term(),
             .group = _ptr->group(),
@@ -216,19 +304,34 @@ ss::future<> recovery_stm::send_install_snapshot_request() {
             .file_offset = _sent_snapshot_bytes,
             .chunk = std::move(chunk),
             .done = (_sent_snapshot_bytes + chunk_size) == _snapshot_size};
-
-          vlog(
-            _ctxlog.trace,
-            "Sending install snapshot request to {}, last included index: {}",
-            _node_id,
-            req.last_included_index);
-          return _ptr->_client_protocol
-            .install_snapshot(
-              _node_id,
-              std::move(req),
-              rpc::client_opts(append_entries_timeout()))
-            .then([this](result<install_snapshot_reply> reply) {
-                return handle_install_snapshot_reply(reply);
+          // optimistic accounting, chunks travel in order on the follower
+          // connection so the next one starts right after this one. any
+          // rejection sets _snapshot_install_failed and restarts the
+          // transfer from scratch
+          const bool is_done = bool(req.done);
+          _sent_snapshot_bytes += chunk_size;
+
+          // snapshot chunks draw from the same shard wide recovery
+          // bandwidth budget as log recovery chunks
+          return recovery_scheduler::local()
+            .throttle(chunk_size, traffic_class())
+            .then([this, &inflight, req = std::move(req), is_done]() mutable {
+                vlog(
+                  _ctxlog.trace,
+                  "Sending install snapshot request to {}, last included "
+                  "index: {}",
+                  _node_id,
+                  req.last_included_index);
+                inflight.push_back(
+                  _ptr->_client_protocol
+                    .install_snapshot(
+                      _node_id,
+                      std::move(req),
+                      rpc::client_opts(append_entries_timeout()))
+                    .then(
+                      [this, is_done](result<install_snapshot_reply> reply) {
+                          return handle_install_snapshot_reply(reply, is_done);
+                      }));
             });
       });
 }
@@ -238,23 +341,25 @@ ss::future<> recovery_stm::close_snapshot_reader() {
         _snapshot_reader.reset();
         _snapshot_size = 0;
         _sent_snapshot_bytes = 0;
+        _snapshot_install_failed = false;
     });
 }
 
 ss::future<> recovery_stm::handle_install_snapshot_reply(
-  result<install_snapshot_reply> reply) {
-    // snapshot delivery failed
+  result<install_snapshot_reply> reply, bool is_done) {
+    // snapshot delivery failed, the reader is closed after the whole window
+    // drained and the transfer restarts from scratch
     if (reply.has_error() || !reply.value().success) {
-        return close_snapshot_reader();
+        _snapshot_install_failed = true;
+        return ss::now();
     }
     if (reply.value().term > _ptr->_term) {
-        return close_snapshot_reader().then(
-          [this, term = reply.value().term] { return _ptr->step_down(term); });
+        _snapshot_install_failed = true;
+        return _ptr->step_down(reply.value().term);
     }
-    _sent_snapshot_bytes = reply.value().bytes_stored;
 
-    // we will send next chunk as a part of recovery loop
-    if (_sent_snapshot_bytes != _snapshot_size) {
+    // only the reply for the final chunk finalizes the transfer
+    if (!is_done) {
         return ss::now();
     }
 
@@ -268,7 +373,7 @@ ss::future<> recovery_stm::handle_install_snapshot_reply(
     // snapshot received by the follower, continue with recovery
     (*meta)->match_index = _ptr->_last_snapshot_index;
     (*meta)->next_index = details::next_offset(_ptr->_last_snapshot_index);
-    return close_snapshot_reader();
+    return ss::now();
 }
 
 ss::future<> recovery_stm::install_snapshot() {
@@ -283,17 +388,50 @@ ss::future<> recovery_stm::install_snapshot() {
             return ss::now();
         }
 
-        return send_install_snapshot_request();
+        // stream a window of snapshot chunks. chunks are read sequentially
+        // from the snapshot file but their requests are dispatched without
+        // waiting for the previous reply, the same way the windowed log
+        // recovery path works, so transfer throughput is not bound by the
+        // request round trip time
+        return ss::do_with(
+          std::vector<ss::future<>>{},
+          [this](std::vector<ss::future<>>& inflight) {
+              return ss::do_until(
+                       [this, &inflight] {
+                           return _snapshot_install_failed
+                                  || _sent_snapshot_bytes >= _snapshot_size
+                                  || inflight.size() >= max_inflight_requests;
+                       },
+                       [this, &inflight] {
+                           return send_install_snapshot_request(inflight);
+                       })
+                .then([&inflight] {
+                    return ss::when_all_succeed(
+                      inflight.begin(), inflight.end());
+                })
+                .then([this] {
+                    // close only after every in-flight request finished so
+                    // none of them still references the reader
+                    if (
+                      _snapshot_reader != nullptr
+                      && (_snapshot_install_failed || _sent_snapshot_bytes == _snapshot_size)) {
+                        return close_snapshot_reader();
+                    }
+                    return ss::now();
+                });
+          });
     });
 }
 
 ss::future<> recovery_stm::replicate(
   model::record_batch_reader&& reader,
-  append_entries_request::flush_after_append flush) {
+  append_entries_request::flush_after_append flush,
+  model::offset base_batch_offset,
+  model::offset last_batch_offset) {
     // collect metadata for append entries request
     // last persisted offset is last_offset of batch before the first one in the
     // reader
-    auto prev_log_idx = details::prev_offset(_base_batch_offset);
+    auto prev_log_idx = details::prev_offset(base_batch_offset);
     model::term_id prev_log_term;
     auto lstats = _ptr->_log.offsets();
 
@@ -310,9 +448,9 @@ ss::future<> recovery_stm::replicate(
     }
 
     // calculate commit index for follower to update immediately
-    auto commit_idx = std::min(_last_batch_offset, _committed_offset);
+    auto commit_idx = std::min(last_batch_offset, _committed_offset);
     auto last_visible_idx = std::min(
-      _last_batch_offset, _ptr->last_visible_index());
+      last_batch_offset, _ptr->last_visible_index());
     // build request
     append_entries_request r(
       _ptr->self(),
@@ -329,10 +467,15 @@ ss::future<> recovery_stm::replicate(
     _ptr->update_node_append_timestamp(_node_id);
 
     auto seq = _ptr->next_follower_sequence(_node_id);
+    auto sent_at = clock_type::now();
     _ptr->suppress_heartbeats(_node_id, seq, true);
     return dispatch_append_entries(std::move(r))
       .finally([this, seq] { _ptr->suppress_heartbeats(_node_id, seq, false); })
-      .then([this, seq, dirty_offset = lstats.dirty_offset](auto r) {
+      .then([this,
+             seq,
+             sent_at,
+             base_batch_offset,
+             dirty_offset = lstats.dirty_offset](auto r) {
           if (!r) {
               vlog(
                 _ctxlog.error,
@@ -343,7 +486,7 @@ ss::future<> recovery_stm::replicate(
               _ptr->get_probe().recovery_request_error();
           }
           _ptr->process_append_entries_reply(
-            _node_id, r.value(), seq, dirty_offset);
+            _node_id, r.value(), seq, dirty_offset, sent_at);
           // If request was reordered we have to stop recovery as follower state
           // is not known
           if (seq < _ptr->_fstats.get(_node_id).last_received_seq) {
@@ -364,7 +507,7 @@ ss::future<> recovery_stm::replicate(
                   return;
               }
               meta.value()->next_index = std::max(
-                model::offset(0), details::prev_offset(_base_batch_offset));
+                model::offset(0), details::prev_offset(base_batch_offset));
               vlog(
                 _ctxlog.trace,
                 "Move node {} next index {} backward",
@@ -378,6 +521,12 @@ clock_type::time_point recovery_stm::append_entries_timeout() {
     return raft::clock_type::now() + _ptr->_recovery_append_timeout;
 }
 
+recovery_scheduler::learner_traffic recovery_stm::traffic_class() const {
+    return _ptr->config().is_voter(_node_id)
+             ? recovery_scheduler::learner_traffic::no
+             : recovery_scheduler::learner_traffic::yes;
+}
+
 ss::future<result<append_entries_reply>>
 recovery_stm::dispatch_append_entries(append_entries_request&& r) {
     _ptr->_probe.recovery_append_request();
@@ -422,11 +571,27 @@ ss::future<> recovery_stm::apply() {
     return ss::with_gate(
              _ptr->_bg,
              [this] {
-                 return do_recover().then([this] {
-                     return ss::do_until(
-                       [this] { return is_recovery_finished(); },
-                       [this] { return do_recover(); });
-                 });
+                 auto meta = get_follower_meta();
+                 if (!meta) {
+                     return ss::now();
+                 }
+                 // admission is ordered by follower lag, the most out of
+                 // date replicas recover first
+                 auto lag = model::offset(
+                   _ptr->_log.offsets().dirty_offset()
+                   - meta.value()->match_index());
+                 return recovery_scheduler::local()
+                   .admit(lag, _ptr->_as)
+                   .then([this] {
+                       return do_recover()
+                         .then([this] {
+                             return ss::do_until(
+                               [this] { return is_recovery_finished(); },
+                               [this] { return do_recover(); });
+                         })
+                         .finally(
+                           [] { recovery_scheduler::local().release(); });
+                   });
              })
       .finally([this] {
           vlog(_ctxlog.trace, "Finished node {} recovery", _node_id);
@@ -13,6 +13,7 @@
 
 #include "model/metadata.h"
 #include "raft/consensus.h"
+#include "raft/recovery_scheduler.h"
 #include "raft/types.h"
 
 namespace raft {
@@ -23,18 +24,53 @@ public:
     ss::future<> apply();
 
 private:
+    /**
+     * maximum number of append entries requests in flight to the follower
+     * being recovered. requests are dispatched back to back over the
+     * ordered connection so recovery throughput is bound by disk and
+     * network bandwidth instead of the request round trip time.
+     */
+    static constexpr size_t max_inflight_requests = 4;
+
+    /**
+     * adaptive read sizing. every recovery starts with a modest read so
+     * many groups recovering at once cannot draw large buffers
+     * simultaneously; a follower that keeps consuming full chunks is deep
+     * behind, and its reads double up to the cap where recovery becomes a
+     * sequential-bandwidth disk workload. a partial read means the
+     * follower is near the tail, so the size drops back to the start.
+     */
+    static constexpr size_t initial_read_size = 32 * 1024;
+    static constexpr size_t max_read_size = 8 * 1024 * 1024;
+
+    /// a chunk that was read and dispatched: offset of the last batch sent
+    /// and the in-flight reply future
+    struct inflight_chunk {
+        model::offset last_offset;
+        ss::future<> reply;
+    };
+
     ss::future<> do_recover();
     ss::future<> read_range_for_recovery(model::offset, model::offset);
+    ss::future<std::optional<inflight_chunk>>
+    dispatch_chunk(model::offset, model::offset);
     ss::future<> replicate(
-      model::record_batch_reader&&, append_entries_request::flush_after_append);
+      model::record_batch_reader&&,
+      append_entries_request::flush_after_append,
+      model::offset base_batch_offset,
+      model::offset last_batch_offset);
     ss::future<result<append_entries_reply>>
     dispatch_append_entries(append_entries_request&&);
     std::optional<follower_index_metadata*> get_follower_meta();
     clock_type::time_point append_entries_timeout();
+    // learner traffic (partition movement) draws from a separate, smaller
+    // bandwidth budget than voter recovery, see recovery_scheduler
+    recovery_scheduler::learner_traffic traffic_class() const;
 
     ss::future<> install_snapshot();
-    ss::future<> send_install_snapshot_request();
-    ss::future<> handle_install_snapshot_reply(result<install_snapshot_reply>);
+    ss::future<> send_install_snapshot_request(std::vector<ss::future<>>&);
+    ss::future<>
+    handle_install_snapshot_reply(result<install_snapshot_reply>, bool is_done);
     ss::future<> open_snapshot_reader();
     ss::future<> close_snapshot_reader();
     bool state_changed();
@@ -42,8 +78,6 @@ private:
 
     consensus* _ptr;
     model::node_id _node_id;
-    model::offset _base_batch_offset;
-    model::offset _last_batch_offset;
     model::offset _committed_offset;
     model::term_id _term;
     ss::io_priority_class _prio;
@@ -52,8 +86,13 @@ private:
     std::unique_ptr<storage::snapshot_reader> _snapshot_reader;
     size_t _sent_snapshot_bytes = 0;
     size_t _snapshot_size = 0;
+    // set when any chunk of the in-flight window was rejected, the whole
+    // transfer restarts from scratch on the next recovery round
+    bool _snapshot_install_failed = false;
     // needed to early exit. (node down)
     bool _stop_requested = false;
+    // current read budget per chunk, see adaptive read sizing above
+    size_t _read_size = initial_read_size;
 };
 
 } // namespace raft
@@ -12,6 +12,7 @@
 #include "model/fundamental.h"
 #include "model/record.h"
 #include "model/record_batch_reader.h"
+#include "raft/consensus.h"
 #include "raft/consensus_utils.h"
 #include "raft/errc.h"
 #include "raft/replicate_entries_stm.h"
@@ -30,14 +31,31 @@ namespace raft {
 using namespace std::chrono_literals; // NOLINT
 replicate_batcher::replicate_batcher(consensus* ptr, size_t cache_size)
   : _ptr(ptr)
+  , _max_batch_size(cache_size)
   , _max_batch_size_sem(cache_size) {}
 
 ss::future<result<replicate_result>>
 replicate_batcher::replicate(model::record_batch_reader&& r) {
     return do_cache(std::move(r)).then([this](item_ptr i) {
-        return _lock.with([this] { return flush(); }).then([i] {
-            return i->_promise.get_future();
+        dispatch_flush();
+        return i->_promise.get_future();
+    });
+}
+
+void replicate_batcher::dispatch_flush() {
+    if (_flush_pending) {
+        // a flush is already waiting for the in-flight round to finish, it
+        // will pick up everything cached so far
+        return;
+    }
+    _flush_pending = true;
+    (void)ss::with_gate(_ptr->_bg, [this] {
+        return _lock.with([this] {
+            _flush_pending = false;
+            return flush();
         });
+    }).handle_exception([this](const std::exception_ptr& e) {
+        _ptr->_ctxlog.error("Error flushing replicate batcher - {}", e);
     });
 }
 
@@ -105,18 +123,29 @@ ss::future<> replicate_batcher::flush() {
       [this,
        data = std::move(data),
        notifications = std::move(notifications)]() mutable {
+          // optimistic leadership snapshot; validated again once the op
+          // lock is acquired
+          auto token = _ptr->capture_leadership_token();
+          if (!token) {
+              for (auto& n : notifications) {
+                  n->_promise.set_value(errc::not_leader);
+              }
+              return ss::make_ready_future<>();
+          }
           return _ptr->_op_lock.get_units().then(
             [this,
+             token = *token,
              data = std::move(data),
              notifications = std::move(notifications)](
               ss::semaphore_units<> u) mutable {
-                // we have to check if we are the leader
-                // it is critical as term could have been updated already by
-                // vote request and entries from current node could be accepted
-                // by the followers while it is no longer a leader
-                // this problem caused truncation failure.
+                // we have to check that we are still the leader under the
+                // same epoch. it is critical as term could have been
+                // updated already by a vote request and entries from the
+                // current node could be accepted by the followers while it
+                // is no longer a leader - this problem caused truncation
+                // failure.
 
-                if (!_ptr->is_leader()) {
+                if (!_ptr->leadership_token_valid(token)) {
                     for (auto& n : notifications) {
                         n->_promise.set_value(errc::not_leader);
                     }
@@ -124,15 +153,21 @@ ss::future<> replicate_batcher::flush() {
                 }
 
                 auto meta = _ptr->meta();
-                auto const term = model::term_id(meta.term);
+                auto const term = token.term;
                 for (auto& b : data) {
                     b.set_term(term);
                 }
                 auto seqs = _ptr->next_followers_request_seq();
+                // with quorum durability followers append without
+                // flushing; their dirty offsets drive the commit quorum
+                // and fdatasync happens on their flush interval
                 append_entries_request req(
                   _ptr->_self,
                   std::move(meta),
-                  model::make_memory_record_batch_reader(std::move(data)));
+                  model::make_memory_record_batch_reader(std::move(data)),
+                  _ptr->quorum_durability()
+                    ? append_entries_request::flush_after_append::no
+                    : append_entries_request::flush_after_append::yes);
                 return do_flush(
                   std::move(notifications),
                   std::move(req),
@@ -16,8 +16,10 @@
 #include "raft/types.h"
 #include "units.h"
 #include "utils/mutex.h"
+#include "utils/slab_pool.h"
 
 #include <seastar/core/semaphore.hh>
+#include <seastar/core/shared_ptr.hh>
 
 #include <absl/container/flat_hash_map.h>
 namespace raft {
@@ -25,7 +27,7 @@ class consensus;
 
 class replicate_batcher {
 public:
-    struct item {
+    struct item : public ss::enable_lw_shared_from_this<item> {
         ss::promise<result<replicate_result>> _promise;
         replicate_result ret;
         size_t record_count;
@@ -34,6 +36,17 @@ public:
          * processing the request.
          */
         ss::semaphore_units<> units;
+
+        // one item is allocated per replicate call; carved from the
+        // per-shard slab pool instead of the general allocator. the
+        // lw_shared counter is embedded (enable_lw_shared_from_this) so
+        // make_lw_shared allocates the item itself through these.
+        static void* operator new(size_t size) {
+            return slab_pool<item>::local().allocate(size);
+        }
+        static void operator delete(void* p, size_t size) {
+            slab_pool<item>::local().deallocate(p, size);
+        }
     };
     using item_ptr = ss::lw_shared_ptr<item>;
     explicit replicate_batcher(consensus* ptr, size_t cache_size);
@@ -50,6 +63,15 @@ public:
     ss::future<> flush();
     ss::future<> stop();
 
+    /**
+     * Group commit style flush scheduling. When no replication round is in
+     * flight the flush starts immediately; while one is in flight a single
+     * follow up flush is queued behind it and picks up everything cached in
+     * the meantime. Batch size therefore tracks the disk+network round trip
+     * instead of a fixed cadence.
+     */
+    void dispatch_flush();
+
     // it will lock on behalf of caller to append entries to leader log.
     ss::future<> do_flush(
       std::vector<item_ptr>&&,
@@ -57,17 +79,30 @@ public:
       ss::semaphore_units<>,
       absl::flat_hash_map<model::node_id, follower_req_seq>);
 
+    /**
+     * Fraction of the batcher's byte budget held by cached or in-flight
+     * requests, in [0, 1]. Used as a queue depth signal by kafka produce
+     * admission control.
+     */
+    double usage() const {
+        return 1.0
+               - (static_cast<double>(_max_batch_size_sem.current())
+                  / static_cast<double>(_max_batch_size));
+    }
+
 private:
     ss::future<item_ptr> do_cache(model::record_batch_reader&&);
     ss::future<replicate_batcher::item_ptr> do_cache_with_backpressure(
       ss::circular_buffer<model::record_batch>, size_t);
 
     consensus* _ptr;
+    size_t _max_batch_size;
     ss::semaphore _max_batch_size_sem;
 
     std::vector<item_ptr> _item_cache;
     ss::circular_buffer<model::record_batch> _data_cache;
     mutex _lock;
+    bool _flush_pending{false};
 };
 
 } // namespace raft
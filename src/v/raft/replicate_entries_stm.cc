@@ -46,6 +46,24 @@ ss::future<result<append_entries_reply>> replicate_entries_stm::do_dispatch_one(
     using ret_t = result<append_entries_reply>;
 
     if (n == _ptr->_self) {
+        if (_ptr->quorum_durability()) {
+            /**
+             * quorum durability: the leader votes toward the commit
+             * quorum with its in-memory append, mirroring what followers
+             * report when asked not to flush. fdatasync runs off the ack
+             * path on flush interval boundaries.
+             */
+            auto lstats = _ptr->_log.offsets();
+            append_entries_reply reply;
+            reply.node_id = _ptr->_self;
+            reply.group = _ptr->group();
+            reply.term = _ptr->term();
+            reply.last_dirty_log_index = lstats.dirty_offset;
+            reply.last_committed_log_index = lstats.committed_offset;
+            reply.result = append_entries_reply::status::success;
+            _dispatch_sem.signal();
+            return ss::make_ready_future<ret_t>(std::move(reply));
+        }
         auto f = _ptr->flush_log()
                    .then([this, units]() {
                        auto lstats = _ptr->_log.offsets();
@@ -94,8 +112,13 @@ ss::future<> replicate_entries_stm::dispatch_one(
     return ss::with_gate(
              _req_bg,
              [this, id, units]() mutable {
+                 // sampled before the request leaves so the reply can be
+                 // traced back to a time no later than its dispatch; the
+                 // leader lease is anchored at this instant
+                 auto sent_at = clock_type::now();
                  return dispatch_single_retry(id, std::move(units))
-                   .then([this, id](result<append_entries_reply> reply) {
+                   .then([this, id, sent_at](
+                           result<append_entries_reply> reply) {
                        auto it = _followers_seq.find(id);
                        auto seq = it == _followers_seq.end()
                                     ? follower_req_seq(0)
@@ -104,7 +127,7 @@ ss::future<> replicate_entries_stm::dispatch_one(
                            _ptr->get_probe().replicate_request_error();
                        }
                        _ptr->process_append_entries_reply(
-                         id, reply, seq, _dirty_offset);
+                         id, reply, seq, _dirty_offset, sent_at);
                    });
              })
       .handle_exception_type([](const ss::gate_closed_exception&) {});
@@ -9,25 +9,110 @@
 
 #include "raft/rpc_client_protocol.h"
 
+#include "likely.h"
 #include "outcome_future_utils.h"
+#include "raft/errc.h"
 #include "raft/raftgen_service.h"
 #include "rpc/connection_cache.h"
 #include "rpc/exceptions.h"
 #include "rpc/transport.h"
 #include "rpc/types.h"
 
+#include <seastar/core/sleep.hh>
+
 namespace raft {
 
 ss::future<result<vote_reply>> rpc_client_protocol::vote(
   model::node_id n, vote_request&& r, rpc::client_opts opts) {
-    return _connection_cache.local().with_node_client<raftgen_client_protocol>(
-      _self,
-      ss::this_shard_id(),
-      n,
-      [r = std::move(r),
-       opts = std::move(opts)](raftgen_client_protocol client) mutable {
-          return client.vote(std::move(r), std::move(opts))
-            .then(&rpc::get_ctx_data<vote_reply>);
+    auto it = _pending_votes.find(n);
+    if (it == _pending_votes.end()) {
+        it = _pending_votes
+               .emplace(n, pending_vote_batch{{}, {}, std::move(opts)})
+               .first;
+        // first vote for this node in the window, schedule the flush
+        (void)ss::sleep(vote_coalescing_window).then([this, n] {
+            dispatch_votes(n);
+        });
+    }
+    auto& batch = it->second;
+    batch.requests.push_back(std::move(r));
+    batch.promises.emplace_back();
+    return batch.promises.back().get_future();
+}
+
+void rpc_client_protocol::dispatch_votes(model::node_id n) {
+    auto it = _pending_votes.find(n);
+    if (it == _pending_votes.end()) {
+        return;
+    }
+    auto batch = std::move(it->second);
+    _pending_votes.erase(it);
+    // elections must not wait behind in-flight recovery transfers
+    batch.opts.priority = rpc::stream_priority::urgent;
+
+    if (batch.requests.size() == 1) {
+        // no concurrent elections, use the plain vote rpc
+        (void)_connection_cache.local()
+          .with_node_client<raftgen_client_protocol>(
+            _self,
+            ss::this_shard_id(),
+            n,
+            [r = std::move(batch.requests.front()),
+             opts = std::move(batch.opts)](
+              raftgen_client_protocol client) mutable {
+                return client.vote(std::move(r), std::move(opts))
+                  .then(&rpc::get_ctx_data<vote_reply>);
+            })
+          .then_wrapped([p = std::move(batch.promises)](
+                          ss::future<result<vote_reply>> f) mutable {
+              try {
+                  p.front().set_value(f.get0());
+              } catch (...) {
+                  p.front().set_exception(std::current_exception());
+              }
+          });
+        return;
+    }
+
+    vote_bundle_request req{std::move(batch.requests)};
+    const auto expected = req.requests.size();
+    (void)_connection_cache.local()
+      .with_node_client<raftgen_client_protocol>(
+        _self,
+        ss::this_shard_id(),
+        n,
+        [r = std::move(req),
+         opts = std::move(batch.opts)](raftgen_client_protocol client) mutable {
+            return client.vote_bundle(std::move(r), std::move(opts))
+              .then(&rpc::get_ctx_data<vote_bundle_reply>);
+        })
+      .then_wrapped([p = std::move(batch.promises),
+                     expected](ss::future<result<vote_bundle_reply>> f) mutable {
+          try {
+              auto r = f.get0();
+              if (!r) {
+                  for (auto& pr : p) {
+                      pr.set_value(r.error());
+                  }
+                  return;
+              }
+              auto& replies = r.value().replies;
+              if (unlikely(replies.size() != expected)) {
+                  for (auto& pr : p) {
+                      pr.set_value(errc::vote_dispatch_error);
+                  }
+                  return;
+              }
+              // demultiplex by index, replies preserve request order
+              for (size_t i = 0; i < expected; ++i) {
+                  p[i].set_value(std::move(replies[i]));
+              }
+          } catch (...) {
+              auto e = std::current_exception();
+              for (auto& pr : p) {
+                  pr.set_exception(e);
+              }
+          }
       });
 }
 
@@ -46,6 +131,8 @@ ss::future<result<append_entries_reply>> rpc_client_protocol::append_entries(
 
 ss::future<result<heartbeat_reply>> rpc_client_protocol::heartbeat(
   model::node_id n, heartbeat_request&& r, rpc::client_opts opts) {
+    // liveness signal, preempts bulk transfers on the shared connection
+    opts.priority = rpc::stream_priority::urgent;
     return _connection_cache.local().with_node_client<raftgen_client_protocol>(
       _self,
       ss::this_shard_id(),
@@ -73,6 +160,7 @@ rpc_client_protocol::install_snapshot(
 
 ss::future<result<timeout_now_reply>> rpc_client_protocol::timeout_now(
   model::node_id n, timeout_now_request&& r, rpc::client_opts opts) {
+    opts.priority = rpc::stream_priority::urgent;
     return _connection_cache.local().with_node_client<raftgen_client_protocol>(
       _self,
       ss::this_shard_id(),
@@ -20,6 +20,9 @@
 #include "rpc/connection_cache.h"
 #include "rpc/transport.h"
 
+#include <absl/container/flat_hash_map.h>
+
+#include <chrono>
 #include <system_error>
 
 namespace raft {
@@ -48,8 +51,28 @@ public:
     timeout_now(model::node_id, timeout_now_request&&, rpc::client_opts) final;
 
 private:
+    /**
+     * Vote requests (and prevotes, which use the same rpc) issued to the
+     * same node within the coalescing window are bundled into a single
+     * vote_bundle rpc. After a node restart thousands of groups elect at
+     * once; bundling flattens the resulting rpc storm the same way the
+     * heartbeat manager batches beats. One extra millisecond is noise next
+     * to election timeout jitter.
+     */
+    static constexpr std::chrono::milliseconds vote_coalescing_window{1};
+
+    struct pending_vote_batch {
+        std::vector<vote_request> requests;
+        std::vector<ss::promise<result<vote_reply>>> promises;
+        /// options of the first bundled request
+        rpc::client_opts opts;
+    };
+
+    void dispatch_votes(model::node_id);
+
     model::node_id _self;
     ss::sharded<rpc::connection_cache>& _connection_cache;
+    absl::flat_hash_map<model::node_id, pending_vote_batch> _pending_votes;
 };
 
 inline consensus_client_protocol make_rpc_client_protocol(
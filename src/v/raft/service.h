@@ -65,14 +65,34 @@ public:
     heartbeat(heartbeat_request&& r, rpc::streaming_context&) final {
         using ret_t = std::vector<append_entries_reply>;
         std::vector<append_entries_request> reqs;
-        reqs.reserve(r.meta.size());
+        reqs.reserve(r.meta.size() + r.unchanged.size());
+        auto& hb_cache = _hb_metadata_cache[r.node_id];
         for (auto& m : r.meta) {
+            hb_cache[m.group] = m;
             reqs.emplace_back(raft::append_entries_request(
               r.node_id,
               m,
               model::make_memory_record_batch_reader(
                 ss::circular_buffer<model::record_batch>{})));
         }
+        // delta encoded groups, reconstruct metadata from the last full beat.
+        // groups we cannot reconstruct (e.g. after a restart) are reported
+        // back as unavailable which makes the sender resend full metadata
+        std::vector<append_entries_reply> stale_delta_replies;
+        for (auto g : r.unchanged) {
+            auto it = hb_cache.find(g);
+            if (unlikely(it == hb_cache.end())) {
+                stale_delta_replies.push_back(append_entries_reply{
+                  .group = g,
+                  .result = append_entries_reply::status::group_unavailable});
+                continue;
+            }
+            reqs.emplace_back(raft::append_entries_request(
+              r.node_id,
+              it->second,
+              model::make_memory_record_batch_reader(
+                ss::circular_buffer<model::record_batch>{})));
+        }
 
         auto req_size = reqs.size();
         auto groupped = group_hbeats_by_shard(std::move(reqs));
@@ -84,8 +104,11 @@ public:
             futures.push_back(dispatch_hbeats_to_core(shard, std::move(req)));
         }
         // replies for groups that are not yet registered at this node
-        std::vector<append_entries_reply> group_missing_replies;
-        group_missing_replies.reserve(groupped.group_missing_requests.size());
+        std::vector<append_entries_reply> group_missing_replies = std::move(
+          stale_delta_replies);
+        group_missing_replies.reserve(
+          group_missing_replies.size()
+          + groupped.group_missing_requests.size());
         std::transform(
           std::begin(groupped.group_missing_requests),
           std::end(groupped.group_missing_requests),
@@ -123,6 +146,29 @@ public:
         });
     }
 
+    [[gnu::always_inline]] ss::future<vote_bundle_reply>
+    vote_bundle(vote_bundle_request&& r, rpc::streaming_context&) final {
+        // groups are dispatched to their shards in parallel, replies are
+        // collected in request order as the sender demultiplexes by index
+        std::vector<ss::future<vote_reply>> replies;
+        replies.reserve(r.requests.size());
+        for (auto& req : r.requests) {
+            replies.push_back(
+              _probe.vote().then([this, req = std::move(req)]() mutable {
+                  return dispatch_request(
+                    std::move(req),
+                    &service::make_failed_vote_reply,
+                    [](vote_request&& r, consensus_ptr c) {
+                        return c->vote(std::move(r));
+                    });
+              }));
+        }
+        return ss::when_all_succeed(replies.begin(), replies.end())
+          .then([](std::vector<vote_reply> r) {
+              return vote_bundle_reply{std::move(r)};
+          });
+    }
+
     [[gnu::always_inline]] ss::future<append_entries_reply>
     append_entries(append_entries_request&& r, rpc::streaming_context&) final {
         return _probe.append_entries().then([this, r = std::move(r)]() mutable {
@@ -290,5 +336,13 @@ private:
     failure_probes _probe;
     ss::sharded<ConsensusManager>& _group_manager;
     ShardLookup& _shard_table;
+    /// last full protocol metadata received from each node per group, used
+    /// to reconstruct delta encoded heartbeats. entries are refreshed by
+    /// every full beat; a miss is reported back as `group_unavailable` so
+    /// the sender falls back to full metadata for that group
+    absl::flat_hash_map<
+      model::node_id,
+      absl::flat_hash_map<raft::group_id, protocol_metadata>>
+      _hb_metadata_cache;
 };
 } // namespace raft
@@ -62,6 +62,14 @@ public:
     // start after ready to receive batches through apply upcall.
     ss::future<> start();
 
+    /**
+     * Begin applying from the given offset instead of the start of the log.
+     * Used when the caller restored the machine's state up to (and
+     * including) the previous offset from a checkpoint. Must be called
+     * before start().
+     */
+    void set_next(model::offset o) { _next = o; }
+
     ss::future<> stop();
 
     // wait until at least offset is applied to state machine
@@ -137,10 +137,34 @@ FIXTURE_TEST(test_getting_configurations, config_manager_fixture) {
         model::offset(10000),
         raft::configuration_manager::offset_update_treshold + 1_KiB)
       .get0();
+    BOOST_REQUIRE_EQUAL(
+      _cfg_mgr.get_highest_known_offset(), model::offset(10000));
 
+    // the watermark write is batched in the background; force it out
+    // before comparing against what recovery sees
+    _cfg_mgr.flush_highest_known_offset().get0();
     validate_recovery();
+}
+
+FIXTURE_TEST(test_stale_watermark_recovery, config_manager_fixture) {
+    auto configurations = test_configurations();
+
+    // advance the watermark in memory without tripping the persistence
+    // threshold - nothing reaches the kv-store
+    _cfg_mgr.maybe_store_highest_known_offset(model::offset(5000), 1_KiB)
+      .get0();
     BOOST_REQUIRE_EQUAL(
-      _cfg_mgr.get_highest_known_offset(), model::offset(10000));
+      _cfg_mgr.get_highest_known_offset(), model::offset(5000));
+
+    raft::configuration_manager recovered(
+      raft::group_configuration({}), raft::group_id(1), _storage, _logger);
+    recovered.start(false).get0();
+
+    // recovery tolerates the stale watermark: it falls back to the value
+    // persisted when the last configuration was added and the log beyond
+    // it gets re-read for configurations on startup
+    BOOST_REQUIRE_EQUAL(
+      recovered.get_highest_known_offset(), model::offset(1254));
 }
 
 FIXTURE_TEST(test_prefix_truncation, config_manager_fixture) {
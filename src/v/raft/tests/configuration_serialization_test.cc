@@ -51,6 +51,31 @@ raft::group_configuration random_configuration() {
     }
 }
 
+SEASTAR_THREAD_TEST_CASE(deserialize_version_0_configuration) {
+    auto brokers = random_brokers();
+    raft::group_nodes current;
+    for (auto& b : brokers) {
+        current.voters.push_back(b.id());
+    }
+
+    // hand rolled version 0 encoding, before group_nodes had observers
+    iobuf buf;
+    reflection::serialize(
+      buf,
+      static_cast<uint8_t>(0),
+      brokers,
+      current.voters,
+      current.learners,
+      static_cast<int8_t>(0)); // no old configuration
+
+    iobuf_parser parser(std::move(buf));
+    auto cfg = reflection::adl<raft::group_configuration>{}.from(parser);
+
+    BOOST_REQUIRE(cfg.brokers() == brokers);
+    BOOST_REQUIRE_EQUAL(cfg.current_config(), current);
+    BOOST_REQUIRE(!cfg.old_config());
+}
+
 SEASTAR_THREAD_TEST_CASE(roundtrip_raft_configuration_entry) {
     auto cfg = random_configuration();
     // serialize to entry
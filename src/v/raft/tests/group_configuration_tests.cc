@@ -46,3 +46,38 @@ BOOST_AUTO_TEST_CASE(should_return_false_as_it_does_not_contain_machine) {
     auto contains = test_grp.contains_broker(model::node_id(1));
     BOOST_REQUIRE_EQUAL(contains, false);
 }
+
+BOOST_AUTO_TEST_CASE(added_observer_is_not_a_voter) {
+    raft::group_configuration test_grp = raft::group_configuration(
+      {create_broker(1)});
+    test_grp.add_observer(create_broker(2));
+
+    BOOST_REQUIRE_EQUAL(test_grp.contains_broker(model::node_id(2)), true);
+    BOOST_REQUIRE_EQUAL(test_grp.is_observer(model::node_id(2)), true);
+    BOOST_REQUIRE_EQUAL(test_grp.is_voter(model::node_id(2)), false);
+    // adding an observer must not trigger joint consensus
+    BOOST_REQUIRE(test_grp.type() == raft::configuration_type::simple);
+}
+
+BOOST_AUTO_TEST_CASE(promoted_observer_becomes_learner) {
+    raft::group_configuration test_grp = raft::group_configuration(
+      {create_broker(1)});
+    test_grp.add_observer(create_broker(2));
+    test_grp.promote_observer(model::node_id(2));
+
+    BOOST_REQUIRE_EQUAL(test_grp.is_observer(model::node_id(2)), false);
+    BOOST_REQUIRE_EQUAL(test_grp.is_voter(model::node_id(2)), false);
+    auto& learners = test_grp.current_config().learners;
+    auto it = std::find(learners.begin(), learners.end(), model::node_id(2));
+    BOOST_REQUIRE(it != learners.end());
+}
+
+BOOST_AUTO_TEST_CASE(removed_observer_leaves_no_trace) {
+    raft::group_configuration test_grp = raft::group_configuration(
+      {create_broker(1)});
+    test_grp.add_observer(create_broker(2));
+    test_grp.remove_observer(model::node_id(2));
+
+    BOOST_REQUIRE_EQUAL(test_grp.contains_broker(model::node_id(2)), false);
+    BOOST_REQUIRE_EQUAL(test_grp.is_observer(model::node_id(2)), false);
+}
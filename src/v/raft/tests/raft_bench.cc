@@ -0,0 +1,189 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "raft/consensus_client_protocol.h"
+#include "raft/tests/raft_group_fixture.h"
+#include "random/generators.h"
+#include "vassert.h"
+
+#include <seastar/core/sleep.hh>
+#include <seastar/core/thread.hh>
+#include <seastar/testing/perf_tests.hh>
+
+#include <chrono>
+
+/*
+ * client protocol decorator adding a configurable base delay plus uniform
+ * jitter to every raft rpc, simulating wide links between group members.
+ * injected into raft_group nodes through client_protocol_decorator.
+ */
+class delayed_client_protocol final
+  : public raft::consensus_client_protocol::impl {
+public:
+    delayed_client_protocol(
+      raft::consensus_client_protocol inner,
+      std::chrono::milliseconds base,
+      std::chrono::milliseconds jitter)
+      : _inner(std::move(inner))
+      , _base(base)
+      , _jitter(jitter) {}
+
+    ss::future<result<raft::vote_reply>> vote(
+      model::node_id n,
+      raft::vote_request&& r,
+      rpc::client_opts opts) final {
+        return link_delay().then(
+          [this, n, r = std::move(r), opts = std::move(opts)]() mutable {
+              return _inner.vote(n, std::move(r), std::move(opts));
+          });
+    }
+
+    ss::future<result<raft::append_entries_reply>> append_entries(
+      model::node_id n,
+      raft::append_entries_request&& r,
+      rpc::client_opts opts) final {
+        return link_delay().then(
+          [this, n, r = std::move(r), opts = std::move(opts)]() mutable {
+              return _inner.append_entries(n, std::move(r), std::move(opts));
+          });
+    }
+
+    ss::future<result<raft::heartbeat_reply>> heartbeat(
+      model::node_id n,
+      raft::heartbeat_request&& r,
+      rpc::client_opts opts) final {
+        return link_delay().then(
+          [this, n, r = std::move(r), opts = std::move(opts)]() mutable {
+              return _inner.heartbeat(n, std::move(r), std::move(opts));
+          });
+    }
+
+    ss::future<result<raft::install_snapshot_reply>> install_snapshot(
+      model::node_id n,
+      raft::install_snapshot_request&& r,
+      rpc::client_opts opts) final {
+        return link_delay().then(
+          [this, n, r = std::move(r), opts = std::move(opts)]() mutable {
+              return _inner.install_snapshot(n, std::move(r), std::move(opts));
+          });
+    }
+
+    ss::future<result<raft::timeout_now_reply>> timeout_now(
+      model::node_id n,
+      raft::timeout_now_request&& r,
+      rpc::client_opts opts) final {
+        return link_delay().then(
+          [this, n, r = std::move(r), opts = std::move(opts)]() mutable {
+              return _inner.timeout_now(n, std::move(r), std::move(opts));
+          });
+    }
+
+private:
+    ss::future<> link_delay() {
+        auto d = _base;
+        if (_jitter.count() > 0) {
+            d += std::chrono::milliseconds(
+              random_generators::get_int<int64_t>(0, _jitter.count()));
+        }
+        if (d.count() == 0) {
+            return ss::now();
+        }
+        return ss::sleep(d);
+    }
+
+    raft::consensus_client_protocol _inner;
+    std::chrono::milliseconds _base;
+    std::chrono::milliseconds _jitter;
+};
+
+// installs the link latency decorator for raft groups created while in
+// scope and restores the identity decorator on exit
+struct scoped_link_latency {
+    scoped_link_latency(
+      std::chrono::milliseconds base, std::chrono::milliseconds jitter) {
+        client_protocol_decorator =
+          [base, jitter](raft::consensus_client_protocol p) {
+              return raft::make_consensus_client_protocol<
+                delayed_client_protocol>(std::move(p), base, jitter);
+          };
+    }
+    ~scoped_link_latency() {
+        client_protocol_decorator = [](raft::consensus_client_protocol p) {
+            return p;
+        };
+    }
+};
+
+static void replicate_rounds(int rounds, int batches_per_round) {
+    raft_group gr(raft::group_id(0), 3);
+    gr.enable_all();
+    gr.wait_for_leader().get0();
+    perf_tests::start_measuring_time();
+    for (int i = 0; i < rounds; ++i) {
+        auto success = replicate_random_batches(gr, batches_per_round).get0();
+        vassert(success, "replication round {} failed", i);
+    }
+    perf_tests::stop_measuring_time();
+}
+
+// replication throughput as a function of the number of batches handed to
+// a single replicate call - the axis the replicate_batcher operates on
+PERF_TEST(raft_bench, replicate_single_batch) {
+    return ss::async([] { replicate_rounds(10, 1); });
+}
+
+PERF_TEST(raft_bench, replicate_16_batches) {
+    return ss::async([] { replicate_rounds(10, 16); });
+}
+
+PERF_TEST(raft_bench, replicate_64_batches) {
+    return ss::async([] { replicate_rounds(10, 64); });
+}
+
+PERF_TEST(raft_bench, replicate_16_batches_slow_links) {
+    return ss::async([] {
+        scoped_link_latency latency(5ms, 5ms);
+        replicate_rounds(10, 16);
+    });
+}
+
+// time from losing the leader to the remaining members electing a new one
+PERF_TEST(raft_bench, election_convergence) {
+    return ss::async([] {
+        raft_group gr(raft::group_id(0), 3);
+        gr.enable_all();
+        auto leader = gr.wait_for_leader().get0();
+        gr.disable_node(leader);
+        perf_tests::start_measuring_time();
+        gr.wait_for_leader().get0();
+        perf_tests::stop_measuring_time();
+    });
+}
+
+// time for a follower that missed 100 batches to catch back up with the
+// leader's committed offset after rejoining
+PERF_TEST(raft_bench, follower_recovery) {
+    return ss::async([] {
+        raft_group gr(raft::group_id(0), 3);
+        gr.enable_all();
+        auto leader = gr.wait_for_leader().get0();
+        auto follower = model::node_id((leader() + 1) % 3);
+        gr.disable_node(follower);
+        auto success = replicate_random_batches(gr, 100).get0();
+        vassert(success, "replication failed");
+        auto target = gr.get_member(leader).consensus->committed_offset();
+        perf_tests::start_measuring_time();
+        gr.enable_node(follower);
+        while (gr.get_member(follower).consensus->committed_offset()
+               < target) {
+            ss::sleep(10ms).get0();
+        }
+        perf_tests::stop_measuring_time();
+    });
+}
@@ -40,6 +40,7 @@
 #include <fmt/core.h>
 
 #include <chrono>
+#include <functional>
 
 inline ss::logger tstlog("raft_test");
 
@@ -49,6 +50,15 @@ inline static auto heartbeat_interval = 40ms;
 inline static const raft::replicate_options
   default_replicate_opts(raft::consistency_level::quorum_ack);
 
+// wraps the client protocol of newly created nodes. benchmarks use this to
+// simulate link latency and jitter between group members; identity by
+// default so regular tests are unaffected.
+inline std::function<raft::consensus_client_protocol(
+  raft::consensus_client_protocol)>
+  client_protocol_decorator = [](raft::consensus_client_protocol p) {
+      return p;
+  };
+
 using consensus_ptr = ss::lw_shared_ptr<raft::consensus>;
 struct test_raft_manager {
     consensus_ptr consensus_for(raft::group_id) { return c; };
@@ -125,7 +135,8 @@ struct raft_node {
           *log,
           seastar::default_priority_class(),
           std::chrono::seconds(10),
-          raft::make_rpc_client_protocol(self_id, cache),
+          client_protocol_decorator(
+            raft::make_rpc_client_protocol(self_id, cache)),
           [this](raft::leadership_status st) { leader_callback(st); },
           storage.local());
 
@@ -169,7 +180,8 @@ struct raft_node {
         server.invoke_on_all(&rpc::server::start).get0();
         hbeats = std::make_unique<raft::heartbeat_manager>(
           heartbeat_interval,
-          raft::make_rpc_client_protocol(broker.id(), cache),
+          client_protocol_decorator(
+            raft::make_rpc_client_protocol(broker.id(), cache)),
           broker.id());
         hbeats->start().get0();
         hbeats->register_group(consensus).get();
@@ -121,6 +121,10 @@ SEASTAR_THREAD_TEST_CASE(heartbeat_request_roundtrip) {
         req.meta[i].prev_log_term = model::term_id(i);
         req.meta[i].last_visible_index = model::offset(i);
     }
+    req.unchanged = std::vector<raft::group_id>(one_k);
+    for (int64_t i = 0; i < one_k; ++i) {
+        req.unchanged[i] = raft::group_id(one_k + i);
+    }
     iobuf buf;
     reflection::async_adl<raft::heartbeat_request>{}
       .to(buf, std::move(req))
@@ -139,6 +143,7 @@ SEASTAR_THREAD_TEST_CASE(heartbeat_request_roundtrip) {
         BOOST_REQUIRE_EQUAL(res.meta[i].prev_log_index, model::offset(i));
         BOOST_REQUIRE_EQUAL(res.meta[i].prev_log_term, model::term_id(i));
         BOOST_REQUIRE_EQUAL(res.meta[i].last_visible_index, model::offset(i));
+        BOOST_REQUIRE_EQUAL(res.unchanged[i], raft::group_id(one_k + i));
     }
 }
 SEASTAR_THREAD_TEST_CASE(heartbeat_request_roundtrip_with_negative) {
@@ -52,8 +52,24 @@ std::ostream& operator<<(std::ostream& o, const heartbeat_request& r) {
     for (auto& m : r.meta) {
         o << m << ",";
     }
+    return o << "], unchanged:(" << r.unchanged.size() << ")}";
+}
+std::ostream& operator<<(std::ostream& o, const vote_bundle_request& r) {
+    o << "{requests:(" << r.requests.size() << ") [";
+    for (auto& v : r.requests) {
+        o << v << ",";
+    }
+    return o << "]}";
+}
+
+std::ostream& operator<<(std::ostream& o, const vote_bundle_reply& r) {
+    o << "{replies:(" << r.replies.size() << ") [";
+    for (auto& v : r.replies) {
+        o << v << ",";
+    }
     return o << "]}";
 }
+
 std::ostream& operator<<(std::ostream& o, const heartbeat_reply& r) {
     o << "{meta:[";
     for (auto& m : r.meta) {
@@ -301,6 +317,8 @@ ss::future<> async_adl<raft::heartbeat_request>::to(
         }
     };
     std::sort(request.meta.begin(), request.meta.end(), sorter_fn{});
+    std::sort(request.unchanged.begin(), request.unchanged.end());
+    auto unchanged = std::move(request.unchanged);
     return ss::make_ready_future<>()
       .then([&out, request = std::move(request)] {
           internal::hbeat_soa encodee(request.meta.size());
@@ -326,7 +344,8 @@ ss::future<> async_adl<raft::heartbeat_request>::to(
           adl<uint32_t>{}.to(out, size);
           return encodee;
       })
-      .then([&out](internal::hbeat_soa encodee) {
+      .then([&out,
+             unchanged = std::move(unchanged)](internal::hbeat_soa encodee) {
           internal::encode_one_delta_array<raft::group_id>(out, encodee.groups);
           internal::encode_one_delta_array<model::offset>(
             out, encodee.commit_indices);
@@ -337,6 +356,8 @@ ss::future<> async_adl<raft::heartbeat_request>::to(
             out, encodee.prev_log_terms);
           internal::encode_one_delta_array<model::offset>(
             out, encodee.last_visible_indices);
+          adl<uint32_t>{}.to(out, unchanged.size());
+          internal::encode_one_delta_array<raft::group_id>(out, unchanged);
       });
 }
 
@@ -345,12 +366,26 @@ T decode_signed(T value) {
     return value < T(0) ? T{} : value;
 }
 
+static std::vector<raft::group_id> decode_unchanged_groups(iobuf_parser& in) {
+    auto unchanged = std::vector<raft::group_id>(adl<uint32_t>{}.from(in));
+    if (unchanged.empty()) {
+        return unchanged;
+    }
+    unchanged[0] = varlong_reader<raft::group_id>(in);
+    for (size_t i = 1; i < unchanged.size(); ++i) {
+        unchanged[i] = internal::read_one_varint_delta<raft::group_id>(
+          in, unchanged[i - 1]);
+    }
+    return unchanged;
+}
+
 ss::future<raft::heartbeat_request>
 async_adl<raft::heartbeat_request>::from(iobuf_parser& in) {
     raft::heartbeat_request req;
     req.node_id = adl<model::node_id>{}.from(in);
     req.meta = std::vector<raft::protocol_metadata>(adl<uint32_t>{}.from(in));
     if (req.meta.empty()) {
+        req.unchanged = decode_unchanged_groups(in);
         return ss::make_ready_future<raft::heartbeat_request>(std::move(req));
     }
     const size_t max = req.meta.size();
@@ -395,6 +430,7 @@ async_adl<raft::heartbeat_request>::from(iobuf_parser& in) {
         m.prev_log_term = decode_signed(m.prev_log_term);
         m.last_visible_index = decode_signed(m.last_visible_index);
     }
+    req.unchanged = decode_unchanged_groups(in);
     return ss::make_ready_future<raft::heartbeat_request>(std::move(req));
 }
 
@@ -52,6 +52,14 @@ struct protocol_metadata {
     model::offset last_visible_index;
 };
 
+inline bool
+operator==(const protocol_metadata& lhs, const protocol_metadata& rhs) {
+    return lhs.group == rhs.group && lhs.commit_index == rhs.commit_index
+           && lhs.term == rhs.term && lhs.prev_log_index == rhs.prev_log_index
+           && lhs.prev_log_term == rhs.prev_log_term
+           && lhs.last_visible_index == rhs.last_visible_index;
+}
+
 // The sequence used to track the order of follower append entries request
 using follower_req_seq = named_type<uint64_t, struct follower_req_seq_tag>;
 
@@ -80,6 +88,12 @@ struct follower_index_metadata {
     // timestamp of last append_entries_rpc call
     clock_type::time_point last_append_timestamp;
     clock_type::time_point last_hbeat_timestamp;
+    // local time the request answered by the most recent reply was
+    // dispatched. leader leases are anchored here rather than at
+    // last_hbeat_timestamp: the follower restarted its election timer no
+    // earlier than the dispatch of the request it acked, while the reply
+    // arrives a network delay later
+    clock_type::time_point last_acked_append_timestamp;
     uint64_t failed_appends{0};
     // The pair of sequences used to track append entries requests sent and
     // received by the follower. Every time append entries request is created
@@ -216,6 +230,15 @@ struct append_entries_reply {
 struct heartbeat_request {
     model::node_id node_id;
     std::vector<protocol_metadata> meta;
+    /**
+     * groups whose protocol metadata did not change since the previous beat
+     * sent to the target node. only the group id travels on the wire, the
+     * receiver reconstructs the metadata from its per-source cache. a
+     * receiver that cannot reconstruct a group replies with
+     * `group_unavailable` which makes the sender fall back to full metadata
+     * for that group on the next beat.
+     */
+    std::vector<group_id> unchanged;
 };
 struct heartbeat_reply {
     std::vector<append_entries_reply> meta;
@@ -247,6 +270,22 @@ struct vote_reply {
     bool log_ok = false;
 };
 
+/**
+ * Vote solicitations for many raft groups bundled into a single request to
+ * one node. After a node restart thousands of groups elect at the same time
+ * and per-group vote rpcs would storm the connection cache; bundling
+ * flattens that into a handful of requests per peer, the same way the
+ * heartbeat manager batches beats. Replies are returned in request order.
+ */
+struct vote_bundle_request {
+    std::vector<vote_request> requests;
+};
+
+struct vote_bundle_reply {
+    /// replies in the same order as the bundled requests
+    std::vector<vote_reply> replies;
+};
+
 /// This structure is used by consensus to notify other systems about group
 /// leadership changes.
 struct leadership_status {
@@ -414,6 +453,8 @@ std::ostream& operator<<(std::ostream& o, const vote_request& r);
 std::ostream& operator<<(std::ostream& o, const follower_index_metadata& i);
 std::ostream& operator<<(std::ostream& o, const heartbeat_request& r);
 std::ostream& operator<<(std::ostream& o, const heartbeat_reply& r);
+std::ostream& operator<<(std::ostream& o, const vote_bundle_request& r);
+std::ostream& operator<<(std::ostream& o, const vote_bundle_reply& r);
 } // namespace raft
 
 namespace reflection {
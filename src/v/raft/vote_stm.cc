@@ -90,7 +90,7 @@ ss::future<> vote_stm::vote(bool leadership_transfer) {
               return ss::make_ready_future<skip_vote>(skip_vote::yes);
           }
           // 5.2.1
-          _ptr->_vstate = consensus::vote_state::candidate;
+          _ptr->set_vote_state(consensus::vote_state::candidate);
           _ptr->_leader_id = std::nullopt;
           _ptr->trigger_leadership_notification();
           // 5.2.1.2
@@ -201,7 +201,7 @@ ss::future<> vote_stm::update_vote_state(ss::semaphore_units<> u) {
                   _ctxlog.info, "Vote failed - received larger term: {}", term);
                 _ptr->_term = term;
                 _ptr->_voted_for = {};
-                _ptr->_vstate = consensus::vote_state::follower;
+                _ptr->set_vote_state(consensus::vote_state::follower);
                 return ss::now();
             }
         }
@@ -214,7 +214,7 @@ ss::future<> vote_stm::update_vote_state(ss::semaphore_units<> u) {
 
     if (!_success) {
         vlog(_ctxlog.info, "Vote failed");
-        _ptr->_vstate = consensus::vote_state::follower;
+        _ptr->set_vote_state(consensus::vote_state::follower);
         return ss::now();
     }
 
@@ -226,7 +226,7 @@ ss::future<> vote_stm::update_vote_state(ss::semaphore_units<> u) {
     }
     vlog(_ctxlog.trace, "vote acks in term {} from: {}", _ptr->term(), acks);
     // section vote:5.2.2
-    _ptr->_vstate = consensus::vote_state::leader;
+    _ptr->set_vote_state(consensus::vote_state::leader);
     _ptr->_leader_id = _ptr->self();
     // reset target priority
     _ptr->_target_priority = voter_priority::max();
@@ -15,33 +15,46 @@
 #include "config/configuration.h"
 #include "config/seed_server.h"
 #include "kafka/protocol.h"
+#include "kafka/read_latency_probe.h"
 #include "model/metadata.h"
 #include "platform/stop_signal.h"
+#include "prometheus/metrics_snapshot.h"
 #include "raft/service.h"
 #include "redpanda/admin/api-doc/config.json.h"
+#include "redpanda/admin/api-doc/debug.json.h"
 #include "redpanda/admin/api-doc/kafka.json.h"
 #include "redpanda/admin/api-doc/raft.json.h"
 #include "rpc/simple_protocol.h"
 #include "storage/chunk_cache.h"
 #include "storage/directories.h"
+#include "storage/parser_utils.h"
+#include "syschecks/doctor.h"
 #include "syschecks/syschecks.h"
 #include "test_utils/logs.h"
 #include "utils/file_io.h"
+#include "utils/trace_ring.h"
 #include "version.h"
 #include "vlog.h"
 
+#include <seastar/core/future-util.hh>
+#include <seastar/core/lowres_clock.hh>
 #include <seastar/core/metrics.hh>
 #include <seastar/core/prometheus.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/core/thread.hh>
+#include <seastar/core/timer.hh>
 #include <seastar/http/api_docs.hh>
 #include <seastar/http/exception.hh>
 #include <seastar/json/json_elements.hh>
 #include <seastar/util/defer.hh>
 
+#include <absl/container/flat_hash_map.h>
+#include <boost/range/irange.hpp>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 #include <sys/utsname.h>
 
+#include <algorithm>
 #include <chrono>
 #include <exception>
 #include <vector>
@@ -64,13 +77,7 @@ int application::run(int ac, char** av) {
         return ss::async([this, &cfg] {
             try {
                 ::stop_signal app_signal;
-                auto deferred = ss::defer([this] {
-                    auto deferred = std::move(_deferred);
-                    // stop services in reverse order
-                    while (!deferred.empty()) {
-                        deferred.pop_back();
-                    }
-                });
+                auto deferred = ss::defer([this] { shutdown(); });
                 // must initialize configuration before services
                 hydrate_config(cfg);
                 initialize();
@@ -93,6 +100,53 @@ int application::run(int ac, char** av) {
     });
 }
 
+void application::run_shutdown_stage(shutdown_stage& stage) {
+    if (stage.stops.empty()) {
+        return;
+    }
+    vlog(
+      _log.info,
+      "Stopping {} stage: {} services, {}ms deadline",
+      stage.name,
+      stage.stops.size(),
+      stage.deadline.count());
+    auto started = ss::lowres_clock::now();
+    std::vector<ss::future<>> futures;
+    futures.reserve(stage.stops.size());
+    for (auto& stop : stage.stops) {
+        futures.push_back(stop());
+    }
+    auto elapsed = [started] {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                 ss::lowres_clock::now() - started)
+          .count();
+    };
+    // a stage past its deadline is never abandoned - the services below it
+    // would be left referencing destroyed state - but it becomes loud so
+    // operators can see which stage is holding up the restart window
+    ss::timer<> watchdog([this, &stage, elapsed] {
+        vlog(
+          _log.error,
+          "Shutdown stage {} exceeded its deadline, waited {}ms so far",
+          stage.name,
+          elapsed());
+    });
+    watchdog.arm_periodic(stage.deadline);
+    auto results
+      = ss::when_all(futures.begin(), futures.end()).get0();
+    watchdog.cancel();
+    for (auto& f : results) {
+        if (f.failed()) {
+            vlog(
+              _log.error,
+              "Failure while stopping {} stage: {}",
+              stage.name,
+              f.get_exception());
+        }
+    }
+    vlog(_log.info, "Stopped {} stage in {}ms", stage.name, elapsed());
+}
+
 void application::initialize() {
     if (config::shard_local_cfg().enable_pid_file()) {
         syschecks::pidfile_create(config::shard_local_cfg().pidfile_path());
@@ -100,9 +154,27 @@ void application::initialize() {
     _scheduling_groups.create_groups().get();
     _deferred.emplace_back(
       [this] { _scheduling_groups.destroy_groups().get(); });
+    // scheduling group handles are global but the routing decision is
+    // shard local - register the compression group everywhere
+    ss::smp::invoke_on_all([sg = _scheduling_groups.compression_sg()] {
+        storage::internal::set_compression_scheduling_group(sg);
+    }).get();
     smp_service_groups.create_groups().get();
     _deferred.emplace_back(
       [this] { smp_service_groups.destroy_groups().get(); });
+
+    // arm the reactor stall detector on every shard. the capture hook only
+    // fires on a stall, so this stays enabled in production.
+    if (auto threshold
+        = config::shard_local_cfg().reactor_stall_capture_threshold_ms();
+        threshold.count() > 0) {
+        construct_service(_stall_ring).get();
+        _stall_ring
+          .invoke_on_all([threshold](syschecks::stall_ring& ring) {
+              ring.install(threshold);
+          })
+          .get();
+    }
 }
 
 void application::setup_metrics() {
@@ -180,7 +252,8 @@ void application::configure_admin_server() {
         return;
     }
     syschecks::systemd_message("constructing http server");
-    construct_service(_admin, ss::sstring("admin")).get();
+    construct_service_in_stage(_listener_stage, _admin, ss::sstring("admin"))
+      .get();
     // configure admin API TLS
     if (conf.admin_api_tls().is_enabled()) {
         _admin
@@ -222,6 +295,9 @@ void application::configure_admin_server() {
     metrics_conf.metric_help = "redpanda metrics";
     metrics_conf.prefix = "vectorized";
     ss::prometheus::add_prometheus_routes(_admin, metrics_conf).get();
+    // binary columnar sibling of the text endpoint for high frequency
+    // scraping
+    prometheus::add_metrics_snapshot_routes(_admin).get();
     if (conf.enable_admin_api()) {
         syschecks::systemd_message(
           "enabling admin HTTP api: {}", config::shard_local_cfg().admin());
@@ -239,6 +315,8 @@ void application::configure_admin_server() {
               rb->register_api_file(server._routes, "raft");
               rb->register_function(server._routes, insert_comma);
               rb->register_api_file(server._routes, "kafka");
+              rb->register_function(server._routes, insert_comma);
+              rb->register_api_file(server._routes, "debug");
               ss::httpd::config_json::get_config.set(
                 server._routes, []([[maybe_unused]] ss::const_req req) {
                     rapidjson::StringBuffer buf;
@@ -248,6 +326,7 @@ void application::configure_admin_server() {
                 });
               admin_register_raft_routes(server);
               admin_register_kafka_routes(server);
+              admin_register_debug_routes(server);
           })
           .get();
     }
@@ -286,8 +365,9 @@ static storage::kvstore_config kvstore_config_from_global_config() {
       storage::debug_sanitize_files::no);
 }
 
-static storage::log_config manager_config_from_global_config() {
-    return storage::log_config(
+static storage::log_config
+manager_config_from_global_config(scheduling_groups& sgs) {
+    auto cfg = storage::log_config(
       storage::log_config::storage_type::disk,
       config::shard_local_cfg().data_directory().as_sstring(),
       config::shard_local_cfg().log_segment_size(),
@@ -304,6 +384,8 @@ static storage::log_config manager_config_from_global_config() {
         .min_size = config::shard_local_cfg().reclaim_min_size(),
         .max_size = config::shard_local_cfg().reclaim_max_size(),
       });
+    cfg.compaction_sg = sgs.background_sg();
+    return cfg;
 }
 
 // add additional services in here
@@ -314,6 +396,10 @@ void application::wire_up_services() {
 
     // cluster
     syschecks::systemd_message("Adding raft client cache");
+    ss::smp::invoke_on_all([] {
+        rpc::connection_cache::set_shard_group_size(
+          config::shard_local_cfg().rpc_client_shard_group_size());
+    }).get();
     construct_service(_raft_connection_cache).get();
     syschecks::systemd_message("Building shard-lookup tables");
     construct_service(shard_table).get();
@@ -322,7 +408,7 @@ void application::wire_up_services() {
     construct_service(
       storage,
       kvstore_config_from_global_config(),
-      manager_config_from_global_config())
+      manager_config_from_global_config(_scheduling_groups))
       .get();
 
     if (coproc_enabled()) {
@@ -385,12 +471,21 @@ void application::wire_up_services() {
       std::ref(_raft_connection_cache))
       .get();
 
+    syschecks::systemd_message("Creating leadership balancer");
+    construct_service(
+      leader_balancer,
+      std::ref(controller->get_partition_leaders()),
+      std::ref(controller->get_members_table()),
+      std::ref(partition_manager))
+      .get();
+
     // group membership
     syschecks::systemd_message("Creating partition manager");
     construct_service(
       _group_manager,
       std::ref(raft_group_manager),
       std::ref(partition_manager),
+      std::ref(storage),
       std::ref(config::shard_local_cfg()))
       .get();
     syschecks::systemd_message("Creating kafka group shard mapper");
@@ -417,6 +512,11 @@ void application::wire_up_services() {
     rpc_cfg.load_balancing_algo
       = ss::server_socket::load_balancing_algorithm::port;
     rpc_cfg.max_service_memory_per_core = memory_groups::rpc_total_memory();
+    // raft traffic must keep flowing during kafka client storms
+    rpc_cfg.dispatch_sg = _scheduling_groups.internal_rpc_sg();
+    rpc_cfg.tcp_nodelay = config::shard_local_cfg().rpc_server_tcp_nodelay();
+    rpc_cfg.tcp_send_buf = config::shard_local_cfg().rpc_server_tcp_send_buf();
+    rpc_cfg.tcp_recv_buf = config::shard_local_cfg().rpc_server_tcp_recv_buf();
     auto rpc_server_addr
       = config::shard_local_cfg().rpc_server().resolve().get0();
     rpc_cfg.addrs.push_back(rpc_server_addr);
@@ -436,7 +536,7 @@ void application::wire_up_services() {
                         .get0()
                     : nullptr;
     syschecks::systemd_message("Starting internal RPC {}", rpc_cfg);
-    construct_service(_rpc, rpc_cfg).get();
+    construct_service_in_stage(_listener_stage, _rpc, rpc_cfg).get();
 
     // coproc rpc
     if (coproc_enabled()) {
@@ -451,11 +551,16 @@ void application::wire_up_services() {
         cp_rpc_cfg.addrs.push_back(coproc_script_manager_server_addr);
         syschecks::systemd_message(
           "Starting coprocessor internal RPC {}", cp_rpc_cfg);
-        construct_service(_coproc_rpc, cp_rpc_cfg).get();
+        construct_service_in_stage(_listener_stage, _coproc_rpc, cp_rpc_cfg)
+          .get();
     }
 
     rpc::server_configuration kafka_cfg("kafka_rpc");
     kafka_cfg.max_service_memory_per_core = memory_groups::kafka_total_memory();
+    kafka_cfg.dispatch_sg = _scheduling_groups.kafka_sg();
+    kafka_cfg.tcp_nodelay = config::shard_local_cfg().kafka_api_tcp_nodelay();
+    kafka_cfg.tcp_send_buf = config::shard_local_cfg().kafka_api_tcp_send_buf();
+    kafka_cfg.tcp_recv_buf = config::shard_local_cfg().kafka_api_tcp_recv_buf();
     auto kafka_addr = config::shard_local_cfg().kafka_api().resolve().get0();
     kafka_cfg.addrs.push_back(kafka_addr);
     syschecks::systemd_message("Building TLS credentials for kafka");
@@ -475,8 +580,12 @@ void application::wire_up_services() {
                           .get0()
                       : nullptr;
     syschecks::systemd_message("Starting kafka RPC {}", kafka_cfg);
-    construct_service(_kafka_server, kafka_cfg).get();
-    construct_service(
+    construct_service_in_stage(_listener_stage, _kafka_server, kafka_cfg).get();
+    construct_service_in_stage(_background_stage, _memory_broker).get();
+    construct_service_in_stage(_background_stage, _background_share_tuner)
+      .get();
+    construct_service_in_stage(
+      _background_stage,
       fetch_session_cache,
       config::shard_local_cfg().fetch_session_eviction_timeout_ms())
       .get();
@@ -505,6 +614,9 @@ void application::start() {
       .invoke_on_all(&cluster::metadata_dissemination_service::start)
       .get();
 
+    syschecks::systemd_message("Starting leadership balancer");
+    leader_balancer.invoke_on_all(&cluster::leader_balancer::start).get();
+
     syschecks::systemd_message("Starting RPC");
     _rpc
       .invoke_on_all([this](rpc::server& s) {
@@ -573,6 +685,33 @@ void application::start() {
     vlog(
       _log.info, "Started Kafka API server listening at {}", conf.kafka_api());
 
+    // Memory broker: arbitrate admission budget between the kafka and
+    // internal rpc servers now that both semaphores exist
+    _memory_broker
+      .invoke_on_all([this](memory_broker& broker) {
+          broker.register_group(
+            "kafka",
+            _kafka_server.local().memory(),
+            memory_groups::kafka_total_memory());
+          broker.register_group(
+            "rpc",
+            _rpc.local().memory(),
+            memory_groups::rpc_total_memory());
+          broker.start();
+      })
+      .get();
+
+    // Throttle background (compaction) cpu shares from the kafka handler
+    // latency observed on each shard
+    _background_share_tuner
+      .invoke_on_all([this](background_share_tuner& tuner) {
+          tuner.start(
+            _scheduling_groups.background_sg(),
+            _kafka_server.local().histogram(),
+            100);
+      })
+      .get();
+
     vlog(_log.info, "Successfully started Redpanda!");
     syschecks::systemd_notify_ready();
 }
@@ -640,6 +779,140 @@ void application::admin_register_raft_routes(ss::http_server& server) {
 }
 
 void application::admin_register_kafka_routes(ss::http_server& server) {
+    ss::httpd::kafka_json::get_partitions.set(
+      server._routes, [this](std::unique_ptr<ss::httpd::request>) {
+          /*
+           * Rendered response cache invalidated with the metadata cache
+           * version counter, the same trick as the kafka metadata response
+           * cache. Orchestration tooling polls this listing from every node
+           * every second; in steady state the request is answered from the
+           * cached buffer without touching the topic table.
+           */
+          struct rendered_listing {
+              uint64_t version;
+              ss::sstring body;
+          };
+          static thread_local std::optional<rendered_listing> cache;
+
+          const auto version = metadata_cache.local().version();
+          if (!cache || cache->version != version) {
+              rapidjson::StringBuffer buf;
+              rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+              writer.StartArray();
+              for (const auto& md : metadata_cache.local()
+                                      .all_topics_metadata()) {
+                  writer.StartObject();
+                  writer.Key("ns");
+                  writer.String(md.tp_ns.ns().c_str());
+                  writer.Key("topic");
+                  writer.String(md.tp_ns.tp().c_str());
+                  writer.Key("partitions");
+                  writer.StartArray();
+                  for (const auto& p : md.partitions) {
+                      writer.StartObject();
+                      writer.Key("id");
+                      writer.Int(p.id());
+                      writer.Key("leader");
+                      if (p.leader_node) {
+                          writer.Int((*p.leader_node)());
+                      } else {
+                          writer.Null();
+                      }
+                      writer.Key("replicas");
+                      writer.StartArray();
+                      for (const auto& r : p.replicas) {
+                          writer.StartObject();
+                          writer.Key("node_id");
+                          writer.Int(r.node_id());
+                          writer.Key("shard");
+                          writer.Uint(r.shard);
+                          writer.EndObject();
+                      }
+                      writer.EndArray();
+                      writer.EndObject();
+                  }
+                  writer.EndArray();
+                  writer.EndObject();
+              }
+              writer.EndArray();
+              cache = rendered_listing{
+                .version = version,
+                .body = ss::sstring(buf.GetString(), buf.GetSize()),
+              };
+          }
+          return ss::json::json_return_type(cache->body);
+      });
+
+    ss::httpd::kafka_json::get_read_latency.set(
+      server._routes, [](std::unique_ptr<ss::httpd::request>) {
+          using samples_t
+            = std::vector<kafka::read_latency_probe::topic_samples>;
+          // pull every shard's reservoirs and merge per topic. the merged
+          // sample is a union of uniform samples, close enough for SLO
+          // tracking since shards see comparable traffic for a topic
+          return ss::map_reduce(
+                   boost::irange<unsigned>(0, ss::smp::count),
+                   [](unsigned shard) {
+                       return ss::smp::submit_to(shard, [] {
+                           return kafka::read_latency_probe::local()
+                             .snapshot();
+                       });
+                   },
+                   samples_t{},
+                   [](samples_t acc, samples_t shard_samples) {
+                       std::move(
+                         shard_samples.begin(),
+                         shard_samples.end(),
+                         std::back_inserter(acc));
+                       return acc;
+                   })
+            .then([](samples_t all) {
+                struct merged_samples {
+                    uint64_t total{0};
+                    std::vector<int64_t> samples_us;
+                };
+                absl::flat_hash_map<model::topic, merged_samples> merged;
+                for (auto& ts : all) {
+                    auto& m = merged[ts.topic];
+                    m.total += ts.total;
+                    std::move(
+                      ts.samples_us.begin(),
+                      ts.samples_us.end(),
+                      std::back_inserter(m.samples_us));
+                }
+                auto quantile =
+                  [](std::vector<int64_t>& sorted, double q) -> int64_t {
+                    auto rank = static_cast<size_t>(
+                      q * double(sorted.size() - 1));
+                    return sorted[rank];
+                };
+                rapidjson::StringBuffer buf;
+                rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+                writer.StartArray();
+                for (auto& [topic, m] : merged) {
+                    if (m.samples_us.empty()) {
+                        continue;
+                    }
+                    std::sort(m.samples_us.begin(), m.samples_us.end());
+                    writer.StartObject();
+                    writer.Key("topic");
+                    writer.String(topic().c_str());
+                    writer.Key("samples");
+                    writer.Uint64(m.total);
+                    writer.Key("p50_us");
+                    writer.Int64(quantile(m.samples_us, 0.5));
+                    writer.Key("p90_us");
+                    writer.Int64(quantile(m.samples_us, 0.9));
+                    writer.Key("p99_us");
+                    writer.Int64(quantile(m.samples_us, 0.99));
+                    writer.EndObject();
+                }
+                writer.EndArray();
+                return ss::json::json_return_type(
+                  ss::sstring(buf.GetString(), buf.GetSize()));
+            });
+      });
+
     ss::httpd::kafka_json::kafka_transfer_leadership.set(
       server._routes, [this](std::unique_ptr<ss::httpd::request> req) {
           auto topic = model::topic(req->param["topic"]);
@@ -708,3 +981,290 @@ void application::admin_register_kafka_routes(ss::http_server& server) {
             });
       });
 }
+
+void application::admin_register_debug_routes(ss::http_server& server) {
+    ss::httpd::debug_json::get_doctor_report.set(
+      server._routes, [this](std::unique_ptr<ss::httpd::request>) {
+          // every shard samples its own probes over a short interval and
+          // ranks them; the first finding per shard is its bottleneck
+          static constexpr auto sample_interval
+            = std::chrono::milliseconds(100);
+          return ss::map_reduce(
+                   boost::irange<unsigned>(0, ss::smp::count),
+                   [this](unsigned shard) {
+                       return ss::smp::submit_to(shard, [this] {
+                           const auto busy = ss::engine().total_busy_time();
+                           return ss::sleep(sample_interval)
+                             .then([this, busy] {
+                                 syschecks::doctor_sample s;
+                                 s.reactor_utilization = std::min(
+                                   std::chrono::duration<double>(
+                                     ss::engine().total_busy_time() - busy)
+                                     / std::chrono::duration<double>(
+                                       sample_interval),
+                                   1.0);
+                                 auto& chunks = storage::internal::chunks();
+                                 s.append_chunk_utilization
+                                   = chunks.utilization();
+                                 s.append_chunk_waiters = chunks.waiters();
+                                 for (const auto& r :
+                                      storage.local().io_rates()) {
+                                     s.cached_read_bytes_sec
+                                       += r.cached_read_bytes_sec;
+                                     s.disk_read_bytes_sec += r.read_bytes_sec;
+                                 }
+                                 const auto mem = ss::memory::stats();
+                                 s.memory_free = mem.free_memory();
+                                 s.memory_total = mem.total_memory();
+                                 s.memory_reclaims = mem.reclaims();
+                                 return syschecks::diagnose(s);
+                             });
+                       });
+                   },
+                   std::vector<syschecks::doctor_report>{},
+                   [](
+                     std::vector<syschecks::doctor_report> acc,
+                     syschecks::doctor_report r) {
+                       acc.push_back(std::move(r));
+                       return acc;
+                   })
+            .then([](std::vector<syschecks::doctor_report> reports) {
+                std::sort(
+                  reports.begin(),
+                  reports.end(),
+                  [](
+                    const syschecks::doctor_report& a,
+                    const syschecks::doctor_report& b) {
+                      return a.shard < b.shard;
+                  });
+                rapidjson::StringBuffer buf;
+                rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+                writer.StartArray();
+                for (const auto& report : reports) {
+                    writer.StartObject();
+                    writer.Key("shard");
+                    writer.Uint(report.shard);
+                    writer.Key("findings");
+                    writer.StartArray();
+                    for (const auto& f : report.findings) {
+                        writer.StartObject();
+                        writer.Key("resource");
+                        writer.String(f.resource.c_str());
+                        writer.Key("severity");
+                        writer.Double(f.severity);
+                        writer.Key("detail");
+                        writer.String(f.detail.c_str());
+                        writer.EndObject();
+                    }
+                    writer.EndArray();
+                    writer.EndObject();
+                }
+                writer.EndArray();
+                return ss::json::json_return_type(buf.GetString());
+            });
+      });
+
+    ss::httpd::debug_json::get_trace_log.set(
+      server._routes, [](std::unique_ptr<ss::httpd::request>) {
+          // render every shard's ring; formatting happens here, on demand,
+          // never on the recording path
+          return ss::map_reduce(
+                   boost::irange<unsigned>(0, ss::smp::count),
+                   [](unsigned shard) {
+                       return ss::smp::submit_to(
+                         shard, [] { return trace_ring::local().render(); });
+                   },
+                   std::vector<trace_ring::report>{},
+                   [](
+                     std::vector<trace_ring::report> acc,
+                     trace_ring::report r) {
+                       acc.push_back(std::move(r));
+                       return acc;
+                   })
+            .then([](std::vector<trace_ring::report> reports) {
+                std::sort(
+                  reports.begin(),
+                  reports.end(),
+                  [](const trace_ring::report& a, const trace_ring::report& b) {
+                      return a.shard < b.shard;
+                  });
+                rapidjson::StringBuffer buf;
+                rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+                writer.StartArray();
+                for (const auto& report : reports) {
+                    writer.StartObject();
+                    writer.Key("shard");
+                    writer.Uint(report.shard);
+                    writer.Key("total");
+                    writer.Uint64(report.total);
+                    writer.Key("entries");
+                    writer.StartArray();
+                    for (const auto& e : report.entries) {
+                        writer.StartObject();
+                        writer.Key("age_ms");
+                        writer.Int64(e.age.count());
+                        writer.Key("message");
+                        writer.String(e.message.c_str());
+                        writer.EndObject();
+                    }
+                    writer.EndArray();
+                    writer.EndObject();
+                }
+                writer.EndArray();
+                return ss::json::json_return_type(buf.GetString());
+            });
+      });
+
+    ss::httpd::debug_json::get_reactor_stalls.set(
+      server._routes, [this](std::unique_ptr<ss::httpd::request>) {
+          if (!_stall_ring.local_is_initialized()) {
+              return ss::make_ready_future<ss::json::json_return_type>(
+                ss::json::json_return_type("[]"));
+          }
+          return _stall_ring
+            .map([](syschecks::stall_ring& ring) { return ring.render(); })
+            .then([](std::vector<syschecks::stall_ring::report> reports) {
+                rapidjson::StringBuffer buf;
+                rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+                writer.StartArray();
+                for (const auto& report : reports) {
+                    writer.StartObject();
+                    writer.Key("shard");
+                    writer.Uint(report.shard);
+                    writer.Key("total");
+                    writer.Uint64(report.total);
+                    writer.Key("stalls");
+                    writer.StartArray();
+                    for (const auto& s : report.samples) {
+                        writer.StartObject();
+                        writer.Key("seq");
+                        writer.Uint64(s.seq);
+                        writer.Key("age_ms");
+                        writer.Int64(s.age.count());
+                        writer.Key("backtrace");
+                        writer.String(s.backtrace.c_str());
+                        writer.EndObject();
+                    }
+                    writer.EndArray();
+                    writer.EndObject();
+                }
+                writer.EndArray();
+                return ss::json::json_return_type(buf.GetString());
+            });
+      });
+
+    ss::httpd::debug_json::get_storage_io_rates.set(
+      server._routes, [this](std::unique_ptr<ss::httpd::request>) {
+          return storage
+            .map_reduce0(
+              [](storage::api& s) { return s.io_rates(); },
+              std::vector<storage::log_io_rates>{},
+              [](
+                std::vector<storage::log_io_rates> acc,
+                std::vector<storage::log_io_rates> r) {
+                  std::move(r.begin(), r.end(), std::back_inserter(acc));
+                  return acc;
+              })
+            .then([](std::vector<storage::log_io_rates> rates) {
+                // hottest partition first: the answer to "who is hammering
+                // the disk" should be the first array element
+                std::sort(
+                  rates.begin(),
+                  rates.end(),
+                  [](
+                    const storage::log_io_rates& a,
+                    const storage::log_io_rates& b) {
+                      return a.write_bytes_sec + a.read_bytes_sec
+                               + a.cached_read_bytes_sec
+                             > b.write_bytes_sec + b.read_bytes_sec
+                                 + b.cached_read_bytes_sec;
+                  });
+                rapidjson::StringBuffer buf;
+                rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+                writer.StartArray();
+                for (const auto& r : rates) {
+                    writer.StartObject();
+                    writer.Key("ntp");
+                    auto ntp = fmt::format("{}", r.ntp);
+                    writer.String(ntp.c_str());
+                    writer.Key("write_bytes_sec");
+                    writer.Double(r.write_bytes_sec);
+                    writer.Key("read_bytes_sec");
+                    writer.Double(r.read_bytes_sec);
+                    writer.Key("cached_read_bytes_sec");
+                    writer.Double(r.cached_read_bytes_sec);
+                    writer.Key("flushes_sec");
+                    writer.Double(r.flushes_sec);
+                    writer.Key("cache_hit_ratio");
+                    writer.Double(r.cache_hit_ratio);
+                    writer.EndObject();
+                }
+                writer.EndArray();
+                return ss::json::json_return_type(buf.GetString());
+            });
+      });
+
+    ss::httpd::debug_json::verify_storage.set(
+      server._routes, [this](std::unique_ptr<ss::httpd::request>) {
+          return storage
+            .map_reduce0(
+              [](storage::api& s) { return s.verify(); },
+              std::vector<storage::verify_report>{},
+              [](
+                std::vector<storage::verify_report> acc,
+                storage::verify_report r) {
+                  acc.push_back(std::move(r));
+                  return acc;
+              })
+            .then([](std::vector<storage::verify_report> reports) {
+                rapidjson::StringBuffer buf;
+                rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+                writer.StartArray();
+                for (const auto& r : reports) {
+                    writer.StartObject();
+                    writer.Key("shard");
+                    writer.Uint(r.shard);
+                    writer.Key("logs");
+                    writer.Uint64(r.logs_verified);
+                    writer.Key("segments");
+                    writer.Uint64(r.segments_verified);
+                    writer.Key("bytes");
+                    writer.Uint64(r.bytes_verified);
+                    writer.Key("batches");
+                    writer.Uint64(r.batches_verified);
+                    writer.Key("elapsed_ms");
+                    writer.Int64(r.elapsed.count());
+                    writer.Key("corrupted_logs");
+                    writer.StartArray();
+                    for (const auto& l : r.corrupted_logs) {
+                        writer.StartObject();
+                        writer.Key("ntp");
+                        auto ntp = fmt::format("{}", l.ntp);
+                        writer.String(ntp.c_str());
+                        writer.Key("segments");
+                        writer.StartArray();
+                        for (const auto& s : l.corruptions) {
+                            writer.StartObject();
+                            writer.Key("path");
+                            writer.String(s.path.c_str());
+                            writer.Key("size_bytes");
+                            writer.Uint64(s.size_bytes);
+                            // [corrupt_range_begin, size_bytes) failed to
+                            // validate
+                            writer.Key("corrupt_range_begin");
+                            writer.Uint64(s.bytes_verified);
+                            writer.Key("error");
+                            writer.String(s.error->c_str());
+                            writer.EndObject();
+                        }
+                        writer.EndArray();
+                        writer.EndObject();
+                    }
+                    writer.EndArray();
+                    writer.EndObject();
+                }
+                writer.EndArray();
+                return ss::json::json_return_type(buf.GetString());
+            });
+      });
+}
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "cluster/controller.h"
+#include "cluster/leader_balancer.h"
 #include "cluster/metadata_cache.h"
 #include "cluster/metadata_dissemination_service.h"
 #include "cluster/partition_manager.h"
@@ -24,11 +25,13 @@
 #include "kafka/quota_manager.h"
 #include "raft/group_manager.h"
 #include "resource_mgmt/cpu_scheduling.h"
+#include "resource_mgmt/memory_broker.h"
 #include "resource_mgmt/memory_groups.h"
 #include "resource_mgmt/smp_groups.h"
 #include "rpc/server.h"
 #include "seastarx.h"
 #include "storage/api.h"
+#include "syschecks/stall_ring.h"
 
 #include <seastar/core/app-template.hh>
 #include <seastar/core/metrics_registration.hh>
@@ -36,6 +39,10 @@
 #include <seastar/http/httpd.hh>
 #include <seastar/util/defer.hh>
 
+#include <chrono>
+#include <functional>
+#include <vector>
+
 namespace po = boost::program_options; // NOLINT
 
 class application {
@@ -49,6 +56,8 @@ public:
     void start();
 
     void shutdown() {
+        run_shutdown_stage(_background_stage);
+        run_shutdown_stage(_listener_stage);
         while (!_deferred.empty()) {
             _deferred.pop_back();
         }
@@ -63,6 +72,7 @@ public:
     ss::sharded<raft::group_manager> raft_group_manager;
     ss::sharded<cluster::metadata_dissemination_service>
       md_dissemination_service;
+    ss::sharded<cluster::leader_balancer> leader_balancer;
     ss::sharded<kafka::coordinator_ntp_mapper> coordinator_ntp_mapper;
     std::unique_ptr<cluster::controller> controller;
     ss::sharded<kafka::fetch_session_cache> fetch_session_cache;
@@ -81,12 +91,29 @@ private:
 
     void admin_register_raft_routes(ss::http_server& server);
     void admin_register_kafka_routes(ss::http_server& server);
+    void admin_register_debug_routes(ss::http_server& server);
 
     bool coproc_enabled() {
         const auto& cfg = config::shard_local_cfg();
         return cfg.developer_mode() && cfg.enable_coproc();
     }
 
+    /*
+     * Services whose teardown does not depend on each other are grouped
+     * into stages and stopped in parallel, before the remaining deferred
+     * actions run in reverse construction order. Each stage carries a
+     * deadline; a stage that exceeds it logs an error periodically but is
+     * never cut short, since abandoning a stop would leave the services
+     * below it referencing destroyed state.
+     */
+    struct shutdown_stage {
+        ss::sstring name;
+        std::chrono::milliseconds deadline;
+        std::vector<std::function<ss::future<>()>> stops;
+    };
+
+    void run_shutdown_stage(shutdown_stage&);
+
     template<typename Service, typename... Args>
     ss::future<> construct_service(ss::sharded<Service>& s, Args&&... args) {
         auto f = s.start(std::forward<Args>(args)...);
@@ -94,6 +121,14 @@ private:
         return f;
     }
 
+    template<typename Service, typename... Args>
+    ss::future<> construct_service_in_stage(
+      shutdown_stage& stage, ss::sharded<Service>& s, Args&&... args) {
+        auto f = s.start(std::forward<Args>(args)...);
+        stage.stops.emplace_back([&s] { return s.stop(); });
+        return f;
+    }
+
     template<typename Service, typename... Args>
     void construct_single_service(std::unique_ptr<Service>& s, Args&&... args) {
         s = std::make_unique<Service>(std::forward<Args>(args)...);
@@ -109,8 +144,18 @@ private:
     ss::sharded<kafka::group_manager> _group_manager;
     ss::sharded<rpc::server> _rpc;
     ss::sharded<ss::http_server> _admin;
+    ss::sharded<syschecks::stall_ring> _stall_ring;
     ss::sharded<rpc::server> _kafka_server;
+    ss::sharded<memory_broker> _memory_broker;
+    ss::sharded<background_share_tuner> _background_share_tuner;
     ss::metrics::metric_groups _metrics;
+    // shard-local helpers that watch the network servers, stopped first
+    shutdown_stage _background_stage{
+      .name = "background", .deadline = std::chrono::seconds(5)};
+    // network front ends; draining connections dominates shutdown time
+    // under load, so all listeners drain concurrently
+    shutdown_stage _listener_stage{
+      .name = "listeners", .deadline = std::chrono::seconds(30)};
     // run these first on destruction
     deferred_actions _deferred;
 };
@@ -53,6 +53,36 @@ struct is_ss_bool<ss::bool_class<T>> : std::true_type {};
 template<typename T>
 inline constexpr bool is_ss_bool_v = is_ss_bool<T>::value;
 
+namespace detail {
+/**
+ * Field-type traits over the std::tie tuple produced by to_tuple. When
+ * every field is an integral, enum, bool_class or named_type over an
+ * integral, and the fields pack without padding
+ * (packed_size == sizeof of the aggregate), the field-by-field little
+ * endian encoding is byte-identical to the object representation on
+ * little endian hosts - the whole struct can be copied in one shot.
+ * Types with custom adl specializations never reach the generic branch
+ * that consults this, so member encodings cannot diverge.
+ */
+template<typename U>
+struct is_flat_field
+  : std::bool_constant<
+      std::is_integral_v<U> || std::is_enum_v<U> || is_ss_bool_v<U>> {};
+template<typename U, typename Tag>
+struct is_flat_field<named_type<U, Tag>>
+  : std::bool_constant<std::is_integral_v<U>> {};
+
+template<typename Tuple>
+struct flat_fields;
+template<typename... Ts>
+struct flat_fields<std::tuple<Ts...>> {
+    static constexpr bool all_scalars
+      = (... && is_flat_field<std::decay_t<Ts>>::value);
+    static constexpr size_t packed_size
+      = (size_t(0) + ... + sizeof(std::decay_t<Ts>));
+};
+} // namespace detail
+
 template<typename T>
 struct adl {
     using type = std::remove_reference_t<std::decay_t<T>>;
@@ -116,12 +146,21 @@ struct adl {
             return std::chrono::milliseconds(
               ss::le_to_cpu(in.consume_type<int64_t>()));
         } else if constexpr (is_standard_layout) {
-            T t;
-            reflection::for_each_field(t, [&in](auto& field) mutable {
-                field = std::move(
-                  adl<std::decay_t<decltype(field)>>{}.from(in));
-            });
-            return t;
+            using fields = detail::flat_fields<
+              std::decay_t<decltype(reflection::to_tuple(std::declval<type&>()))>>;
+            if constexpr (
+              is_trivially_copyable && fields::all_scalars
+              && fields::packed_size == sizeof(type)) {
+                // flat fast path, see detail::flat_fields
+                return in.consume_type<type>();
+            } else {
+                T t;
+                reflection::for_each_field(t, [&in](auto& field) mutable {
+                    field = std::move(
+                      adl<std::decay_t<decltype(field)>>{}.from(in));
+                });
+                return t;
+            }
         }
     }
 
@@ -170,15 +209,24 @@ struct adl {
             adl<int64_t>{}.to(out, t.count());
             return;
         } else if constexpr (is_standard_layout) {
-            /*
-            std::apply(
-              [&out](auto&&... args) {
-                  (adl<decltype(args)>{}.to(out, std::move(args)), ...);
-              },
-              reflection::to_tuple(t)); */
-            reflection::for_each_field(t, [&out](auto& field) {
-                adl<std::decay_t<decltype(field)>>{}.to(out, std::move(field));
-            });
+            using fields = detail::flat_fields<
+              std::decay_t<decltype(reflection::to_tuple(t))>>;
+            if constexpr (
+              is_trivially_copyable && fields::all_scalars
+              && fields::packed_size == sizeof(type)) {
+                // flat fast path, see detail::flat_fields. encoding a
+                // frame header becomes one append instead of a field walk
+                static_assert(
+                  __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+                  "flat adl encoding assumes a little endian host");
+                // NOLINTNEXTLINE
+                out.append(reinterpret_cast<const char*>(&t), sizeof(type));
+            } else {
+                reflection::for_each_field(t, [&out](auto& field) {
+                    adl<std::decay_t<decltype(field)>>{}.to(
+                      out, std::move(field));
+                });
+            }
             return;
         }
     }
@@ -28,6 +28,63 @@ struct async_adl {
     }
 };
 
+namespace detail {
+template<typename... Fields>
+ss::future<> encode_fields_async(iobuf& out, Fields&... fields) {
+    auto fut = ss::now();
+    ((fut = fut.then([&out, &f = fields] {
+         return async_adl<std::decay_t<decltype(f)>>{}.to(out, std::move(f));
+     })),
+     ...);
+    return fut;
+}
+template<typename... Fields>
+ss::future<> decode_fields_async(iobuf_parser& in, Fields&... fields) {
+    auto fut = ss::now();
+    ((fut = fut.then([&in, &f = fields] {
+         return async_adl<std::decay_t<decltype(f)>>{}.from(in).then(
+           [&f](auto v) { f = std::move(v); });
+     })),
+     ...);
+    return fut;
+}
+} // namespace detail
+
+/**
+ * Opt-in asynchronous serializer for standard-layout aggregates: fields
+ * are walked in declaration order through their own async_adl, so vector
+ * fields yield between elements instead of encoding a multi-megabyte
+ * payload in one reactor task. The wire format is identical to the
+ * generic field-walking adl<T>; types with a custom adl specialization
+ * must not use it (their encoding would diverge) and need a hand written
+ * async_adl instead.
+ */
+template<typename T>
+struct async_adl_struct {
+    using type = std::remove_reference_t<std::decay_t<T>>;
+
+    ss::future<> to(iobuf& out, type t) {
+        return ss::do_with(std::move(t), [&out](type& t) {
+            return std::apply(
+              [&out](auto&... fields) {
+                  return detail::encode_fields_async(out, fields...);
+              },
+              reflection::to_tuple(t));
+        });
+    }
+
+    ss::future<type> from(iobuf_parser& in) {
+        return ss::do_with(type{}, [&in](type& t) {
+            return std::apply(
+                     [&in](auto&... fields) {
+                         return detail::decode_fields_async(in, fields...);
+                     },
+                     reflection::to_tuple(t))
+              .then([&t] { return std::move(t); });
+        });
+    }
+};
+
 template<typename T>
 struct async_adl<std::vector<T>> {
     using value_type = std::remove_reference_t<std::decay_t<T>>;
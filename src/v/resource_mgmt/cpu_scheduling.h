@@ -11,10 +11,16 @@
 
 #pragma once
 
+#include "prometheus/prometheus_sanitize.h"
 #include "seastarx.h"
+#include "utils/hdr_hist.h"
 
 #include <seastar/core/future.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics.hh>
+#include <seastar/core/metrics_registration.hh>
 #include <seastar/core/scheduling.hh>
+#include <seastar/core/timer.hh>
 
 // manage cpu scheduling groups. scheduling groups are global, so one instance
 // of this class can be created at the top level and passed down into any server
@@ -31,7 +37,13 @@ public:
           .then([] { return ss::create_scheduling_group("cluster", 300); })
           .then([this](ss::scheduling_group sg) { _cluster = sg; })
           .then([] { return ss::create_scheduling_group("coproc", 100); })
-          .then([this](ss::scheduling_group sg) { _coproc = sg; });
+          .then([this](ss::scheduling_group sg) { _coproc = sg; })
+          .then([] { return ss::create_scheduling_group("background", 100); })
+          .then([this](ss::scheduling_group sg) { _background = sg; })
+          .then([] { return ss::create_scheduling_group("internal_rpc", 1000); })
+          .then([this](ss::scheduling_group sg) { _internal_rpc = sg; })
+          .then([] { return ss::create_scheduling_group("compression", 500); })
+          .then([this](ss::scheduling_group sg) { _compression = sg; });
     }
 
     ss::future<> destroy_groups() {
@@ -39,7 +51,10 @@ public:
           .then([this] { return destroy_scheduling_group(_raft); })
           .then([this] { return destroy_scheduling_group(_kafka); })
           .then([this] { return destroy_scheduling_group(_cluster); })
-          .then([this] { return destroy_scheduling_group(_coproc); });
+          .then([this] { return destroy_scheduling_group(_coproc); })
+          .then([this] { return destroy_scheduling_group(_background); })
+          .then([this] { return destroy_scheduling_group(_internal_rpc); })
+          .then([this] { return destroy_scheduling_group(_compression); });
     }
 
     ss::scheduling_group admin_sg() { return _admin; }
@@ -47,6 +62,20 @@ public:
     ss::scheduling_group kafka_sg() { return _kafka; }
     ss::scheduling_group cluster_sg() { return _cluster; }
     ss::scheduling_group coproc_sg() { return _coproc; }
+    /// \brief Maintenance work (e.g. compaction) that should yield to
+    /// foreground traffic. Shares are tuned at runtime, see
+    /// background_share_tuner.
+    ss::scheduling_group background_sg() { return _background; }
+    /// \brief Dispatch path (socket reads, header parsing, reply writes) of
+    /// the internal rpc server. Weighted equally with raft so a client storm
+    /// on the kafka listeners cannot starve raft message processing and
+    /// trigger elections.
+    ss::scheduling_group internal_rpc_sg() { return _internal_rpc; }
+    /// \brief Bulk batch (de)compression slices. Runs at half the weight of
+    /// the request handlers so the reactor interleaves small requests
+    /// between slices of a large batch instead of running the whole batch
+    /// inline in the handler's group.
+    ss::scheduling_group compression_sg() { return _compression; }
 
 private:
     ss::scheduling_group _admin;
@@ -54,4 +83,77 @@ private:
     ss::scheduling_group _kafka;
     ss::scheduling_group _cluster;
     ss::scheduling_group _coproc;
+    ss::scheduling_group _background;
+    ss::scheduling_group _internal_rpc;
+    ss::scheduling_group _compression;
+};
+
+/// \brief Adjusts the background group's cpu shares from observed
+/// foreground request latency.
+///
+/// The tuner periodically samples the p99 of the kafka handler histogram
+/// on its shard. While the p99 sits above the ceiling the background
+/// group's shares are stepped down, giving compaction less cpu next to
+/// produce/fetch work; once it falls below the floor shares are stepped
+/// back up so maintenance is not starved on a quiet node. The dead band
+/// between floor and ceiling keeps the shares from oscillating.
+///
+/// Shares are a per-shard reactor property, so one tuner runs on every
+/// shard. The current value is exposed as a gauge; seastar already
+/// exports per-group reactor runtime once the groups exist.
+class background_share_tuner final {
+public:
+    static constexpr std::chrono::seconds adjust_interval{5};
+    /// p99 above this steps background shares down (microseconds)
+    static constexpr int64_t latency_ceiling_us = 50'000;
+    /// p99 below this steps background shares back up (microseconds)
+    static constexpr int64_t latency_floor_us = 20'000;
+    static constexpr float min_shares = 50;
+    static constexpr float max_shares = 400;
+    static constexpr float shares_step = 50;
+
+    void
+    start(ss::scheduling_group sg, const hdr_hist& foreground, float shares) {
+        _sg = sg;
+        _foreground = &foreground;
+        _shares = shares;
+        setup_metrics();
+        _timer.set_callback([this] { adjust(); });
+        _timer.arm_periodic(adjust_interval);
+    }
+
+    ss::future<> stop() {
+        _timer.cancel();
+        _metrics.clear();
+        return ss::now();
+    }
+
+private:
+    void adjust() {
+        auto p99 = _foreground->get_value_at(99.0);
+        if (p99 >= latency_ceiling_us && _shares > min_shares) {
+            _shares = std::max(min_shares, _shares - shares_step);
+            _sg.set_shares(_shares);
+        } else if (p99 <= latency_floor_us && _shares < max_shares) {
+            _shares = std::min(max_shares, _shares + shares_step);
+            _sg.set_shares(_shares);
+        }
+    }
+
+    void setup_metrics() {
+        namespace sm = ss::metrics;
+        _metrics.add_group(
+          prometheus_sanitize::metrics_name("scheduling"),
+          {sm::make_gauge(
+            "background_shares",
+            [this] { return _shares; },
+            sm::description(
+              "Current cpu shares of the background scheduling group"))});
+    }
+
+    ss::scheduling_group _sg;
+    const hdr_hist* _foreground{nullptr};
+    float _shares{0};
+    ss::timer<ss::lowres_clock> _timer;
+    ss::metrics::metric_groups _metrics;
 };
@@ -16,6 +16,9 @@
 #include <seastar/core/distributed.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/reactor.hh>
+#include <seastar/core/sstring.hh>
+
+#include <absl/container/flat_hash_map.h>
 
 class priority_manager {
 public:
@@ -23,6 +26,24 @@ public:
     ss::io_priority_class controller_priority() { return _controller_priority; }
     ss::io_priority_class kafka_read_priority() { return _kafka_read_priority; }
     ss::io_priority_class compaction_priority() { return _compaction_priority; }
+    ss::io_priority_class recovery_priority() { return _recovery_priority; }
+
+    /// io priority class for a topic with explicitly configured io queue
+    /// shares. registered lazily on first use and cached by topic name; io
+    /// priority classes are a limited per-shard resource, so only topics
+    /// that configure shares allocate one - everything else keeps the
+    /// subsystem-wide classes above.
+    ss::io_priority_class
+    topic_priority(const ss::sstring& topic, uint32_t shares) {
+        if (auto it = _topic_priorities.find(topic);
+            it != _topic_priorities.end()) {
+            return it->second;
+        }
+        auto pc = ss::engine().register_one_priority_class(
+          ss::sstring(fmt::format("topic_{}", topic)), shares);
+        _topic_priorities.emplace(topic, pc);
+        return pc;
+    }
 
     static priority_manager& local() {
         static thread_local priority_manager pm = priority_manager();
@@ -37,12 +58,16 @@ private:
       , _kafka_read_priority(
           ss::engine().register_one_priority_class("kafka_read", 200))
       , _compaction_priority(
-          ss::engine().register_one_priority_class("compaction", 200)) {}
+          ss::engine().register_one_priority_class("compaction", 200))
+      , _recovery_priority(
+          ss::engine().register_one_priority_class("recovery", 200)) {}
 
     ss::io_priority_class _raft_priority;
     ss::io_priority_class _controller_priority;
     ss::io_priority_class _kafka_read_priority;
     ss::io_priority_class _compaction_priority;
+    ss::io_priority_class _recovery_priority;
+    absl::flat_hash_map<ss::sstring, ss::io_priority_class> _topic_priorities;
 };
 
 inline ss::io_priority_class raft_priority() {
@@ -60,3 +85,7 @@ inline ss::io_priority_class kafka_read_priority() {
 inline ss::io_priority_class compaction_priority() {
     return priority_manager::local().compaction_priority();
 }
+
+inline ss::io_priority_class recovery_priority() {
+    return priority_manager::local().recovery_priority();
+}
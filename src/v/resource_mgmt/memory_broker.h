@@ -0,0 +1,125 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/sstring.hh>
+#include <seastar/core/timer.hh>
+
+#include <algorithm>
+#include <vector>
+
+/// \brief Shifts memory reservation between subsystem admission semaphores
+/// at runtime.
+///
+/// The static splits in memory_groups are a reasonable default, but skewed
+/// workloads leave one group's admission semaphore saturated while another
+/// sits idle. Each registered group starts at its memory_groups reservation;
+/// periodically the broker moves a slice of budget from the most idle group
+/// to the most pressured one.
+///
+/// Hysteresis comes from the gap between the watermarks: budget only moves
+/// when the recipient is above the pressure watermark (or has waiters) and
+/// the donor is below the idle watermark, so a group hovering between the
+/// two neither gains nor loses. A donor is never cut below half of its
+/// startup reservation, which bounds how far the system can drift from the
+/// provisioned defaults.
+///
+/// Consumers do not need changes: admission paths (e.g. the kafka server's
+/// request reservation) already wait on the group's semaphore, so they see
+/// the live budget as soon as it moves.
+class memory_broker {
+public:
+    static constexpr std::chrono::seconds rebalance_interval{5};
+    /// A group above this fraction of its reservation may receive budget
+    static constexpr double pressure_watermark = 0.80;
+    /// A group below this fraction of its reservation may donate budget
+    static constexpr double idle_watermark = 0.40;
+    /// Fraction of the donor's reservation moved per rebalance
+    static constexpr double shift_step = 0.10;
+    /// A donor's reservation never drops below this fraction of its base
+    static constexpr double min_reservation = 0.50;
+
+    void register_group(ss::sstring name, ss::semaphore& sem, size_t base) {
+        _groups.push_back(group{
+          .name = std::move(name), .sem = &sem, .base = base, .reserved = base});
+    }
+
+    void start() {
+        _timer.set_callback([this] { rebalance(); });
+        _timer.arm_periodic(rebalance_interval);
+    }
+
+    ss::future<> stop() {
+        _timer.cancel();
+        return ss::now();
+    }
+
+private:
+    struct group {
+        ss::sstring name;
+        ss::semaphore* sem;
+        size_t base;
+        size_t reserved;
+
+        size_t in_use() const {
+            // current() is clamped at zero if the count went negative
+            return reserved - std::min(reserved, sem->current());
+        }
+        double usage() const {
+            return reserved == 0 ? 1.0 : double(in_use()) / double(reserved);
+        }
+        bool pressured() const {
+            return sem->waiters() > 0 || usage() >= pressure_watermark;
+        }
+        bool idle() const {
+            return sem->waiters() == 0 && usage() <= idle_watermark;
+        }
+    };
+
+    void rebalance() {
+        if (_groups.size() < 2) {
+            return;
+        }
+        auto to = std::max_element(
+          _groups.begin(), _groups.end(), [](const group& a, const group& b) {
+              return a.usage() < b.usage();
+          });
+        auto from = std::min_element(
+          _groups.begin(), _groups.end(), [](const group& a, const group& b) {
+              return a.usage() < b.usage();
+          });
+        if (to == from || !to->pressured() || !from->idle()) {
+            return;
+        }
+        const auto floor = size_t(double(from->base) * min_reservation);
+        auto step = size_t(double(from->reserved) * shift_step);
+        step = std::min(step, from->reserved - std::min(from->reserved, floor));
+        // only move budget the donor actually has free, so its semaphore
+        // count never goes negative
+        step = std::min(step, from->sem->current());
+        if (step == 0) {
+            return;
+        }
+        from->sem->consume(step);
+        from->reserved -= step;
+        to->sem->signal(step);
+        to->reserved += step;
+    }
+
+    std::vector<group> _groups;
+    ss::timer<ss::lowres_clock> _timer;
+};
@@ -41,12 +41,16 @@ public:
       , _window_size(window_size)
       , _current(0) {}
 
-    // record an observation and return the updated rate in units/second.
-    double record_and_measure(double v, const clock::time_point& now) {
-        // update the current window
+    // record an observation without computing the rate. this is the cheap
+    // half of record_and_measure for hot paths that sample continuously but
+    // are only measured on demand (e.g. the storage per-partition io rates).
+    void record(double v, const clock::time_point& now) {
         maybe_advance_current(now);
         _windows[_current].count += v;
+    }
 
+    // measure the current rate in units/second without recording.
+    double measure(const clock::time_point& now) {
         // process historical samples
         double total = 0.;
         struct window* oldest = nullptr;
@@ -82,6 +86,12 @@ public:
         return total / std::chrono::duration<double>(elapsed).count();
     }
 
+    // record an observation and return the updated rate in units/second.
+    double record_and_measure(double v, const clock::time_point& now) {
+        record(v, now);
+        return measure(now);
+    }
+
     clock::duration window_size() const { return _window_size; }
 
 private:
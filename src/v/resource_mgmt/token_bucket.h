@@ -0,0 +1,179 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "seastarx.h"
+
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/smp.hh>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+
+// token_bucket is a refill-on-demand bucket: tokens accrue at the target
+// rate up to the burst cap, a charge may drive the balance negative, and
+// the deficit translates into the time the bucket needs to replenish it.
+// this matches the semantics of kafka's throttle_time_ms and is the
+// arithmetic kafka::quota_manager has always used, extracted so other
+// subsystems can share it.
+class token_bucket final {
+public:
+    using clock = ss::lowres_clock;
+
+    token_bucket(double rate, double burst)
+      : _rate(rate)
+      , _burst(burst)
+      , _tokens(burst)
+      , _last_refill(clock::now()) {}
+
+    // charge units and return the time the bucket needs to replenish the
+    // resulting deficit; zero when the charge fit the available tokens
+    clock::duration record(double units, clock::time_point now) {
+        refill(now);
+        _tokens -= units;
+        if (_tokens >= 0) {
+            return clock::duration(0);
+        }
+        return std::chrono::duration_cast<clock::duration>(
+          std::chrono::duration<double>(-_tokens / _rate));
+    }
+
+    double rate() const { return _rate; }
+    double burst() const { return _burst; }
+    double deficit() const { return _tokens < 0 ? -_tokens : 0; }
+
+    // accumulated tokens are preserved; the new burst cap applies on the
+    // next refill
+    void set_rate(double rate, double burst) {
+        _rate = rate;
+        _burst = burst;
+    }
+
+private:
+    void refill(clock::time_point now) {
+        auto elapsed = std::chrono::duration<double>(now - _last_refill)
+                         .count();
+        _tokens = std::min(_burst, _tokens + elapsed * _rate);
+        _last_refill = now;
+    }
+
+    double _rate;
+    double _burst;
+    double _tokens;
+    clock::time_point _last_refill;
+};
+
+// chains buckets from leaf towards the root (connection -> client ->
+// tenant -> global); a charge is applied at every level and the reported
+// delay is the largest deficit in the chain, so a child can never sustain
+// more throughput than any of its ancestors allow.
+class hierarchical_token_bucket final {
+public:
+    using clock = token_bucket::clock;
+
+    hierarchical_token_bucket(
+      double rate, double burst, hierarchical_token_bucket* parent = nullptr)
+      : _bucket(rate, burst)
+      , _parent(parent) {}
+
+    clock::duration record(double units, clock::time_point now) {
+        auto delay = _bucket.record(units, now);
+        if (_parent != nullptr) {
+            delay = std::max(delay, _parent->record(units, now));
+        }
+        return delay;
+    }
+
+    token_bucket& bucket() { return _bucket; }
+
+private:
+    token_bucket _bucket;
+    hierarchical_token_bucket* _parent;
+};
+
+// splits one node-wide rate across shards without locks or cross-shard
+// messaging. each shard charges a private sub-bucket sized to its current
+// share of the node rate and publishes its observed demand into a
+// per-shard atomic slot; on every reconciliation period the share is
+// recomputed proportionally to the published demands, so budget unused by
+// idle shards flows to busy ones within a period or two. the aggregate can
+// transiently overshoot the node rate by at most the reconciliation lag,
+// which is the price of keeping the hot path shard-local.
+//
+// Tag separates the static demand tables of unrelated users (e.g. the
+// kafka quota manager vs other services).
+template<typename Tag>
+class sharded_token_bucket final {
+public:
+    using clock = token_bucket::clock;
+
+    static constexpr clock::duration reconcile_period
+      = std::chrono::seconds(1);
+    // floor on a shard's share so a client arriving on a previously idle
+    // shard is not starved until the next reconciliation
+    static constexpr double min_share = 0.05;
+
+    sharded_token_bucket(double node_rate, double node_burst)
+      : _node_rate(node_rate)
+      , _node_burst(node_burst)
+      , _bucket(node_rate / ss::smp::count, node_burst / ss::smp::count)
+      , _last_reconcile(clock::now()) {}
+
+    clock::duration record(double units, clock::time_point now) {
+        _demand += units;
+        maybe_reconcile(now);
+        return _bucket.record(units, now);
+    }
+
+    double shard_rate() const { return _bucket.rate(); }
+
+private:
+    void maybe_reconcile(clock::time_point now) {
+        auto elapsed = now - _last_reconcile;
+        if (elapsed < reconcile_period) {
+            return;
+        }
+        auto& table = demand_table();
+        const auto secs = std::chrono::duration<double>(elapsed).count();
+        table[ss::this_shard_id()].store(
+          _demand / secs, std::memory_order_relaxed);
+        _demand = 0;
+        _last_reconcile = now;
+
+        double total = 0;
+        for (unsigned s = 0; s < ss::smp::count; ++s) {
+            total += table[s].load(std::memory_order_relaxed);
+        }
+        double share = total <= 0
+                         ? 1.0 / ss::smp::count
+                         : table[ss::this_shard_id()].load(
+                             std::memory_order_relaxed)
+                             / total;
+        share = std::max(share, min_share);
+        _bucket.set_rate(_node_rate * share, _node_burst * share);
+    }
+
+    static std::array<std::atomic<double>, ss::smp::max_cpus>&
+    demand_table() {
+        // written only by the owning shard's slot, read by all; atomics
+        // make the unsynchronized access well defined
+        static std::array<std::atomic<double>, ss::smp::max_cpus> table{};
+        return table;
+    }
+
+    const double _node_rate;
+    const double _node_burst;
+    token_bucket _bucket;
+    double _demand{0};
+    clock::time_point _last_reconcile;
+};
@@ -50,6 +50,27 @@ ss::future<> batched_output_stream::write(ss::scattered_message<char> msg) {
           });
       });
 }
+ss::future<>
+batched_output_stream::write_coalesced(ss::scattered_message<char> msg) {
+    if (unlikely(_closed)) {
+        return already_closed_error(msg);
+    }
+    return ss::with_semaphore(
+      *_write_sem, 1, [this, v = std::move(msg)]() mutable {
+          if (unlikely(_closed)) {
+              return already_closed_error(v);
+          }
+          const size_t vbytes = v.size();
+          return _out.write(std::move(v)).then([this, vbytes] {
+              _unflushed_bytes += vbytes;
+              if (_unflushed_bytes >= _cache_size) {
+                  return do_flush();
+              }
+              return ss::make_ready_future<>();
+          });
+      });
+}
+
 ss::future<> batched_output_stream::do_flush() {
     if (_unflushed_bytes == 0) {
         return ss::make_ready_future<>();
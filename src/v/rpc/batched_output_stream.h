@@ -47,6 +47,13 @@ public:
     batched_output_stream& operator=(const batched_output_stream&) = delete;
 
     ss::future<> write(ss::scattered_message<char> msg);
+    /**
+     * Writes without forcing a flush. Used by dispatch loops that know more
+     * frames are already queued behind this one: the frames coalesce in the
+     * socket buffer and a single flush is issued when the queue drains
+     * (or when the unflushed byte budget is exceeded, whichever is first).
+     */
+    ss::future<> write_coalesced(ss::scattered_message<char> msg);
     ss::future<> flush();
 
     /// \brief calls output_stream<char>::close()
@@ -47,4 +47,14 @@ ss::future<> connection::write(ss::scattered_message<char> msg) {
     return _out.write(std::move(msg));
 }
 
+std::optional<tcp_info> connection::diagnostics() {
+    tcp_info info{};
+    try {
+        _fd.get_sockopt(IPPROTO_TCP, TCP_INFO, &info, sizeof(info));
+    } catch (...) {
+        return std::nullopt;
+    }
+    return info;
+}
+
 } // namespace rpc
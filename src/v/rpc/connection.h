@@ -21,6 +21,10 @@
 
 #include <boost/intrusive/list.hpp>
 
+#include <netinet/tcp.h>
+
+#include <optional>
+
 namespace rpc {
 
 class connection : public boost::intrusive::list_base_hook<> {
@@ -41,6 +45,10 @@ public:
     ss::future<> shutdown();
     void shutdown_input();
 
+    /// \brief kernel TCP_INFO snapshot for this connection, nullopt if the
+    /// socket is not a plain tcp socket (e.g. behind tls) or already closed
+    std::optional<tcp_info> diagnostics();
+
     // NOLINTNEXTLINE
     const ss::socket_address addr;
 
@@ -17,6 +17,8 @@
 
 namespace rpc {
 
+thread_local size_t connection_cache::_shard_group_size = 1;
+
 /// \brief needs to be a future, because mutations may come from different
 /// fibers and they need to be synchronized
 ss::future<> connection_cache::emplace(
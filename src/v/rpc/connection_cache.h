@@ -11,6 +11,7 @@
 
 #pragma once
 #include "hashing/jump_consistent_hash.h"
+#include "likely.h"
 #include "model/metadata.h"
 #include "outcome.h"
 #include "outcome_future_utils.h"
@@ -23,6 +24,7 @@
 #include <seastar/core/sharded.hh>
 #include <seastar/core/shared_ptr.hh>
 
+#include <algorithm>
 #include <chrono>
 #include <unordered_map>
 
@@ -40,6 +42,13 @@ public:
       model::node_id node,
       ss::shard_id max_shards = ss::smp::count);
 
+    /// \brief number of neighbouring shards that share one client connection
+    /// per peer node. with the default of 1 every shard owns a dedicated
+    /// connection and requests are dispatched on the caller's core, without
+    /// a cross-core hop. must be set on every shard at startup, before any
+    /// connection is created.
+    static void set_shard_group_size(size_t size) { _shard_group_size = size; }
+
     connection_cache() = default;
     bool contains(model::node_id n) const {
         return _cache.find(n) != _cache.end();
@@ -68,32 +77,45 @@ public:
         ss::shard_id src_shard,
         model::node_id node_id,
         Func&& f) {
-        using ret_t = result_wrap_t<std::invoke_result_t<Func, Protocol>>;
         auto shard = rpc::connection_cache::shard_for(self, src_shard, node_id);
-
+        if (shard == ss::this_shard_id()) {
+            // the caller's shard owns the connection, dispatch directly
+            // and save two cross-core hops per request
+            return with_local_client<Protocol>(
+              node_id, std::forward<Func>(f));
+        }
         return container().invoke_on(
           shard,
           [node_id,
            f = std::forward<Func>(f)](rpc::connection_cache& cache) mutable {
-              if (!cache.contains(node_id)) {
-                  // No client available
-                  return ss::futurize<ret_t>::convert(
-                    rpc::make_error_code(errc::missing_node_rpc_client));
-              }
-              return cache.get(node_id)->get_connected().then(
-                [f = std::forward<Func>(f)](
-                  result<rpc::transport*> transport) mutable {
-                    if (!transport) {
-                        // Connection error
-                        return ss::futurize<ret_t>::convert(transport.error());
-                    }
-                    return ss::futurize<ret_t>::convert(
-                      f(Protocol(*transport.value())));
-                });
+              return cache.with_local_client<Protocol>(
+                node_id, std::forward<Func>(f));
           });
     }
 
 private:
+    template<typename Protocol, typename Func>
+    auto with_local_client(model::node_id node_id, Func&& f) {
+        using ret_t = result_wrap_t<std::invoke_result_t<Func, Protocol>>;
+        if (!contains(node_id)) {
+            // No client available
+            return ss::futurize<ret_t>::convert(
+              rpc::make_error_code(errc::missing_node_rpc_client));
+        }
+        return get(node_id)->get_connected().then(
+          [f = std::forward<Func>(f)](
+            result<rpc::transport*> transport) mutable {
+              if (!transport) {
+                  // Connection error
+                  return ss::futurize<ret_t>::convert(transport.error());
+              }
+              return ss::futurize<ret_t>::convert(
+                f(Protocol(*transport.value())));
+          });
+    }
+
+    static thread_local size_t _shard_group_size;
+
     ss::semaphore _sem{1}; // to add/remove nodes
     underlying _cache;
 };
@@ -102,17 +124,29 @@ inline ss::shard_id connection_cache::shard_for(
   ss::shard_id src_shard,
   model::node_id n,
   ss::shard_id total_shards) {
+    if (likely(_shard_group_size <= 1) || total_shards <= 1) {
+        // dedicated connection per shard, every request is issued from the
+        // core that produced it
+        return src_shard;
+    }
+    // shards within one group share a connection. spread the owner shards
+    // of different peers across the group so one core does not carry the
+    // client traffic for every peer
     static const constexpr size_t vnodes = 3;
     /// make deterministic - choose 1 prime to mix node_id with
     /// https://planetmath.org/goodhashtableprimes
     static const constexpr std::array<size_t, vnodes> universe{
       {402653189, 805306457, 1610612741}};
+    const size_t group_base = (src_shard / _shard_group_size)
+                              * _shard_group_size;
     // NOLINTNEXTLINE
-    size_t h = universe[jump_consistent_hash(src_shard, vnodes)];
+    size_t h = universe[jump_consistent_hash(group_base, vnodes)];
     boost::hash_combine(h, std::hash<model::node_id>{}(n));
     boost::hash_combine(h, std::hash<model::node_id>{}(self));
     // use self node id to shift jump_consistent_hash_assignment
-    return jump_consistent_hash(h, total_shards);
+    const size_t span = std::min<size_t>(
+      _shard_group_size, total_shards - group_base);
+    return group_base + jump_consistent_hash(h, span);
 }
 
 } // namespace rpc
@@ -16,6 +16,9 @@
 #include "rpc/types.h"
 #include "vassert.h"
 
+#include <seastar/core/do_with.hh>
+#include <seastar/core/future-util.hh>
+
 namespace rpc {
 iobuf header_as_iobuf(const header& h) {
     iobuf b;
@@ -26,36 +29,75 @@ iobuf header_as_iobuf(const header& h) {
       "Header size must be known and exact");
     return b;
 }
+/// \brief checksum the payload in bounded slices, yielding to the reactor
+/// between them
+static ss::future<uint64_t> payload_checksum(const iobuf& buf) {
+    return ss::do_with(
+      incremental_xxhash64{},
+      buf.cbegin(),
+      [&buf](incremental_xxhash64& h, iobuf::const_iterator& it) {
+          return ss::do_until(
+                   [&buf, &it] { return it == buf.cend(); },
+                   [&buf, &h, &it] {
+                       size_t n = 0;
+                       while (it != buf.cend()
+                              && n < netbuf::large_payload_threshold) {
+                           h.update(it->get(), it->size());
+                           n += it->size();
+                           ++it;
+                       }
+                       return ss::later();
+                   })
+            .then([&h] { return h.digest(); });
+      });
+}
+
 /// \brief used to send the bytes down the wire
 /// we re-compute the header-checksum on every call
-ss::scattered_message<char> netbuf::as_scattered() && {
+ss::future<ss::scattered_message<char>> netbuf::as_scattered() && {
     if (_hdr.correlation_id == 0 || _hdr.meta == 0) {
-        throw std::runtime_error(
-          "cannot compose scattered view with incomplete header. missing "
-          "correlation_id or remote method id");
+        return ss::make_exception_future<ss::scattered_message<char>>(
+          std::runtime_error(
+            "cannot compose scattered view with incomplete header. missing "
+            "correlation_id or remote method id"));
     }
+    auto hdr = _hdr;
+    auto out = std::move(_out);
+    auto f = ss::make_ready_future<iobuf>(iobuf{});
     if (
-      _out.size_bytes() >= _min_compression_bytes
-      && rpc::compression_type::zstd == _hdr.compression) {
-        compression::stream_zstd fn;
-        _out = fn.compress(std::move(_out));
+      out.size_bytes() >= _min_compression_bytes
+      && rpc::compression_type::zstd == hdr.compression) {
+        if (out.size_bytes() >= large_payload_threshold) {
+            // compress fragment by fragment with reactor yields in
+            // between, keeping poll latency flat during bulk transfers
+            f = ss::do_with(
+              compression::stream_zstd(),
+              [out = std::move(out)](compression::stream_zstd& fn) mutable {
+                  return fn.compress_async(std::move(out));
+              });
+        } else {
+            compression::stream_zstd fn;
+            f = ss::make_ready_future<iobuf>(fn.compress(std::move(out)));
+        }
     } else {
         // didn't meet min requirements
-        _hdr.compression = rpc::compression_type::none;
+        hdr.compression = rpc::compression_type::none;
+        f = ss::make_ready_future<iobuf>(std::move(out));
     }
-    incremental_xxhash64 h;
-    auto in = iobuf::iterator_consumer(_out.cbegin(), _out.cend());
-    in.consume(_out.size_bytes(), [&h](const char* src, size_t sz) {
-        h.update(src, sz);
-        return ss::stop_iteration::no;
-    });
-    _hdr.payload_checksum = h.digest();
-    _hdr.payload_size = _out.size_bytes();
-    _hdr.header_checksum = rpc::checksum_header_only(_hdr);
-    _out.prepend(header_as_iobuf(_hdr));
+    return f.then([hdr](iobuf out) mutable {
+        return ss::do_with(std::move(out), [hdr](iobuf& out) mutable {
+            return payload_checksum(out).then(
+              [hdr, &out](uint64_t digest) mutable {
+                  hdr.payload_checksum = digest;
+                  hdr.payload_size = out.size_bytes();
+                  hdr.header_checksum = rpc::checksum_header_only(hdr);
+                  out.prepend(header_as_iobuf(hdr));
 
-    // prepare for output
-    return iobuf_as_scattered(std::move(_out));
+                  // prepare for output
+                  return iobuf_as_scattered(std::move(out));
+              });
+        });
+    });
 }
 
 } // namespace rpc
@@ -13,22 +13,31 @@
 
 #include "bytes/iobuf.h"
 #include "rpc/types.h"
+#include "units.h"
 #include "vassert.h"
 
+#include <seastar/core/future.hh>
 #include <seastar/core/scattered_message.hh>
 
 namespace rpc {
 class netbuf {
 public:
+    /// payloads at least this large are compressed and checksummed in
+    /// bounded slices with reactor yields in between, so bulk transfers
+    /// (append_entries, fetch) do not stall the scheduler for the whole
+    /// frame
+    static constexpr size_t large_payload_threshold = 128_KiB;
+
     /// \brief used to send the bytes down the wire
     /// we re-compute the header-checksum on every call
-    ss::scattered_message<char> as_scattered() &&;
+    ss::future<ss::scattered_message<char>> as_scattered() &&;
 
     void set_status(rpc::status);
     void set_correlation_id(uint32_t);
     void set_compression(rpc::compression_type c);
     void set_service_method_id(uint32_t);
     void set_min_compression_bytes(size_t);
+    rpc::compression_type compression() const { return _hdr.compression; }
     iobuf& buffer();
 
 private:
@@ -24,8 +24,11 @@
 #include <seastar/core/future.hh>
 #include <seastar/core/iostream.hh>
 
+#include <seastar/core/byteorder.hh>
+
 #include <fmt/format.h>
 
+#include <cstring>
 #include <memory>
 #include <optional>
 
@@ -39,28 +42,55 @@ static inline void check_out_of_range(size_t got, size_t expected) {
           expected));
     }
 }
+
+template<typename T>
+static inline T read_header_field(const char* src) {
+    T t{};
+    std::memcpy(&t, src, sizeof(T));
+    return ss::le_to_cpu(t);
+}
 } // namespace detail
 
+/// \brief decode the fixed size rpc header directly from a flat buffer.
+/// the layout must stay identical to reflection::adl<header>: fields in
+/// declaration order, little endian, no padding - which is exactly what
+/// the size_of_rpc_header static_assert pins down
+inline header header_from_buffer(const char* b) {
+    header h;
+    h.version = detail::read_header_field<uint8_t>(b);
+    h.header_checksum = detail::read_header_field<uint32_t>(b + 1);
+    h.compression = static_cast<compression_type>(
+      detail::read_header_field<uint8_t>(b + 5));
+    h.payload_size = detail::read_header_field<uint32_t>(b + 6);
+    h.meta = detail::read_header_field<uint32_t>(b + 10);
+    h.correlation_id = detail::read_header_field<uint32_t>(b + 14);
+    h.payload_checksum = detail::read_header_field<uint64_t>(b + 18);
+    return h;
+}
+
 inline ss::future<std::optional<header>>
 parse_header(ss::input_stream<char>& in) {
-    return read_iobuf_exactly(in, size_of_rpc_header).then([](iobuf b) {
-        if (b.size_bytes() != size_of_rpc_header) {
-            return ss::make_ready_future<std::optional<header>>();
-        }
-        iobuf_parser parser(std::move(b));
-        auto h = reflection::adl<header>{}.from(parser);
-        if (auto got = checksum_header_only(h);
-            unlikely(h.header_checksum != got)) {
-            vlog(
-              rpclog.info,
-              "rpc header missmatching checksums. expected:{}, got:{} - {}",
-              h.header_checksum,
-              got,
-              h);
-            return ss::make_ready_future<std::optional<header>>();
-        }
-        return ss::make_ready_future<std::optional<header>>(h);
-    });
+    // read_exactly hands out a view of the connection's receive buffer, so
+    // the header read on every inbound frame neither copies data nor
+    // materializes an iobuf and a parser just to decode 26 bytes
+    return in.read_exactly(size_of_rpc_header)
+      .then([](ss::temporary_buffer<char> b) {
+          if (b.size() != size_of_rpc_header) {
+              return ss::make_ready_future<std::optional<header>>();
+          }
+          auto h = header_from_buffer(b.get());
+          if (auto got = checksum_header_only(h);
+              unlikely(h.header_checksum != got)) {
+              vlog(
+                rpclog.info,
+                "rpc header missmatching checksums. expected:{}, got:{} - {}",
+                h.header_checksum,
+                got,
+                h);
+              return ss::make_ready_future<std::optional<header>>();
+          }
+          return ss::make_ready_future<std::optional<header>>(h);
+      });
 }
 
 static inline void
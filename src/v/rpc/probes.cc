@@ -76,6 +76,32 @@ void server_probe::setup_metrics(
           [this] { return _requests_received - _requests_completed; },
           sm::description(fmt::format(
             "{}: Number of requests being processed by server", proto))),
+        sm::make_gauge(
+          "dispatch_queue_delay_us",
+          [this] { return _dispatch_delay_us; },
+          sm::description(fmt::format(
+            "{}: Last observed scheduling delay of the dispatch group",
+            proto))),
+        sm::make_derive(
+          "dispatch_starvation_events",
+          [this] { return _dispatch_starvations; },
+          sm::description(fmt::format(
+            "{}: Number of watchdog probes that found the dispatch group "
+            "starved of cpu",
+            proto))),
+        sm::make_gauge(
+          "tcp_retransmits",
+          [this] { return _tcp_retransmits; },
+          sm::description(fmt::format(
+            "{}: Retransmitted segments summed over open connections",
+            proto))),
+        sm::make_total_bytes(
+          "tcp_min_send_window",
+          [this] { return _tcp_min_send_window; },
+          sm::description(fmt::format(
+            "{}: Effective send window (cwnd * mss) of the slowest open "
+            "connection",
+            proto))),
       });
 }
 
@@ -15,6 +15,7 @@
 #include "rpc/exceptions.h"
 #include "rpc/types.h"
 #include "utils/concepts-enabled.h"
+#include "utils/timeout_wheel.h"
 
 #include <seastar/core/future.hh>
 
@@ -24,7 +25,8 @@ class response_handler {
 public:
     using response_ptr = result<std::unique_ptr<streaming_context>>;
     using promise_t = ss::promise<response_ptr>;
-    using timer_ptr = std::unique_ptr<rpc::timer_type>;
+    using timeout_ptr
+      = std::unique_ptr<timeout_wheel<rpc::clock_type>::entry>;
 
     response_handler() noexcept = default;
     ~response_handler() noexcept = default;
@@ -41,11 +43,15 @@ public:
     // clang-format on
     void with_timeout(
       rpc::clock_type::time_point timeout, Func&& timeout_action) {
-        _timeout_timer = std::make_unique<rpc::timer_type>(
+        // in-flight requests share the shard's timeout wheel instead of
+        // arming one reactor timer each
+        _timeout = std::make_unique<timeout_wheel<rpc::clock_type>::entry>();
+        shard_timeout_wheel<rpc::clock_type>().arm(
+          *_timeout,
+          timeout,
           [this, f = std::forward<Func>(timeout_action)]() mutable {
               complete_with_timeout(std::forward<Func>(f));
           });
-        _timeout_timer->arm(timeout);
     }
 
     ss::future<response_ptr> get_future() { return _promise.get_future(); }
@@ -68,12 +74,12 @@ private:
         timeout_action();
     }
     void maybe_cancel_timer() {
-        if (_timeout_timer && _timeout_timer->armed()) {
-            _timeout_timer->cancel();
+        if (_timeout && _timeout->armed()) {
+            _timeout->cancel();
         }
     }
     promise_t _promise;
-    timer_ptr _timeout_timer;
+    timeout_ptr _timeout;
 };
 } // namespace internal
 } // namespace rpc
@@ -18,12 +18,16 @@
 #include "vlog.h"
 
 #include <seastar/core/future.hh>
+#include <seastar/core/lowres_clock.hh>
 #include <seastar/core/metrics.hh>
 #include <seastar/core/reactor.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/net/api.hh>
 
 #include <fmt/format.h>
 
+#include <sys/socket.h>
+
 namespace rpc {
 
 server::server(server_configuration c)
@@ -64,6 +68,28 @@ void server::start() {
         // background
         (void)with_gate(_conn_gate, [this, &ref] { return accept(ref); });
     }
+    // background
+    (void)with_gate(_conn_gate, [this] { return dispatch_delay_watchdog(); });
+}
+
+static constexpr auto watchdog_interval = std::chrono::seconds(1);
+
+ss::future<> server::dispatch_delay_watchdog() {
+    return ss::do_until(
+      [this] { return _as.abort_requested(); },
+      [this] {
+          return ss::sleep_abortable(watchdog_interval, _as)
+            .then([this] {
+                sample_tcp_diagnostics();
+                auto enqueued = ss::lowres_clock::now();
+                return ss::with_scheduling_group(
+                  cfg.dispatch_sg, [this, enqueued] {
+                      _probe.dispatch_queue_delay(
+                        ss::lowres_clock::now() - enqueued);
+                  });
+            })
+            .handle_exception_type([](const ss::sleep_aborted&) {});
+      });
 }
 
 // inline to get more context
@@ -103,8 +129,28 @@ ss::future<> server::accept(ss::server_socket& s) {
                     ss::stop_iteration::yes);
               }
               auto ar = f_cs_sa.get();
-              ar.connection.set_nodelay(true);
+              ar.connection.set_nodelay(cfg.tcp_nodelay);
               ar.connection.set_keepalive(true);
+              try {
+                  if (cfg.tcp_send_buf) {
+                      // explicit buffer size disables kernel autotuning
+                      int32_t v = *cfg.tcp_send_buf;
+                      ar.connection.set_sockopt(
+                        SOL_SOCKET, SO_SNDBUF, &v, sizeof(v));
+                  }
+                  if (cfg.tcp_recv_buf) {
+                      int32_t v = *cfg.tcp_recv_buf;
+                      ar.connection.set_sockopt(
+                        SOL_SOCKET, SO_RCVBUF, &v, sizeof(v));
+                  }
+              } catch (...) {
+                  // e.g. the tls wrapper does not forward raw sockopts;
+                  // kernel defaults still apply
+                  vlog(
+                    rpclog.debug,
+                    "Could not apply tcp buffer settings: {}",
+                    std::current_exception());
+              }
               auto conn = ss::make_lw_shared<connection>(
                 _connections,
                 std::move(ar.connection),
@@ -119,7 +165,10 @@ ss::future<> server::accept(ss::server_socket& s) {
                   });
               }
               (void)with_gate(_conn_gate, [this, conn]() mutable {
-                  return apply_proto(_proto.get(), resources(this, conn));
+                  return ss::with_scheduling_group(
+                    cfg.dispatch_sg, [this, conn]() mutable {
+                        return apply_proto(_proto.get(), resources(this, conn));
+                    });
               });
               return ss::make_ready_future<ss::stop_iteration>(
                 ss::stop_iteration::no);
@@ -127,6 +176,26 @@ ss::future<> server::accept(ss::server_socket& s) {
     });
 } // namespace rpc
 
+void server::sample_tcp_diagnostics() {
+    uint64_t retransmits = 0;
+    uint64_t min_send_window = 0;
+    bool first = true;
+    for (auto& c : _connections) {
+        auto info = c.diagnostics();
+        if (!info) {
+            continue;
+        }
+        retransmits += info->tcpi_total_retrans;
+        const uint64_t send_window = uint64_t(info->tcpi_snd_cwnd)
+                                     * info->tcpi_snd_mss;
+        if (first || send_window < min_send_window) {
+            min_send_window = send_window;
+            first = false;
+        }
+    }
+    _probe.tcp_sample(retransmits, min_send_window);
+}
+
 ss::future<> server::stop() {
     ss::sstring proto_name = _proto ? _proto->name() : "protocol not set";
     vlog(
@@ -79,10 +79,20 @@ public:
 
     const server_configuration cfg; // NOLINT
     const hdr_hist& histogram() const { return _hist; }
+    /// \brief Admission semaphore, sized by max_service_memory_per_core.
+    /// Exposed so the memory broker can shift budget between servers.
+    ss::semaphore& memory() { return _memory; }
 
 private:
     friend resources;
     ss::future<> accept(ss::server_socket&);
+    /// \brief periodically measures how long a task queued into the dispatch
+    /// scheduling group waits before it runs. a starved dispatch group shows
+    /// up here long before requests start timing out.
+    ss::future<> dispatch_delay_watchdog();
+    /// \brief aggregates TCP_INFO counters over open connections so buffer
+    /// and nodelay tuning can be verified per listener instead of per host
+    void sample_tcp_diagnostics();
     void setup_metrics();
 
     std::unique_ptr<protocol> _proto;
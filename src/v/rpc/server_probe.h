@@ -15,6 +15,7 @@
 
 #include <seastar/core/metrics_registration.hh>
 
+#include <chrono>
 #include <iostream>
 
 namespace rpc {
@@ -28,6 +29,8 @@ public:
 
     void connection_closed() { --_connections; }
 
+    uint32_t connections() const { return _connections; }
+
     void connection_close_error() { ++_connection_close_error; }
 
     void add_bytes_sent(size_t sent) { _out_bytes += sent; }
@@ -46,10 +49,30 @@ public:
 
     void waiting_for_available_memory() { ++_requests_blocked_memory; }
 
+    /// delay above which the dispatch group counts as starved of cpu
+    static constexpr std::chrono::milliseconds starvation_threshold{30};
+
+    void dispatch_queue_delay(std::chrono::steady_clock::duration d) {
+        _dispatch_delay_us
+          = std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+        if (d >= starvation_threshold) {
+            ++_dispatch_starvations;
+        }
+    }
+
+    void tcp_sample(uint64_t retransmits, uint64_t min_send_window) {
+        _tcp_retransmits = retransmits;
+        _tcp_min_send_window = min_send_window;
+    }
+
     void setup_metrics(ss::metrics::metric_groups& mgs, const char* name);
 
 private:
     uint64_t _requests_completed = 0;
+    uint64_t _dispatch_delay_us = 0;
+    uint64_t _dispatch_starvations = 0;
+    uint64_t _tcp_retransmits = 0;
+    uint64_t _tcp_min_send_window = 0;
     uint64_t _in_bytes = 0;
     uint64_t _out_bytes = 0;
     uint64_t _connects = 0;
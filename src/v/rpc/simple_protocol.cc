@@ -62,17 +62,21 @@ send_reply(ss::lw_shared_ptr<server_context_impl> ctx, netbuf buf) {
     buf.set_compression(rpc::compression_type::zstd);
     buf.set_correlation_id(ctx->get_header().correlation_id);
 
-    auto view = std::move(buf).as_scattered();
-    if (ctx->res.conn_gate().is_closed()) {
-        // do not write if gate is closed
-        rpclog.debug(
-          "Skipping write of {} bytes, connection is closed", view.size());
-        return ss::make_ready_future<>();
-    }
-    return ctx->res.conn->write(std::move(view))
-      .handle_exception([ctx](std::exception_ptr e) {
-          vlog(rpclog.info, "Error dispatching method: {}", e);
-          ctx->res.conn->shutdown_input();
+    return std::move(buf)
+      .as_scattered()
+      .then([ctx](ss::scattered_message<char> view) {
+          if (ctx->res.conn_gate().is_closed()) {
+              // do not write if gate is closed
+              rpclog.debug(
+                "Skipping write of {} bytes, connection is closed",
+                view.size());
+              return ss::make_ready_future<>();
+          }
+          return ctx->res.conn->write(std::move(view))
+            .handle_exception([ctx](std::exception_ptr e) {
+                vlog(rpclog.info, "Error dispatching method: {}", e);
+                ctx->res.conn->shutdown_input();
+            });
       })
       .finally([ctx] { ctx->res.probe().request_completed(); });
 }
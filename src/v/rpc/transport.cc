@@ -19,6 +19,7 @@
 
 #include <seastar/core/reactor.hh>
 
+#include <cerrno>
 #include <memory>
 #include <type_traits>
 
@@ -44,7 +45,26 @@ struct client_context_impl final : streaming_context {
 base_transport::base_transport(configuration c)
   : _server_addr(c.server_addr)
   , _creds(c.credentials)
-  , _tls_sni_hostname(c.tls_sni_hostname) {}
+  , _tls_sni_hostname(c.tls_sni_hostname)
+  , _steer_to_shard(c.steer_to_shard) {}
+
+/**
+ * Source port with the residue a port based load balancer on the remote
+ * end maps to the target shard. Candidates walk the IANA ephemeral range
+ * in steps of our core count (homogeneous core counts across the cluster
+ * keep the residue meaningful on the remote end), starting at a
+ * per-shard position so concurrent transports rarely collide.
+ */
+static uint16_t steered_source_port(uint32_t shard, uint32_t attempt) {
+    constexpr uint32_t lo = 32768;
+    constexpr uint32_t hi = 60999;
+    const uint32_t step = ss::smp::count;
+    const uint32_t slots = (hi - lo) / step;
+    static thread_local uint32_t counter = ss::this_shard_id() * 101;
+    const uint32_t slot = (counter++ + attempt) % slots;
+    const uint32_t residue = (shard % step + step - lo % step) % step;
+    return uint16_t(lo + slot * step + residue);
+}
 
 transport::transport(
   transport_configuration c,
@@ -52,13 +72,45 @@ transport::transport(
   : base_transport(base_transport::configuration{
     .server_addr = std::move(c.server_addr),
     .credentials = std::move(c.credentials),
+    .steer_to_shard = c.steer_to_shard,
   })
-  , _memory(c.max_queued_bytes) {
+  , _memory(c.max_queued_bytes)
+  , _default_compression(c.default_compression)
+  , _min_compression_bytes(c.min_compression_bytes) {
     if (!c.disable_metrics) {
         setup_metrics(service_name);
     }
 }
 
+ss::future<ss::connected_socket>
+base_transport::connect_socket(uint32_t attempt) {
+    constexpr uint32_t max_steered_attempts = 4;
+    const bool steer = _steer_to_shard.has_value()
+                       && attempt < max_steered_attempts;
+    auto local = ss::socket_address(sockaddr_in{AF_INET, INADDR_ANY, {0}});
+    if (steer) {
+        local = ss::socket_address(sockaddr_in{
+          AF_INET,
+          htons(steered_source_port(*_steer_to_shard, attempt)),
+          {INADDR_ANY}});
+    }
+    auto f = ss::engine().net().connect(
+      server_address(), local, ss::transport::TCP);
+    if (!steer) {
+        return f;
+    }
+    return f.handle_exception_type(
+      [this, attempt](const std::system_error& e) {
+          // the candidate port raced with another socket: step to the
+          // next one, eventually letting the kernel pick
+          if (e.code().value() != EADDRINUSE) {
+              return ss::make_exception_future<ss::connected_socket>(
+                std::make_exception_ptr(e));
+          }
+          return connect_socket(attempt + 1);
+      });
+}
+
 ss::future<> base_transport::do_connect() {
     // hold invariant of having an always valid dispatch gate
     // and make sure we don't have a live connection already
@@ -67,12 +119,7 @@ ss::future<> base_transport::do_connect() {
           "cannot do_connect with a valid connection. remote:{}",
           server_address())));
     }
-    return ss::engine()
-      .net()
-      .connect(
-        server_address(),
-        ss::socket_address(sockaddr_in{AF_INET, INADDR_ANY, {0}}),
-        ss::transport::TCP)
+    return connect_socket(0)
       .then([this](ss::connected_socket fd) mutable {
           if (_creds) {
               return ss::tls::wrap_client(
@@ -120,6 +167,7 @@ void transport::fail_outstanding_futures() noexcept {
     _last_seq = sequence_t{0};
     _seq = sequence_t{0};
     _requests_queue.clear();
+    _urgent_queue.clear();
     _correlations.clear();
 }
 void base_transport::shutdown() noexcept {
@@ -159,6 +207,9 @@ ss::future<> transport::connect() {
 
 ss::future<result<std::unique_ptr<streaming_context>>>
 transport::send(netbuf b, rpc::client_opts opts) {
+    if (opts.priority == stream_priority::urgent) {
+        return do_send_urgent(std::move(b), std::move(opts));
+    }
     return do_send(_seq++, std::move(b), std::move(opts));
 }
 
@@ -227,24 +278,88 @@ transport::do_send(sequence_t seq, netbuf b, rpc::client_opts opts) {
       });
 }
 
+ss::future<result<std::unique_ptr<streaming_context>>>
+transport::do_send_urgent(netbuf b, rpc::client_opts opts) {
+    using ret_t = result<std::unique_ptr<streaming_context>>;
+    if (!is_valid() || _dispatch_gate.is_closed()) {
+        return ss::make_ready_future<ret_t>(errc::disconnected_endpoint);
+    }
+    return ss::with_gate(
+      _dispatch_gate, [this, b = std::move(b), opts = std::move(opts)]() mutable {
+          auto f = make_response_handler(b, opts);
+          auto sz = b.buffer().size_bytes();
+          return get_units(_memory, sz)
+            .then([this, b = std::move(b), f = std::move(f)](
+                    ss::semaphore_units<> units) mutable {
+                // urgent requests skip the sequenced queue, responses are
+                // still matched by correlation id so ordering relative to
+                // bulk requests does not matter
+                _urgent_queue.push_back(
+                  std::make_unique<netbuf>(std::move(b)));
+                dispatch_send();
+                return std::move(f).finally([u = std::move(units)] {});
+            });
+      });
+}
+
 void transport::dispatch_send() {
     (void)ss::with_gate(_dispatch_gate, [this]() mutable {
         return ss::do_until(
           [this] {
-              return _requests_queue.empty()
-                     || _requests_queue.begin()->first
-                          > (_last_seq + sequence_t(1));
+              return _urgent_queue.empty()
+                     && (_requests_queue.empty()
+                         || _requests_queue.begin()->first
+                              > (_last_seq + sequence_t(1)));
           },
           [this] {
-              auto it = _requests_queue.begin();
-              _last_seq = it->first;
-              auto buffer = std::move(it->second).get();
-              auto v = std::move(*buffer).as_scattered();
-              auto msg_size = v.size();
-              _requests_queue.erase(it->first);
-              return _out.write(std::move(v)).finally([this, msg_size] {
-                  _probe.add_bytes_sent(msg_size);
-              });
+              std::unique_ptr<netbuf> buffer;
+              // the urgent class preempts queued bulk requests at every
+              // message boundary
+              if (!_urgent_queue.empty()) {
+                  buffer = std::move(_urgent_queue.front());
+                  _urgent_queue.pop_front();
+              } else {
+                  auto it = _requests_queue.begin();
+                  _last_seq = it->first;
+                  buffer = std::move(it->second);
+                  _requests_queue.erase(it->first);
+              }
+              const auto pre_size = buffer->buffer().size_bytes();
+              const bool compressed = buffer->compression()
+                                      != compression_type::none;
+              /*
+               * nagle-like frame coalescing: while more frames are already
+               * queued behind this one they accumulate in the socket buffer
+               * and a single flush is issued when the queue drains. an idle
+               * connection still flushes every frame immediately, so only
+               * bursts of small frames (heartbeats, votes) pay the bounded
+               * extra latency and collapse into one syscall
+               */
+              const bool last_pending
+                = _urgent_queue.empty()
+                  && (_requests_queue.empty()
+                      || _requests_queue.begin()->first
+                           > (_last_seq + sequence_t(1)));
+              return std::move(*buffer).as_scattered().then(
+                [this, pre_size, compressed, last_pending](
+                  ss::scattered_message<char> v) {
+                    auto msg_size = v.size();
+                    if (compressed && pre_size >= _min_compression_bytes) {
+                        // feed the transparent compression heuristic with
+                        // the ratio this frame achieved
+                        const auto post = msg_size - size_of_rpc_header;
+                        const double sample = static_cast<double>(post)
+                                              / static_cast<double>(pre_size);
+                        _compression_ratio = (0.8 * _compression_ratio)
+                                             + (0.2 * sample);
+                    }
+                    auto write_f = last_pending
+                                     ? _out.write(std::move(v))
+                                     : _out.write_coalesced(std::move(v));
+                    return write_f.finally([this, msg_size] {
+                        _probe.add_bytes_sent(msg_size);
+                    });
+                });
           });
     }).handle_exception([this](std::exception_ptr e) {
         vlog(rpclog.info, "Error dispatching socket write:{}", e);
@@ -23,6 +23,7 @@
 #include "seastarx.h"
 #include "utils/named_type.h"
 
+#include <seastar/core/circular_buffer.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/iostream.hh>
 #include <seastar/core/metrics_registration.hh>
@@ -50,6 +51,10 @@ public:
         rpc::metrics_disabled disable_metrics = rpc::metrics_disabled::no;
         /// Optional server name indication (SNI) for TLS connection
         std::optional<ss::sstring> tls_sni_hostname;
+        /// When set, the local source port is chosen so that a server
+        /// listening with seastar's port based load balancer places the
+        /// connection on this shard (modulo the server's core count).
+        std::optional<uint32_t> steer_to_shard;
     };
 
     explicit base_transport(configuration c);
@@ -77,11 +82,15 @@ protected:
 
 private:
     ss::future<> do_connect();
+    // opens the socket, stepping through steered source port candidates
+    // when shard steering is enabled
+    ss::future<ss::connected_socket> connect_socket(uint32_t attempt);
 
     std::unique_ptr<ss::connected_socket> _fd;
     ss::socket_address _server_addr;
     ss::shared_ptr<ss::tls::certificate_credentials> _creds;
     std::optional<ss::sstring> _tls_sni_hostname;
+    std::optional<uint32_t> _steer_to_shard;
 };
 
 class transport final : public base_transport {
@@ -116,12 +125,30 @@ private:
 
     ss::future<result<std::unique_ptr<streaming_context>>>
       do_send(sequence_t, netbuf, rpc::client_opts);
+    ss::future<result<std::unique_ptr<streaming_context>>>
+      do_send_urgent(netbuf, rpc::client_opts);
     void dispatch_send();
 
     ss::future<result<std::unique_ptr<streaming_context>>>
     make_response_handler(netbuf&, const rpc::client_opts&);
 
+    /// \brief transparent compression is only worth the cpu while recent
+    /// frames actually shrank. the ratio is an ewma of compressed to
+    /// uncompressed payload size, sampled in dispatch_send. when payloads
+    /// stop compressing we back off, still probing every 64th frame so the
+    /// ratio can recover when the workload changes
+    bool use_transparent_compression() {
+        if (_compression_ratio < 0.9) {
+            return true;
+        }
+        return (++_compression_probe % 64) == 0;
+    }
+
     ss::semaphore _memory;
+    compression_type _default_compression;
+    size_t _min_compression_bytes;
+    double _compression_ratio{0.5};
+    uint32_t _compression_probe{0};
     absl::flat_hash_map<uint32_t, std::unique_ptr<internal::response_handler>>
       _correlations;
     uint32_t _correlation_idx{0};
@@ -132,6 +159,12 @@ private:
      * ususally contains only few elements.
      */
     requests_queue_t _requests_queue;
+    /**
+     * urgent requests (heartbeats, votes) bypass the sequenced queue and
+     * are drained first at every message boundary, so a chunked bulk
+     * transfer can not head-of-line-block them. FIFO within the class.
+     */
+    ss::circular_buffer<std::unique_ptr<netbuf>> _urgent_queue;
     sequence_t _seq;
     sequence_t _last_seq;
     friend std::ostream& operator<<(std::ostream&, const transport&);
@@ -174,6 +207,16 @@ transport::send_typed(Input r, uint32_t method_id, rpc::client_opts opts) {
     auto b = std::make_unique<rpc::netbuf>();
     b->set_compression(opts.compression);
     b->set_min_compression_bytes(opts.min_compression_bytes);
+    if (
+      opts.compression == compression_type::none
+      && opts.priority == stream_priority::bulk
+      && _default_compression != compression_type::none
+      && use_transparent_compression()) {
+        // transparent frame compression for bulk traffic, call sites that
+        // requested a compression type explicitly are left alone
+        b->set_compression(_default_compression);
+        b->set_min_compression_bytes(_min_compression_bytes);
+    }
     auto raw_b = b.get();
     raw_b->set_service_method_id(method_id);
 
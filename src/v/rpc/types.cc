@@ -54,7 +54,8 @@ std::ostream& operator<<(std::ostream& o, const server_configuration& c) {
     }
     o << ", max_service_memory_per_core: " << c.max_service_memory_per_core
       << ", has_tls_credentials: " << (c.credentials ? "yes" : "no")
-      << ", metrics_enabled:" << !c.disable_metrics;
+      << ", metrics_enabled:" << !c.disable_metrics
+      << ", dispatch_sg: " << c.dispatch_sg.name();
     return o << "}";
 }
 
@@ -98,6 +98,16 @@ static_assert(
 
 uint32_t checksum_header_only(const header& h);
 
+/**
+ * Priority class of a request on the shared connection. Urgent requests
+ * (heartbeats, votes) jump ahead of queued bulk transfers at message
+ * granularity so recovery storms do not head-of-line-block them.
+ */
+enum class stream_priority : uint8_t {
+    bulk = 0,
+    urgent,
+};
+
 struct client_opts {
     client_opts(
       clock_type::time_point client_send_timeout,
@@ -120,6 +130,7 @@ struct client_opts {
     clock_type::time_point timeout;
     compression_type compression;
     size_t min_compression_bytes;
+    stream_priority priority = stream_priority::bulk;
 };
 
 /// \brief used to pass environment context to the class
@@ -186,6 +197,20 @@ struct server_configuration {
     // we use the same default as seastar for load balancing algorithm
     ss::server_socket::load_balancing_algorithm load_balancing_algo
       = ss::server_socket::load_balancing_algorithm::connection_distribution;
+    /// \brief scheduling group for the dispatch path - socket reads, header
+    /// parsing and reply writes. service handlers already run in their own
+    /// groups, but without this the dispatch work of every server on a shard
+    /// competes in the default group, so a client storm on one listener can
+    /// starve another's dispatch loop.
+    ss::scheduling_group dispatch_sg = ss::default_scheduling_group();
+    /// \brief per-listener tcp tuning, applied to every accepted connection.
+    /// explicit buffer sizes pin the socket buffers and disable kernel
+    /// autotuning; nodelay trades small-packet batching for latency. when
+    /// unset the kernel defaults apply, which is the sysctl-tuned behavior
+    /// this replaces.
+    std::optional<size_t> tcp_send_buf;
+    std::optional<size_t> tcp_recv_buf;
+    bool tcp_nodelay = true;
 
     explicit server_configuration(ss::sstring n)
       : name(std::move(n)) {}
@@ -200,6 +225,18 @@ struct transport_configuration {
     uint32_t max_queued_bytes = std::numeric_limits<uint32_t>::max();
     ss::shared_ptr<ss::tls::certificate_credentials> credentials;
     metrics_disabled disable_metrics = metrics_disabled::no;
+    /// \brief compression applied transparently to bulk-class requests
+    /// larger than min_compression_bytes. urgent requests (heartbeats,
+    /// votes) are never compressed, they are latency bound not
+    /// bandwidth bound
+    compression_type default_compression = compression_type::none;
+    size_t min_compression_bytes = 1024;
+    /// \brief steer the connection to this shard on a server using port
+    /// based load balancing, by picking the matching local source port.
+    /// with homogeneous core counts across the cluster the connection
+    /// from shard i lands on remote shard i, so request processing stays
+    /// on the core (and numa node) that owns the partition data.
+    std::optional<uint32_t> steer_to_shard;
 };
 
 std::ostream& operator<<(std::ostream&, const header&);
@@ -0,0 +1,496 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "s3/client.h"
+
+#include "bytes/iobuf_parser.h"
+#include "s3/error.h"
+#include "s3/logger.h"
+#include "vlog.h"
+
+#include <seastar/core/do_with.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/loop.hh>
+
+#include <boost/range/irange.hpp>
+#include <fmt/format.h>
+
+namespace s3 {
+
+// sha256 of an empty payload, required by the V4 signature for bodyless
+// requests
+static constexpr std::string_view empty_payload_sha256
+  = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+
+// payloads that are streamed are not included in the signature
+static constexpr std::string_view unsigned_payload = "UNSIGNED-PAYLOAD";
+
+request_creator::request_creator(const configuration& conf)
+  : _ap(conf.uri)
+  , _sign(conf.region, conf.access_key, conf.secret_key) {}
+
+result<http::client::request_header> request_creator::make_get_object_request(
+  const bucket_name& name, const object_key& key) {
+    http::client::request_header header{};
+    // GET /{object-id} HTTP/1.1
+    // Host: {bucket-name}.s3.amazonaws.com
+    auto host = fmt::format("{}.{}", name(), _ap());
+    auto target = fmt::format("/{}", key());
+    header.method(http::client::verb::get);
+    header.target(target);
+    header.insert(http::client::field::host, host);
+    header.insert(http::client::field::content_length, "0");
+    auto ec = _sign.sign_header(header, ss::sstring(empty_payload_sha256));
+    if (ec) {
+        return ec;
+    }
+    return header;
+}
+
+result<http::client::request_header>
+request_creator::make_unsigned_put_object_request(
+  const bucket_name& name, const object_key& key, size_t payload_size_bytes) {
+    http::client::request_header header{};
+    // PUT /{object-id} HTTP/1.1
+    // Host: {bucket-name}.s3.amazonaws.com
+    // Content-Length: {payload-size}
+    auto host = fmt::format("{}.{}", name(), _ap());
+    auto target = fmt::format("/{}", key());
+    header.method(http::client::verb::put);
+    header.target(target);
+    header.insert(http::client::field::host, host);
+    header.insert(
+      http::client::field::content_length,
+      std::to_string(payload_size_bytes));
+    auto ec = _sign.sign_header(header, ss::sstring(unsigned_payload));
+    if (ec) {
+        return ec;
+    }
+    return header;
+}
+
+result<http::client::request_header>
+request_creator::make_create_multipart_upload_request(
+  const bucket_name& name, const object_key& key) {
+    http::client::request_header header{};
+    // POST /{object-id}?uploads HTTP/1.1
+    // Host: {bucket-name}.s3.amazonaws.com
+    auto host = fmt::format("{}.{}", name(), _ap());
+    auto target = fmt::format("/{}?uploads", key());
+    header.method(http::client::verb::post);
+    header.target(target);
+    header.insert(http::client::field::host, host);
+    header.insert(http::client::field::content_length, "0");
+    auto ec = _sign.sign_header(header, ss::sstring(empty_payload_sha256));
+    if (ec) {
+        return ec;
+    }
+    return header;
+}
+
+result<http::client::request_header>
+request_creator::make_unsigned_upload_part_request(
+  const bucket_name& name,
+  const object_key& key,
+  const upload_id& id,
+  unsigned int part_number,
+  size_t payload_size_bytes) {
+    http::client::request_header header{};
+    // PUT /{object-id}?partNumber={part-number}&uploadId={upload-id} HTTP/1.1
+    // Host: {bucket-name}.s3.amazonaws.com
+    // Content-Length: {payload-size}
+    auto host = fmt::format("{}.{}", name(), _ap());
+    auto target = fmt::format(
+      "/{}?partNumber={}&uploadId={}", key(), part_number, id());
+    header.method(http::client::verb::put);
+    header.target(target);
+    header.insert(http::client::field::host, host);
+    header.insert(
+      http::client::field::content_length,
+      std::to_string(payload_size_bytes));
+    auto ec = _sign.sign_header(header, ss::sstring(unsigned_payload));
+    if (ec) {
+        return ec;
+    }
+    return header;
+}
+
+result<http::client::request_header>
+request_creator::make_unsigned_complete_multipart_upload_request(
+  const bucket_name& name,
+  const object_key& key,
+  const upload_id& id,
+  size_t payload_size_bytes) {
+    http::client::request_header header{};
+    // POST /{object-id}?uploadId={upload-id} HTTP/1.1
+    // Host: {bucket-name}.s3.amazonaws.com
+    // Content-Length: {payload-size}
+    auto host = fmt::format("{}.{}", name(), _ap());
+    auto target = fmt::format("/{}?uploadId={}", key(), id());
+    header.method(http::client::verb::post);
+    header.target(target);
+    header.insert(http::client::field::host, host);
+    header.insert(
+      http::client::field::content_length,
+      std::to_string(payload_size_bytes));
+    auto ec = _sign.sign_header(header, ss::sstring(unsigned_payload));
+    if (ec) {
+        return ec;
+    }
+    return header;
+}
+
+result<http::client::request_header>
+request_creator::make_abort_multipart_upload_request(
+  const bucket_name& name, const object_key& key, const upload_id& id) {
+    http::client::request_header header{};
+    // DELETE /{object-id}?uploadId={upload-id} HTTP/1.1
+    // Host: {bucket-name}.s3.amazonaws.com
+    auto host = fmt::format("{}.{}", name(), _ap());
+    auto target = fmt::format("/{}?uploadId={}", key(), id());
+    header.method(http::client::verb::delete_);
+    header.target(target);
+    header.insert(http::client::field::host, host);
+    header.insert(http::client::field::content_length, "0");
+    auto ec = _sign.sign_header(header, ss::sstring(empty_payload_sha256));
+    if (ec) {
+        return ec;
+    }
+    return header;
+}
+
+client::client(const configuration& conf)
+  : _requestor(conf)
+  , _client(conf) {}
+
+ss::future<> client::shutdown() { return _client.shutdown(); }
+
+ss::future<http::client::response_stream_ref>
+client::get_object(const bucket_name& name, const object_key& key) {
+    auto header = _requestor.make_get_object_request(name, key);
+    if (!header) {
+        return ss::make_exception_future<http::client::response_stream_ref>(
+          std::system_error(header.error()));
+    }
+    vlog(s3_log.trace, "send https request:\n{}", header.value());
+    return _client.request(std::move(header.value()));
+}
+
+ss::future<> client::put_object(
+  const bucket_name& name,
+  const object_key& key,
+  size_t payload_size,
+  ss::input_stream<char>&& body) {
+    auto header = _requestor.make_unsigned_put_object_request(
+      name, key, payload_size);
+    if (!header) {
+        return ss::make_exception_future<>(std::system_error(header.error()));
+    }
+    vlog(s3_log.trace, "send https request:\n{}", header.value());
+    return ss::do_with(
+      std::move(body), [this, header = std::move(header.value())](
+                         ss::input_stream<char>& body) mutable {
+          return _client.request(std::move(header), body)
+            .then([](const http::client::response_stream_ref& response) {
+                // drain the response; S3 returns an empty body on success
+                // and an xml error document otherwise
+                return ss::do_with(
+                  response, [](http::client::response_stream_ref& response) {
+                      return ss::do_until(
+                        [&response] { return response->is_done(); },
+                        [&response] {
+                            return response->recv_some().discard_result();
+                        });
+                  });
+            })
+            .finally([&body] { return body.close(); });
+      });
+}
+
+/// Receive the whole response payload and verify the status. S3 replies
+/// on the control path are small xml documents so buffering them is fine.
+static ss::future<iobuf>
+drain_response(http::client::response_stream_ref resp) {
+    return ss::do_with(
+      std::move(resp),
+      iobuf(),
+      [](http::client::response_stream_ref& resp, iobuf& body) {
+          return ss::do_until(
+                   [&resp] { return resp->is_done(); },
+                   [&resp, &body] {
+                       return resp->recv_some().then(
+                         [&body](iobuf buf) { body.append(std::move(buf)); });
+                   })
+            .then([&resp, &body] {
+                auto status = resp->get_headers().result();
+                if (
+                  boost::beast::http::to_status_class(status)
+                  != boost::beast::http::status_class::successful) {
+                    vlog(
+                      s3_log.error,
+                      "s3 request failed with status {}",
+                      resp->get_headers().result_int());
+                    return ss::make_exception_future<iobuf>(std::system_error(
+                      make_error_code(s3_error_codes::failed_request)));
+                }
+                return ss::make_ready_future<iobuf>(std::move(body));
+            });
+      });
+}
+
+static ss::sstring iobuf_to_string(iobuf buf) {
+    iobuf_parser parser(std::move(buf));
+    return parser.read_string(parser.bytes_left());
+}
+
+/// Minimal extraction of one tag value from a flat S3 xml document. The
+/// documents involved are tiny and the tags of interest occur once, so a
+/// full xml parser is not needed.
+static result<ss::sstring>
+extract_xml_tag(const ss::sstring& doc, std::string_view tag) {
+    auto open = fmt::format("<{}>", tag);
+    auto close = fmt::format("</{}>", tag);
+    auto begin = doc.find(open.data());
+    if (begin == ss::sstring::npos) {
+        return make_error_code(s3_error_codes::invalid_response);
+    }
+    begin += open.size();
+    auto end = doc.find(close.data(), begin);
+    if (end == ss::sstring::npos) {
+        return make_error_code(s3_error_codes::invalid_response);
+    }
+    return doc.substr(begin, end - begin);
+}
+
+ss::future<upload_id> client::create_multipart_upload(
+  const bucket_name& name, const object_key& key) {
+    auto header = _requestor.make_create_multipart_upload_request(name, key);
+    if (!header) {
+        return ss::make_exception_future<upload_id>(
+          std::system_error(header.error()));
+    }
+    vlog(s3_log.trace, "send https request:\n{}", header.value());
+    return _client.request(std::move(header.value()))
+      .then([](http::client::response_stream_ref response) {
+          return drain_response(std::move(response));
+      })
+      .then([](iobuf body) {
+          auto id = extract_xml_tag(
+            iobuf_to_string(std::move(body)), "UploadId");
+          if (!id) {
+              return ss::make_exception_future<upload_id>(
+                std::system_error(id.error()));
+          }
+          return ss::make_ready_future<upload_id>(
+            upload_id(std::move(id.value())));
+      });
+}
+
+ss::future<ss::sstring> client::upload_part(
+  const bucket_name& name,
+  const object_key& key,
+  const upload_id& id,
+  unsigned int part_number,
+  size_t payload_size,
+  ss::input_stream<char>&& body) {
+    auto header = _requestor.make_unsigned_upload_part_request(
+      name, key, id, part_number, payload_size);
+    if (!header) {
+        return ss::make_exception_future<ss::sstring>(
+          std::system_error(header.error()));
+    }
+    vlog(s3_log.trace, "send https request:\n{}", header.value());
+    return ss::do_with(
+      std::move(body), [this, header = std::move(header.value())](
+                         ss::input_stream<char>& body) mutable {
+          return _client.request(std::move(header), body)
+            .then([](http::client::response_stream_ref response) {
+                // the etag of the part arrives in the response headers and
+                // has to be echoed back on complete
+                auto resp = response;
+                return drain_response(std::move(response))
+                  .then([resp = std::move(resp)](iobuf) {
+                      auto etag = resp->get_headers()["ETag"];
+                      return ss::sstring(etag.data(), etag.size());
+                  });
+            })
+            .finally([&body] { return body.close(); });
+      });
+}
+
+ss::future<> client::complete_multipart_upload(
+  const bucket_name& name,
+  const object_key& key,
+  const upload_id& id,
+  const std::vector<ss::sstring>& etags) {
+    ss::sstring payload = "<CompleteMultipartUpload>";
+    for (size_t i = 0; i < etags.size(); i++) {
+        payload += fmt::format(
+          "<Part><PartNumber>{}</PartNumber><ETag>{}</ETag></Part>",
+          i + 1,
+          etags[i]);
+    }
+    payload += "</CompleteMultipartUpload>";
+    auto header = _requestor.make_unsigned_complete_multipart_upload_request(
+      name, key, id, payload.size());
+    if (!header) {
+        return ss::make_exception_future<>(std::system_error(header.error()));
+    }
+    vlog(s3_log.trace, "send https request:\n{}", header.value());
+    iobuf body;
+    body.append(payload.data(), payload.size());
+    return ss::do_with(
+      make_iobuf_input_stream(std::move(body)),
+      [this, header = std::move(header.value())](
+        ss::input_stream<char>& body) mutable {
+          return _client.request(std::move(header), body)
+            .then([](http::client::response_stream_ref response) {
+                return drain_response(std::move(response)).discard_result();
+            })
+            .finally([&body] { return body.close(); });
+      });
+}
+
+ss::future<> client::abort_multipart_upload(
+  const bucket_name& name, const object_key& key, const upload_id& id) {
+    auto header = _requestor.make_abort_multipart_upload_request(
+      name, key, id);
+    if (!header) {
+        return ss::make_exception_future<>(std::system_error(header.error()));
+    }
+    vlog(s3_log.trace, "send https request:\n{}", header.value());
+    return _client.request(std::move(header.value()))
+      .then([](http::client::response_stream_ref response) {
+          return drain_response(std::move(response)).discard_result();
+      });
+}
+
+// client_pool //
+
+client_pool::client_pool(size_t size, configuration conf)
+  : _config(std::move(conf))
+  , _sem(size) {
+    _all.reserve(size);
+    _idle.reserve(size);
+    for (size_t i = 0; i < size; i++) {
+        auto cl = ss::make_shared<client>(_config);
+        _all.push_back(cl);
+        _idle.push_back(std::move(cl));
+    }
+}
+
+ss::future<> client_pool::stop() {
+    return ss::parallel_for_each(
+      _all, [](client_ptr& cl) { return cl->shutdown(); });
+}
+
+ss::future<client_pool::client_lease> client_pool::acquire() {
+    return ss::get_units(_sem, 1).then([this](ss::semaphore_units<> units) {
+        vassert(!_idle.empty(), "semaphore units held without idle client");
+        auto cl = std::move(_idle.back());
+        _idle.pop_back();
+        return client_lease(std::move(cl), std::move(units), this);
+    });
+}
+
+void client_pool::release(client_ptr cl) { _idle.push_back(std::move(cl)); }
+
+ss::future<> multipart_upload(
+  client_pool& pool,
+  bucket_name name,
+  object_key key,
+  std::vector<multipart_source> parts) {
+    struct upload_state {
+        bucket_name name;
+        object_key key;
+        std::vector<multipart_source> parts;
+        upload_id id;
+        std::vector<ss::sstring> etags;
+    };
+    return ss::do_with(
+      upload_state{
+        .name = std::move(name),
+        .key = std::move(key),
+        .parts = std::move(parts)},
+      [&pool](upload_state& st) {
+          return pool.acquire()
+            .then([&st](client_pool::client_lease lease) {
+                return ss::do_with(
+                  std::move(lease), [&st](client_pool::client_lease& cl) {
+                      return cl->create_multipart_upload(st.name, st.key);
+                  });
+            })
+            .then([&pool, &st](upload_id id) {
+                st.id = std::move(id);
+                st.etags.resize(st.parts.size());
+                auto range = boost::irange<size_t>(0, st.parts.size());
+                return ss::parallel_for_each(
+                  range, [&pool, &st](size_t i) {
+                      return pool.acquire().then(
+                        [&st, i](client_pool::client_lease lease) {
+                            return ss::do_with(
+                              std::move(lease),
+                              [&st, i](client_pool::client_lease& cl) {
+                                  return cl
+                                    ->upload_part(
+                                      st.name,
+                                      st.key,
+                                      st.id,
+                                      i + 1,
+                                      st.parts[i].size_bytes,
+                                      std::move(st.parts[i].stream))
+                                    .then([&st, i](ss::sstring etag) {
+                                        st.etags[i] = std::move(etag);
+                                    });
+                              });
+                        });
+                  });
+            })
+            .then([&pool, &st] {
+                return pool.acquire().then(
+                  [&st](client_pool::client_lease lease) {
+                      return ss::do_with(
+                        std::move(lease),
+                        [&st](client_pool::client_lease& cl) {
+                            return cl->complete_multipart_upload(
+                              st.name, st.key, st.id, st.etags);
+                        });
+                  });
+            })
+            .handle_exception([&pool, &st](std::exception_ptr e) {
+                if (st.id().empty()) {
+                    // nothing was initiated, nothing to clean up
+                    return ss::make_exception_future<>(e);
+                }
+                // best effort abort so the uploaded parts do not linger as
+                // billable garbage; the original error is what the caller
+                // needs to see
+                return pool.acquire()
+                  .then([&st](client_pool::client_lease lease) {
+                      return ss::do_with(
+                        std::move(lease),
+                        [&st](client_pool::client_lease& cl) {
+                            return cl->abort_multipart_upload(
+                              st.name, st.key, st.id);
+                        });
+                  })
+                  .then_wrapped([e](ss::future<> f) {
+                      if (f.failed()) {
+                          vlog(
+                            s3_log.warn,
+                            "failed to abort multipart upload: {}",
+                            f.get_exception());
+                      }
+                      return ss::make_exception_future<>(e);
+                  });
+            });
+      });
+}
+
+} // namespace s3
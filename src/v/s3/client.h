@@ -0,0 +1,306 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "http/client.h"
+#include "outcome.h"
+#include "s3/signature.h"
+#include "utils/named_type.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/iostream.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/shared_ptr.hh>
+
+#include <utility>
+#include <vector>
+
+namespace s3 {
+
+using access_point_uri = named_type<ss::sstring, struct s3_access_point_uri>;
+using bucket_name = named_type<ss::sstring, struct s3_bucket_name>;
+using object_key = named_type<ss::sstring, struct s3_object_key>;
+using upload_id = named_type<ss::sstring, struct s3_upload_id>;
+
+/// S3 client configuration
+struct configuration : rpc::base_transport::configuration {
+    /// URI of the S3 access point, e.g. "s3.us-east-1.amazonaws.com"
+    access_point_uri uri;
+    /// AWS access key
+    public_key_str access_key;
+    /// AWS secret key
+    private_key_str secret_key;
+    /// AWS region
+    aws_region_name region;
+};
+
+/// Request formatter for S3 REST calls. Generates headers with the
+/// V4 signature pre-computed so they can be used with http::client.
+class request_creator {
+public:
+    /// \brief Initialize request creator
+    ///
+    /// \param conf is a client configuration
+    explicit request_creator(const configuration& conf);
+
+    /// \brief Create a signed 'GetObject' request header
+    ///
+    /// \param name is a bucket that contains the object
+    /// \param key is an object key
+    /// \return initialized and signed http header or error
+    result<http::client::request_header>
+    make_get_object_request(const bucket_name& name, const object_key& key);
+
+    /// \brief Create a 'PutObject' request header. The payload is not
+    /// signed (UNSIGNED-PAYLOAD) so the content can be streamed.
+    ///
+    /// \param name is a bucket that contains the object
+    /// \param key is an object key
+    /// \param payload_size_bytes is a size of the object in bytes
+    /// \return initialized and signed http header or error
+    result<http::client::request_header> make_unsigned_put_object_request(
+      const bucket_name& name, const object_key& key, size_t payload_size_bytes);
+
+    /// \brief Create a signed 'CreateMultipartUpload' request header
+    ///
+    /// \param name is a bucket that should receive the object
+    /// \param key is an object key
+    /// \return initialized and signed http header or error
+    result<http::client::request_header> make_create_multipart_upload_request(
+      const bucket_name& name, const object_key& key);
+
+    /// \brief Create an 'UploadPart' request header. The payload is not
+    /// signed (UNSIGNED-PAYLOAD) so the content can be streamed.
+    ///
+    /// \param name is a bucket that should receive the object
+    /// \param key is an object key
+    /// \param id is an id of the multipart upload
+    /// \param part_number is a 1-based index of the part
+    /// \param payload_size_bytes is a size of the part in bytes
+    /// \return initialized and signed http header or error
+    result<http::client::request_header> make_unsigned_upload_part_request(
+      const bucket_name& name,
+      const object_key& key,
+      const upload_id& id,
+      unsigned int part_number,
+      size_t payload_size_bytes);
+
+    /// \brief Create a 'CompleteMultipartUpload' request header. The xml
+    /// payload is not signed so it can be streamed.
+    ///
+    /// \param name is a bucket that should receive the object
+    /// \param key is an object key
+    /// \param id is an id of the multipart upload
+    /// \param payload_size_bytes is a size of the xml payload in bytes
+    /// \return initialized and signed http header or error
+    result<http::client::request_header>
+    make_unsigned_complete_multipart_upload_request(
+      const bucket_name& name,
+      const object_key& key,
+      const upload_id& id,
+      size_t payload_size_bytes);
+
+    /// \brief Create a signed 'AbortMultipartUpload' request header
+    ///
+    /// \param name is a bucket that should receive the object
+    /// \param key is an object key
+    /// \param id is an id of the multipart upload
+    /// \return initialized and signed http header or error
+    result<http::client::request_header> make_abort_multipart_upload_request(
+      const bucket_name& name, const object_key& key, const upload_id& id);
+
+private:
+    access_point_uri _ap;
+    /// Signature generator
+    signature_v4 _sign;
+};
+
+/// S3 REST-API client. Provides the object data path on top of
+/// http::client; request signing is handled internally by the
+/// request_creator.
+class client {
+public:
+    /// \brief Initialize the client
+    ///
+    /// \param conf is a client configuration
+    explicit client(const configuration& conf);
+
+    /// Stop the client
+    ss::future<> shutdown();
+
+    /// Download object from S3 bucket. The response stream yields the
+    /// object payload; the caller should verify the response status in
+    /// the stream headers before consuming the body.
+    ///
+    /// \param name is a bucket that has the object
+    /// \param key is an object key
+    /// \return future that becomes ready after the request was sent
+    ss::future<http::client::response_stream_ref>
+    get_object(const bucket_name& name, const object_key& key);
+
+    /// Upload object to S3 bucket, streaming the payload from the
+    /// provided input stream.
+    ///
+    /// \param name is a bucket that should receive the object
+    /// \param key is an object key
+    /// \param payload_size is a size of the payload in bytes
+    /// \param body is an input stream that contains payload octets
+    /// \return future that becomes ready when the upload is acknowledged
+    ss::future<> put_object(
+      const bucket_name& name,
+      const object_key& key,
+      size_t payload_size,
+      ss::input_stream<char>&& body);
+
+    /// Start a multipart upload of the object.
+    ///
+    /// \param name is a bucket that should receive the object
+    /// \param key is an object key
+    /// \return id of the initiated upload
+    ss::future<upload_id>
+    create_multipart_upload(const bucket_name& name, const object_key& key);
+
+    /// Upload a single part of a multipart upload, streaming the payload
+    /// from the provided input stream.
+    ///
+    /// \param name is a bucket that should receive the object
+    /// \param key is an object key
+    /// \param id is an id of the multipart upload
+    /// \param part_number is a 1-based index of the part
+    /// \param payload_size is a size of the part in bytes
+    /// \param body is an input stream that contains part octets
+    /// \return etag of the uploaded part, required to complete the upload
+    ss::future<ss::sstring> upload_part(
+      const bucket_name& name,
+      const object_key& key,
+      const upload_id& id,
+      unsigned int part_number,
+      size_t payload_size,
+      ss::input_stream<char>&& body);
+
+    /// Complete a multipart upload, stitching the uploaded parts into the
+    /// final object.
+    ///
+    /// \param name is a bucket that should receive the object
+    /// \param key is an object key
+    /// \param id is an id of the multipart upload
+    /// \param etags are the part etags in part number order
+    ss::future<> complete_multipart_upload(
+      const bucket_name& name,
+      const object_key& key,
+      const upload_id& id,
+      const std::vector<ss::sstring>& etags);
+
+    /// Abort a multipart upload, releasing the storage held by the parts
+    /// uploaded so far.
+    ///
+    /// \param name is a bucket that should receive the object
+    /// \param key is an object key
+    /// \param id is an id of the multipart upload
+    ss::future<> abort_multipart_upload(
+      const bucket_name& name, const object_key& key, const upload_id& id);
+
+private:
+    request_creator _requestor;
+    http::client _client;
+};
+
+/// Fixed size pool of independent client connections to one endpoint.
+/// Clients are borrowed with \ref acquire and returned automatically when
+/// the lease goes out of scope; acquire waits when all connections are
+/// busy. The pool gives concurrent uploads and downloads their own
+/// connections, which is what it takes to saturate the uplink - a single
+/// http connection serializes requests.
+class client_pool {
+public:
+    using client_ptr = ss::shared_ptr<client>;
+
+    /// RAII handle of a borrowed client. The client goes back to the
+    /// pool's idle list when the lease is destroyed.
+    class client_lease {
+    public:
+        client_lease(
+          client_ptr cl, ss::semaphore_units<> units, client_pool* pool)
+          : _client(std::move(cl))
+          , _units(std::move(units))
+          , _pool(pool) {}
+        client_lease(client_lease&& o) noexcept
+          : _client(std::move(o._client))
+          , _units(std::move(o._units))
+          , _pool(std::exchange(o._pool, nullptr)) {}
+        client_lease& operator=(client_lease&&) = delete;
+        client_lease(const client_lease&) = delete;
+        client_lease& operator=(const client_lease&) = delete;
+        ~client_lease() {
+            if (_pool) {
+                // the client is returned before the semaphore units are
+                // released, so the next waiter always finds an idle client
+                _pool->release(std::move(_client));
+            }
+        }
+
+        client& operator*() const { return *_client; }
+        client* operator->() const { return _client.get(); }
+
+    private:
+        client_ptr _client;
+        ss::semaphore_units<> _units;
+        client_pool* _pool;
+    };
+
+    /// \brief Initialize the pool
+    ///
+    /// \param size is a number of connections in the pool
+    /// \param conf is a client configuration
+    client_pool(size_t size, configuration conf);
+
+    /// Stop all clients in the pool
+    ss::future<> stop();
+
+    /// Borrow a client from the pool; waits when all clients are leased
+    ss::future<client_lease> acquire();
+
+    size_t size() const { return _all.size(); }
+
+private:
+    friend class client_lease;
+
+    void release(client_ptr);
+
+    configuration _config;
+    std::vector<client_ptr> _all;
+    std::vector<client_ptr> _idle;
+    ss::semaphore _sem;
+};
+
+/// A single part of a multipart upload
+struct multipart_source {
+    size_t size_bytes;
+    ss::input_stream<char> stream;
+};
+
+/// Upload an object as a multipart upload with the parts transferred in
+/// parallel over the pool's connections. On any failure the upload is
+/// aborted (best effort) so the already uploaded parts do not linger as
+/// billable garbage, and the original error is rethrown.
+///
+/// \param pool is a pool of clients used for the transfers
+/// \param name is a bucket that should receive the object
+/// \param key is an object key
+/// \param parts are the part payloads in part number order
+ss::future<> multipart_upload(
+  client_pool& pool,
+  bucket_name name,
+  object_key key,
+  std::vector<multipart_source> parts);
+
+} // namespace s3
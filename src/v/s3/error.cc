@@ -12,6 +12,10 @@ struct s3_error_category final : std::error_category {
             return "Target URI contains invalid query parameters";
         case s3_error_codes::not_enough_arguments:
             return "Can't make request, not enough arguments";
+        case s3_error_codes::failed_request:
+            return "S3 request failed with a non-success http status";
+        case s3_error_codes::invalid_response:
+            return "Can't parse S3 response";
         }
         return "unknown";
     }
@@ -8,6 +8,8 @@ enum class s3_error_codes : int {
     invalid_uri,
     invalid_uri_params,
     not_enough_arguments,
+    failed_request,
+    invalid_response,
 };
 
 std::error_code make_error_code(s3_error_codes ec) noexcept;
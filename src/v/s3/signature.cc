@@ -317,6 +317,9 @@ ss::sstring signature_v4::sha256_hexdigest(std::string_view payload) {
 std::error_code signature_v4::sign_header(
   http::client::request_header& header, const ss::sstring& sha256) const {
     auto amz_date = _sig_time.format_datetime();
+    // the date prefix of the same timestamp the header is stamped with, so
+    // the key scope and x-amz-date can't disagree across midnight
+    maybe_refresh_sign_key(std::string_view(amz_date.data(), 8));
     header.set("x-amz-date", {amz_date.data(), amz_date.size()});
     header.set("x-amz-content-sha256", {sha256.data(), sha256.size()});
     auto canonical_headers = get_canonical_headers(header);
@@ -344,6 +347,22 @@ std::error_code signature_v4::sign_header(
     return {};
 }
 
+void signature_v4::maybe_refresh_sign_key(std::string_view datestr) const {
+    if (_sign_key_date == datestr) {
+        return;
+    }
+    ss::sstring service = "s3";
+    _sign_key_date = ss::sstring(datestr.data(), datestr.size());
+    _sign_key = gen_sig_key(_private_key(), datestr, _region(), service);
+    _cred_scope = fmt::format(
+      "{}/{}/{}/aws4_request", _sign_key_date, _region(), service);
+    vlog(
+      s3_log.trace,
+      "\n[signing key]\n{}\n[scope]\n{}\n",
+      hexdigest(_sign_key),
+      _cred_scope);
+}
+
 signature_v4::signature_v4(
   aws_region_name region,
   public_key_str access_key,
@@ -353,15 +372,6 @@ signature_v4::signature_v4(
   , _region(std::move(region))
   , _access_key(std::move(access_key))
   , _private_key(std::move(private_key)) {
-    ss::sstring date_str = _sig_time.format_date();
-    ss::sstring service = "s3";
-    _sign_key = gen_sig_key(_private_key(), date_str, _region(), service);
-    _cred_scope = fmt::format(
-      "{}/{}/{}/aws4_request", date_str, _region(), service);
-    vlog(
-      s3_log.trace,
-      "\n[signing key]\n{}\n[scope]\n{}\n",
-      hexdigest(_sign_key),
-      _cred_scope);
+    maybe_refresh_sign_key(_sig_time.format_date());
 }
 } // namespace s3
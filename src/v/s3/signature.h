@@ -98,6 +98,13 @@ private:
     /// requirements)
     static ss::sstring sha256_hexdigest(std::string_view payload);
 
+    /// Re-derive the signing key if the UTC date moved past the day the
+    /// cached key is scoped to. The date-scoped HMAC chain is only valid
+    /// for one day; deriving it lazily keeps a long lived client signing
+    /// correctly across midnight while signing each request with a cached
+    /// key instead of recomputing the chain.
+    void maybe_refresh_sign_key(std::string_view datestr) const;
+
     /// Time of the signing key
     time_source _sig_time;
     /// AWS region
@@ -106,10 +113,12 @@ private:
     public_key_str _access_key;
     /// Secret key
     private_key_str _private_key;
-    /// Service specific signing key
-    ss::sstring _sign_key;
+    /// Service specific signing key, cached per day
+    mutable ss::sstring _sign_key;
     /// Scope of the key (part of the header digest)
-    ss::sstring _cred_scope;
+    mutable ss::sstring _cred_scope;
+    /// Date the cached signing key was derived for
+    mutable ss::sstring _sign_key_date;
 };
 
 template<class Fn>
@@ -0,0 +1,45 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "s3/client.h"
+#include "seastarx.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+static s3::configuration transport_configuration() {
+    s3::configuration conf;
+    conf.server_addr = ss::socket_address(
+      ss::ipv4_addr("127.0.0.1", 4430)); // NOLINT
+    conf.uri = s3::access_point_uri("s3.us-east-1.amazonaws.com");
+    conf.access_key = s3::public_key_str("access-key");
+    conf.secret_key = s3::private_key_str("secret-key");
+    conf.region = s3::aws_region_name("us-east-1");
+    return conf;
+}
+
+SEASTAR_THREAD_TEST_CASE(test_pool_acquire_release) {
+    auto conf = transport_configuration();
+    s3::client_pool pool(2, conf);
+    BOOST_REQUIRE_EQUAL(pool.size(), 2);
+
+    auto lease1 = pool.acquire().get0();
+    auto lease2 = pool.acquire().get0();
+
+    // all clients are leased: the next acquire waits
+    auto fut = pool.acquire();
+    BOOST_REQUIRE(!fut.available());
+
+    {
+        // returning a lease wakes the waiter
+        auto done = std::move(lease1);
+    }
+    auto lease3 = fut.get0();
+
+    pool.stop().get0();
+}
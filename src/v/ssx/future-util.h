@@ -14,12 +14,79 @@
 
 #include <seastar/core/future-util.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/preempt.hh>
 
 #include <algorithm>
 #include <iterator>
 
 namespace ssx {
 
+/// \brief Continuation that runs inline when the future is already resolved.
+///
+/// On hot paths most futures are ready by the time the continuation is
+/// attached (e.g. parsing requests whose bytes are already buffered), yet
+/// \c then() still sets up continuation state before discovering that. This
+/// helper invokes \c func directly - no task or continuation frame - when
+/// the future is resolved and the reactor does not ask for preemption, and
+/// degrades to a plain \c then() otherwise. Exceptions thrown by the inline
+/// invocation are captured into the returned future, matching \c then()
+/// semantics.
+///
+/// \param fut the future to continue
+/// \param func Function invoked with the future's result (will be futurized
+/// if it doesn't return a \c future<>)
+/// \return the futurized result of \c func
+// clang-format off
+template<typename Func, typename... T>
+CONCEPT(requires requires(Func f, ss::future<T...> fut) {
+    std::move(fut).then(std::move(f));
+})
+// clang-format on
+inline auto inline_then(seastar::future<T...> fut, Func&& func) {
+    if (
+      fut.available() && !fut.failed() && !seastar::need_preempt()) {
+        if constexpr (sizeof...(T) == 0) {
+            return seastar::futurize_invoke(std::forward<Func>(func));
+        } else {
+            return seastar::futurize_invoke(
+              std::forward<Func>(func), fut.get0());
+        }
+    }
+    return std::move(fut).then(std::forward<Func>(func));
+}
+
+/// \brief Fixed-arity \c when_all_succeed for already-started futures.
+///
+/// \c seastar::when_all_succeed allocates waiter state sized at runtime;
+/// for a fixed set of futures the inputs are already running, so waiting
+/// for them one after another is equivalent and needs no allocation at
+/// all when the inputs are ready. A failed input is reported only after
+/// every other input resolved, like \c when_all_succeed; when several
+/// fail, one of the exceptions is returned.
+inline seastar::future<> when_all_fixed(seastar::future<> head) {
+    return head;
+}
+
+template<typename... Futs>
+inline seastar::future<>
+when_all_fixed(seastar::future<> head, Futs... tail) {
+    if (head.available() && !head.failed()) {
+        return when_all_fixed(std::move(tail)...);
+    }
+    return std::move(head).then_wrapped(
+      [... tail = std::move(tail)](seastar::future<> done) mutable {
+          if (done.failed()) {
+              return when_all_fixed(std::move(tail)...)
+                .then_wrapped([e = done.get_exception()](
+                                seastar::future<> rest) {
+                    rest.ignore_ready_future();
+                    return seastar::make_exception_future<>(e);
+                });
+          }
+          return when_all_fixed(std::move(tail)...);
+      });
+}
+
 /// \brief Run tasks synchronously in order and wait for completion only
 /// invoking futures one after the previous has completed
 ///
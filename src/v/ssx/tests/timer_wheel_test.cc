@@ -0,0 +1,90 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "ssx/timer_wheel.h"
+
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include <chrono>
+#include <seastarx.h>
+
+using namespace std::chrono_literals;
+
+SEASTAR_THREAD_TEST_CASE(timer_wheel_fires_in_deadline_order) {
+    ssx::timer_wheel<ss::lowres_clock> wheel;
+    std::vector<int> fired;
+
+    ssx::timer_wheel<ss::lowres_clock>::timer first(wheel);
+    ssx::timer_wheel<ss::lowres_clock>::timer second(wheel);
+    first.set_callback([&fired] { fired.push_back(1); });
+    second.set_callback([&fired] { fired.push_back(2); });
+
+    first.arm(20ms);
+    second.arm(200ms);
+    BOOST_REQUIRE(first.armed());
+    BOOST_REQUIRE(second.armed());
+
+    ss::sleep(100ms).get();
+    BOOST_REQUIRE_EQUAL(fired.size(), 1);
+    BOOST_REQUIRE_EQUAL(fired[0], 1);
+    BOOST_REQUIRE(!first.armed());
+    BOOST_REQUIRE(second.armed());
+
+    ss::sleep(200ms).get();
+    BOOST_REQUIRE_EQUAL(fired.size(), 2);
+    BOOST_REQUIRE_EQUAL(fired[1], 2);
+}
+
+SEASTAR_THREAD_TEST_CASE(timer_wheel_cancel_and_rearm) {
+    ssx::timer_wheel<ss::lowres_clock> wheel;
+    int fired = 0;
+
+    ssx::timer_wheel<ss::lowres_clock>::timer t(wheel);
+    t.set_callback([&fired] { ++fired; });
+
+    t.arm(20ms);
+    BOOST_REQUIRE(t.cancel());
+    BOOST_REQUIRE(!t.armed());
+    ss::sleep(100ms).get();
+    BOOST_REQUIRE_EQUAL(fired, 0);
+
+    // rearm supersedes the previous deadline
+    t.arm(1h);
+    t.arm(20ms);
+    ss::sleep(100ms).get();
+    BOOST_REQUIRE_EQUAL(fired, 1);
+
+    // callbacks may rearm their own timer
+    t.set_callback([&fired, &t] {
+        if (++fired < 3) {
+            t.arm(20ms);
+        }
+    });
+    t.arm(20ms);
+    ss::sleep(300ms).get();
+    BOOST_REQUIRE_EQUAL(fired, 3);
+    BOOST_REQUIRE(!t.armed());
+}
+
+SEASTAR_THREAD_TEST_CASE(timer_wheel_deadlines_beyond_one_revolution) {
+    ssx::timer_wheel<ss::lowres_clock> wheel;
+    // 128 buckets x 10ms tick = 1.28s per revolution, this entry shares a
+    // bucket with earlier revolutions and must not fire prematurely
+    int fired = 0;
+    ssx::timer_wheel<ss::lowres_clock>::timer t(wheel);
+    t.set_callback([&fired] { ++fired; });
+    t.arm(2s);
+
+    ss::sleep(1500ms).get();
+    BOOST_REQUIRE_EQUAL(fired, 0);
+    ss::sleep(1s).get();
+    BOOST_REQUIRE_EQUAL(fired, 1);
+}
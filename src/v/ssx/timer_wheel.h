@@ -0,0 +1,167 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "utils/intrusive_list_helpers.h"
+
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include <array>
+#include <chrono>
+
+namespace ssx {
+
+/**
+ * \brief A hashed timing wheel coalescing many coarse timers into a single
+ * seastar timer.
+ *
+ * Every armed seastar timer is an entry in the reactor wide timer heap, so a
+ * shard hosting tens of thousands of independently rearmed timers (e.g. raft
+ * election timeouts, one per group) pays measurable heap churn even when the
+ * cluster is idle. The wheel hashes timers into buckets by expiry tick and
+ * drives all of them with one periodic seastar timer that only runs while at
+ * least one entry is armed, making arm/cancel/rearm O(1) and the per tick
+ * work proportional to the timers that are actually due.
+ *
+ * Expiry resolution is one tick (10ms). This is the same order as
+ * ss::lowres_clock granularity and is only suitable for coarse timeouts like
+ * elections and heartbeats, not for fine grained request expiry.
+ */
+template<typename Clock = ss::lowres_clock>
+class timer_wheel {
+public:
+    using time_point = typename Clock::time_point;
+    using duration = typename Clock::duration;
+
+    class timer {
+    public:
+        explicit timer(timer_wheel& w)
+          : _wheel(&w) {}
+        timer(timer&&) = delete;
+        timer(const timer&) = delete;
+        timer& operator=(timer&&) = delete;
+        timer& operator=(const timer&) = delete;
+        ~timer() { cancel(); }
+
+        void set_callback(ss::noncopyable_function<void()> cb) {
+            _callback = std::move(cb);
+        }
+
+        /// (Re)arms the timer to fire at the given deadline
+        void rearm(time_point deadline) {
+            cancel();
+            _deadline = deadline;
+            _wheel->schedule(*this);
+        }
+
+        void arm(duration d) { rearm(Clock::now() + d); }
+
+        /// Cancels the timer, returns true if it was armed
+        bool cancel() {
+            if (!_hook.is_linked()) {
+                return false;
+            }
+            _hook.unlink();
+            _wheel->_armed_count--;
+            return true;
+        }
+
+        bool armed() const { return _hook.is_linked(); }
+
+    private:
+        friend class timer_wheel;
+
+        timer_wheel* _wheel;
+        ss::noncopyable_function<void()> _callback;
+        time_point _deadline;
+        intrusive_list_hook _hook;
+    };
+
+    timer_wheel()
+      : _last_tick(to_tick(Clock::now())) {
+        _driver.set_callback([this] { service(); });
+    }
+
+private:
+    friend class timer;
+
+    static constexpr duration tick_interval
+      = std::chrono::duration_cast<duration>(std::chrono::milliseconds(10));
+    static constexpr size_t bucket_count = 128;
+
+    static uint64_t to_tick(time_point t) {
+        return t.time_since_epoch() / tick_interval;
+    }
+
+    void schedule(timer& t) {
+        // hash by expiry tick. entries more than bucket_count ticks out
+        // share a bucket with nearer ones and are simply skipped until
+        // their deadline tick comes around
+        _buckets[to_tick(t._deadline) % bucket_count].push_back(t);
+        _armed_count++;
+        if (!_driver.armed()) {
+            _driver.arm(tick_interval);
+        }
+    }
+
+    void service() {
+        auto now = Clock::now();
+        auto now_tick = to_tick(now);
+        // collect due entries first, callbacks may arm or cancel arbitrary
+        // timers and must not invalidate the bucket iteration
+        intrusive_list<timer, &timer::_hook> due;
+        // visit every bucket whose tick elapsed since the last run, at most
+        // one full wheel revolution
+        auto first = _last_tick + 1;
+        auto last = std::min(now_tick, first + bucket_count - 1);
+        for (uint64_t t = first; t <= last; ++t) {
+            auto& bucket = _buckets[t % bucket_count];
+            intrusive_list<timer, &timer::_hook> pending;
+            pending.swap(bucket);
+            while (!pending.empty()) {
+                auto& entry = pending.front();
+                pending.pop_front();
+                if (entry._deadline <= now) {
+                    due.push_back(entry);
+                } else {
+                    // hash collision with a later revolution, put it back
+                    bucket.push_back(entry);
+                }
+            }
+        }
+        _last_tick = now_tick;
+        while (!due.empty()) {
+            auto& entry = due.front();
+            entry.cancel();
+            entry._callback();
+        }
+        // keep ticking only while there is something armed
+        if (_armed_count > 0) {
+            _driver.arm(tick_interval);
+        }
+    }
+
+    std::array<intrusive_list<timer, &timer::_hook>, bucket_count> _buckets;
+    ss::timer<Clock> _driver;
+    size_t _armed_count{0};
+    uint64_t _last_tick;
+};
+
+/// Shard local wheel shared by all users with the same clock
+template<typename Clock = ss::lowres_clock>
+timer_wheel<Clock>& shard_timer_wheel() {
+    static thread_local timer_wheel<Clock> wheel;
+    return wheel;
+}
+
+} // namespace ssx
@@ -0,0 +1,192 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/aborted_txn_index.h"
+
+#include "bytes/iobuf_parser.h"
+#include "hashing/xx.h"
+#include "likely.h"
+#include "reflection/adl.h"
+#include "storage/logger.h"
+#include "vassert.h"
+#include "vlog.h"
+
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include <optional>
+
+namespace storage {
+
+uint64_t aborted_txn_index::checksum_state(const aborted_txn_index& r) {
+    auto xx = incremental_xxhash64{};
+    xx.update_all(
+      r.bitflags, r.base_offset(), uint32_t(r.producer_id_index.size()));
+    const uint32_t vsize = r.producer_id_index.size();
+    for (auto i = 0U; i < vsize; ++i) {
+        xx.update(r.producer_id_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        xx.update(r.relative_first_offset_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        xx.update(r.relative_last_offset_index[i]);
+    }
+    return xx.digest();
+}
+
+void aborted_txn_index::add_entry(
+  int64_t producer_id, model::offset first, model::offset last) {
+    vassert(
+      first >= base_offset && last >= first,
+      "invalid aborted txn range [{},{}] for index with base {}",
+      first,
+      last,
+      base_offset);
+    // We know that a segment cannot be > 4GB
+    producer_id_index.push_back(producer_id);
+    relative_first_offset_index.push_back(first() - base_offset());
+    relative_last_offset_index.push_back(last() - base_offset());
+}
+
+std::vector<aborted_txn_index::entry>
+aborted_txn_index::collect(model::offset from, model::offset to) const {
+    std::vector<entry> retval;
+    const uint32_t vsize = producer_id_index.size();
+    for (auto i = 0U; i < vsize; ++i) {
+        auto first = base_offset
+                     + model::offset(relative_first_offset_index[i]);
+        auto last = base_offset + model::offset(relative_last_offset_index[i]);
+        if (first <= to && last >= from) {
+            retval.push_back(entry{
+              .producer_id = producer_id_index[i],
+              .first_offset = first,
+              .last_offset = last,
+            });
+        }
+    }
+    return retval;
+}
+
+void aborted_txn_index::truncate(model::offset o) {
+    if (o <= base_offset) {
+        producer_id_index.clear();
+        relative_first_offset_index.clear();
+        relative_last_offset_index.clear();
+        return;
+    }
+    const uint32_t max_relative = o() - base_offset();
+    size_t keep = 0;
+    for (size_t i = 0; i < producer_id_index.size(); ++i) {
+        if (relative_first_offset_index[i] >= max_relative) {
+            continue;
+        }
+        producer_id_index[keep] = producer_id_index[i];
+        relative_first_offset_index[keep] = relative_first_offset_index[i];
+        // a transaction cut by the truncation keeps only its surviving
+        // prefix of offsets
+        relative_last_offset_index[keep] = std::min(
+          relative_last_offset_index[i], max_relative - 1);
+        ++keep;
+    }
+    producer_id_index.resize(keep);
+    relative_first_offset_index.resize(keep);
+    relative_last_offset_index.resize(keep);
+}
+
+std::ostream& operator<<(std::ostream& o, const aborted_txn_index& s) {
+    return o << "{version:" << (int)s.version << ", header_size:" << s.size
+             << ", header_checksum:" << s.checksum
+             << ", header_bitflags:" << s.bitflags
+             << ", base_offset:" << s.base_offset << ", index("
+             << s.producer_id_index.size() << ","
+             << s.relative_first_offset_index.size() << ","
+             << s.relative_last_offset_index.size() << ")}";
+}
+
+std::optional<aborted_txn_index>
+aborted_txn_index::hydrate_from_buffer(iobuf b) {
+    iobuf_parser parser(std::move(b));
+    aborted_txn_index retval;
+    retval.version = reflection::adl<int8_t>{}.from(parser);
+    if (retval.version != 1) {
+        return std::nullopt;
+    }
+    retval.size = reflection::adl<uint32_t>{}.from(parser);
+    retval.checksum = reflection::adl<uint64_t>{}.from(parser);
+    retval.bitflags = reflection::adl<uint32_t>{}.from(parser);
+    retval.base_offset = model::offset(
+      reflection::adl<model::offset::type>{}.from(parser));
+
+    const uint32_t vsize = ss::le_to_cpu(
+      reflection::adl<uint32_t>{}.from(parser));
+    retval.producer_id_index.reserve(vsize);
+    retval.relative_first_offset_index.reserve(vsize);
+    retval.relative_last_offset_index.reserve(vsize);
+    for (auto i = 0U; i < vsize; ++i) {
+        retval.producer_id_index.push_back(
+          reflection::adl<int64_t>{}.from(parser));
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        retval.relative_first_offset_index.push_back(
+          reflection::adl<uint32_t>{}.from(parser));
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        retval.relative_last_offset_index.push_back(
+          reflection::adl<uint32_t>{}.from(parser));
+    }
+    const auto computed_checksum = aborted_txn_index::checksum_state(retval);
+    if (unlikely(retval.checksum != computed_checksum)) {
+        vlog(
+          stlog.debug,
+          "Invalid checksum for tx index. Got:{}, expected:{}",
+          computed_checksum,
+          retval.checksum);
+        return std::nullopt;
+    }
+    return retval;
+}
+
+iobuf aborted_txn_index::checksum_and_serialize() {
+    iobuf out;
+    vassert(
+      producer_id_index.size() == relative_first_offset_index.size()
+        && producer_id_index.size() == relative_last_offset_index.size(),
+      "ALL indexes must match in size. {}",
+      *this);
+    const uint32_t final_size
+      = sizeof(aborted_txn_index::checksum)
+        + sizeof(aborted_txn_index::bitflags)
+        + sizeof(aborted_txn_index::base_offset) + (uint32_t) // index size
+        + (producer_id_index.size()
+           * (sizeof(int64_t) + sizeof(uint32_t) * 2));
+    size = final_size;
+    checksum = aborted_txn_index::checksum_state(*this);
+    reflection::serialize(
+      out,
+      version,
+      size,
+      checksum,
+      bitflags,
+      base_offset(),
+      uint32_t(producer_id_index.size()));
+    const uint32_t vsize = producer_id_index.size();
+    for (auto i = 0U; i < vsize; ++i) {
+        reflection::serialize(out, producer_id_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        reflection::serialize(out, relative_first_offset_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        reflection::serialize(out, relative_last_offset_index[i]);
+    }
+    return out;
+}
+
+} // namespace storage
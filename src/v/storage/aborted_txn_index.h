@@ -0,0 +1,100 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "bytes/iobuf.h"
+#include "model/fundamental.h"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace storage {
+/* Fileformat:
+   1 byte  - version
+   4 bytes - size - does not include the version or size
+   8 bytes - checksum - xxhash64 -- we checksum everything below the checksum
+   4 bytes - bitflags - unused
+   8 bytes - base_offset
+   4 bytes - entry count
+   [] producer_id
+   [] relative_first_offset
+   [] relative_last_offset
+
+   Per segment index of aborted transactions, the transactional sibling of
+   index_state. It lives next to the segment's base_index:
+
+       default/test/0/1-1-v1.log
+       default/test/0/1-1-v1.base_index
+       default/test/0/1-1-v1.tx_index
+
+   One entry per transaction aborted within the segment records the
+   producer id and the [first, last] offset range the transaction's
+   batches span. A read_committed fetch collects the entries overlapping
+   its fetch range with a linear pass over the (small, offset ordered)
+   arrays instead of scanning segment data for control batches. Offsets
+   are stored relative to base_offset in the same fixed width
+   struct-of-arrays layout as index_state.
+
+   Nothing populates the index yet: it is groundwork so transaction
+   support can be added without touching the non-transactional fetch
+   path, which never opens the file.
+ */
+struct aborted_txn_index {
+    /// brief hydrated entry, offsets rebased to absolute
+    struct entry {
+        int64_t producer_id;
+        model::offset first_offset;
+        model::offset last_offset;
+    };
+
+    aborted_txn_index() = default;
+    aborted_txn_index(aborted_txn_index&&) noexcept = default;
+    aborted_txn_index& operator=(aborted_txn_index&&) noexcept = default;
+    aborted_txn_index(const aborted_txn_index&) = delete;
+    aborted_txn_index& operator=(const aborted_txn_index&) = delete;
+    ~aborted_txn_index() noexcept = default;
+
+    int8_t version{1};
+    /// \brief sizeof the index in bytes
+    uint32_t size{0};
+    /// \brief currently xxhash64
+    uint64_t checksum{0};
+    /// \brief unused
+    uint32_t bitflags{0};
+    // the segment's base offset; entry offsets are relative to it
+    model::offset base_offset{0};
+
+    std::vector<int64_t> producer_id_index;
+    std::vector<uint32_t> relative_first_offset_index;
+    std::vector<uint32_t> relative_last_offset_index;
+
+    bool empty() const { return producer_id_index.empty(); }
+
+    void add_entry(
+      int64_t producer_id, model::offset first, model::offset last);
+
+    /// entries whose offset range overlaps [from, to], in index order
+    std::vector<entry> collect(model::offset from, model::offset to) const;
+
+    /// drops entries of transactions aborted entirely at or above the
+    /// truncation point; used by prefix_truncate of the owning segment
+    void truncate(model::offset o);
+
+    iobuf checksum_and_serialize();
+
+    static std::optional<aborted_txn_index> hydrate_from_buffer(iobuf);
+    static uint64_t checksum_state(const aborted_txn_index&);
+    friend std::ostream& operator<<(std::ostream&, const aborted_txn_index&);
+};
+
+} // namespace storage
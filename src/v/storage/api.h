@@ -14,6 +14,7 @@
 #include "seastarx.h"
 #include "storage/kvstore.h"
 #include "storage/log_manager.h"
+#include "storage/log_verifier.h"
 
 namespace storage {
 
@@ -43,6 +44,15 @@ public:
 
     kvstore& kvs() { return *_kvstore; }
     log_manager& log_mgr() { return *_log_mgr; }
+    flush_coordinator& flusher() { return _log_mgr->flusher(); }
+
+    /// Full checksum verification of this shard's logs; run on every
+    /// shard in parallel for a whole-node sweep. See storage/log_verifier.h
+    ss::future<verify_report> verify() { return verify_logs(log_mgr()); }
+
+    /// Rolling-window io rates of this shard's logs; aggregated across
+    /// shards by the hot-partition admin query
+    std::vector<log_io_rates> io_rates() { return log_mgr().io_rates(); }
 
 private:
     kvstore_config _kv_conf;
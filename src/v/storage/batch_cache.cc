@@ -24,20 +24,64 @@ batch_cache::put(batch_cache_index& index, const model::record_batch& input) {
     // we must copy memory to prevent holding onto bigger memory from
     // temporary buffers
     auto batch = input.copy();
-    _size_bytes += batch.memory_usage();
+    const auto mem = batch.memory_usage();
+    _size_bytes += mem;
+    index._cached_bytes += mem;
     auto e = new entry(index, std::move(batch));
 
     // if weak_from_this were to cause an allocation--which it shouldn't--`e`
     // wouldn't be visible to the reclaimer since it isn't on a lru/pool list.
     auto p = e->weak_from_this();
-    _lru.push_back(*e);
+    /*
+     * new entries start on probation. when other indexes also hold cached
+     * data, an index holding more than half of all cached bytes (e.g. a
+     * partition replaying its history) has its new entries inserted at the
+     * cold end so it preferentially evicts itself.
+     */
+    if (unlikely(
+          _size_bytes > index._cached_bytes
+          && index._cached_bytes > _size_bytes / 2 && !_probation.empty())) {
+        _probation.push_front(*e);
+    } else {
+        _probation.push_back(*e);
+    }
     return p;
 }
 
+void batch_cache::touch(entry_ptr& e) {
+    if (!e) {
+        return;
+    }
+    auto p = e.get();
+    p->_hook.unlink();
+    if (p->_area == entry::cache_area::probation) {
+        p->_area = entry::cache_area::protection;
+        _protected_bytes += p->_batch.memory_usage();
+    }
+    _lru.push_back(*p);
+    /*
+     * keep the protected segment within its share of the cache by demoting
+     * its coldest entries back to probation. demotion (rather than eviction)
+     * gives previously-hot entries one more chance before reclaim.
+     */
+    const auto limit = static_cast<size_t>(
+      static_cast<double>(_size_bytes) * max_protected_fraction);
+    while (_protected_bytes > limit && !_lru.empty()) {
+        auto& cold = _lru.front();
+        if (&cold == p) {
+            break;
+        }
+        cold._hook.unlink();
+        cold._area = entry::cache_area::probation;
+        _protected_bytes -= cold._batch.memory_usage();
+        _probation.push_back(cold);
+    }
+}
+
 batch_cache::~batch_cache() noexcept {
     clear();
     vassert(
-      _size_bytes == 0 && _lru.empty(),
+      _size_bytes == 0 && _lru.empty() && _probation.empty(),
       "Detected incorrect batch_cache accounting. {}",
       *this);
 }
@@ -48,9 +92,14 @@ void batch_cache::evict(entry_ptr&& e) {
         // invalidates the caller's entry_ptr. simply interacting with the
         // r-value reference `e` wouldn't do that.
         auto p = std::exchange(e, {});
-        _size_bytes -= p->_batch.memory_usage();
-        _lru.erase_and_dispose(
-          _lru.iterator_to(*p), [](entry* e) { delete e; });
+        const auto mem = p->_batch.memory_usage();
+        _size_bytes -= mem;
+        p->_index._cached_bytes -= mem;
+        if (p->_area == entry::cache_area::protection) {
+            _protected_bytes -= mem;
+        }
+        p->_hook.unlink();
+        delete p.get(); // NOLINT
     }
 }
 
@@ -86,11 +135,54 @@ size_t batch_cache::reclaim(size_t size) {
      * invalidated. invalidation is important because the batch reference in the
      * index still exists even though the batch data was removed.
      */
-    size_t reclaimed = 0;
     intrusive_list<entry, &entry::_hook> reclaimed_entries;
 
-    for (auto it = _lru.begin(); it != _lru.end();) {
-        if (reclaimed >= _reclaim_size) {
+    /*
+     * scan resistance: drain the probationary segment first so one-shot
+     * readers evict their own entries. only touch the protected segment if
+     * probation alone cannot satisfy the reclaim target.
+     */
+    size_t reclaimed = reclaim_from(
+      _probation, _reclaim_size, reclaimed_entries);
+    if (reclaimed < _reclaim_size) {
+        reclaimed += reclaim_from(
+          _lru, _reclaim_size - reclaimed, reclaimed_entries);
+    }
+
+    /*
+     * final removal from the index is deferred because there is some chance
+     * that removal allocates, so waiting until the bulk of the reclaims have
+     * occurred reduces the probability of an allocation failure.
+     */
+    reclaimed_entries.clear_and_dispose([](entry* e) {
+        auto offset = e->_batch.base_offset();
+        auto* index = &e->_index;
+        delete e; // NOLINT
+
+        /*
+         * since reclaim may be invoked at any moment and removals may be
+         * deferred if an index is locked, one can imagine races in which a
+         * batch is removed by offset here which is not the same batch that was
+         * reclaimed in a prior pass. at worst this would raise the miss ratio,
+         * but is still generally safe since all batch cache users are prepared
+         * to handle a miss.
+         */
+        index->remove(offset);
+    });
+
+    _last_reclaim = ss::lowres_clock::now();
+    _size_bytes -= reclaimed;
+    return reclaimed;
+}
+
+size_t batch_cache::reclaim_from(
+  intrusive_list<entry, &entry::_hook>& list,
+  size_t target,
+  intrusive_list<entry, &entry::_hook>& reclaimed_entries) {
+    size_t reclaimed = 0;
+
+    for (auto it = list.begin(); it != list.end();) {
+        if (reclaimed >= target) {
             break;
         }
 
@@ -101,7 +193,8 @@ size_t batch_cache::reclaim(size_t size) {
         }
 
         // reclaim the batch's record data
-        reclaimed += it->_batch.memory_usage();
+        const auto before = it->_batch.memory_usage();
+        reclaimed += before;
         it->_batch.clear_data();
 
         /*
@@ -110,41 +203,27 @@ size_t batch_cache::reclaim(size_t size) {
          * iterators on the index.
          */
         if (unlikely(it->_index.locked())) {
-            reclaimed -= it->_batch.memory_usage();
+            const auto after = it->_batch.memory_usage();
+            reclaimed -= after;
+            it->_index._cached_bytes -= before - after;
+            if (it->_area == entry::cache_area::protection) {
+                _protected_bytes -= before - after;
+            }
             it->invalidate();
             ++it;
             continue;
         }
 
+        it->_index._cached_bytes -= before;
+        if (it->_area == entry::cache_area::protection) {
+            _protected_bytes -= before;
+        }
+
         // collect the entries that will be fully removed
-        it = _lru.erase_and_dispose(it, [&reclaimed_entries](entry* e) {
+        it = list.erase_and_dispose(it, [&reclaimed_entries](entry* e) {
             reclaimed_entries.push_back(*e);
         });
     }
-
-    /*
-     * final removal from the index is deferred because there is some chance
-     * that removal allocates, so waiting until the bulk of the reclaims have
-     * occurred reduces the probability of an allocation failure.
-     */
-    reclaimed_entries.clear_and_dispose([](entry* e) {
-        auto offset = e->_batch.base_offset();
-        auto* index = &e->_index;
-        delete e; // NOLINT
-
-        /*
-         * since reclaim may be invoked at any moment and removals may be
-         * deferred if an index is locked, one can imagine races in which a
-         * batch is removed by offset here which is not the same batch that was
-         * reclaimed in a prior pass. at worst this would raise the miss ratio,
-         * but is still generally safe since all batch cache users are prepared
-         * to handle a miss.
-         */
-        index->remove(offset);
-    });
-
-    _last_reclaim = ss::lowres_clock::now();
-    _size_bytes -= reclaimed;
     return reclaimed;
 }
 
@@ -228,6 +307,21 @@ batch_cache_index::read_result batch_cache_index::read(
     return ret;
 }
 
+batch_cache::pin_guard
+batch_cache_index::pin(model::offset begin, model::offset end) {
+    lock_guard lk(*this);
+    batch_cache::pin_guard guard;
+    for (auto it = find_first(begin); it != _index.end() && it->first <= end;
+         ++it) {
+        if (it->second && it->second->valid()) {
+            auto* e = it->second.get();
+            e->pin();
+            guard._entries.push_back(e->weak_from_this());
+        }
+    }
+    return guard;
+}
+
 void batch_cache_index::truncate(model::offset offset) {
     lock_guard lk(*this);
     if (auto it = find_first(offset); it != _index.end()) {
@@ -249,7 +343,9 @@ std::ostream& operator<<(std::ostream& o, const batch_cache& b) {
     // Do _not_ print size of _lru
     return o << "{is_reclaiming:" << b.is_memory_reclaiming()
              << ", size_bytes: " << b._size_bytes
-             << ", lru_empty:" << b._lru.empty() << "}";
+             << ", protected_bytes: " << b._protected_bytes
+             << ", lru_empty:" << b._lru.empty()
+             << ", probation_empty:" << b._probation.empty() << "}";
 }
 std::ostream&
 operator<<(std::ostream& o, const batch_cache_index::read_result& c) {
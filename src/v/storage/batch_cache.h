@@ -13,6 +13,7 @@
 #include "config/configuration.h"
 #include "model/record.h"
 #include "utils/intrusive_list_helpers.h"
+#include "utils/slab_pool.h"
 #include "vassert.h"
 
 #include <seastar/core/circular_buffer.hh>
@@ -25,6 +26,7 @@
 
 #include <limits>
 #include <type_traits>
+#include <vector>
 
 namespace storage {
 
@@ -51,6 +53,22 @@ class batch_cache_index;
  * example, a batch cache index is created for each log segment, all of which
  * share the same LRU cache.
  *
+ * Eviction policy
+ * ===============
+ *
+ * The cache is a segmented LRU. New batches start in a probationary segment
+ * and are promoted into the protected segment on their first touch. Reclaim
+ * drains the probationary segment before touching the protected one, so a
+ * one-shot scan (e.g. a consumer rewinding and replaying a partition) churns
+ * through probation without flushing the hot tails of other partitions. When
+ * the protected segment grows beyond its share of the cache its coldest
+ * entries are demoted back to probation rather than evicted outright.
+ *
+ * Additionally, a single index that holds more than half of the cached bytes
+ * has its new insertions placed at the cold end of probation, so one
+ * replaying partition becomes its own first eviction victim instead of
+ * evicting every other partition's tail on the shard.
+ *
  * The LRU cache serves as an entry point for the Seastar memory reclaimer.
  * During a low-memory event Seastar may make an upcall to the LRU cache to free
  * memory. When memory is reclaimed cache entries are invalidated. Since this
@@ -140,6 +158,16 @@ public:
         entry(const entry&) = delete;
         entry& operator=(const entry&) = delete;
 
+        // entries churn with every cache insertion and eviction; they are
+        // carved from the per-shard slab pool instead of the general
+        // allocator
+        static void* operator new(size_t size) {
+            return slab_pool<entry>::local().allocate(size);
+        }
+        static void operator delete(void* p, size_t size) {
+            slab_pool<entry>::local().deallocate(p, size);
+        }
+
         // the entry initially contains a valid batch, but it may transition
         // into an invalid state where the batch data cannot be accessed.
         bool valid() const { return _valid; }
@@ -150,27 +178,91 @@ public:
             return _batch;
         }
 
-        void pin() { _pinned = true; }
-        void unpin() { _pinned = false; }
-        bool pinned() const { return _pinned; }
+        // pins nest: short synchronous lock_guards and long lived
+        // pin_guards may overlap on the same entry
+        void pin() { ++_pins; }
+        void unpin() {
+            vassert(_pins > 0, "unpin of unpinned batch cache entry");
+            --_pins;
+        }
+        bool pinned() const { return _pins > 0; }
 
     private:
         friend class batch_cache;
+        friend class batch_cache_index;
         friend ss::weakly_referencable<entry>;
 
+        /*
+         * segment of the cache the entry currently lives in. new entries
+         * start on probation and are promoted on their first touch. see the
+         * reclaim policy description on batch_cache.
+         */
+        enum class cache_area : uint8_t { probation, protection };
+
         // invalidation is logical. we still want the cache to be able to look
         // at its memory usage and base offset, but the cache index should never
         // interact with an invalid entry.
         bool _valid{true};
         model::record_batch _batch;
 
-        bool _pinned{false};
+        uint32_t _pins{0};
+        cache_area _area{cache_area::probation};
         intrusive_list_hook _hook;
         batch_cache_index& _index;
     };
 
     using entry_ptr = ss::weak_ptr<entry>;
 
+    /**
+     * RAII lease over a set of pinned cache entries. While held, the
+     * reclaimer skips the covered entries, so they stay memory resident
+     * through low-memory events. Unlike entry::lock_guard, which guards a
+     * single entry across one synchronous allocation, a pin_guard is held
+     * across scheduling points - e.g. raft pins the uncommitted tail of a
+     * log until the quorum acks it so follower dispatch never falls back
+     * to a disk read for fresh data.
+     *
+     * The guard only holds weak references: entries removed by truncation
+     * or explicit eviction simply drop out and are skipped on release.
+     */
+    class pin_guard {
+    public:
+        pin_guard() noexcept = default;
+        pin_guard(pin_guard&&) noexcept = default;
+        pin_guard& operator=(pin_guard&& o) noexcept {
+            if (this != &o) {
+                release();
+                _entries = std::move(o._entries);
+            }
+            return *this;
+        }
+        pin_guard(const pin_guard&) = delete;
+        pin_guard& operator=(const pin_guard&) = delete;
+        ~pin_guard() noexcept { release(); }
+
+        /// take over the entries pinned by another guard
+        void merge(pin_guard&& o) {
+            _entries.insert(
+              _entries.end(),
+              std::make_move_iterator(o._entries.begin()),
+              std::make_move_iterator(o._entries.end()));
+            o._entries.clear();
+        }
+
+        void release() noexcept {
+            for (auto& e : _entries) {
+                if (e) {
+                    e->unpin();
+                }
+            }
+            _entries.clear();
+        }
+
+    private:
+        friend class batch_cache_index;
+        std::vector<entry_ptr> _entries;
+    };
+
     batch_cache(const reclaim_options& opts)
       : _reclaimer(
         [this](reclaimer::request r) { return reclaim(r); },
@@ -189,21 +281,24 @@ public:
      * and the moved from reclaimer will deregister itself properly.
      */
     batch_cache(batch_cache&& o) noexcept
-      : _lru(std::move(o._lru))
+      : _probation(std::move(o._probation))
+      , _lru(std::move(o._lru))
       , _reclaimer(
           [this](reclaimer::request r) { return reclaim(r); },
           reclaim_scope::sync)
       , _is_reclaiming(o._is_reclaiming)
       , _size_bytes(o._size_bytes)
+      , _protected_bytes(o._protected_bytes)
       , _reclaim_opts(o._reclaim_opts) {
         o._size_bytes = 0;
+        o._protected_bytes = 0;
         o._is_reclaiming = false;
     }
 
     ~batch_cache() noexcept;
 
     /// Returns true if the cache is empty, and false otherwise.
-    bool empty() const { return _lru.empty(); }
+    bool empty() const { return _lru.empty() && _probation.empty(); }
 
     /// Removes all entries from the cache and entry pool.
     void clear() { reclaim(std::numeric_limits<size_t>::max()); }
@@ -234,15 +329,11 @@ public:
     void evict(entry_ptr&& e);
 
     /**
-     * Notify the cache that the specified entry was recently used.
+     * Notify the cache that the specified entry was recently used. A
+     * probationary entry is promoted into the protected segment; a protected
+     * entry moves to the hot end of the protected segment.
      */
-    void touch(entry_ptr& e) {
-        if (e) {
-            auto p = e.get();
-            p->_hook.unlink();
-            _lru.push_back(*p);
-        }
-    }
+    void touch(entry_ptr& e);
 
     /**
      * \brief Evict batches up to the accumulated size specified.
@@ -291,10 +382,28 @@ private:
                               : reclaim_result::reclaimed_nothing;
     }
 
+    /// Largest fraction of the cache the protected segment may occupy
+    /// before its coldest entries are demoted back to probation.
+    static constexpr double max_protected_fraction = 0.80;
+
+    /*
+     * reclaim entries from the given list, coldest first, until the reclaim
+     * target is met. returns the number of bytes reclaimed. fully removed
+     * entries are parked on reclaimed_entries for deferred index removal.
+     */
+    size_t reclaim_from(
+      intrusive_list<entry, &entry::_hook>& list,
+      size_t target,
+      intrusive_list<entry, &entry::_hook>& reclaimed_entries);
+
+    // probationary segment; new entries land here (segmented LRU)
+    intrusive_list<entry, &entry::_hook> _probation;
+    // protected segment; entries that were touched at least once
     intrusive_list<entry, &entry::_hook> _lru;
     reclaimer _reclaimer;
     bool _is_reclaiming{false};
     size_t _size_bytes{0};
+    size_t _protected_bytes{0};
 
     reclaim_options _reclaim_opts;
     ss::lowres_clock::time_point _last_reclaim;
@@ -379,6 +488,16 @@ public:
       size_t max_bytes,
       bool skip_lru_promote);
 
+    /**
+     * \brief Pin the cached batches whose range intersects [begin, end].
+     *
+     * Returns a lease keeping the covered entries out of reach of the
+     * reclaimer until it is released. Batches in the range that are not
+     * cached are simply absent from the lease - pinning is a residency
+     * hint, not a read. Entries cached after the call are not covered.
+     */
+    batch_cache::pin_guard pin(model::offset begin, model::offset end);
+
     /**
      * Removes all batches that _may_ contain the specified offset.
      */
@@ -477,6 +596,10 @@ private:
     bool _locked{false};
     batch_cache* _cache;
     index_type _index;
+    // bytes this index currently holds in the cache; maintained by
+    // batch_cache and used to damp insertions from indexes that hog the
+    // cache (e.g. a replaying partition)
+    size_t _cached_bytes{0};
 
     friend std::ostream& operator<<(std::ostream&, const batch_cache_index&);
 };
@@ -0,0 +1,363 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/batch_header_index.h"
+
+#include "bytes/iobuf_parser.h"
+#include "hashing/xx.h"
+#include "likely.h"
+#include "reflection/adl.h"
+#include "storage/logger.h"
+#include "vassert.h"
+#include "vlog.h"
+
+#include <optional>
+
+namespace storage {
+
+// fixed width of one serialized row across all columns
+static constexpr uint32_t row_width
+  = sizeof(uint32_t)    // header_crc
+    + sizeof(int32_t)   // size_bytes
+    + sizeof(uint32_t)  // relative_offset
+    + sizeof(int8_t)    // type
+    + sizeof(int32_t)   // crc
+    + sizeof(int16_t)   // attrs
+    + sizeof(int32_t)   // last_offset_delta
+    + sizeof(int64_t)   // first_timestamp
+    + sizeof(int64_t)   // max_timestamp
+    + sizeof(int64_t)   // producer_id
+    + sizeof(int16_t)   // producer_epoch
+    + sizeof(int32_t)   // base_sequence
+    + sizeof(int32_t)   // record_count
+    + sizeof(uint32_t); // position
+
+uint64_t batch_header_index::checksum_state(const batch_header_index& r) {
+    auto xx = incremental_xxhash64{};
+    xx.update_all(
+      r.bitflags, r.base_offset(), uint32_t(r.relative_offset_index.size()));
+    const uint32_t vsize = r.relative_offset_index.size();
+    for (auto i = 0U; i < vsize; ++i) {
+        xx.update(r.header_crc_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        xx.update(r.size_bytes_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        xx.update(r.relative_offset_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        xx.update(r.type_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        xx.update(r.crc_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        xx.update(r.attrs_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        xx.update(r.last_offset_delta_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        xx.update(r.first_timestamp_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        xx.update(r.max_timestamp_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        xx.update(r.producer_id_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        xx.update(r.producer_epoch_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        xx.update(r.base_sequence_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        xx.update(r.record_count_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        xx.update(r.position_index[i]);
+    }
+    return xx.digest();
+}
+
+void batch_header_index::add_entry(
+  const model::record_batch_header& hdr, size_t filepos) {
+    vassert(
+      hdr.base_offset >= base_offset,
+      "invalid batch base {} for header index with base {}",
+      hdr.base_offset,
+      base_offset);
+    // We know that a segment cannot be > 4GB
+    header_crc_index.push_back(hdr.header_crc);
+    size_bytes_index.push_back(hdr.size_bytes);
+    relative_offset_index.push_back(hdr.base_offset() - base_offset());
+    type_index.push_back(hdr.type());
+    crc_index.push_back(hdr.crc);
+    attrs_index.push_back(hdr.attrs.value());
+    last_offset_delta_index.push_back(hdr.last_offset_delta);
+    first_timestamp_index.push_back(hdr.first_timestamp());
+    max_timestamp_index.push_back(hdr.max_timestamp());
+    producer_id_index.push_back(hdr.producer_id);
+    producer_epoch_index.push_back(hdr.producer_epoch);
+    base_sequence_index.push_back(hdr.base_sequence);
+    record_count_index.push_back(hdr.record_count);
+    position_index.push_back(filepos);
+}
+
+batch_header_index::entry batch_header_index::get_entry(size_t i) const {
+    model::record_batch_header hdr{
+      .header_crc = header_crc_index[i],
+      .size_bytes = size_bytes_index[i],
+      .base_offset = base_offset + model::offset(relative_offset_index[i]),
+      .type = model::record_batch_type(type_index[i]),
+      .crc = crc_index[i],
+      .attrs = model::record_batch_attributes(attrs_index[i]),
+      .last_offset_delta = last_offset_delta_index[i],
+      .first_timestamp = model::timestamp(first_timestamp_index[i]),
+      .max_timestamp = model::timestamp(max_timestamp_index[i]),
+      .producer_id = producer_id_index[i],
+      .producer_epoch = producer_epoch_index[i],
+      .base_sequence = base_sequence_index[i],
+      .record_count = record_count_index[i]};
+    return entry{
+      .header = hdr,
+      .filepos = position_index[i],
+    };
+}
+
+std::vector<batch_header_index::entry>
+batch_header_index::collect(model::offset from, model::offset to) const {
+    std::vector<entry> retval;
+    const uint32_t vsize = relative_offset_index.size();
+    for (auto i = 0U; i < vsize; ++i) {
+        auto first = base_offset + model::offset(relative_offset_index[i]);
+        auto last = first + model::offset(last_offset_delta_index[i]);
+        if (first <= to && last >= from) {
+            retval.push_back(get_entry(i));
+        }
+    }
+    return retval;
+}
+
+std::optional<batch_header_index::entry> batch_header_index::find_first_timestamp(
+  model::timestamp t, model::offset min, model::offset max) const {
+    const uint32_t vsize = relative_offset_index.size();
+    for (auto i = 0U; i < vsize; ++i) {
+        auto first = base_offset + model::offset(relative_offset_index[i]);
+        if (first < min) {
+            continue;
+        }
+        if (first > max) {
+            break;
+        }
+        if (model::timestamp(first_timestamp_index[i]) >= t) {
+            return get_entry(i);
+        }
+    }
+    return std::nullopt;
+}
+
+bool batch_header_index::truncate(model::offset o) {
+    bool changed = false;
+    // rows are in offset order; drop the suffix of batches starting past o
+    while (!relative_offset_index.empty()
+           && base_offset + model::offset(relative_offset_index.back()) > o) {
+        header_crc_index.pop_back();
+        size_bytes_index.pop_back();
+        relative_offset_index.pop_back();
+        type_index.pop_back();
+        crc_index.pop_back();
+        attrs_index.pop_back();
+        last_offset_delta_index.pop_back();
+        first_timestamp_index.pop_back();
+        max_timestamp_index.pop_back();
+        producer_id_index.pop_back();
+        producer_epoch_index.pop_back();
+        base_sequence_index.pop_back();
+        record_count_index.pop_back();
+        position_index.pop_back();
+        changed = true;
+    }
+    return changed;
+}
+
+std::ostream& operator<<(std::ostream& o, const batch_header_index& s) {
+    return o << "{version:" << (int)s.version << ", header_size:" << s.size
+             << ", header_checksum:" << s.checksum
+             << ", header_bitflags:" << s.bitflags
+             << ", base_offset:" << s.base_offset
+             << ", index(" << s.relative_offset_index.size() << ")}";
+}
+
+std::optional<batch_header_index>
+batch_header_index::hydrate_from_buffer(iobuf b) {
+    iobuf_parser parser(std::move(b));
+    batch_header_index retval;
+    retval.version = reflection::adl<int8_t>{}.from(parser);
+    if (retval.version != 1) {
+        return std::nullopt;
+    }
+    retval.size = reflection::adl<uint32_t>{}.from(parser);
+    retval.checksum = reflection::adl<uint64_t>{}.from(parser);
+    retval.bitflags = reflection::adl<uint32_t>{}.from(parser);
+    retval.base_offset = model::offset(
+      reflection::adl<model::offset::type>{}.from(parser));
+
+    const uint32_t vsize = ss::le_to_cpu(
+      reflection::adl<uint32_t>{}.from(parser));
+    retval.header_crc_index.reserve(vsize);
+    retval.size_bytes_index.reserve(vsize);
+    retval.relative_offset_index.reserve(vsize);
+    retval.type_index.reserve(vsize);
+    retval.crc_index.reserve(vsize);
+    retval.attrs_index.reserve(vsize);
+    retval.last_offset_delta_index.reserve(vsize);
+    retval.first_timestamp_index.reserve(vsize);
+    retval.max_timestamp_index.reserve(vsize);
+    retval.producer_id_index.reserve(vsize);
+    retval.producer_epoch_index.reserve(vsize);
+    retval.base_sequence_index.reserve(vsize);
+    retval.record_count_index.reserve(vsize);
+    retval.position_index.reserve(vsize);
+    for (auto i = 0U; i < vsize; ++i) {
+        retval.header_crc_index.push_back(
+          reflection::adl<uint32_t>{}.from(parser));
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        retval.size_bytes_index.push_back(
+          reflection::adl<int32_t>{}.from(parser));
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        retval.relative_offset_index.push_back(
+          reflection::adl<uint32_t>{}.from(parser));
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        retval.type_index.push_back(reflection::adl<int8_t>{}.from(parser));
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        retval.crc_index.push_back(reflection::adl<int32_t>{}.from(parser));
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        retval.attrs_index.push_back(reflection::adl<int16_t>{}.from(parser));
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        retval.last_offset_delta_index.push_back(
+          reflection::adl<int32_t>{}.from(parser));
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        retval.first_timestamp_index.push_back(
+          reflection::adl<int64_t>{}.from(parser));
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        retval.max_timestamp_index.push_back(
+          reflection::adl<int64_t>{}.from(parser));
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        retval.producer_id_index.push_back(
+          reflection::adl<int64_t>{}.from(parser));
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        retval.producer_epoch_index.push_back(
+          reflection::adl<int16_t>{}.from(parser));
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        retval.base_sequence_index.push_back(
+          reflection::adl<int32_t>{}.from(parser));
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        retval.record_count_index.push_back(
+          reflection::adl<int32_t>{}.from(parser));
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        retval.position_index.push_back(
+          reflection::adl<uint32_t>{}.from(parser));
+    }
+    const auto computed_checksum = batch_header_index::checksum_state(retval);
+    if (unlikely(retval.checksum != computed_checksum)) {
+        vlog(
+          stlog.debug,
+          "Invalid checksum for batch header index. Got:{}, expected:{}",
+          computed_checksum,
+          retval.checksum);
+        return std::nullopt;
+    }
+    return retval;
+}
+
+iobuf batch_header_index::checksum_and_serialize() {
+    iobuf out;
+    vassert(
+      header_crc_index.size() == relative_offset_index.size()
+        && position_index.size() == relative_offset_index.size(),
+      "ALL indexes must match in size. {}",
+      *this);
+    const uint32_t final_size
+      = sizeof(batch_header_index::checksum)
+        + sizeof(batch_header_index::bitflags)
+        + sizeof(batch_header_index::base_offset) + (uint32_t) // index size
+        + (relative_offset_index.size() * row_width);
+    size = final_size;
+    checksum = batch_header_index::checksum_state(*this);
+    reflection::serialize(
+      out,
+      version,
+      size,
+      checksum,
+      bitflags,
+      base_offset(),
+      uint32_t(relative_offset_index.size()));
+    const uint32_t vsize = relative_offset_index.size();
+    for (auto i = 0U; i < vsize; ++i) {
+        reflection::serialize(out, header_crc_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        reflection::serialize(out, size_bytes_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        reflection::serialize(out, relative_offset_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        reflection::serialize(out, type_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        reflection::serialize(out, crc_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        reflection::serialize(out, attrs_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        reflection::serialize(out, last_offset_delta_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        reflection::serialize(out, first_timestamp_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        reflection::serialize(out, max_timestamp_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        reflection::serialize(out, producer_id_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        reflection::serialize(out, producer_epoch_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        reflection::serialize(out, base_sequence_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        reflection::serialize(out, record_count_index[i]);
+    }
+    for (auto i = 0U; i < vsize; ++i) {
+        reflection::serialize(out, position_index[i]);
+    }
+    return out;
+}
+
+} // namespace storage
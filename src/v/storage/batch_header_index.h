@@ -0,0 +1,131 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "bytes/iobuf.h"
+#include "model/fundamental.h"
+#include "model/record.h"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace storage {
+/* Fileformat:
+   1 byte  - version
+   4 bytes - size - does not include the version or size
+   8 bytes - checksum - xxhash64 -- we checksum everything below the checksum
+   4 bytes - bitflags - unused
+   8 bytes - base_offset
+   4 bytes - entry count
+   [] header_crc
+   [] size_bytes
+   [] relative_offset
+   [] type
+   [] crc
+   [] attrs
+   [] last_offset_delta
+   [] first_timestamp
+   [] max_timestamp
+   [] producer_id
+   [] producer_epoch
+   [] base_sequence
+   [] record_count
+   [] position
+
+   Per segment sidecar holding one packed record_batch_header row per
+   batch, plus the batch's physical file position. It lives next to the
+   segment's other indices:
+
+       default/test/0/1-1-v1.log
+       default/test/0/1-1-v1.base_index
+       default/test/0/1-1-v1.header_index
+
+   Metadata only scans - time queries, retention evaluation, offset to
+   file position translation - need the headers of every batch but none
+   of the record data, and headers are roughly one percent of segment
+   bytes. The columnar fixed width layout means such a scan walks a
+   single contiguous array (e.g. the timestamp column) instead of
+   parsing batch framing out of the data file. The same struct-of-arrays
+   and checksum conventions as index_state apply; offsets and file
+   positions are stored relative/32-bit wide under the usual assumption
+   that a segment is smaller than 4GB.
+ */
+struct batch_header_index {
+    /// brief hydrated row: the full header with offsets rebased to
+    /// absolute, and the physical position of the batch in the segment
+    struct entry {
+        model::record_batch_header header;
+        size_t filepos;
+    };
+
+    batch_header_index() = default;
+    batch_header_index(batch_header_index&&) noexcept = default;
+    batch_header_index& operator=(batch_header_index&&) noexcept = default;
+    batch_header_index(const batch_header_index&) = delete;
+    batch_header_index& operator=(const batch_header_index&) = delete;
+    ~batch_header_index() noexcept = default;
+
+    int8_t version{1};
+    /// \brief sizeof the index in bytes
+    uint32_t size{0};
+    /// \brief currently xxhash64
+    uint64_t checksum{0};
+    /// \brief unused
+    uint32_t bitflags{0};
+    // the segment's base offset; entry offsets are relative to it
+    model::offset base_offset{0};
+
+    std::vector<uint32_t> header_crc_index;
+    std::vector<int32_t> size_bytes_index;
+    std::vector<uint32_t> relative_offset_index;
+    std::vector<int8_t> type_index;
+    std::vector<int32_t> crc_index;
+    std::vector<int16_t> attrs_index;
+    std::vector<int32_t> last_offset_delta_index;
+    std::vector<int64_t> first_timestamp_index;
+    std::vector<int64_t> max_timestamp_index;
+    std::vector<int64_t> producer_id_index;
+    std::vector<int16_t> producer_epoch_index;
+    std::vector<int32_t> base_sequence_index;
+    std::vector<int32_t> record_count_index;
+    std::vector<uint32_t> position_index;
+
+    bool empty() const { return relative_offset_index.empty(); }
+    size_t entries() const { return relative_offset_index.size(); }
+
+    void add_entry(const model::record_batch_header&, size_t filepos);
+
+    entry get_entry(size_t i) const;
+
+    /// rows whose batch offset range overlaps [from, to], in index order
+    std::vector<entry> collect(model::offset from, model::offset to) const;
+
+    /// first row with base offset in [min, max] and first_timestamp >= t,
+    /// matching the filtering a timequery reader applies while scanning
+    /// batch data. linear walk of the timestamp column: timestamps are
+    /// client supplied and not guaranteed monotonic
+    std::optional<entry> find_first_timestamp(
+      model::timestamp t, model::offset min, model::offset max) const;
+
+    /// drops rows of batches that start above the truncation offset.
+    /// returns true when anything was removed
+    bool truncate(model::offset o);
+
+    iobuf checksum_and_serialize();
+
+    static std::optional<batch_header_index> hydrate_from_buffer(iobuf);
+    static uint64_t checksum_state(const batch_header_index&);
+    friend std::ostream& operator<<(std::ostream&, const batch_header_index&);
+};
+
+} // namespace storage
@@ -0,0 +1,160 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/chunk_cache.h"
+
+#include "config/configuration.h"
+#include "prometheus/prometheus_sanitize.h"
+#include "resource_mgmt/io_priority.h"
+#include "resource_mgmt/memory_groups.h"
+#include "storage/logger.h"
+#include "vlog.h"
+
+#include <seastar/core/loop.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics.hh>
+
+#include <boost/iterator/counting_iterator.hpp>
+
+#include <chrono>
+
+namespace storage::internal {
+
+chunk_cache::chunk_cache() noexcept
+  : _size_target(memory_groups::chunk_cache_min_memory())
+  , _size_limit(memory_groups::chunk_cache_max_memory())
+  , _size_reserve(_size_target / 8) {}
+
+ss::future<> chunk_cache::start() {
+    setup_metrics();
+    /*
+     * pre-populate the cache up to the memory group minimum. the chunk
+     * constructor zeroes its buffer which also pre-faults the pages while the
+     * reactor thread runs on its home cpu, so with seastar's per-shard memory
+     * binding the dma buffers end up resident on the local NUMA node.
+     */
+    const auto num_chunks = memory_groups::chunk_cache_min_memory()
+                            / chunk::chunk_size;
+    return ss::do_for_each(
+      boost::counting_iterator<size_t>(0),
+      boost::counting_iterator<size_t>(num_chunks),
+      [this](size_t) {
+          auto c = ss::make_lw_shared<chunk>(alignment);
+          _size_total += chunk::chunk_size;
+          add(c);
+      });
+}
+
+void chunk_cache::add(const chunk_ptr& chunk) {
+    if (_size_available >= _size_target) {
+        _size_total -= chunk::chunk_size;
+        return;
+    }
+    _chunks.push_back(chunk);
+    _size_available += chunk::chunk_size;
+    if (_sem.waiters()) {
+        _sem.signal();
+    }
+}
+
+ss::future<chunk_cache::chunk_ptr> chunk_cache::get() {
+    return do_get(false);
+}
+
+ss::future<chunk_cache::chunk_ptr>
+chunk_cache::get(const ss::io_priority_class& pc) {
+    const bool may_use_reserve = pc.id() == raft_priority().id()
+                                 || pc.id() == controller_priority().id();
+    return do_get(may_use_reserve);
+}
+
+ss::future<chunk_cache::chunk_ptr> chunk_cache::do_get(bool may_use_reserve) {
+    // don't steal if there are waiters
+    if (!_sem.waiters()) {
+        if (auto c = pop_or_allocate(may_use_reserve); c) {
+            return ss::make_ready_future<chunk_ptr>(c);
+        }
+    }
+    const auto start = ss::lowres_clock::now();
+    ++_num_waits;
+    return wait_and_get(may_use_reserve).then([this, start](chunk_ptr c) {
+        _wait_time_us += std::chrono::duration_cast<std::chrono::microseconds>(
+                           ss::lowres_clock::now() - start)
+                           .count();
+        return c;
+    });
+}
+
+ss::future<chunk_cache::chunk_ptr>
+chunk_cache::wait_and_get(bool may_use_reserve) {
+    return ss::get_units(_sem, 1).then(
+      [this, may_use_reserve](ss::semaphore_units<>) {
+          if (auto c = pop_or_allocate(may_use_reserve); c) {
+              return ss::make_ready_future<chunk_ptr>(c);
+          }
+          return wait_and_get(may_use_reserve);
+      });
+}
+
+chunk_cache::chunk_ptr chunk_cache::pop_or_allocate(bool may_use_reserve) {
+    // bulk appenders may not drain the reserve held for internal appends
+    const size_t floor = may_use_reserve ? 0 : _size_reserve;
+    if (!_chunks.empty() && _size_available > floor) {
+        auto c = _chunks.front();
+        _chunks.pop_front();
+        _size_available -= chunk::chunk_size;
+        c->reset();
+        return c;
+    }
+    if (_size_total < _size_limit) {
+        try {
+            auto c = ss::make_lw_shared<chunk>(alignment);
+            _size_total += chunk::chunk_size;
+            return c;
+        } catch (const std::bad_alloc& e) {
+            vlog(stlog.debug, "chunk allocation failed: {}", e);
+        }
+    }
+    return nullptr;
+}
+
+void chunk_cache::setup_metrics() {
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+    namespace sm = ss::metrics;
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("storage:chunk_cache"),
+      {
+        sm::make_gauge(
+          "available_bytes",
+          [this] { return _size_available; },
+          sm::description("Amount of chunk memory on the free list")),
+        sm::make_gauge(
+          "total_bytes",
+          [this] { return _size_total; },
+          sm::description("Total amount of chunk memory allocated")),
+        sm::make_derive(
+          "waits",
+          [this] { return _num_waits; },
+          sm::description("Number of chunk requests that had to wait")),
+        sm::make_derive(
+          "wait_time_us",
+          [this] { return _wait_time_us; },
+          sm::description(
+            "Cumulative time in microseconds spent waiting for chunks")),
+      });
+}
+
+chunk_cache& chunks() {
+    static thread_local chunk_cache cache;
+    return cache;
+}
+
+} // namespace storage::internal
@@ -1,18 +1,12 @@
 #pragma once
-#include "resource_mgmt/memory_groups.h"
 #include "seastarx.h"
-#include "storage/logger.h"
 #include "storage/segment_appender_chunk.h"
-#include "vassert.h"
-#include "vlog.h"
+#include "units.h"
 
 #include <seastar/core/chunked_fifo.hh>
 #include <seastar/core/future.hh>
-#include <seastar/core/loop.hh>
+#include <seastar/core/metrics_registration.hh>
 #include <seastar/core/semaphore.hh>
-#include <seastar/util/later.hh>
-
-#include <boost/iterator/counting_iterator.hpp>
 
 namespace storage::internal {
 
@@ -30,9 +24,7 @@ public:
      */
     static constexpr const size_t alignment = 4_KiB;
 
-    chunk_cache() noexcept
-      : _size_target(memory_groups::chunk_cache_min_memory())
-      , _size_limit(memory_groups::chunk_cache_max_memory()) {}
+    chunk_cache() noexcept;
 
     chunk_cache(chunk_cache&&) = delete;
     chunk_cache& operator=(chunk_cache&&) = delete;
@@ -40,80 +32,61 @@ public:
     chunk_cache& operator=(const chunk_cache&) = delete;
     ~chunk_cache() noexcept = default;
 
-    ss::future<> start() {
-        const auto num_chunks = memory_groups::chunk_cache_min_memory()
-                                / chunk::chunk_size;
-        return ss::do_for_each(
-          boost::counting_iterator<size_t>(0),
-          boost::counting_iterator<size_t>(num_chunks),
-          [this](size_t) {
-              auto c = ss::make_lw_shared<chunk>(alignment);
-              _size_total += chunk::chunk_size;
-              add(c);
-          });
-    }
+    ss::future<> start();
 
-    void add(const chunk_ptr& chunk) {
-        if (_size_available >= _size_target) {
-            _size_total -= chunk::chunk_size;
-            return;
-        }
-        _chunks.push_back(chunk);
-        _size_available += chunk::chunk_size;
-        if (_sem.waiters()) {
-            _sem.signal();
-        }
-    }
+    void add(const chunk_ptr& chunk);
 
-    ss::future<chunk_ptr> get() {
-        // don't steal if there are waiters
-        if (!_sem.waiters()) {
-            return do_get();
-        }
-        return ss::get_units(_sem, 1).then(
-          [this](ss::semaphore_units<>) { return do_get(); });
-    }
+    /// \brief obtain a chunk for a bulk (e.g. kafka produce) appender.
+    ss::future<chunk_ptr> get();
 
-private:
-    ss::future<chunk_ptr> do_get() {
-        if (auto c = pop_or_allocate(); c) {
-            return ss::make_ready_future<chunk_ptr>(c);
-        }
-        return ss::get_units(_sem, 1).then(
-          [this](ss::semaphore_units<>) { return do_get(); });
-    }
+    /**
+     * \brief obtain a chunk for an appender writing with the given io
+     * priority.
+     *
+     * appenders running at the raft or controller io priority may dip into a
+     * small reserve of the free list so that internal appends cannot be
+     * starved by a burst of bulk produce traffic exhausting the cache.
+     */
+    ss::future<chunk_ptr> get(const ss::io_priority_class&);
 
-    chunk_ptr pop_or_allocate() {
-        if (!_chunks.empty()) {
-            auto c = _chunks.front();
-            _chunks.pop_front();
-            _size_available -= chunk::chunk_size;
-            c->reset();
-            return c;
-        }
-        if (_size_total < _size_limit) {
-            try {
-                auto c = ss::make_lw_shared<chunk>(alignment);
-                _size_total += chunk::chunk_size;
-                return c;
-            } catch (const std::bad_alloc& e) {
-                vlog(stlog.debug, "chunk allocation failed: {}", e);
-            }
+    /**
+     * \brief fraction of the cache's target working set held by appenders.
+     *
+     * a chunk stays checked out while the writes behind it are in flight,
+     * so free list depletion is a shard level proxy for the depth of the
+     * segment append pipeline.
+     */
+    double utilization() const {
+        if (_size_target == 0) {
+            return 0.0;
         }
-        return nullptr;
+        const auto held = _size_total - std::min(_size_available, _size_total);
+        return std::min(double(held) / double(_size_target), 1.0);
     }
 
+    /// appenders currently blocked waiting for a free chunk
+    size_t waiters() const { return _sem.waiters(); }
+
+private:
+    ss::future<chunk_ptr> do_get(bool may_use_reserve);
+    ss::future<chunk_ptr> wait_and_get(bool may_use_reserve);
+    chunk_ptr pop_or_allocate(bool may_use_reserve);
+    void setup_metrics();
+
     ss::chunked_fifo<chunk_ptr> _chunks;
     ss::semaphore _sem{0};
     size_t _size_available{0};
     size_t _size_total{0};
     const size_t _size_target;
     const size_t _size_limit;
+    // portion of the free list only raft/controller appenders may consume
+    const size_t _size_reserve;
+    // wait accounting for the cache metrics
+    uint64_t _num_waits{0};
+    uint64_t _wait_time_us{0};
+    ss::metrics::metric_groups _metrics;
 };
 
-inline chunk_cache& chunks() {
-    static thread_local chunk_cache cache;
-    return cache;
-}
+chunk_cache& chunks();
 
 } // namespace storage::internal
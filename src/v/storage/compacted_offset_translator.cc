@@ -0,0 +1,131 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/compacted_offset_translator.h"
+
+#include <algorithm>
+
+namespace storage::internal {
+
+compacted_offset_translator::compacted_offset_translator(
+  model::offset base, const Roaring& to_keep)
+  : _base(base) {
+    // roaring iteration is sorted ascending; coalesce consecutive
+    // offsets into runs
+    for (const uint32_t relative : to_keep) {
+        if (
+          !_runs.empty()
+          && relative == _runs.back().first + _runs.back().len) {
+            ++_runs.back().len;
+        } else {
+            _runs.push_back(run{
+              .first = relative,
+              .dense_first = uint32_t(_size),
+              .len = 1,
+            });
+        }
+        ++_size;
+    }
+}
+
+std::optional<size_t>
+compacted_offset_translator::find_run(uint32_t relative) const {
+    auto it = std::upper_bound(
+      _runs.begin(),
+      _runs.end(),
+      relative,
+      [](uint32_t needle, const run& r) { return needle < r.first; });
+    if (it == _runs.begin()) {
+        return std::nullopt;
+    }
+    --it;
+    if (relative >= it->first + it->len) {
+        return std::nullopt;
+    }
+    return std::distance(_runs.begin(), it);
+}
+
+std::optional<model::offset>
+compacted_offset_translator::to_dense(model::offset o) const {
+    if (o < _base) {
+        return std::nullopt;
+    }
+    const uint32_t relative = (o - _base)();
+    auto ix = find_run(relative);
+    if (!ix) {
+        return std::nullopt;
+    }
+    const run& r = _runs[*ix];
+    return model::offset(r.dense_first + (relative - r.first));
+}
+
+std::optional<model::offset>
+compacted_offset_translator::from_dense(model::offset d) const {
+    if (d < model::offset(0) || size_t(d()) >= _size) {
+        return std::nullopt;
+    }
+    const uint32_t dense = d();
+    auto it = std::upper_bound(
+      _runs.begin(),
+      _runs.end(),
+      dense,
+      [](uint32_t needle, const run& r) { return needle < r.dense_first; });
+    --it; // dense < _size guarantees a containing run
+    return _base + model::offset(it->first + (dense - it->dense_first));
+}
+
+std::optional<std::pair<model::offset, model::offset>>
+compacted_offset_translator::to_dense_range(
+  model::offset from, model::offset to) const {
+    if (_size == 0 || to < from) {
+        return std::nullopt;
+    }
+    // clamp the lower bound up to the first kept offset at or after it
+    const uint32_t rel_from = from <= _base ? 0 : (from - _base)();
+    auto it = std::upper_bound(
+      _runs.begin(),
+      _runs.end(),
+      rel_from,
+      [](uint32_t needle, const run& r) { return needle < r.first; });
+    uint32_t dense_from;
+    if (
+      it != _runs.begin()
+      && rel_from < std::prev(it)->first + std::prev(it)->len) {
+        const run& r = *std::prev(it);
+        dense_from = r.dense_first + (rel_from - r.first);
+    } else if (it != _runs.end()) {
+        dense_from = it->dense_first;
+    } else {
+        return std::nullopt;
+    }
+    // clamp the upper bound down to the last kept offset at or before it
+    auto dense_to = to_dense(to);
+    if (!dense_to) {
+        if (to < _base) {
+            return std::nullopt;
+        }
+        const uint32_t rel_to = (to - _base)();
+        auto jt = std::upper_bound(
+          _runs.begin(),
+          _runs.end(),
+          rel_to,
+          [](uint32_t needle, const run& r) { return needle < r.first; });
+        if (jt == _runs.begin()) {
+            return std::nullopt;
+        }
+        const run& r = *std::prev(jt);
+        dense_to = model::offset(r.dense_first + r.len - 1);
+    }
+    if (model::offset(dense_from) > *dense_to) {
+        return std::nullopt;
+    }
+    return std::make_pair(model::offset(dense_from), *dense_to);
+}
+
+} // namespace storage::internal
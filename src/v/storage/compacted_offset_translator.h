@@ -0,0 +1,77 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/fundamental.h"
+
+#include <roaring/roaring.hh>
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace storage::internal {
+
+/**
+ * Translation between the gapped offset space of a compacted segment and
+ * the dense offset space seen by consumers that cannot tolerate gaps.
+ *
+ * The kept offsets are delta run-length encoded: one run per stretch of
+ * consecutive surviving offsets, carrying the run's first gapped offset
+ * and the dense index of its first element. Compaction keeps the latest
+ * record per key, so surviving offsets cluster into long runs and the
+ * encoding stays tiny even for segments with millions of records. Both
+ * directions are a single binary search over the runs, and a whole fetch
+ * range translates with two lookups instead of one per record.
+ */
+class compacted_offset_translator {
+public:
+    compacted_offset_translator(model::offset base, const Roaring& to_keep);
+
+    /// gapped offset of a kept record -> dense offset; nullopt when the
+    /// record was compacted away
+    std::optional<model::offset> to_dense(model::offset) const;
+
+    /// dense offset -> gapped offset; nullopt when past the end
+    std::optional<model::offset> from_dense(model::offset) const;
+
+    /**
+     * Translate a whole gapped fetch range in one shot: the bounds are
+     * clamped inward to the nearest kept offsets and both translated with
+     * one binary search each. nullopt when no kept offset falls within
+     * [from, to].
+     */
+    std::optional<std::pair<model::offset, model::offset>>
+    to_dense_range(model::offset from, model::offset to) const;
+
+    /// number of kept offsets
+    size_t size() const { return _size; }
+    /// number of runs in the encoding
+    size_t runs() const { return _runs.size(); }
+
+private:
+    struct run {
+        uint32_t first; // relative to _base
+        uint32_t dense_first;
+        uint32_t len;
+    };
+
+    // index of the run containing the relative offset, or nullopt when
+    // the offset falls in a gap or outside the encoded range
+    std::optional<size_t> find_run(uint32_t relative) const;
+
+    model::offset _base;
+    std::vector<run> _runs;
+    size_t _size{0};
+};
+
+} // namespace storage::internal
@@ -29,10 +29,29 @@
 
 namespace storage::internal {
 
+ss::future<ss::stop_iteration>
+key_duplicate_filter_reducer::operator()(compacted_index::entry&& e) {
+    auto key = bytes_view(e.key);
+    if (_seen.maybe_contains(key)) {
+        _duplicates.add(key);
+    } else {
+        _seen.add(key);
+    }
+    return ss::make_ready_future<ss::stop_iteration>(ss::stop_iteration::no);
+}
+
 ss::future<ss::stop_iteration>
 compaction_key_reducer::operator()(compacted_index::entry&& e) {
     using stop_t = ss::stop_iteration;
     const model::offset o = e.offset + model::offset(e.delta);
+    if (_duplicates && !_duplicates->maybe_contains(bytes_view(e.key))) {
+        // the key occurs exactly once in the index, so this entry is
+        // trivially the latest version - keep it without paying for a map
+        // entry
+        _inverted.add(_natural_index);
+        ++_natural_index;
+        return ss::make_ready_future<stop_t>(stop_t::no);
+    }
     auto f = ss::now();
     auto it = _indices.find(e.key);
     if (it != _indices.end()) {
@@ -111,17 +130,28 @@ compacted_offset_list_reducer::operator()(compacted_index::entry&& e) {
     return ss::make_ready_future<stop_t>(stop_t::no);
 }
 
+ss::future<ss::stop_iteration>
+offset_translator_reducer::operator()(compacted_index::entry&& e) {
+    using stop_t = ss::stop_iteration;
+    const model::offset o = e.offset + model::offset(e.delta);
+    _to_keep.add(uint32_t((o - _base)()));
+    return ss::make_ready_future<stop_t>(stop_t::no);
+}
+
 std::optional<model::record_batch>
 copy_data_segment_reducer::filter(model::record_batch&& batch) {
     // 1. compute which records to keep
     const auto base = batch.base_offset();
     std::vector<int32_t> offset_deltas;
     offset_deltas.reserve(batch.record_count());
-    batch.for_each_record([this, base, &offset_deltas](const model::record& r) {
-        if (should_keep(base, r.offset_delta())) {
-            offset_deltas.push_back(r.offset_delta());
-        }
-    });
+    // only offsets are needed in this pass, values and headers stay
+    // serialized
+    batch.for_each_record_view(
+      [this, base, &offset_deltas](const model::record_view& r) {
+          if (should_keep(base, r.offset_delta())) {
+              offset_deltas.push_back(r.offset_delta());
+          }
+      });
 
     // 2. no record to keep
     if (offset_deltas.empty()) {
@@ -218,6 +248,34 @@ copy_data_segment_reducer::filter(model::record_batch&& batch) {
       h, std::move(ret), model::record_batch::tag_ctor_ng{});
     return new_batch;
 }
+ss::future<ss::stop_iteration>
+copy_data_segment_reducer::append(model::record_batch&& b) {
+    using stop_t = ss::stop_iteration;
+    return ss::do_with(std::move(b), [this](model::record_batch& batch) {
+        auto const start_offset = _appender->file_byte_offset();
+        auto const header_size = batch.header().size_bytes;
+        _acc += header_size;
+        if (_idx.maybe_index(
+              _acc,
+              32_KiB,
+              start_offset,
+              batch.base_offset(),
+              batch.last_offset(),
+              batch.header().first_timestamp,
+              batch.header().max_timestamp)) {
+            _acc = 0;
+        }
+        return storage::write(*_appender, batch)
+          .then([this, start_offset, header_size] {
+              vassert(
+                _appender->file_byte_offset() == start_offset + header_size,
+                "Size must be deterministic. Expected:{} == {}",
+                _appender->file_byte_offset(),
+                start_offset + header_size);
+          });
+    }).then([] { return ss::make_ready_future<stop_t>(stop_t::no); });
+}
+
 ss::future<ss::stop_iteration> copy_data_segment_reducer::do_compaction(
   model::compression original, model::record_batch&& b) {
     using stop_t = ss::stop_iteration;
@@ -226,37 +284,16 @@ ss::future<ss::stop_iteration> copy_data_segment_reducer::do_compaction(
         return ss::make_ready_future<stop_t>(stop_t::no);
     }
     return compress_batch(original, std::move(to_copy.value()))
-      .then([this](model::record_batch&& b) {
-          return ss::do_with(std::move(b), [this](model::record_batch& batch) {
-              auto const start_offset = _appender->file_byte_offset();
-              auto const header_size = batch.header().size_bytes;
-              _acc += header_size;
-              if (_idx.maybe_index(
-                    _acc,
-                    32_KiB,
-                    start_offset,
-                    batch.base_offset(),
-                    batch.last_offset(),
-                    batch.header().first_timestamp,
-                    batch.header().max_timestamp)) {
-                  _acc = 0;
-              }
-              return storage::write(*_appender, batch)
-                .then([this, start_offset, header_size] {
-                    vassert(
-                      _appender->file_byte_offset()
-                        == start_offset + header_size,
-                      "Size must be deterministic. Expected:{} == {}",
-                      _appender->file_byte_offset(),
-                      start_offset + header_size);
-                });
-          });
-      })
-      .then([] { return ss::make_ready_future<stop_t>(stop_t::no); });
+      .then([this](model::record_batch&& b) { return append(std::move(b)); });
 }
 
 ss::future<ss::stop_iteration>
 copy_data_segment_reducer::operator()(model::record_batch&& b) {
+    if (!_list) {
+        // unfiltered rewrite - every batch survives byte for byte, so there
+        // is no reason to cycle it through the codec
+        return append(std::move(b));
+    }
     const auto comp = b.header().attrs.compression();
     if (!b.compressed()) {
         return do_compaction(comp, std::move(b));
@@ -274,18 +311,21 @@ index_rebuilder_reducer::operator()(model::record_batch&& b) {
     if (!b.compressed()) {
         f = do_index(std::move(b));
     } else {
-        f = internal::decompress_batch(std::move(b))
-              .then([this](model::record_batch&& b) {
-                  return do_index(std::move(b));
-              });
+        // stream records out of the compressed payload instead of inflating
+        // the whole batch before indexing
+        auto o = b.base_offset();
+        f = internal::for_each_decompressed_record(
+          std::move(b), [this, o](model::record r) {
+              return _w->index(r.key(), o, r.offset_delta());
+          });
     }
     return f.then([] { return ss::make_ready_future<stop_t>(stop_t::no); });
 }
 
 ss::future<> index_rebuilder_reducer::do_index(model::record_batch&& b) {
     return ss::do_with(std::move(b), [this](model::record_batch& b) {
-        return model::for_each_record(
-          b, [this, o = b.base_offset()](model::record& r) {
+        return model::for_each_record_view(
+          b, [this, o = b.base_offset()](model::record_view r) {
               return _w->index(r.key(), o, r.offset_delta());
           });
     });
@@ -15,10 +15,12 @@
 #include "storage/compacted_index.h"
 #include "storage/compacted_index_writer.h"
 #include "storage/compacted_offset_list.h"
+#include "storage/compacted_offset_translator.h"
 #include "storage/index_state.h"
 #include "storage/logger.h"
 #include "storage/segment_appender.h"
 #include "units.h"
+#include "utils/bloom_filter.h"
 
 #include <absl/container/btree_map.h>
 #include <absl/container/node_hash_map.h>
@@ -29,6 +31,25 @@ namespace storage::internal {
 
 struct compaction_reducer {};
 
+/// First pass of the two-tier key index. Builds a bloom filter of the keys
+/// that occur more than once in the index, so the exact (and expensive)
+/// key map in compaction_key_reducer only ever sees duplicate candidates.
+/// A key flagged here may be a false positive; a key not flagged is
+/// guaranteed to occur exactly once.
+class key_duplicate_filter_reducer : public compaction_reducer {
+public:
+    explicit key_duplicate_filter_reducer(size_t expected_keys)
+      : _seen(expected_keys)
+      , _duplicates(expected_keys) {}
+
+    ss::future<ss::stop_iteration> operator()(compacted_index::entry&&);
+    bloom_filter end_of_stream() { return std::move(_duplicates); }
+
+private:
+    bloom_filter _seen;
+    bloom_filter _duplicates;
+};
+
 class compaction_key_reducer : public compaction_reducer {
 public:
     static constexpr const size_t default_max_memory_usage = 5_MiB;
@@ -42,8 +63,11 @@ public:
     using underlying_t
       = absl::node_hash_map<bytes, value_type, bytes_type_hash, bytes_type_eq>;
 
-    explicit compaction_key_reducer(size_t max_mem = default_max_memory_usage)
-      : _max_mem(max_mem) {}
+    explicit compaction_key_reducer(
+      size_t max_mem = default_max_memory_usage,
+      std::optional<bloom_filter> duplicates = std::nullopt)
+      : _duplicates(std::move(duplicates))
+      , _max_mem(max_mem) {}
 
     ss::future<ss::stop_iteration> operator()(compacted_index::entry&&);
     Roaring end_of_stream();
@@ -56,6 +80,9 @@ private:
     }
     Roaring _inverted;
     underlying_t _indices;
+    // keys that occur once in the index never enter _indices when the
+    // duplicate-candidate filter is present
+    std::optional<bloom_filter> _duplicates;
     size_t _keys_mem_usage{0};
     size_t _max_mem{0};
     uint32_t _natural_index{0};
@@ -90,9 +117,31 @@ private:
     compacted_offset_list _list;
 };
 
+/// Builds the dense offset translation for a compacted segment from the
+/// same entry stream that produces the compacted offset list.
+class offset_translator_reducer : public compaction_reducer {
+public:
+    explicit offset_translator_reducer(model::offset base)
+      : _base(base) {}
+
+    ss::future<ss::stop_iteration> operator()(compacted_index::entry&&);
+    compacted_offset_translator end_of_stream() {
+        return compacted_offset_translator(_base, _to_keep);
+    }
+
+private:
+    model::offset _base;
+    Roaring _to_keep;
+};
+
+/// Copies batches from a reader into an appender, rebuilding the offset
+/// index as it goes. With an offset list it drops the records compaction
+/// deduplicated; without one (std::nullopt) it is a byte-for-byte rewrite
+/// used by the segment format upgrader.
 class copy_data_segment_reducer : public compaction_reducer {
 public:
-    copy_data_segment_reducer(compacted_offset_list l, segment_appender* a)
+    copy_data_segment_reducer(
+      std::optional<compacted_offset_list> l, segment_appender* a)
       : _list(std::move(l))
       , _appender(a) {}
 
@@ -100,16 +149,17 @@ public:
     storage::index_state end_of_stream() { return std::move(_idx); }
 
 private:
+    ss::future<ss::stop_iteration> append(model::record_batch&&);
     ss::future<ss::stop_iteration>
     do_compaction(model::compression, model::record_batch&&);
 
     bool should_keep(model::offset base, int32_t delta) const {
         const auto o = base + model::offset(delta);
-        return _list.contains(o);
+        return _list->contains(o);
     }
     std::optional<model::record_batch> filter(model::record_batch&&);
 
-    compacted_offset_list _list;
+    std::optional<compacted_offset_list> _list;
     segment_appender* _appender;
     index_state _idx;
     size_t _acc{0};
@@ -0,0 +1,72 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/dirsync_coordinator.h"
+
+#include <seastar/core/future-util.hh>
+#include <seastar/core/seastar.hh>
+
+#include <vector>
+
+namespace storage::internal {
+
+dirsync_coordinator::dirsync_coordinator()
+  : _sync([](const ss::sstring& dir) { return ss::sync_directory(dir); }) {}
+
+ss::future<> dirsync_coordinator::sync(ss::sstring dir) {
+    if (_gate.is_closed()) {
+        // shutting down, no more batching, execute directly
+        return _sync(dir);
+    }
+    if (!_next) {
+        _next = std::make_unique<round>();
+    }
+    _next->dirs.emplace(std::move(dir));
+    auto fut = _next->done.get_shared_future();
+    if (!_in_progress) {
+        dispatch_round();
+    }
+    return fut;
+}
+
+void dirsync_coordinator::dispatch_round() {
+    if (!_next) {
+        _in_progress = false;
+        _gate.leave();
+        return;
+    }
+    if (!_in_progress) {
+        // the round chain holds a single gate unit until it drains so
+        // stop() waits for queued rounds and their waiters
+        _gate.enter();
+        _in_progress = true;
+    }
+    auto r = std::move(_next);
+    std::vector<ss::future<>> syncs;
+    syncs.reserve(r->dirs.size());
+    for (auto& dir : r->dirs) {
+        syncs.push_back(_sync(dir));
+    }
+    (void)ss::when_all_succeed(syncs.begin(), syncs.end())
+      .then_wrapped([this, r = std::move(r)](ss::future<> f) {
+          if (f.failed()) {
+              r->done.set_exception(f.get_exception());
+          } else {
+              r->done.set_value();
+          }
+          dispatch_round();
+      });
+}
+
+dirsync_coordinator& dir_syncer() {
+    static thread_local dirsync_coordinator coordinator;
+    return coordinator;
+}
+
+} // namespace storage::internal
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/shared_future.hh>
+#include <seastar/core/sstring.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include <absl/container/flat_hash_set.h>
+
+#include <memory>
+
+namespace storage::internal {
+
+/**
+ * Shard level coalescer for directory durability.
+ *
+ * Making a created, renamed or removed directory entry durable requires an
+ * fsync of the parent directory. During topic creation bursts and heavy
+ * segment rolling many files appear in a short window and every directory
+ * fsync is another serialized metadata round trip to the device. The
+ * coordinator applies the flush_coordinator group-commit scheme to this
+ * metadata io: while one round of syncs is on the device new requests
+ * queue into the next round, requests for the same directory collapse
+ * into a single fsync, distinct directories are submitted concurrently,
+ * and all waiters of a round are acked together when it settles. Since
+ * all logs share a mountpoint the journal commit forced by the first sync
+ * of a round typically makes the rest of it cheap.
+ */
+class dirsync_coordinator {
+public:
+    using sync_func
+      = ss::noncopyable_function<ss::future<>(const ss::sstring&)>;
+
+    dirsync_coordinator();
+    // for testing: inject the per directory sync operation
+    explicit dirsync_coordinator(sync_func f)
+      : _sync(std::move(f)) {}
+
+    /**
+     * Makes the entries of the given directory durable. If the directory
+     * is already queued in the upcoming round the request shares its
+     * fsync. Resolves when the round containing the request settled,
+     * fails with the round's error if any sync in it failed.
+     */
+    ss::future<> sync(ss::sstring dir);
+
+    ss::future<> stop() { return _gate.close(); }
+
+private:
+    struct round {
+        absl::flat_hash_set<ss::sstring> dirs;
+        ss::shared_promise<> done;
+    };
+
+    void dispatch_round();
+
+    sync_func _sync;
+    std::unique_ptr<round> _next;
+    bool _in_progress{false};
+    ss::gate _gate;
+};
+
+/// shard local instance shared by all storage activity
+dirsync_coordinator& dir_syncer();
+
+} // namespace storage::internal
@@ -13,7 +13,10 @@
 #include "model/fundamental.h"
 #include "model/timeout_clock.h"
 #include "reflection/adl.h"
+#include "resource_mgmt/io_priority.h"
+#include "storage/dirsync_coordinator.h"
 #include "storage/disk_log_appender.h"
+#include "storage/fs_utils.h"
 #include "storage/log_manager.h"
 #include "storage/logger.h"
 #include "storage/offset_assignment.h"
@@ -35,6 +38,7 @@
 
 #include <fmt/format.h>
 
+#include <filesystem>
 #include <iterator>
 
 namespace storage {
@@ -64,6 +68,12 @@ disk_log_impl::~disk_log_impl() {
 ss::future<> disk_log_impl::remove() {
     vassert(!_closed, "Invalid double closing of log - {}", *this);
     _closed = true;
+    return _roll_ahead_gate.close()
+      .then([this] { return evict_parked_readers(); })
+      .then([this] { return do_remove(); });
+}
+
+ss::future<> disk_log_impl::do_remove() {
     // gets all the futures started in the background
     std::vector<ss::future<>> permanent_delete;
     permanent_delete.reserve(_segs.size());
@@ -79,6 +89,10 @@ ss::future<> disk_log_impl::remove() {
       .then([this]() {
           vlog(stlog.info, "Finished removing all segments:{}", config());
       })
+      .then([this] {
+          // the ntp directory is removed after us and must be empty
+          return remove_staged_roll_files();
+      })
       .then([this] {
           return _kvstore.remove(
             kvstore::key_space::storage,
@@ -93,11 +107,34 @@ ss::future<> disk_log_impl::close() {
       && !_eviction_monitor->promise.get_future().available()) {
         _eviction_monitor->promise.set_exception(segment_closed_exception());
     }
-    return ss::parallel_for_each(_segs, [](ss::lw_shared_ptr<segment>& h) {
-        return h->close().handle_exception([h](std::exception_ptr e) {
-            vlog(stlog.error, "Error closing segment:{} - {}", e, h);
-        });
-    });
+    // record the last segment so a clean restart can skip checksum replay
+    auto top_segment = _segs.empty() ? ss::lw_shared_ptr<segment>(nullptr)
+                                     : _segs.back();
+    return _roll_ahead_gate.close()
+      .then([this] { return evict_parked_readers(); })
+      .then([this] {
+          return ss::parallel_for_each(
+            _segs, [](ss::lw_shared_ptr<segment>& h) {
+                return h->close().handle_exception(
+                  [h](std::exception_ptr e) {
+                      vlog(stlog.error, "Error closing segment:{} - {}", e, h);
+                  });
+            });
+      })
+      .then([this, top_segment]() {
+          if (!top_segment) {
+              return ss::now();
+          }
+          auto filename = std::filesystem::path(
+                            top_segment->reader().filename())
+                            .filename()
+                            .string();
+          return _kvstore.put(
+            kvstore::key_space::storage,
+            internal::clean_segment_key(config().ntp()),
+            reflection::to_iobuf(
+              internal::clean_segment_value{.segment_name = filename}));
+      });
 }
 
 model::offset disk_log_impl::size_based_gc_max_offset(size_t max_size) {
@@ -131,20 +168,20 @@ model::offset disk_log_impl::time_based_gc_max_offset(model::timestamp time) {
     // files so that size-based retention eventually evicts the problematic
     // segment, preventing a crash.
     //
-    auto it = std::find_if(
-      std::cbegin(_segs),
-      std::cend(_segs),
-      [time](const ss::lw_shared_ptr<segment>& s) {
-          // first that is not going to be collected
-          return s->index().max_timestamp() > time;
-      });
+    // walk the flat max-timestamp level of the segment set looking for the
+    // first segment that is not going to be collected. the loop stops at
+    // the first segment young enough to keep, so a housekeeping cycle costs
+    // O(segments to delete) instead of touching every segment's state
+    size_t i = 0;
+    const size_t n = _segs.size();
+    while (i < n && _segs.max_timestamp(i) <= time) {
+        ++i;
+    }
 
-    if (it == _segs.cbegin()) {
+    if (i == 0) {
         return model::offset{};
     }
-
-    it = std::prev(it);
-    return (*it)->offsets().committed_offset;
+    return _segs[i - 1]->offsets().committed_offset;
 }
 
 ss::future<model::offset>
@@ -260,6 +297,135 @@ ss::future<> disk_log_impl::do_compact(compaction_config cfg) {
     return ss::now();
 }
 ss::future<> disk_log_impl::compact(compaction_config cfg) {
+    // gc and compaction remove and rewrite segments; parked readers pin
+    // their segments through read locks, so release them first
+    return evict_parked_readers().then(
+      [this, cfg] { return do_housekeeping(cfg); });
+}
+
+ss::future<size_t> disk_log_impl::upgrade_stale_segments(
+  compaction_config cfg, size_t bytes_budget) {
+    vassert(!_closed, "upgrade_stale_segments on closed log - {}", *this);
+    // snapshot the sealed segments past the persisted watermark up front;
+    // every rewrite is a scheduling point and _segs may roll or truncate
+    // underneath an iterator
+    const auto upgraded_through = read_format_upgraded_offset();
+    std::vector<ss::lw_shared_ptr<segment>> candidates;
+    for (auto& s : _segs) {
+        if (s->has_appender()) {
+            // active tail, rewritten on its next roll anyway
+            break;
+        }
+        if (
+          upgraded_through
+          && s->offsets().committed_offset <= *upgraded_through) {
+            continue;
+        }
+        candidates.push_back(s);
+    }
+    if (candidates.empty()) {
+        return ss::make_ready_future<size_t>(0);
+    }
+    struct upgrade_round {
+        std::vector<ss::lw_shared_ptr<segment>> segments;
+        size_t next{0};
+        size_t used{0};
+        std::optional<model::offset> watermark;
+    };
+    return ss::do_with(
+      upgrade_round{.segments = std::move(candidates)},
+      [this, cfg, bytes_budget](upgrade_round& round) {
+          // parked readers hold read locks on their segments and the
+          // staging swap needs the write lock
+          return evict_parked_readers()
+            .then([this, cfg, bytes_budget, &round] {
+                return ss::repeat([this, cfg, bytes_budget, &round] {
+                    using stop_t = ss::stop_iteration;
+                    if (
+                      round.next == round.segments.size()
+                      || round.used >= bytes_budget
+                      || cfg.asrc->abort_requested()) {
+                        return ss::make_ready_future<stop_t>(stop_t::yes);
+                    }
+                    auto s = round.segments[round.next++];
+                    auto meta = segment_path::parse_segment_filename(
+                      std::filesystem::path(s->reader().filename().c_str())
+                        .filename()
+                        .string());
+                    if (!meta) {
+                        // cannot classify the file; do not advance the
+                        // watermark past it
+                        return ss::make_ready_future<stop_t>(stop_t::yes);
+                    }
+                    if (meta->version == latest_segment_version) {
+                        round.watermark = s->offsets().committed_offset;
+                        return ss::make_ready_future<stop_t>(stop_t::no);
+                    }
+                    const auto sz = s->size_bytes();
+                    vlog(
+                      stlog.info,
+                      "rewriting {} from format {} to {}",
+                      s->reader().filename(),
+                      meta->version,
+                      latest_segment_version);
+                    return internal::upgrade_segment_format(s, cfg, _probe)
+                      .then([&round, s, sz] {
+                          round.used += sz;
+                          round.watermark = s->offsets().committed_offset;
+                          return stop_t::no;
+                      });
+                });
+            })
+            .then([this, &round] {
+                if (!round.watermark) {
+                    return ss::make_ready_future<size_t>(round.used);
+                }
+                // persisted only after the rewrites it covers are on disk;
+                // a crash in between redoes an idempotent copy
+                return _kvstore
+                  .put(
+                    kvstore::key_space::storage,
+                    internal::format_upgraded_offset_key(config().ntp()),
+                    reflection::to_iobuf(*round.watermark))
+                  .then([&round] { return round.used; });
+            });
+      });
+}
+
+ss::future<size_t> disk_log_impl::flush_dirty_indices() {
+    vassert(!_closed, "flush_dirty_indices on closed log - {}", *this);
+    // snapshot the dirty segments up front; every write is a scheduling
+    // point and _segs may roll or truncate underneath an iterator
+    std::vector<ss::lw_shared_ptr<segment>> dirty;
+    for (auto& s : _segs) {
+        if (s->index().needs_persistence()) {
+            dirty.push_back(s);
+        }
+    }
+    if (dirty.empty()) {
+        return ss::make_ready_future<size_t>(0);
+    }
+    return ss::do_with(
+      std::move(dirty), [](std::vector<ss::lw_shared_ptr<segment>>& dirty) {
+          // phase one: write the state of every dirty index without
+          // waiting for the device barrier so the small writes coalesce
+          return ss::parallel_for_each(
+                   dirty,
+                   [](ss::lw_shared_ptr<segment>& s) {
+                       return s->index().flush_data().discard_result();
+                   })
+            // phase two: one group of barriers for the whole batch
+            .then([&dirty] {
+                return ss::parallel_for_each(
+                  dirty, [](ss::lw_shared_ptr<segment>& s) {
+                      return s->index().barrier();
+                  });
+            })
+            .then([&dirty] { return dirty.size(); });
+      });
+}
+
+ss::future<> disk_log_impl::do_housekeeping(compaction_config cfg) {
     ss::future<> f = ss::now();
     if (config().is_collectable()) {
         f = gc(cfg);
@@ -383,7 +549,44 @@ ss::future<> disk_log_impl::new_segment(
   model::offset o, model::term_id t, ss::io_priority_class pc) {
     vassert(
       o() >= 0 && t() >= 0, "offset:{} and term:{} must be initialized", o, t);
-    return _manager.make_log_segment(config(), o, t, pc)
+    // topics with explicitly configured io shares write through their own
+    // priority class instead of the caller's subsystem-wide one
+    if (auto shares = config().io_shares(); shares) {
+        pc = priority_manager::local().topic_priority(
+          config().ntp().tp.topic(), *shares);
+    }
+    auto adopt = ss::now();
+    if (std::exchange(_roll_ahead_staged, false)) {
+        // adopt the staged files: two renames instead of file creation and
+        // the first fallocation in the append path. on any error fall back
+        // to creating the segment from scratch
+        auto path = segment_path::make_segment_path(
+          config(), o, t, record_version_type::v1);
+        auto index_path = std::filesystem::path(path).replace_extension(
+          "base_index");
+        adopt = ss::rename_file(staged_segment_path().string(), path.string())
+                  .then([this, index_path] {
+                      return ss::rename_file(
+                        staged_index_path().string(), index_path.string());
+                  })
+                  .then([this] {
+                      // the renamed entries need the directory durability a
+                      // create would have paid; coalesced shard wide
+                      return internal::dir_syncer().sync(
+                        config().work_directory());
+                  })
+                  .handle_exception([this](std::exception_ptr e) {
+                      vlog(
+                        stlog.debug,
+                        "Could not adopt staged roll-ahead files for {}: {}",
+                        config().ntp(),
+                        e);
+                  });
+    }
+    return adopt
+      .then([this, o, t, pc] {
+          return _manager.make_log_segment(config(), o, t, pc);
+      })
       .then([this](ss::lw_shared_ptr<segment> handles) mutable {
           return remove_empty_segments().then(
             [this, h = std::move(handles)]() mutable {
@@ -430,7 +633,18 @@ ss::future<> disk_log_impl::flush() {
     if (_segs.empty()) {
         return ss::make_ready_future<>();
     }
-    return _segs.back()->flush();
+    // route through the shard wide flush barrier so concurrent flushes of
+    // this log collapse into one fdatasync and flushes of other logs are
+    // submitted to the device in the same round
+    return _manager.flusher().flush(this, [this] {
+        if (_segs.empty()) {
+            return ss::make_ready_future<>();
+        }
+        // counted here rather than at the entry point so flushes collapsed
+        // by the barrier register as the single device operation they are
+        _probe.flush();
+        return _segs.back()->flush();
+    });
 }
 
 size_t disk_log_impl::max_segment_size() const {
@@ -480,9 +694,82 @@ ss::future<> disk_log_impl::maybe_roll(
             return new_segment(next_offset, t, iopc);
         });
     }
+    maybe_stage_roll_ahead();
     return ss::make_ready_future<>();
 }
 
+std::filesystem::path disk_log_impl::staged_segment_path() const {
+    return std::filesystem::path(
+      fmt::format("{}/roll_ahead.log.staging", config().work_directory()));
+}
+
+std::filesystem::path disk_log_impl::staged_index_path() const {
+    return std::filesystem::path(fmt::format(
+      "{}/roll_ahead.base_index.staging", config().work_directory()));
+}
+
+void disk_log_impl::maybe_stage_roll_ahead() {
+    if (_roll_ahead_staged || _roll_ahead_in_progress || _segs.empty()) {
+        return;
+    }
+    auto& back = _segs.back();
+    if (!back->has_appender()) {
+        return;
+    }
+    const auto threshold = _max_segment_size
+                           - _max_segment_size / roll_ahead_divisor;
+    if (back->appender().file_byte_offset() < threshold) {
+        return;
+    }
+    _roll_ahead_in_progress = true;
+    (void)ss::with_gate(_roll_ahead_gate, [this] {
+        return do_stage_roll_ahead()
+          .handle_exception([this](std::exception_ptr e) {
+              vlog(
+                stlog.debug,
+                "Could not stage roll-ahead files for {}: {}",
+                config().ntp(),
+                e);
+          })
+          .finally([this] { _roll_ahead_in_progress = false; });
+    });
+}
+
+ss::future<> disk_log_impl::do_stage_roll_ahead() {
+    const auto sanitize = _manager.config().sanitize_fileops;
+    return internal::make_writer_handle(staged_segment_path(), sanitize)
+      .then([](ss::file f) {
+          // pre-allocate the first extent so the new appender's first
+          // fallocation finds the journal work already done
+          return f.allocate(0, segment_appender::min_fallocation_step)
+            .then([f]() mutable { return f.close(); })
+            .finally([f] {});
+      })
+      .then([this, sanitize] {
+          return internal::make_writer_handle(staged_index_path(), sanitize)
+            .then([](ss::file f) {
+                return f.close().finally([f] {});
+            });
+      })
+      .then([this] { _roll_ahead_staged = true; });
+}
+
+ss::future<> disk_log_impl::remove_staged_roll_files() {
+    return ss::do_with(
+      std::vector<ss::sstring>{
+        staged_segment_path().string(), staged_index_path().string()},
+      [](std::vector<ss::sstring>& paths) {
+          return ss::parallel_for_each(paths, [](const ss::sstring& path) {
+              return ss::file_exists(path).then([path](bool exists) {
+                  if (!exists) {
+                      return ss::now();
+                  }
+                  return ss::remove_file(path);
+              });
+          });
+      });
+}
+
 ss::future<model::record_batch_reader>
 disk_log_impl::make_unchecked_reader(log_reader_config config) {
     vassert(!_closed, "make_reader on closed log - {}", *this);
@@ -493,6 +780,89 @@ disk_log_impl::make_unchecked_reader(log_reader_config config) {
       });
 }
 
+ss::future<model::record_batch_reader>
+disk_log_impl::make_cached_reader(log_reader_config config) {
+    if (auto parked = find_parked_reader(config); parked) {
+        auto rdr = std::make_unique<log_reader>(
+          std::move(*parked), config, _probe);
+        rdr->set_parker([this](parked_reader r) { park_reader(std::move(r)); });
+        return ss::make_ready_future<model::record_batch_reader>(
+          model::record_batch_reader(std::move(rdr)));
+    }
+    return _lock_mngr.range_lock(config).then(
+      [this, cfg = config](std::unique_ptr<lock_manager::lease> lease) {
+          auto rdr = std::make_unique<log_reader>(
+            std::move(lease), cfg, _probe);
+          rdr->set_parker(
+            [this](parked_reader r) { park_reader(std::move(r)); });
+          return model::record_batch_reader(std::move(rdr));
+      });
+}
+
+bool disk_log_impl::is_cold_read_range(model::offset max_offset) const {
+    if (_segs.size() <= cold_read_segment_lag) {
+        return false;
+    }
+    auto it = _segs.lower_bound(max_offset);
+    if (it == _segs.end()) {
+        // past the tail - the read chases the high watermark
+        return false;
+    }
+    return static_cast<size_t>(std::distance(it, _segs.end()))
+           > cold_read_segment_lag;
+}
+
+std::optional<parked_reader>
+disk_log_impl::find_parked_reader(const log_reader_config& config) {
+    auto it = std::find_if(
+      _parked_readers.begin(),
+      _parked_readers.end(),
+      [&config](const parked_reader& p) {
+          // the open stream was created with the parked priority class, so
+          // only resume it for a fetch issued at the same priority
+          return p.next_offset() == config.start_offset
+                 && p.config.prio.id() == config.prio.id();
+      });
+    if (it == _parked_readers.end()) {
+        return std::nullopt;
+    }
+    auto parked = std::move(*it);
+    _parked_readers.erase(it);
+    return parked;
+}
+
+void disk_log_impl::park_reader(parked_reader reader) {
+    if (_closed) {
+        (void)reader.close().handle_exception([](std::exception_ptr e) {
+            vlog(stlog.debug, "ignoring parked reader close error: {}", e);
+        });
+        return;
+    }
+    if (_parked_readers.size() >= max_parked_readers) {
+        auto oldest = std::min_element(
+          _parked_readers.begin(),
+          _parked_readers.end(),
+          [](const parked_reader& a, const parked_reader& b) {
+              return a.parked_at < b.parked_at;
+          });
+        auto victim = std::move(*oldest);
+        _parked_readers.erase(oldest);
+        (void)victim.close().handle_exception([](std::exception_ptr e) {
+            vlog(stlog.debug, "ignoring parked reader close error: {}", e);
+        });
+    }
+    _parked_readers.push_back(std::move(reader));
+}
+
+ss::future<> disk_log_impl::evict_parked_readers() {
+    return ss::do_with(
+      std::exchange(_parked_readers, {}),
+      [](std::vector<parked_reader>& readers) {
+          return ss::parallel_for_each(
+            readers, [](parked_reader& r) { return r.close(); });
+      });
+}
+
 ss::future<model::record_batch_reader>
 disk_log_impl::make_reader(log_reader_config config) {
     vassert(!_closed, "make_reader on closed log - {}", *this);
@@ -503,7 +873,26 @@ disk_log_impl::make_reader(log_reader_config config) {
             config.start_offset,
             _start_offset)));
     }
-    return make_unchecked_reader(config);
+    // as with appends, reads from topics with configured io shares go
+    // through the topic's own priority class
+    if (auto shares = this->config().io_shares(); shares) {
+        config.prio = priority_manager::local().topic_priority(
+          this->config().ntp().tp.topic(), *shares);
+    }
+    // scans over compacted topics cross many small cleaned segments; let
+    // the reader overlap the next segment's first read with the consumer
+    if (this->config().is_compacted() && !config.strict_max_bytes) {
+        config.cross_segment_prefetch = true;
+    }
+    // a range that ends several sealed segments behind the tail is a
+    // historical backfill: stream it with large read-once buffers and keep
+    // it out of the batch cache so it does not evict the data tail
+    // consumers are about to fetch
+    if (is_cold_read_range(config.max_offset)) {
+        config.cold_read = true;
+        config.skip_batch_cache = true;
+    }
+    return make_cached_reader(config);
 }
 
 ss::future<model::record_batch_reader>
@@ -513,9 +902,21 @@ disk_log_impl::make_reader(timequery_config config) {
       [this, cfg = config](std::unique_ptr<lock_manager::lease> lease) {
           auto start_offset = _start_offset;
           if (!lease->range.empty()) {
+              auto& first_seg = *lease->range.begin();
               // adjust for partial visibility of segment prefix
               start_offset = std::max(
-                start_offset, (*lease->range.begin())->offsets().base_offset);
+                start_offset, first_seg->offsets().base_offset);
+              /*
+               * seek within the segment using the sparse time index:
+               * resolving a timestamp is then two binary searches (segment,
+               * then index entry) plus a scan bounded by the index
+               * granularity, instead of a scan from the segment base. a
+               * released or empty index degrades to the full scan.
+               */
+              if (auto e = first_seg->index().find_nearest_before(cfg.time);
+                  e) {
+                  start_offset = std::max(start_offset, e->offset);
+              }
           }
           log_reader_config config(
             start_offset,
@@ -539,12 +940,64 @@ std::optional<model::term_id> disk_log_impl::get_term(model::offset o) const {
 
     return std::nullopt;
 }
+/*
+ * Header-only timequery: answered from the per-segment batch header
+ * sidecars, walking the timestamp column instead of reading batch data.
+ * Returns nullopt in the outer optional when a segment in range has no
+ * hydrated sidecar (released index, or a segment written before the
+ * sidecar existed) and the query must scan data.
+ */
+static std::optional<std::optional<timequery_result>>
+timequery_from_headers(
+  const timequery_config& cfg,
+  model::offset start_offset,
+  lock_manager::lease& lease) {
+    std::optional<timequery_result> result;
+    for (auto& seg : lease.range) {
+        auto min = std::max(start_offset, seg->offsets().base_offset);
+        if (min > cfg.max_offset) {
+            break;
+        }
+        const auto& idx = seg->index();
+        if (!idx.has_batch_headers()) {
+            return std::nullopt;
+        }
+        auto e = idx.batch_headers().find_first_timestamp(
+          cfg.time, min, cfg.max_offset);
+        if (e) {
+            // same shape a reader scan produces: the first batch in range
+            // whose first timestamp reaches the query time
+            result = timequery_result(
+              e->header.base_offset, e->header.first_timestamp);
+            break;
+        }
+    }
+    return result;
+}
+
 ss::future<std::optional<timequery_result>>
 disk_log_impl::timequery(timequery_config cfg) {
     vassert(!_closed, "timequery on closed log - {}", *this);
     if (_segs.empty()) {
         return ss::make_ready_future<std::optional<timequery_result>>();
     }
+    return _lock_mngr.range_lock(cfg)
+      .then([this, cfg](std::unique_ptr<lock_manager::lease> lease) {
+          auto fast = timequery_from_headers(cfg, _start_offset, *lease);
+          return ss::make_ready_future<
+            std::optional<std::optional<timequery_result>>>(fast);
+      })
+      .then([this, cfg](std::optional<std::optional<timequery_result>> fast) {
+          if (fast) {
+              return ss::make_ready_future<std::optional<timequery_result>>(
+                *fast);
+          }
+          return timequery_from_data(cfg);
+      });
+}
+
+ss::future<std::optional<timequery_result>>
+disk_log_impl::timequery_from_data(timequery_config cfg) {
     return make_reader(std::move(cfg))
       .then([cfg](model::record_batch_reader reader) {
           return model::consume_reader_to_memory(
@@ -565,6 +1018,57 @@ disk_log_impl::timequery(timequery_config cfg) {
       });
 }
 
+batch_cache::pin_guard
+disk_log_impl::pin_cached_range(model::offset begin, model::offset end) {
+    batch_cache::pin_guard guard;
+    // fresh appends live in the tail segments; walk backwards and stop at
+    // the first segment entirely below the range
+    for (auto it = std::make_reverse_iterator(_segs.end());
+         it != std::make_reverse_iterator(_segs.begin());
+         ++it) {
+        auto& seg = *it;
+        const auto offsets = seg->offsets();
+        if (offsets.dirty_offset < begin) {
+            break;
+        }
+        if (offsets.base_offset > end) {
+            continue;
+        }
+        guard.merge(seg->cache_pin(begin, end));
+    }
+    return guard;
+}
+
+ss::future<log_verify_result> disk_log_impl::verify() {
+    // copies keep the segments alive if the set shrinks underneath us;
+    // per-segment read locks serialize with truncation and removal
+    auto segs = std::vector<ss::lw_shared_ptr<segment>>(
+      _segs.begin(), _segs.end());
+    return ss::do_with(
+      log_verify_result{}, std::move(segs), [this](auto& res, auto& segs) {
+          res.ntp = config().ntp();
+          return ss::do_for_each(
+                   segs,
+                   [&res](const ss::lw_shared_ptr<segment>& s) {
+                       if (s->has_appender() || s->is_closed()) {
+                           // the active tail races ongoing writes
+                           return ss::now();
+                       }
+                       return internal::verify_segment(
+                                s, ss::default_priority_class())
+                         .then([&res](segment_verify_result sr) {
+                             ++res.segments_verified;
+                             res.bytes_verified += sr.bytes_verified;
+                             res.batches_verified += sr.batches_verified;
+                             if (sr.corrupt()) {
+                                 res.corruptions.push_back(std::move(sr));
+                             }
+                         });
+                   })
+            .then([&res] { return std::move(res); });
+      });
+}
+
 ss::future<> disk_log_impl::remove_segment_permanently(
   ss::lw_shared_ptr<segment> s, std::string_view ctx) {
     vlog(stlog.info, "{} - tombstone & delete segment: {}", ctx, s);
@@ -615,8 +1119,9 @@ disk_log_impl::remove_prefix_full_segments(truncate_prefix_config cfg) {
 ss::future<> disk_log_impl::truncate_prefix(truncate_prefix_config cfg) {
     vassert(!_closed, "truncate_prefix() on closed log - {}", *this);
     return _failure_probes.truncate_prefix().then([this, cfg]() mutable {
-        // dispatch the actual truncation
-        return do_truncate_prefix(cfg);
+        // parked readers may cover the range being truncated
+        return evict_parked_readers().then(
+          [this, cfg] { return do_truncate_prefix(cfg); });
     });
 }
 
@@ -688,8 +1193,9 @@ ss::future<> disk_log_impl::do_truncate_prefix(truncate_prefix_config cfg) {
 ss::future<> disk_log_impl::truncate(truncate_config cfg) {
     vassert(!_closed, "truncate() on closed log - {}", *this);
     return _failure_probes.truncate().then([this, cfg]() mutable {
-        // dispatch the actual truncation
-        return do_truncate(cfg);
+        // parked readers may cover the range being truncated
+        return evict_parked_readers().then(
+          [this, cfg] { return do_truncate(cfg); });
     });
 }
 
@@ -783,6 +1289,16 @@ model::offset disk_log_impl::read_start_offset() const {
     return model::offset{};
 }
 
+std::optional<model::offset> disk_log_impl::read_format_upgraded_offset() const {
+    auto value = _kvstore.get(
+      kvstore::key_space::storage,
+      internal::format_upgraded_offset_key(config().ntp()));
+    if (value) {
+        return reflection::adl<model::offset>{}.from(std::move(*value));
+    }
+    return std::nullopt;
+}
+
 std::ostream& disk_log_impl::print(std::ostream& o) const {
     return o << "{offsets:" << offsets()
              << ", max_collectible_offset: " << _max_collectible_offset
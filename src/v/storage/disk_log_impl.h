@@ -29,6 +29,9 @@
 
 #include <absl/container/flat_hash_map.h>
 
+#include <filesystem>
+#include <vector>
+
 namespace storage {
 
 class disk_log_impl final : public log::impl {
@@ -59,6 +62,13 @@ public:
     /// timequery
     ss::future<std::optional<timequery_result>>
     timequery(timequery_config cfg) final;
+    ss::future<log_verify_result> verify() final;
+    batch_cache::pin_guard
+      pin_cached_range(model::offset, model::offset) final;
+    log_io_rates io_rates() final { return _probe.io_rates(config().ntp()); }
+    ss::future<size_t>
+      upgrade_stale_segments(compaction_config, size_t bytes_budget) final;
+    ss::future<size_t> flush_dirty_indices() final;
     size_t segment_count() const final { return _segs.size(); }
     offset_stats offsets() const final;
     std::optional<model::term_id> get_term(model::offset) const final;
@@ -81,8 +91,24 @@ private:
     ss::future<model::record_batch_reader>
       make_unchecked_reader(log_reader_config);
 
+    ss::future<model::record_batch_reader>
+      make_cached_reader(log_reader_config);
+
+    /// scan fallback when a segment lacks a batch header sidecar
+    ss::future<std::optional<timequery_result>>
+      timequery_from_data(timequery_config);
+
+    void park_reader(parked_reader);
+    std::optional<parked_reader> find_parked_reader(const log_reader_config&);
+    ss::future<> evict_parked_readers();
+
+    bool is_cold_read_range(model::offset max_offset) const;
+
     model::offset read_start_offset() const;
+    std::optional<model::offset> read_format_upgraded_offset() const;
 
+    ss::future<> do_remove();
+    ss::future<> do_housekeeping(compaction_config);
     ss::future<> do_compact(compaction_config);
     ss::future<> gc(compaction_config);
 
@@ -97,6 +123,21 @@ private:
       model::term_id term_for_this_segment,
       ss::io_priority_class prio);
 
+    /*
+     * roll-ahead: the final segment name embeds the base offset which is
+     * only known at roll time, so the next segment's data file and index
+     * are prepared in the background under fixed staging names once the
+     * active segment is close to full. the roll then adopts them with two
+     * renames instead of paying file creation and the first fallocation
+     * in the append path. recovery ignores the staging names and stale
+     * files are simply reused by the next staging pass.
+     */
+    void maybe_stage_roll_ahead();
+    ss::future<> do_stage_roll_ahead();
+    ss::future<> remove_staged_roll_files();
+    std::filesystem::path staged_segment_path() const;
+    std::filesystem::path staged_index_path() const;
+
     ss::future<> do_truncate(truncate_config);
     ss::future<> remove_full_segments(model::offset o);
 
@@ -131,6 +172,25 @@ private:
     std::optional<eviction_monitor> _eviction_monitor;
     model::offset _max_collectible_offset;
     size_t _max_segment_size;
+    /*
+     * small cache of readers parked by finished fetches, keyed by the offset
+     * of their next read. consecutive fetches from the same consumer resume
+     * the open stream and parser instead of re-opening the segment. evicted
+     * before gc, compaction and truncation since parked readers hold read
+     * locks on their segments.
+     */
+    static constexpr size_t max_parked_readers = 4;
+    std::vector<parked_reader> _parked_readers;
+    // a read is cold when its whole range ends at least this many sealed
+    // segments behind the tail; with default segment sizes that is
+    // gigabytes of lag, far past anything a live consumer re-reads
+    static constexpr size_t cold_read_segment_lag = 2;
+    // stage the next segment once the active one enters the last fifth
+    // before the roll threshold
+    static constexpr size_t roll_ahead_divisor = 5;
+    bool _roll_ahead_staged{false};
+    bool _roll_ahead_in_progress{false};
+    ss::gate _roll_ahead_gate;
 };
 
 } // namespace storage
@@ -13,7 +13,7 @@
 #include "finjector/hbadger.h"
 #include "random/fast_prng.h"
 #include "seastarx.h"
-#include "utils/string_switch.h"
+#include "utils/static_string_map.h"
 
 #include <seastar/core/sleep.hh>
 
@@ -37,12 +37,12 @@ public:
     };
 
     type method_for_point(std::string_view point) const final {
-        return string_switch<type>(point)
-          .match("append", static_cast<type>(methods::append))
-          .match("roll", static_cast<type>(methods::roll))
-          .match("truncate", static_cast<type>(methods::truncate))
-          .match("truncate_prefix", static_cast<type>(methods::truncate_prefix))
-          .default_match(0);
+        static constexpr auto points = make_static_string_map<type>(
+          {{"append", static_cast<type>(methods::append)},
+           {"roll", static_cast<type>(methods::roll)},
+           {"truncate", static_cast<type>(methods::truncate)},
+           {"truncate_prefix", static_cast<type>(methods::truncate_prefix)}});
+        return points.match_or(point, 0);
     }
 
     std::vector<ss::sstring> points() final {
@@ -0,0 +1,63 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/flush_coordinator.h"
+
+#include <seastar/core/future-util.hh>
+
+#include <vector>
+
+namespace storage {
+
+ss::future<> flush_coordinator::flush(const void* key, flush_func f) {
+    if (_gate.is_closed()) {
+        // shutting down, no more batching, execute directly
+        return f();
+    }
+    if (!_next) {
+        _next = std::make_unique<round>();
+    }
+    _next->funcs.try_emplace(key, std::move(f));
+    auto fut = _next->done.get_shared_future();
+    if (!_in_progress) {
+        dispatch_round();
+    }
+    return fut;
+}
+
+void flush_coordinator::dispatch_round() {
+    if (!_next) {
+        _in_progress = false;
+        _gate.leave();
+        return;
+    }
+    if (!_in_progress) {
+        // the round chain holds a single gate unit until it drains so
+        // stop() waits for queued rounds and their waiters
+        _gate.enter();
+        _in_progress = true;
+    }
+    auto r = std::move(_next);
+    std::vector<ss::future<>> flushes;
+    flushes.reserve(r->funcs.size());
+    for (auto& e : r->funcs) {
+        flushes.push_back(e.second());
+    }
+    (void)ss::when_all_succeed(flushes.begin(), flushes.end())
+      .then_wrapped([this, r = std::move(r)](ss::future<> f) {
+          if (f.failed()) {
+              r->done.set_exception(f.get_exception());
+          } else {
+              r->done.set_value();
+          }
+          dispatch_round();
+      });
+}
+
+} // namespace storage
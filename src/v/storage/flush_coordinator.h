@@ -0,0 +1,70 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/shared_future.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <memory>
+
+namespace storage {
+
+/**
+ * Shard level flush barrier.
+ *
+ * On shards hosting hundreds of active raft groups every replication round
+ * flushes its own log, producing thousands of small fdatasyncs/sec against
+ * the same device. The coordinator batches flushes into rounds: while one
+ * round of fdatasyncs is on the device every new request queues into the
+ * next round, requests for the same log collapse into a single sync, and
+ * the whole round is dispatched as one concurrent barrier when the device
+ * becomes free. All waiters of a round are acked together when it settles.
+ *
+ * Distinct logs are distinct files so each still needs its own fdatasync,
+ * but coalescing per log and aligning the rest into one submission turns a
+ * stream of serialized single-sync round trips into deep, device friendly
+ * batches.
+ */
+class flush_coordinator {
+public:
+    using flush_func = ss::noncopyable_function<ss::future<>()>;
+
+    /**
+     * Schedules a flush of the log identified by key. If the same key is
+     * already queued in the upcoming round the request shares its sync.
+     * Resolves when the round containing the request settled, fails with
+     * the round's error if any flush in it failed.
+     */
+    ss::future<> flush(const void* key, flush_func);
+
+    ss::future<> stop() { return _gate.close(); }
+
+private:
+    struct round {
+        absl::flat_hash_map<const void*, flush_func> funcs;
+        ss::shared_promise<> done;
+    };
+
+    void dispatch_round();
+
+    std::unique_ptr<round> _next;
+    bool _in_progress{false};
+    ss::gate _gate;
+};
+
+} // namespace storage
@@ -11,6 +11,7 @@
 
 #include "bytes/iobuf.h"
 #include "cluster/namespace.h"
+#include "model/record_utils.h"
 #include "prometheus/prometheus_sanitize.h"
 #include "raft/types.h"
 #include "reflection/adl.h"
@@ -24,6 +25,8 @@
 #include <seastar/util/defer.hh>
 #include <seastar/util/log.hh>
 
+#include <boost/range/irange.hpp>
+
 static ss::logger lg("kvstore");
 
 namespace storage {
@@ -34,7 +37,15 @@ kvstore::kvstore(kvstore_config kv_conf)
   , _snap(
       std::filesystem::path(_ntpc.work_directory()),
       ss::default_priority_class())
-  , _timer([this] { _sem.signal(); }) {}
+  , _timer([this] { _sem.signal(); }) {
+    _spaces.reserve(num_key_spaces);
+    for (int8_t i = 0; i < num_key_spaces; ++i) {
+        _spaces.emplace_back(snapshot_manager(
+          std::filesystem::path(_ntpc.work_directory()),
+          fmt::format("snapshot.{}", i),
+          ss::default_priority_class()));
+    }
+}
 
 ss::future<> kvstore::start() {
     vlog(lg.info, "Starting kvstore: dir {}", _ntpc.work_directory());
@@ -87,8 +98,27 @@ ss::future<> kvstore::start() {
                         if (_gate.is_closed()) {
                             return ss::now();
                         }
-                        return roll().then(
-                          [this] { return flush_and_apply_ops(); });
+                        _flush_in_flight = true;
+                        return roll()
+                          .then([this] { return flush_and_apply_ops(); })
+                          .finally([this] {
+                              _flush_in_flight = false;
+                              /*
+                               * group commit: operations staged while this
+                               * flush was being written commit in one append
+                               * directly behind it instead of waiting out
+                               * another commit interval. under write storms
+                               * (mass re-elections persisting voted_for for
+                               * thousands of groups) flushes chain back to
+                               * back and each fsync is amortized over every
+                               * operation that arrived during the previous
+                               * one.
+                               */
+                              if (!_ops.empty()) {
+                                  _timer.cancel();
+                                  _sem.signal();
+                              }
+                          });
                     });
                 });
           });
@@ -125,6 +155,20 @@ ss::future<> kvstore::stop() {
     });
 }
 
+/*
+ * Return the key-space a spaced key belongs to
+ */
+static inline kvstore::key_space spaced_key_space(const bytes& spaced_key) {
+    using ks_t = std::underlying_type<kvstore::key_space>::type;
+    vassert(!spaced_key.empty(), "Spaced key must carry a key-space prefix");
+    auto ks = ss::le_to_cpu(static_cast<ks_t>(spaced_key[0]));
+    vassert(
+      ks >= 0 && ks < kvstore::num_key_spaces,
+      "Unknown key-space prefix {}",
+      ks);
+    return kvstore::key_space(ks);
+}
+
 /*
  * Return a key prefixed by a key-space
  */
@@ -170,7 +214,10 @@ ss::future<> kvstore::put(key_space ks, bytes key, std::optional<iobuf> value) {
     return ss::with_gate(
       _gate, [this, key = std::move(key), value = std::move(value)]() mutable {
           auto& w = _ops.emplace_back(std::move(key), std::move(value));
-          if (!_timer.armed()) {
+          // while a flush is in flight the flusher commits this operation
+          // as soon as the flush completes; the timer only covers the case
+          // where the flusher is idle
+          if (!_flush_in_flight && !_timer.armed()) {
               _timer.arm(_conf.commit_interval);
           }
           return w.done.get_future();
@@ -214,18 +261,40 @@ ss::future<> kvstore::flush_and_apply_ops() {
     // flush and apply whatever happens to be queued up
     auto ops = std::exchange(_ops, {});
 
+    /*
+     * coalesce repeated updates to the same key within the commit window:
+     * only the last operation per key needs to hit the log. every waiter
+     * still resolves once the flush that covers its operation completes.
+     */
+    absl::
+      flat_hash_map<bytes, size_t, bytes_type_hash, bytes_type_eq>
+        last_op_index;
+    for (size_t i = 0; i < ops.size(); i++) {
+        last_op_index.insert_or_assign(ops[i].key, i);
+    }
+
     // build the operation batch to be logged
     storage::record_batch_builder builder(kvstore_batch_type, _next_offset);
-    for (auto& op : ops) {
+    for (size_t i = 0; i < ops.size(); i++) {
+        auto& op = ops[i];
+        if (last_op_index.find(op.key)->second != i) {
+            continue;
+        }
         std::optional<iobuf> value;
         if (op.value) {
             value = op.value->share(0, op.value->size_bytes());
         }
+        // attribute the logged bytes to the key's space so the next log
+        // collapse only rewrites snapshots of spaces that changed
+        auto& sp = _spaces[static_cast<size_t>(spaced_key_space(op.key))];
+        sp.dirty_bytes += op.key.size()
+                          + (value ? value->size_bytes() : size_t(0));
         builder.add_raw_kv(
           bytes_to_iobuf(op.key), reflection::to_iobuf(std::move(value)));
     }
     auto batch = std::move(builder).build();
     auto last_offset = batch.last_offset();
+    _dirty_bytes += batch.size_bytes();
 
     /*
      * 1. write batch
@@ -275,14 +344,36 @@ ss::future<> kvstore::roll() {
         // cleaned-up segment.
         auto seg = std::exchange(_segment, nullptr);
         return seg->close()
-          .then([this] { return save_snapshot(); })
-          .then([seg] {
-              vlog(
-                lg.debug,
-                "Removing old segment with base offset {}",
-                seg->offsets().base_offset);
-              return ss::remove_file(seg->reader().filename()).then([seg] {
-                  return ss::remove_file(seg->index().filename());
+          .then([this, seg] {
+              /*
+               * defer the snapshot while its cost outweighs the amount of
+               * state that actually changed: the rolled segment is retained
+               * as a delta and replayed at startup instead. once the bytes
+               * logged since the last snapshot are on the order of the
+               * database size, or enough segments accumulated, collapse the
+               * chain into a full snapshot.
+               */
+              if (
+                _dirty_bytes < _probe.cached_bytes
+                && _deferred_segments.size() < max_deferred_segments) {
+                  vlog(
+                    lg.debug,
+                    "Retaining segment with base offset {} as snapshot delta",
+                    seg->offsets().base_offset);
+                  _deferred_segments.push_back(deferred_segment{
+                    .data_file = seg->reader().filename(),
+                    .index_file = seg->index().filename()});
+                  return ss::now();
+              }
+              return save_snapshot().then([this, seg] {
+                  vlog(
+                    lg.debug,
+                    "Removing old segment with base offset {}",
+                    seg->offsets().base_offset);
+                  return ss::remove_file(seg->reader().filename())
+                    .then(
+                      [seg] { return ss::remove_file(seg->index().filename()); })
+                    .then([this] { return remove_deferred_segments(); });
               });
           })
           .then([this] {
@@ -304,6 +395,18 @@ ss::future<> kvstore::roll() {
     return ss::now();
 }
 
+ss::future<> kvstore::remove_deferred_segments() {
+    auto segs = std::exchange(_deferred_segments, {});
+    return ss::do_with(
+      std::move(segs), [](std::vector<deferred_segment>& segs) {
+          return ss::do_for_each(segs, [](deferred_segment& seg) {
+              vlog(lg.debug, "Removing deferred segment {}", seg.data_file);
+              return ss::remove_file(seg.data_file).then(
+                [&seg] { return ss::remove_file(seg.index_file); });
+          });
+      });
+}
+
 ss::future<> kvstore::save_snapshot() {
     vassert(
       _next_offset >= model::offset(0),
@@ -315,20 +418,78 @@ ss::future<> kvstore::save_snapshot() {
         return ss::now();
     }
 
-    vlog(
-      lg.debug,
-      "Creating snapshot at offset {}",
-      _next_offset - model::offset(1));
+    auto last_offset = _next_offset - model::offset(1);
+    vlog(lg.debug, "Creating snapshots at offset {}", last_offset);
 
-    // package up the db into a batch
+    return ss::do_with(
+             boost::irange<int8_t>(0, num_key_spaces),
+             [this, last_offset](boost::integer_range<int8_t>& range) {
+                 return ss::do_for_each(range, [this, last_offset](int8_t i) {
+                     return save_space_snapshot(key_space(i), last_offset);
+                 });
+             })
+      .then([this] {
+          _dirty_bytes = 0;
+          _legacy_snapshot_loaded = false;
+          // the per-space snapshots supersede the legacy whole-store one
+          return ss::file_exists(_snap.snapshot_path().string())
+            .then([this](bool exists) {
+                if (!exists) {
+                    return ss::now();
+                }
+                return ss::remove_file(_snap.snapshot_path().string());
+            });
+      });
+}
+
+ss::future<>
+kvstore::save_space_snapshot(key_space ks, model::offset last_offset) {
+    auto& sp = _spaces[static_cast<size_t>(ks)];
+
+    // package up the space's keys into a batch
     storage::record_batch_builder builder(kvstore_batch_type, model::offset(0));
+    size_t entries = 0;
     for (auto& entry : _db) {
+        if (spaced_key_space(entry.first) != ks) {
+            continue;
+        }
         builder.add_raw_kv(
           bytes_to_iobuf(entry.first),
           entry.second.share(0, entry.second.size_bytes()));
+        ++entries;
+    }
+
+    /*
+     * a clean space's snapshot is still valid through last_offset: the
+     * segments about to be collapsed contain no operations for it. skip
+     * the rewrite unless the space changed, its keys were restored from
+     * the legacy whole-store snapshot (about to be removed), or it has
+     * keys but no snapshot file yet.
+     */
+    const bool must_write = sp.dirty_bytes != 0
+                            || (_legacy_snapshot_loaded && entries != 0)
+                            || (!sp.has_snapshot && entries != 0);
+    if (!must_write) {
+        vlog(
+          lg.trace,
+          "Skipping snapshot of clean key space {}",
+          static_cast<int>(ks));
+        return ss::make_ready_future<>();
     }
+
+    vlog(
+      lg.debug,
+      "Snapshotting key space {} with {} entries",
+      static_cast<int>(ks),
+      entries);
+
     auto batch = std::move(builder).build();
 
+    // snapshots are node-local so they use the cheaper xxhash64 integrity
+    // profile. the digest travels in the snapshot metadata; loaders that
+    // find no digest fall back to the batch crc32c fields.
+    auto digest = model::xxhash_record_batch(batch);
+
     // serialize batch: size_prefix + batch
     iobuf data;
     auto ph = data.reserve(sizeof(int32_t));
@@ -336,16 +497,15 @@ ss::future<> kvstore::save_snapshot() {
     auto size = ss::cpu_to_le(int32_t(data.size_bytes() - sizeof(int32_t)));
     ph.write((const char*)&size, sizeof(size));
 
-    return _snap.start_snapshot().then(
-      [this, data = std::move(data)](snapshot_writer writer) mutable {
+    return sp.snap.start_snapshot().then(
+      [this, &sp, last_offset, digest, data = std::move(data)](
+        snapshot_writer writer) mutable {
           return ss::do_with(
             std::move(writer),
-            [this, data = std::move(data)](snapshot_writer& wr) mutable {
-                // the last log offset represented in the snapshot
-                auto last_offset = _next_offset - model::offset(1);
-
+            [this, &sp, last_offset, digest, data = std::move(data)](
+              snapshot_writer& wr) mutable {
                 iobuf meta;
-                reflection::serialize(meta, last_offset);
+                reflection::serialize(meta, last_offset, digest);
 
                 return wr.write_metadata(std::move(meta))
                   .then([&wr, data = std::move(data)]() mutable {
@@ -353,9 +513,12 @@ ss::future<> kvstore::save_snapshot() {
                       return write_iobuf_to_output_stream(std::move(data), os);
                   })
                   .then([&wr] { return wr.close(); })
-                  .then([this, &wr]() {
+                  .then([this, &sp, &wr]() {
                       vlog(lg.debug, "Finishing snapshot creation");
-                      return _snap.finish_snapshot(wr);
+                      return sp.snap.finish_snapshot(wr).then([&sp] {
+                          sp.dirty_bytes = 0;
+                          sp.has_snapshot = true;
+                      });
                   });
             });
       });
@@ -375,30 +538,79 @@ ss::future<> kvstore::recover() {
                           debug_sanitize_files::yes,
                           _ntpc.is_compacted(),
                           [] { return std::nullopt; },
+                          std::nullopt,
                           _as)
                           .get0();
 
         replay_segments_in_thread(std::move(segments));
+
+        /*
+         * keys restored from the legacy whole-store snapshot must be
+         * rewritten into per-space snapshots before the legacy file goes
+         * away. replay covers this when segments exist; handle the case
+         * where there was nothing to replay.
+         */
+        if (_legacy_snapshot_loaded) {
+            save_snapshot().get();
+        }
     });
 }
 
 void kvstore::load_snapshot_in_thread() {
     _gate.check(); // early out on shutdown
 
-    // open snapshot reader, if a snapshot exists
+    /*
+     * restore from the per-key-space snapshots. every space's snapshot is
+     * valid through the offset of the newest one (clean spaces skip the
+     * rewrite precisely because the collapsed segments contained no
+     * operations for them), so replay resumes after the maximum.
+     */
+    _next_offset = model::offset(0);
+    bool found = false;
+    for (auto& sp : _spaces) {
+        auto reader = sp.snap.open_snapshot().get0();
+        if (!reader) {
+            continue;
+        }
+        auto close_reader = ss::defer(
+          [&reader] { return reader->close().get(); });
+        auto last_offset = load_snapshot_reader_in_thread(*reader);
+        sp.has_snapshot = true;
+        found = true;
+        _next_offset = std::max(
+          _next_offset, last_offset + model::offset(1));
+    }
+    if (found) {
+        return;
+    }
+
+    // upgrade path: fall back to the legacy whole-store snapshot. the next
+    // snapshot save rewrites every space and removes the legacy file.
     auto reader = _snap.open_snapshot().get0();
     if (!reader) {
         vlog(lg.debug, "Load snapshot: no snapshot found");
-        _next_offset = model::offset(0);
         return;
     }
     auto close_reader = ss::defer([&reader] { return reader->close().get(); });
+    auto last_offset = load_snapshot_reader_in_thread(*reader);
+    _legacy_snapshot_loaded = true;
+    _next_offset = last_offset + model::offset(1);
+}
 
+model::offset kvstore::load_snapshot_reader_in_thread(snapshot_reader& rdr) {
+    auto reader = &rdr;
     // the snapshot metadata contains the last offset represented
     auto snap_meta = reader->read_metadata().get0();
     iobuf_parser parser(std::move(snap_meta));
     auto last_offset = model::offset(
       reflection::adl<model::offset::type>{}.from(parser));
+    // snapshots written with the xxhash64 integrity profile carry the
+    // digest after the offset. older snapshots end here and are validated
+    // with the batch crc32c fields instead.
+    std::optional<uint64_t> digest;
+    if (parser.bytes_left() >= sizeof(uint64_t)) {
+        digest = reflection::adl<uint64_t>{}.from(parser);
+    }
     vlog(
       lg.debug,
       "Load snapshot: loading snapshot with last offset {}",
@@ -424,18 +636,29 @@ void kvstore::load_snapshot_in_thread() {
 
     auto batch = reflection::from_iobuf<model::record_batch>(std::move(buf));
 
-    auto batch_crc = model::crc_record_batch(batch);
-    if (batch.header().crc != batch_crc) {
-        throw std::runtime_error(fmt::format(
-          "Snapshot batch failed crc {} != {}", batch_crc, batch.header().crc));
-    }
+    if (digest) {
+        // one xxhash64 pass covers header and records
+        auto batch_digest = model::xxhash_record_batch(batch);
+        if (*digest != batch_digest) {
+            throw std::runtime_error(fmt::format(
+              "Snapshot batch failed xxhash {} != {}", batch_digest, *digest));
+        }
+    } else {
+        auto batch_crc = model::crc_record_batch(batch);
+        if (batch.header().crc != batch_crc) {
+            throw std::runtime_error(fmt::format(
+              "Snapshot batch failed crc {} != {}",
+              batch_crc,
+              batch.header().crc));
+        }
 
-    auto header_crc = model::internal_header_only_crc(batch.header());
-    if (batch.header().header_crc != header_crc) {
-        throw std::runtime_error(fmt::format(
-          "Snapshot batch header failed crc {} != {}",
-          header_crc,
-          batch.header().header_crc));
+        auto header_crc = model::internal_header_only_crc(batch.header());
+        if (batch.header().header_crc != header_crc) {
+            throw std::runtime_error(fmt::format(
+              "Snapshot batch header failed crc {} != {}",
+              header_crc,
+              batch.header().header_crc));
+        }
     }
 
     batch.for_each_record([this](model::record r) {
@@ -451,7 +674,7 @@ void kvstore::load_snapshot_in_thread() {
           res.first->second);
     });
 
-    _next_offset = last_offset + model::offset(1);
+    return last_offset;
 }
 
 void kvstore::replay_segments_in_thread(segment_set segs) {
@@ -46,7 +46,10 @@ namespace storage {
  * Operations are staged in an ordered in-memory container. After a commit
  * interval has elapsed the operations are serialized into a single blob and
  * flushed to disk. Once the flush is complete the operations are applied to the
- * in-memory cache, and the associated promise is resolved.
+ * in-memory cache, and the associated promise is resolved. Operations staged
+ * while a flush is being written are committed in one append immediately
+ * behind it (group commit), so sustained write bursts pay one fsync per
+ * chained flush rather than one commit interval per wave.
  *
  * Concurrency
  * ===========
@@ -96,9 +99,12 @@ public:
         consensus = 1,
         storage = 2,
         controller = 3,
-        /* your sub-system here */
+        kafka = 4,
+        /* your sub-system here (bump num_key_spaces) */
     };
 
+    static constexpr int8_t num_key_spaces = 5;
+
     explicit kvstore(kvstore_config kv_conf);
 
     ss::future<> start();
@@ -118,6 +124,8 @@ private:
     ntp_config _ntpc;
     ss::gate _gate;
     ss::abort_source _as;
+    // legacy whole-store snapshot; read once for upgrades and removed
+    // after the first per-space snapshot save
     snapshot_manager _snap;
     bool _started{false};
 
@@ -143,15 +151,68 @@ private:
     std::vector<op> _ops;
     ss::timer<> _timer;
     ss::semaphore _sem{0};
+    bool _flush_in_flight{false};
     ss::lw_shared_ptr<segment> _segment;
     model::offset _next_offset;
     absl::flat_hash_map<bytes, iobuf, bytes_type_hash, bytes_type_eq> _db;
 
+    /*
+     * Incremental snapshots.
+     *
+     * A full snapshot rewrites the entire database, so on brokers with many
+     * partitions its cost dwarfs the handful of keys that actually changed
+     * since the last roll. Instead of snapshotting on every roll, rolled
+     * segments are retained as deltas and replayed at startup, and a full
+     * snapshot is only taken once the bytes logged since the last snapshot
+     * are on the order of the database size (constant write amplification)
+     * or the number of retained segments reaches a bound on recovery time.
+     */
+    static constexpr size_t max_deferred_segments = 8;
+
+    struct deferred_segment {
+        ss::sstring data_file;
+        ss::sstring index_file;
+    };
+
+    std::vector<deferred_segment> _deferred_segments;
+    size_t _dirty_bytes{0};
+
+    /*
+     * Key-space partitioned snapshots.
+     *
+     * Key classes have very different update rates: raft bookkeeping
+     * (voted_for, offsets) churns constantly while configuration data is
+     * nearly immutable. The snapshot is therefore one file per key space
+     * ("snapshot.<n>") and collapsing the log only rewrites the spaces
+     * that were actually dirtied since their last snapshot - hot raft
+     * keys never force a rewrite of cold configuration state.
+     *
+     * A clean space's snapshot stays valid through the collapse offset
+     * because the deleted segments contained no operations for it, so
+     * recovery replays the retained segments from the newest snapshot
+     * offset as before.
+     */
+    struct space {
+        explicit space(snapshot_manager s)
+          : snap(std::move(s)) {}
+        snapshot_manager snap;
+        // bytes logged for this space since its snapshot was written
+        size_t dirty_bytes{0};
+        // a snapshot file for this space exists on disk
+        bool has_snapshot{false};
+    };
+    std::vector<space> _spaces;
+    // set when state was restored from the legacy whole-store snapshot;
+    // forces a per-space rewrite before the legacy file is removed
+    bool _legacy_snapshot_loaded{false};
+
     ss::future<> put(key_space ks, bytes key, std::optional<iobuf> value);
     void apply_op(bytes key, std::optional<iobuf> value);
     ss::future<> flush_and_apply_ops();
     ss::future<> roll();
     ss::future<> save_snapshot();
+    ss::future<> save_space_snapshot(key_space, model::offset last_offset);
+    ss::future<> remove_deferred_segments();
 
     /*
      * Recovery
@@ -161,6 +222,9 @@ private:
      */
     ss::future<> recover();
     void load_snapshot_in_thread();
+    // restore keys from one snapshot stream; returns the last log offset
+    // the snapshot is valid through
+    model::offset load_snapshot_reader_in_thread(snapshot_reader&);
     void replay_segments_in_thread(segment_set);
 
     /**
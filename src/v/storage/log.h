@@ -15,7 +15,9 @@
 #include "model/timeout_clock.h"
 #include "model/timestamp.h"
 #include "seastarx.h"
+#include "storage/batch_cache.h"
 #include "storage/log_appender.h"
+#include "storage/log_verifier.h"
 #include "storage/segment_reader.h"
 #include "storage/types.h"
 
@@ -64,6 +66,18 @@ public:
         virtual ss::future<std::optional<timequery_result>>
           timequery(timequery_config) = 0;
 
+        virtual ss::future<log_verify_result> verify() = 0;
+
+        virtual batch_cache::pin_guard
+          pin_cached_range(model::offset, model::offset) = 0;
+
+        virtual log_io_rates io_rates() = 0;
+
+        virtual ss::future<size_t>
+          upgrade_stale_segments(compaction_config, size_t bytes_budget) = 0;
+
+        virtual ss::future<size_t> flush_dirty_indices() = 0;
+
         const ntp_config& config() const { return _config; }
 
         virtual size_t segment_count() const = 0;
@@ -138,6 +152,67 @@ public:
 
     ss::future<> compact(compaction_config cfg) { return _impl->compact(cfg); }
 
+    /**
+     * \brief Re-parse and checksum every sealed segment of this log
+     *
+     * The active segment (one with an attached appender) is skipped
+     * since its tail may race ongoing writes. See storage/log_verifier.h
+     * for the engine and result semantics.
+     */
+    ss::future<log_verify_result> verify() { return _impl->verify(); }
+
+    /**
+     * \brief Pin cached batches covering [begin, end] in the batch cache
+     *
+     * The returned lease keeps the covered entries out of reach of the
+     * memory reclaimer until released. Raft holds one per append over the
+     * uncommitted tail so follower dispatch and commit apply read fresh
+     * batches from memory instead of falling back to disk when the cache
+     * is under pressure. Batches not cached at call time are simply not
+     * covered, and truncation removes entries from under the lease safely.
+     */
+    batch_cache::pin_guard pin_cached_range(
+      model::offset begin, model::offset end) {
+        return _impl->pin_cached_range(begin, end);
+    }
+
+    /**
+     * \brief Rolling-window io rates of this log (see storage::log_io_rates)
+     *
+     * Snapshot of what the log is doing right now rather than lifetime
+     * totals; used by the hot-partition admin query.
+     */
+    log_io_rates io_rates() { return _impl->io_rates(); }
+
+    /**
+     * \brief Rewrite sealed segments still in an older on-disk format
+     *
+     * Walks sealed segments past the persisted upgrade watermark and
+     * rewrites any whose format predates storage::latest_segment_version,
+     * spending at most \p bytes_budget bytes of rewrite io. Returns the
+     * bytes actually rewritten so the caller (the housekeeping loop) can
+     * spread a shard-wide budget across logs. A no-op when every segment
+     * is already current.
+     */
+    ss::future<size_t>
+    upgrade_stale_segments(compaction_config cfg, size_t bytes_budget) {
+        return _impl->upgrade_stale_segments(cfg, bytes_budget);
+    }
+
+    /**
+     * \brief Persist the index state of every dirty segment of this log
+     *
+     * Writes are issued for all dirty indices first and a single group of
+     * durability barriers follows, instead of a write/sync pair per index.
+     * Segments whose indices are unchanged since the last flush are not
+     * touched at all. Returns the number of indices written. Driven
+     * periodically by the housekeeping loop to bound how much index state
+     * replay has to rebuild after a crash.
+     */
+    ss::future<size_t> flush_dirty_indices() {
+        return _impl->flush_dirty_indices();
+    }
+
     /**
      * \brief Returns a future that resolves when log eviction is scheduled
      *
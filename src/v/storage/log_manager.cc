@@ -13,6 +13,7 @@
 #include "likely.h"
 #include "model/fundamental.h"
 #include "model/timestamp.h"
+#include "reflection/adl.h"
 #include "storage/batch_cache.h"
 #include "storage/compacted_index_writer.h"
 #include "storage/fs_utils.h"
@@ -59,14 +60,16 @@ log_manager::log_manager(log_config config, kvstore& kvstore) noexcept
 void log_manager::trigger_housekeeping() {
     (void)ss::with_gate(_open_gate, [this] {
         auto next_housekeeping = _jitter();
-        return housekeeping().finally([this, next_housekeeping] {
-            // all of these *MUST* be in the finally
-            if (_open_gate.is_closed()) {
-                return;
-            }
+        return ss::with_scheduling_group(
+                 _config.compaction_sg, [this] { return housekeeping(); })
+          .finally([this, next_housekeeping] {
+              // all of these *MUST* be in the finally
+              if (_open_gate.is_closed()) {
+                  return;
+              }
 
-            _compaction_timer.rearm(next_housekeeping);
-        });
+              _compaction_timer.rearm(next_housekeeping);
+          });
     }).handle_exception([](std::exception_ptr e) {
         vlog(stlog.info, "Error processing housekeeping(): {}", e);
     });
@@ -75,19 +78,39 @@ void log_manager::trigger_housekeeping() {
 ss::future<> log_manager::stop() {
     _compaction_timer.cancel();
     _abort_source.request_abort();
-    return _open_gate.close().then([this] {
-        return ss::parallel_for_each(_logs, [](logs_type::value_type& entry) {
-            return entry.second.handle.close();
-        });
-    });
+    return _open_gate.close()
+      .then([this] {
+          return ss::parallel_for_each(
+            _logs, [](logs_type::value_type& entry) {
+                return entry.second.handle.close();
+            });
+      })
+      .then([this] { return _flusher.stop(); });
 }
 
+/**
+ * \brief Find the most overdue log that has not been serviced this pass.
+ *
+ * Ordering by last_compaction means that when a pass is cut short (e.g.
+ * shutdown, or a shard with more partitions than it can service in one
+ * interval) the logs furthest behind on retention are always handled
+ * first on the next pass, instead of whichever ones hash iteration
+ * happens to visit.
+ */
 inline logs_type::iterator find_next_non_compacted_log(logs_type& logs) {
     using bflags = log_housekeeping_meta::bitflags;
-    return std::find_if(
-      logs.begin(), logs.end(), [](const logs_type::value_type& l) {
-          return bflags::none == (l.second.flags & bflags::compacted);
-      });
+    auto next = logs.end();
+    for (auto it = logs.begin(); it != logs.end(); ++it) {
+        if (bflags::none != (it->second.flags & bflags::compacted)) {
+            continue;
+        }
+        if (
+          next == logs.end()
+          || it->second.last_compaction < next->second.last_compaction) {
+            next = it;
+        }
+    }
+    return next;
 }
 ss::future<> log_manager::housekeeping() {
     auto collection_threshold = model::timestamp(
@@ -108,32 +131,117 @@ ss::future<> log_manager::housekeeping() {
      * hotpath / (request-response)
      */
     using bflags = log_housekeeping_meta::bitflags;
-    return ss::do_until(
-             [this] {
-                 auto it = find_next_non_compacted_log(_logs);
-                 return it == _logs.end();
-             },
-             [this, collection_threshold] {
-                 auto it = find_next_non_compacted_log(_logs);
-                 if (it == _logs.end()) {
-                     // must check again because between the stop condition
-                     // and this continuation we might have removed the log
-                     return ss::now();
-                 }
-                 it->second.flags |= bflags::compacted;
-                 it->second.last_compaction = ss::lowres_clock::now();
-                 return it->second.handle.compact(compaction_config(
-                   collection_threshold,
-                   // TODO: [ch433] - this configuration needs to be updated
-                   _config.retention_bytes,
-                   // TODO: change default priority in application.cc
-                   ss::default_priority_class(),
-                   _abort_source));
+    // service a couple of logs at a time so one large compaction does not
+    // stall retention enforcement for the rest of the shard
+    constexpr size_t concurrency = 2;
+    return ss::do_with(
+             ss::semaphore(concurrency),
+             [this, collection_threshold](ss::semaphore& limit) {
+                 return ss::do_until(
+                          [this] {
+                              return find_next_non_compacted_log(_logs)
+                                     == _logs.end();
+                          },
+                          [this, collection_threshold, &limit] {
+                              return dispatch_housekeeping_one(
+                                limit, collection_threshold);
+                          })
+                   // wait for the in-flight compactions; the housekeeping
+                   // gate is held until this resolves
+                   .then([&limit] { return limit.wait(concurrency); });
              })
       .finally([this] {
           for (auto& h : _logs) {
               h.second.flags &= ~bflags::compacted;
           }
+      })
+      .then([this] { return format_upgrade_round(); })
+      .then([this] { return index_flush_round(); });
+}
+
+ss::future<> log_manager::index_flush_round() {
+    if (_abort_source.abort_requested()) {
+        return ss::now();
+    }
+    // all logs flush concurrently so the write phases of the whole shard
+    // coalesce and the durability barriers land together, instead of a
+    // scattered write/sync pair per segment over the housekeeping period
+    return ss::do_with(logs(), [](std::vector<log>& all) {
+        return ss::parallel_for_each(all, [](log& l) {
+            return l.flush_dirty_indices().discard_result().handle_exception(
+              [](std::exception_ptr e) {
+                  vlog(stlog.info, "Error flushing segment indices: {}", e);
+              });
+        });
+    });
+}
+
+ss::future<> log_manager::format_upgrade_round() {
+    if (
+      _config.format_upgrade_bytes_per_round == 0
+      || _abort_source.abort_requested()) {
+        return ss::now();
+    }
+    return ss::do_with(
+      logs(),
+      _config.format_upgrade_bytes_per_round,
+      [this](std::vector<log>& all, size_t& budget) {
+          return ss::do_for_each(all, [this, &budget](log& l) {
+              if (budget == 0 || _abort_source.abort_requested()) {
+                  return ss::now();
+              }
+              return l
+                .upgrade_stale_segments(
+                  compaction_config(
+                    model::timestamp::min(),
+                    std::nullopt,
+                    ss::default_priority_class(),
+                    _abort_source,
+                    _config.sanitize_fileops),
+                  budget)
+                .then(
+                  [&budget](size_t used) { budget -= std::min(budget, used); })
+                .handle_exception([](std::exception_ptr e) {
+                    vlog(stlog.info, "Error upgrading segment format: {}", e);
+                });
+          });
+      });
+}
+
+ss::future<> log_manager::dispatch_housekeeping_one(
+  ss::semaphore& limit, model::timestamp collection_threshold) {
+    using bflags = log_housekeeping_meta::bitflags;
+    return ss::get_units(limit, 1)
+      .then([this, collection_threshold](ss::semaphore_units<> units) {
+          auto it = find_next_non_compacted_log(_logs);
+          if (it == _logs.end()) {
+              // must check again because between the stop condition
+              // and this continuation we might have removed the log
+              return;
+          }
+          it->second.flags |= bflags::compacted;
+          it->second.last_compaction = ss::lowres_clock::now();
+          // ephemeral partitions live entirely in memory; the per-partition
+          // budget bounds them regardless of the disk retention settings
+          auto max_bytes = it->second.handle.config().is_ephemeral()
+                             ? std::make_optional(
+                               _config.ephemeral_retention_bytes)
+                             : _config.retention_bytes;
+          // runs in the background of the housekeeping pass; the units are
+          // released when the compaction finishes and drained before
+          // housekeeping() resolves
+          (void)it->second.handle
+            .compact(compaction_config(
+              collection_threshold,
+              // TODO: [ch433] - this configuration needs to be updated
+              max_bytes,
+              // TODO: change default priority in application.cc
+              ss::default_priority_class(),
+              _abort_source))
+            .handle_exception([](std::exception_ptr e) {
+                vlog(stlog.info, "Error compacting log: {}", e);
+            })
+            .finally([units = std::move(units)] {});
       });
 }
 ss::future<ss::lw_shared_ptr<segment>> log_manager::make_log_segment(
@@ -193,7 +301,8 @@ ss::future<log> log_manager::do_manage(ntp_config cfg) {
     vassert(
       _logs.find(cfg.ntp()) == _logs.end(), "cannot double register same ntp");
 
-    if (_config.stype == log_config::storage_type::memory) {
+    if (
+      _config.stype == log_config::storage_type::memory || cfg.is_ephemeral()) {
         auto path = cfg.work_directory();
         auto l = storage::make_memory_backed_log(std::move(cfg));
         _logs.emplace(l.config().ntp(), l);
@@ -203,11 +312,27 @@ ss::future<log> log_manager::do_manage(ntp_config cfg) {
 
     return recover_log_state(cfg).then([this, cfg = std::move(cfg)]() mutable {
         ss::sstring path = cfg.work_directory();
+        /*
+         * if the log was closed cleanly then its last segment does not need
+         * checksum replay. the marker is removed below: it is only valid for
+         * the startup that consumes it.
+         */
+        std::optional<ss::sstring> last_clean_segment;
+        if (auto clean = _kvstore.get(
+              kvstore::key_space::storage,
+              internal::clean_segment_key(cfg.ntp()));
+            clean) {
+            last_clean_segment = reflection::from_iobuf<
+                                   internal::clean_segment_value>(
+                                   std::move(*clean))
+                                   .segment_name;
+        }
         return recover_segments(
                  std::filesystem::path(path),
                  _config.sanitize_fileops,
                  cfg.is_compacted(),
                  [this] { return create_cache(); },
+                 std::move(last_clean_segment),
                  _abort_source)
           .then([this, cfg = std::move(cfg)](segment_set segments) mutable {
               auto l = storage::make_disk_backed_log(
@@ -215,7 +340,11 @@ ss::future<log> log_manager::do_manage(ntp_config cfg) {
               auto [_, success] = _logs.emplace(l.config().ntp(), l);
               vassert(
                 success, "Could not keep track of:{} - concurrency issue", l);
-              return l;
+              return _kvstore
+                .remove(
+                  kvstore::key_space::storage,
+                  internal::clean_segment_key(l.config().ntp()))
+                .then([l] { return l; });
           });
     });
 }
@@ -279,6 +408,25 @@ log_manager::get(const model::topic_namespace& tn) {
     return r;
 }
 
+std::vector<log> log_manager::logs() const {
+    std::vector<log> r;
+    r.reserve(_logs.size());
+    for (const auto& p : _logs) {
+        r.push_back(p.second.handle);
+    }
+    return r;
+}
+
+std::vector<log_io_rates> log_manager::io_rates() const {
+    std::vector<log_io_rates> r;
+    r.reserve(_logs.size());
+    for (const auto& p : _logs) {
+        auto handle = p.second.handle;
+        r.push_back(handle.io_rates());
+    }
+    return r;
+}
+
 std::ostream& operator<<(std::ostream& o, log_config::storage_type t) {
     switch (t) {
     case log_config::storage_type::memory:
@@ -12,9 +12,11 @@
 #pragma once
 
 #include "model/fundamental.h"
+#include "model/timestamp.h"
 #include "random/simple_time_jitter.h"
 #include "seastarx.h"
 #include "storage/batch_cache.h"
+#include "storage/flush_coordinator.h"
 #include "storage/kvstore.h"
 #include "storage/log.h"
 #include "storage/log_housekeeping_meta.h"
@@ -29,6 +31,8 @@
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/lowres_clock.hh>
+#include <seastar/core/scheduling.hh>
+#include <seastar/core/semaphore.hh>
 #include <seastar/core/sstring.hh>
 
 #include <absl/container/flat_hash_map.h>
@@ -105,7 +109,16 @@ struct log_config {
     std::chrono::milliseconds compaction_interval = std::chrono::minutes(10);
     // same as delete.retention.ms in kafka - default 1 week
     std::chrono::milliseconds delete_retention = std::chrono::minutes(10080);
+    // per-partition memory budget for ephemeral (memory-only) partitions;
+    // retention eviction keeps each of them under this many bytes
+    size_t ephemeral_retention_bytes = 128_MiB;
+    // shard-wide rewrite io spent per housekeeping pass migrating sealed
+    // segments to the newest on-disk format; 0 disables the migration
+    size_t format_upgrade_bytes_per_round = 64_MiB;
     with_cache cache = log_config::with_cache::yes;
+    // scheduling group housekeeping (compaction/retention) runs in; the
+    // default group is used unless the application provides one
+    ss::scheduling_group compaction_sg;
     batch_cache::reclaim_options reclaim_opts{
       .growth_window = std::chrono::seconds(3),
       .stable_window = std::chrono::seconds(10),
@@ -178,6 +191,9 @@ public:
 
     const log_config& config() const { return _config; }
 
+    /// Shard wide flush barrier shared by all managed logs
+    flush_coordinator& flusher() { return _flusher; }
+
     /// Returns the number of managed logs.
     size_t size() const { return _logs.size(); }
 
@@ -192,6 +208,14 @@ public:
     /// Returns the logs that match a model::topic_namespace
     absl::flat_hash_map<model::ntp, log> get(const model::topic_namespace&);
 
+    /// Snapshot of every managed log, for maintenance walks (e.g. the
+    /// verification engine). Handles stay valid if logs are removed.
+    std::vector<log> logs() const;
+
+    /// Rolling-window io rates of every managed log, for the hot-partition
+    /// admin query. Cheap: reads each log's probe, no io.
+    std::vector<log_io_rates> io_rates() const;
+
 private:
     using logs_type = absl::flat_hash_map<model::ntp, log_housekeeping_meta>;
 
@@ -204,6 +228,27 @@ private:
     void trigger_housekeeping();
     void arm_housekeeping();
     ss::future<> housekeeping();
+    ss::future<> dispatch_housekeeping_one(
+      ss::semaphore& limit, model::timestamp collection_threshold);
+    /**
+     * \brief migrate sealed segments to the newest on-disk format
+     *
+     * Runs at the tail of each housekeeping pass, spreading
+     * log_config::format_upgrade_bytes_per_round of rewrite io across the
+     * managed logs. Once every segment is current the round degenerates
+     * into a cheap per-log watermark check.
+     */
+    ss::future<> format_upgrade_round();
+
+    /**
+     * \brief persist dirty segment indices across the shard in one batch
+     *
+     * Runs at the tail of each housekeeping pass. Indices unchanged since
+     * their last flush are skipped entirely; the rest are written first
+     * and synced together (see log::flush_dirty_indices), which smooths
+     * the periodic sawtooth of scattered small index writes.
+     */
+    ss::future<> index_flush_round();
 
     std::optional<batch_cache_index> create_cache();
 
@@ -216,6 +261,7 @@ private:
     ss::timer<ss::lowres_clock> _compaction_timer;
     logs_type _logs;
     batch_cache _batch_cache;
+    flush_coordinator _flusher;
     ss::gate _open_gate;
     ss::abort_source _abort_source;
 
@@ -40,31 +40,31 @@ batch_consumer::consume_result skipping_consumer::consume_batch_start(
     }
     _expected_next_batch = header.last_offset() + model::offset(1);
 
-    if (header.last_offset() < _reader._config.start_offset) {
+    if (header.last_offset() < _reader._config->start_offset) {
         return skip_batch::yes;
     }
-    if (header.base_offset() > _reader._config.max_offset) {
+    if (header.base_offset() > _reader._config->max_offset) {
         return stop_parser::yes;
     }
     if (
-      _reader._config.type_filter
-      && _reader._config.type_filter != header.type) {
-        _reader._config.start_offset = header.last_offset() + model::offset(1);
+      _reader._config->type_filter
+      && _reader._config->type_filter != header.type) {
+        _reader._config->start_offset = header.last_offset() + model::offset(1);
         return skip_batch::yes;
     }
-    if (_reader._config.first_timestamp > header.first_timestamp) {
+    if (_reader._config->first_timestamp > header.first_timestamp) {
         // kakfa needs to guarantee that the returned record is >=
         // first_timestamp
-        _reader._config.start_offset = header.last_offset() + model::offset(1);
+        _reader._config->start_offset = header.last_offset() + model::offset(1);
         return skip_batch::yes;
     }
 
     if (
-      (_reader._config.strict_max_bytes || _reader._config.bytes_consumed)
-      && (_reader._config.bytes_consumed + header.size_bytes)
-           > _reader._config.max_bytes) {
+      (_reader._config->strict_max_bytes || _reader._config->bytes_consumed)
+      && (_reader._config->bytes_consumed + header.size_bytes)
+           > _reader._config->max_bytes) {
         // signal to log reader to stop (see log_reader::is_done)
-        _reader._config.over_budget = true;
+        _reader._config->over_budget = true;
         return stop_parser::yes;
     }
 
@@ -85,7 +85,7 @@ batch_consumer::stop_parser skipping_consumer::consume_batch_end() {
     // We keep the batch in the buffer so that the reader can be cached.
     if (
       _header.last_offset() >= _reader._seg.offsets().stable_offset
-      || _header.last_offset() >= _reader._config.max_offset) {
+      || _header.last_offset() >= _reader._config->max_offset) {
         return stop_parser::yes;
     }
     /*
@@ -96,7 +96,7 @@ batch_consumer::stop_parser skipping_consumer::consume_batch_end() {
         return stop_parser::yes;
     }
     if (
-      _reader._config.bytes_consumed >= _reader._config.max_bytes
+      _reader._config->bytes_consumed >= _reader._config->max_bytes
       || model::timeout_clock::now() >= _timeout) {
         return stop_parser::yes;
     }
@@ -111,16 +111,21 @@ void skipping_consumer::print(std::ostream& os) const {
 log_segment_batch_reader::log_segment_batch_reader(
   segment& seg, log_reader_config& config, probe& p) noexcept
   : _seg(seg)
-  , _config(config)
+  , _config(&config)
   , _probe(p) {}
 
 std::unique_ptr<continuous_batch_parser> log_segment_batch_reader::initialize(
   model::timeout_clock::time_point timeout,
   std::optional<model::offset> next_cached_batch) {
-    auto input = _seg.offset_data_stream(_config.start_offset, _config.prio);
+    auto input = _seg.offset_data_stream(
+      _config->start_offset,
+      _config->prio,
+      _config->cold_read ? cold_read_hint::yes : cold_read_hint::no);
+    auto consumer = std::make_unique<skipping_consumer>(
+      *this, timeout, next_cached_batch);
+    _consumer = consumer.get();
     return std::make_unique<continuous_batch_parser>(
-      std::make_unique<skipping_consumer>(*this, timeout, next_cached_batch),
-      std::move(input));
+      std::move(consumer), std::move(input));
 }
 
 ss::future<> log_segment_batch_reader::close() {
@@ -133,12 +138,12 @@ ss::future<> log_segment_batch_reader::close() {
 void log_segment_batch_reader::add_one(model::record_batch&& batch) {
     _state.buffer.emplace_back(std::move(batch));
     const auto& b = _state.buffer.back();
-    _config.start_offset = b.header().last_offset() + model::offset(1);
+    _config->start_offset = b.header().last_offset() + model::offset(1);
     const auto size_bytes = b.header().size_bytes;
-    _config.bytes_consumed += size_bytes;
+    _config->bytes_consumed += size_bytes;
     _state.buffer_size += size_bytes;
     _probe.add_bytes_read(size_bytes);
-    if (!_config.skip_batch_cache) {
+    if (!_config->skip_batch_cache) {
         _seg.cache_put(b);
     }
 }
@@ -149,21 +154,21 @@ log_segment_batch_reader::read_some(model::timeout_clock::time_point timeout) {
      * end is either the configured max offset or the end of the segment.
      */
     auto cache_read = _seg.cache_get(
-      _config.start_offset,
-      _config.max_offset,
-      _config.type_filter,
-      _config.first_timestamp,
+      _config->start_offset,
+      _config->max_offset,
+      _config->type_filter,
+      _config->first_timestamp,
       max_buffer_size,
-      _config.skip_batch_cache);
+      _config->skip_batch_cache);
 
     // handles cases where the type filter skipped batches. see
     // batch_cache_index::read for more details.
-    _config.start_offset = cache_read.next_batch;
+    _config->start_offset = cache_read.next_batch;
 
     if (
       !cache_read.batches.empty()
-      || _config.start_offset > _config.max_offset) {
-        _config.bytes_consumed += cache_read.memory_usage;
+      || _config->start_offset > _config->max_offset) {
+        _config->bytes_consumed += cache_read.memory_usage;
         _probe.add_bytes_read(cache_read.memory_usage);
         _probe.add_cached_bytes_read(cache_read.memory_usage);
         _probe.add_cached_batches_read(cache_read.batches.size());
@@ -177,12 +182,16 @@ log_segment_batch_reader::read_some(model::timeout_clock::time_point timeout) {
      * visible to the reader. however, we need to enforce visibility rules for
      * on disk reads which is bound by the stable offset.
      */
-    if (_config.start_offset > _seg.offsets().stable_offset) {
+    if (_config->start_offset > _seg.offsets().stable_offset) {
         return ss::make_ready_future<result<records_t>>(records_t{});
     }
 
     if (!_iterator) {
         _iterator = initialize(timeout, cache_read.next_cached_batch);
+    } else {
+        // an iterator resumed from a parked reader still carries the timeout
+        // of the fetch that parked it
+        _consumer->set_timeout(timeout);
     }
     auto ptr = _iterator.get();
     return ptr->consume().then(
@@ -195,6 +204,16 @@ log_segment_batch_reader::read_some(model::timeout_clock::time_point timeout) {
       });
 }
 
+ss::future<> parked_reader::close() {
+    if (!reader) {
+        lease.reset();
+        return ss::make_ready_future<>();
+    }
+    auto raw = reader.get();
+    return raw->close().finally(
+      [r = std::move(reader), l = std::move(lease)] {});
+}
+
 log_reader::log_reader(
   std::unique_ptr<lock_manager::lease> l,
   log_reader_config config,
@@ -221,6 +240,142 @@ log_reader::log_reader(
     }
 }
 
+log_reader::log_reader(
+  parked_reader parked, log_reader_config config, probe& probe) noexcept
+  : _lease(std::move(parked.lease))
+  , _iterator(parked.next_seg)
+  , _config(config)
+  , _probe(probe) {
+    if (config.abort_source) {
+        auto op_sub = config.abort_source.value().get().subscribe(
+          [this]() noexcept { set_end_of_stream(); });
+
+        if (op_sub) {
+            _as_sub = std::move(*op_sub);
+        } else {
+            // already aborted
+            set_end_of_stream();
+        }
+    }
+
+    _iterator.reader = std::move(parked.reader);
+    _iterator.reader->rebind_config(_config);
+}
+
+ss::future<> log_reader::finally() noexcept {
+    /*
+     * hand still-open reader state back to the log instead of tearing it
+     * down: a follow-up fetch starting at _config.start_offset resumes the
+     * open stream and parser without re-opening and re-seeking the segment.
+     * on error and end-of-stream paths do_load_slice() already closed the
+     * iterator, so only healthy mid-log readers are parked.
+     */
+    if (_parker && _iterator.reader && !is_end_of_stream()) {
+        auto next_seg = _iterator.next_seg;
+        _parker(parked_reader{
+          .lease = std::move(_lease),
+          .next_seg = next_seg,
+          .reader = std::move(_iterator.reader),
+          .config = _config,
+          .parked_at = ss::lowres_clock::now()});
+        return close_prefetch();
+    }
+    return close_prefetch().then([this] { return _iterator.close(); });
+}
+
+void log_reader::maybe_prefetch_next_segment(
+  model::timeout_clock::time_point timeout) {
+    if (
+      !_config.cross_segment_prefetch || _prefetch
+      || _config.strict_max_bytes) {
+        return;
+    }
+    // only worth starting once the current segment is drained; an earlier
+    // prefetch would be torn down by the mid-segment slices that follow
+    if (_config.start_offset <= _iterator.offsets().dirty_offset) {
+        return;
+    }
+    auto next = std::next(_iterator.next_seg);
+    if (next == _lease->range.end()) {
+        return;
+    }
+    const auto& offsets = (*next)->offsets();
+    if (
+      offsets.base_offset > _config.max_offset
+      || _config.bytes_consumed >= _config.max_bytes) {
+        return;
+    }
+    // the prefetch runs against a private config copy with the remaining
+    // byte budget; adoption folds the consumed state back into _config
+    auto cfg = _config;
+    cfg.start_offset = offsets.base_offset;
+    cfg.min_bytes = 0;
+    cfg.max_bytes = _config.max_bytes - _config.bytes_consumed;
+    cfg.bytes_consumed = 0;
+    cfg.over_budget = false;
+    auto& pf = _prefetch.emplace(next, cfg);
+    pf.reader = std::make_unique<log_segment_batch_reader>(
+      **next, pf.config, _probe);
+    pf.data = pf.reader->read_some(timeout);
+}
+
+ss::future<result<records_t>> log_reader::adopt_prefetch() {
+    return std::move(_prefetch->data)
+      .then_wrapped([this](ss::future<result<records_t>> f) {
+          auto pf = std::move(*_prefetch);
+          _prefetch.reset();
+          auto raw = pf.reader.get();
+          if (f.failed()) {
+              auto e = f.get_exception();
+              return raw->close()
+                .then([e] {
+                    return ss::make_exception_future<result<records_t>>(e);
+                })
+                .finally([r = std::move(pf.reader)] {});
+          }
+          auto recs = f.get0();
+          if (!recs) {
+              return raw->close()
+                .then([recs = std::move(recs)]() mutable {
+                    return ss::make_ready_future<result<records_t>>(
+                      std::move(recs));
+                })
+                .finally([r = std::move(pf.reader)] {});
+          }
+          // the prefetched reader replaces the one find_next_valid_iterator
+          // created for the segment; it keeps the open stream and parser
+          _config.start_offset = pf.config.start_offset;
+          _config.bytes_consumed += pf.config.bytes_consumed;
+          _config.over_budget = _config.over_budget || pf.config.over_budget;
+          auto old = std::move(_iterator.reader);
+          _iterator.reader = std::move(pf.reader);
+          _iterator.reader->rebind_config(_config);
+          auto old_raw = old.get();
+          return old_raw->close()
+            .then([recs = std::move(recs)]() mutable {
+                return ss::make_ready_future<result<records_t>>(
+                  std::move(recs));
+            })
+            .finally([r = std::move(old)] {});
+      });
+}
+
+ss::future<> log_reader::close_prefetch() {
+    if (!_prefetch) {
+        return ss::make_ready_future<>();
+    }
+    // wait the in-flight read out before moving the state: the segment
+    // reader dereferences the state's config until the read resolves
+    return std::move(_prefetch->data)
+      .then_wrapped([this](ss::future<result<records_t>> f) {
+          f.ignore_ready_future();
+          auto pf = std::move(*_prefetch);
+          _prefetch.reset();
+          auto raw = pf.reader.get();
+          return raw->close().finally([r = std::move(pf.reader)] {});
+      });
+}
+
 ss::future<> log_reader::find_next_valid_iterator() {
     if (_config.start_offset <= _iterator.offsets().dirty_offset) {
         return ss::make_ready_future<>();
@@ -266,7 +421,18 @@ log_reader::do_load_slice(model::timeout_clock::time_point timeout) {
         return fut.then([] { return ss::make_ready_future<storage_t>(); });
     }
     return fut
-      .then([this, timeout] { return _iterator.reader->read_some(timeout); })
+      .then([this, timeout]() -> ss::future<result<records_t>> {
+          if (_prefetch) {
+              if (_prefetch->seg == _iterator.next_seg) {
+                  return adopt_prefetch();
+              }
+              // a skip moved the iterator off the prefetched segment
+              return close_prefetch().then([this, timeout] {
+                  return _iterator.reader->read_some(timeout);
+              });
+          }
+          return _iterator.reader->read_some(timeout);
+      })
       .then([this, timeout](result<records_t> recs) -> ss::future<storage_t> {
           if (!recs) {
               set_end_of_stream();
@@ -288,6 +454,7 @@ log_reader::do_load_slice(model::timeout_clock::time_point timeout) {
               return do_load_slice(timeout);
           }
           _probe.add_batches_read(recs.value().size());
+          maybe_prefetch_next_segment(timeout);
           return ss::make_ready_future<storage_t>(std::move(recs.value()));
       })
       .handle_exception([this](std::exception_ptr e) {
@@ -23,6 +23,8 @@
 
 #include <seastar/core/circular_buffer.hh>
 #include <seastar/core/io_queue.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/util/noncopyable_function.hh>
 #include <seastar/util/optimized_optional.hh>
 
 /**
@@ -70,6 +72,10 @@ public:
     stop_parser consume_batch_end() override;
     void print(std::ostream&) const override;
 
+    // a reader resumed from a parked state carries the timeout of the fetch
+    // that parked it; the owning reader refreshes it on every read
+    void set_timeout(model::timeout_clock::time_point t) { _timeout = t; }
+
 private:
     log_segment_batch_reader& _reader;
     model::record_batch_header _header;
@@ -98,6 +104,10 @@ public:
 
     ss::future<> close();
 
+    // a parked reader outlives the log_reader whose config it was bound to;
+    // the resuming log_reader re-points it at its own config
+    void rebind_config(log_reader_config& cfg) { _config = &cfg; }
+
 private:
     std::unique_ptr<continuous_batch_parser> initialize(
       model::timeout_clock::time_point,
@@ -113,23 +123,47 @@ private:
     };
 
     segment& _seg;
-    log_reader_config& _config;
+    log_reader_config* _config;
     probe& _probe;
 
     std::unique_ptr<continuous_batch_parser> _iterator;
+    // owned by _iterator; valid for as long as _iterator is
+    skipping_consumer* _consumer{nullptr};
     tmp_state _state;
     friend class skipping_consumer;
 };
 
+/**
+ * Open reader state salvaged when a fetch finishes, so that the next
+ * sequential fetch over the same range can resume the open stream, file
+ * handle and parser instead of re-opening and re-seeking the segment.
+ * Owned by disk_log_impl which keys parked readers by next read offset.
+ */
+struct parked_reader {
+    std::unique_ptr<lock_manager::lease> lease;
+    segment_set::iterator next_seg;
+    std::unique_ptr<log_segment_batch_reader> reader;
+    log_reader_config config;
+    ss::lowres_clock::time_point parked_at;
+
+    model::offset next_offset() const { return config.start_offset; }
+    ss::future<> close();
+};
+
 class log_reader final : public model::record_batch_reader::impl {
 public:
     using data_t = model::record_batch_reader::data_t;
     using foreign_data_t = model::record_batch_reader::foreign_data_t;
     using storage_t = model::record_batch_reader::storage_t;
 
+    using parker = ss::noncopyable_function<void(parked_reader)>;
+
     log_reader(
       std::unique_ptr<lock_manager::lease>, log_reader_config, probe&) noexcept;
 
+    /// resume from the state parked by a previous reader over the same range
+    log_reader(parked_reader, log_reader_config, probe&) noexcept;
+
     ~log_reader() final {
         vassert(!_iterator.reader, "log reader destroyed with live reader");
     }
@@ -140,7 +174,11 @@ public:
 
     ss::future<storage_t> do_load_slice(model::timeout_clock::time_point) final;
 
-    ss::future<> finally() noexcept final { return _iterator.close(); }
+    ss::future<> finally() noexcept final;
+
+    /// when set, finally() hands still-open reader state back to the owner
+    /// instead of closing it, so the next sequential fetch can resume it
+    void set_parker(parker p) { _parker = std::move(p); }
 
     void print(std::ostream& os) final {
         fmt::print(os, "storage::log_reader. config {}", _config);
@@ -151,6 +189,32 @@ private:
     bool is_done();
     ss::future<> find_next_valid_iterator();
 
+    /**
+     * first slice of the following segment, read eagerly while the consumer
+     * drains the tail of the current one (see
+     * log_reader_config::cross_segment_prefetch). the segment reader points
+     * at the state's private config copy until adoption rebinds it to the
+     * log_reader's own config; the state must therefore stay at a stable
+     * address while the read is in flight.
+     */
+    struct prefetch_state {
+        prefetch_state(segment_set::iterator it, log_reader_config cfg)
+          : seg(it)
+          , config(cfg) {}
+        segment_set::iterator seg;
+        log_reader_config config;
+        std::unique_ptr<log_segment_batch_reader> reader;
+        ss::future<result<ss::circular_buffer<model::record_batch>>> data
+          = ss::make_ready_future<
+            result<ss::circular_buffer<model::record_batch>>>(
+            ss::circular_buffer<model::record_batch>{});
+    };
+
+    void maybe_prefetch_next_segment(model::timeout_clock::time_point);
+    ss::future<result<ss::circular_buffer<model::record_batch>>>
+    adopt_prefetch();
+    ss::future<> close_prefetch();
+
     using reader_available = ss::bool_class<struct create_reader_tag>;
     reader_available maybe_create_segment_reader();
 
@@ -175,10 +239,12 @@ private:
 
     std::unique_ptr<lock_manager::lease> _lease;
     iterator_pair _iterator;
+    std::optional<prefetch_state> _prefetch;
     log_reader_config _config;
     model::offset _last_base;
     probe& _probe;
     ss::abort_source::subscription _as_sub;
+    parker _parker;
 };
 
 } // namespace storage
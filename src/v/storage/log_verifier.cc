@@ -0,0 +1,222 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/log_verifier.h"
+
+#include "bytes/utils.h"
+#include "hashing/crc32c.h"
+#include "model/record_utils.h"
+#include "storage/log_manager.h"
+#include "storage/logger.h"
+#include "storage/parser.h"
+#include "storage/segment.h"
+#include "vlog.h"
+
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/smp.hh>
+
+#include <fmt/ostream.h>
+
+namespace storage {
+
+// logs verified concurrently on one shard. verification is sequential
+// i/o, so a small fan-out is enough to keep the disk busy without
+// starving foreground readers of request slots
+static constexpr size_t max_concurrent_logs = 4;
+
+namespace internal {
+
+/**
+ * Same crc discipline as recovery's checksumming_consumer, but instead
+ * of rebuilding index state it accounts verified bytes and batches and
+ * records where verification stopped. The payload crc uses the
+ * hardware-accelerated crc32c kernel shared with the write path.
+ */
+class verifying_consumer final : public batch_consumer {
+public:
+    explicit verifying_consumer(segment_verify_result& res)
+      : _res(res) {}
+
+    consume_result consume_batch_start(
+      model::record_batch_header header,
+      size_t physical_base_offset,
+      size_t size_on_disk) override {
+        _header = header;
+        _file_pos_to_end_of_batch = physical_base_offset + size_on_disk;
+        _crc = crc32();
+        model::crc_record_batch_header(_crc, header);
+        return skip_batch::no;
+    }
+
+    void consume_records(iobuf&& records) override {
+        crc_extend_iobuf(_crc, records);
+    }
+
+    stop_parser consume_batch_end() override {
+        if ((uint32_t)_header.crc != _crc.value()) {
+            _res.error = fmt::format(
+              "batch crc mismatch at offset {}", _header.base_offset);
+            return stop_parser::yes;
+        }
+        _res.bytes_verified = _file_pos_to_end_of_batch;
+        ++_res.batches_verified;
+        return stop_parser::no;
+    }
+
+    void print(std::ostream& os) const override {
+        fmt::print(os, "storage::verifying_consumer {}", _res.path);
+    }
+
+private:
+    model::record_batch_header _header;
+    segment_verify_result& _res;
+    crc32 _crc;
+    size_t _file_pos_to_end_of_batch{0};
+};
+
+ss::future<segment_verify_result>
+verify_segment(ss::lw_shared_ptr<segment> s, ss::io_priority_class prio) {
+    return s->read_lock().then([s, prio](ss::rwlock::holder h) {
+        return ss::do_with(
+          segment_verify_result{},
+          [s, prio](segment_verify_result& res) {
+              res.path = s->reader().filename();
+              res.size_bytes = s->size_bytes();
+              auto parser = ss::make_lw_shared<continuous_batch_parser>(
+                std::make_unique<verifying_consumer>(res),
+                s->reader().data_stream(0, prio));
+              return parser->consume()
+                .then([&res](result<size_t> r) {
+                    if (!r && !res.error) {
+                        res.error = fmt::format(
+                          "parse error after {} clean batches: {}",
+                          res.batches_verified,
+                          r.error().message());
+                    }
+                })
+                .handle_exception([&res](const std::exception_ptr& e) {
+                    if (res.error) {
+                        return;
+                    }
+                    try {
+                        std::rethrow_exception(e);
+                    } catch (const std::exception& ex) {
+                        res.error = fmt::format("read error: {}", ex.what());
+                    } catch (...) {
+                        res.error = "read error";
+                    }
+                })
+                .finally([parser] { return parser->close(); })
+                .then([&res] {
+                    if (res.error) {
+                        vlog(
+                          stlog.error,
+                          "verification failed for {}: {}",
+                          res.path,
+                          *res.error);
+                    }
+                    return std::move(res);
+                });
+          })
+          .finally([s, h = std::move(h)] {});
+    });
+}
+
+} // namespace internal
+
+void verify_report::add(log_verify_result r) {
+    ++logs_verified;
+    segments_verified += r.segments_verified;
+    bytes_verified += r.bytes_verified;
+    batches_verified += r.batches_verified;
+    if (r.corrupt()) {
+        corrupted_logs.push_back(std::move(r));
+    }
+}
+
+ss::future<verify_report> verify_logs(log_manager& lm) {
+    auto start = ss::lowres_clock::now();
+    return ss::do_with(
+      verify_report{},
+      lm.logs(),
+      ss::semaphore(max_concurrent_logs),
+      [start](
+        verify_report& rpt, std::vector<log>& logs, ss::semaphore& limit) {
+          rpt.shard = ss::this_shard_id();
+          return ss::parallel_for_each(
+                   logs,
+                   [&rpt, &limit](log& l) {
+                       return ss::with_semaphore(limit, 1, [&rpt, l]() mutable {
+                           return l.verify().then(
+                             [&rpt](log_verify_result r) {
+                                 rpt.add(std::move(r));
+                             });
+                       });
+                   })
+            .then([&rpt, start] {
+                rpt.elapsed
+                  = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    ss::lowres_clock::now() - start);
+                vlog(
+                  stlog.info,
+                  "verified {} logs / {} segments / {} bytes in {}ms, {} "
+                  "corrupted",
+                  rpt.logs_verified,
+                  rpt.segments_verified,
+                  rpt.bytes_verified,
+                  rpt.elapsed.count(),
+                  rpt.corrupted_logs.size());
+                return std::move(rpt);
+            });
+      });
+}
+
+std::ostream& operator<<(std::ostream& o, const segment_verify_result& r) {
+    fmt::print(
+      o,
+      "{{path: {}, size: {}, verified_bytes: {}, verified_batches: {}, "
+      "error: {}}}",
+      r.path,
+      r.size_bytes,
+      r.bytes_verified,
+      r.batches_verified,
+      r.error.value_or("none"));
+    return o;
+}
+
+std::ostream& operator<<(std::ostream& o, const log_verify_result& r) {
+    fmt::print(
+      o,
+      "{{ntp: {}, segments: {}, bytes: {}, batches: {}, corrupt_segments: "
+      "{}}}",
+      r.ntp,
+      r.segments_verified,
+      r.bytes_verified,
+      r.batches_verified,
+      r.corruptions.size());
+    return o;
+}
+
+std::ostream& operator<<(std::ostream& o, const verify_report& r) {
+    fmt::print(
+      o,
+      "{{shard: {}, logs: {}, segments: {}, bytes: {}, batches: {}, "
+      "elapsed_ms: {}, corrupted_logs: {}}}",
+      r.shard,
+      r.logs_verified,
+      r.segments_verified,
+      r.bytes_verified,
+      r.batches_verified,
+      r.elapsed.count(),
+      r.corrupted_logs.size());
+    return o;
+}
+
+} // namespace storage
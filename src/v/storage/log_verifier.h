@@ -0,0 +1,94 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/fundamental.h"
+#include "seastarx.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/io_queue.hh>
+#include <seastar/core/shared_ptr.hh>
+#include <seastar/core/sstring.hh>
+
+#include <chrono>
+#include <optional>
+#include <vector>
+
+namespace storage {
+
+class log_manager;
+
+/**
+ * Full checksum verification of on-disk log data, the explicit
+ * counterpart of the per-segment replay that recovery performs after an
+ * unclean shutdown. Every batch of every sealed segment is parsed and
+ * its payload crc recomputed; the walk is sequential per segment so it
+ * rides the reader's deep read-ahead pipeline, and logs are verified a
+ * few at a time per shard with every shard working in parallel.
+ *
+ * Results report the verified totals plus, for each corrupt segment,
+ * the byte range that could not be validated: everything from the end
+ * of the last good batch to the end of the file.
+ */
+struct segment_verify_result {
+    ss::sstring path;
+    size_t size_bytes{0};
+    /// bytes covered by batches that parsed and checksummed clean; on a
+    /// corrupt segment the suspect range is [bytes_verified, size_bytes)
+    size_t bytes_verified{0};
+    size_t batches_verified{0};
+    /// set when verification stopped before the end of the segment
+    std::optional<ss::sstring> error;
+    bool corrupt() const { return bool(error); }
+
+    friend std::ostream& operator<<(std::ostream&, const segment_verify_result&);
+};
+
+struct log_verify_result {
+    model::ntp ntp;
+    size_t segments_verified{0};
+    size_t bytes_verified{0};
+    size_t batches_verified{0};
+    /// results for corrupt segments only; clean segments just count
+    std::vector<segment_verify_result> corruptions;
+    bool corrupt() const { return !corruptions.empty(); }
+
+    friend std::ostream& operator<<(std::ostream&, const log_verify_result&);
+};
+
+/// per-shard aggregate over every managed log
+struct verify_report {
+    unsigned shard{0};
+    size_t logs_verified{0};
+    size_t segments_verified{0};
+    size_t bytes_verified{0};
+    size_t batches_verified{0};
+    std::vector<log_verify_result> corrupted_logs;
+    std::chrono::milliseconds elapsed{0};
+
+    void add(log_verify_result);
+
+    friend std::ostream& operator<<(std::ostream&, const verify_report&);
+};
+
+/// verify every log managed by this shard's log_manager
+ss::future<verify_report> verify_logs(log_manager&);
+
+class segment;
+
+namespace internal {
+/// parse and checksum one segment end to end under its read lock
+ss::future<segment_verify_result>
+verify_segment(ss::lw_shared_ptr<segment>, ss::io_priority_class);
+} // namespace internal
+
+} // namespace storage
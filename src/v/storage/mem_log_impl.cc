@@ -183,6 +183,29 @@ struct mem_log_impl final : log::impl {
         }
         return ss::make_ready_future<ret_t>();
     }
+    ss::future<log_verify_result> verify() final {
+        // nothing on disk to checksum
+        return ss::make_ready_future<log_verify_result>(
+          log_verify_result{.ntp = config().ntp()});
+    }
+    batch_cache::pin_guard
+    pin_cached_range(model::offset, model::offset) final {
+        // data is always memory resident
+        return {};
+    }
+    log_io_rates io_rates() final {
+        // no disk io to rate
+        return log_io_rates{.ntp = config().ntp()};
+    }
+    ss::future<size_t>
+    upgrade_stale_segments(compaction_config, size_t) final {
+        // nothing on disk to rewrite
+        return ss::make_ready_future<size_t>(0);
+    }
+    ss::future<size_t> flush_dirty_indices() final {
+        // no on disk indices
+        return ss::make_ready_future<size_t>(0);
+    }
     ss::future<> truncate_prefix(truncate_prefix_config cfg) final {
         stlog.debug("PREFIX Truncating {} log at {}", config().ntp(), cfg);
         if (_data.empty()) {
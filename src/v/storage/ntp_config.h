@@ -19,6 +19,24 @@
 #include <optional>
 
 namespace storage {
+
+/**
+ * Controls when appends become locally durable. With fsync_on_append
+ * (the default) every quorum append round is fdatasynced before it is
+ * acknowledged. With raft_quorum the leader acknowledges once a majority
+ * of replicas hold the entries in memory and every replica fdatasyncs in
+ * the background on interval boundaries (raft_flush_interval_ms) - a
+ * write then survives single node crashes through the quorum rather than
+ * the local disk.
+ */
+enum class durability_mode : int8_t {
+    fsync_on_append = 0,
+    raft_quorum = 1,
+};
+
+// in storage/types.cc
+std::ostream& operator<<(std::ostream&, durability_mode);
+
 class ntp_config {
 public:
     struct default_overrides {
@@ -28,6 +46,15 @@ public:
         std::optional<model::compaction_strategy> compaction_strategy;
         // if not set, use the log_manager's configuration
         std::optional<size_t> segment_size;
+        // seastar io queue shares for this topic's partitions. if not set
+        // the subsystem-wide priority classes are used
+        std::optional<uint32_t> io_shares;
+        // if not set fsync_on_append is used
+        std::optional<durability_mode> durability;
+        // memory-only partition: batches never touch disk and redundancy
+        // comes from raft replication alone. bounded by the log_manager's
+        // ephemeral memory budget via retention eviction
+        bool ephemeral{false};
 
         // partition retention settings. If tristate is disabled the feature
         // will be disabled if there is no value set the default will be used
@@ -94,6 +121,22 @@ public:
                == model::cleanup_policy_bitflags::deletion;
     }
 
+    std::optional<uint32_t> io_shares() const {
+        if (_overrides) {
+            return _overrides->io_shares;
+        }
+        return std::nullopt;
+    }
+
+    durability_mode durability() const {
+        if (_overrides && _overrides->durability) {
+            return *_overrides->durability;
+        }
+        return durability_mode::fsync_on_append;
+    }
+
+    bool is_ephemeral() const { return _overrides && _overrides->ephemeral; }
+
     ss::sstring work_directory() const {
         return fmt::format("{}/{}_{}", _base_dir, _ntp.path(), _revision_id);
     }
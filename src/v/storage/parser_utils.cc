@@ -10,22 +10,92 @@
 #include "storage/parser_utils.h"
 
 #include "compression/compression.h"
+#include "compression/stream_zstd.h"
 #include "model/compression.h"
 #include "model/record.h"
 #include "model/record_utils.h"
 #include "reflection/adl.h"
 #include "storage/logger.h"
+#include "utils/vint.h"
 #include "vlog.h"
 
 #include <seastar/core/byteorder.hh>
+#include <seastar/core/do_with.hh>
+#include <seastar/core/future-util.hh>
+
+#include <array>
+#include <memory>
+#include <optional>
 
 namespace storage::internal {
 
+// batches below this size are decompressed inline: the work is shorter
+// than a group switch is worth
+static constexpr size_t inline_decompress_threshold = 16_KiB;
+
+static thread_local ss::scheduling_group _compression_sg;
+
+void set_compression_scheduling_group(ss::scheduling_group sg) {
+    _compression_sg = sg;
+}
+
+// decompress a zstd batch in bounded slices. every chunk the streaming
+// decompressor produces is a preemption point, so the reactor can run
+// small requests between slices of a multi-MB batch
+static ss::future<model::record_batch>
+decompress_zstd_sliced(model::record_batch b) {
+    auto h = b.header();
+    return ss::do_with(
+      std::make_unique<compression::zstd_chunked_decompressor>(
+        std::move(b).release_data()),
+      iobuf{},
+      [h](
+        std::unique_ptr<compression::zstd_chunked_decompressor>& dec,
+        iobuf& out) mutable {
+          return ss::repeat([&dec, &out] {
+                     auto chunk = dec->next();
+                     if (!chunk) {
+                         return ss::make_ready_future<ss::stop_iteration>(
+                           ss::stop_iteration::yes);
+                     }
+                     out.append(std::move(*chunk));
+                     return ss::make_ready_future<ss::stop_iteration>(
+                       ss::stop_iteration::no);
+                 })
+            .then([h, &out]() mutable {
+                // must remove compression first!
+                h.attrs.remove_compression();
+                reset_size_checksum_metadata(h, out);
+                return model::record_batch(
+                  h, std::move(out), model::record_batch::tag_ctor_ng{});
+            });
+      });
+}
+
 ss::future<model::record_batch> decompress_batch(model::record_batch&& b) {
     if (!b.compressed()) {
         return ss::make_ready_future<model::record_batch>(std::move(b));
     }
-    return decompress_batch(b);
+    if (
+      b.size_bytes() < inline_decompress_threshold
+      || _compression_sg == ss::scheduling_group()) {
+        return decompress_batch(b);
+    }
+    if (b.header().attrs.compression() == model::compression::zstd) {
+        return ss::with_scheduling_group(
+          _compression_sg,
+          [b = std::move(b)]() mutable {
+              return decompress_zstd_sliced(std::move(b));
+          });
+    }
+    // other codecs have no streaming wrapper; at least keep the one-shot
+    // inflate out of the handler's scheduling group
+    return ss::with_scheduling_group(
+      _compression_sg, [b = std::move(b)]() mutable {
+          return ss::do_with(std::move(b), [](model::record_batch& b) {
+              return decompress_batch(b);
+          });
+      });
 }
 
 ss::future<model::record_batch> decompress_batch(const model::record_batch& b) {
@@ -78,6 +148,101 @@ compress_batch(model::compression c, const model::record_batch& b) {
     return ss::make_ready_future<model::record_batch>(std::move(batch));
 }
 
+namespace {
+
+/// total framed size of the first record in `buf` when it is fully
+/// buffered, empty optional when more input is needed
+std::optional<size_t> buffered_record_size(const iobuf& buf) {
+    std::array<char, vint::max_length> prefix{};
+    const auto n = std::min(prefix.size(), buf.size_bytes());
+    auto consumer = iobuf::iterator_consumer(buf.cbegin(), buf.cend());
+    consumer.consume_to(n, prefix.data());
+    // records are prefixed with their vint encoded length. find the
+    // terminating byte before decoding so a partially buffered prefix is
+    // never interpreted.
+    size_t len_end = 0;
+    while (len_end < n && (static_cast<uint8_t>(prefix[len_end]) & 0x80) != 0) {
+        ++len_end;
+    }
+    if (len_end == n) {
+        return std::nullopt;
+    }
+    const auto [len, prefix_size] = vint::deserialize_buf(prefix.data(), n);
+    const auto framed = prefix_size + static_cast<size_t>(len);
+    if (buf.size_bytes() < framed) {
+        return std::nullopt;
+    }
+    return framed;
+}
+
+struct record_stream {
+    record_stream(
+      std::unique_ptr<compression::zstd_chunked_decompressor> d,
+      iobuf initial,
+      int32_t records,
+      ss::noncopyable_function<ss::future<>(model::record)> f)
+      : decompressor(std::move(d))
+      , buffered(std::move(initial))
+      , remaining(records)
+      , consumer(std::move(f)) {}
+
+    std::unique_ptr<compression::zstd_chunked_decompressor> decompressor;
+    iobuf buffered;
+    int32_t remaining;
+    ss::noncopyable_function<ss::future<>(model::record)> consumer;
+};
+
+ss::future<> consume_record_stream(record_stream st) {
+    return ss::do_with(std::move(st), [](record_stream& st) {
+        return ss::do_until(
+          [&st] { return st.remaining <= 0; },
+          [&st] {
+              auto framed = buffered_record_size(st.buffered);
+              while (!framed) {
+                  std::optional<iobuf> chunk;
+                  if (st.decompressor) {
+                      chunk = st.decompressor->next();
+                  }
+                  if (unlikely(!chunk)) {
+                      throw std::runtime_error(fmt_with_ctx(
+                        fmt::format,
+                        "Record stream ended with {} records still expected",
+                        st.remaining));
+                  }
+                  st.buffered.append(std::move(*chunk));
+                  framed = buffered_record_size(st.buffered);
+              }
+              auto parser = iobuf_parser(st.buffered.share(0, *framed));
+              auto record = model::parse_one_record_from_buffer(parser);
+              st.buffered.trim_front(*framed);
+              --st.remaining;
+              return st.consumer(std::move(record));
+          });
+    });
+}
+
+} // namespace
+
+ss::future<> for_each_decompressed_record(
+  model::record_batch b,
+  ss::noncopyable_function<ss::future<>(model::record)> f) {
+    if (b.header().attrs.compression() == model::compression::zstd) {
+        auto records = b.record_count();
+        auto dec = std::make_unique<compression::zstd_chunked_decompressor>(
+          std::move(b).release_data());
+        return consume_record_stream(
+          record_stream(std::move(dec), iobuf{}, records, std::move(f)));
+    }
+    // only zstd exposes a streaming interface; other codecs (and
+    // uncompressed batches) go through the materialized records buffer
+    return decompress_batch(std::move(b))
+      .then([f = std::move(f)](model::record_batch b) mutable {
+          auto records = b.record_count();
+          return consume_record_stream(record_stream(
+            nullptr, std::move(b).release_data(), records, std::move(f)));
+      });
+}
+
 /// \brief resets the size, header crc and payload crc
 void reset_size_checksum_metadata(
   model::record_batch_header& hdr, const iobuf& records) {
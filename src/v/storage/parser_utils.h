@@ -14,9 +14,21 @@
 #include "bytes/iobuf_parser.h"
 #include "model/record.h"
 
+#include <seastar/core/scheduling.hh>
+#include <seastar/util/noncopyable_function.hh>
+
 namespace storage::internal {
 
-/// \brief batch decompression
+/// \brief route large-batch decompression into the given scheduling group.
+/// Must be called on every shard (scheduling groups are global handles,
+/// the routing decision is shard local). When unset, decompression runs
+/// inline in the caller's group as before.
+void set_compression_scheduling_group(ss::scheduling_group);
+
+/// \brief batch decompression. Batches above an internal size threshold
+/// are decompressed under the compression scheduling group, zstd ones in
+/// bounded slices, so a large batch never monopolizes the handler's
+/// group for the whole payload.
 ss::future<model::record_batch> decompress_batch(model::record_batch&&);
 /// \brief batch decompression
 ss::future<model::record_batch> decompress_batch(const model::record_batch&);
@@ -31,4 +43,13 @@ compress_batch(model::compression, const model::record_batch&);
 /// \brief resets the size, header crc and payload crc
 void reset_size_checksum_metadata(model::record_batch_header&, const iobuf&);
 
+/// \brief iterates over a batch's records, inflating incrementally
+///
+/// For zstd batches records are decoded from a streaming decompressor, so
+/// peak memory is bounded by the decompression chunk plus the largest
+/// record instead of the uncompressed batch size. Codecs without a
+/// streaming wrapper fall back to full decompression.
+ss::future<> for_each_decompressed_record(
+  model::record_batch, ss::noncopyable_function<ss::future<>(model::record)>);
+
 } // namespace storage::internal
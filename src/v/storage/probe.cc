@@ -89,6 +89,11 @@ void probe::setup_metrics(const model::ntp& ntp) {
           [this] { return _segment_compacted; },
           sm::description("Number of compacted segments"),
           labels),
+        sm::make_derive(
+          "log_flushes",
+          [this] { return _log_flushes; },
+          sm::description("Number of log flushes"),
+          labels),
         sm::make_gauge(
           "partition_size",
           [this] { return _partition_bytes; },
@@ -97,6 +102,21 @@ void probe::setup_metrics(const model::ntp& ntp) {
       });
 }
 
+log_io_rates probe::io_rates(const model::ntp& ntp) {
+    const auto now = ss::lowres_clock::now();
+    log_io_rates r;
+    r.ntp = ntp;
+    r.write_bytes_sec = _write_rate.measure(now);
+    r.read_bytes_sec = _read_rate.measure(now);
+    r.cached_read_bytes_sec = _cached_read_rate.measure(now);
+    r.flushes_sec = _flush_rate.measure(now);
+    if (const auto reads = r.read_bytes_sec + r.cached_read_bytes_sec;
+        reads > 0) {
+        r.cache_hit_ratio = r.cached_read_bytes_sec / reads;
+    }
+    return r;
+}
+
 void probe::add_initial_segment(const segment& s) {
     _partition_bytes += s.reader().file_size();
 }
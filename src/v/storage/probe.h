@@ -11,12 +11,16 @@
 
 #pragma once
 #include "model/fundamental.h"
+#include "resource_mgmt/rate.h"
 #include "storage/logger.h"
 #include "storage/segment.h"
+#include "storage/types.h"
 
+#include <seastar/core/lowres_clock.hh>
 #include <seastar/core/metrics_registration.hh>
 #include <seastar/core/shared_ptr.hh>
 
+#include <chrono>
 #include <cstdint>
 
 namespace storage {
@@ -25,13 +29,25 @@ public:
     void add_bytes_written(uint64_t written) {
         _partition_bytes += written;
         _bytes_written += written;
+        _write_rate.record(written, ss::lowres_clock::now());
     }
 
-    void add_bytes_read(uint64_t read) { _bytes_read += read; }
-    void add_cached_bytes_read(uint64_t read) { _cached_bytes_read += read; }
+    void add_bytes_read(uint64_t read) {
+        _bytes_read += read;
+        _read_rate.record(read, ss::lowres_clock::now());
+    }
+    void add_cached_bytes_read(uint64_t read) {
+        _cached_bytes_read += read;
+        _cached_read_rate.record(read, ss::lowres_clock::now());
+    }
 
     void batch_written() { ++_batches_written; }
 
+    void flush() {
+        ++_log_flushes;
+        _flush_rate.record(1, ss::lowres_clock::now());
+    }
+
     void corrupted_compaction_index() { ++_corrupted_compaction_index; }
 
     void segment_created() { ++_log_segments_created; }
@@ -58,7 +74,16 @@ public:
     void add_initial_segment(const segment&);
     void remove_partition_bytes(size_t remove) { _partition_bytes -= remove; }
 
+    /// current rolling-window io rates of this log. recording is O(1) per
+    /// sample; the window scans happen here, on demand
+    log_io_rates io_rates(const model::ntp&);
+
 private:
+    /// ten one-second buckets: long enough to smooth out a flush burst,
+    /// short enough that a hot partition shows up while it is still hot
+    static constexpr size_t rate_windows = 10;
+    static constexpr std::chrono::seconds rate_window_width{1};
+
     uint64_t _partition_bytes = 0;
     uint64_t _bytes_written = 0;
     uint64_t _bytes_read = 0;
@@ -73,6 +98,12 @@ private:
     uint32_t _log_segments_created = 0;
     uint32_t _batch_parse_errors = 0;
     uint32_t _batch_write_errors = 0;
+    uint64_t _log_flushes = 0;
+
+    rate_tracker _write_rate{rate_windows, rate_window_width};
+    rate_tracker _read_rate{rate_windows, rate_window_width};
+    rate_tracker _cached_read_rate{rate_windows, rate_window_width};
+    rate_tracker _flush_rate{rate_windows, rate_window_width};
     ss::metrics::metric_groups _metrics;
 };
 } // namespace storage
@@ -93,9 +93,11 @@ ss::future<> segment::remove_tombstones() {
         return ss::make_ready_future<>();
     }
     std::vector<std::filesystem::path> rm;
-    rm.reserve(3);
+    rm.reserve(4);
     rm.emplace_back(reader().filename().c_str());
     rm.emplace_back(index().filename().c_str());
+    rm.emplace_back(std::filesystem::path(reader().filename().c_str())
+                      .replace_extension("header_index"));
     if (is_compacted_segment()) {
         rm.push_back(
           internal::compacted_index_path(reader().filename().c_str()));
@@ -318,8 +320,8 @@ void segment::cache_truncate(model::offset offset) {
 ss::future<> segment::do_compaction_index_batch(const model::record_batch& b) {
     vassert(!b.compressed(), "wrong method. Call compact_index_batch. {}", b);
     auto& w = compaction_index();
-    return model::for_each_record(
-      b, [o = b.base_offset(), &w](const model::record& r) {
+    return model::for_each_record_view(
+      b, [o = b.base_offset(), &w](model::record_view r) {
           return w.index(r.key(), o, r.offset_delta());
       });
 }
@@ -330,11 +332,13 @@ ss::future<> segment::compaction_index_batch(const model::record_batch& b) {
     if (!b.compressed()) {
         return do_compaction_index_batch(b);
     }
-    return internal::decompress_batch(b).then([this](model::record_batch&& b) {
-        return ss::do_with(std::move(b), [this](model::record_batch& b) {
-            return do_compaction_index_batch(b);
-        });
-    });
+    // stream records out of the compressed payload instead of inflating the
+    // whole batch on the append path
+    auto& w = compaction_index();
+    return internal::for_each_decompressed_record(
+      b.copy(), [o = b.base_offset(), &w](model::record r) {
+          return w.index(r.key(), o, r.offset_delta());
+      });
 }
 
 ss::future<append_result> segment::append(const model::record_batch& b) {
@@ -421,15 +425,15 @@ ss::future<append_result> segment::append(model::record_batch&& b) {
     });
 }
 
-ss::input_stream<char>
-segment::offset_data_stream(model::offset o, ss::io_priority_class iopc) {
+ss::input_stream<char> segment::offset_data_stream(
+  model::offset o, ss::io_priority_class iopc, cold_read_hint cold) {
     check_segment_not_closed("offset_data_stream()");
     auto nearest = _idx.find_nearest(o);
     size_t position = 0;
     if (nearest) {
         position = nearest->filepos;
     }
-    return _reader.data_stream(position, iopc);
+    return _reader.data_stream(position, iopc, cold);
 }
 
 void segment::advance_stable_offset(size_t offset) {
@@ -550,33 +554,66 @@ ss::future<ss::lw_shared_ptr<segment>> open_segment(
           auto index_name = std::filesystem::path(ptr->filename().c_str())
                               .replace_extension("base_index")
                               .string();
-          return ss::open_file_dma(
-                   index_name, ss::open_flags::create | ss::open_flags::rw)
-            .then_wrapped([batch_cache = std::move(batch_cache),
-                           ptr,
-                           sanitize_fileops,
-                           rdr = std::move(rdr),
-                           index_name,
-                           meta](ss::future<ss::file> f) mutable {
-                ss::file fd;
-                try {
-                    fd = f.get0();
-                } catch (...) {
-                    return ptr->close().then(
-                      [rdr = std::move(rdr), e = std::current_exception()] {
+          auto headers_name = std::filesystem::path(ptr->filename().c_str())
+                                .replace_extension("header_index")
+                                .string();
+          return ss::when_all(
+                   ss::open_file_dma(
+                     index_name, ss::open_flags::create | ss::open_flags::rw),
+                   ss::open_file_dma(
+                     headers_name, ss::open_flags::create | ss::open_flags::rw))
+            .then([batch_cache = std::move(batch_cache),
+                   ptr,
+                   sanitize_fileops,
+                   rdr = std::move(rdr),
+                   index_name,
+                   meta](
+                    std::tuple<ss::future<ss::file>, ss::future<ss::file>>
+                      files) mutable {
+                auto& [index_fut, headers_fut] = files;
+                const bool index_failed = index_fut.failed();
+                const bool headers_failed = headers_fut.failed();
+                if (index_failed || headers_failed) {
+                    // surface one failure; close whatever did open
+                    auto e = index_failed ? index_fut.get_exception()
+                                          : headers_fut.get_exception();
+                    if (index_failed && headers_failed) {
+                        headers_fut.ignore_ready_future();
+                    }
+                    auto cleanup = ss::now();
+                    if (!index_failed) {
+                        cleanup = cleanup.then(
+                          [fd = index_fut.get0()]() mutable {
+                              return fd.close().finally([fd] {});
+                          });
+                    }
+                    if (!headers_failed) {
+                        cleanup = cleanup.then(
+                          [fd = headers_fut.get0()]() mutable {
+                              return fd.close().finally([fd] {});
+                          });
+                    }
+                    return cleanup
+                      .then([ptr] { return ptr->close(); })
+                      .then([rdr = std::move(rdr), e] {
                           return ss::make_exception_future<
                             ss::lw_shared_ptr<segment>>(e);
                       });
                 }
+                ss::file fd = index_fut.get0();
+                ss::file headers_fd = headers_fut.get0();
                 if (sanitize_fileops) {
                     fd = ss::file(
                       ss::make_shared(file_io_sanitizer(std::move(fd))));
+                    headers_fd = ss::file(ss::make_shared(
+                      file_io_sanitizer(std::move(headers_fd))));
                 }
                 auto idx = segment_index(
                   index_name,
                   fd,
                   meta->base_offset,
-                  segment_index::default_data_buffer_step);
+                  config::shard_local_cfg().log_segment_index_granularity(),
+                  std::move(headers_fd));
                 return ss::make_ready_future<ss::lw_shared_ptr<segment>>(
                   ss::make_lw_shared<segment>(
                     segment::offset_tracker(meta->term, meta->base_offset),
@@ -92,8 +92,10 @@ public:
     ss::future<bool> materialize_index();
 
     /// main read interface
-    ss::input_stream<char>
-      offset_data_stream(model::offset, ss::io_priority_class);
+    ss::input_stream<char> offset_data_stream(
+      model::offset,
+      ss::io_priority_class,
+      cold_read_hint = cold_read_hint::no);
 
     const offset_tracker& offsets() const { return _tracker; }
     bool empty() const;
@@ -133,6 +135,7 @@ public:
       size_t max_bytes,
       bool skip_lru_promote);
     void cache_put(const model::record_batch& batch);
+    batch_cache::pin_guard cache_pin(model::offset begin, model::offset end);
 
     ss::future<ss::rwlock::holder> read_lock(
       ss::semaphore::time_point timeout = ss::semaphore::time_point::max());
@@ -302,6 +305,13 @@ inline void segment::cache_put(const model::record_batch& batch) {
         _cache->put(batch);
     }
 }
+inline batch_cache::pin_guard
+segment::cache_pin(model::offset begin, model::offset end) {
+    if (likely(bool(_cache))) {
+        return _cache->pin(begin, end);
+    }
+    return {};
+}
 inline ss::future<ss::rwlock::holder>
 segment::read_lock(ss::semaphore::time_point timeout) {
     return _destructive_ops.hold_read_lock(timeout);
@@ -23,6 +23,9 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <chrono>
+
 namespace storage {
 
 [[gnu::cold]] static ss::future<>
@@ -34,6 +37,8 @@ size_missmatch_error(const char* ctx, size_t expected, size_t got) {
 segment_appender::segment_appender(ss::file f, options opts)
   : _out(std::move(f))
   , _opts(opts)
+  , _falloc_step(std::clamp(
+      _opts.falloc_step, min_fallocation_step, max_fallocation_step))
   , _concurrent_flushes(ss::semaphore::max_counter())
   , _inactive_timer([this] { handle_inactive_timer(); }) {
     const auto alignment = _out.disk_write_dma_alignment();
@@ -59,6 +64,8 @@ segment_appender::segment_appender(segment_appender&& o) noexcept
   : _out(std::move(o._out))
   , _opts(o._opts)
   , _closed(o._closed)
+  , _falloc_step(o._falloc_step)
+  , _last_fallocation_time(o._last_fallocation_time)
   , _committed_offset(o._committed_offset)
   , _fallocation_offset(o._fallocation_offset)
   , _bytes_flush_pending(o._bytes_flush_pending)
@@ -67,7 +74,10 @@ segment_appender::segment_appender(segment_appender&& o) noexcept
   , _inflight(std::move(o._inflight))
   , _callbacks(std::exchange(o._callbacks, nullptr))
   , _inactive_timer([this] { handle_inactive_timer(); })
-  , _previously_inactive(o._previously_inactive) {
+  , _previously_inactive(o._previously_inactive)
+  , _prev_tail(std::move(o._prev_tail))
+  , _prev_tail_offset(o._prev_tail_offset)
+  , _prev_tail_size(o._prev_tail_size) {
     o._closed = true;
 }
 
@@ -122,7 +132,7 @@ ss::future<> segment_appender::do_append(const char* buf, const size_t n) {
      */
     if (unlikely(!_head && _committed_offset > 0)) {
         return internal::chunks()
-          .get()
+          .get(_opts.priority)
           .then([this](ss::lw_shared_ptr<chunk> chunk) {
               _head = std::move(chunk);
           })
@@ -154,7 +164,7 @@ ss::future<> segment_appender::do_append(const char* buf, const size_t n) {
       .then([this, next_buf = buf + written, next_sz = n - written](
               ss::semaphore_units<>) {
           // do not hold the units!
-          return internal::chunks().get().then(
+          return internal::chunks().get(_opts.priority).then(
             [this, next_buf, next_sz](ss::lw_shared_ptr<chunk> chunk) {
                 vassert(!_head, "cannot overwrite existing chunk");
                 _head = std::move(chunk);
@@ -186,6 +196,7 @@ void segment_appender::handle_inactive_timer() {
      */
     if (_concurrent_flushes.try_wait(ss::semaphore::max_counter())) {
         if (_head && !_head->bytes_pending()) {
+            cache_tail_block();
             internal::chunks().add(std::exchange(_head, nullptr));
             vlog(
               stlog.debug, "reclaiming inactive chunk from appender {}", *this);
@@ -197,6 +208,28 @@ void segment_appender::handle_inactive_timer() {
     }
 }
 
+void segment_appender::cache_tail_block() {
+    vassert(_head, "caching the tail block requires an active chunk");
+    const size_t partial = _committed_offset % _head->alignment();
+    if (partial == 0) {
+        return;
+    }
+    if (!_prev_tail) {
+        // one block is enough: tails are strictly smaller than a block
+        _prev_tail = std::make_unique<char[]>(internal::chunk_cache::alignment);
+    }
+    /*
+     * chunk positions are congruent with file offsets modulo the write
+     * alignment (rehydration seeds the position with the offset within
+     * the block), so the partial block ends at the chunk's append
+     * position.
+     */
+    std::memcpy(
+      _prev_tail.get(), _head->data() + _head->size() - partial, partial);
+    _prev_tail_offset = _committed_offset - partial;
+    _prev_tail_size = partial;
+}
+
 ss::future<> segment_appender::hydrate_last_half_page() {
     vassert(_head, "hydrate last half page expects active chunk");
     vassert(
@@ -222,6 +255,12 @@ ss::future<> segment_appender::hydrate_last_half_page() {
     if (bytes_to_read == 0) {
         return ss::make_ready_future<>();
     }
+    if (_prev_tail_size == bytes_to_read && _prev_tail_offset == sz) {
+        // the block contents were cached when the chunk was reclaimed;
+        // restore them from memory instead of re-reading the disk
+        std::memcpy(buff, _prev_tail.get(), bytes_to_read);
+        return ss::make_ready_future<>();
+    }
     return _out
       .dma_read(
         sz, buff, read_align /*must be full _write_ alignment*/, _opts.priority)
@@ -266,6 +305,8 @@ ss::future<> segment_appender::truncate(size_t n) {
     return flush().then([this, n] { return do_truncation(n); }).then([this, n] {
         _committed_offset = n;
         _fallocation_offset = n;
+        // on-disk contents changed; the cached tail block is stale
+        _prev_tail_size = 0;
         auto f = ss::now();
         if (_head) {
             // NOTE: Important to reset chunks for offset accounting.  reset any
@@ -274,7 +315,7 @@ ss::future<> segment_appender::truncate(size_t n) {
             _head->reset();
         } else {
             // https://github.com/vectorizedio/redpanda/issues/43
-            f = internal::chunks().get().then(
+            f = internal::chunks().get(_opts.priority).then(
               [this](ss::lw_shared_ptr<chunk> chunk) {
                   _head = std::move(chunk);
               });
@@ -291,6 +332,28 @@ ss::future<> segment_appender::close() {
       .then([this] { return _out.close(); });
 }
 
+size_t segment_appender::next_fallocation_step() {
+    /*
+     * adapt the preallocation step to the observed append rate. a hot
+     * partition exhausts its preallocated range quickly - grow the step to
+     * amortize the fallocate syscall. a cold partition takes a long time to
+     * consume the range - shrink the step to keep preallocated-but-unused
+     * disk space bounded across many partitions. the very first fallocation
+     * of a segment uses the configured step unchanged.
+     */
+    const auto now = ss::lowres_clock::now();
+    if (_last_fallocation_time.time_since_epoch().count() != 0) {
+        const auto elapsed = now - _last_fallocation_time;
+        if (elapsed < std::chrono::seconds(1)) {
+            _falloc_step = std::min(_falloc_step * 2, max_fallocation_step);
+        } else if (elapsed > std::chrono::seconds(10)) {
+            _falloc_step = std::max(_falloc_step / 2, min_fallocation_step);
+        }
+    }
+    _last_fallocation_time = now;
+    return _falloc_step;
+}
+
 ss::future<> segment_appender::do_next_adaptive_fallocation() {
     return ss::with_semaphore(
              _concurrent_flushes,
@@ -299,7 +362,7 @@ ss::future<> segment_appender::do_next_adaptive_fallocation() {
                  // step - compute step rounded to 4096; this is needed because
                  // during a truncation the follow up fallocation might not be
                  // page aligned
-                 auto step = _opts.falloc_step;
+                 auto step = next_fallocation_step();
                  if (_fallocation_offset % 4096 != 0) {
                      // add left over bytes to a full page
                      step += 4096 - (_fallocation_offset % 4096);
@@ -375,6 +438,11 @@ void segment_appender::dispatch_background_head_write() {
       "Writes can be at most a full segment. Expected {}, attempted write: {}",
       chunk::chunk_size,
       expected);
+    // the partial tail block is padded with zeros on disk. zeroing only
+    // the padding keeps chunk recycling memset free.
+    h->zero_pad();
+    // this write changes the bytes backing the cached tail block
+    _prev_tail_size = 0;
     // accounting synchronously
     _committed_offset += h->bytes_pending();
     _bytes_flush_pending -= h->bytes_pending();
@@ -427,6 +495,7 @@ std::ostream& operator<<(std::ostream& o, const segment_appender& a) {
     // NOTE: intrusivelist.size() == O(N) but often N is very small, ~8
     return o << "{no_of_chunks:" << a._opts.number_of_chunks
              << ", closed:" << a._closed
+             << ", falloc_step:" << a._falloc_step
              << ", fallocation_offset:" << a._fallocation_offset
              << ", committed_offset:" << a._committed_offset
              << ", bytes_flush_pending:" << a._bytes_flush_pending << "}";
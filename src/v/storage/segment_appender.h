@@ -21,6 +21,7 @@
 #include <seastar/core/file.hh>
 #include <seastar/core/fstream.hh>
 #include <seastar/core/iostream.hh>
+#include <seastar/core/lowres_clock.hh>
 #include <seastar/core/sstring.hh>
 
 #include <iostream>
@@ -40,6 +41,11 @@ public:
                                                      / chunk::chunk_size;
     static constexpr const size_t chunk_size = chunk::chunk_size;
     static constexpr const size_t fallocation_step = 32_MiB;
+    // bounds for the adaptive fallocation step. the step starts at
+    // options::falloc_step and grows/shrinks with the observed append
+    // rate, but never leaves this window.
+    static constexpr const size_t min_fallocation_step = 4_MiB;
+    static constexpr const size_t max_fallocation_step = 256_MiB;
 
     struct options {
         options(ss::io_priority_class p, size_t chunks_no)
@@ -83,6 +89,7 @@ public:
 private:
     void dispatch_background_head_write();
     ss::future<> do_next_adaptive_fallocation();
+    size_t next_fallocation_step();
     ss::future<> hydrate_last_half_page();
     ss::future<> do_truncation(size_t);
     ss::future<> do_append(const char* buf, const size_t n);
@@ -104,6 +111,10 @@ private:
     ss::file _out;
     options _opts;
     bool _closed{false};
+    // current adaptive fallocation step, adjusted per segment from the
+    // observed append rate; seeded from _opts.falloc_step
+    size_t _falloc_step{0};
+    ss::lowres_clock::time_point _last_fallocation_time;
     size_t _committed_offset{0};
     size_t _fallocation_offset{0};
     size_t _bytes_flush_pending{0};
@@ -127,6 +138,18 @@ private:
     void handle_inactive_timer();
     bool _previously_inactive = false;
 
+    /*
+     * contents of the last partially written dma block, captured when an
+     * idle appender's chunk is reclaimed into the chunk cache. when the
+     * appender becomes active again rehydration can restore the block
+     * from here instead of re-reading it from disk. invalidated by any
+     * write or truncation.
+     */
+    void cache_tail_block();
+    std::unique_ptr<char[]> _prev_tail;
+    size_t _prev_tail_offset{0};
+    size_t _prev_tail_size{0};
+
     friend std::ostream& operator<<(std::ostream&, const segment_appender&);
 };
 
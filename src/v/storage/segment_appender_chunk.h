@@ -29,9 +29,11 @@ public:
     explicit segment_appender_chunk(size_t alignment)
       : _alignment(alignment)
       , _buf(ss::allocate_aligned_buffer<char>(chunk_size, alignment)) {
-        // zero-out the buffer in case the alloctor gaves us a recycled buffer
-        // that was from a valid previous segment.
-        reset();
+        // zeroing here pre-faults the pages on the local NUMA node (see
+        // chunk_cache::start). correctness does not depend on it: every
+        // dma write zero-pads its partial tail block, so stale buffer
+        // contents can never reach disk.
+        std::memset(_buf.get(), 0, chunk_size);
     }
 
     segment_appender_chunk(const segment_appender_chunk&) = delete;
@@ -84,11 +86,17 @@ public:
         return sz;
     }
 
-    void reset() {
-        _flushed_pos = _pos = 0;
-        // allow chunk reuse
-        std::memset(_buf.get(), 0, chunk_size);
+    /// \brief zero the padding between the append position and the end of
+    /// its dma block. called before every dma write so the zeros that pad
+    /// the partial tail block on disk never contain stale buffer contents.
+    void zero_pad() {
+        const auto end = ss::align_up<size_t>(_pos, _alignment);
+        std::memset(get_current(), 0, end - _pos);
     }
+
+    // reuse does not require zeroing the buffer: appends overwrite the
+    // data range of every dma write and zero_pad() covers the padding
+    void reset() { _flushed_pos = _pos = 0; }
     void flush() { _flushed_pos = _pos; }
     char* get_current() { return _buf.get() + _pos; }
     void set_position(size_t p) { _flushed_pos = _pos = p; }
@@ -16,6 +16,9 @@
 
 namespace storage {
 
+/// serialize a batch header into the on-disk layout written by write()
+iobuf disk_header_to_iobuf(const model::record_batch_header& h);
+
 ss::future<>
 write(segment_appender& appender, const model::record_batch& batch);
 
@@ -35,22 +35,31 @@ static inline segment_index::entry translate_index_entry(
 }
 
 segment_index::segment_index(
-  ss::sstring filename, ss::file f, model::offset base, size_t step)
+  ss::sstring filename,
+  ss::file f,
+  model::offset base,
+  size_t step,
+  std::optional<ss::file> batch_headers_file)
   : _name(std::move(filename))
   , _out(std::move(f))
-  , _step(step) {
+  , _step(step)
+  , _headers_out(std::move(batch_headers_file)) {
     _state.base_offset = base;
+    _headers.base_offset = base;
 }
 
 void segment_index::reset() {
     auto base = _state.base_offset;
     _state = {};
     _state.base_offset = base;
+    _headers = {};
+    _headers.base_offset = base;
     _acc = 0;
 }
 
 void segment_index::swap_index_state(index_state&& o) {
     _needs_persistence = true;
+    _released = false;
     _acc = 0;
     std::swap(_state, o);
 }
@@ -58,6 +67,8 @@ void segment_index::swap_index_state(index_state&& o) {
 void segment_index::maybe_track(
   const model::record_batch_header& hdr, size_t filepos) {
     _acc += hdr.size_bytes;
+    // the header sidecar tracks every batch, not every _step bytes
+    _headers.add_entry(hdr, filepos);
     if (_state.maybe_index(
           _acc,
           _step,
@@ -85,10 +96,30 @@ segment_index::find_nearest(model::timestamp t) {
       std::end(_state.relative_time_index),
       i,
       std::less<uint32_t>{});
-    if (it == _state.relative_offset_index.end()) {
+    if (it == _state.relative_time_index.end()) {
         return std::nullopt;
     }
-    auto dist = std::distance(_state.relative_offset_index.begin(), it);
+    auto dist = std::distance(_state.relative_time_index.begin(), it);
+    return translate_index_entry(_state, _state.get_entry(dist));
+}
+
+std::optional<segment_index::entry>
+segment_index::find_nearest_before(model::timestamp t) {
+    if (t < _state.base_timestamp || _state.empty()) {
+        return std::nullopt;
+    }
+    const uint32_t i = t() - _state.base_timestamp();
+    auto it = std::lower_bound(
+      std::begin(_state.relative_time_index),
+      std::end(_state.relative_time_index),
+      i,
+      std::less<uint32_t>{});
+    if (it == _state.relative_time_index.begin()) {
+        // no entry strictly below t; scan from the start of the segment
+        return std::nullopt;
+    }
+    it = std::prev(it);
+    auto dist = std::distance(_state.relative_time_index.begin(), it);
     return translate_index_entry(_state, _state.get_entry(dist));
 }
 
@@ -98,22 +129,25 @@ segment_index::find_nearest(model::offset o) {
         return std::nullopt;
     }
     const uint32_t needle = o() - _state.base_offset();
+    /*
+     * pure binary search: locate the last indexed entry with a relative
+     * offset <= needle. lower_bound returns the first entry >= needle, so
+     * the answer is either that entry (exact hit) or its predecessor.
+     */
     auto it = std::lower_bound(
       std::begin(_state.relative_offset_index),
       std::end(_state.relative_offset_index),
       needle,
       std::less<uint32_t>{});
-    if (it == _state.relative_offset_index.end()) {
+    if (
+      it == _state.relative_offset_index.end()
+      || (*it != needle && it != _state.relative_offset_index.begin())) {
         it = std::prev(it);
     }
-    // make it signed so it can be negative
-    int i = std::distance(_state.relative_offset_index.begin(), it);
-    do {
-        if (_state.relative_offset_index[i] <= needle) {
-            return translate_index_entry(_state, _state.get_entry(i));
-        }
-    } while (i-- > 0);
-
+    if (*it <= needle) {
+        auto dist = std::distance(_state.relative_offset_index.begin(), it);
+        return translate_index_entry(_state, _state.get_entry(dist));
+    }
     return std::nullopt;
 }
 
@@ -121,6 +155,9 @@ ss::future<> segment_index::truncate(model::offset o) {
     if (o < _state.base_offset) {
         return ss::now();
     }
+    if (_headers.truncate(o)) {
+        _needs_persistence = true;
+    }
     const uint32_t i = o() - _state.base_offset();
     auto it = std::lower_bound(
       std::begin(_state.relative_offset_index),
@@ -163,25 +200,63 @@ ss::future<bool> segment_index::materialize_index() {
               return false;
           }
           _state = std::move(hydrated.value());
+          _released = false;
           return true;
+      })
+      .then([this](bool hydrated) {
+          if (!hydrated || !_headers_out) {
+              return ss::make_ready_future<bool>(hydrated);
+          }
+          // the sidecar is best effort: a missing or corrupt file only
+          // costs consumers the header-only fast path
+          return _headers_out->size()
+            .then([this](uint64_t size) {
+                return _headers_out->dma_read_bulk<char>(0, size);
+            })
+            .then([this, hydrated](ss::temporary_buffer<char> buf) {
+                if (!buf.empty()) {
+                    iobuf b;
+                    b.append(std::move(buf));
+                    auto headers = batch_header_index::hydrate_from_buffer(
+                      std::move(b));
+                    if (headers) {
+                        _headers = std::move(headers.value());
+                    }
+                }
+                return hydrated;
+            });
       });
 }
 
+ss::future<> segment_index::release() {
+    return flush().then([this] {
+        // free the entry arrays but keep the header fields; the on-disk
+        // serialized form remains the source of truth until re-hydration
+        _state.relative_offset_index = {};
+        _state.relative_time_index = {};
+        _state.position_index = {};
+        auto base = _headers.base_offset;
+        _headers = {};
+        _headers.base_offset = base;
+        _acc = 0;
+        _released = true;
+    });
+}
+
 ss::future<> segment_index::drop_all_data() {
     reset();
-    return _out.truncate(0);
+    return _out.truncate(0).then([this] {
+        if (_headers_out) {
+            return _headers_out->truncate(0);
+        }
+        return ss::now();
+    });
 }
 
-ss::future<> segment_index::flush() {
-    if (!_needs_persistence) {
-        return ss::make_ready_future<>();
-    }
-    _needs_persistence = false;
-    return _out.truncate(0)
-      .then(
-        [this] { return ss::make_file_output_stream(ss::file(_out.dup())); })
-      .then([this](ss::output_stream<char> out) {
-          auto b = _state.checksum_and_serialize();
+static ss::future<> persist_buffer(ss::file& f, iobuf b) {
+    return f.truncate(0)
+      .then([&f] { return ss::make_file_output_stream(ss::file(f.dup())); })
+      .then([b = std::move(b)](ss::output_stream<char> out) mutable {
           return do_with(
             std::move(b),
             std::move(out),
@@ -196,8 +271,44 @@ ss::future<> segment_index::flush() {
             });
       });
 }
+
+ss::future<> segment_index::flush_batch_headers() {
+    if (!_headers_out) {
+        return ss::now();
+    }
+    return persist_buffer(*_headers_out, _headers.checksum_and_serialize());
+}
+
+ss::future<bool> segment_index::flush_data() {
+    if (!_needs_persistence) {
+        return ss::make_ready_future<bool>(false);
+    }
+    _needs_persistence = false;
+    return persist_buffer(_out, _state.checksum_and_serialize())
+      .then([this] { return flush_batch_headers(); })
+      .then([] { return true; });
+}
+
+ss::future<> segment_index::barrier() {
+    return _out.flush().then([this] {
+        if (_headers_out) {
+            return _headers_out->flush();
+        }
+        return ss::now();
+    });
+}
+
+ss::future<> segment_index::flush() { return flush_data().discard_result(); }
+
 ss::future<> segment_index::close() {
-    return flush().then([this] { return _out.close(); });
+    return flush()
+      .then([this] { return _out.close(); })
+      .then([this] {
+          if (_headers_out) {
+              return _headers_out->close();
+          }
+          return ss::now();
+      });
 }
 std::ostream& operator<<(std::ostream& o, const segment_index& i) {
     return o << "{file:" << i.filename() << ", offsets:" << i.base_offset()
@@ -13,6 +13,7 @@
 #include "model/fundamental.h"
 #include "model/record.h"
 #include "model/timestamp.h"
+#include "storage/batch_header_index.h"
 #include "storage/index_state.h"
 
 #include <seastar/core/file.hh>
@@ -34,6 +35,13 @@ namespace storage {
  *
  * The name of this index _must_ be then:
  *     default/test/0/1-1-v1.base_index
+ *
+ * When constructed with a second file the index also maintains the
+ * batch_header_index sidecar (1-1-v1.header_index): one packed header
+ * row per batch, fed by the same maybe_track() calls on the append and
+ * recovery paths, persisted on the same flush/close points and cut by
+ * the same truncations. Without the file the sidecar state is kept in
+ * memory only and consumers fall back to scanning batch data.
  */
 class segment_index {
 public:
@@ -49,7 +57,11 @@ public:
     static constexpr size_t default_data_buffer_step = 4096 * 8;
 
     segment_index(
-      ss::sstring filename, ss::file, model::offset base, size_t step);
+      ss::sstring filename,
+      ss::file,
+      model::offset base,
+      size_t step,
+      std::optional<ss::file> batch_headers_file = std::nullopt);
     ~segment_index() noexcept = default;
     segment_index(segment_index&&) noexcept = default;
     segment_index& operator=(segment_index&&) noexcept = default;
@@ -59,6 +71,10 @@ public:
     void maybe_track(const model::record_batch_header&, size_t filepos);
     std::optional<entry> find_nearest(model::offset);
     std::optional<entry> find_nearest(model::timestamp);
+    /// last indexed entry with a timestamp strictly below t: a safe position
+    /// to start a forward scan from without missing the first batch whose
+    /// timestamp is >= t. used to seek timestamp queries.
+    std::optional<entry> find_nearest_before(model::timestamp);
 
     model::offset base_offset() const { return _state.base_offset; }
     model::offset max_offset() const { return _state.max_offset; }
@@ -68,7 +84,31 @@ public:
 
     ss::future<bool> materialize_index();
     ss::future<> close();
+
+    /**
+     * \brief flush the index and drop the in-memory entry arrays.
+     *
+     * The serialized fixed-width form stays on disk, so a released index
+     * keeps near-zero resident memory for a cold segment and can be
+     * re-hydrated on demand with materialize_index(). The header fields
+     * (base/max offsets and timestamps) remain available. While released,
+     * find_nearest() returns nullopt and readers degrade to a sequential
+     * scan from the start of the segment.
+     */
+    ss::future<> release();
+    bool released() const { return _released; }
     ss::future<> flush();
+    /**
+     * two-phase flush used by the batched index flush round. flush_data()
+     * serializes and writes the state of a dirty index without waiting for
+     * the device barrier and returns whether anything was written; a clean
+     * index writes nothing. barrier() issues the barrier for a previously
+     * written index. Batching the writes of many indices before a single
+     * group of barriers coalesces what would otherwise be scattered small
+     * write/sync pairs.
+     */
+    ss::future<bool> flush_data();
+    ss::future<> barrier();
     ss::future<> truncate(model::offset);
 
     /// \brief erases the underlying file and resets the index
@@ -82,13 +122,23 @@ public:
     void swap_index_state(index_state&&);
     bool needs_persistence() const { return _needs_persistence; }
 
+    /// per-batch header sidecar; empty when released or when the segment
+    /// predates the sidecar file, in which case callers scan batch data
+    const batch_header_index& batch_headers() const { return _headers; }
+    bool has_batch_headers() const { return !_headers.empty(); }
+
 private:
+    ss::future<> flush_batch_headers();
+
     ss::sstring _name;
     ss::file _out;
     size_t _step;
     size_t _acc{0};
     bool _needs_persistence{false};
+    bool _released{false};
     index_state _state;
+    std::optional<ss::file> _headers_out;
+    batch_header_index _headers;
 
     friend std::ostream& operator<<(std::ostream&, const segment_index&);
 };
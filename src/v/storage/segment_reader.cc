@@ -29,8 +29,8 @@ segment_reader::segment_reader(
   , _file_size(file_size)
   , _buffer_size(buffer_size) {}
 
-ss::input_stream<char>
-segment_reader::data_stream(size_t pos, const ss::io_priority_class& pc) {
+ss::input_stream<char> segment_reader::data_stream(
+  size_t pos, const ss::io_priority_class& pc, cold_read_hint cold) {
     vassert(
       pos <= _file_size,
       "cannot read negative bytes. Asked to read at position: '{}' - {}",
@@ -39,7 +39,33 @@ segment_reader::data_stream(size_t pos, const ss::io_priority_class& pc) {
     ss::file_input_stream_options options;
     options.buffer_size = _buffer_size;
     options.io_priority_class = pc;
-    options.read_ahead = 4; // FIXME: scylla uses 10
+    if (cold == cold_read_hint::yes) {
+        /*
+         * historical read-once scan: large reads amortize the per-io cost
+         * over data that will not be read again, and the shallow pipeline
+         * bounds the memory the scan holds. the sequential-detection state
+         * and the shared stream history are deliberately left untouched so
+         * a day-long backfill does not distort the readahead tuning of the
+         * consumers fetching from the tail.
+         */
+        options.buffer_size = cold_read_buffer_size;
+        options.read_ahead = cold_read_ahead;
+        return make_file_input_stream(
+          _data_file, pos, _file_size - pos, std::move(options));
+    }
+    /*
+     * a consumer that keeps up with the log re-creates its stream each time
+     * the previous one was drained (e.g. after stopping at the stable offset
+     * or exhausting its byte budget). when a new stream picks up at or right
+     * after the previous stream's start the access pattern is sequential, so
+     * deepen the read-ahead pipeline and keep background reads in flight
+     * between record_batch_reader pulls. random (e.g. historical seek) reads
+     * keep the shallower default.
+     */
+    options.read_ahead = (pos > 0 && pos >= _last_stream_pos)
+                           ? sequential_read_ahead
+                           : default_read_ahead;
+    _last_stream_pos = pos;
     options.dynamic_adjustments = _history;
     return make_file_input_stream(
       _data_file, pos, _file_size - pos, std::move(options));
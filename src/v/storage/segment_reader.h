@@ -18,6 +18,7 @@
 #include <seastar/core/fstream.hh>
 #include <seastar/core/io_queue.hh>
 #include <seastar/core/iostream.hh>
+#include <seastar/util/bool_class.hh>
 #include <seastar/util/log.hh>
 
 #include <optional>
@@ -26,6 +27,11 @@
 
 namespace storage {
 
+// historical read-once scan (e.g. a backfill consumer replaying old data);
+// streams opened with this hint use large reads and leave the reader's
+// sequential-detection state alone
+using cold_read_hint = ss::bool_class<struct cold_read_hint_tag>;
+
 class segment_reader {
 public:
     segment_reader(
@@ -62,14 +68,28 @@ public:
 
     /// create an input stream _sharing_ the underlying file handle
     /// starting at position @pos
-    ss::input_stream<char>
-    data_stream(size_t pos, const ss::io_priority_class&);
+    ss::input_stream<char> data_stream(
+      size_t pos,
+      const ss::io_priority_class&,
+      cold_read_hint = cold_read_hint::no);
 
 private:
+    // read-ahead depth (in buffers) for a freshly created stream and for a
+    // stream detected to continue a sequential scan of this segment
+    static constexpr unsigned default_read_ahead = 4;
+    static constexpr unsigned sequential_read_ahead = 10;
+    // cold scans amortize io with large reads and a shallow pipeline so a
+    // backfill pins a bounded amount of memory per open stream
+    static constexpr size_t cold_read_buffer_size = 1024 * 1024;
+    static constexpr unsigned cold_read_ahead = 2;
+
     ss::sstring _filename;
     ss::file _data_file;
     size_t _file_size{0};
     size_t _buffer_size{0};
+    // physical position at which the most recent stream was created. used to
+    // detect sequential consumers that re-create streams along the segment.
+    size_t _last_stream_pos{0};
     ss::lw_shared_ptr<ss::file_input_stream_history> _history
       = ss::make_lw_shared<ss::file_input_stream_history>();
 
@@ -9,6 +9,7 @@
 
 #include "storage/segment_set.h"
 
+#include "resource_mgmt/io_priority.h"
 #include "storage/fs_utils.h"
 #include "storage/log_replayer.h"
 #include "storage/logger.h"
@@ -21,9 +22,12 @@
 #include <seastar/core/seastar.hh>
 #include <seastar/core/thread.hh>
 
+#include <absl/container/flat_hash_map.h>
+#include <boost/range/irange.hpp>
 #include <fmt/format.h>
 
 #include <exception>
+#include <filesystem>
 
 namespace storage {
 struct segment_ordering {
@@ -42,6 +46,12 @@ struct segment_ordering {
 segment_set::segment_set(segment_set::underlying_t segs)
   : _handles(std::move(segs)) {
     std::sort(_handles.begin(), _handles.end(), segment_ordering{});
+    _base_offsets.reserve(_handles.size());
+    _max_timestamps.reserve(_handles.size());
+    for (auto& s : _handles) {
+        _base_offsets.push_back(s->offsets().base_offset);
+        _max_timestamps.push_back(s->index().max_timestamp());
+    }
 }
 
 void segment_set::add(ss::lw_shared_ptr<segment> h) {
@@ -55,11 +65,26 @@ void segment_set::add(ss::lw_shared_ptr<segment> h) {
           *h,
           *this);
     }
+    if (!_handles.empty()) {
+        // the previous tail just rolled and is now immutable: freeze its
+        // max timestamp into the flat level
+        _max_timestamps.back() = _handles.back()->index().max_timestamp();
+    }
+    _base_offsets.push_back(h->offsets().base_offset);
+    _max_timestamps.push_back(h->index().max_timestamp());
     _handles.emplace_back(std::move(h));
 }
 
-void segment_set::pop_back() { _handles.pop_back(); }
-void segment_set::pop_front() { _handles.pop_front(); }
+void segment_set::pop_back() {
+    _handles.pop_back();
+    _base_offsets.pop_back();
+    _max_timestamps.pop_back();
+}
+void segment_set::pop_front() {
+    _handles.pop_front();
+    _base_offsets.pop_front();
+    _max_timestamps.pop_front();
+}
 
 template<typename Iterator>
 struct needle_in_range {
@@ -104,19 +129,61 @@ Iterator segments_lower_bound(Iterator begin, Iterator end, Needle needle) {
     return end;
 }
 
-/// lower_bound returns the element that is _strictly_ greater than or equal
-/// to bucket->dirty_offset() - see comparator above because our offsets are
-/// _inclusive_ we must check the previous iterator in the case that we are at
-/// the end, we also check the last element.
+/// resolves the bucket hint from the flat offset level against the actual
+/// segments. the hinted segment is the only one whose range can contain the
+/// needle; we also probe its predecessor to step over an empty tail bucket
+template<typename Iterator>
+Iterator offset_level_lower_bound(
+  Iterator begin, Iterator end, size_t hint, model::offset needle) {
+    auto it = begin + hint;
+    if (needle_in_range<Iterator>()(it, needle)) {
+        return it;
+    }
+    if (it != begin && needle_in_range<Iterator>()(std::prev(it), needle)) {
+        return std::prev(it);
+    }
+    return end;
+}
+
+size_t segment_set::bucket_index(model::offset needle) const {
+    auto it = std::upper_bound(
+      _base_offsets.begin(), _base_offsets.end(), needle);
+    if (it == _base_offsets.begin()) {
+        return 0;
+    }
+    return std::distance(_base_offsets.begin(), std::prev(it));
+}
+
+/// offset lookups binary search the contiguous base-offset level instead of
+/// dereferencing every segment, with a fast path for the active tail segment
+/// since appends and tailing readers dominate the lookup traffic
 segment_set::iterator segment_set::lower_bound(model::offset offset) {
-    return segments_lower_bound(
-      std::begin(_handles), std::end(_handles), offset);
+    if (_handles.empty()) {
+        return end();
+    }
+    auto& tail = *_handles.back();
+    if (
+      !tail.empty() && offset >= tail.offsets().base_offset
+      && offset <= tail.offsets().dirty_offset) {
+        return std::prev(end());
+    }
+    return offset_level_lower_bound(
+      begin(), end(), bucket_index(offset), offset);
 }
 
 segment_set::const_iterator
 segment_set::lower_bound(model::offset offset) const {
-    return segments_lower_bound(
-      std::cbegin(_handles), std::cend(_handles), offset);
+    if (_handles.empty()) {
+        return end();
+    }
+    auto& tail = *_handles.back();
+    if (
+      !tail.empty() && offset >= tail.offsets().base_offset
+      && offset <= tail.offsets().dirty_offset) {
+        return std::prev(end());
+    }
+    return offset_level_lower_bound(
+      cbegin(), cend(), bucket_index(offset), offset);
 }
 // Lower bound for timestamp based indexing
 //
@@ -149,9 +216,13 @@ std::ostream& operator<<(std::ostream& o, const segment_set& s) {
 // Recover the last segment. Whenever we close a segment, we will likely
 // open a new one to which we will direct new writes. That new segment
 // might be empty. To optimize log replay, implement #140.
-static ss::future<segment_set>
-unsafe_do_recover(segment_set&& segments, ss::abort_source& as) {
-    return ss::async([segments = std::move(segments), &as]() mutable {
+static ss::future<segment_set> unsafe_do_recover(
+  segment_set&& segments,
+  std::optional<ss::sstring> last_clean_segment,
+  ss::abort_source& as) {
+    return ss::async([segments = std::move(segments),
+                      last_clean_segment = std::move(last_clean_segment),
+                      &as]() mutable {
         if (segments.empty() || as.abort_requested()) {
             return std::move(segments);
         }
@@ -186,13 +257,26 @@ unsafe_do_recover(segment_set&& segments, ss::abort_source& as) {
           good_end,
           good.end()); // remove all the ones we copied into recover
 
+        // issue the stats for every recovery candidate at once; the empty
+        // segment scan then costs one device round trip instead of one
+        // per file
+        absl::flat_hash_map<const segment*, off_t> sizes;
+        sizes.reserve(to_recover.size());
+        ss::parallel_for_each(
+          to_recover,
+          [&sizes](ss::lw_shared_ptr<segment>& s) {
+              return s->reader().stat().then([&sizes, &s](struct stat st) {
+                  sizes.emplace(s.get(), st.st_size);
+              });
+          })
+          .get();
+
         // remove empty segments
         auto non_empty_end = std::stable_partition(
           to_recover.begin(),
           to_recover.end(),
-          [](ss::lw_shared_ptr<segment>& segment) {
-              auto stat = segment->reader().stat().get0();
-              if (stat.st_size != 0) {
+          [&sizes](ss::lw_shared_ptr<segment>& segment) {
+              if (sizes[segment.get()] != 0) {
                   return true;
               }
               vlog(stlog.info, "Removing empty segment: {}", segment);
@@ -210,38 +294,78 @@ unsafe_do_recover(segment_set&& segments, ss::abort_source& as) {
             good.pop_back();
         }
 
-        for (auto& s : to_recover) {
-            // check for abort
-            if (unlikely(as.abort_requested())) {
-                return segment_set(std::move(good));
-            }
-            auto replayer = log_replayer(*s);
-            auto recovered = replayer.recover_in_thread(
-              ss::default_priority_class());
-            if (!recovered) {
-                vlog(stlog.info, "Unable to recover segment: {}", s);
-                s->close().get();
-                ss::rename_file(
-                  s->reader().filename(),
-                  s->reader().filename() + ".cannotrecover")
-                  .get();
-                continue;
+        /*
+         * replay the remaining segments with bounded concurrency. segments
+         * are independent for recovery purposes: checksums and truncation
+         * points are strictly per-segment, and the final segment_set sorts
+         * by base offset. a segment named by the clean-shutdown marker can
+         * skip checksum replay entirely; its index was flushed on close and
+         * only needs to be materialized.
+         */
+        static constexpr size_t max_concurrent_recoveries = 8;
+        ss::semaphore limit(max_concurrent_recoveries);
+        segment_set::underlying_t recovered(to_recover.size());
+        ss::parallel_for_each(
+          boost::irange<size_t>(0, to_recover.size()),
+          [&](size_t i) {
+              return ss::with_semaphore(limit, 1, [&, i] {
+                  return ss::async([&, i] {
+                      // check for abort
+                      if (unlikely(as.abort_requested())) {
+                          return;
+                      }
+                      auto& s = to_recover[i];
+                      if (
+                        last_clean_segment
+                        && std::filesystem::path(s->reader().filename())
+                               .filename()
+                               .string()
+                             == *last_clean_segment) {
+                          vlog(
+                            stlog.debug,
+                            "Skipping recovery of {}, it was closed cleanly",
+                            s->reader().filename());
+                          s->materialize_index().get();
+                          recovered[i] = std::move(s);
+                          return;
+                      }
+                      auto replayer = log_replayer(*s);
+                      auto replayed = replayer.recover_in_thread(
+                        recovery_priority());
+                      if (!replayed) {
+                          vlog(stlog.info, "Unable to recover segment: {}", s);
+                          s->close().get();
+                          ss::rename_file(
+                            s->reader().filename(),
+                            s->reader().filename() + ".cannotrecover")
+                            .get();
+                          return;
+                      }
+                      s->truncate(
+                         replayed.last_offset.value(),
+                         replayed.truncate_file_pos.value())
+                        .get();
+                      // persist index
+                      s->index().flush().get();
+                      vlog(stlog.info, "Recovered: {}", s);
+                      recovered[i] = std::move(s);
+                  });
+              });
+          })
+          .get();
+        for (auto& s : recovered) {
+            if (s) {
+                good.emplace_back(std::move(s));
             }
-            s->truncate(
-               recovered.last_offset.value(),
-               recovered.truncate_file_pos.value())
-              .get();
-            // persist index
-            s->index().flush().get();
-            vlog(stlog.info, "Recovered: {}", s);
-            good.emplace_back(std::move(s));
         }
         return segment_set(std::move(good));
     });
 }
 
-static ss::future<segment_set>
-do_recover(segment_set&& segments, ss::abort_source& as) {
+static ss::future<segment_set> do_recover(
+  segment_set&& segments,
+  std::optional<ss::sstring> last_clean_segment,
+  ss::abort_source& as) {
     // light-weight copy used for clean-up if recovery fails
     segment_set::underlying_t copy;
     copy.reserve(segments.size());
@@ -253,7 +377,7 @@ do_recover(segment_set&& segments, ss::abort_source& as) {
     // are any pending io operations on a file associated with the segment
     // at the time of destruction seastar will complain about the file handle
     // being destroyed with pending ops.
-    return unsafe_do_recover(std::move(segments), as)
+    return unsafe_do_recover(std::move(segments), std::move(last_clean_segment), as)
       .handle_exception(
         [copy = std::move(copy)](const std::exception_ptr& ex) mutable {
             return ss::do_with(
@@ -285,11 +409,16 @@ static ss::future<segment_set::underlying_t> open_segments(
   std::function<std::optional<batch_cache_index>()> cache_factory,
   ss::abort_source& as) {
     using segs_type = segment_set::underlying_t;
+    // one open is a handful of serial syscalls; overlapping them makes the
+    // discovery phase bound by the device queue depth instead of the
+    // per-file round trip. the final segment_set sorts by base offset so
+    // completion order does not matter
+    static constexpr size_t max_concurrent_opens = 32;
     return ss::do_with(
       segs_type{},
       [&as, cache_factory, sanitize_fileops, dir = std::move(dir)](
         segs_type& segs) {
-          auto f = directory_walker::walk(
+          auto f = directory_walker::walk_parallel(
             dir,
             [&as, cache_factory, dir, sanitize_fileops, &segs](
               ss::directory_entry seg) {
@@ -320,7 +449,8 @@ static ss::future<segment_set::underlying_t> open_segments(
                   .then([&segs](ss::lw_shared_ptr<segment> p) {
                       segs.push_back(std::move(p));
                   });
-            });
+            },
+            max_concurrent_opens);
           /*
            * if the directory walker returns an exceptional future then all
            * the segment readers that were created are cleaned up by
@@ -337,13 +467,17 @@ ss::future<segment_set> recover_segments(
   debug_sanitize_files sanitize_fileops,
   bool is_compaction_enabled,
   std::function<std::optional<batch_cache_index>()> cache_factory,
+  std::optional<ss::sstring> last_clean_segment,
   ss::abort_source& as) {
     return ss::recursive_touch_directory(path.string())
       .then([&as, cache_factory, sanitize_fileops, path = std::move(path)] {
           return open_segments(
             path.string(), sanitize_fileops, cache_factory, as);
       })
-      .then([&as, is_compaction_enabled](segment_set::underlying_t segs) {
+      .then([&as,
+             is_compaction_enabled,
+             last_clean_segment = std::move(last_clean_segment)](
+              segment_set::underlying_t segs) mutable {
           auto segments = segment_set(std::move(segs));
           // we have to mark compacted segments before recovery to allow reading
           // gaps introduced by compaction
@@ -352,7 +486,8 @@ ss::future<segment_set> recover_segments(
                   s->mark_as_compacted_segment();
               }
           }
-          return do_recover(std::move(segments), as);
+          return do_recover(
+            std::move(segments), std::move(last_clean_segment), as);
       });
 }
 
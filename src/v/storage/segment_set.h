@@ -73,6 +73,19 @@ public:
     iterator lower_bound(model::timestamp o);
     const_iterator lower_bound(model::timestamp o) const;
 
+    /// Max timestamp of the i-th segment, for retention evaluation. Served
+    /// from the flat level for closed segments - their value is frozen at
+    /// roll - while the active tail segment is still growing, so its live
+    /// index is consulted. Compaction may shrink a closed segment's real
+    /// max timestamp below the frozen value; the error only delays
+    /// eviction, never evicts early.
+    model::timestamp max_timestamp(size_t i) const {
+        if (i + 1 == _handles.size()) {
+            return _handles[i]->index().max_timestamp();
+        }
+        return _max_timestamps[i];
+    }
+
     const_iterator cbegin() const { return _handles.cbegin(); }
     const_iterator cend() const { return _handles.cend(); }
     iterator begin() { return _handles.begin(); }
@@ -81,7 +94,19 @@ public:
     const_iterator end() const { return _handles.end(); }
 
 private:
+    /// index into _handles of the rightmost segment whose base offset is
+    /// not greater than the needle - the only candidate that can contain it
+    size_t bucket_index(model::offset) const;
+
     underlying_t _handles;
+    // flat level of base offsets kept parallel to _handles. offset lookups
+    // binary search this contiguous level instead of chasing the segment
+    // shared pointers, then verify against at most two segments
+    ss::circular_buffer<model::offset> _base_offsets;
+    // flat level of per-segment max timestamps, frozen when a segment is
+    // rolled. time based retention walks this level instead of touching
+    // every segment's index state
+    ss::circular_buffer<model::timestamp> _max_timestamps;
 
     friend std::ostream& operator<<(std::ostream&, const segment_set&);
 };
@@ -91,6 +116,7 @@ ss::future<segment_set> recover_segments(
   debug_sanitize_files sanitize_fileops,
   bool is_compaction_enabled,
   std::function<std::optional<batch_cache_index>()> batch_cache_factory,
+  std::optional<ss::sstring> last_clean_segment,
   ss::abort_source& as);
 
 std::ostream& operator<<(std::ostream&, const segment_set&);
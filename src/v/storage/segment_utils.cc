@@ -32,6 +32,7 @@
 
 #include <seastar/core/file-types.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/queue.hh>
 #include <seastar/core/reactor.hh>
 #include <seastar/core/rwlock.hh>
 #include <seastar/core/seastar.hh>
@@ -155,8 +156,24 @@ size_t number_of_chunks_from_config(const ntp_config& ntpc) {
 
 ss::future<Roaring>
 natural_index_of_entries_to_keep(compacted_index_reader reader) {
-    reader.reset();
-    return reader.consume(compaction_key_reducer(), model::no_timeout);
+    return reader.load_footer().then(
+      [reader](compacted_index::footer footer) mutable {
+          // first pass: build a bloom filter of duplicate-candidate keys so
+          // the exact key map in the second pass only ever materializes keys
+          // that may need deduplication
+          reader.reset();
+          return reader
+            .consume(
+              key_duplicate_filter_reducer(footer.keys), model::no_timeout)
+            .then([reader](bloom_filter duplicates) mutable {
+                reader.reset();
+                return reader.consume(
+                  compaction_key_reducer(
+                    compaction_key_reducer::default_max_memory_usage,
+                    std::move(duplicates)),
+                  model::no_timeout);
+            });
+      });
 }
 
 ss::future<> copy_filtered_entries(
@@ -269,6 +286,13 @@ generate_compacted_list(model::offset o, compacted_index_reader reader) {
       .finally([reader] {});
 }
 
+ss::future<compacted_offset_translator>
+generate_offset_translator(model::offset o, compacted_index_reader reader) {
+    reader.reset();
+    return reader.consume(offset_translator_reducer(o), model::no_timeout)
+      .finally([reader] {});
+}
+
 ss::future<>
 do_compact_segment_index(ss::lw_shared_ptr<segment> s, compaction_config cfg) {
     auto compacted_path = std::filesystem::path(s->reader().filename());
@@ -281,6 +305,76 @@ do_compact_segment_index(ss::lw_shared_ptr<segment> s, compaction_config cfg) {
           return write_clean_compacted_index(reader, cfg);
       });
 }
+/*
+ * Pipelined rewrite stage. Reading the source segment and appending the
+ * filtered batches to the staging segment are decoupled through a bounded
+ * queue, so the dma read of the next slice overlaps the dma writes of the
+ * previous one instead of strictly alternating. The queue is bounded by
+ * batch count to keep memory usage in check, and every push/pop is a
+ * scheduling point so produce traffic on the shard keeps making progress
+ * while a large segment is rewritten.
+ */
+static constexpr size_t compaction_pipeline_depth = 16;
+
+using compaction_pipeline_t = ss::queue<std::optional<model::record_batch>>;
+
+struct pipeline_filling_consumer {
+    explicit pipeline_filling_consumer(compaction_pipeline_t& q)
+      : _queue(&q) {}
+
+    ss::future<ss::stop_iteration> operator()(model::record_batch b) {
+        return _queue->push_eventually(std::move(b)).then([] {
+            return ss::stop_iteration::no;
+        });
+    }
+    void end_of_stream() {}
+
+    compaction_pipeline_t* _queue;
+};
+
+static ss::future<storage::index_state> copy_data_segment_pipelined(
+  std::optional<compacted_offset_list> list,
+  segment_appender* appender,
+  model::record_batch_reader reader) {
+    return ss::do_with(
+      compaction_pipeline_t(compaction_pipeline_depth),
+      copy_data_segment_reducer(std::move(list), appender),
+      std::move(reader),
+      [](
+        compaction_pipeline_t& queue,
+        copy_data_segment_reducer& red,
+        model::record_batch_reader& reader) {
+          auto producer
+            = std::move(reader)
+                .consume(pipeline_filling_consumer(queue), model::no_timeout)
+                .then([&queue] {
+                    // sentinel: the source segment is exhausted
+                    return queue.push_eventually(std::nullopt);
+                })
+                .handle_exception([&queue](std::exception_ptr e) {
+                    // wake the append side so the error propagates
+                    queue.abort(e);
+                });
+          auto consumer
+            = ss::repeat([&queue, &red] {
+                  return queue.pop_eventually().then(
+                    [&red](std::optional<model::record_batch> b) {
+                        if (!b) {
+                            return ss::make_ready_future<ss::stop_iteration>(
+                              ss::stop_iteration::yes);
+                        }
+                        return red(std::move(*b));
+                    });
+              }).handle_exception([&queue](std::exception_ptr e) {
+                  // unblock the read side; it may be parked on a full queue
+                  queue.abort(e);
+                  return ss::make_exception_future<>(e);
+              });
+          return ss::when_all_succeed(std::move(producer), std::move(consumer))
+            .then([&red] { return red.end_of_stream(); });
+      });
+}
+
 ss::future<storage::index_state> do_copy_segment_data(
   ss::lw_shared_ptr<segment> s,
   compaction_config cfg,
@@ -308,10 +402,9 @@ ss::future<storage::index_state> do_copy_segment_data(
               .then([l = std::move(list), &pb, h = std::move(h), cfg, s](
                       segment_appender_ptr w) mutable {
                   auto raw = w.get();
-                  auto red = copy_data_segment_reducer(std::move(l), raw);
                   auto r = create_segment_full_reader(s, cfg, pb, std::move(h));
-                  return std::move(r)
-                    .consume(std::move(red), model::no_timeout)
+                  return copy_data_segment_pipelined(
+                           std::move(l), raw, std::move(r))
                     .finally([raw, w = std::move(w)]() mutable {
                         return raw->close()
                           .handle_exception([](std::exception_ptr e) {
@@ -381,33 +474,23 @@ ss::future<> do_swap_data_file_handles(
       });
 }
 
-ss::future<> do_self_compact_segment(
-  ss::lw_shared_ptr<segment> s, compaction_config cfg, storage::probe& pb) {
-    return s->read_lock()
-      .then([cfg, s, &pb](ss::rwlock::holder h) {
+/// once the staging file is fully written: take the write lock, swap the
+/// staging file in under the segment's name and install the rebuilt offset
+/// index. shared tail of self-compaction and the format upgrade rewrite.
+static ss::future<> swap_in_staging_segment(
+  ss::lw_shared_ptr<segment> s,
+  compaction_config cfg,
+  storage::probe& pb,
+  storage::index_state idx) {
+    return s->write_lock()
+      .then([s, idx = std::move(idx)](ss::rwlock::holder h) mutable {
+          using type = std::tuple<index_state, ss::rwlock::holder>;
           if (s->is_closed()) {
-              return ss::make_exception_future<index_state>(
+              return ss::make_exception_future<type>(
                 segment_closed_exception());
           }
-
-          return do_compact_segment_index(s, cfg)
-            // copy the bytes after segment is good - note that we
-            // need to do it with the READ-lock, not the write lock
-            .then([cfg, s, h = std::move(h), &pb]() mutable {
-                return do_copy_segment_data(s, cfg, pb, std::move(h));
-            });
-      })
-      .then([s](storage::index_state idx) {
-          return s->write_lock().then(
-            [s, idx = std::move(idx)](ss::rwlock::holder h) mutable {
-                using type = std::tuple<index_state, ss::rwlock::holder>;
-                if (s->is_closed()) {
-                    return ss::make_exception_future<type>(
-                      segment_closed_exception());
-                }
-                return ss::make_ready_future<type>(
-                  std::make_tuple(std::move(idx), std::move(h)));
-            });
+          return ss::make_ready_future<type>(
+            std::make_tuple(std::move(idx), std::move(h)));
       })
       .then([cfg, s, &pb](std::tuple<index_state, ss::rwlock::holder> h) {
           return s->index()
@@ -427,6 +510,73 @@ ss::future<> do_self_compact_segment(
       });
 }
 
+ss::future<> do_self_compact_segment(
+  ss::lw_shared_ptr<segment> s, compaction_config cfg, storage::probe& pb) {
+    return s->read_lock()
+      .then([cfg, s, &pb](ss::rwlock::holder h) {
+          if (s->is_closed()) {
+              return ss::make_exception_future<index_state>(
+                segment_closed_exception());
+          }
+
+          return do_compact_segment_index(s, cfg)
+            // copy the bytes after segment is good - note that we
+            // need to do it with the READ-lock, not the write lock
+            .then([cfg, s, h = std::move(h), &pb]() mutable {
+                return do_copy_segment_data(s, cfg, pb, std::move(h));
+            });
+      })
+      .then([s, cfg, &pb](storage::index_state idx) {
+          return swap_in_staging_segment(s, cfg, pb, std::move(idx));
+      });
+}
+
+ss::future<> upgrade_segment_format(
+  ss::lw_shared_ptr<segment> s, compaction_config cfg, storage::probe& pb) {
+    if (s->has_appender()) {
+        return ss::make_exception_future<>(std::runtime_error(fmt::format(
+          "Cannot rewrite an active segment. cfg:{} - segment:{}", cfg, s)));
+    }
+    // unfiltered rewrite through the compaction staging machinery: every
+    // batch is copied into a staging file written by the current appender
+    // (newest format and index layout), then swapped in under the same
+    // name. a crash before the caller persists the upgrade marker simply
+    // redoes the rewrite - the copy is idempotent.
+    return s->read_lock()
+      .then([cfg, s, &pb](ss::rwlock::holder h) {
+          if (s->is_closed()) {
+              return ss::make_exception_future<index_state>(
+                segment_closed_exception());
+          }
+          const auto tmpname = data_segment_staging_name(s);
+          return make_segment_appender(
+                   tmpname,
+                   cfg.sanitize,
+                   segment_appender::chunks_no_buffer,
+                   cfg.iopc)
+            .then([&pb, h = std::move(h), cfg, s](
+                    segment_appender_ptr w) mutable {
+                auto raw = w.get();
+                auto r = create_segment_full_reader(s, cfg, pb, std::move(h));
+                return copy_data_segment_pipelined(
+                         std::nullopt, raw, std::move(r))
+                  .finally([raw, w = std::move(w)]() mutable {
+                      return raw->close()
+                        .handle_exception([](std::exception_ptr e) {
+                            vlog(
+                              stlog.error,
+                              "Error closing format upgrade staging file:{}",
+                              e);
+                        })
+                        .finally([w = std::move(w)] {});
+                  });
+            });
+      })
+      .then([s, cfg, &pb](storage::index_state idx) {
+          return swap_in_staging_segment(s, cfg, pb, std::move(idx));
+      });
+}
+
 ss::future<> rebuild_compaction_index(
   model::record_batch_reader rdr,
   std::filesystem::path p,
@@ -524,4 +674,17 @@ bytes start_offset_key(model::ntp ntp) {
     return iobuf_to_bytes(buf);
 }
 
+bytes clean_segment_key(model::ntp ntp) {
+    iobuf buf;
+    reflection::serialize(buf, kvstore_key_type::clean_segment, std::move(ntp));
+    return iobuf_to_bytes(buf);
+}
+
+bytes format_upgraded_offset_key(model::ntp ntp) {
+    iobuf buf;
+    reflection::serialize(
+      buf, kvstore_key_type::format_upgraded_offset, std::move(ntp));
+    return iobuf_to_bytes(buf);
+}
+
 } // namespace storage::internal
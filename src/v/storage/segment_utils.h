@@ -15,6 +15,7 @@
 #include "storage/compacted_index_reader.h"
 #include "storage/compacted_index_writer.h"
 #include "storage/compacted_offset_list.h"
+#include "storage/compacted_offset_translator.h"
 #include "storage/probe.h"
 #include "storage/segment.h"
 #include "storage/segment_appender.h"
@@ -35,6 +36,16 @@ ss::future<> self_compact_segment(
   storage::compaction_config,
   storage::probe&);
 
+/// \brief rewrites a sealed segment in place through the staging-file
+/// machinery so its data file and offset index come out in the newest
+/// on-disk format. acquires its own locks; the copy is unfiltered and
+/// idempotent, callers persist completion separately (see
+/// format_upgraded_offset_key)
+ss::future<> upgrade_segment_format(
+  ss::lw_shared_ptr<storage::segment>,
+  storage::compaction_config,
+  storage::probe&);
+
 /// make file handle with default opts
 ss::future<ss::file>
 make_writer_handle(const std::filesystem::path&, storage::debug_sanitize_files);
@@ -80,6 +91,11 @@ ss::future<> write_clean_compacted_index(
 ss::future<compacted_offset_list>
   generate_compacted_list(model::offset, storage::compacted_index_reader);
 
+/// \brief builds the gapped->dense offset translation of a compacted
+/// segment from its compacted index, without touching segment data
+ss::future<compacted_offset_translator>
+  generate_offset_translator(model::offset, storage::compacted_index_reader);
+
 ss::future<bool>
   detect_if_segment_already_compacted(std::filesystem::path, compaction_config);
 
@@ -100,7 +116,8 @@ ss::future<storage::index_state> do_copy_segment_data(
 ss::future<> do_swap_data_file_handles(
   std::filesystem::path compacted,
   ss::lw_shared_ptr<storage::segment>,
-  storage::compaction_config);
+  storage::compaction_config,
+  storage::probe&);
 
 std::filesystem::path compacted_index_path(std::filesystem::path segment_path);
 
@@ -113,8 +130,22 @@ size_t
 // key types used to store data in key-value store
 enum class kvstore_key_type : int8_t {
     start_offset = 0,
+    clean_segment = 1,
+    format_upgraded_offset = 2,
 };
 
 bytes start_offset_key(model::ntp ntp);
+bytes clean_segment_key(model::ntp ntp);
+// per-ntp watermark of the background format upgrader: sealed segments with
+// a base offset at or below the stored offset have been rewritten to
+// latest_segment_version. written only after the rewrite is on disk, so a
+// crash mid-rewrite redoes the (idempotent) copy.
+bytes format_upgraded_offset_key(model::ntp ntp);
+
+// stored under the clean_segment key on clean shutdown. names the last
+// segment of the log at close time so recovery can skip checksum replay.
+struct clean_segment_value {
+    ss::sstring segment_name;
+};
 
 } // namespace storage::internal
@@ -14,6 +14,7 @@
 #include "hashing/crc32c.h"
 #include "random/generators.h"
 #include "reflection/adl.h"
+#include "storage/dirsync_coordinator.h"
 #include "utils/directory_walker.h"
 
 #include <seastar/core/iostream.hh>
@@ -23,7 +24,7 @@
 namespace storage {
 
 ss::future<std::optional<snapshot_reader>> snapshot_manager::open_snapshot() {
-    auto path = _dir / snapshot_filename;
+    auto path = snapshot_path();
     return ss::file_exists(path.string()).then([this, path](bool exists) {
         if (!exists) {
             return ss::make_ready_future<std::optional<snapshot_reader>>(
@@ -47,7 +48,7 @@ ss::future<snapshot_writer> snapshot_manager::start_snapshot() {
     // unique file names when tests run fast.
     auto filename = fmt::format(
       "{}.partial.{}.{}",
-      snapshot_filename,
+      _filename,
       ss::lowres_system_clock::now().time_since_epoch().count(),
       random_generators::gen_alphanum_string(4));
 
@@ -69,12 +70,16 @@ ss::future<snapshot_writer> snapshot_manager::start_snapshot() {
 
 ss::future<> snapshot_manager::finish_snapshot(snapshot_writer& writer) {
     return ss::rename_file(writer.path().string(), snapshot_path().string())
-      .then([this] { return ss::sync_directory(_dir.string()); });
+      .then([this] {
+          // many raft groups snapshot in the same window; coalesce the
+          // directory fsyncs shard wide
+          return internal::dir_syncer().sync(_dir.string());
+      });
 }
 
 ss::future<> snapshot_manager::remove_partial_snapshots() {
     std::regex re(fmt::format(
-      "^{}\\.partial\\.(\\d+)\\.([a-zA-Z0-9]{{4}})$", snapshot_filename));
+      "^{}\\.partial\\.(\\d+)\\.([a-zA-Z0-9]{{4}})$", _filename));
     return directory_walker::walk(
       _dir.string(), [this, re = std::move(re)](ss::directory_entry ent) {
           if (!ent.type || *ent.type != ss::directory_entry_type::regular) {
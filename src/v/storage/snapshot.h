@@ -89,12 +89,22 @@ class snapshot_writer;
  *       mgr.remove_partial_snapshots();
  */
 class snapshot_manager {
-    static constexpr const char* snapshot_filename = "snapshot";
+    static constexpr const char* default_snapshot_filename = "snapshot";
 
 public:
     snapshot_manager(
       std::filesystem::path dir, ss::io_priority_class io_prio) noexcept
+      : snapshot_manager(std::move(dir), default_snapshot_filename, io_prio) {}
+
+    // several independent snapshots can live in the same directory when
+    // each manager is given its own filename (e.g. one per kvstore key
+    // space)
+    snapshot_manager(
+      std::filesystem::path dir,
+      ss::sstring filename,
+      ss::io_priority_class io_prio) noexcept
       : _dir(std::move(dir))
+      , _filename(std::move(filename))
       , _io_prio(io_prio) {}
 
     ss::future<std::optional<snapshot_reader>> open_snapshot();
@@ -103,13 +113,14 @@ public:
     ss::future<> finish_snapshot(snapshot_writer&);
 
     std::filesystem::path snapshot_path() const {
-        return _dir / snapshot_filename;
+        return _dir / _filename.c_str();
     }
 
     ss::future<> remove_partial_snapshots();
 
 private:
     std::filesystem::path _dir;
+    ss::sstring _filename;
     ss::io_priority_class _io_prio;
 };
 
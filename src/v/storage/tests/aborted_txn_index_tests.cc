@@ -0,0 +1,88 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/bytes.h"
+#include "storage/aborted_txn_index.h"
+#include "test_utils/fixture.h"
+
+#include <boost/test/unit_test_suite.hpp>
+
+struct aborted_txn_index_fixture {
+    static storage::aborted_txn_index make_index(model::offset base) {
+        storage::aborted_txn_index idx;
+        idx.base_offset = base;
+        return idx;
+    }
+};
+
+FIXTURE_TEST(tx_index_round_trip, aborted_txn_index_fixture) {
+    auto idx = make_index(model::offset(100));
+    idx.add_entry(7, model::offset(110), model::offset(120));
+    idx.add_entry(9, model::offset(150), model::offset(155));
+
+    auto buf = idx.checksum_and_serialize();
+    auto hydrated = storage::aborted_txn_index::hydrate_from_buffer(
+      std::move(buf));
+    BOOST_REQUIRE(bool(hydrated));
+    BOOST_REQUIRE_EQUAL(hydrated->base_offset, model::offset(100));
+    auto entries = hydrated->collect(model::offset(0), model::offset(1000));
+    BOOST_REQUIRE_EQUAL(entries.size(), 2);
+    BOOST_REQUIRE_EQUAL(entries[0].producer_id, 7);
+    BOOST_REQUIRE_EQUAL(entries[0].first_offset, model::offset(110));
+    BOOST_REQUIRE_EQUAL(entries[0].last_offset, model::offset(120));
+    BOOST_REQUIRE_EQUAL(entries[1].producer_id, 9);
+}
+
+FIXTURE_TEST(tx_index_rejects_corruption, aborted_txn_index_fixture) {
+    auto idx = make_index(model::offset(0));
+    idx.add_entry(1, model::offset(5), model::offset(9));
+    auto buf = idx.checksum_and_serialize();
+    // flip the last byte so the checksum no longer matches
+    auto bytes = iobuf_to_bytes(buf);
+    bytes[bytes.size() - 1] ^= 0xff;
+    auto mangled = bytes_to_iobuf(bytes);
+    BOOST_REQUIRE(!storage::aborted_txn_index::hydrate_from_buffer(
+      std::move(mangled)));
+}
+
+FIXTURE_TEST(tx_index_collect_overlap, aborted_txn_index_fixture) {
+    auto idx = make_index(model::offset(0));
+    idx.add_entry(1, model::offset(0), model::offset(10));
+    idx.add_entry(2, model::offset(20), model::offset(30));
+    idx.add_entry(3, model::offset(40), model::offset(50));
+
+    // range touching only the middle entry
+    auto entries = idx.collect(model::offset(25), model::offset(35));
+    BOOST_REQUIRE_EQUAL(entries.size(), 1);
+    BOOST_REQUIRE_EQUAL(entries[0].producer_id, 2);
+    // boundary overlap on last offset
+    entries = idx.collect(model::offset(10), model::offset(15));
+    BOOST_REQUIRE_EQUAL(entries.size(), 1);
+    BOOST_REQUIRE_EQUAL(entries[0].producer_id, 1);
+    // disjoint range
+    entries = idx.collect(model::offset(11), model::offset(19));
+    BOOST_REQUIRE(entries.empty());
+}
+
+FIXTURE_TEST(tx_index_truncate, aborted_txn_index_fixture) {
+    auto idx = make_index(model::offset(0));
+    idx.add_entry(1, model::offset(0), model::offset(10));
+    idx.add_entry(2, model::offset(20), model::offset(30));
+    idx.add_entry(3, model::offset(40), model::offset(50));
+
+    // drops the last entry entirely and clips the one spanning the point
+    idx.truncate(model::offset(25));
+    auto entries = idx.collect(model::offset(0), model::offset(1000));
+    BOOST_REQUIRE_EQUAL(entries.size(), 2);
+    BOOST_REQUIRE_EQUAL(entries[1].producer_id, 2);
+    BOOST_REQUIRE_EQUAL(entries[1].last_offset, model::offset(24));
+
+    idx.truncate(model::offset(0));
+    BOOST_REQUIRE(idx.empty());
+}
@@ -58,3 +58,21 @@ SEASTAR_THREAD_TEST_CASE(chunk_manipulation) {
         BOOST_REQUIRE_EQUAL(c.dma_size(), 0);
     }
 }
+
+SEASTAR_THREAD_TEST_CASE(chunk_zero_pad) {
+    const auto b = random_generators::gen_alphanum_string(alignment);
+    chunk c(alignment);
+    // dirty the first page, then recycle the chunk without zeroing
+    c.append(b.data(), alignment);
+    c.reset();
+    c.append(b.data(), 10);
+    c.zero_pad();
+    // the data survives and the padding up to the block boundary is zero
+    BOOST_REQUIRE(std::memcmp(c.data(), b.data(), 10) == 0);
+    for (size_t i = 10; i < alignment; ++i) {
+        BOOST_REQUIRE_EQUAL(c.data()[i], 0);
+    }
+    // padding is not part of the append position
+    BOOST_REQUIRE_EQUAL(c.size(), 10);
+    BOOST_REQUIRE_EQUAL(c.dma_size(), alignment);
+}
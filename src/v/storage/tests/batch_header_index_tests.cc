@@ -0,0 +1,122 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/bytes.h"
+#include "storage/batch_header_index.h"
+#include "test_utils/fixture.h"
+
+#include <boost/test/unit_test_suite.hpp>
+
+struct batch_header_index_fixture {
+    static storage::batch_header_index make_index(model::offset base) {
+        storage::batch_header_index idx;
+        idx.base_offset = base;
+        return idx;
+    }
+
+    static model::record_batch_header make_header(
+      model::offset base, int32_t records, model::timestamp first_ts) {
+        model::record_batch_header hdr;
+        hdr.header_crc = 42;
+        hdr.size_bytes = 1024;
+        hdr.base_offset = base;
+        hdr.type = model::record_batch_type(1);
+        hdr.crc = 7;
+        hdr.attrs = model::record_batch_attributes(0);
+        hdr.last_offset_delta = records - 1;
+        hdr.first_timestamp = first_ts;
+        hdr.max_timestamp = model::timestamp(first_ts() + records - 1);
+        hdr.producer_id = -1;
+        hdr.producer_epoch = -1;
+        hdr.base_sequence = 0;
+        hdr.record_count = records;
+        return hdr;
+    }
+};
+
+FIXTURE_TEST(header_index_round_trip, batch_header_index_fixture) {
+    auto idx = make_index(model::offset(100));
+    idx.add_entry(
+      make_header(model::offset(100), 10, model::timestamp(1000)), 0);
+    idx.add_entry(
+      make_header(model::offset(110), 5, model::timestamp(2000)), 1024);
+
+    auto buf = idx.checksum_and_serialize();
+    auto hydrated = storage::batch_header_index::hydrate_from_buffer(
+      std::move(buf));
+    BOOST_REQUIRE(bool(hydrated));
+    BOOST_REQUIRE_EQUAL(hydrated->entries(), 2);
+    auto e = hydrated->get_entry(1);
+    BOOST_REQUIRE_EQUAL(e.header.base_offset, model::offset(110));
+    BOOST_REQUIRE_EQUAL(e.header.last_offset(), model::offset(114));
+    BOOST_REQUIRE_EQUAL(e.header.record_count, 5);
+    BOOST_REQUIRE_EQUAL(e.header.first_timestamp, model::timestamp(2000));
+    BOOST_REQUIRE_EQUAL(e.filepos, 1024);
+    BOOST_REQUIRE(
+      e.header == make_header(model::offset(110), 5, model::timestamp(2000)));
+}
+
+FIXTURE_TEST(header_index_rejects_corruption, batch_header_index_fixture) {
+    auto idx = make_index(model::offset(0));
+    idx.add_entry(make_header(model::offset(0), 1, model::timestamp(1)), 0);
+    auto buf = idx.checksum_and_serialize();
+    // flip the last byte so the checksum no longer matches
+    auto bytes = iobuf_to_bytes(buf);
+    bytes[bytes.size() - 1] ^= 0xff;
+    auto mangled = bytes_to_iobuf(bytes);
+    BOOST_REQUIRE(!storage::batch_header_index::hydrate_from_buffer(
+      std::move(mangled)));
+}
+
+FIXTURE_TEST(header_index_find_first_timestamp, batch_header_index_fixture) {
+    auto idx = make_index(model::offset(0));
+    idx.add_entry(make_header(model::offset(0), 10, model::timestamp(100)), 0);
+    idx.add_entry(
+      make_header(model::offset(10), 10, model::timestamp(200)), 1024);
+    idx.add_entry(
+      make_header(model::offset(20), 10, model::timestamp(300)), 2048);
+
+    auto e = idx.find_first_timestamp(
+      model::timestamp(150), model::offset(0), model::offset(1000));
+    BOOST_REQUIRE(bool(e));
+    BOOST_REQUIRE_EQUAL(e->header.base_offset, model::offset(10));
+
+    // min offset excludes the match the timestamp alone would produce
+    e = idx.find_first_timestamp(
+      model::timestamp(150), model::offset(15), model::offset(1000));
+    BOOST_REQUIRE(bool(e));
+    BOOST_REQUIRE_EQUAL(e->header.base_offset, model::offset(20));
+
+    // max offset cuts the scan before any match
+    e = idx.find_first_timestamp(
+      model::timestamp(250), model::offset(0), model::offset(15));
+    BOOST_REQUIRE(!e);
+
+    e = idx.find_first_timestamp(
+      model::timestamp(400), model::offset(0), model::offset(1000));
+    BOOST_REQUIRE(!e);
+}
+
+FIXTURE_TEST(header_index_truncate, batch_header_index_fixture) {
+    auto idx = make_index(model::offset(0));
+    idx.add_entry(make_header(model::offset(0), 10, model::timestamp(100)), 0);
+    idx.add_entry(
+      make_header(model::offset(10), 10, model::timestamp(200)), 1024);
+    idx.add_entry(
+      make_header(model::offset(20), 10, model::timestamp(300)), 2048);
+
+    // keeps batches that start at or below the truncation offset
+    BOOST_REQUIRE(idx.truncate(model::offset(10)));
+    BOOST_REQUIRE_EQUAL(idx.entries(), 2);
+    BOOST_REQUIRE(!idx.truncate(model::offset(10)));
+
+    auto rows = idx.collect(model::offset(0), model::offset(1000));
+    BOOST_REQUIRE_EQUAL(rows.size(), 2);
+    BOOST_REQUIRE_EQUAL(rows[1].header.base_offset, model::offset(10));
+}
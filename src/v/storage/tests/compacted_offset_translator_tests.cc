@@ -0,0 +1,84 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/compacted_offset_translator.h"
+#include "test_utils/fixture.h"
+
+#include <boost/test/unit_test_suite.hpp>
+
+using translator = storage::internal::compacted_offset_translator;
+
+struct offset_translator_fixture {
+    static translator
+    make(model::offset base, std::initializer_list<uint32_t> kept) {
+        Roaring r;
+        for (auto o : kept) {
+            r.add(o);
+        }
+        return translator(base, r);
+    }
+};
+
+FIXTURE_TEST(translator_runs_coalesce, offset_translator_fixture) {
+    // kept: [0..2], [5..6], [9]
+    auto t = make(model::offset(100), {0, 1, 2, 5, 6, 9});
+    BOOST_REQUIRE_EQUAL(t.size(), 6);
+    BOOST_REQUIRE_EQUAL(t.runs(), 3);
+}
+
+FIXTURE_TEST(translator_to_dense, offset_translator_fixture) {
+    auto t = make(model::offset(100), {0, 1, 2, 5, 6, 9});
+    BOOST_REQUIRE_EQUAL(*t.to_dense(model::offset(100)), model::offset(0));
+    BOOST_REQUIRE_EQUAL(*t.to_dense(model::offset(102)), model::offset(2));
+    BOOST_REQUIRE_EQUAL(*t.to_dense(model::offset(105)), model::offset(3));
+    BOOST_REQUIRE_EQUAL(*t.to_dense(model::offset(109)), model::offset(5));
+    // compacted away
+    BOOST_REQUIRE(!t.to_dense(model::offset(103)));
+    BOOST_REQUIRE(!t.to_dense(model::offset(108)));
+    // outside the encoded range
+    BOOST_REQUIRE(!t.to_dense(model::offset(99)));
+    BOOST_REQUIRE(!t.to_dense(model::offset(110)));
+}
+
+FIXTURE_TEST(translator_from_dense_round_trip, offset_translator_fixture) {
+    auto t = make(model::offset(100), {0, 1, 2, 5, 6, 9});
+    for (int64_t d = 0; d < int64_t(t.size()); ++d) {
+        auto gapped = t.from_dense(model::offset(d));
+        BOOST_REQUIRE(bool(gapped));
+        BOOST_REQUIRE_EQUAL(*t.to_dense(*gapped), model::offset(d));
+    }
+    BOOST_REQUIRE(!t.from_dense(model::offset(6)));
+}
+
+FIXTURE_TEST(translator_range_translation, offset_translator_fixture) {
+    auto t = make(model::offset(100), {0, 1, 2, 5, 6, 9});
+    // both bounds in gaps clamp inward
+    auto r = t.to_dense_range(model::offset(103), model::offset(108));
+    BOOST_REQUIRE(bool(r));
+    BOOST_REQUIRE_EQUAL(r->first, model::offset(3));
+    BOOST_REQUIRE_EQUAL(r->second, model::offset(4));
+    // bounds on kept offsets map exactly
+    r = t.to_dense_range(model::offset(100), model::offset(109));
+    BOOST_REQUIRE(bool(r));
+    BOOST_REQUIRE_EQUAL(r->first, model::offset(0));
+    BOOST_REQUIRE_EQUAL(r->second, model::offset(5));
+    // range entirely inside a gap
+    BOOST_REQUIRE(!t.to_dense_range(model::offset(103), model::offset(104)));
+    // range before / after the encoded offsets
+    BOOST_REQUIRE(!t.to_dense_range(model::offset(0), model::offset(99)));
+    BOOST_REQUIRE(!t.to_dense_range(model::offset(110), model::offset(200)));
+}
+
+FIXTURE_TEST(translator_empty, offset_translator_fixture) {
+    auto t = make(model::offset(0), {});
+    BOOST_REQUIRE_EQUAL(t.size(), 0);
+    BOOST_REQUIRE(!t.to_dense(model::offset(0)));
+    BOOST_REQUIRE(!t.from_dense(model::offset(0)));
+    BOOST_REQUIRE(!t.to_dense_range(model::offset(0), model::offset(10)));
+}
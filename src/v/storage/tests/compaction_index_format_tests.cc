@@ -262,6 +262,72 @@ FIXTURE_TEST(key_reducer_max_mem, compacted_topic_fixture) {
     BOOST_REQUIRE(exact_mem_bitmap.contains(98));
     BOOST_REQUIRE(exact_mem_bitmap.contains(99));
 }
+FIXTURE_TEST(two_tier_key_reducer, compacted_topic_fixture) {
+    tmpbuf_file::store_t index_data;
+    auto idx = storage::make_file_backed_compacted_index(
+      "dummy name",
+      ss::file(ss::make_shared(tmpbuf_file(index_data))),
+      ss::default_priority_class(),
+      1_KiB);
+
+    // 100 entries over two duplicated keys, plus 10 unique keys that
+    // should never reach the exact key map
+    const auto key1 = random_generators::get_bytes(128);
+    const auto key2 = random_generators::get_bytes(128);
+    for (auto i = 0; i < 100; ++i) {
+        bytes_view put_key;
+        if (i % 2) {
+            put_key = key1;
+        } else {
+            put_key = key2;
+        }
+        idx.index(put_key, model::offset(i), 0).get();
+    }
+    for (auto i = 100; i < 110; ++i) {
+        auto unique_key = random_generators::get_bytes(128);
+        idx.index(bytes_view(unique_key), model::offset(i), 0).get();
+    }
+    idx.close().get();
+    info("{}", idx);
+
+    auto rdr = storage::make_file_backed_compacted_reader(
+      "dummy name",
+      ss::file(ss::make_shared(tmpbuf_file(index_data))),
+      ss::default_priority_class(),
+      32_KiB);
+
+    auto footer = rdr.load_footer().get0();
+    rdr.reset();
+    auto duplicates = rdr
+                        .consume(
+                          storage::internal::key_duplicate_filter_reducer(
+                            footer.keys),
+                          model::no_timeout)
+                        .get0();
+    BOOST_REQUIRE(duplicates.maybe_contains(bytes_view(key1)));
+    BOOST_REQUIRE(duplicates.maybe_contains(bytes_view(key2)));
+
+    rdr.reset();
+    auto key_bitmap
+      = rdr
+          .consume(
+            storage::internal::compaction_key_reducer(
+              storage::internal::compaction_key_reducer::
+                default_max_memory_usage,
+              std::move(duplicates)),
+            model::no_timeout)
+          .get0();
+
+    info("two tier key bitmap: {}", key_bitmap.toString());
+    // last occurrence of both duplicated keys plus every unique key
+    BOOST_REQUIRE_EQUAL(key_bitmap.cardinality(), 12);
+    BOOST_REQUIRE(key_bitmap.contains(98));
+    BOOST_REQUIRE(key_bitmap.contains(99));
+    for (uint32_t i = 100; i < 110; ++i) {
+        BOOST_REQUIRE(key_bitmap.contains(i));
+    }
+}
+
 FIXTURE_TEST(index_filtered_copy_tests, compacted_topic_fixture) {
     tmpbuf_file::store_t index_data;
 
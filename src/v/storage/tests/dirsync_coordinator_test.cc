@@ -0,0 +1,82 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "seastarx.h"
+#include "storage/dirsync_coordinator.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/shared_future.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+SEASTAR_THREAD_TEST_CASE(dirsync_coordinator_coalesces_same_directory) {
+    int syncs_a = 0;
+    int syncs_b = 0;
+    ss::shared_promise<> barrier;
+    storage::internal::dirsync_coordinator c(
+      [&](const ss::sstring& dir) -> ss::future<> {
+          if (dir == "a") {
+              if (++syncs_a == 1) {
+                  // first request occupies the device until we release it
+                  return barrier.get_shared_future();
+              }
+          } else {
+              ++syncs_b;
+          }
+          return ss::now();
+      });
+
+    auto f1 = c.sync("a");
+    // requests arriving while the round is in flight queue into the next
+    // one, all for directory "a" collapse into a single fsync
+    auto f2 = c.sync("a");
+    auto f3 = c.sync("a");
+    auto f4 = c.sync("b");
+
+    BOOST_REQUIRE_EQUAL(syncs_a, 1);
+    BOOST_REQUIRE_EQUAL(syncs_b, 0);
+    barrier.set_value();
+    f1.get();
+    f2.get();
+    f3.get();
+    f4.get();
+    // one sync for the first round, one shared by f2/f3, one for "b"
+    BOOST_REQUIRE_EQUAL(syncs_a, 2);
+    BOOST_REQUIRE_EQUAL(syncs_b, 1);
+    c.stop().get();
+}
+
+SEASTAR_THREAD_TEST_CASE(dirsync_coordinator_propagates_round_failure) {
+    int ok = 0;
+    ss::shared_promise<> barrier;
+    storage::internal::dirsync_coordinator c(
+      [&](const ss::sstring& dir) -> ss::future<> {
+          if (dir == "slow") {
+              return barrier.get_shared_future();
+          }
+          if (dir == "bad") {
+              return ss::make_exception_future<>(
+                std::runtime_error("sync failed"));
+          }
+          ++ok;
+          return ss::now();
+      });
+
+    auto f1 = c.sync("slow");
+    // both members of the failing round observe the error
+    auto f2 = c.sync("bad");
+    auto f3 = c.sync("good");
+
+    barrier.set_value();
+    f1.get();
+    BOOST_REQUIRE_THROW(f2.get(), std::runtime_error);
+    BOOST_REQUIRE_THROW(f3.get(), std::runtime_error);
+    // the non failing sync still ran
+    BOOST_REQUIRE_EQUAL(ok, 1);
+    c.stop().get();
+}
@@ -38,6 +38,21 @@ FIXTURE_TEST(kitchen_sink, log_builder_fixture) {
     BOOST_TEST(stats.record_count >= 105);
 }
 
+FIXTURE_TEST(flush_dirty_indices_skips_clean, log_builder_fixture) {
+    using namespace storage; // NOLINT
+
+    b | start() | add_segment(0) | add_random_batch(0, 10) | add_segment(10)
+      | add_random_batch(10, 10);
+
+    auto flushed = b.get_log().flush_dirty_indices().get0();
+    BOOST_REQUIRE_EQUAL(flushed, 2);
+    // nothing changed since the last round, no index is rewritten
+    flushed = b.get_log().flush_dirty_indices().get0();
+    BOOST_REQUIRE_EQUAL(flushed, 0);
+
+    b | stop();
+}
+
 static void do_write_zeroes(ss::sstring name) {
     auto fd = ss::open_file_dma(
                 name, ss::open_flags::create | ss::open_flags::rw)
@@ -0,0 +1,84 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "seastarx.h"
+#include "storage/flush_coordinator.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/shared_future.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+SEASTAR_THREAD_TEST_CASE(flush_coordinator_coalesces_same_key) {
+    storage::flush_coordinator c;
+    int log_a = 0;
+    int log_b = 0;
+    int syncs_a = 0;
+    int syncs_b = 0;
+
+    // first request dispatches immediately and occupies the device, its
+    // sync resolves only when we release the barrier
+    ss::shared_promise<> barrier;
+    auto f1 = c.flush(&log_a, [&syncs_a, &barrier] {
+        ++syncs_a;
+        return barrier.get_shared_future();
+    });
+
+    // requests arriving while the round is in flight queue into the next
+    // one, both for log_a collapse into a single sync
+    auto f2 = c.flush(&log_a, [&syncs_a] {
+        ++syncs_a;
+        return ss::now();
+    });
+    auto f3 = c.flush(&log_a, [&syncs_a] {
+        ++syncs_a;
+        return ss::now();
+    });
+    auto f4 = c.flush(&log_b, [&syncs_b] {
+        ++syncs_b;
+        return ss::now();
+    });
+
+    BOOST_REQUIRE_EQUAL(syncs_a, 1);
+    BOOST_REQUIRE_EQUAL(syncs_b, 0);
+    barrier.set_value();
+    f1.get();
+    f2.get();
+    f3.get();
+    f4.get();
+    // one sync for the first round, one shared by f2/f3, one for log_b
+    BOOST_REQUIRE_EQUAL(syncs_a, 2);
+    BOOST_REQUIRE_EQUAL(syncs_b, 1);
+    c.stop().get();
+}
+
+SEASTAR_THREAD_TEST_CASE(flush_coordinator_propagates_round_failure) {
+    storage::flush_coordinator c;
+    int ok = 0;
+
+    ss::shared_promise<> barrier;
+    auto f1 = c.flush(&barrier, [&barrier] {
+        return barrier.get_shared_future();
+    });
+    // both members of the failing round observe the error
+    auto f2 = c.flush(&ok, [] {
+        return ss::make_exception_future<>(std::runtime_error("sync failed"));
+    });
+    auto f3 = c.flush(&c, [&ok] {
+        ++ok;
+        return ss::now();
+    });
+
+    barrier.set_value();
+    f1.get();
+    BOOST_REQUIRE_THROW(f2.get(), std::runtime_error);
+    BOOST_REQUIRE_THROW(f3.get(), std::runtime_error);
+    // the non failing flush still ran
+    BOOST_REQUIRE_EQUAL(ok, 1);
+    c.stop().get();
+}
@@ -13,6 +13,8 @@
 
 #include <seastar/testing/thread_test_case.hh>
 
+#include <filesystem>
+
 template<typename T>
 static void set_configuration(ss::sstring p_name, T v) {
     ss::smp::invoke_on_all([p_name, v = std::move(v)] {
@@ -86,6 +88,63 @@ SEASTAR_THREAD_TEST_CASE(key_space) {
     kvs->stop().get();
 }
 
+SEASTAR_THREAD_TEST_CASE(key_space_snapshots) {
+    set_configuration("disable_metrics", true);
+
+    auto dir = fmt::format("kvstore_test_{}", random_generators::get_int(4000));
+
+    auto conf = get_conf(dir);
+
+    auto kvs = std::make_unique<storage::kvstore>(conf);
+    kvs->start().get();
+
+    // a cold key in the consensus space that never changes again
+    const auto cold_key = random_generators::get_bytes(2);
+    const auto cold_value = bytes_to_iobuf(random_generators::get_bytes(100));
+    kvs->put(storage::kvstore::key_space::consensus, cold_key, cold_value.copy())
+      .get();
+
+    // churn the testing space until segments roll and the log collapses
+    // into per-space snapshots
+    std::unordered_map<bytes, iobuf> truth;
+    for (int i = 0; i < 1000; i++) {
+        auto key = random_generators::get_bytes(2);
+        auto value = bytes_to_iobuf(random_generators::get_bytes(512));
+        truth[key] = value.copy();
+        kvs->put(storage::kvstore::key_space::testing, key, std::move(value))
+          .get();
+    }
+    kvs->stop().get();
+
+    // snapshots are partitioned by key space and no legacy whole-store
+    // snapshot file is left behind
+    bool found_spaced = false;
+    bool found_legacy = false;
+    for (const auto& ent :
+         std::filesystem::recursive_directory_iterator(dir.c_str())) {
+        if (ent.path().filename() == "snapshot.0") {
+            found_spaced = true;
+        } else if (ent.path().filename() == "snapshot") {
+            found_legacy = true;
+        }
+    }
+    BOOST_REQUIRE(found_spaced);
+    BOOST_REQUIRE(!found_legacy);
+
+    // recovery restores the hot and the cold space alike
+    kvs = std::make_unique<storage::kvstore>(conf);
+    kvs->start().get();
+    BOOST_REQUIRE(
+      kvs->get(storage::kvstore::key_space::consensus, cold_key).value()
+      == cold_value);
+    for (auto& e : truth) {
+        BOOST_REQUIRE(
+          kvs->get(storage::kvstore::key_space::testing, e.first).value()
+          == e.second);
+    }
+    kvs->stop().get();
+}
+
 SEASTAR_THREAD_TEST_CASE(kvstore_empty) {
     set_configuration("disable_metrics", true);
 
@@ -0,0 +1,156 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/bytes.h"
+#include "bytes/iobuf.h"
+#include "model/record.h"
+#include "random/generators.h"
+#include "storage/batch_cache.h"
+#include "storage/parser.h"
+#include "storage/segment_appender.h"
+#include "storage/segment_appender_utils.h"
+#include "storage/tests/utils/random_batch.h"
+
+#include <seastar/core/file.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/testing/perf_tests.hh>
+
+#include <boost/range/irange.hpp>
+
+/*
+ * append + flush cycle of the segment appender. every sample opens a fresh
+ * file and measures appending 64 x 4KiB payloads followed by one flush -
+ * the shape of a produce round trip hitting the log.
+ */
+struct appender_bench {
+    appender_bench()
+      : payload(bytes_to_iobuf(random_generators::get_bytes(4096))) {}
+    iobuf payload;
+};
+
+PERF_TEST_F(appender_bench, append_flush) {
+    return ss::open_file_dma(
+             "storage_bench_appender.log",
+             ss::open_flags::create | ss::open_flags::rw
+               | ss::open_flags::truncate)
+      .then([this](ss::file f) {
+          return ss::do_with(
+            storage::segment_appender(
+              std::move(f),
+              storage::segment_appender::options(
+                ss::default_priority_class(),
+                storage::segment_appender::chunks_no_buffer)),
+            boost::irange(0, 64),
+            [this](
+              storage::segment_appender& appender,
+              boost::integer_range<int>& range) {
+                perf_tests::start_measuring_time();
+                return ss::do_for_each(
+                         range,
+                         [this, &appender](int) {
+                             return appender.append(payload);
+                         })
+                  .then([&appender] { return appender.flush(); })
+                  .then([] { perf_tests::stop_measuring_time(); })
+                  .then([&appender] { return appender.close(); });
+            });
+      });
+}
+
+class replay_consumer final : public storage::batch_consumer {
+public:
+    consume_result consume_batch_start(
+      model::record_batch_header, size_t, size_t) final {
+        return skip_batch::no;
+    }
+    void consume_records(iobuf&& records) final {
+        perf_tests::do_not_optimize(records);
+    }
+    stop_parser consume_batch_end() final { return stop_parser::no; }
+    void print(std::ostream& os) const final { os << "{replay_consumer}"; }
+};
+
+/*
+ * batch parser decode rate over an in-memory stream in the on-disk format,
+ * i.e. log replay without the disk. the stream holds 32 uncompressed random
+ * batches and is re-parsed on every sample.
+ */
+struct parser_bench {
+    parser_bench() {
+        auto batches = storage::test::make_random_batches(
+          model::offset(0), 32, false);
+        for (auto& b : batches) {
+            _data.append(storage::disk_header_to_iobuf(b.header()));
+            _data.append(b.data().copy());
+        }
+    }
+    iobuf _data;
+};
+
+PERF_TEST_F(parser_bench, replay) {
+    return ss::do_with(
+      storage::continuous_batch_parser(
+        std::make_unique<replay_consumer>(),
+        make_iobuf_input_stream(_data.copy())),
+      [](storage::continuous_batch_parser& parser) {
+          perf_tests::start_measuring_time();
+          return parser.consume()
+            .then([](result<size_t> r) { perf_tests::do_not_optimize(r); })
+            .finally([] { perf_tests::stop_measuring_time(); })
+            .then([&parser] { return parser.close(); });
+      });
+}
+
+static storage::batch_cache::reclaim_options reclaim_opts = {
+  .growth_window = std::chrono::milliseconds(3000),
+  .stable_window = std::chrono::milliseconds(10000),
+  .min_size = 128 << 10,
+  .max_size = 4 << 20,
+};
+
+struct batch_cache_bench {
+    batch_cache_bench()
+      : index(cache) {}
+    storage::batch_cache cache{reclaim_opts};
+    storage::batch_cache_index index;
+    model::offset next{0};
+};
+
+/*
+ * cost of inserting a batch and immediately reading it back. reclaim runs
+ * outside of the measured region only to keep the cache bounded across
+ * samples; eviction cost is measured separately below.
+ */
+PERF_TEST_F(batch_cache_bench, hit) {
+    auto b = storage::test::make_random_batch(next, 10, false);
+    auto offset = b.base_offset();
+    next = b.last_offset() + model::offset(1);
+    perf_tests::start_measuring_time();
+    index.put(b);
+    auto hit = index.get(offset);
+    perf_tests::do_not_optimize(hit);
+    perf_tests::stop_measuring_time();
+    cache.reclaim(1);
+}
+
+/*
+ * insertion under memory pressure: every put is followed by a reclaim that
+ * evicts the inserted batch, the pattern of a reader streaming through a
+ * cache that is already at its limit.
+ */
+PERF_TEST_F(batch_cache_bench, eviction) {
+    auto b = storage::test::make_random_batch(next, 10, false);
+    next = b.last_offset() + model::offset(1);
+    perf_tests::start_measuring_time();
+    index.put(b);
+    auto reclaimed = cache.reclaim(1);
+    perf_tests::do_not_optimize(reclaimed);
+    perf_tests::stop_measuring_time();
+}
@@ -22,6 +22,7 @@
 #include "storage/tests/utils/random_batch.h"
 #include "storage/types.h"
 
+#include <seastar/core/seastar.hh>
 #include <seastar/core/sleep.hh>
 #include <seastar/util/defer.hh>
 #include <seastar/util/log.hh>
@@ -1066,3 +1067,45 @@ FIXTURE_TEST(check_segment_size_jitter, storage_test_fixture) {
         [size = sizes[0]](auto other) { return size == other; }),
       false);
 }
+
+FIXTURE_TEST(stray_roll_ahead_files_are_ignored, storage_test_fixture) {
+    auto cfg = default_log_config(test_dir);
+    cfg.max_segment_size = 10_KiB;
+    cfg.stype = storage::log_config::storage_type::disk;
+    auto ntp = model::ntp("default", "test", 0);
+    size_t segments = 0;
+    model::offset dirty_offset;
+    {
+        storage::log_manager mgr = make_log_manager(cfg);
+        auto deferred = ss::defer([&mgr]() mutable { mgr.stop().get0(); });
+        auto log
+          = mgr.manage(storage::ntp_config(ntp, mgr.config().base_dir)).get0();
+        // enough data to cross the roll-ahead threshold and roll a few
+        // times so later segments are adopted from staged files
+        append_exactly(log, 1000, 100).get0();
+        log.flush().get0();
+        segments = log.segment_count();
+        dirty_offset = log.offsets().dirty_offset;
+        BOOST_REQUIRE_GT(segments, 1);
+    }
+    // simulate a crash that left staged roll-ahead files behind: recovery
+    // must not treat them as segments
+    auto dir = storage::ntp_config(ntp, cfg.base_dir).work_directory();
+    for (auto name :
+         {"roll_ahead.log.staging", "roll_ahead.base_index.staging"}) {
+        auto f = ss::open_file_dma(
+                   fmt::format("{}/{}", dir, name),
+                   ss::open_flags::create | ss::open_flags::rw)
+                   .get0();
+        f.close().get0();
+    }
+    {
+        storage::log_manager mgr = make_log_manager(cfg);
+        auto deferred = ss::defer([&mgr]() mutable { mgr.stop().get0(); });
+        auto log
+          = mgr.manage(storage::ntp_config(ntp, mgr.config().base_dir)).get0();
+        BOOST_REQUIRE_EQUAL(log.segment_count(), segments);
+        auto batches = read_and_validate_all_batches(log);
+        BOOST_REQUIRE_EQUAL(batches.back().last_offset(), dirty_offset);
+    }
+};
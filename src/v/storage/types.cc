@@ -49,15 +49,29 @@ std::ostream& operator<<(std::ostream& o, const timequery_config& a) {
     return o << "{max_offset:" << a.max_offset << ", time:" << a.time << "}";
 }
 
+std::ostream& operator<<(std::ostream& o, durability_mode m) {
+    switch (m) {
+    case durability_mode::fsync_on_append:
+        return o << "fsync_on_append";
+    case durability_mode::raft_quorum:
+        return o << "raft_quorum";
+    }
+    return o << "unknown";
+}
+
 std::ostream&
 operator<<(std::ostream& o, const ntp_config::default_overrides& v) {
     fmt::print(
       o,
       "{{compaction_strategy: {}, cleanup_policy_bitflags: {}, segment_size: "
-      "{}, retention_bytes: {}, retention_time_ms: {}}}",
+      "{}, io_shares: {}, durability: {}, ephemeral: {}, retention_bytes: {}, "
+      "retention_time_ms: {}}}",
       v.compaction_strategy,
       v.cleanup_policy_bitflags,
       v.segment_size,
+      v.io_shares,
+      v.durability,
+      v.ephemeral,
       v.retention_bytes,
       v.retention_time);
 
@@ -99,6 +113,20 @@ std::ostream& operator<<(std::ostream& o, const offset_stats& s) {
     return o;
 }
 
+std::ostream& operator<<(std::ostream& o, const log_io_rates& r) {
+    fmt::print(
+      o,
+      "{{ntp:{}, write_bytes_sec:{}, read_bytes_sec:{}, "
+      "cached_read_bytes_sec:{}, flushes_sec:{}, cache_hit_ratio:{}}}",
+      r.ntp,
+      r.write_bytes_sec,
+      r.read_bytes_sec,
+      r.cached_read_bytes_sec,
+      r.flushes_sec,
+      r.cache_hit_ratio);
+    return o;
+}
+
 std::ostream& operator<<(std::ostream& o, const compaction_config& c) {
     fmt::print(
       o,
@@ -177,6 +177,19 @@ struct log_reader_config {
     // historical read-once workloads like compaction).
     bool skip_batch_cache{false};
 
+    // the requested range lies far behind the high watermark. cold readers
+    // stream with large read-once buffers and never insert into the batch
+    // cache, so a backfill replaying history does not evict the tail data
+    // live consumers are about to fetch. set automatically by
+    // disk_log_impl::make_reader based on how far behind the range ends.
+    bool cold_read{false};
+
+    // read the first slice of the following segment eagerly when the reader
+    // finishes a segment, hiding the open/seek round trip of the next
+    // segment behind the consumer. used for scans over compacted logs that
+    // cross many small cleaned segments.
+    bool cross_segment_prefetch{false};
+
     log_reader_config(
       model::offset start_offset,
       model::offset max_offset,
@@ -242,4 +255,24 @@ struct compaction_config {
 
     friend std::ostream& operator<<(std::ostream&, const compaction_config&);
 };
+
+/**
+ * Rolling-window io rates of a single log, sampled by storage::probe.
+ *
+ * Rates are units/second averaged over the probe's sliding window (see
+ * storage/probe.h), so they answer "what is this partition doing right
+ * now" rather than "what has it done since startup". The cache hit ratio
+ * is the windowed fraction of read bytes served from the batch cache; it
+ * is 1.0 for a log that has not been read inside the window.
+ */
+struct log_io_rates {
+    model::ntp ntp;
+    double write_bytes_sec{0};
+    double read_bytes_sec{0};
+    double cached_read_bytes_sec{0};
+    double flushes_sec{0};
+    double cache_hit_ratio{1.0};
+
+    friend std::ostream& operator<<(std::ostream&, const log_io_rates&);
+};
 } // namespace storage
@@ -24,6 +24,12 @@ namespace storage {
 
 enum class record_version_type { v1 };
 
+/// newest on-disk segment format. the background format upgrader (see
+/// log_manager) rewrites sealed segments written in older formats to this
+/// one so the read path only ever has to decode the latest layout
+inline constexpr record_version_type latest_segment_version
+  = record_version_type::v1;
+
 inline record_version_type from_string(std::string_view version) {
     if (version == "v1") {
         return record_version_type::v1;
@@ -0,0 +1,90 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "syschecks/doctor.h"
+
+#include "units.h"
+
+#include <seastar/core/smp.hh>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+namespace syschecks {
+
+// below this disk read rate batch cache misses are noise, not a
+// bottleneck: a cold partition read once costs nothing to serve from disk
+static constexpr double min_interesting_read_rate = 1_MiB;
+
+doctor_report diagnose(const doctor_sample& s) {
+    doctor_report r{.shard = ss::this_shard_id(), .findings = {}};
+
+    r.findings.push_back(doctor_finding{
+      .resource = "reactor",
+      .severity = std::clamp(s.reactor_utilization, 0.0, 1.0),
+      .detail = fmt::format(
+        "reactor busy {:.0f}% of the sampling interval",
+        100 * s.reactor_utilization),
+    });
+
+    // anyone actually waiting for an appender chunk is full saturation,
+    // same reasoning as the shard load score
+    r.findings.push_back(doctor_finding{
+      .resource = "append_pipeline",
+      .severity = s.append_chunk_waiters != 0
+                    ? 1.0
+                    : std::clamp(s.append_chunk_utilization, 0.0, 1.0),
+      .detail = fmt::format(
+        "{:.0f}% of appender chunks in use, {} writers waiting",
+        100 * s.append_chunk_utilization,
+        s.append_chunk_waiters),
+    });
+
+    const double reads = s.cached_read_bytes_sec + s.disk_read_bytes_sec;
+    double miss_ratio = 0;
+    if (reads > 0) {
+        miss_ratio = s.disk_read_bytes_sec / reads;
+    }
+    r.findings.push_back(doctor_finding{
+      .resource = "batch_cache",
+      .severity = s.disk_read_bytes_sec >= min_interesting_read_rate
+                    ? miss_ratio
+                    : 0.0,
+      .detail = fmt::format(
+        "{:.0f}% of read bytes missed the batch cache "
+        "({:.0f} KiB/s served from disk)",
+        100 * miss_ratio,
+        s.disk_read_bytes_sec / 1024),
+    });
+
+    double used_frac = 0;
+    if (s.memory_total > 0) {
+        used_frac = 1.0
+                    - double(s.memory_free) / double(s.memory_total);
+    }
+    r.findings.push_back(doctor_finding{
+      .resource = "memory",
+      .severity = std::clamp(used_frac, 0.0, 1.0),
+      .detail = fmt::format(
+        "{:.0f}% of shard memory allocated, {} reclaimer runs since start",
+        100 * used_frac,
+        s.memory_reclaims),
+    });
+
+    std::sort(
+      r.findings.begin(),
+      r.findings.end(),
+      [](const doctor_finding& a, const doctor_finding& b) {
+          return a.severity > b.severity;
+      });
+    return r;
+}
+
+} // namespace syschecks
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+
+#include <seastar/core/sstring.hh>
+
+#include <cstdint>
+#include <vector>
+
+namespace syschecks {
+
+/**
+ * Runtime bottleneck diagnosis ("doctor").
+ *
+ * The startup checks validate configuration once; the doctor looks at a
+ * live shard and answers "what would this shard queue on right now". The
+ * caller samples the raw numbers from the probes that already exist
+ * (reactor busy time, appender chunk cache, per-log io rates, memory
+ * allocator stats) and diagnose() turns them into findings ranked by
+ * severity - the first array element of the report is the bottleneck.
+ *
+ * The logic is deliberately free of dependencies on the modules it
+ * diagnoses; syschecks sits below storage and kafka in the dependency
+ * order, so the wiring lives with the admin API.
+ */
+
+/// raw per-shard numbers, gathered by the caller from existing probes
+struct doctor_sample {
+    /// fraction of the sampling interval the reactor spent busy, 0-1
+    double reactor_utilization{0};
+    /// fraction of appender chunks in use; writers queue when it runs dry
+    double append_chunk_utilization{0};
+    /// writers currently waiting for an appender chunk
+    uint64_t append_chunk_waiters{0};
+    /// current read rates summed over the shard's logs
+    double cached_read_bytes_sec{0};
+    double disk_read_bytes_sec{0};
+    /// allocator stats for this shard
+    uint64_t memory_free{0};
+    uint64_t memory_total{0};
+    uint64_t memory_reclaims{0};
+};
+
+/// one resource dimension with its diagnosis
+struct doctor_finding {
+    ss::sstring resource;
+    /// 0 healthy .. 1 saturated
+    double severity{0};
+    ss::sstring detail;
+};
+
+struct doctor_report {
+    unsigned shard;
+    /// most severe first
+    std::vector<doctor_finding> findings;
+};
+
+/// rank the sampled resources by how close each is to saturation
+doctor_report diagnose(const doctor_sample&);
+
+} // namespace syschecks
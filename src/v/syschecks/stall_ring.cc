@@ -0,0 +1,74 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "syschecks/stall_ring.h"
+
+#include "syschecks/syschecks.h"
+#include "vlog.h"
+
+#include <seastar/core/reactor.hh>
+#include <seastar/util/backtrace.hh>
+
+#include <fmt/format.h>
+
+namespace syschecks {
+
+void stall_ring::install(std::chrono::milliseconds threshold) {
+    ss::engine().update_blocked_reactor_notify_ms(threshold);
+    ss::engine().set_stall_detector_report_function([this] { capture(); });
+    vlog(
+      checklog.info,
+      "reactor stall detector armed with {}ms threshold",
+      threshold.count());
+}
+
+ss::future<> stall_ring::stop() {
+    ss::engine().set_stall_detector_report_function({});
+    return ss::make_ready_future<>();
+}
+
+void stall_ring::capture() noexcept {
+    auto& slot = _ring[_head % capacity];
+    slot.num_frames = 0;
+    ss::backtrace([&slot](ss::frame f) {
+        if (slot.num_frames < max_frames) {
+            slot.frames[slot.num_frames++] = f.addr;
+        }
+    });
+    // lowres_clock::now() reads a cached counter, safe in this context
+    slot.captured_at = ss::lowres_clock::now();
+    slot.seq = ++_total;
+    ++_head;
+}
+
+stall_ring::report stall_ring::render() const {
+    report r{
+      .shard = ss::this_shard_id(),
+      .total = _total,
+    };
+    auto retained = std::min<uint64_t>(_head, capacity);
+    auto now = ss::lowres_clock::now();
+    r.samples.reserve(retained);
+    for (uint64_t i = _head - retained; i < _head; ++i) {
+        const auto& s = _ring[i % capacity];
+        fmt::memory_buffer bt;
+        for (size_t f = 0; f < s.num_frames; ++f) {
+            fmt::format_to(bt, "{}0x{:x}", f == 0 ? "" : " ", s.frames[f]);
+        }
+        r.samples.push_back(rendered_sample{
+          .seq = s.seq,
+          .age = std::chrono::duration_cast<std::chrono::milliseconds>(
+            now - s.captured_at),
+          .backtrace = ss::sstring(bt.data(), bt.size()),
+        });
+    }
+    return r;
+}
+
+} // namespace syschecks
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/sstring.hh>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace syschecks {
+
+/**
+ * Per-shard ring buffer of backtraces captured by seastar's cpu stall
+ * detector.
+ *
+ * install() lowers the reactor's stall reporting threshold and registers a
+ * capture hook with the stall detector. The hook runs in signal handler
+ * context, so capture() only writes raw frame addresses into a preallocated
+ * slot: no allocation, no locks, no symbolization. The ring is rendered to
+ * strings lazily when queried through the admin API; decode the addresses
+ * offline with seastar-addr2line, exactly like reactor stall log lines.
+ *
+ * The cost of an armed hook is a timer re-arm per poll period, and capture
+ * itself only runs when a stall already blew the threshold, so the detector
+ * is cheap enough to leave enabled in production.
+ */
+class stall_ring {
+public:
+    static constexpr size_t capacity = 64;
+    static constexpr size_t max_frames = 64;
+
+    struct sample {
+        // number of stalls observed on this shard when captured
+        uint64_t seq{0};
+        ss::lowres_clock::time_point captured_at;
+        std::array<uintptr_t, max_frames> frames;
+        size_t num_frames{0};
+    };
+
+    struct rendered_sample {
+        uint64_t seq;
+        // time since the stall was captured
+        std::chrono::milliseconds age;
+        // space separated hex frame addresses
+        ss::sstring backtrace;
+    };
+
+    struct report {
+        unsigned shard;
+        uint64_t total;
+        std::vector<rendered_sample> samples;
+    };
+
+    // set the reactor's stall reporting threshold and register the capture
+    // hook with the stall detector. must run on the shard being monitored.
+    void install(std::chrono::milliseconds threshold);
+
+    // required by ss::sharded; unregisters the capture hook
+    ss::future<> stop();
+
+    // capture hook body. signal handler context: async-signal safe.
+    void capture() noexcept;
+
+    // total number of stalls observed on this shard
+    uint64_t total() const { return _total; }
+
+    // snapshot of the retained samples, oldest first
+    report render() const;
+
+private:
+    std::array<sample, capacity> _ring;
+    uint64_t _head{0};
+    uint64_t _total{0};
+};
+
+} // namespace syschecks
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "vassert.h"
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+/**
+ * A monotonic bump allocator for scratch memory with a single well known
+ * release point - e.g. everything decoded and computed while serving one
+ * kafka request. Allocation is a pointer bump into the current chunk;
+ * nothing is ever freed individually and all chunks are released together
+ * when the arena is destroyed (or reset).
+ *
+ * The arena is a std::pmr::memory_resource, so standard containers can
+ * draw from it for short lived temporaries:
+ *
+ *   std::pmr::vector<T> tmp{&some_arena};
+ *
+ * deallocate() is a no-op, which is what makes the fast path free: a
+ * container growing inside the arena abandons its old buffer instead of
+ * returning it. That is the intended trade - scratch peaks at a small
+ * multiple of live data and is recycled wholesale.
+ *
+ * Allocations larger than the chunk size get a dedicated chunk and do not
+ * disturb the current bump position. The arena is neither movable nor
+ * copyable: containers and views hold pointers to it, so it should be
+ * placed behind a stable address (member of a non-moving object, or a
+ * unique_ptr).
+ */
+class arena final : public std::pmr::memory_resource {
+public:
+    static constexpr size_t default_chunk_size = 16 * 1024;
+
+    explicit arena(size_t chunk_size = default_chunk_size)
+      : _chunk_size(chunk_size) {
+        vassert(chunk_size > 0, "arena chunk size must not be zero");
+    }
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+    arena(arena&&) = delete;
+    arena& operator=(arena&&) = delete;
+    ~arena() override = default;
+
+    void* allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+        return do_allocate(bytes, align);
+    }
+
+    /// copy a string into the arena; the returned view lives as long as
+    /// the arena does
+    std::string_view copy(std::string_view v) {
+        if (v.empty()) {
+            return {};
+        }
+        auto* dst = static_cast<char*>(allocate(v.size(), alignof(char)));
+        std::memcpy(dst, v.data(), v.size());
+        return {dst, v.size()};
+    }
+
+    /// total bytes handed out; grows monotonically until reset
+    size_t memory_used() const { return _used; }
+
+    /// release every chunk. invalidates all outstanding allocations
+    void reset() {
+        _chunks.clear();
+        _pos = nullptr;
+        _end = nullptr;
+        _used = 0;
+    }
+
+private:
+    void* do_allocate(size_t bytes, size_t align) override {
+        _used += bytes;
+        // oversized requests get their own chunk and leave the current
+        // bump position alone so small allocations keep filling it
+        if (bytes + align > _chunk_size) {
+            auto& c = _chunks.emplace_back(
+              std::make_unique<char[]>(bytes + align));
+            return align_up(c.get(), align);
+        }
+        auto* p = align_up(_pos, align);
+        if (p == nullptr || p > _end || bytes > size_t(_end - p)) {
+            auto& c = _chunks.emplace_back(
+              std::make_unique<char[]>(_chunk_size));
+            _pos = c.get();
+            _end = c.get() + _chunk_size;
+            p = align_up(_pos, align);
+        }
+        _pos = p + bytes;
+        return p;
+    }
+
+    // individual frees are dropped on the floor by design; memory comes
+    // back when the arena is destroyed or reset
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    static char* align_up(char* p, size_t align) {
+        auto v = reinterpret_cast<uintptr_t>(p);
+        return reinterpret_cast<char*>((v + align - 1) & ~(align - 1));
+    }
+
+    std::vector<std::unique_ptr<char[]>> _chunks;
+    char* _pos{nullptr};
+    char* _end{nullptr};
+    size_t _chunk_size;
+    size_t _used{0};
+};
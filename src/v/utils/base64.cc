@@ -13,6 +13,7 @@
 #include "vassert.h"
 
 #include <seastar/core/sstring.hh>
+#include <seastar/core/temporary_buffer.hh>
 
 #include <libbase64.h>
 
@@ -61,6 +62,25 @@ ss::sstring bytes_to_base64(bytes_view input) {
     return output;
 }
 
+iobuf base64_to_iobuf(std::string_view input) {
+    ss::temporary_buffer<char> output(input.size());
+    size_t output_len; // NOLINT
+    int ret = base64_decode(
+      input.data(), input.size(), output.get_write(), &output_len, 0);
+    if (unlikely(!ret)) {
+        throw base64_decoder_exception();
+    }
+    vassert(
+      output_len <= input.size(),
+      "base64 decode overflow: {} > {}",
+      output_len,
+      input.size());
+    output.trim(output_len);
+    iobuf result;
+    result.append(std::move(output));
+    return result;
+}
+
 ss::sstring iobuf_to_base64(const iobuf& input) {
     const size_t output_capacity = encode_capacity(input.size_bytes());
     ss::sstring output(ss::sstring::initialized_later{}, output_capacity);
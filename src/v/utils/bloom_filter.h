@@ -0,0 +1,88 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "bytes/bytes.h"
+#include "hashing/xx.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/// Space efficient approximate set membership over byte keys.
+///
+/// Sized from the expected number of entries and a target false positive
+/// rate. `maybe_contains` never returns false for a key that was added;
+/// a true return is wrong with roughly the configured probability. Bit
+/// positions are derived from two xxhash64 digests via double hashing, so
+/// only two hash passes are paid per operation regardless of the number
+/// of probes.
+class bloom_filter {
+public:
+    explicit bloom_filter(
+      size_t expected_entries, double false_positive_rate = 0.01)
+      : _num_bits(bits_for(expected_entries, false_positive_rate))
+      , _num_probes(probes_for(expected_entries, _num_bits))
+      , _bits((_num_bits + 63) / 64, 0) {}
+
+    void add(bytes_view key) {
+        probe(key, [this](size_t bit) {
+            _bits[bit / 64] |= uint64_t(1) << (bit % 64);
+        });
+    }
+
+    bool maybe_contains(bytes_view key) const {
+        bool hit = true;
+        probe(key, [this, &hit](size_t bit) {
+            hit &= (_bits[bit / 64] & (uint64_t(1) << (bit % 64))) != 0;
+        });
+        return hit;
+    }
+
+    size_t memory_usage() const { return _bits.size() * sizeof(uint64_t); }
+
+private:
+    static size_t bits_for(size_t entries, double fp_rate) {
+        constexpr double ln2_squared = 0.4804530139182014;
+        auto bits = std::ceil(
+          -(double(std::max<size_t>(entries, 1)) * std::log(fp_rate))
+          / ln2_squared);
+        return std::max<size_t>(static_cast<size_t>(bits), 64);
+    }
+
+    static unsigned probes_for(size_t entries, size_t bits) {
+        constexpr double ln2 = 0.6931471805599453;
+        auto k = std::round(
+          double(bits) / double(std::max<size_t>(entries, 1)) * ln2);
+        return std::clamp<unsigned>(static_cast<unsigned>(k), 1, 16);
+    }
+
+    template<typename Func>
+    void probe(bytes_view key, Func f) const {
+        // NOLINTNEXTLINE
+        const auto* data = reinterpret_cast<const char*>(key.data());
+        auto h1 = incremental_xxhash64(0);
+        h1.update(data, key.size());
+        auto h2 = incremental_xxhash64(1);
+        h2.update(data, key.size());
+        const uint64_t d1 = h1.digest();
+        const uint64_t d2 = h2.digest();
+        for (unsigned i = 0; i < _num_probes; ++i) {
+            f((d1 + i * d2) % _num_bits);
+        }
+    }
+
+    size_t _num_bits;
+    unsigned _num_probes;
+    std::vector<uint64_t> _bits;
+};
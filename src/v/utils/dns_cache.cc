@@ -0,0 +1,109 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "utils/dns_cache.h"
+
+#include <fmt/format.h>
+
+#include <stdexcept>
+
+dns_cache::dns_cache()
+  : dns_cache([](const ss::sstring& host) {
+      return ss::net::inet_address::find(host);
+  }) {}
+
+dns_cache::dns_cache(
+  resolver_fn resolver,
+  ss::lowres_clock::duration positive_ttl,
+  ss::lowres_clock::duration negative_ttl)
+  : _resolver(std::move(resolver))
+  , _positive_ttl(positive_ttl)
+  , _negative_ttl(negative_ttl) {}
+
+ss::future<ss::net::inet_address>
+dns_cache::resolve(const ss::sstring& host) {
+    auto now = ss::lowres_clock::now();
+    if (auto it = _cache.find(host); it != _cache.end()) {
+        auto& e = it->second;
+        if (!e.addr) {
+            if (now < e.expiry) {
+                return ss::make_exception_future<ss::net::inet_address>(
+                  std::runtime_error(fmt::format(
+                    "dns resolution of {} failed recently "
+                    "(negative cache entry)",
+                    host)));
+            }
+            // expired negative entry: retry inline like a miss
+            _cache.erase(it);
+            return miss(host);
+        }
+        if (now >= e.expiry && !e.refreshing) {
+            // keep serving the stale address while a refresh runs in the
+            // background; during a flap a stale peer address beats
+            // blocking every reconnect on the resolver
+            e.refreshing = true;
+            refresh(host);
+        }
+        return ss::make_ready_future<ss::net::inet_address>(*e.addr);
+    }
+    return miss(host);
+}
+
+ss::future<ss::socket_address>
+dns_cache::resolve(const unresolved_address& addr) {
+    return resolve(addr.host()).then(
+      [port = addr.port()](ss::net::inet_address ia) {
+          return ss::socket_address(ia, port);
+      });
+}
+
+ss::future<ss::net::inet_address> dns_cache::miss(ss::sstring host) {
+    return _resolver(host).then_wrapped(
+      [this,
+       host = std::move(host)](ss::future<ss::net::inet_address> f) {
+          auto now = ss::lowres_clock::now();
+          if (f.failed()) {
+              _cache[host] = entry{
+                .addr = std::nullopt, .expiry = now + _negative_ttl};
+              return f;
+          }
+          auto addr = f.get0();
+          _cache[host] = entry{
+            .addr = addr, .expiry = now + _positive_ttl};
+          return ss::make_ready_future<ss::net::inet_address>(addr);
+      });
+}
+
+void dns_cache::refresh(ss::sstring host) {
+    (void)_resolver(host).then_wrapped(
+      [this,
+       host = std::move(host)](ss::future<ss::net::inet_address> f) {
+          auto it = _cache.find(host);
+          if (f.failed()) {
+              // keep the stale entry; the next lookup past the ttl kicks
+              // another refresh
+              f.ignore_ready_future();
+              if (it != _cache.end()) {
+                  it->second.refreshing = false;
+              }
+              return;
+          }
+          auto addr = f.get0();
+          if (it != _cache.end()) {
+              it->second = entry{
+                .addr = addr,
+                .expiry = ss::lowres_clock::now() + _positive_ttl};
+          }
+      });
+}
+
+dns_cache& shard_dns_cache() {
+    static thread_local dns_cache cache;
+    return cache;
+}
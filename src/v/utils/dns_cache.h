@@ -0,0 +1,77 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+#include "utils/unresolved_address.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/net/inet_address.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <chrono>
+#include <optional>
+
+/// Per-shard cache of hostname resolutions.
+///
+/// Broker peer addresses are re-resolved whenever clients are rebuilt, so
+/// connectivity flaps turn into resolution storms right when the resolver
+/// may itself be slow or unreachable. The cache serves fresh entries
+/// instantly, keeps serving an expired entry while a background refresh
+/// runs (a stale peer address beats no address during a flap), and caches
+/// resolution failures briefly so a dead resolver is not hammered once per
+/// reconnect attempt.
+class dns_cache {
+public:
+    using resolver_fn = ss::noncopyable_function<ss::future<
+      ss::net::inet_address>(const ss::sstring&)>;
+
+    static constexpr auto default_positive_ttl = std::chrono::seconds(30);
+    static constexpr auto default_negative_ttl = std::chrono::seconds(2);
+
+    /// resolves through ss::net::inet_address::find
+    dns_cache();
+
+    /// resolver injection for tests
+    explicit dns_cache(
+      resolver_fn resolver,
+      ss::lowres_clock::duration positive_ttl = default_positive_ttl,
+      ss::lowres_clock::duration negative_ttl = default_negative_ttl);
+
+    ss::future<ss::net::inet_address> resolve(const ss::sstring& host);
+    ss::future<ss::socket_address> resolve(const unresolved_address&);
+
+    void invalidate(const ss::sstring& host) { _cache.erase(host); }
+    size_t size() const { return _cache.size(); }
+
+private:
+    struct entry {
+        // disengaged for a cached resolution failure
+        std::optional<ss::net::inet_address> addr;
+        ss::lowres_clock::time_point expiry;
+        bool refreshing{false};
+    };
+
+    ss::future<ss::net::inet_address> miss(ss::sstring host);
+    void refresh(ss::sstring host);
+
+    resolver_fn _resolver;
+    ss::lowres_clock::duration _positive_ttl;
+    ss::lowres_clock::duration _negative_ttl;
+    absl::flat_hash_map<ss::sstring, entry> _cache;
+};
+
+/// The calling shard's resolver cache instance.
+dns_cache& shard_dns_cache();
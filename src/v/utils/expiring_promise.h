@@ -11,12 +11,12 @@
 
 #pragma once
 #include "seastarx.h"
+#include "utils/timeout_wheel.h"
 
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/lowres_clock.hh>
 #include <seastar/core/shared_future.hh>
-#include <seastar/core/timer.hh>
 
 #include <system_error>
 
@@ -33,7 +33,7 @@ public:
             // handle abort source
             if (as) {
                 auto opt_sub = as.value().get().subscribe([this]() noexcept {
-                    if (_timer.cancel()) {
+                    if (_timeout.cancel()) {
                         _promise.set_exception(ss::abort_requested_exception{});
                     }
                 });
@@ -44,7 +44,11 @@ public:
                     return _promise.get_shared_future();
                 }
             }
-            _timer.set_callback(
+            // register with the shard's timeout wheel instead of arming a
+            // dedicated timer; outstanding requests share one backing timer
+            shard_timeout_wheel<Clock>().arm(
+              _timeout,
+              timeout,
               [this, ef = std::forward<ErrorFactory>(err_factory)] {
                   using err_t = std::invoke_result_t<ErrorFactory>;
 
@@ -60,7 +64,6 @@ public:
                   }
                   unlink_abort_source();
               });
-            _timer.arm(timeout);
         }
 
         auto f = _promise.get_shared_future();
@@ -68,7 +71,7 @@ public:
     };
 
     void set_value(T val) {
-        if (_timer.cancel()) {
+        if (_timeout.cancel()) {
             unlink_abort_source();
         }
 
@@ -78,7 +81,7 @@ public:
     }
 
     void set_exception(std::exception_ptr&& ex) {
-        if (_timer.cancel()) {
+        if (_timeout.cancel()) {
             _promise.set_exception(ex);
             unlink_abort_source();
         }
@@ -89,7 +92,7 @@ public:
     }
 
     void set_exception(const std::exception_ptr& ex) {
-        if (_timer.cancel()) {
+        if (_timeout.cancel()) {
             unlink_abort_source();
         }
 
@@ -106,6 +109,6 @@ private:
     }
 
     ss::shared_promise<T> _promise;
-    ss::timer<Clock> _timer;
+    typename timeout_wheel<Clock>::entry _timeout;
     ss::abort_source::subscription _sub;
 };
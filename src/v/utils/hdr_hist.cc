@@ -16,10 +16,20 @@
 
 #include <iostream>
 
+void hdr_hist::flush_staged() const {
+    for (auto value : _staged) {
+        ::hdr_record_value(_hist.get(), value);
+    }
+    _staged.clear();
+}
+
 void hdr_hist::record(uint64_t value) {
     _sample_count++;
     _sample_sum += value;
-    ::hdr_record_value(_hist.get(), value);
+    _staged.push_back(value);
+    if (unlikely(_staged.size() >= staged_capacity)) {
+        flush_staged();
+    }
 }
 void hdr_hist::record_multiple_times(uint64_t value, uint32_t times) {
     _sample_count += times;
@@ -35,11 +45,14 @@ void hdr_hist::record_corrected(uint64_t value, uint64_t interval) {
 }
 
 hdr_hist& hdr_hist::operator+=(const hdr_hist& o) {
+    flush_staged();
+    o.flush_staged();
     ::hdr_add(_hist.get(), o._hist.get());
     return *this;
 }
 
 ss::temporary_buffer<char> hdr_hist::print_classic() const {
+    flush_staged();
     char* buf = nullptr;
     std::size_t len = 0;
     FILE* fp = open_memstream(&buf, &len);
@@ -63,14 +76,22 @@ ss::temporary_buffer<char> hdr_hist::print_classic() const {
 }
 // getters
 int64_t hdr_hist::get_value_at(double percentile) const {
+    flush_staged();
     return ::hdr_value_at_percentile(_hist.get(), percentile);
 }
-double hdr_hist::stddev() const { return ::hdr_stddev(_hist.get()); }
-double hdr_hist::mean() const { return ::hdr_mean(_hist.get()); }
+double hdr_hist::stddev() const {
+    flush_staged();
+    return ::hdr_stddev(_hist.get());
+}
+double hdr_hist::mean() const {
+    flush_staged();
+    return ::hdr_mean(_hist.get());
+}
 size_t hdr_hist::memory_size() const {
     return ::hdr_get_memory_size(_hist.get());
 }
 ss::metrics::histogram hdr_hist::seastar_histogram_logform() const {
+    flush_staged();
     // logarithmic histogram configuration. this will range from 10 microseconds
     // through around 6000 seconds with 26 buckets doubling.
     //
@@ -29,6 +29,7 @@
 #include <chrono>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace hist_internal {
 using hdr_histogram_ptr = std::
@@ -43,6 +44,12 @@ inline hdr_histogram_ptr make_unique_hdr_histogram(
 } // namespace hist_internal
 
 // VERY Expensive object. At default granularity is about 185KB
+//
+// Recording is two-level: samples are appended to a small staging buffer on
+// the hot path (a single store) and merged into the hdr structure lazily when
+// the histogram is read, or when the buffer fills. Raw sample values are
+// staged rather than pre-bucketed so the configured hdr precision is
+// preserved.
 class hdr_hist {
 public:
     using clock_type = std::chrono::high_resolution_clock;
@@ -109,12 +116,15 @@ public:
       int64_t min = 1,
       int32_t significant_figures = 3)
       : _hist(hist_internal::make_unique_hdr_histogram(
-        max_value, min, significant_figures)) {}
+        max_value, min, significant_figures)) {
+        _staged.reserve(staged_capacity);
+    }
     hdr_hist(hdr_hist&& o) noexcept
       : _probes(std::move(o._probes))
       , _hist(std::move(o._hist))
       , _sample_count(o._sample_count)
-      , _sample_sum(o._sample_sum) {}
+      , _sample_sum(o._sample_sum)
+      , _staged(std::move(o._staged)) {}
     hdr_hist& operator=(hdr_hist&& o) noexcept {
         if (this != &o) {
             this->~hdr_hist();
@@ -144,10 +154,20 @@ private:
     friend measurement;
     friend std::ostream& operator<<(std::ostream& o, const hdr_hist& h);
 
+    // number of samples staged before a merge is forced. sized to keep the
+    // buffer within a couple of cache lines worth of pages while making a
+    // forced merge rare between metrics scrapes.
+    static constexpr size_t staged_capacity = 1024;
+
+    /// Merge staged samples into the hdr structure.
+    void flush_staged() const;
+
     boost::intrusive::list<measurement> _probes;
     hist_internal::hdr_histogram_ptr _hist;
     uint64_t _sample_count{0};
     uint64_t _sample_sum{0};
+    // staged samples are merged on reads, so mutable for const getters
+    mutable std::vector<uint64_t> _staged;
 
     friend std::ostream& operator<<(std::ostream& o, const hdr_hist& h);
 };
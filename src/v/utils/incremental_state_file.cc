@@ -0,0 +1,183 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "utils/incremental_state_file.h"
+
+#include "hashing/crc32c.h"
+
+#include <seastar/core/align.hh>
+#include <seastar/core/aligned_buffer.hh>
+#include <seastar/core/do_with.hh>
+#include <seastar/core/seastar.hh>
+
+#include <cstring>
+#include <filesystem>
+
+namespace utils {
+
+static uint32_t chained_crc(uint32_t chain, const iobuf& payload) {
+    crc32 crc;
+    crc.extend(chain);
+    crc.extend(uint32_t(payload.size_bytes()));
+    for (const auto& frag : payload) {
+        crc.extend(frag.get(), frag.size());
+    }
+    return crc.value();
+}
+
+incremental_state_file::incremental_state_file(ss::sstring name)
+  : _filename(std::move(name)) {}
+
+uint32_t incremental_state_file::record_crc(const iobuf& payload) const {
+    return chained_crc(_chain, payload);
+}
+
+ss::future<result<std::vector<iobuf>>> incremental_state_file::open() {
+    return ss::open_file_dma(
+             _filename, ss::open_flags::rw | ss::open_flags::create)
+      .then([this](ss::file f) {
+          _file = std::move(f);
+          _alignment = _file.disk_write_dma_alignment();
+          return _file.size();
+      })
+      .then([this](uint64_t size) { return _file.dma_read_bulk<char>(0, size); })
+      .then([this](ss::temporary_buffer<char> b) {
+          const char* p = b.get();
+          const size_t n = b.size();
+          size_t pos = 0;
+          uint32_t chain = 0;
+          std::vector<iobuf> records;
+          while (n - pos >= record_header_size) {
+              uint32_t crc; // NOLINT
+              uint32_t size; // NOLINT
+              std::memcpy(&crc, p + pos, sizeof(crc));
+              std::memcpy(&size, p + pos + sizeof(crc), sizeof(size));
+              if (n - pos - record_header_size < size) {
+                  // torn tail: the payload never made it to disk
+                  break;
+              }
+              iobuf payload;
+              payload.append(p + pos + record_header_size, size);
+              if (chained_crc(chain, payload) != crc) {
+                  // the chain seed makes this trip on reordered or replaced
+                  // records as well as plain corruption
+                  break;
+              }
+              chain = crc;
+              pos += record_header_size + size;
+              records.push_back(std::move(payload));
+          }
+          _size = pos;
+          _chain = chain;
+          const auto aligned = ss::align_down(pos, _alignment);
+          _tail.assign(p + aligned, p + pos);
+          return result<std::vector<iobuf>>(std::move(records));
+      });
+}
+
+ss::future<> incremental_state_file::append(iobuf record) {
+    const auto crc = record_crc(record);
+    iobuf rec;
+    reflection::serialize(rec, crc, uint32_t(record.size_bytes()));
+    rec.append(std::move(record));
+    _chain = crc;
+    return write_tail_block(std::move(rec));
+}
+
+ss::future<> incremental_state_file::write_tail_block(iobuf record) {
+    const auto aligned_start = ss::align_down(_size, _alignment);
+    const auto tail_len = _tail.size();
+    const auto total = tail_len + record.size_bytes();
+    const auto buf_len = ss::align_up(total, _alignment);
+
+    auto buf = ss::allocate_aligned_buffer<char>(buf_len, _alignment);
+    std::memset(buf.get(), 0, buf_len);
+    std::copy(_tail.begin(), _tail.end(), buf.get());
+    size_t off = tail_len;
+    for (const auto& frag : record) {
+        std::memcpy(buf.get() + off, frag.get(), frag.size());
+        off += frag.size();
+    }
+
+    auto src = buf.get();
+    return _file.dma_write(aligned_start, src, buf_len)
+      .then([this, buf = std::move(buf), aligned_start, total](size_t) {
+          _size = aligned_start + total;
+          const auto new_tail_len = _size - ss::align_down(_size, _alignment);
+          _tail.assign(
+            buf.get() + total - new_tail_len, buf.get() + total);
+          // the write itself bypasses the page cache; the flush persists
+          // file metadata (size) so recovery sees the record
+          return _file.flush();
+      });
+}
+
+ss::future<> incremental_state_file::compact(iobuf full_state) {
+    const auto crc = chained_crc(0, full_state);
+    const uint32_t payload_size = full_state.size_bytes();
+    iobuf rec;
+    reflection::serialize(rec, crc, payload_size);
+    rec.append(std::move(full_state));
+    const size_t rec_size = rec.size_bytes();
+
+    auto staging = _filename + ".staging";
+    const auto flags = ss::open_flags::wo | ss::open_flags::create
+                       | ss::open_flags::truncate;
+    return ss::open_file_dma(staging, flags)
+      .then([this, rec = std::move(rec)](ss::file staged) mutable {
+          const auto buf_len = ss::align_up(rec.size_bytes(), _alignment);
+          auto buf = ss::allocate_aligned_buffer<char>(buf_len, _alignment);
+          std::memset(buf.get(), 0, buf_len);
+          size_t off = 0;
+          for (const auto& frag : rec) {
+              std::memcpy(buf.get() + off, frag.get(), frag.size());
+              off += frag.size();
+          }
+          auto src = buf.get();
+          return staged.dma_write(0, src, buf_len)
+            .then([staged, buf = std::move(buf)](size_t) mutable {
+                return staged.flush();
+            })
+            .then([staged]() mutable { return staged.close(); })
+            .finally([staged] {});
+      })
+      .then([this] { return _file.close(); })
+      .then([this, staging = std::move(staging)] {
+          return ss::rename_file(staging, _filename);
+      })
+      .then([this] {
+          auto dir = std::filesystem::path(_filename).parent_path().string();
+          return ss::sync_directory(dir.empty() ? "." : dir);
+      })
+      .then([this] {
+          return ss::open_file_dma(
+            _filename, ss::open_flags::rw | ss::open_flags::create);
+      })
+      .then([this, crc, rec_size](ss::file f) {
+          _file = std::move(f);
+          _chain = crc;
+          _size = rec_size;
+          // appends after a compaction rewrite the record's trailing block
+          return _file.dma_read_bulk<char>(
+            ss::align_down(rec_size, _alignment),
+            rec_size - ss::align_down(rec_size, _alignment));
+      })
+      .then([this](ss::temporary_buffer<char> b) {
+          _tail.assign(b.get(), b.get() + b.size());
+      });
+}
+
+ss::future<> incremental_state_file::close() {
+    if (!_file) {
+        return ss::make_ready_future<>();
+    }
+    return _file.close();
+}
+
+} // namespace utils
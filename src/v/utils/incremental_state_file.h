@@ -0,0 +1,94 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "bytes/iobuf.h"
+#include "outcome.h"
+#include "reflection/adl.h"
+#include "seastarx.h"
+#include "utils/state_crc_file_errc.h"
+
+#include <seastar/core/file.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/sstring.hh>
+
+#include <vector>
+
+namespace utils {
+
+/**
+ * Append-oriented sibling of state_crc_file for state that changes often
+ * in small increments. Where state_crc_file rewrites the whole file with a
+ * full-content crc on every update, this file appends one record per
+ * update, so the bytes written are proportional to the delta:
+ *
+ *   |crc|size|payload|crc|size|payload|...
+ *
+ * Each record's crc32 is chained from the previous record's, so a reorder
+ * or a replaced record breaks every checksum after it. Recovery scans from
+ * the front and stops at the first record that does not verify - a torn
+ * tail left by a crash is discarded, not an error. The caller replays the
+ * recovered records in order to rebuild its state and should call
+ * compact() once the file grows past its taste, which atomically replaces
+ * the record chain with a single full-state record.
+ */
+class incremental_state_file {
+public:
+    explicit incremental_state_file(ss::sstring);
+
+    /// opens (creating if needed) and scans existing records in order.
+    /// subsequent appends go after the last valid record; torn tail bytes
+    /// are overwritten by the next append
+    ss::future<result<std::vector<iobuf>>> open();
+
+    /// appends one delta record; bytes written are one tail-block
+    /// read-modify-write, independent of total state size
+    ss::future<> append(iobuf record);
+
+    template<typename T>
+    ss::future<> append(const T& record) {
+        return append(reflection::to_iobuf(record));
+    }
+
+    /// atomically replaces the record chain with a single record holding
+    /// the full state (staging file + rename), resetting the file size
+    ss::future<> compact(iobuf full_state);
+
+    template<typename T>
+    ss::future<> compact(const T& full_state) {
+        return compact(reflection::to_iobuf(full_state));
+    }
+
+    /// bytes occupied by valid records; drives the caller's compaction
+    /// policy
+    size_t size_bytes() const { return _size; }
+
+    ss::future<> close();
+
+private:
+    static constexpr size_t record_header_size = 2 * sizeof(uint32_t);
+
+    uint32_t record_crc(const iobuf& payload) const;
+    ss::future<> write_tail_block(iobuf record);
+
+    ss::sstring _filename;
+    ss::file _file;
+    size_t _alignment{4096};
+    /// end of the last valid record
+    size_t _size{0};
+    /// crc of the last valid record, seed for the next one
+    uint32_t _chain{0};
+    /// content of the trailing partial dma block, rewritten on append
+    std::vector<char> _tail;
+};
+
+} // namespace utils
@@ -0,0 +1,201 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "utils/intrusive_list_helpers.h"
+
+#include <boost/intrusive/unordered_set.hpp>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+/// Hash map with an embedded LRU list for cache-style containers.
+///
+/// Caches that pair a hash map with recency-ordered eviction usually keep
+/// two structures: a map of owning pointers and a separate list (or a full
+/// scan) to find cold entries. This container folds both into one node:
+/// the key, the value, the hash-table hook and the LRU hook share a single
+/// allocation, so a lookup touches one cache line chain and an insert or
+/// erase performs one allocation or free.
+///
+/// `get` refreshes recency, `find` does not; eviction walks entries from
+/// the cold end via `evict_while`, stopping at the first entry the
+/// predicate keeps, so a periodic sweep costs O(evicted) rather than
+/// O(size). Lookups are heterogeneous: any key type the hasher and the
+/// (transparent) equality accept can be used without materializing a Key.
+///
+/// References returned by `find`/`get`/`insert` stay valid until the entry
+/// is erased; rehashing relinks nodes without moving them.
+template<
+  typename Key,
+  typename Value,
+  typename Hash = std::hash<Key>,
+  typename Eq = std::equal_to<>>
+class lru_hash_map {
+public:
+    struct entry {
+        entry(Key k, Value v)
+          : key(std::move(k))
+          , value(std::move(v)) {}
+
+        Key key;
+        Value value;
+
+    private:
+        friend class lru_hash_map;
+        boost::intrusive::unordered_set_member_hook<> _map_hook;
+        safe_intrusive_list_hook _lru_hook;
+    };
+
+private:
+    struct entry_key {
+        using type = Key;
+        const type& operator()(const entry& e) const { return e.key; }
+    };
+
+    using map_type = boost::intrusive::unordered_set<
+      entry,
+      boost::intrusive::member_hook<
+        entry,
+        boost::intrusive::unordered_set_member_hook<>,
+        &entry::_map_hook>,
+      boost::intrusive::key_of_value<entry_key>,
+      boost::intrusive::hash<Hash>,
+      boost::intrusive::equal<Eq>,
+      boost::intrusive::power_2_buckets<true>,
+      boost::intrusive::constant_time_size<true>>;
+
+    using bucket_type = typename map_type::bucket_type;
+    using bucket_traits = typename map_type::bucket_traits;
+
+    using lru_type = uncounted_intrusive_list<entry, &entry::_lru_hook>;
+
+    static constexpr size_t initial_buckets = 16;
+
+public:
+    lru_hash_map()
+      : _buckets(initial_buckets)
+      , _map(bucket_traits(_buckets.data(), _buckets.size())) {}
+
+    lru_hash_map(lru_hash_map&&) noexcept = default;
+    lru_hash_map& operator=(lru_hash_map&&) noexcept = default;
+    lru_hash_map(const lru_hash_map&) = delete;
+    lru_hash_map& operator=(const lru_hash_map&) = delete;
+
+    ~lru_hash_map() { clear(); }
+
+    size_t size() const { return _map.size(); }
+    bool empty() const { return _map.empty(); }
+
+    template<typename K>
+    bool contains(const K& key) const {
+        return _map.find(key, Hash{}, Eq{}) != _map.end();
+    }
+
+    /// Lookup without refreshing recency.
+    template<typename K>
+    Value* find(const K& key) {
+        auto it = _map.find(key, Hash{}, Eq{});
+        return it == _map.end() ? nullptr : &it->value;
+    }
+
+    /// Lookup that moves the entry to the hot end of the LRU list.
+    template<typename K>
+    Value* get(const K& key) {
+        auto it = _map.find(key, Hash{}, Eq{});
+        if (it == _map.end()) {
+            return nullptr;
+        }
+        touch(*it);
+        return &it->value;
+    }
+
+    /// Insert-or-assign. A new entry starts hot; assigning over an
+    /// existing key refreshes its recency.
+    Value& insert(Key key, Value value) {
+        if (auto it = _map.find(key, Hash{}, Eq{}); it != _map.end()) {
+            it->value = std::move(value);
+            touch(*it);
+            return it->value;
+        }
+        maybe_grow();
+        auto e = std::make_unique<entry>(std::move(key), std::move(value));
+        _map.insert(*e);
+        _lru.push_back(*e);
+        return e.release()->value;
+    }
+
+    template<typename K>
+    bool erase(const K& key) {
+        auto it = _map.find(key, Hash{}, Eq{});
+        if (it == _map.end()) {
+            return false;
+        }
+        auto& e = *it;
+        _map.erase(it);
+        _lru.erase(_lru.iterator_to(e));
+        delete &e;
+        return true;
+    }
+
+    /// Erase entries from the cold end while `pred(entry)` approves,
+    /// stopping at the first entry it keeps. Returns the number evicted.
+    template<typename Pred>
+    size_t evict_while(Pred&& pred) {
+        size_t evicted = 0;
+        while (!_lru.empty() && pred(_lru.front())) {
+            auto& e = _lru.front();
+            _map.erase(_map.iterator_to(e));
+            _lru.pop_front();
+            delete &e;
+            ++evicted;
+        }
+        return evicted;
+    }
+
+    void clear() {
+        _map.clear();
+        _lru.clear_and_dispose([](entry* e) { delete e; });
+    }
+
+    /// Bytes owned by the container itself: the bucket array plus the
+    /// fixed part of every node. Variable-size state held by values is
+    /// the caller's to account for.
+    size_t memory_allocated() const {
+        return _buckets.capacity() * sizeof(bucket_type)
+               + _map.size() * sizeof(entry);
+    }
+
+    /// Iteration in recency order, coldest entry first.
+    typename lru_type::const_iterator begin() const { return _lru.begin(); }
+    typename lru_type::const_iterator end() const { return _lru.end(); }
+
+private:
+    void touch(entry& e) {
+        _lru.erase(_lru.iterator_to(e));
+        _lru.push_back(e);
+    }
+
+    void maybe_grow() {
+        if (_map.size() < _buckets.size()) {
+            return;
+        }
+        std::vector<bucket_type> grown(_buckets.size() * 2);
+        _map.rehash(bucket_traits(grown.data(), grown.size()));
+        _buckets = std::move(grown);
+    }
+
+    std::vector<bucket_type> _buckets;
+    map_type _map;
+    lru_type _lru;
+};
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "random/fast_prng.h"
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+/**
+ * Fixed size uniform sample of an unbounded stream (Vitter's algorithm R).
+ *
+ * Every element of the stream is equally likely to be in the reservoir, so
+ * order statistics of the reservoir estimate the same statistics of the
+ * whole stream with memory bounded by the capacity. Insertion is O(1) -
+ * one prng draw once the reservoir is full - which makes it cheap enough
+ * for hot paths; quantile queries sort a copy of the reservoir and are
+ * meant to be rare relative to insertions (metrics scrapes, admin
+ * queries).
+ */
+template<typename T>
+class reservoir_sample {
+public:
+    explicit reservoir_sample(size_t capacity)
+      : _capacity(capacity) {
+        _samples.reserve(capacity);
+    }
+
+    void add(T value) {
+        ++_count;
+        if (_samples.size() < _capacity) {
+            _samples.push_back(std::move(value));
+            return;
+        }
+        // keep the new element with probability capacity/count by letting
+        // it displace a uniformly chosen slot. the 32 bit draw is uniform
+        // enough for any realistic stream length
+        auto slot = _rng() % _count;
+        if (slot < _capacity) {
+            _samples[slot] = std::move(value);
+        }
+    }
+
+    /// Number of elements observed, not the number retained
+    uint64_t count() const { return _count; }
+
+    bool empty() const { return _samples.empty(); }
+
+    /// Current reservoir contents, in no particular order
+    const std::vector<T>& samples() const { return _samples; }
+
+    /// The q-th quantile (q in [0, 1]) estimated from the reservoir;
+    /// empty optional when nothing was sampled yet
+    std::optional<T> quantile(double q) const {
+        if (_samples.empty()) {
+            return std::nullopt;
+        }
+        auto sorted = _samples;
+        std::sort(sorted.begin(), sorted.end());
+        q = std::clamp(q, 0.0, 1.0);
+        auto rank = static_cast<size_t>(q * double(sorted.size() - 1));
+        return sorted[rank];
+    }
+
+private:
+    size_t _capacity;
+    uint64_t _count{0};
+    std::vector<T> _samples;
+    fast_prng _rng{};
+};
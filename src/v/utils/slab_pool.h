@@ -0,0 +1,118 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "likely.h"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+/**
+ * Per-shard slab pool for fixed-size hot allocations.
+ *
+ * A handful of small objects (batch cache entries, replicate batcher
+ * items) are allocated and freed at very high rate on the append and
+ * fetch paths, each paying the general allocator's bucket lookup and
+ * sharing cache lines with unrelated neighbours. The pool carves
+ * cache-line aligned slots out of slab-sized blocks and keeps freed
+ * slots on a per-shard free list, so steady state allocate/deallocate is
+ * a pointer pop/push and no two pooled objects ever share a line.
+ *
+ * Slabs are retained for the lifetime of the shard: the pooled types
+ * have a bounded steady state population, so memory settles at the
+ * high-water mark instead of cycling through the allocator.
+ *
+ * Intended to back class-level operator new/delete of the pooled type:
+ *
+ *    static void* operator new(size_t size) {
+ *        return slab_pool<entry>::local().allocate(size);
+ *    }
+ *    static void operator delete(void* p, size_t size) {
+ *        slab_pool<entry>::local().deallocate(p, size);
+ *    }
+ *
+ * A request larger than the slot (e.g. a derived type) falls through to
+ * the general allocator.
+ */
+template<typename T>
+class slab_pool {
+public:
+    static constexpr size_t cache_line_size = 64;
+    static constexpr size_t slot_size
+      = ((sizeof(T) + cache_line_size - 1) / cache_line_size)
+        * cache_line_size;
+    static constexpr size_t slab_slots = 128;
+
+    /// pool of the calling shard
+    static slab_pool& local() {
+        static thread_local slab_pool pool;
+        return pool;
+    }
+
+    void* allocate(size_t size) {
+        if (unlikely(size > slot_size)) {
+            return ::operator new(size);
+        }
+        if (_free_list == nullptr) {
+            grow();
+        }
+        auto* slot = _free_list;
+        _free_list = slot->next;
+        --_free_slots;
+        return slot;
+    }
+
+    void deallocate(void* p, size_t size) {
+        if (unlikely(size > slot_size)) {
+            ::operator delete(p);
+            return;
+        }
+        auto* slot = static_cast<free_slot*>(p);
+        slot->next = _free_list;
+        _free_list = slot;
+        ++_free_slots;
+    }
+
+    size_t free_slots() const { return _free_slots; }
+    size_t capacity() const { return _slabs.size() * slab_slots; }
+
+private:
+    struct free_slot {
+        free_slot* next;
+    };
+
+    struct slab_deleter {
+        void operator()(char* p) const {
+            ::operator delete(p, std::align_val_t(cache_line_size));
+        }
+    };
+
+    void grow() {
+        auto* base = static_cast<char*>(::operator new(
+          slab_slots * slot_size, std::align_val_t(cache_line_size)));
+        _slabs.emplace_back(base);
+        // thread the fresh slab onto the free list in address order
+        for (size_t i = slab_slots; i-- > 0;) {
+            auto* slot
+              = reinterpret_cast<free_slot*>(base + (i * slot_size)); // NOLINT
+            slot->next = _free_list;
+            _free_list = slot;
+        }
+        _free_slots += slab_slots;
+    }
+
+    free_slot* _free_list{nullptr};
+    size_t _free_slots{0};
+    std::vector<std::unique_ptr<char, slab_deleter>> _slabs;
+};
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+/// A perfect-hashed, compile-time string lookup table.
+///
+/// Drop-in for hot string_switch call sites over a fixed key set. Where
+/// string_switch compares the query against every candidate in turn, a
+/// static_string_map hashes the query once and confirms a single slot, so
+/// the lookup is one hash, one index jump and one string compare no matter
+/// how many keys there are. The seed that makes the hash collision free for
+/// the given keys is searched at compile time; a constexpr instance lives
+/// entirely in rodata.
+///
+/// \code
+/// static constexpr auto colors = make_static_string_map<Color>(
+///   {{"red", Red}, {"green", Green}, {"blue", Blue}});
+/// Color c = colors.match_or(s, UnknownColor);
+/// \endcode
+///
+/// The mapped type must be default constructible (vacant slots hold a
+/// default constructed value that is never returned).
+template<typename T, size_t N>
+class static_string_map {
+    static_assert(N > 0, "static_string_map requires at least one key");
+
+    static constexpr size_t next_pow2(size_t v) {
+        size_t p = 1;
+        while (p < v) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    /// at most half full so the compile-time seed search converges fast
+    static constexpr size_t table_size = next_pow2(2 * N);
+
+public:
+    constexpr explicit static_string_map(
+      const std::array<std::pair<std::string_view, T>, N>& items)
+      : _seed(find_seed(items)) {
+        for (const auto& [key, value] : items) {
+            const auto slot = index_of(key, _seed);
+            _keys[slot] = key;
+            _values[slot] = value;
+        }
+    }
+
+    constexpr std::optional<T> maybe(std::string_view s) const {
+        const auto slot = index_of(s, _seed);
+        if (hit(slot, s)) {
+            return _values[slot];
+        }
+        return std::nullopt;
+    }
+
+    constexpr bool contains(std::string_view s) const {
+        return hit(index_of(s, _seed), s);
+    }
+
+    constexpr T match_or(std::string_view s, T fallback) const {
+        const auto slot = index_of(s, _seed);
+        if (hit(slot, s)) {
+            return _values[slot];
+        }
+        return fallback;
+    }
+
+    /// like the string_switch conversion operator, unknown keys throw
+    constexpr T match(std::string_view s) const {
+        const auto slot = index_of(s, _seed);
+        if (!hit(slot, s)) {
+            throw std::runtime_error("Fell off the end of a string-switch");
+        }
+        return _values[slot];
+    }
+
+private:
+    // FNV-1a with a murmur-style finalizer. the finalizer matters: without
+    // it the masked low bits are nearly invariant in the seed and the seed
+    // search cannot separate same-length keys. nothing here has to resist
+    // adversarial input, only tell the known keys apart
+    static constexpr uint64_t hash(std::string_view s, uint64_t seed) {
+        uint64_t h = seed ^ 14695981039346656037ULL;
+        for (char c : s) {
+            h ^= static_cast<uint8_t>(c);
+            h *= 1099511628211ULL;
+        }
+        h ^= h >> 33U;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33U;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33U;
+        return h;
+    }
+
+    static constexpr size_t index_of(std::string_view s, uint64_t seed) {
+        return hash(s, seed) & (table_size - 1);
+    }
+
+    // vacant slots hold a default constructed (null) string_view; the data
+    // check keeps an empty query from matching one
+    constexpr bool hit(size_t slot, std::string_view s) const {
+        return _keys[slot].data() != nullptr && _keys[slot] == s;
+    }
+
+    static constexpr uint64_t
+    find_seed(const std::array<std::pair<std::string_view, T>, N>& items) {
+        for (uint64_t seed = 1;; ++seed) {
+            std::array<bool, table_size> used{};
+            bool collision = false;
+            for (const auto& [key, value] : items) {
+                const auto slot = index_of(key, seed);
+                if (used[slot]) {
+                    collision = true;
+                    break;
+                }
+                used[slot] = true;
+            }
+            if (!collision) {
+                return seed;
+            }
+        }
+    }
+
+    uint64_t _seed;
+    std::array<std::string_view, table_size> _keys{};
+    std::array<T, table_size> _values{};
+};
+
+template<typename T, size_t N>
+constexpr static_string_map<T, N>
+make_static_string_map(const std::pair<std::string_view, T> (&items)[N]) {
+    std::array<std::pair<std::string_view, T>, N> arr{};
+    for (size_t i = 0; i < N; ++i) {
+        arr[i] = items[i];
+    }
+    return static_string_map<T, N>(arr);
+}
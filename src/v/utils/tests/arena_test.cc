@@ -0,0 +1,75 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "utils/arena.h"
+
+#define BOOST_TEST_MODULE utils
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(arena_bump_allocations_are_distinct) {
+    arena a(64);
+    auto* p = static_cast<char*>(a.allocate(16));
+    auto* q = static_cast<char*>(a.allocate(16));
+    BOOST_REQUIRE(p != q);
+    std::memset(p, 0xaa, 16);
+    std::memset(q, 0xbb, 16);
+    BOOST_REQUIRE_EQUAL(uint8_t(p[15]), 0xaa);
+    BOOST_REQUIRE_EQUAL(uint8_t(q[0]), 0xbb);
+    BOOST_REQUIRE_EQUAL(a.memory_used(), 32);
+}
+
+BOOST_AUTO_TEST_CASE(arena_respects_alignment) {
+    arena a(64);
+    a.allocate(1, 1);
+    auto* p = a.allocate(8, alignof(uint64_t));
+    BOOST_REQUIRE_EQUAL(
+      reinterpret_cast<uintptr_t>(p) % alignof(uint64_t), 0);
+    *static_cast<uint64_t*>(p) = 42;
+}
+
+BOOST_AUTO_TEST_CASE(arena_oversized_allocation_keeps_bump_position) {
+    arena a(64);
+    auto* before = static_cast<char*>(a.allocate(8));
+    // larger than the chunk size: dedicated chunk
+    auto* big = static_cast<char*>(a.allocate(1024));
+    std::memset(big, 0, 1024);
+    auto* after = static_cast<char*>(a.allocate(8));
+    // small allocations keep filling the original chunk
+    BOOST_REQUIRE(after > before && after < before + 64);
+}
+
+BOOST_AUTO_TEST_CASE(arena_copy_string) {
+    arena a;
+    std::string s = "straddling string";
+    auto v = a.copy(s);
+    BOOST_REQUIRE(v == s);
+    BOOST_REQUIRE(v.data() != s.data());
+    BOOST_REQUIRE(a.copy("").empty());
+}
+
+BOOST_AUTO_TEST_CASE(arena_backs_pmr_containers) {
+    arena a(128);
+    std::pmr::vector<int> xs{&a};
+    for (int i = 0; i < 1000; ++i) {
+        xs.push_back(i);
+    }
+    BOOST_REQUIRE_EQUAL(xs.size(), 1000);
+    BOOST_REQUIRE_EQUAL(xs.back(), 999);
+    // growth reallocates inside the arena; old buffers are abandoned, so
+    // usage exceeds the live size but everything is reclaimed by reset
+    BOOST_REQUIRE(a.memory_used() >= 1000 * sizeof(int));
+    xs = std::pmr::vector<int>{&a};
+    a.reset();
+    BOOST_REQUIRE_EQUAL(a.memory_used(), 0);
+}
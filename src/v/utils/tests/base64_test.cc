@@ -49,3 +49,17 @@ BOOST_AUTO_TEST_CASE(iobuf_type) {
     auto decoded = base64_to_bytes(encoded);
     BOOST_REQUIRE_EQUAL(decoded, iobuf_to_bytes(buf));
 }
+
+BOOST_AUTO_TEST_CASE(decode_to_iobuf) {
+    auto encdec = [](const bytes& input) {
+        auto decoded = base64_to_iobuf(bytes_to_base64(input));
+        BOOST_REQUIRE_EQUAL(iobuf_to_bytes(decoded), input);
+    };
+
+    encdec("");
+    encdec("this is a string");
+    encdec("a");
+    encdec(random_generators::get_bytes(1024));
+
+    BOOST_REQUIRE_THROW(base64_to_iobuf("!!!!"), base64_decoder_exception);
+}
@@ -0,0 +1,53 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE utils
+#include "utils/bloom_filter.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <fmt/format.h>
+
+static bytes make_key(size_t i) {
+    auto s = fmt::format("bloom-test-key-{}", i);
+    // NOLINTNEXTLINE
+    return bytes(reinterpret_cast<const uint8_t*>(s.data()), s.size());
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter_no_false_negatives) {
+    bloom_filter filter(1000);
+    for (size_t i = 0; i < 1000; ++i) {
+        filter.add(bytes_view(make_key(i)));
+    }
+    for (size_t i = 0; i < 1000; ++i) {
+        BOOST_REQUIRE(filter.maybe_contains(bytes_view(make_key(i))));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter_false_positive_rate) {
+    bloom_filter filter(1000, 0.01);
+    for (size_t i = 0; i < 1000; ++i) {
+        filter.add(bytes_view(make_key(i)));
+    }
+    // keys never added. the configured rate is 1%, leave generous slack
+    // since the test is deterministic but the math is probabilistic
+    size_t hits = 0;
+    for (size_t i = 1000; i < 11000; ++i) {
+        if (filter.maybe_contains(bytes_view(make_key(i)))) {
+            ++hits;
+        }
+    }
+    BOOST_REQUIRE_LT(hits, 500);
+}
+
+BOOST_AUTO_TEST_CASE(bloom_filter_empty) {
+    bloom_filter filter(1000);
+    BOOST_REQUIRE(!filter.maybe_contains(bytes_view(make_key(0))));
+    BOOST_REQUIRE(filter.memory_usage() > 0);
+}
@@ -11,6 +11,7 @@
 #include "utils/directory_walker.h"
 
 #include <seastar/core/file.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/testing/thread_test_case.hh>
 
 #include <fmt/format.h>
@@ -111,3 +112,51 @@ SEASTAR_THREAD_TEST_CASE(test_empty_dir) {
     ss::recursive_touch_directory((dir / "xxx").string()).get();
     BOOST_REQUIRE(!directory_walker::empty(dir).get0());
 }
+
+SEASTAR_THREAD_TEST_CASE(test_list) {
+    auto dir = "test.dir_" + random_generators::gen_alphanum_string(4);
+    ss::recursive_touch_directory(dir).get();
+    for (int i = 0; i < 5; i++) {
+        ss::open_file_dma(
+          fmt::format("{}/file{}", dir, i),
+          ss::open_flags::ro | ss::open_flags::create)
+          .discard_result()
+          .get();
+    }
+
+    auto entries = directory_walker::list(dir).get0();
+    BOOST_REQUIRE_EQUAL(entries.size(), 5);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_walk_parallel) {
+    auto dir = "test.dir_" + random_generators::gen_alphanum_string(4);
+    ss::recursive_touch_directory(dir).get();
+    for (int i = 0; i < 10; i++) {
+        ss::open_file_dma(
+          fmt::format("{}/file{}", dir, i),
+          ss::open_flags::ro | ss::open_flags::create)
+          .discard_result()
+          .get();
+    }
+
+    int count = 0;
+    int inflight = 0;
+    int max_inflight = 0;
+    directory_walker::walk_parallel(
+      dir,
+      [&](ss::directory_entry) {
+          ++count;
+          ++inflight;
+          max_inflight = std::max(max_inflight, inflight);
+          return ss::sleep(std::chrono::milliseconds(1)).then([&inflight] {
+              --inflight;
+          });
+      },
+      4)
+      .get();
+    BOOST_CHECK_EQUAL(count, 10);
+    // concurrency is bounded by the semaphore
+    BOOST_CHECK_LE(max_inflight, 4);
+    // and the walkers actually overlapped
+    BOOST_CHECK_GT(max_inflight, 1);
+}
@@ -0,0 +1,85 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "utils/dns_cache.h"
+
+#include <seastar/core/sleep.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include <chrono>
+
+using namespace std::chrono_literals; // NOLINT
+
+SEASTAR_THREAD_TEST_CASE(dns_cache_positive_hit) {
+    int calls = 0;
+    dns_cache cache([&calls](const ss::sstring&) {
+        calls++;
+        return ss::make_ready_future<ss::net::inet_address>(
+          ss::net::inet_address("127.0.0.1"));
+    });
+
+    auto a = cache.resolve(ss::sstring("node-1")).get0();
+    auto b = cache.resolve(ss::sstring("node-1")).get0();
+    BOOST_REQUIRE_EQUAL(calls, 1);
+    BOOST_REQUIRE(a == b);
+    BOOST_REQUIRE_EQUAL(cache.size(), 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(dns_cache_negative_caching) {
+    int calls = 0;
+    dns_cache cache(
+      [&calls](const ss::sstring&) {
+          calls++;
+          return ss::make_exception_future<ss::net::inet_address>(
+            std::runtime_error("no such host"));
+      },
+      dns_cache::default_positive_ttl,
+      10ms);
+
+    BOOST_REQUIRE_THROW(
+      cache.resolve(ss::sstring("node-1")).get0(), std::runtime_error);
+    // a failure within the negative ttl is answered from the cache
+    BOOST_REQUIRE_THROW(
+      cache.resolve(ss::sstring("node-1")).get0(), std::runtime_error);
+    BOOST_REQUIRE_EQUAL(calls, 1);
+
+    // once the negative entry expires the resolver is retried inline
+    ss::sleep(50ms).get();
+    BOOST_REQUIRE_THROW(
+      cache.resolve(ss::sstring("node-1")).get0(), std::runtime_error);
+    BOOST_REQUIRE_EQUAL(calls, 2);
+}
+
+SEASTAR_THREAD_TEST_CASE(dns_cache_serves_stale_while_refreshing) {
+    ss::sstring current = "127.0.0.1";
+    int calls = 0;
+    dns_cache cache(
+      [&calls, &current](const ss::sstring&) {
+          calls++;
+          return ss::make_ready_future<ss::net::inet_address>(
+            ss::net::inet_address(current));
+      },
+      10ms);
+
+    auto a = cache.resolve(ss::sstring("node-1")).get0();
+    BOOST_REQUIRE(a == ss::net::inet_address("127.0.0.1"));
+
+    current = "127.0.0.2";
+    ss::sleep(50ms).get();
+
+    // expired entries answer immediately with the stale address and
+    // refresh in the background
+    auto b = cache.resolve(ss::sstring("node-1")).get0();
+    BOOST_REQUIRE(b == ss::net::inet_address("127.0.0.1"));
+
+    ss::sleep(50ms).get();
+    auto c = cache.resolve(ss::sstring("node-1")).get0();
+    BOOST_REQUIRE(c == ss::net::inet_address("127.0.0.2"));
+    BOOST_REQUIRE_EQUAL(calls, 2);
+}
@@ -0,0 +1,108 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "utils/lru_hash_map.h"
+
+#define BOOST_TEST_MODULE utils
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(lru_hash_map_insert_find) {
+    lru_hash_map<int, int> m;
+    BOOST_REQUIRE(m.empty());
+    m.insert(1, 10);
+    m.insert(2, 20);
+    BOOST_REQUIRE_EQUAL(m.size(), 2);
+    BOOST_REQUIRE(m.contains(1));
+    BOOST_REQUIRE(!m.contains(3));
+    BOOST_REQUIRE_EQUAL(*m.find(2), 20);
+    BOOST_REQUIRE(m.find(3) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(lru_hash_map_insert_assigns_existing) {
+    lru_hash_map<int, int> m;
+    m.insert(1, 10);
+    m.insert(1, 11);
+    BOOST_REQUIRE_EQUAL(m.size(), 1);
+    BOOST_REQUIRE_EQUAL(*m.find(1), 11);
+}
+
+BOOST_AUTO_TEST_CASE(lru_hash_map_erase) {
+    lru_hash_map<int, int> m;
+    m.insert(1, 10);
+    BOOST_REQUIRE(m.erase(1));
+    BOOST_REQUIRE(!m.erase(1));
+    BOOST_REQUIRE(m.empty());
+}
+
+BOOST_AUTO_TEST_CASE(lru_hash_map_eviction_order) {
+    lru_hash_map<int, int> m;
+    m.insert(1, 10);
+    m.insert(2, 20);
+    m.insert(3, 30);
+    // refresh 1 so 2 becomes the coldest entry
+    BOOST_REQUIRE_EQUAL(*m.get(1), 10);
+
+    std::vector<int> evicted;
+    auto n = m.evict_while([&evicted](auto& e) {
+        if (evicted.size() == 2) {
+            return false;
+        }
+        evicted.push_back(e.key);
+        return true;
+    });
+    BOOST_REQUIRE_EQUAL(n, 2);
+    BOOST_REQUIRE(evicted == (std::vector<int>{2, 3}));
+    BOOST_REQUIRE_EQUAL(m.size(), 1);
+    BOOST_REQUIRE(m.contains(1));
+}
+
+BOOST_AUTO_TEST_CASE(lru_hash_map_find_does_not_touch) {
+    lru_hash_map<int, int> m;
+    m.insert(1, 10);
+    m.insert(2, 20);
+    // find must not refresh recency, so 1 stays coldest
+    BOOST_REQUIRE_EQUAL(*m.find(1), 10);
+    std::vector<int> order;
+    for (auto& e : m) {
+        order.push_back(e.key);
+    }
+    BOOST_REQUIRE(order == (std::vector<int>{1, 2}));
+}
+
+BOOST_AUTO_TEST_CASE(lru_hash_map_grows_past_initial_buckets) {
+    lru_hash_map<int, int> m;
+    auto* first = m.find(0);
+    BOOST_REQUIRE(first == nullptr);
+    for (int i = 0; i < 1000; i++) {
+        m.insert(i, i * 2);
+    }
+    // rehashing relinks nodes in place, references stay valid
+    auto& v = *m.find(17);
+    for (int i = 1000; i < 2000; i++) {
+        m.insert(i, i * 2);
+    }
+    BOOST_REQUIRE_EQUAL(m.size(), 2000);
+    BOOST_REQUIRE_EQUAL(&v, m.find(17));
+    for (int i = 0; i < 2000; i++) {
+        BOOST_REQUIRE_EQUAL(*m.find(i), i * 2);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(lru_hash_map_heterogeneous_lookup) {
+    lru_hash_map<std::string, int, std::hash<std::string_view>> m;
+    m.insert("redpanda", 1);
+    // lookup with a string_view must not materialize a std::string
+    BOOST_REQUIRE_EQUAL(*m.find(std::string_view("redpanda")), 1);
+    BOOST_REQUIRE(m.contains(std::string_view("redpanda")));
+    BOOST_REQUIRE(!m.contains(std::string_view("tazmanian")));
+}
@@ -0,0 +1,52 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE utils
+#include "utils/reservoir_sample.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(reservoir_below_capacity_keeps_everything) {
+    reservoir_sample<int64_t> r(100);
+    for (int64_t i = 0; i < 50; ++i) {
+        r.add(i);
+    }
+    BOOST_REQUIRE_EQUAL(r.count(), 50);
+    BOOST_REQUIRE_EQUAL(r.samples().size(), 50);
+    // all values retained: quantiles are exact
+    BOOST_REQUIRE_EQUAL(r.quantile(0.0).value(), 0);
+    BOOST_REQUIRE_EQUAL(r.quantile(1.0).value(), 49);
+}
+
+BOOST_AUTO_TEST_CASE(reservoir_empty_has_no_quantiles) {
+    reservoir_sample<int64_t> r(16);
+    BOOST_REQUIRE(!r.quantile(0.5).has_value());
+    BOOST_REQUIRE_EQUAL(r.count(), 0);
+    BOOST_REQUIRE(r.empty());
+}
+
+BOOST_AUTO_TEST_CASE(reservoir_bounded_memory_and_sane_estimates) {
+    constexpr size_t capacity = 1000;
+    reservoir_sample<int64_t> r(capacity);
+    // uniform stream 0..99999
+    constexpr int64_t n = 100000;
+    for (int64_t i = 0; i < n; ++i) {
+        r.add(i);
+    }
+    BOOST_REQUIRE_EQUAL(r.count(), n);
+    BOOST_REQUIRE_EQUAL(r.samples().size(), capacity);
+    // with 1000 uniform samples the median estimate lands well within
+    // 10% of the true stream median
+    auto p50 = r.quantile(0.5).value();
+    BOOST_REQUIRE_GT(p50, n / 2 - n / 10);
+    BOOST_REQUIRE_LT(p50, n / 2 + n / 10);
+    // monotone in q
+    BOOST_REQUIRE_LE(r.quantile(0.5).value(), r.quantile(0.9).value());
+    BOOST_REQUIRE_LE(r.quantile(0.9).value(), r.quantile(0.99).value());
+}
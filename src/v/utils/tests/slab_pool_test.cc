@@ -0,0 +1,90 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE slab_pool
+
+#include "utils/slab_pool.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+
+namespace {
+
+struct widget {
+    uint64_t a;
+    uint64_t b;
+    uint64_t c;
+};
+
+struct pooled_widget : widget {
+    static void* operator new(size_t size) {
+        return slab_pool<pooled_widget>::local().allocate(size);
+    }
+    static void operator delete(void* p, size_t size) {
+        slab_pool<pooled_widget>::local().deallocate(p, size);
+    }
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(slots_are_cache_line_aligned) {
+    slab_pool<widget> pool;
+    auto* a = pool.allocate(sizeof(widget));
+    auto* b = pool.allocate(sizeof(widget));
+    BOOST_REQUIRE_EQUAL(
+      uintptr_t(a) % slab_pool<widget>::cache_line_size, 0);
+    BOOST_REQUIRE_EQUAL(
+      uintptr_t(b) % slab_pool<widget>::cache_line_size, 0);
+    BOOST_REQUIRE(a != b);
+    pool.deallocate(a, sizeof(widget));
+    pool.deallocate(b, sizeof(widget));
+}
+
+BOOST_AUTO_TEST_CASE(freed_slot_is_reused) {
+    slab_pool<widget> pool;
+    auto* a = pool.allocate(sizeof(widget));
+    pool.deallocate(a, sizeof(widget));
+    auto* b = pool.allocate(sizeof(widget));
+    BOOST_REQUIRE_EQUAL(a, b);
+    pool.deallocate(b, sizeof(widget));
+}
+
+BOOST_AUTO_TEST_CASE(pool_grows_by_whole_slabs) {
+    slab_pool<widget> pool;
+    BOOST_REQUIRE_EQUAL(pool.capacity(), 0);
+    std::vector<void*> live;
+    for (size_t i = 0; i < slab_pool<widget>::slab_slots + 1; i++) {
+        live.push_back(pool.allocate(sizeof(widget)));
+    }
+    BOOST_REQUIRE_EQUAL(pool.capacity(), 2 * slab_pool<widget>::slab_slots);
+    for (auto* p : live) {
+        pool.deallocate(p, sizeof(widget));
+    }
+    BOOST_REQUIRE_EQUAL(pool.free_slots(), pool.capacity());
+}
+
+BOOST_AUTO_TEST_CASE(oversized_requests_fall_through) {
+    slab_pool<widget> pool;
+    const auto big = slab_pool<widget>::slot_size + 1;
+    auto* p = pool.allocate(big);
+    BOOST_REQUIRE(p != nullptr);
+    pool.deallocate(p, big);
+    BOOST_REQUIRE_EQUAL(pool.free_slots(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(class_level_operator_new_uses_the_pool) {
+    auto& pool = slab_pool<pooled_widget>::local();
+    auto* w = new pooled_widget();
+    BOOST_REQUIRE_EQUAL(
+      uintptr_t(w) % slab_pool<pooled_widget>::cache_line_size, 0);
+    const auto free_before = pool.free_slots();
+    delete w;
+    BOOST_REQUIRE_EQUAL(pool.free_slots(), free_before + 1);
+}
@@ -0,0 +1,63 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE utils
+
+#include "utils/static_string_map.h"
+
+#include <boost/test/unit_test.hpp>
+
+static constexpr auto simple_map = make_static_string_map<int>(
+  {{"one", 1}, {"two", 2}, {"three", 3}});
+
+// the whole table is usable at compile time
+static_assert(simple_map.match("one") == 1);
+static_assert(simple_map.match_or("none", 0) == 0);
+static_assert(simple_map.contains("three"));
+static_assert(!simple_map.contains(""));
+
+BOOST_AUTO_TEST_CASE(match_known_keys) {
+    BOOST_CHECK_EQUAL(simple_map.match("one"), 1);
+    BOOST_CHECK_EQUAL(simple_map.match("two"), 2);
+    BOOST_CHECK_EQUAL(simple_map.match("three"), 3);
+}
+
+BOOST_AUTO_TEST_CASE(match_or_falls_back) {
+    BOOST_CHECK_EQUAL(simple_map.match_or("four", 0), 0);
+    BOOST_CHECK_EQUAL(simple_map.match_or("", -1), -1);
+    BOOST_CHECK_EQUAL(simple_map.match_or("on", 7), 7);
+}
+
+BOOST_AUTO_TEST_CASE(match_unknown_key_throws) {
+    BOOST_CHECK_THROW((void)simple_map.match("four"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(maybe_lookup) {
+    BOOST_CHECK(simple_map.maybe("two") == std::optional<int>(2));
+    BOOST_CHECK(!simple_map.maybe("five"));
+}
+
+BOOST_AUTO_TEST_CASE(larger_key_set) {
+    // enough same-length keys that a weak seed search would never converge
+    static constexpr auto m = make_static_string_map<int>(
+      {{"one", 1},
+       {"two", 2},
+       {"six", 6},
+       {"ten", 10},
+       {"four", 4},
+       {"five", 5},
+       {"nine", 9},
+       {"three", 3},
+       {"seven", 7},
+       {"eight", 8}});
+    BOOST_CHECK_EQUAL(m.match("one"), 1);
+    BOOST_CHECK_EQUAL(m.match("ten"), 10);
+    BOOST_CHECK_EQUAL(m.match("seven"), 7);
+    BOOST_CHECK_EQUAL(m.match_or("eleven", -1), -1);
+}
@@ -0,0 +1,117 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "utils/timeout_wheel.h"
+
+#include <seastar/core/manual_clock.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+using namespace std::chrono_literals; // NOLINT
+
+using wheel_t = timeout_wheel<ss::manual_clock>;
+
+// let the reactor run the wheel's backing timer after a clock advance
+static void advance(ss::manual_clock::duration d) {
+    ss::manual_clock::advance(d);
+    ss::sleep<ss::manual_clock>(0ms).get();
+}
+
+SEASTAR_THREAD_TEST_CASE(timeout_wheel_fires_at_deadline) {
+    wheel_t wheel;
+    wheel_t::entry e;
+    int fired = 0;
+    wheel.arm(e, ss::manual_clock::now() + 100ms, [&fired] { ++fired; });
+    BOOST_REQUIRE(e.armed());
+    advance(50ms);
+    BOOST_REQUIRE_EQUAL(fired, 0);
+    advance(60ms);
+    BOOST_REQUIRE_EQUAL(fired, 1);
+    BOOST_REQUIRE(!e.armed());
+    BOOST_REQUIRE_EQUAL(wheel.armed(), 0);
+}
+
+SEASTAR_THREAD_TEST_CASE(timeout_wheel_cancel_is_o1_and_final) {
+    wheel_t wheel;
+    wheel_t::entry e;
+    int fired = 0;
+    wheel.arm(e, ss::manual_clock::now() + 50ms, [&fired] { ++fired; });
+    BOOST_REQUIRE(e.cancel());
+    // mirrors ss::timer: a second cancel reports not-armed
+    BOOST_REQUIRE(!e.cancel());
+    advance(200ms);
+    BOOST_REQUIRE_EQUAL(fired, 0);
+    BOOST_REQUIRE_EQUAL(wheel.armed(), 0);
+}
+
+SEASTAR_THREAD_TEST_CASE(timeout_wheel_expired_deadline_fires_next_tick) {
+    wheel_t wheel;
+    wheel_t::entry e;
+    int fired = 0;
+    wheel.arm(e, ss::manual_clock::now() - 1s, [&fired] { ++fired; });
+    advance(wheel_t::tick);
+    BOOST_REQUIRE_EQUAL(fired, 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(timeout_wheel_handles_wrap_around) {
+    // a deadline more than one wheel revolution away must not fire when
+    // the cursor first passes its bucket
+    wheel_t wheel;
+    wheel_t::entry near;
+    wheel_t::entry far;
+    int near_fired = 0;
+    int far_fired = 0;
+    const auto revolution = wheel_t::tick * wheel_t::bucket_count;
+    wheel.arm(
+      near, ss::manual_clock::now() + 30ms, [&near_fired] { ++near_fired; });
+    wheel.arm(far, ss::manual_clock::now() + revolution + 30ms, [&far_fired] {
+        ++far_fired;
+    });
+    for (size_t i = 0; i < wheel_t::bucket_count; ++i) {
+        advance(wheel_t::tick);
+    }
+    BOOST_REQUIRE_EQUAL(near_fired, 1);
+    BOOST_REQUIRE_EQUAL(far_fired, 0);
+    for (size_t i = 0; i < wheel_t::bucket_count; ++i) {
+        advance(wheel_t::tick);
+    }
+    BOOST_REQUIRE_EQUAL(far_fired, 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(timeout_wheel_many_entries_share_one_timer) {
+    wheel_t wheel;
+    std::vector<wheel_t::entry> entries(1000);
+    size_t fired = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        wheel.arm(
+          entries[i],
+          ss::manual_clock::now() + 10ms + std::chrono::milliseconds(i),
+          [&fired] { ++fired; });
+    }
+    BOOST_REQUIRE_EQUAL(wheel.armed(), entries.size());
+    // cancel half before they fire
+    for (size_t i = 0; i < entries.size(); i += 2) {
+        entries[i].cancel();
+    }
+    advance(2s);
+    BOOST_REQUIRE_EQUAL(fired, entries.size() / 2);
+    BOOST_REQUIRE_EQUAL(wheel.armed(), 0);
+}
+
+SEASTAR_THREAD_TEST_CASE(timeout_wheel_entry_destruction_cancels) {
+    wheel_t wheel;
+    int fired = 0;
+    {
+        wheel_t::entry e;
+        wheel.arm(e, ss::manual_clock::now() + 50ms, [&fired] { ++fired; });
+    }
+    BOOST_REQUIRE_EQUAL(wheel.armed(), 0);
+    advance(200ms);
+    BOOST_REQUIRE_EQUAL(fired, 0);
+}
@@ -0,0 +1,52 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "utils/trace_ring.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+#include <fmt/format.h>
+
+SEASTAR_THREAD_TEST_CASE(trace_ring_formats_lazily) {
+    trace_ring ring;
+    ring.write("plain entry");
+    ring.write("one arg {}", 42);
+    ring.write("two args {} {}", uint64_t(1), int64_t(2));
+    auto r = ring.render();
+    BOOST_REQUIRE_EQUAL(r.total, 3);
+    BOOST_REQUIRE_EQUAL(r.entries.size(), 3);
+    BOOST_REQUIRE_EQUAL(r.entries[0].message, "plain entry");
+    BOOST_REQUIRE_EQUAL(r.entries[1].message, "one arg 42");
+    BOOST_REQUIRE_EQUAL(r.entries[2].message, "two args 1 2");
+}
+
+SEASTAR_THREAD_TEST_CASE(trace_ring_wraps_keeping_newest) {
+    trace_ring ring;
+    const uint64_t writes = trace_ring::capacity + 100;
+    for (uint64_t i = 0; i < writes; ++i) {
+        ring.write("entry {}", i);
+    }
+    auto r = ring.render();
+    BOOST_REQUIRE_EQUAL(r.total, writes);
+    BOOST_REQUIRE_EQUAL(r.entries.size(), trace_ring::capacity);
+    // oldest retained entry first, newest last
+    BOOST_REQUIRE_EQUAL(
+      r.entries.front().message, fmt::format("entry {}", 100));
+    BOOST_REQUIRE_EQUAL(
+      r.entries.back().message, fmt::format("entry {}", writes - 1));
+}
+
+SEASTAR_THREAD_TEST_CASE(trace_ring_bad_format_falls_back) {
+    trace_ring ring;
+    // more placeholders than recorded arguments
+    ring.write("want {} and {}", 1);
+    auto r = ring.render();
+    BOOST_REQUIRE_EQUAL(r.entries.size(), 1);
+    BOOST_REQUIRE_EQUAL(r.entries[0].message, "want {} and {}");
+}
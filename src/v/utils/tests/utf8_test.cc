@@ -0,0 +1,67 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#define BOOST_TEST_MODULE utils
+#include "utils/utf8.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+// embed a short sequence in long ascii runs so the simd path sees it at
+// several positions relative to the 16 byte block boundary
+static void check_embedded(const std::string& s, bool valid) {
+    BOOST_CHECK_EQUAL(is_valid_utf8(s), valid);
+    for (size_t pad = 1; pad <= 33; ++pad) {
+        auto padded = std::string(pad, 'x') + s + std::string(16, 'y');
+        BOOST_CHECK_EQUAL(is_valid_utf8(padded), valid);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(valid_sequences) {
+    check_embedded("", true);
+    check_embedded("plain ascii topic-name_42", true);
+    check_embedded("\xC2\x80", true);         // U+0080, shortest 2 byte
+    check_embedded("\xDF\xBF", true);         // U+07FF, longest 2 byte
+    check_embedded("\xE0\xA0\x80", true);     // U+0800, shortest 3 byte
+    check_embedded("\xED\x9F\xBF", true);     // U+D7FF, below surrogates
+    check_embedded("\xEE\x80\x80", true);     // U+E000, above surrogates
+    check_embedded("\xEF\xBF\xBF", true);     // U+FFFF
+    check_embedded("\xF0\x90\x80\x80", true); // U+10000, shortest 4 byte
+    check_embedded("\xF4\x8F\xBF\xBF", true); // U+10FFFF, last codepoint
+}
+
+BOOST_AUTO_TEST_CASE(invalid_sequences) {
+    check_embedded("\x80", false);             // stray continuation
+    check_embedded("\xC0\xAF", false);         // overlong 2 byte
+    check_embedded("\xC1\xBF", false);         // overlong 2 byte
+    check_embedded("\xE0\x9F\xBF", false);     // overlong 3 byte
+    check_embedded("\xED\xA0\x80", false);     // surrogate U+D800
+    check_embedded("\xF0\x8F\xBF\xBF", false); // overlong 4 byte
+    check_embedded("\xF4\x90\x80\x80", false); // above U+10FFFF
+    check_embedded("\xF5\x80\x80\x80", false); // invalid lead byte
+    check_embedded("\xFF", false);             // invalid lead byte
+    check_embedded("\xC2\x41", false);         // bad continuation
+    check_embedded("\xE1\x80\xC0", false);     // bad continuation
+    check_embedded("\xF1\x80\x80\x41", false); // bad continuation
+    check_embedded("\xE1\x80\xE1\x80", false); // overlapping sequences
+}
+
+BOOST_AUTO_TEST_CASE(truncated_sequences) {
+    // truncation at the end of the buffer, including right after the simd
+    // blocks hand over to the scalar tail
+    check_embedded("\xC2", false);
+    check_embedded("\xE1\x80", false);
+    check_embedded("\xF1\x80\x80", false);
+}
+
+BOOST_AUTO_TEST_CASE(throwing_interface) {
+    BOOST_CHECK_NO_THROW(validate_utf8("ascii"));
+    BOOST_CHECK_THROW(validate_utf8("bad \xC0\xAF"), std::runtime_error);
+}
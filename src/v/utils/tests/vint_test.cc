@@ -17,6 +17,7 @@
 #include <array>
 #include <cstdint>
 #include <iostream>
+#include <limits>
 #include <random>
 
 namespace {
@@ -36,3 +37,19 @@ void check_roundtrip_sweep(int64_t count) {
 SEASTAR_THREAD_TEST_CASE(sanity_signed_sweep_64) {
     check_roundtrip_sweep(100000000);
 }
+
+SEASTAR_THREAD_TEST_CASE(bulk_decoder_matches_iterator_decoder) {
+    // exercise every encoded length, including the unrolled 1 and 2 byte
+    // fast paths of the contiguous buffer decoder
+    std::array<int64_t, 8> values{
+      {0, -1, 63, -64, 8191, -8192, std::numeric_limits<int64_t>::max(),
+       std::numeric_limits<int64_t>::min()}};
+    for (const int64_t v : values) {
+        const auto b = vint::to_bytes(v);
+        const auto [decoded, sz] = vint::deserialize_buf(
+          // NOLINTNEXTLINE
+          reinterpret_cast<const char*>(b.data()), b.size());
+        BOOST_REQUIRE_EQUAL(decoded, v);
+        BOOST_REQUIRE_EQUAL(sz, b.size());
+    }
+}
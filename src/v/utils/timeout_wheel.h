@@ -0,0 +1,190 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+#include "vassert.h"
+
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include <boost/intrusive/list.hpp>
+
+#include <array>
+#include <chrono>
+
+/**
+ * Shard local hashed timing wheel for request timeouts.
+ *
+ * Arming a dedicated seastar timer per outstanding request costs two
+ * reactor timer operations per request (arm on issue, cancel on
+ * completion), which adds up at hundreds of thousands of requests per
+ * second whose timeouts almost never fire. Entries register into the
+ * wheel instead: insert and cancel are O(1) intrusive list operations
+ * and the wheel keeps exactly one backing timer armed, ticking at bucket
+ * granularity only while entries are outstanding. Timeout precision is
+ * one tick, which matches the resolution of the lowres clock the
+ * timeouts are specified against anyway.
+ */
+template<typename Clock = ss::lowres_clock>
+class timeout_wheel {
+public:
+    using time_point = typename Clock::time_point;
+    using duration = typename Clock::duration;
+
+    static constexpr size_t bucket_count = 128;
+    static constexpr duration tick = std::chrono::duration_cast<duration>(
+      std::chrono::milliseconds(10));
+
+    /**
+     * Registration handle owned by the waiter. Must stay at a stable
+     * address while armed; destruction cancels.
+     */
+    class entry
+      : public boost::intrusive::list_base_hook<
+          boost::intrusive::link_mode<boost::intrusive::safe_link>> {
+    public:
+        entry() = default;
+        // moving transfers the bucket slot; like a moved ss::timer, a
+        // callback capturing the old owner is the mover's problem
+        entry(entry&& o) noexcept
+          : _wheel(o._wheel)
+          , _deadline(o._deadline)
+          , _callback(std::move(o._callback)) {
+            swap_nodes(o);
+        }
+        entry& operator=(entry&& o) noexcept {
+            if (this != &o) {
+                cancel();
+                _wheel = o._wheel;
+                _deadline = o._deadline;
+                _callback = std::move(o._callback);
+                swap_nodes(o);
+            }
+            return *this;
+        }
+        entry(const entry&) = delete;
+        entry& operator=(const entry&) = delete;
+        ~entry() { cancel(); }
+
+        /// true when the entry was armed and had not fired yet; mirrors
+        /// ss::timer::cancel() semantics
+        bool cancel() {
+            if (!is_linked()) {
+                return false;
+            }
+            unlink();
+            --_wheel->_armed;
+            return true;
+        }
+
+        bool armed() const { return is_linked(); }
+
+    private:
+        friend timeout_wheel;
+
+        timeout_wheel* _wheel{nullptr};
+        time_point _deadline;
+        ss::noncopyable_function<void()> _callback;
+    };
+
+    timeout_wheel() {
+        _timer.set_callback([this] { on_tick(); });
+    }
+    timeout_wheel(timeout_wheel&&) = delete;
+    timeout_wheel& operator=(timeout_wheel&&) = delete;
+    timeout_wheel(const timeout_wheel&) = delete;
+    timeout_wheel& operator=(const timeout_wheel&) = delete;
+    ~timeout_wheel() = default;
+
+    /**
+     * Fires the callback at the first tick boundary at or after the
+     * deadline, unless the entry is cancelled first. An already expired
+     * deadline fires on the next tick.
+     */
+    void arm(
+      entry& e, time_point deadline, ss::noncopyable_function<void()> cb) {
+        vassert(!e.is_linked(), "cannot arm an armed timeout wheel entry");
+        if (_armed == 0) {
+            _last_tick = tick_of(Clock::now());
+            _timer.arm(boundary_of(_last_tick + 1));
+        }
+        e._wheel = this;
+        e._deadline = deadline;
+        e._callback = std::move(cb);
+        // never place an entry into a bucket the cursor already passed
+        const int64_t t = std::max(deadline_tick(deadline), _last_tick + 1);
+        _buckets[size_t(t % bucket_count)].push_back(e);
+        ++_armed;
+    }
+
+    size_t armed() const { return _armed; }
+
+private:
+    using list_t = boost::intrusive::
+      list<entry, boost::intrusive::constant_time_size<false>>;
+
+    static int64_t tick_of(time_point t) {
+        return t.time_since_epoch() / tick;
+    }
+    /// first tick boundary at or after t
+    static int64_t deadline_tick(time_point t) {
+        auto ticks = tick_of(t);
+        if (boundary_of(ticks) < t) {
+            ++ticks;
+        }
+        return ticks;
+    }
+    static time_point boundary_of(int64_t ticks) {
+        return time_point(ticks * tick);
+    }
+
+    void on_tick() {
+        const auto now = Clock::now();
+        const int64_t current = tick_of(now);
+        // normally exactly one tick elapsed; more only after a stall
+        while (_last_tick < current) {
+            ++_last_tick;
+            fire_bucket(_buckets[size_t(_last_tick % bucket_count)], now);
+        }
+        if (_armed > 0) {
+            _timer.arm(boundary_of(current + 1));
+        }
+    }
+
+    void fire_bucket(list_t& bucket, time_point now) {
+        for (auto it = bucket.begin(); it != bucket.end();) {
+            entry& e = *it;
+            if (e._deadline <= now) {
+                it = bucket.erase(it);
+                --_armed;
+                e._callback();
+            } else {
+                // due a whole wheel revolution (or more) later
+                ++it;
+            }
+        }
+    }
+
+    std::array<list_t, bucket_count> _buckets;
+    size_t _armed{0};
+    int64_t _last_tick{0};
+    ss::timer<Clock> _timer;
+};
+
+/// shard local wheel for the given clock
+template<typename Clock = ss::lowres_clock>
+timeout_wheel<Clock>& shard_timeout_wheel() {
+    static thread_local timeout_wheel<Clock> wheel;
+    return wheel;
+}
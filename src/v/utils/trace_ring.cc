@@ -0,0 +1,68 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "utils/trace_ring.h"
+
+#include <seastar/core/smp.hh>
+
+#include <fmt/format.h>
+
+trace_ring& trace_ring::local() {
+    static thread_local trace_ring ring;
+    return ring;
+}
+
+static ss::sstring format_entry(const trace_ring::entry& e) {
+    try {
+        std::string s;
+        switch (e.num_args) {
+        case 0:
+            s = fmt::format(e.fmt);
+            break;
+        case 1:
+            s = fmt::format(e.fmt, e.args[0]);
+            break;
+        case 2:
+            s = fmt::format(e.fmt, e.args[0], e.args[1]);
+            break;
+        case 3:
+            s = fmt::format(e.fmt, e.args[0], e.args[1], e.args[2]);
+            break;
+        default:
+            s = fmt::format(
+              e.fmt, e.args[0], e.args[1], e.args[2], e.args[3]);
+            break;
+        }
+        return ss::sstring(s.data(), s.size());
+    } catch (const fmt::format_error&) {
+        // argument count mismatch in the format string; surface the raw
+        // format string rather than dropping the entry
+        return ss::sstring(e.fmt);
+    }
+}
+
+trace_ring::report trace_ring::render() const {
+    report r{
+      .shard = ss::this_shard_id(),
+      .total = _head,
+      .entries = {},
+    };
+    const auto now = ss::lowres_clock::now();
+    const size_t n = std::min<uint64_t>(_head, capacity);
+    r.entries.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        const auto& e = _ring[(_head - n + i) % capacity];
+        r.entries.push_back(rendered_entry{
+          .age = std::chrono::duration_cast<std::chrono::milliseconds>(
+            now - e.at),
+          .message = format_entry(e),
+        });
+    }
+    return r;
+}
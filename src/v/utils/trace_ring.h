@@ -0,0 +1,101 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/sstring.hh>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Per-shard binary trace ring.
+ *
+ * The regular loggers format strings inline on the calling shard, which
+ * makes debug-grade logging on hot paths unusable in production. vtrace()
+ * instead stores the format string pointer (format strings are static,
+ * the pointer doubles as the message id) plus up to four integral
+ * arguments into a preallocated ring slot - a handful of POD stores, no
+ * allocation, no locks, no formatting - cheap enough to leave enabled on
+ * hot paths and safe to call from signal handler context.
+ *
+ * Entries are formatted lazily when the ring is rendered through the
+ * admin API after an incident, exactly like the cpu stall ring. The ring
+ * keeps the most recent entries; older ones are overwritten.
+ */
+class trace_ring {
+public:
+    static constexpr size_t capacity = 2048;
+    static constexpr size_t max_args = 4;
+
+    struct entry {
+        ss::lowres_clock::time_point at;
+        // pointer to a static format string; also the message id
+        const char* fmt{nullptr};
+        std::array<uint64_t, max_args> args{};
+        uint8_t num_args{0};
+    };
+
+    struct rendered_entry {
+        // time since the entry was recorded
+        std::chrono::milliseconds age;
+        ss::sstring message;
+    };
+
+    struct report {
+        unsigned shard;
+        // entries recorded on this shard since startup, including the
+        // ones already overwritten
+        uint64_t total;
+        // retained entries, oldest first
+        std::vector<rendered_entry> entries;
+    };
+
+    static trace_ring& local();
+
+    template<typename... Args>
+    void write(const char* fmt, Args... args) noexcept {
+        static_assert(
+          sizeof...(Args) <= max_args, "too many trace arguments");
+        static_assert(
+          ((std::is_integral_v<Args> || std::is_enum_v<Args>)&&...),
+          "trace arguments must be integral");
+        auto& e = _ring[_head % capacity];
+        ++_head;
+        e.at = ss::lowres_clock::now();
+        e.fmt = fmt;
+        e.num_args = sizeof...(Args);
+        size_t i = 0;
+        ((e.args[i++] = static_cast<uint64_t>(args)), ...);
+    }
+
+    uint64_t total() const { return _head; }
+
+    /// format the retained entries; O(retained), for admin queries only
+    report render() const;
+
+private:
+    std::array<entry, capacity> _ring{};
+    uint64_t _head{0};
+};
+
+// clang-format off
+/// Record a trace entry on the local shard's ring. Only integral
+/// arguments are accepted; anything that needs formatting up front
+/// belongs in a regular log line instead.
+#define vtrace(FMT, ...) trace_ring::local().write(FMT, ##__VA_ARGS__)
+// clang-format on
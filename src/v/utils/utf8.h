@@ -11,10 +11,16 @@
 
 #pragma once
 
-#include <boost/locale/encoding_utf.hpp>
+#include "likely.h"
+#include "utils/concepts-enabled.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
 #include <string_view>
 
+#include <x86intrin.h>
+
 // clang-format off
 CONCEPT(
 template<typename T>
@@ -24,25 +30,211 @@ concept ExceptionThrower = requires(T obj) {
 )
 // clang-format on
 
-namespace {
+namespace utf8_detail {
+
+inline bool is_valid_scalar(const unsigned char* data, size_t len) {
+    while (len) {
+        const unsigned char byte1 = data[0];
+        if (byte1 <= 0x7F) {
+            data += 1;
+            len -= 1;
+            continue;
+        }
+        if (byte1 >= 0xC2 && byte1 <= 0xDF) {
+            if (len < 2 || data[1] < 0x80 || data[1] > 0xBF) {
+                return false;
+            }
+            data += 2;
+            len -= 2;
+            continue;
+        }
+        if (byte1 >= 0xE0 && byte1 <= 0xEF) {
+            if (len < 3) {
+                return false;
+            }
+            // E0 excludes overlong encodings, ED excludes surrogates
+            const unsigned char min2 = byte1 == 0xE0 ? 0xA0 : 0x80;
+            const unsigned char max2 = byte1 == 0xED ? 0x9F : 0xBF;
+            if (
+              data[1] < min2 || data[1] > max2 || data[2] < 0x80
+              || data[2] > 0xBF) {
+                return false;
+            }
+            data += 3;
+            len -= 3;
+            continue;
+        }
+        if (byte1 >= 0xF0 && byte1 <= 0xF4) {
+            if (len < 4) {
+                return false;
+            }
+            // F0 excludes overlong encodings, F4 caps at U+10FFFF
+            const unsigned char min2 = byte1 == 0xF0 ? 0x90 : 0x80;
+            const unsigned char max2 = byte1 == 0xF4 ? 0x8F : 0xBF;
+            if (
+              data[1] < min2 || data[1] > max2 || data[2] < 0x80
+              || data[2] > 0xBF || data[3] < 0x80 || data[3] > 0xBF) {
+                return false;
+            }
+            data += 4;
+            len -= 4;
+            continue;
+        }
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Shuffle-based range validation, after "Validating UTF-8 In Less Than One
+ * Instruction Per Byte" (Keiser & Lemire). Every byte is classified into a
+ * range index from its own high nibble and the lead byte it follows, then
+ * checked against per-range min/max tables with a single pair of vector
+ * compares. Overlapping or dangling sequences land on range indices whose
+ * table entries reject every byte value.
+ *
+ * Compiled for sse4.2 explicitly: redpanda refuses to start without it
+ * (syschecks::cpu), so the build does not need a matching -march.
+ */
+[[gnu::target("sse4.2")]] inline bool
+is_valid_simd(const unsigned char* data, size_t len) {
+    if (len >= 16) {
+        // clang-format off
+        // length minus one of the character a lead byte starts, by high
+        // nibble; zero for ascii and continuation bytes
+        alignas(16) static constexpr int8_t first_len_tbl[16] = {
+          0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2, 3};
+        // range index 8 (C2~F4) for lead bytes C0~FF
+        alignas(16) static constexpr int8_t first_range_tbl[16] = {
+          0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 8, 8, 8, 8};
+        // 0: 00~7F, 1-3: 80~BF, 4: A0~BF (after E0), 5: 80~9F (after ED),
+        // 6: 90~BF (after F0), 7: 80~8F (after F4), 8: C2~F4 (lead),
+        // 9-15: impossible ranges that reject everything
+        alignas(16) static constexpr int8_t range_min_tbl[16] = {
+          0x00, -0x80, -0x80, -0x80, -0x60, -0x80, -0x70, -0x80,
+          -0x3E, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F};
+        alignas(16) static constexpr int8_t range_max_tbl[16] = {
+          0x7F, -0x41, -0x41, -0x41, -0x41, -0x61, -0x41, -0x71,
+          -0x0C, -0x80, -0x80, -0x80, -0x80, -0x80, -0x80, -0x80};
+        // range adjustments for the second byte after E0/ED and F0/F4
+        alignas(16) static constexpr int8_t df_ee_tbl[16] = {
+          0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0};
+        alignas(16) static constexpr int8_t ef_fe_tbl[16] = {
+          0, 3, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+        // clang-format on
+
+        const auto v_first_len_tbl = _mm_load_si128(
+          reinterpret_cast<const __m128i*>(first_len_tbl));
+        const auto v_first_range_tbl = _mm_load_si128(
+          reinterpret_cast<const __m128i*>(first_range_tbl));
+        const auto v_range_min_tbl = _mm_load_si128(
+          reinterpret_cast<const __m128i*>(range_min_tbl));
+        const auto v_range_max_tbl = _mm_load_si128(
+          reinterpret_cast<const __m128i*>(range_max_tbl));
+        const auto v_df_ee_tbl = _mm_load_si128(
+          reinterpret_cast<const __m128i*>(df_ee_tbl));
+        const auto v_ef_fe_tbl = _mm_load_si128(
+          reinterpret_cast<const __m128i*>(ef_fe_tbl));
+
+        __m128i prev_input = _mm_setzero_si128();
+        __m128i prev_first_len = _mm_setzero_si128();
+        __m128i error = _mm_setzero_si128();
+
+        while (len >= 16) {
+            const __m128i input = _mm_loadu_si128(
+              reinterpret_cast<const __m128i*>(data));
+
+            const __m128i high_nibbles = _mm_and_si128(
+              _mm_srli_epi16(input, 4), _mm_set1_epi8(0x0F));
+
+            const __m128i first_len = _mm_shuffle_epi8(
+              v_first_len_tbl, high_nibbles);
+
+            // lead byte range
+            __m128i range = _mm_shuffle_epi8(v_first_range_tbl, high_nibbles);
+
+            // second byte: range index = first_len of the previous byte
+            range = _mm_or_si128(
+              range, _mm_alignr_epi8(first_len, prev_first_len, 15));
+
+            // third byte: saturate_sub(first_len, 1) two bytes back
+            __m128i tmp = _mm_alignr_epi8(first_len, prev_first_len, 14);
+            tmp = _mm_subs_epu8(tmp, _mm_set1_epi8(1));
+            range = _mm_or_si128(range, tmp);
+
+            // fourth byte: saturate_sub(first_len, 2) three bytes back
+            tmp = _mm_alignr_epi8(first_len, prev_first_len, 13);
+            tmp = _mm_subs_epu8(tmp, _mm_set1_epi8(2));
+            range = _mm_or_si128(range, tmp);
+
+            // tighten the second byte range after the special lead bytes
+            // E0 (A0~BF), ED (80~9F), F0 (90~BF) and F4 (80~8F)
+            const __m128i shift1 = _mm_alignr_epi8(input, prev_input, 15);
+            const __m128i pos = _mm_sub_epi8(
+              shift1, _mm_set1_epi8(static_cast<char>(0xEF)));
+            tmp = _mm_subs_epu8(pos, _mm_set1_epi8(static_cast<char>(0xF0)));
+            __m128i range2 = _mm_shuffle_epi8(v_df_ee_tbl, tmp);
+            tmp = _mm_adds_epu8(pos, _mm_set1_epi8(0x70));
+            range2 = _mm_add_epi8(range2, _mm_shuffle_epi8(v_ef_fe_tbl, tmp));
+            range = _mm_add_epi8(range, range2);
+
+            const __m128i minv = _mm_shuffle_epi8(v_range_min_tbl, range);
+            const __m128i maxv = _mm_shuffle_epi8(v_range_max_tbl, range);
+            error = _mm_or_si128(error, _mm_cmplt_epi8(input, minv));
+            error = _mm_or_si128(error, _mm_cmpgt_epi8(input, maxv));
+
+            prev_input = input;
+            prev_first_len = first_len;
+            data += 16;
+            len -= 16;
+        }
+
+        if (_mm_movemask_epi8(error) != 0) {
+            return false;
+        }
+
+        // a multi-byte character may straddle the boundary: back up to the
+        // last lead byte and let the scalar tail re-check it
+        alignas(16) int8_t last[16];
+        _mm_store_si128(reinterpret_cast<__m128i*>(last), prev_input);
+        size_t lookahead = 0;
+        if (last[15] > static_cast<int8_t>(0xBF)) {
+            lookahead = 1;
+        } else if (last[14] > static_cast<int8_t>(0xBF)) {
+            lookahead = 2;
+        } else if (last[13] > static_cast<int8_t>(0xBF)) {
+            lookahead = 3;
+        }
+        data -= lookahead;
+        len += lookahead;
+    }
+    return is_valid_scalar(data, len);
+}
+
 struct default_thrower {
     [[noreturn]] [[gnu::cold]] void conversion_error() {
         throw std::runtime_error("Cannot decode string as UTF8");
     }
 };
-} // namespace
+
+} // namespace utf8_detail
+
+/// validate a whole string in one vectorized pass; 16 bytes per iteration
+/// with a scalar tail, ascii never leaves the fast path
+inline bool is_valid_utf8(std::string_view s) {
+    return utf8_detail::is_valid_simd(
+      // NOLINTNEXTLINE
+      reinterpret_cast<const unsigned char*>(s.data()), s.size());
+}
 
 template<typename Thrower>
 CONCEPT(requires ExceptionThrower<Thrower>)
 inline void validate_utf8(std::string_view s, Thrower&& thrower) {
-    try {
-        boost::locale::conv::utf_to_utf<char>(
-          s.begin(), s.end(), boost::locale::conv::stop);
-    } catch (const boost::locale::conv::conversion_error& ex) {
+    if (unlikely(!is_valid_utf8(s))) {
         thrower.conversion_error();
     }
 }
 
 inline void validate_utf8(std::string_view s) {
-    validate_utf8(s, default_thrower{});
+    validate_utf8(s, utf8_detail::default_thrower{});
 }
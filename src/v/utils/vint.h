@@ -75,6 +75,41 @@ inline bytes to_bytes(int64_t value) noexcept {
     return out;
 }
 
+/// \brief decode a zigzag vint from contiguous memory holding at least
+/// `size` bytes of the encoding. unrolled for the one and two byte values
+/// that dominate record fields (deltas, small lengths), with no per-byte
+/// iterator dispatch - the bulk path for parsing records out of a single
+/// iobuf fragment. the caller must guarantee the encoded value does not
+/// extend past `size` bytes (e.g. size >= max_length).
+inline std::pair<int64_t, size_t>
+deserialize_buf(const char* src, size_t size) noexcept {
+    // NOLINTNEXTLINE
+    const auto* p = reinterpret_cast<const uint8_t*>(src);
+    if (likely(size >= 1 && !(p[0] & 0x80))) {
+        return {decode_zigzag(p[0]), 1};
+    }
+    if (likely(size >= 2 && !(p[1] & 0x80))) {
+        return {
+          decode_zigzag(
+            (uint64_t(p[0]) & 127) | (uint64_t(p[1]) << uint64_t(7))),
+          2};
+    }
+    uint64_t result = 0;
+    uint64_t shift = 0;
+    size_t bytes_read = 0;
+    while (shift <= 63 && bytes_read < size) {
+        const uint64_t byte = p[bytes_read++];
+        if (byte & 128) {
+            result |= ((byte & 127) << shift);
+        } else {
+            result |= byte << shift;
+            break;
+        }
+        shift += 7;
+    }
+    return {decode_zigzag(result), bytes_read};
+}
+
 /// \brief almost identical impl to leveldb, made generic for c++
 /// friendliness
 /// https://github.com/google/leveldb/blob/201f52201f/util/coding.cc#L116